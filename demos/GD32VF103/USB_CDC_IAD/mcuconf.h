@@ -103,6 +103,8 @@
 #define GD32_CAN_CAN1_IRQ_PRIORITY           11
 #define GD32_CAN_CAN0_IRQ_TRIGGER            ECLIC_TRIGGER_DEFAULT
 #define GD32_CAN_CAN1_IRQ_TRIGGER            ECLIC_TRIGGER_DEFAULT
+#define GD32_CAN_USE_RX_RING                 FALSE
+#define GD32_CAN_RX_RING_SIZE                32
 
 /*
  * CRC driver system settings.
@@ -0,0 +1,47 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Kernel settings of the demo, only the values differing from the RT
+ * template are listed here, everything else comes from
+ * $(CHIBIOS)/os/rt/templates/chconf.h.
+ */
+
+#ifndef SIMHAL_CHCONF_H
+#define SIMHAL_CHCONF_H
+
+/*
+ * The simulator port has a periodic tick only.
+ */
+#define CH_CFG_ST_FREQUENCY                 1000
+#define CH_CFG_ST_TIMEDELTA                 0
+
+/*
+ * No linker provided heap on the host.
+ */
+#define CH_CFG_MEMCORE_SIZE                 0x20000
+
+/*
+ * Debug options.
+ */
+#define CH_DBG_STATISTICS                   TRUE
+#define CH_DBG_SYSTEM_STATE_CHECK           TRUE
+#define CH_DBG_ENABLE_CHECKS                TRUE
+#define CH_DBG_ENABLE_ASSERTS               TRUE
+
+#include "rt/templates/chconf.h"
+
+#endif /* SIMHAL_CHCONF_H */
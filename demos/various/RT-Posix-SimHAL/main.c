@@ -0,0 +1,338 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "hal_ee24xx.h"
+#include "hal_ee25xx.h"
+#include "sim_ee24xx.h"
+#include "sim_ee25xx.h"
+#include "sim_ds18b20.h"
+
+/*===========================================================================*/
+/* 24xx EEPROM on I2C1.                                                      */
+/*===========================================================================*/
+
+#define EE24_SIZE           32768U
+#define EE24_PAGE           64U
+#define EE24_ADDR           0x50U
+
+static uint8_t ee24_mem[EE24_SIZE];
+static sim_ee24xx_t ee24;
+static uint8_t ee24_buf[EE24_PAGE + 2U];
+
+static const I2CConfig i2ccfg = {
+  400000
+};
+
+static const I2CEepromFileConfig ee24cfg = {
+  0,
+  EE24_SIZE,
+  EE24_SIZE,
+  EE24_PAGE,
+  TIME_MS2I(5),
+  &I2CD1,
+  EE24_ADDR,
+  ee24_buf
+};
+
+static I2CEepromFileStream ee24fs;
+
+/*===========================================================================*/
+/* 25xx EEPROM on SPI1.                                                      */
+/*===========================================================================*/
+
+#define EE25_SIZE           32768U
+#define EE25_PAGE           64U
+
+static uint8_t ee25_mem[EE25_SIZE];
+static sim_ee25xx_t ee25;
+static uint8_t ee25_buf[EE25_PAGE + 3U];
+
+static const SPIConfig spicfg = {
+  NULL,
+  10000000,
+  &ee25.dev
+};
+
+static const SPIEepromFileConfig ee25cfg = {
+  0,
+  EE25_SIZE,
+  EE25_SIZE,
+  EE25_PAGE,
+  TIME_MS2I(5),
+  &SPID1,
+  &spicfg
+};
+
+static SPIEepromFileStream ee25fs;
+
+/*===========================================================================*/
+/* NAND flash.                                                               */
+/*===========================================================================*/
+
+#define NAND_BLOCKS         64U
+#define NAND_PAGES          64U
+#define NAND_DATA           2048U
+#define NAND_SPARE          64U
+
+static uint8_t nand_array[NAND_BLOCKS * NAND_PAGES * (NAND_DATA + NAND_SPARE)];
+static uint32_t nand_erase_counts[NAND_BLOCKS];
+static const uint32_t nand_bad_blocks[] = {7, 42};
+static bitmap_word_t nand_bb_words[(NAND_BLOCKS + 31U) / 32U];
+static bitmap_t nand_bb_map = {
+  nand_bb_words,
+  sizeof(nand_bb_words) / sizeof(nand_bb_words[0])
+};
+static uint8_t nand_page[NAND_DATA];
+
+static const NANDConfig nandcfg = {
+  1,
+  1,
+  1,
+  NAND_BLOCKS,
+  NAND_DATA,
+  NAND_SPARE,
+  NAND_PAGES,
+  3,
+  2,
+  nand_array,
+  nand_bad_blocks,
+  sizeof(nand_bad_blocks) / sizeof(nand_bad_blocks[0]),
+  nand_erase_counts,
+  0x2CDA,
+  25U,
+  SIM_US2NS(25),
+  SIM_US2NS(250),
+  SIM_MS2NS(2)
+};
+
+/*===========================================================================*/
+/* DS18B20 sensors on a 1-Wire bus driven by PWM1.                           */
+/*===========================================================================*/
+
+#define OW_SENSORS          2U
+#define OW_PAD              0U
+#define OW_WRITE_SCRATCHPAD 0x4EU
+
+static const uint8_t ow_serials[OW_SENSORS][6] = {
+  {0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x01U},
+  {0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x02U}
+};
+static const int32_t ow_millicelsius[OW_SENSORS] = {21500, -10000};
+static sim_ds18b20_t ow_sensors[OW_SENSORS];
+static sim_onewire_t ow_bus;
+static uint8_t ow_roms[OW_SENSORS * 8U];
+static uint8_t ow_temps[OW_SENSORS * 2U];
+
+/*
+ * Not constant, the 1-Wire driver rewrites it.
+ */
+static PWMConfig ow_pwmcfg = {
+  0,
+  0,
+  NULL,
+  {
+    {PWM_OUTPUT_DISABLED, NULL},
+    {PWM_OUTPUT_DISABLED, NULL},
+    {PWM_OUTPUT_DISABLED, NULL},
+    {PWM_OUTPUT_DISABLED, NULL}
+  }
+};
+
+static const onewireConfig owcfg = {
+  &PWMD1,
+  &ow_pwmcfg,
+  PWM_OUTPUT_ACTIVE_LOW,
+  0,
+  1,
+  IOPORT1,
+  OW_PAD,
+  PAL_MODE_OUTPUT_OPENDRAIN
+};
+
+/*===========================================================================*/
+/* Benchmarks.                                                               */
+/*===========================================================================*/
+
+static uint8_t pattern[4096];
+static uint8_t readback[4096];
+
+static void report(const char *name, const sim_stats_t *stp, simtime_t t0) {
+
+  printf("%-8s %8lu bytes %8lu us, bus %8lu B/s, busy %lu\n", name,
+         (unsigned long)stp->bytes,
+         (unsigned long)((simTimeNow() - t0) / 1000U),
+         (unsigned long)simStatsThroughput(stp),
+         (unsigned long)stp->busy);
+}
+
+static bool eeprom_bench(const char *name, EepromFileStream *efs,
+                         const sim_stats_t *stp) {
+  simtime_t t0 = simTimeNow();
+
+  fileStreamSeek(efs, 0);
+  if (streamWrite(efs, pattern, sizeof(pattern)) != sizeof(pattern)) {
+    return false;
+  }
+  fileStreamSeek(efs, 0);
+  if (streamRead(efs, readback, sizeof(readback)) != sizeof(readback)) {
+    return false;
+  }
+  report(name, stp, t0);
+  return memcmp(pattern, readback, sizeof(pattern)) == 0;
+}
+
+static bool nand_bench(void) {
+  simtime_t t0 = simTimeNow();
+  uint32_t block, page;
+
+  for (block = 0; block < NAND_BLOCKS; block++) {
+    if (nandIsBad(&NANDD1, 0, 0, 0, block, 0)) {
+      continue;
+    }
+    if ((nandErase(&NANDD1, 0, 0, 0, block) & SIM_NAND_STATUS_FAIL) != 0U) {
+      nandMarkBad(&NANDD1, 0, 0, 0, block);
+      continue;
+    }
+    for (page = 0; page < 4U; page++) {
+      memcpy(nand_page, pattern, sizeof(nand_page));
+      nand_page[0] = (uint8_t)block;
+      nand_page[1] = (uint8_t)page;
+      nandWritePageData(&NANDD1, 0, 0, 0, block, page, nand_page,
+                        sizeof(nand_page), NULL);
+      nandReadPageData(&NANDD1, 0, 0, 0, block, page, nand_page,
+                       sizeof(nand_page), NULL);
+      if ((nand_page[0] != (uint8_t)block) || (nand_page[1] != (uint8_t)page)) {
+        return false;
+      }
+    }
+  }
+  report("NAND", &NANDD1.stats, t0);
+  return true;
+}
+
+static bool onewire_bench(void) {
+  /* TH, TL and 9 bits resolution.*/
+  static uint8_t res9[3] = {0x4BU, 0x46U, 0x1FU};
+  simtime_t t0 = simTimeNow();
+  uint8_t status = 0U;
+  size_t i, j;
+
+  if (onewireSearchRom(&OWD1, ow_roms, OW_SENSORS) != OW_SENSORS) {
+    return false;
+  }
+  if (!onewireSelect(&OWD1, NULL, OW_WRITE_SCRATCHPAD, 0)) {
+    return false;
+  }
+  onewireWrite(&OWD1, res9, sizeof(res9), 0);
+  if (!onewireConvertAll(&OWD1, 0)) {
+    return false;
+  }
+  /* The bus reads 0 until all the conversions are done.*/
+  while (status == 0U) {
+    onewireRead(&OWD1, &status, 1);
+  }
+  if (onewireReadScratchpads(&OWD1, ow_temps, 2) != OW_SENSORS) {
+    return false;
+  }
+  report("1-Wire", &ow_bus.stats, t0);
+
+  /* Search order differs from the attach order, sensors are matched by
+     their ROM code.*/
+  for (i = 0; i < OW_SENSORS; i++) {
+    int16_t t = (int16_t)(ow_temps[i * 2U] | (ow_temps[i * 2U + 1U] << 8));
+
+    for (j = 0; j < OW_SENSORS; j++) {
+      if (memcmp(&ow_roms[i * 8U], ow_sensors[j].rom, 8) == 0) {
+        break;
+      }
+    }
+    if ((j == OW_SENSORS) ||
+        (((int32_t)t * 625) / 10 != ow_millicelsius[j])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Application entry point.
+ */
+int main(void) {
+  unsigned i;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  chSysInit();
+
+  for (i = 0; i < sizeof(pattern); i++) {
+    pattern[i] = (uint8_t)(i * 7U + 3U);
+  }
+
+  /*
+   * Device models wiring.
+   */
+  memset(ee24_mem, 0xFF, sizeof(ee24_mem));
+  simEe24xxObjectInit(&ee24, EE24_ADDR, ee24_mem, EE24_SIZE, EE24_PAGE,
+                      SIM_MS2NS(5));
+  simI2cAttach(&I2CD1, &ee24.dev);
+  memset(ee25_mem, 0xFF, sizeof(ee25_mem));
+  simEe25xxObjectInit(&ee25, ee25_mem, EE25_SIZE, EE25_PAGE, SIM_MS2NS(5));
+  simNandFormat(&nandcfg);
+  simOnewireObjectInit(&ow_bus, &PWMD1, 0, IOPORT1, OW_PAD);
+  for (i = 0; i < OW_SENSORS; i++) {
+    simDs18b20ObjectInit(&ow_sensors[i], ow_serials[i]);
+    simDs18b20SetTemperature(&ow_sensors[i], ow_millicelsius[i]);
+    simOnewireAttach(&ow_bus, &ow_sensors[i]);
+  }
+
+  i2cStart(&I2CD1, &i2ccfg);
+  spiStart(&SPID1, &spicfg);
+  nandStart(&NANDD1, &nandcfg, &nand_bb_map);
+  simNandInjectFailure(&NANDD1, 13);
+  onewireObjectInit(&OWD1);
+  onewireStart(&OWD1, &owcfg);
+
+  I2CEepromFileOpen(&ee24fs, &ee24cfg, EepromFindDevice(EEPROM_DEV_24XX));
+  SPIEepromFileOpen(&ee25fs, &ee25cfg, EepromFindDevice(EEPROM_DEV_25XX));
+
+  simTimeReset();
+  printf("24xx     %s\n", eeprom_bench("24xx", (EepromFileStream *)&ee24fs,
+                                       &I2CD1.stats) ? "PASS" : "FAIL");
+  printf("25xx     %s\n", eeprom_bench("25xx", (EepromFileStream *)&ee25fs,
+                                       &SPID1.stats) ? "PASS" : "FAIL");
+  printf("NAND     %s\n", nand_bench() ? "PASS" : "FAIL");
+  printf("1-Wire   %s\n", onewire_bench() ? "PASS" : "FAIL");
+  printf("24xx write cycles %lu, 25xx write cycles %lu\n",
+         (unsigned long)ee24.write_cycles, (unsigned long)ee25.write_cycles);
+  printf("DS18B20 conversions %lu\n",
+         (unsigned long)(ow_sensors[0].conversions +
+                         ow_sensors[1].conversions));
+  fflush(stdout);
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef MCUCONF_H
+#define MCUCONF_H
+
+/*
+ * Simulator drivers configuration.
+ */
+#define SIM_I2C_USE_I2C1                    TRUE
+#define SIM_I2C_USE_I2C2                    FALSE
+#define SIM_SPI_USE_SPI1                    TRUE
+#define SIM_SPI_USE_SPI2                    FALSE
+#define SIM_PWM_USE_PWM1                    TRUE
+#define SIM_PWM_USE_PWM2                    FALSE
+#define SIM_NAND_USE_NAND1                  TRUE
+
+#endif /* MCUCONF_H */
@@ -16,6 +16,7 @@
 
 #include "fault_handlers.h"
 #include "hal.h"
+#include <stddef.h>
 #include <string.h>
 
 #ifndef FAULT_NO_PRINT
@@ -160,11 +161,228 @@ static void _save_fault_info(void) {
 	}
 }
 
+#if defined(FAULT_CRASH_RECORD)
+
+#ifndef FAULT_CRASH_RECORD_SECTION
+#define FAULT_CRASH_RECORD_SECTION		".ram0.fault_crash_record"
+#endif
+
+/* not cleared by the startup code, survives a reset */
+static struct fault_crash_record crash_record
+		__attribute__((section(FAULT_CRASH_RECORD_SECTION), aligned(4)));
+
+extern uint32_t __main_stack_end__;
+
+/* Rotate and xor over the record words, the checksum field counts as 0. */
+static uint32_t _crash_checksum(const struct fault_crash_record *record) {
+	const uint32_t *wp = (const uint32_t *)record;
+	uint32_t sum = FAULT_CRASH_RECORD_MAGIC;
+	size_t i;
+
+	for (i = 0; i < sizeof(*record) / sizeof(uint32_t); i++) {
+		uint32_t w = (&wp[i] == &record->checksum) ? 0U : wp[i];
+		sum = ((sum << 1) | (sum >> 31)) ^ w;
+	}
+	return sum;
+}
+
+static bool _crash_record_valid(void) {
+	return (crash_record.magic == FAULT_CRASH_RECORD_MAGIC)
+			&& (crash_record.version == FAULT_CRASH_RECORD_VERSION)
+			&& (crash_record.size == sizeof(crash_record))
+			&& (crash_record.checksum == _crash_checksum(&crash_record));
+}
+
+static void _crash_registers(uint32_t msp, uint32_t exc_return,
+		const uint32_t *r4_r11) {
+	const uint32_t *frame;
+	uint32_t sp;
+	unsigned i;
+
+	frame = (const uint32_t *)((exc_return & 4U) ? __get_PSP() : msp);
+
+	crash_record.exc_return = exc_return;
+	crash_record.msp = msp;
+	crash_record.psp = __get_PSP();
+
+	/* exception frame: r0-r3, r12, lr, pc, xpsr */
+	for (i = 0; i < 4; i++)
+		crash_record.r[i] = frame[i];
+	for (i = 0; i < 8; i++)
+		crash_record.r[4 + i] = r4_r11[i];
+	crash_record.r[12] = frame[4];
+	crash_record.lr = frame[5];
+	crash_record.pc = frame[6];
+	crash_record.xpsr = frame[7];
+
+	/* sp before stacking: skip the frame, the FPU part and the padding */
+	sp = (uint32_t)frame + ((exc_return & 16U) ? 32U : 104U);
+	if (crash_record.xpsr & (1U << 9))
+		sp += 4U;
+	crash_record.sp = sp;
+}
+
+static void _crash_stack_window(void) {
+	const uint32_t *wp = (const uint32_t *)crash_record.sp;
+	unsigned n = FAULT_CRASH_STACK_WORDS;
+
+	/* the stack pointer itself can't be trusted after a stacking error */
+	if (crash_record.cfsr & (SCB_CFSR_MSTKERR_Msk | SCB_CFSR_STKERR_Msk))
+		return;
+
+	/* don't read past the top of the main stack */
+	if (!(crash_record.exc_return & 4U)) {
+		uint32_t left;
+
+		if (crash_record.sp > (uint32_t)&__main_stack_end__)
+			return;
+		left = ((uint32_t)&__main_stack_end__ - crash_record.sp) / 4U;
+		if (n > left)
+			n = left;
+	}
+
+	memcpy(crash_record.stack, wp, n * sizeof(uint32_t));
+	crash_record.stack_words = (uint8_t)n;
+}
+
+#if CH_CFG_USE_REGISTRY == TRUE
+static uint32_t _crash_stack_free(const thread_t *tp) {
+#if (CH_DBG_FILL_THREADS == TRUE) && \
+		((CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE))
+	const uint8_t *p = (const uint8_t *)tp->wabase;
+
+	/* the thread structure sits at the top of its working area */
+	while ((p < (const uint8_t *)tp) && (*p == CH_DBG_STACK_FILL_VALUE))
+		p++;
+	return (uint32_t)(p - (const uint8_t *)tp->wabase);
+#else
+	(void)tp;
+	return 0xffffffffU;
+#endif
+}
+
+static void _crash_threads(void) {
+	ch_queue_t *qp = REG_HEADER(currcore)->next;
+	unsigned n = 0;
+
+	/* no locking, the list may be corrupted: bounded walk */
+	while ((qp != NULL) && (qp != REG_HEADER(currcore))
+			&& (n < FAULT_CRASH_MAX_THREADS)) {
+		const thread_t *tp = (const thread_t *)(void *)
+				((uint8_t *)qp - offsetof(thread_t, rqueue));
+		struct fault_crash_thread *ctp = &crash_record.threads[n++];
+
+		ctp->address = (uint32_t)tp;
+		ctp->name = (uint32_t)tp->name;
+#if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
+		ctp->stack_base = (uint32_t)tp->wabase;
+#endif
+		ctp->stack_free = _crash_stack_free(tp);
+		ctp->prio = (uint8_t)tp->hdr.pqueue.prio;
+		ctp->state = (uint8_t)tp->state;
+		qp = qp->next;
+	}
+	crash_record.thread_count = (uint8_t)n;
+}
+#endif
+
+#if CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED
+static void _crash_trace(void) {
+	const trace_buffer_t *tbp = &currcore->trace_buffer;
+	size_t size = sizeof(trace_event_t);
+	unsigned n = FAULT_CRASH_TRACE_EVENTS;
+	unsigned i, idx;
+
+	if (size > FAULT_CRASH_TRACE_EVENT_SIZE)
+		size = FAULT_CRASH_TRACE_EVENT_SIZE;
+	if (n > CH_DBG_TRACE_BUFFER_SIZE)
+		n = CH_DBG_TRACE_BUFFER_SIZE;
+
+	/* ptr is the next slot to be written, the oldest event */
+	idx = (unsigned)(tbp->ptr - &tbp->buffer[0]);
+	idx = (idx + CH_DBG_TRACE_BUFFER_SIZE - n) % CH_DBG_TRACE_BUFFER_SIZE;
+	for (i = 0; i < n; i++) {
+		memcpy(crash_record.trace[i], &tbp->buffer[idx], size);
+		idx = (idx + 1) % CH_DBG_TRACE_BUFFER_SIZE;
+	}
+	crash_record.trace_count = (uint8_t)n;
+	crash_record.trace_event_size = (uint8_t)size;
+}
+#endif
+
+static void _save_crash_record(uint32_t msp, uint32_t exc_return,
+		const uint32_t *r4_r11) {
+	uint32_t count = _crash_record_valid() ? crash_record.count + 1U : 1U;
+
+	memset(&crash_record, 0, sizeof(crash_record));
+	crash_record.magic = FAULT_CRASH_RECORD_MAGIC;
+	crash_record.version = FAULT_CRASH_RECORD_VERSION;
+	crash_record.size = sizeof(crash_record);
+	crash_record.count = count;
+	crash_record.max_stack_words = FAULT_CRASH_STACK_WORDS;
+	crash_record.max_threads = FAULT_CRASH_MAX_THREADS;
+	crash_record.max_trace = FAULT_CRASH_TRACE_EVENTS;
+	crash_record.systime_size = sizeof(systime_t);
+
+	crash_record.cfsr = SCB->CFSR;
+	crash_record.hfsr = SCB->HFSR;
+	crash_record.dfsr = SCB->DFSR;
+	crash_record.mmfar = SCB->MMFAR;
+	crash_record.bfar = SCB->BFAR;
+	crash_record.afsr = SCB->AFSR;
+	crash_record.current_thread = (uint32_t)currcore->rlist.current;
+
+	_crash_registers(msp, exc_return, r4_r11);
+	_crash_stack_window();
+#if CH_CFG_USE_REGISTRY == TRUE
+	_crash_threads();
+#endif
+#if CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED
+	_crash_trace();
+#endif
+
+	crash_record.checksum = _crash_checksum(&crash_record);
+}
+
+/*
+ * Copies the record left by a fault before the last reset, returns false
+ * if there is none. The record stays valid until faultClearCrashRecord().
+ */
+bool faultGetCrashRecord(struct fault_crash_record *record) {
+	if (!_crash_record_valid())
+		return false;
+	memcpy(record, &crash_record, sizeof(crash_record));
+	return true;
+}
+
+void faultClearCrashRecord(void) {
+	crash_record.magic = 0;
+}
+
+#if defined(FAULT_CRASH_RECORD_HOOK)
+void FAULT_CRASH_RECORD_HOOK(const struct fault_crash_record *record);
+#endif
+
+#endif /* FAULT_CRASH_RECORD */
+
 #if defined(FAULT_INFO_HOOK)
 void FAULT_INFO_HOOK(const struct fault_info *info);
 #endif
 
-void _hardfault_info(void) {
+void _hardfault_info(uint32_t msp, uint32_t exc_return,
+		const uint32_t *r4_r11) {
+#if defined(FAULT_CRASH_RECORD)
+	/* first, before anything else can go wrong */
+	_save_crash_record(msp, exc_return, r4_r11);
+#if defined(FAULT_CRASH_RECORD_HOOK)
+	FAULT_CRASH_RECORD_HOOK(&crash_record);
+#endif
+#else
+	(void)msp;
+	(void)exc_return;
+	(void)r4_r11;
+#endif
+
 	_init_fault_info();
 	fault_printf("HardFault Handler");
 	_save_fault_info();
@@ -172,6 +390,11 @@ void _hardfault_info(void) {
 #if defined(FAULT_INFO_HOOK)
 	FAULT_INFO_HOOK(&fault_info);
 #endif
+
+#if defined(FAULT_CRASH_RESET)
+	if (!(CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk))
+		NVIC_SystemReset();
+#endif
 }
 
 void _hardfault_epilogue(void) __attribute__((used, naked));
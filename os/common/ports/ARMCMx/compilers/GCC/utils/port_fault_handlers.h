@@ -49,4 +49,90 @@ struct decoded_fault_registers {
 	} usagefault;
 };
 
+#if defined(FAULT_CRASH_RECORD)
+
+#define FAULT_CRASH_RECORD_MAGIC		0x48535243U		/* "CRSH" */
+#define FAULT_CRASH_RECORD_VERSION		1U
+
+/* words copied from the stack of the faulting code, starting at its sp */
+#ifndef FAULT_CRASH_STACK_WORDS
+#define FAULT_CRASH_STACK_WORDS			32
+#endif
+
+/* threads found in the registry beyond this number are not recorded */
+#ifndef FAULT_CRASH_MAX_THREADS
+#define FAULT_CRASH_MAX_THREADS			16
+#endif
+
+/* last kernel trace events, needs CH_DBG_TRACE_MASK */
+#ifndef FAULT_CRASH_TRACE_EVENTS
+#define FAULT_CRASH_TRACE_EVENTS		8
+#endif
+
+/* bytes kept of each trace event, trace_event_t is 16 bytes on RT 7 */
+#define FAULT_CRASH_TRACE_EVENT_SIZE	16
+
+struct fault_crash_thread {
+	uint32_t address;
+	/* pointer into the image, resolved by the decoder */
+	uint32_t name;
+	uint32_t stack_base;
+	/* never used stack bytes, 0xffffffff if unknown */
+	uint32_t stack_free;
+	uint8_t prio;
+	uint8_t state;
+	uint16_t reserved;
+};
+
+/*
+ * Binary crash record, little endian, decoded by tools/fault_decode.py.
+ * Keep the two in sync and bump FAULT_CRASH_RECORD_VERSION when changing
+ * the layout.
+ */
+struct fault_crash_record {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t size;
+	/* see fault_handlers_v7m.c, computed with this field set to 0 */
+	uint32_t checksum;
+	/* faults recorded since the record was last cleared */
+	uint32_t count;
+
+	/* registers of the faulting code */
+	uint32_t r[13];
+	uint32_t sp;
+	uint32_t lr;
+	uint32_t pc;
+	uint32_t xpsr;
+	uint32_t exc_return;
+	uint32_t msp;
+	uint32_t psp;
+
+	/* fault status */
+	uint32_t cfsr;
+	uint32_t hfsr;
+	uint32_t dfsr;
+	uint32_t mmfar;
+	uint32_t bfar;
+	uint32_t afsr;
+
+	uint32_t current_thread;
+
+	uint8_t stack_words;
+	uint8_t max_stack_words;
+	uint8_t thread_count;
+	uint8_t max_threads;
+	uint8_t trace_count;
+	uint8_t max_trace;
+	uint8_t trace_event_size;
+	uint8_t systime_size;
+
+	uint32_t stack[FAULT_CRASH_STACK_WORDS];
+	struct fault_crash_thread threads[FAULT_CRASH_MAX_THREADS];
+	/* oldest first */
+	uint8_t trace[FAULT_CRASH_TRACE_EVENTS][FAULT_CRASH_TRACE_EVENT_SIZE];
+};
+
+#endif /* FAULT_CRASH_RECORD */
+
 #endif /* FAULT_HANDLERS_v7m_H_ */
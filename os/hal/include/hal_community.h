@@ -94,6 +94,7 @@
 /* Abstract interfaces.*/
 
 /* Shared headers.*/
+#include "hal_trace_points.h"
 
 /* Normal drivers.*/
 #include "hal_eicu.h"
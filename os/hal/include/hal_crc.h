@@ -49,6 +49,60 @@
 #define CRC_USE_MUTUAL_EXCLUSION        TRUE
 #endif
 
+/**
+ * @brief   Enables the CRC context APIs.
+ * @details A context carries its own parameters and running value. It is
+ *          computed by the CRC unit when the unit can handle its polynomial,
+ *          in software otherwise. Contexts can be interleaved on one unit,
+ *          the unit state is saved and restored around each update.
+ */
+#if !defined(CRC_USE_CONTEXTS) || defined(__DOXYGEN__)
+#define CRC_USE_CONTEXTS                FALSE
+#endif
+
+/**
+ * @brief   Includes the constant CRC-32 table of the table engine.
+ * @details Polynomial 0x04C11DB7, reflected: CRC-32 and CRC-32/JAMCRC.
+ */
+#if !defined(CRC_USE_CRC32_TABLE) || defined(__DOXYGEN__)
+#define CRC_USE_CRC32_TABLE             FALSE
+#endif
+
+/**
+ * @brief   Includes the constant CRC-16/ARC table of the table engine.
+ * @details Polynomial 0x8005, reflected: CRC-16/ARC, CRC-16/MODBUS and
+ *          CRC-16/USB.
+ */
+#if !defined(CRC_USE_CRC16_ARC_TABLE) || defined(__DOXYGEN__)
+#define CRC_USE_CRC16_ARC_TABLE         FALSE
+#endif
+
+/**
+ * @brief   Includes the constant CRC-16/CCITT table of the table engine.
+ * @details Polynomial 0x1021, not reflected: CRC-16/CCITT-FALSE and
+ *          CRC-16/XMODEM.
+ */
+#if !defined(CRC_USE_CRC16_CCITT_TABLE) || defined(__DOXYGEN__)
+#define CRC_USE_CRC16_CCITT_TABLE       FALSE
+#endif
+
+/**
+ * @brief   Includes the constant CRC-8 table of the table engine.
+ * @details Polynomial 0x07, not reflected: CRC-8/SMBUS.
+ */
+#if !defined(CRC_USE_CRC8_TABLE) || defined(__DOXYGEN__)
+#define CRC_USE_CRC8_TABLE              FALSE
+#endif
+
+/**
+ * @brief   Smallest buffer fed to the CRC unit by DMA.
+ * @note    Shorter buffers are written by the CPU, setting up a DMA
+ *          transfer costs more than it saves on them.
+ */
+#if !defined(CRC_DMA_THRESHOLD) || defined(__DOXYGEN__)
+#define CRC_DMA_THRESHOLD               64U
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -57,6 +111,12 @@
 #error "CRC requires at least one LLD driver."
 #endif
 
+#if ((CRC_USE_CRC32_TABLE == TRUE) || (CRC_USE_CRC16_ARC_TABLE == TRUE) ||  \
+     (CRC_USE_CRC16_CCITT_TABLE == TRUE) || (CRC_USE_CRC8_TABLE == TRUE)) &&\
+    (CRC_USE_CONTEXTS != TRUE)
+#error "the constant CRC tables require CRC_USE_CONTEXTS"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -80,6 +140,51 @@ typedef enum {
 #include "crcsw.h" /* Include software LL driver */
 #endif
 
+/**
+ * @brief   Set by low level drivers able to save and restore the unit state.
+ */
+#if !defined(CRC_LLD_SUPPORTS_CONTEXTS) || defined(__DOXYGEN__)
+#define CRC_LLD_SUPPORTS_CONTEXTS       FALSE
+#endif
+
+#if (CRC_USE_CONTEXTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC context engines.
+ */
+typedef enum {
+  CRC_ENGINE_BITWISE,        /* Software, one bit at a time.               */
+  CRC_ENGINE_TABLE,          /* Software, one byte at a time from a table. */
+  CRC_ENGINE_UNIT            /* CRC unit.                                  */
+} crcengine_t;
+
+/**
+ * @brief   CRC context.
+ * @note    Only the mandatory @p CRCConfig fields are used.
+ */
+typedef struct {
+  /**
+   * @brief CRC parameters.
+   */
+  const CRCConfig           *config;
+  /**
+   * @brief Engine selected by @p crcContextObjectInit().
+   */
+  crcengine_t               engine;
+  /**
+   * @brief Running value, in the form used by the engine.
+   */
+  uint32_t                  value;
+  /**
+   * @brief Constant table or table built by @p crcGenerateTable().
+   */
+  const uint32_t            *table;
+  /**
+   * @brief CRC unit used by the @p CRC_ENGINE_UNIT engine.
+   */
+  CRCDriver                 *crcp;
+} CRCContext;
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -132,6 +237,19 @@ typedef enum {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (CRC_USE_CRC32_TABLE == TRUE) && !defined(__DOXYGEN__)
+extern const uint32_t crc_crc32_table[256];
+#endif
+#if (CRC_USE_CRC16_ARC_TABLE == TRUE) && !defined(__DOXYGEN__)
+extern const uint32_t crc_crc16_arc_table[256];
+#endif
+#if (CRC_USE_CRC16_CCITT_TABLE == TRUE) && !defined(__DOXYGEN__)
+extern const uint32_t crc_crc16_ccitt_table[256];
+#endif
+#if (CRC_USE_CRC8_TABLE == TRUE) && !defined(__DOXYGEN__)
+extern const uint32_t crc_crc8_table[256];
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -151,6 +269,14 @@ extern "C" {
   void crcAcquireUnit(CRCDriver *crcp);
   void crcReleaseUnit(CRCDriver *crcp);
 #endif
+#if CRC_USE_CONTEXTS == TRUE
+  bool crcGenerateTable(const CRCConfig *config, uint32_t *table);
+  void crcContextObjectInit(CRCContext *ctxp, const CRCConfig *config,
+                            CRCDriver *crcp, const uint32_t *table);
+  void crcContextReset(CRCContext *ctxp);
+  void crcContextUpdate(CRCContext *ctxp, size_t n, const void *buf);
+  uint32_t crcContextGet(const CRCContext *ctxp);
+#endif
 #ifdef __cplusplus
 }
 #endif
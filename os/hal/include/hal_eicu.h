@@ -35,6 +35,22 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    EICU configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the DMA streaming mode.
+ * @details In streaming mode the captures of one channel are moved by DMA
+ *          into a circular buffer and the application is notified once
+ *          per half buffer instead of once per edge.
+ * @note    Requires DMA support in the low level driver.
+ */
+#if !defined(EICU_USE_DMA) || defined(__DOXYGEN__)
+#define EICU_USE_DMA                FALSE
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -52,7 +68,8 @@ typedef enum {
   EICU_READY,                 /* Ready.                                     */
   EICU_WAITING,               /* Waiting for first edge.                    */
   EICU_ACTIVE,                /* Active cycle phase.                        */
-  EICU_IDLE                   /* Idle cycle phase.                          */
+  EICU_IDLE,                  /* Idle cycle phase.                          */
+  EICU_STREAMING              /* DMA streaming active.                      */
 } eicustate_t;
 
 /**
@@ -90,6 +107,21 @@ typedef struct EICUDriver EICUDriver;
 typedef void (*eicucallback_t)(EICUDriver *eicup, eicuchannel_t channel,
                                uint32_t width, uint32_t period);
 
+/**
+ * @brief EICU streamed capture sample type.
+ */
+typedef uint32_t eicusample_t;
+
+/**
+ * @brief EICU stream notification callback type.
+ *
+ * @param[in] eicup     Pointer to a EICUDriver object
+ * @param[in] buf       Half buffer just filled
+ * @param[in] n         Number of samples in the half buffer
+ */
+typedef void (*eicustreamcb_t)(EICUDriver *eicup, const eicusample_t *buf,
+                               size_t n);
+
 #include "hal_eicu_lld.h"
 
 /*===========================================================================*/
@@ -165,6 +197,20 @@ static inline void _eicu_isr_invoke_pwm_period_cb(EICUDriver *eicup,
 #define _eicu_isr_invoke_overflow_cb(icup) do {                                \
   (eicup)->config->overflow_cb(eicup, 0, 0, 0);                                \
 } while (0)
+
+/**
+ * @brief   Common ISR code, EICU stream half buffer event.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] buf       Half buffer just filled
+ * @param[in] n         Number of samples in the half buffer
+ *
+ * @notapi
+ */
+#define _eicu_isr_invoke_stream_cb(eicup, buf, n) do {                         \
+  if ((eicup)->config->stream_cb != NULL)                                      \
+    (eicup)->config->stream_cb(eicup, buf, n);                                 \
+} while (0)
 /** @} */
 
 /*===========================================================================*/
@@ -180,6 +226,11 @@ extern "C" {
   void eicuStop(EICUDriver *eicup);
   void eicuEnable(EICUDriver *eicup);
   void eicuDisable(EICUDriver *eicup);
+#if EICU_USE_DMA == TRUE
+  void eicuStartStream(EICUDriver *eicup, eicuchannel_t channel,
+                       eicusample_t *buf, size_t n);
+  void eicuStopStream(EICUDriver *eicup);
+#endif
 #ifdef __cplusplus
 }
 #endif
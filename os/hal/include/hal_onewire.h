@@ -43,6 +43,8 @@
 #define ONEWIRE_CMD_SEARCH_ROM            0xF0
 #define ONEWIRE_CMD_MATCH_ROM             0x55
 #define ONEWIRE_CMD_SKIP_ROM              0xCC
+#define ONEWIRE_CMD_OVERDRIVE_SKIP_ROM    0x3C
+#define ONEWIRE_CMD_OVERDRIVE_MATCH_ROM   0x69
 #define ONEWIRE_CMD_CONVERT_TEMP          0x44
 #define ONEWIRE_CMD_READ_SCRATCHPAD       0xBE
 
@@ -59,6 +61,26 @@
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
+/**
+ * @brief   Use UART instead of PWM for time slots generation.
+ * @details Every time slot is single UART character, so with DMA capable
+ *          UART the whole transaction goes without per bit interrupts.
+ *          Overdrive speed needs about 1Mbaud UART.
+ */
+#if !defined(ONEWIRE_USE_UART) || defined(__DOXYGEN__)
+#define ONEWIRE_USE_UART                  FALSE
+#endif
+
+/**
+ * @brief   UART backend slot buffer size.
+ * @details Every byte on bus takes 8 slots, longer transactions are split.
+ *          80 slots are enough for 'match ROM' with function command in
+ *          single transfer.
+ */
+#if !defined(ONEWIRE_UART_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define ONEWIRE_UART_BUFFER_SIZE          80
+#endif
+
 #if ONEWIRE_SYNTH_SEARCH_TEST && !ONEWIRE_USE_SEARCH_ROM
 #error "Synthetic search rom test needs ONEWIRE_USE_SEARCH_ROM"
 #endif
@@ -66,9 +88,23 @@
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
+#if ONEWIRE_USE_UART
+#if !HAL_USE_UART
+#error "1-wire Driver UART backend requires HAL_USE_UART"
+#endif
+
+#if (ONEWIRE_UART_BUFFER_SIZE < 8) || ((ONEWIRE_UART_BUFFER_SIZE % 8) != 0)
+#error "ONEWIRE_UART_BUFFER_SIZE must be a multiple of 8"
+#endif
+
+#if ONEWIRE_SYNTH_SEARCH_TEST
+#error "Synthetic search rom test works with PWM backend only"
+#endif
+#else /* !ONEWIRE_USE_UART */
 #if !HAL_USE_PWM
 #error "1-wire Driver requires HAL_USE_PWM"
 #endif
+#endif /* !ONEWIRE_USE_UART */
 
 #if !HAL_USE_PAL
 #error "1-wire Driver requires HAL_USE_PAL"
@@ -101,6 +137,14 @@ typedef enum {
 #endif
 } onewire_state_t;
 
+/**
+ * @brief   Bus speed.
+ */
+typedef enum {
+  ONEWIRE_SPEED_STANDARD = 0, /**< Standard speed, 70us time slot.          */
+  ONEWIRE_SPEED_OVERDRIVE = 1 /**< Overdrive speed, 10us time slot.         */
+} onewire_speed_t;
+
 #if ONEWIRE_USE_SEARCH_ROM
 /**
  * @brief   Search ROM procedure possible state.
@@ -124,6 +168,33 @@ typedef enum {
  * @brief   Driver configuration structure.
  */
 typedef struct {
+#if ONEWIRE_USE_UART || defined(__DOXYGEN__)
+  /**
+   * @brief Pointer to @p UART driver used for communication.
+   */
+  UARTDriver                *uartd;
+  /**
+   * @brief UART configuration for standard speed reset pulse, 9600 baud.
+   * @note  It is NOT constant because 1-wire driver installs its own
+   *        receive end callback in all UART configurations.
+   */
+  UARTConfig                *uartcfg_reset;
+  /**
+   * @brief UART configuration for standard speed time slots, 115200 baud.
+   */
+  UARTConfig                *uartcfg_data;
+  /**
+   * @brief UART configuration for overdrive reset pulse, 115200 baud.
+   * @note  Usually the same object as @p uartcfg_data. Set it to
+   *        @p NULL if overdrive is not needed.
+   */
+  UARTConfig                *uartcfg_od_reset;
+  /**
+   * @brief UART configuration for overdrive time slots, 1Mbaud.
+   * @note  Set it to @p NULL if overdrive is not needed.
+   */
+  UARTConfig                *uartcfg_od_data;
+#else /* !ONEWIRE_USE_UART */
   /**
    * @brief Pointer to @p PWM driver used for communication.
    */
@@ -150,6 +221,7 @@ typedef struct {
    * @brief Number of PWM channel used as sample interrupt generator.
    */
   size_t                    sample_channel;
+#endif /* !ONEWIRE_USE_UART */
   /**
    * @brief   Port Identifier.
    * @details This type can be a scalar or some kind of pointer, do not make
@@ -283,6 +355,10 @@ typedef struct {
    * @brief   Bool flag for premature timer stop prevention.
    */
   uint32_t      final_timeslot: 1;
+  /**
+   * @brief   Current bus speed (@p onewire_speed_t enum).
+   */
+  uint32_t      speed: 1;
   /**
    * @brief   Bytes number to be processing in current transaction.
    */
@@ -310,16 +386,51 @@ typedef struct {
    * @brief   Search ROM helper structure.
    */
   onewire_search_rom_t  search_rom;
+  /**
+   * @brief   ROMs discovered by last search.
+   */
+  const uint8_t         *roms;
+  /**
+   * @brief   Count of ROMs in @p roms cache.
+   */
+  size_t                roms_cnt;
 #endif /* ONEWIRE_USE_SEARCH_ROM */
   /**
    * @brief   Thread waiting for I/O completion.
    */
   thread_reference_t  thread;
+#if ONEWIRE_USE_UART || defined(__DOXYGEN__)
+  /**
+   * @brief   Currently active UART configuration.
+   */
+  UARTConfig            *uartcfg;
+  /**
+   * @brief   Time slots buffer, transmitted and received in place.
+   * @note    Must be DMA accessible memory.
+   */
+  uint8_t               slots[ONEWIRE_UART_BUFFER_SIZE];
+#endif /* ONEWIRE_USE_UART */
 } onewireDriver;
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
+#if ONEWIRE_USE_SEARCH_ROM || defined(__DOXYGEN__)
+/**
+ * @brief   Count of ROMs cached by last search.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ */
+#define onewireGetRomCount(owp) ((owp)->roms_cnt)
+
+/**
+ * @brief   Pointer to cached ROM code.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] n         index of the ROM in cache
+ */
+#define onewireGetRom(owp, n) (&(owp)->roms[8U * (n)])
+#endif /* ONEWIRE_USE_SEARCH_ROM */
 
 /*===========================================================================*/
 /* External declarations.                                                    */
@@ -334,13 +445,20 @@ extern "C" {
   void onewireStart(onewireDriver *owp, const onewireConfig *config);
   void onewireStop(onewireDriver *owp);
   bool onewireReset(onewireDriver *owp);
-  void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes);
+  msg_t onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes);
   uint8_t onewireCRC(const uint8_t *buf, size_t len);
-  void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
-                    size_t txbytes, systime_t pullup_time);
+  msg_t onewireWrite(onewireDriver *owp, uint8_t *txbuf,
+                     size_t txbytes, systime_t pullup_time);
+  bool onewireSetSpeed(onewireDriver *owp, onewire_speed_t speed);
+  bool onewireSelect(onewireDriver *owp, const uint8_t *rom, uint8_t cmd,
+                     systime_t pullup_time);
+  bool onewireConvertAll(onewireDriver *owp, systime_t pullup_time);
 #if ONEWIRE_USE_SEARCH_ROM
   size_t onewireSearchRom(onewireDriver *owp,
                           uint8_t *result, size_t max_rom_cnt);
+  bool onewireMatchRom(onewireDriver *owp, size_t n, uint8_t cmd);
+  size_t onewireReadScratchpads(onewireDriver *owp, uint8_t *rxbuf,
+                                size_t rxbytes);
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 #if ONEWIRE_SYNTH_SEARCH_TEST
   void _synth_ow_write_bit(onewireDriver *owp, ioline_t bit);
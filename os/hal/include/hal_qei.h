@@ -35,6 +35,55 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    QEI configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the velocity estimator.
+ * @details The low level driver timestamps one encoder edge per reading,
+ *          velocity and acceleration are computed when they are read.
+ */
+#if !defined(QEI_USE_VELOCITY) || defined(__DOXYGEN__)
+#define QEI_USE_VELOCITY                    FALSE
+#endif
+
+/**
+ * @brief   Velocity fixed point scale.
+ * @details Velocities are expressed in 1/QEI_VELOCITY_SCALE counts per
+ *          second, accelerations in 1/QEI_VELOCITY_SCALE counts per
+ *          second squared.
+ */
+#if !defined(QEI_VELOCITY_SCALE) || defined(__DOXYGEN__)
+#define QEI_VELOCITY_SCALE                  1000
+#endif
+
+/**
+ * @brief   Time without edges after which the encoder is considered still.
+ * @note    In milliseconds, it must be shorter than the wrap period of
+ *          the timestamp counter.
+ */
+#if !defined(QEI_VELOCITY_TIMEOUT) || defined(__DOXYGEN__)
+#define QEI_VELOCITY_TIMEOUT                1000
+#endif
+
+/**
+ * @brief   Edge timestamp source.
+ * @details It must return a free running 32 bits counter value, the
+ *          default is the realtime counter.
+ */
+#if !defined(QEI_VELOCITY_TIMESTAMP) || defined(__DOXYGEN__)
+#define QEI_VELOCITY_TIMESTAMP()            halGetCounterValue()
+#endif
+
+/**
+ * @brief   Edge timestamp source frequency in Hz.
+ */
+#if !defined(QEI_VELOCITY_TIMESTAMP_FREQ) || defined(__DOXYGEN__)
+#define QEI_VELOCITY_TIMESTAMP_FREQ         halGetCounterFrequency()
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -91,6 +140,80 @@ typedef enum {
 #endif
 } qeioverflow_t;
 
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   QEI velocity type.
+ */
+typedef int32_t qeivelocity_t;
+
+/**
+ * @brief   Motion estimate.
+ */
+typedef struct {
+  /**
+   * @brief   Velocity in 1/QEI_VELOCITY_SCALE counts per second.
+   */
+  qeivelocity_t             velocity;
+  /**
+   * @brief   Acceleration in 1/QEI_VELOCITY_SCALE counts per second
+   *          squared.
+   */
+  qeivelocity_t             acceleration;
+} qeimotion_t;
+
+/**
+ * @brief   Velocity estimator state.
+ * @details Each reading arms the low level driver, which records the
+ *          count and the time of the next encoder edge. Velocity is the
+ *          count change between two such edges divided by the time
+ *          between them, so it is period based when the encoder is slow
+ *          and count based when it is fast, with no quantization error
+ *          from the reading instant.
+ */
+typedef struct {
+  /**
+   * @brief   Waiting for an edge, cleared by the low level driver.
+   */
+  volatile bool             armed;
+  /**
+   * @brief   Count at the recorded edge.
+   */
+  volatile int32_t          edge_count;
+  /**
+   * @brief   Timestamp of the recorded edge.
+   */
+  volatile uint32_t         edge_time;
+  /**
+   * @brief   A reference edge is available.
+   */
+  bool                      primed;
+  /**
+   * @brief   Count at the reference edge.
+   */
+  int32_t                   ref_count;
+  /**
+   * @brief   Timestamp of the reference edge.
+   */
+  uint32_t                  ref_time;
+  /**
+   * @brief   Count change over the last window.
+   */
+  int32_t                   step;
+  /**
+   * @brief   Duration of the last window, zero if none.
+   */
+  uint32_t                  period;
+  /**
+   * @brief   Velocity over the last window.
+   */
+  qeivelocity_t             window_velocity;
+  /**
+   * @brief   Latest estimate.
+   */
+  qeimotion_t               motion;
+} qeiestimator_t;
+#endif /* QEI_USE_VELOCITY == TRUE */
+
 
 #include "hal_qei_lld.h"
 
@@ -130,6 +253,33 @@ typedef enum {
  * @iclass
  */
 #define qeiGetCountI(qeip) qei_lld_get_count(qeip)
+/** @} */
+
+/**
+ * @name    Low level driver helper macros
+ * @{
+ */
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Records an encoder edge for the velocity estimator.
+ * @details Only the first edge after the estimator has been armed is
+ *          recorded.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ * @param[in] count     counter value at the edge
+ * @param[in] time      timestamp of the edge
+ *
+ * @notapi
+ */
+#define _qei_isr_velocity_edge(qeip, count, time) {                         \
+  if ((qeip)->vel.armed) {                                                  \
+    (qeip)->vel.edge_count = (int32_t)(count);                              \
+    (qeip)->vel.edge_time  = (time);                                        \
+    (qeip)->vel.armed      = false;                                         \
+  }                                                                         \
+}
+#endif
+/** @} */
 
 /*===========================================================================*/
 /* External declarations.                                                    */
@@ -149,6 +299,11 @@ extern "C" {
   qeidelta_t qeiUpdate(QEIDriver *qeip);
   qeidelta_t qeiUpdateI(QEIDriver *qeip);
   qeidelta_t qeiAdjustI(QEIDriver *qeip, qeidelta_t delta);
+#if QEI_USE_VELOCITY == TRUE
+  void qeiGetMotion(QEIDriver *qeip, qeimotion_t *mp);
+  void qeiGetMotionI(QEIDriver *qeip, qeimotion_t *mp);
+  qeivelocity_t qeiGetVelocity(QEIDriver *qeip);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,22 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    TIMCAP configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the DMA streaming mode.
+ * @details In streaming mode the captures of one channel are moved by DMA
+ *          into a circular buffer and the application is notified once
+ *          per half buffer instead of once per edge.
+ * @note    Requires DMA support in the low level driver.
+ */
+#if !defined(TIMCAP_USE_DMA) || defined(__DOXYGEN__)
+#define TIMCAP_USE_DMA                      FALSE
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -59,6 +75,7 @@ typedef enum {
   TIMCAP_WAITING = 3,                  /**< Waiting first edge.                */
   TIMCAP_ACTIVE = 4,                   /**< Active cycle phase.                */
   TIMCAP_IDLE = 5,                     /**< Idle cycle phase.                  */
+  TIMCAP_STREAMING = 6,                /**< DMA streaming active.              */
 } timcapstate_t;
 
 /**
@@ -74,6 +91,21 @@ typedef struct TIMCAPDriver TIMCAPDriver;
  */
 typedef void (*timcapcallback_t)(TIMCAPDriver *timcapp);
 
+/**
+ * @brief   TIMCAP streamed capture sample type.
+ */
+typedef uint32_t timcapsample_t;
+
+/**
+ * @brief   TIMCAP stream notification callback type.
+ *
+ * @param[in] timcapp      pointer to a @p TIMCAPDriver object
+ * @param[in] buf          pointer to the half buffer just filled
+ * @param[in] n            number of samples in the half buffer
+ */
+typedef void (*timcapstreamcb_t)(TIMCAPDriver *timcapp,
+                                 const timcapsample_t *buf, size_t n);
+
 #include "hal_timcap_lld.h"
 
 /*===========================================================================*/
@@ -179,6 +211,20 @@ typedef void (*timcapcallback_t)(TIMCAPDriver *timcapp);
 #define _timcap_isr_invoke_overflow_cb(timcapp) {                                 \
   (timcapp)->config->overflow_cb(timcapp);                                        \
 }
+
+/**
+ * @brief   Common ISR code, TIMCAP stream half buffer event.
+ *
+ * @param[in] timcapp      pointer to the @p TIMCAPDriver object
+ * @param[in] buf          pointer to the half buffer just filled
+ * @param[in] n            number of samples in the half buffer
+ *
+ * @notapi
+ */
+#define _timcap_isr_invoke_stream_cb(timcapp, buf, n) {                           \
+  if ((timcapp)->config->stream_cb != NULL)                                       \
+    (timcapp)->config->stream_cb(timcapp, buf, n);                                \
+}
 /** @} */
 
 /*===========================================================================*/
@@ -194,6 +240,11 @@ extern "C" {
   void timcapStop(TIMCAPDriver *timcapp);
   void timcapEnable(TIMCAPDriver *timcapp);
   void timcapDisable(TIMCAPDriver *timcapp);
+#if TIMCAP_USE_DMA == TRUE
+  void timcapStartStream(TIMCAPDriver *timcapp, timcapchannel_t channel,
+                         timcapsample_t *buf, size_t n);
+  void timcapStopStream(TIMCAPDriver *timcapp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,151 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_trace_points.h
+ * @brief   Driver trace points.
+ * @details Drivers mark the start and the end of their transactions with
+ *          @p _hal_trace_point(), a trace backend records them on the same
+ *          timeline as the kernel events. The SystemView binding in
+ *          os/various/segger_bindings registers one SystemView module per
+ *          driver and implements @p halTracePoint().
+ *          With @p HAL_USE_TRACE_POINTS set to @p FALSE the trace points
+ *          expand to nothing and their arguments are not evaluated.
+ *
+ * @addtogroup HAL_TRACE_POINTS
+ * @{
+ */
+
+#ifndef HAL_TRACE_POINTS_H
+#define HAL_TRACE_POINTS_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Trace modules
+ * @{
+ */
+#define HAL_TRACE_MODULE_USBH               0U
+#define HAL_TRACE_MODULE_SCSI               1U
+#define HAL_TRACE_MODULE_EE24XX             2U
+#define HAL_TRACE_MODULE_DMA2D              3U
+#define HAL_TRACE_MODULES                   4U
+/** @} */
+
+/**
+ * @name    USBH trace events
+ * @{
+ */
+/** @brief URB submitted, URB, endpoint address, requested length.*/
+#define HAL_TRACE_USBH_URB_SUBMIT           0U
+/** @brief URB completed, URB, status, actual length.*/
+#define HAL_TRACE_USBH_URB_COMPLETE         1U
+/** @} */
+
+/**
+ * @name    SCSI trace events
+ * @{
+ */
+/** @brief Command started, opcode, LBA, blocks.*/
+#define HAL_TRACE_SCSI_CMD_START            0U
+/** @brief Command ended, opcode, result, residue.*/
+#define HAL_TRACE_SCSI_CMD_END              1U
+/** @} */
+
+/**
+ * @name    EE24XX trace events
+ * @{
+ */
+/** @brief Page write started, I2C address, offset, length.*/
+#define HAL_TRACE_EE24XX_PAGE_WRITE_START   0U
+/** @brief Page write cycle ended, I2C address, offset, status.*/
+#define HAL_TRACE_EE24XX_PAGE_WRITE_END     1U
+/** @} */
+
+/**
+ * @name    DMA2D trace events
+ * @{
+ */
+/** @brief Job started, mode, width, height.*/
+#define HAL_TRACE_DMA2D_JOB_START           0U
+/** @brief Job ended, ISR flags, 0, 0.*/
+#define HAL_TRACE_DMA2D_JOB_END             1U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Enables the driver trace points.
+ * @note    A trace backend providing @p halTracePoint() must be linked.
+ */
+#if !defined(HAL_USE_TRACE_POINTS) || defined(__DOXYGEN__)
+#define HAL_USE_TRACE_POINTS                FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Records a driver trace point.
+ * @note    Callable from any context, the backend must not block.
+ *
+ * @param[in] module    trace module
+ * @param[in] event     event number within the module
+ * @param[in] a         first event argument
+ * @param[in] b         second event argument
+ * @param[in] c         third event argument
+ *
+ * @notapi
+ */
+#if (HAL_USE_TRACE_POINTS == TRUE) || defined(__DOXYGEN__)
+#define _hal_trace_point(module, event, a, b, c)                            \
+  halTracePoint((module), (event), (uint32_t)(a), (uint32_t)(b),            \
+                (uint32_t)(c))
+#else
+#define _hal_trace_point(module, event, a, b, c) do {} while (false)
+#endif
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (HAL_USE_TRACE_POINTS == TRUE) || defined(__DOXYGEN__)
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void halTracePoint(uint32_t module, uint32_t event,
+                     uint32_t a, uint32_t b, uint32_t c);
+#ifdef __cplusplus
+}
+#endif
+#endif /* HAL_USE_TRACE_POINTS == TRUE */
+
+#endif /* HAL_TRACE_POINTS_H */
+
+/** @} */
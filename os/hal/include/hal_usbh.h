@@ -56,6 +56,22 @@
 #define HAL_USBH_USE_IAD     HAL_USBH_USE_UVC
 #endif
 
+/* Binary debug log: usbDbgPrintf/usbDbgPuts only store the format string
+ * pointer, a time stamp and the raw arguments, the debug thread formats them.
+ * Format strings and usbDbgPuts strings must be static; %s arguments are
+ * copied (up to USBH_DEBUG_BINARY_MAX_STRING characters). */
+#ifndef USBH_DEBUG_BINARY
+#define USBH_DEBUG_BINARY	FALSE
+#endif
+
+#ifndef USBH_DEBUG_BINARY_MAX_ARGS
+#define USBH_DEBUG_BINARY_MAX_ARGS	8
+#endif
+
+#ifndef USBH_DEBUG_BINARY_MAX_STRING
+#define USBH_DEBUG_BINARY_MAX_STRING	32
+#endif
+
 #if (HAL_USE_USBH == TRUE) || defined(__DOXYGEN__)
 
 #include "osal.h"
@@ -244,6 +260,20 @@ struct usbh_port {
 
 
 #if USBH_DEBUG_ENABLE
+#if USBH_DEBUG_BINARY
+/* Binary record ring: the producers store the format string pointer, the
+ * time stamp and the raw arguments, usb_debug_thread formats them later.
+ * Indexes are in words, the ring is empty when rd == wr. */
+struct usbh_bq {
+	uint32_t *start;
+	uint32_t sz;
+	volatile uint32_t rd;
+	volatile uint32_t wr;
+	uint32_t dropped;
+};
+
+typedef struct usbh_bq usbh_bq_t;
+#else
 struct usbh_dq {
 	int rem;
 	int sz;
@@ -254,11 +284,18 @@ struct usbh_dq {
 };
 
 typedef struct usbh_dq usbh_dq_t;
+#endif
 
 struct usbh_debug_helper {
+#if USBH_DEBUG_BINARY
+	uint32_t buff[USBH_DEBUG_BUFFER / 4];
+	THD_WORKING_AREA(thd_wa, 1024);
+	usbh_bq_t bq;
+#else
 	uint8_t buff[USBH_DEBUG_BUFFER];
 	THD_WORKING_AREA(thd_wa, 512);
 	usbh_dq_t dq;
+#endif
 	systime_t first;
 	systime_t last;
 	bool ena;
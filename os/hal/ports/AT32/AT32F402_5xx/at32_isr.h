@@ -113,6 +113,13 @@
 #define AT32_DMA2_CH7_NUMBER               69
 #define AT32_DMAMUX_NUMBER                 94
 
+/*
+ * FLASH unit.
+ */
+#define AT32_FLASH_HANDLER                 Vector50
+
+#define AT32_FLASH_NUMBER                  4
+
 /*
  * EXINT unit.
  */
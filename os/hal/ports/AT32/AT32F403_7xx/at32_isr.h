@@ -124,6 +124,13 @@
 #define DMA2_CH6_CMASK                     0x00003000U
 #define DMA2_CH7_CMASK                     0x00003000U
 
+/*
+ * FLASH unit.
+ */
+#define AT32_FLASH_HANDLER                 Vector50
+
+#define AT32_FLASH_NUMBER                  4
+
 /*
  * EXINT unit.
  */
@@ -35,6 +35,17 @@
 #define AT32_FLASH_LINE_SIZE               2U
 #define AT32_FLASH_LINE_MASK               (AT32_FLASH_LINE_SIZE - 1U)
 
+#define AT32_FLASH_WORD_SIZE               4U
+#define AT32_FLASH_WORD_MASK               (AT32_FLASH_WORD_SIZE - 1U)
+
+/* Not in the CMSIS header.*/
+#if !defined(FLASH_CTRL_ERRIE)
+#define FLASH_CTRL_ERRIE                   (0x1U << 10)
+#endif
+#if !defined(FLASH_CTRL_ODFIE)
+#define FLASH_CTRL_ODFIE                   (0x1U << 12)
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -89,7 +100,7 @@ static inline void at32_flash_disable_pgm(EFlashDriver *eflp) {
 
 static inline void at32_flash_clear_status(EFlashDriver *eflp) {
   
-  eflp->flash->STS = FLASH_STS_PRGMERR | FLASH_STS_EPPERR;
+  eflp->flash->STS = FLASH_STS_PRGMERR | FLASH_STS_EPPERR | FLASH_STS_ODF;
 }
 
 static inline uint32_t at32_flash_is_busy(EFlashDriver *eflp) {
@@ -104,10 +115,163 @@ static inline void at32_flash_wait_busy(EFlashDriver *eflp) {
   }
 }
 
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+static inline void at32_flash_enable_irq(EFlashDriver *eflp) {
+
+  eflp->flash->CTRL |= FLASH_CTRL_ERRIE | FLASH_CTRL_ODFIE;
+}
+
+static inline void at32_flash_disable_irq(EFlashDriver *eflp) {
+
+  eflp->flash->CTRL &= ~(FLASH_CTRL_ERRIE | FLASH_CTRL_ODFIE);
+}
+#endif
+
+/**
+ * @brief   Writes the next program unit.
+ * @details Aligned data is written a 32 bits word at a time, unaligned
+ *          ends use the halfword lines, padded with ones.
+ */
+static void at32_flash_pgm_issue(at32_efl_pgm_t *pgm) {
+  uint8_t *address = efl_lld_descriptor.address + pgm->offset;
+
+  if (((pgm->offset & AT32_FLASH_WORD_MASK) == 0U) &&
+      (pgm->n >= AT32_FLASH_WORD_SIZE)) {
+    uint32_t word;
+
+    memcpy(&word, pgm->pp, AT32_FLASH_WORD_SIZE);
+    pgm->address = address;
+    pgm->data    = word;
+    pgm->width   = AT32_FLASH_WORD_SIZE;
+    pgm->offset += AT32_FLASH_WORD_SIZE;
+    pgm->pp     += AT32_FLASH_WORD_SIZE;
+    pgm->n      -= AT32_FLASH_WORD_SIZE;
+
+    *(volatile uint32_t *)address = word;
+  }
+  else {
+    union {
+      uint16_t  hw[AT32_FLASH_LINE_SIZE / sizeof (uint16_t)];
+      uint8_t   b[AT32_FLASH_LINE_SIZE / sizeof (uint8_t)];
+    } line;
+
+    /* Unwritten bytes are initialized to all ones.*/
+    line.hw[0] = 0xFFFFU;
+
+    /* Programming address aligned to flash lines.*/
+    address -= pgm->offset & AT32_FLASH_LINE_MASK;
+
+    /* Copying data inside the prepared line.*/
+    do {
+      line.b[pgm->offset & AT32_FLASH_LINE_MASK] = *pgm->pp;
+      pgm->offset++;
+      pgm->n--;
+      pgm->pp++;
+    }
+    while ((pgm->n > 0U) && ((pgm->offset & AT32_FLASH_LINE_MASK) != 0U));
+
+    pgm->address = address;
+    pgm->data    = line.hw[0];
+    pgm->width   = AT32_FLASH_LINE_SIZE;
+
+    *(volatile uint16_t *)address = line.hw[0];
+  }
+}
+
+/**
+ * @brief   Prepares a program operation.
+ */
+static void at32_flash_pgm_setup(EFlashDriver *eflp, flash_offset_t offset,
+                                 size_t n, const uint8_t *pp) {
+
+  eflp->pgm.offset = offset;
+  eflp->pgm.n      = n;
+  eflp->pgm.pp     = pp;
+  eflp->pgm.width  = 0U;
+}
+
+/**
+ * @brief   Checks the outcome of the last program unit.
+ */
+static flash_error_t at32_flash_pgm_check(EFlashDriver *eflp) {
+  at32_efl_pgm_t *pgm = &eflp->pgm;
+  uint32_t sts = eflp->flash->STS;
+  uint8_t width = pgm->width;
+
+  /* Clearing error status bits.*/
+  at32_flash_clear_status(eflp);
+  pgm->width = 0U;
+
+  /* Decoding relevant errors.*/
+  if ((sts & FLASH_STS_EPPERR) != 0U) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  if (((sts & FLASH_STS_PRGMERR) != 0U) || ((sts & FLASH_STS_ODF) == 0U)) {
+    return FLASH_ERROR_PROGRAM;
+  }
+
+  /* Check for flash error.*/
+  if (width == AT32_FLASH_WORD_SIZE) {
+    if (*(volatile uint32_t *)pgm->address != pgm->data) {
+      return FLASH_ERROR_PROGRAM;
+    }
+  }
+  else if (*(volatile uint16_t *)pgm->address != (uint16_t)pgm->data) {
+    return FLASH_ERROR_PROGRAM;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Program operation-done/error interrupt service.
+ * @details Checks the finished unit and writes the next one, the waiting
+ *          thread is resumed at the end or on the first error.
+ */
+static void at32_flash_serve_interrupt(EFlashDriver *eflp) {
+  at32_efl_pgm_t *pgm = &eflp->pgm;
+
+  if ((pgm->width == 0U) || (at32_flash_is_busy(eflp) != 0U)) {
+    return;
+  }
+
+  eflp->pgm_err = at32_flash_pgm_check(eflp);
+  if ((eflp->pgm_err == FLASH_NO_ERROR) && (pgm->n > 0U)) {
+    at32_flash_pgm_issue(pgm);
+    return;
+  }
+
+  at32_flash_disable_irq(eflp);
+  at32_flash_disable_pgm(eflp);
+
+  osalSysLockFromISR();
+  eflp->state = FLASH_READY;
+  osalThreadResumeI(&eflp->pgm_thread, (msg_t)eflp->pgm_err);
+  osalSysUnlockFromISR();
+}
+#endif /* AT32_EFL_USE_ASYNC_PROGRAM == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   FLASH interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(AT32_FLASH_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  at32_flash_serve_interrupt(&EFLD1);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -135,6 +299,9 @@ void efl_lld_start(EFlashDriver *eflp) {
 
   at32_flash_unlock(eflp);
   eflp->flash->CTRL = 0x00000000U;
+#if AT32_EFL_USE_ASYNC_PROGRAM == TRUE
+  nvicEnableVector(AT32_FLASH_NUMBER, AT32_EFL_IRQ_PRIORITY);
+#endif
 }
 
 /**
@@ -147,6 +314,9 @@ void efl_lld_start(EFlashDriver *eflp) {
 void efl_lld_stop(EFlashDriver *eflp) {
 
   at32_flash_lock(eflp);
+#if AT32_EFL_USE_ASYNC_PROGRAM == TRUE
+  nvicDisableVector(AT32_FLASH_NUMBER);
+#endif
 }
 
 /**
@@ -213,6 +383,7 @@ flash_error_t efl_lld_read(void *instance, flash_offset_t offset,
  * @brief   Program operation.
  * @note    It is only possible to write erased pages once except
  *          when writing all zeroes.
+ * @note    Aligned data is programmed in 32 bits words.
  *
  * @param[in] ip                    pointer to a @p EFlashDriver instance
  * @param[in] offset                flash offset
@@ -245,6 +416,8 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
   /* FLASH_PGM state while the operation is performed.*/
   devp->state = FLASH_PGM;
 
+  at32_flash_pgm_setup(devp, offset, n, pp);
+
   /* Clearing error status bits.*/
   at32_flash_clear_status(devp);
 
@@ -252,67 +425,101 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
   at32_flash_enable_pgm(devp);
 
   /* Actual program implementation.*/
-  while (n > 0U) {
-    volatile uint16_t *address;
-
-    union {
-      uint16_t  hw[AT32_FLASH_LINE_SIZE / sizeof (uint16_t)];
-      uint8_t   b[AT32_FLASH_LINE_SIZE / sizeof (uint8_t)];
-    } line;
+  while ((err == FLASH_NO_ERROR) && (devp->pgm.n > 0U)) {
+    at32_flash_pgm_issue(&devp->pgm);
+    at32_flash_wait_busy(devp);
+    err = at32_flash_pgm_check(devp);
+  }
 
-    /* Unwritten bytes are initialized to all ones.*/
-    line.hw[0] = 0xFFFFU;
+  /* Disabling PGM mode in the controller.*/
+  at32_flash_disable_pgm(devp);
 
-    /* Programming address aligned to flash lines.*/
-    address = (volatile uint16_t *)(efl_lld_descriptor.address +
-                                    (offset & ~AT32_FLASH_LINE_MASK));
+  /* Ready state again.*/
+  devp->state = FLASH_READY;
 
-    /* Copying data inside the prepared line.*/
-    do {
-      line.b[offset & AT32_FLASH_LINE_MASK] = *pp;
-      offset++;
-      n--;
-      pp++;
-    }
-    while ((n > 0U) & ((offset & AT32_FLASH_LINE_MASK) != 0U));
-    /* Programming line.*/
-    address[0] = line.hw[0];
-    at32_flash_wait_busy(devp);
+  return err;
+}
 
-    uint32_t sts = devp->flash->STS;
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous program operation.
+ * @details The first unit is written here, the following ones from the
+ *          FLASH interrupt, the calling thread is free to run.
+ * @note    The data buffer must stay valid until the operation ends.
+ * @note    The flash must not be read until the operation ends, code
+ *          executing from the bank being programmed stalls anyway.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[in] offset                flash offset
+ * @param[in] n                     number of bytes to be programmed
+ * @param[in] pp                    pointer to the data buffer
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if the operation has been started.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ *
+ * @api
+ */
+flash_error_t efl_lld_start_program(void *instance, flash_offset_t offset,
+                                    size_t n, const uint8_t *pp) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
 
-    /* Clearing error status bits.*/
-    at32_flash_clear_status(devp);
+  osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= (size_t)efl_lld_descriptor.size);
 
-    /* Decoding relevant errors.*/
-    if ((sts & FLASH_STS_EPPERR) != 0U) {
-      err = FLASH_ERROR_HW_FAILURE;
-      break;
-    }
-    else if ((sts & FLASH_STS_PRGMERR) != 0U) {
-      err = FLASH_ERROR_PROGRAM;
-      break;
-    }
-    else if ((sts & FLASH_STS_ODF) == 0U) {
-      err = FLASH_ERROR_PROGRAM;
-      break;
-    }
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
 
-    /* Check for flash error.*/
-    if (address[0] != line.hw[0]) {
-      err = FLASH_ERROR_PROGRAM;
-      break;
-    }
+  /* No programming while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
   }
 
-  /* Disabling PGM mode in the controller.*/
-  at32_flash_disable_pgm(devp);
+  /* FLASH_PGM state until the interrupt handler completes.*/
+  devp->state   = FLASH_PGM;
+  devp->pgm_err = FLASH_NO_ERROR;
 
-  /* Ready state again.*/
-  devp->state = FLASH_READY;
+  at32_flash_pgm_setup(devp, offset, n, pp);
 
-  return err;
+  osalSysLock();
+  at32_flash_clear_status(devp);
+  at32_flash_enable_pgm(devp);
+  at32_flash_enable_irq(devp);
+  at32_flash_pgm_issue(&devp->pgm);
+  osalSysUnlock();
+
+  return FLASH_NO_ERROR;
+}
+
+/**
+ * @brief   Waits for the end of an asynchronous program operation.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @return                          The outcome of the last asynchronous
+ *                                  program operation.
+ * @retval FLASH_NO_ERROR           if the data has been programmed.
+ * @retval FLASH_ERROR_PROGRAM      if the program operation failed.
+ * @retval FLASH_ERROR_HW_FAILURE   if access to the memory failed.
+ *
+ * @api
+ */
+flash_error_t efl_lld_wait_program(void *instance) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+  msg_t msg;
+
+  osalDbgCheck(instance != NULL);
+
+  osalSysLock();
+  if (devp->state == FLASH_PGM) {
+    msg = osalThreadSuspendS(&devp->pgm_thread);
+  }
+  else {
+    msg = (msg_t)devp->pgm_err;
+  }
+  osalSysUnlock();
+
+  return (flash_error_t)msg;
 }
+#endif /* AT32_EFL_USE_ASYNC_PROGRAM == TRUE */
 
 /**
  * @brief   Starts a whole-device erase operation.
@@ -148,6 +148,13 @@
 #define AT32_EDMA1_CH7_NUMBER              17
 #define AT32_EDMA1_CH8_NUMBER              47
 
+/*
+ * FLASH unit.
+ */
+#define AT32_FLASH_HANDLER                 Vector50
+
+#define AT32_FLASH_NUMBER                  4
+
 /*
  * EXINT unit.
  */
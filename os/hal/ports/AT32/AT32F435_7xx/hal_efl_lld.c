@@ -35,6 +35,20 @@
 #define AT32_FLASH_LINE_SIZE               2U
 #define AT32_FLASH_LINE_MASK               (AT32_FLASH_LINE_SIZE - 1U)
 
+#define AT32_FLASH_WORD_SIZE               4U
+#define AT32_FLASH_WORD_MASK               (AT32_FLASH_WORD_SIZE - 1U)
+
+/* Not in the CMSIS header.*/
+#if !defined(FLASH_CTRL_ERRIE)
+#define FLASH_CTRL_ERRIE                   (0x1U << 10)
+#endif
+#if !defined(FLASH_CTRL_ODFIE)
+#define FLASH_CTRL_ODFIE                   (0x1U << 12)
+#endif
+
+#define AT32_FLASH_BANK2_OFFSET                                             \
+  ((flash_offset_t)(FLASH_BANK2_START_ADDR - FLASH_BASE))
+
 #define AT32_FLASH_GET_BANK(addr, bank)                                            \
 do {                                                                               \
   if ((addr >= FLASH_BANK1_START_ADDR) && (addr <= FLASH_BANK1_END_ADDR)) {        \
@@ -137,11 +151,11 @@ static inline void at32_flash_clear_status(EFlashDriver *eflp, flash_bank_t bank
   
   switch (bank) {
     case FLASH_BANK_1: {
-      eflp->flash->STS = FLASH_STS_PRGMERR | FLASH_STS_EPPERR;
+      eflp->flash->STS = FLASH_STS_PRGMERR | FLASH_STS_EPPERR | FLASH_STS_ODF;
       break;
     }
     case FLASH_BANK_2: {
-      eflp->flash->STS2 = FLASH_STS_PRGMERR | FLASH_STS_EPPERR;
+      eflp->flash->STS2 = FLASH_STS_PRGMERR | FLASH_STS_EPPERR | FLASH_STS_ODF;
       break;
     }
   }
@@ -167,10 +181,239 @@ static inline void at32_flash_wait_busy(EFlashDriver *eflp, flash_bank_t bank) {
   }
 }
 
+static inline uint32_t at32_flash_get_status(EFlashDriver *eflp, flash_bank_t bank) {
+
+  switch (bank) {
+    case FLASH_BANK_1: {
+      return eflp->flash->STS;
+    }
+    case FLASH_BANK_2: {
+      return eflp->flash->STS2;
+    }
+  }
+  return 0;
+}
+
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+static inline void at32_flash_enable_irq(EFlashDriver *eflp, flash_bank_t bank) {
+
+  switch (bank) {
+    case FLASH_BANK_1: {
+      eflp->flash->CTRL |=(FLASH_CTRL_ERRIE | FLASH_CTRL_ODFIE);
+      break;
+    }
+    case FLASH_BANK_2: {
+      eflp->flash->CTRL2 |=(FLASH_CTRL_ERRIE | FLASH_CTRL_ODFIE);
+      break;
+    }
+  }
+}
+
+static inline void at32_flash_disable_irq(EFlashDriver *eflp, flash_bank_t bank) {
+
+  switch (bank) {
+    case FLASH_BANK_1: {
+      eflp->flash->CTRL &= ~(FLASH_CTRL_ERRIE | FLASH_CTRL_ODFIE);
+      break;
+    }
+    case FLASH_BANK_2: {
+      eflp->flash->CTRL2 &= ~(FLASH_CTRL_ERRIE | FLASH_CTRL_ODFIE);
+      break;
+    }
+  }
+}
+#endif
+
+/**
+ * @brief   Writes the next program unit of a bank.
+ * @details Aligned data is written a 32 bits word at a time, unaligned
+ *          ends use the halfword lines, padded with ones.
+ */
+static void at32_flash_pgm_issue(at32_efl_pgm_t *pgm) {
+  uint8_t *address = efl_lld_descriptor.address + pgm->offset;
+
+  if (((pgm->offset & AT32_FLASH_WORD_MASK) == 0U) &&
+      (pgm->n >= AT32_FLASH_WORD_SIZE)) {
+    uint32_t word;
+
+    memcpy(&word, pgm->pp, AT32_FLASH_WORD_SIZE);
+    pgm->address = address;
+    pgm->data    = word;
+    pgm->width   = AT32_FLASH_WORD_SIZE;
+    pgm->offset += AT32_FLASH_WORD_SIZE;
+    pgm->pp     += AT32_FLASH_WORD_SIZE;
+    pgm->n      -= AT32_FLASH_WORD_SIZE;
+
+    *(volatile uint32_t *)address = word;
+  }
+  else {
+    union {
+      uint16_t  hw[AT32_FLASH_LINE_SIZE / sizeof (uint16_t)];
+      uint8_t   b[AT32_FLASH_LINE_SIZE / sizeof (uint8_t)];
+    } line;
+
+    /* Unwritten bytes are initialized to all ones.*/
+    line.hw[0] = 0xFFFFU;
+
+    /* Programming address aligned to flash lines.*/
+    address -= pgm->offset & AT32_FLASH_LINE_MASK;
+
+    /* Copying data inside the prepared line.*/
+    do {
+      line.b[pgm->offset & AT32_FLASH_LINE_MASK] = *pgm->pp;
+      pgm->offset++;
+      pgm->n--;
+      pgm->pp++;
+    }
+    while ((pgm->n > 0U) && ((pgm->offset & AT32_FLASH_LINE_MASK) != 0U));
+
+    pgm->address = address;
+    pgm->data    = line.hw[0];
+    pgm->width   = AT32_FLASH_LINE_SIZE;
+
+    *(volatile uint16_t *)address = line.hw[0];
+  }
+}
+
+/**
+ * @brief   Splits a program operation between the banks.
+ */
+static void at32_flash_pgm_setup(EFlashDriver *eflp, flash_offset_t offset,
+                                 size_t n, const uint8_t *pp) {
+  unsigned i;
+
+  for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+    at32_efl_pgm_t *pgm = &eflp->pgm[i];
+    size_t chunk = n;
+
+    if ((i == 0U) && (AT32_FLASH_NUMBER_OF_BANKS > 1)) {
+      chunk = offset >= AT32_FLASH_BANK2_OFFSET ? 0U :
+              n < AT32_FLASH_BANK2_OFFSET - offset ? n :
+              AT32_FLASH_BANK2_OFFSET - offset;
+    }
+
+    pgm->offset = offset;
+    pgm->n      = chunk;
+    pgm->pp     = pp;
+    pgm->width  = 0U;
+
+    offset += chunk;
+    pp     += chunk;
+    n      -= chunk;
+  }
+}
+
+/**
+ * @brief   Checks the outcome of the last program unit of a bank.
+ */
+static flash_error_t at32_flash_pgm_check(EFlashDriver *eflp,
+                                          flash_bank_t bank) {
+  at32_efl_pgm_t *pgm = &eflp->pgm[bank];
+  uint32_t sts = at32_flash_get_status(eflp, bank);
+  uint8_t width = pgm->width;
+
+  /* Clearing error status bits.*/
+  at32_flash_clear_status(eflp, bank);
+  pgm->width = 0U;
+
+  /* Decoding relevant errors.*/
+  if ((sts & FLASH_STS_EPPERR) != 0U) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  if (((sts & FLASH_STS_PRGMERR) != 0U) || ((sts & FLASH_STS_ODF) == 0U)) {
+    return FLASH_ERROR_PROGRAM;
+  }
+
+  /* Check for flash error.*/
+  if (width == AT32_FLASH_WORD_SIZE) {
+    if (*(volatile uint32_t *)pgm->address != pgm->data) {
+      return FLASH_ERROR_PROGRAM;
+    }
+  }
+  else if (*(volatile uint16_t *)pgm->address != (uint16_t)pgm->data) {
+    return FLASH_ERROR_PROGRAM;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Program operation-done/error interrupt service.
+ * @details Checks the finished unit of each bank and writes the next one,
+ *          the waiting thread is resumed when both banks are done or on
+ *          the first error.
+ */
+static void at32_flash_serve_interrupt(EFlashDriver *eflp) {
+  bool busy = false;
+  unsigned i;
+
+  for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+    flash_bank_t bank = (flash_bank_t)i;
+    at32_efl_pgm_t *pgm = &eflp->pgm[i];
+    flash_error_t err;
+
+    if (pgm->width == 0U) {
+      /* Nothing in flight on this bank.*/
+      continue;
+    }
+    if (at32_flash_is_busy(eflp, bank) != 0U) {
+      busy = true;
+      continue;
+    }
+
+    err = at32_flash_pgm_check(eflp, bank);
+    if (err != FLASH_NO_ERROR) {
+      unsigned j;
+
+      if (eflp->pgm_err == FLASH_NO_ERROR) {
+        eflp->pgm_err = err;
+      }
+      /* The other bank only finishes its current unit.*/
+      for (j = 0U; j < AT32_FLASH_NUMBER_OF_BANKS; j++) {
+        eflp->pgm[j].n = 0U;
+      }
+    }
+    else if (pgm->n > 0U) {
+      at32_flash_pgm_issue(pgm);
+      busy = true;
+    }
+  }
+
+  if (!busy) {
+    for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+      at32_flash_disable_irq(eflp, (flash_bank_t)i);
+      at32_flash_disable_pgm(eflp, (flash_bank_t)i);
+    }
+
+    osalSysLockFromISR();
+    eflp->state = FLASH_READY;
+    osalThreadResumeI(&eflp->pgm_thread, (msg_t)eflp->pgm_err);
+    osalSysUnlockFromISR();
+  }
+}
+#endif /* AT32_EFL_USE_ASYNC_PROGRAM == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   FLASH interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(AT32_FLASH_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  at32_flash_serve_interrupt(&EFLD1);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -200,6 +443,9 @@ void efl_lld_start(EFlashDriver *eflp) {
   eflp->flash->CTRL = 0x00000000U;
   at32_flash_unlock(eflp, FLASH_BANK_2);
   eflp->flash->CTRL2 = 0x00000000U;
+#if AT32_EFL_USE_ASYNC_PROGRAM == TRUE
+  nvicEnableVector(AT32_FLASH_NUMBER, AT32_EFL_IRQ_PRIORITY);
+#endif
 }
 
 /**
@@ -213,6 +459,9 @@ void efl_lld_stop(EFlashDriver *eflp) {
 
   at32_flash_lock(eflp, FLASH_BANK_1);
   at32_flash_lock(eflp, FLASH_BANK_2);
+#if AT32_EFL_USE_ASYNC_PROGRAM == TRUE
+  nvicDisableVector(AT32_FLASH_NUMBER);
+#endif
 }
 
 /**
@@ -283,6 +532,9 @@ flash_error_t efl_lld_read(void *instance, flash_offset_t offset,
  * @brief   Program operation.
  * @note    It is only possible to write erased pages once except
  *          when writing all zeroes.
+ * @note    Aligned data is programmed in 32 bits words. A range
+ *          crossing the bank boundary is programmed on both banks
+ *          concurrently.
  *
  * @param[in] ip                    pointer to a @p EFlashDriver instance
  * @param[in] offset                flash offset
@@ -300,8 +552,7 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
                               size_t n, const uint8_t *pp) {
   EFlashDriver *devp = (EFlashDriver *)instance;
   flash_error_t err = FLASH_NO_ERROR;
-  uint32_t addr = (uint32_t)(efl_lld_descriptor.address + offset);
-  flash_bank_t bank;
+  unsigned i;
 
   osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
   osalDbgCheck((size_t)offset + n <= (size_t)efl_lld_descriptor.size);
@@ -317,81 +568,49 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
   /* FLASH_PGM state while the operation is performed.*/
   devp->state = FLASH_PGM;
 
-  AT32_FLASH_GET_BANK(addr, bank);
-
-  /* Clearing error status bits.*/
-  at32_flash_clear_status(devp, bank);
-
-  /* Enabling PGM mode in the controller.*/
-  at32_flash_enable_pgm(devp, bank);
-
-  /* Actual program implementation.*/
-  while (n > 0U) {
-    volatile uint16_t *address;
+  at32_flash_pgm_setup(devp, offset, n, pp);
 
-    union {
-      uint16_t  hw[AT32_FLASH_LINE_SIZE / sizeof (uint16_t)];
-      uint8_t   b[AT32_FLASH_LINE_SIZE / sizeof (uint8_t)];
-    } line;
+  for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+    if (devp->pgm[i].n > 0U) {
+      /* Clearing error status bits.*/
+      at32_flash_clear_status(devp, (flash_bank_t)i);
 
-    /* Unwritten bytes are initialized to all ones.*/
-    line.hw[0] = 0xFFFFU;
+      /* Enabling PGM mode in the controller.*/
+      at32_flash_enable_pgm(devp, (flash_bank_t)i);
+    }
+  }
 
-    /* Programming address aligned to flash lines.*/
-    address = (volatile uint16_t *)(efl_lld_descriptor.address +
-                                    (offset & ~AT32_FLASH_LINE_MASK));
+  /* Actual program implementation, one unit per bank in flight.*/
+  while (err == FLASH_NO_ERROR) {
+    bool active = false;
 
-    /* Copying data inside the prepared line.*/
-    do {
-      line.b[offset & AT32_FLASH_LINE_MASK] = *pp;
-      offset++;
-      n--;
-      pp++;
-    }
-    while ((n > 0U) & ((offset & AT32_FLASH_LINE_MASK) != 0U));
-    /* Programming line.*/
-    address[0] = line.hw[0];
-    at32_flash_wait_busy(devp, bank);
-
-    uint32_t sts = 0;
-
-    switch (bank) {
-      case FLASH_BANK_1: {
-        sts = devp->flash->STS;
-        break;
-      }
-      case FLASH_BANK_2: {
-        sts = devp->flash->STS2;
-        break;
+    for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+      if (devp->pgm[i].n > 0U) {
+        at32_flash_pgm_issue(&devp->pgm[i]);
+        active = true;
       }
     }
-  
-    /* Clearing error status bits.*/
-    at32_flash_clear_status(devp, bank);
-
-    /* Decoding relevant errors.*/
-    if ((sts & FLASH_STS_EPPERR) != 0U) {
-      err = FLASH_ERROR_HW_FAILURE;
-      break;
-    }
-    else if ((sts & FLASH_STS_PRGMERR) != 0U) {
-      err = FLASH_ERROR_PROGRAM;
-      break;
-    }
-    else if ((sts & FLASH_STS_ODF) == 0U) {
-      err = FLASH_ERROR_PROGRAM;
+    if (!active) {
       break;
     }
 
-    /* Check for flash error.*/
-    if (address[0] != line.hw[0]) {
-      err = FLASH_ERROR_PROGRAM;
-      break;
+    for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+      if (devp->pgm[i].width != 0U) {
+        flash_error_t e;
+
+        at32_flash_wait_busy(devp, (flash_bank_t)i);
+        e = at32_flash_pgm_check(devp, (flash_bank_t)i);
+        if (err == FLASH_NO_ERROR) {
+          err = e;
+        }
+      }
     }
   }
 
   /* Disabling PGM mode in the controller.*/
-  at32_flash_disable_pgm(devp, bank);
+  for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+    at32_flash_disable_pgm(devp, (flash_bank_t)i);
+  }
 
   /* Ready state again.*/
   devp->state = FLASH_READY;
@@ -399,6 +618,92 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
   return err;
 }
 
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous program operation.
+ * @details The first unit is written here, the following ones from the
+ *          FLASH interrupt, the calling thread is free to run.
+ * @note    The data buffer must stay valid until the operation ends.
+ * @note    The flash must not be read until the operation ends, code
+ *          executing from the bank being programmed stalls anyway.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @param[in] offset                flash offset
+ * @param[in] n                     number of bytes to be programmed
+ * @param[in] pp                    pointer to the data buffer
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if the operation has been started.
+ * @retval FLASH_BUSY_ERASING       if there is an erase operation in progress.
+ *
+ * @api
+ */
+flash_error_t efl_lld_start_program(void *instance, flash_offset_t offset,
+                                    size_t n, const uint8_t *pp) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+  unsigned i;
+
+  osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= (size_t)efl_lld_descriptor.size);
+
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  /* No programming while erasing.*/
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  /* FLASH_PGM state until the interrupt handler completes.*/
+  devp->state   = FLASH_PGM;
+  devp->pgm_err = FLASH_NO_ERROR;
+
+  at32_flash_pgm_setup(devp, offset, n, pp);
+
+  osalSysLock();
+  for (i = 0U; i < AT32_FLASH_NUMBER_OF_BANKS; i++) {
+    if (devp->pgm[i].n > 0U) {
+      at32_flash_clear_status(devp, (flash_bank_t)i);
+      at32_flash_enable_pgm(devp, (flash_bank_t)i);
+      at32_flash_enable_irq(devp, (flash_bank_t)i);
+      at32_flash_pgm_issue(&devp->pgm[i]);
+    }
+  }
+  osalSysUnlock();
+
+  return FLASH_NO_ERROR;
+}
+
+/**
+ * @brief   Waits for the end of an asynchronous program operation.
+ *
+ * @param[in] ip                    pointer to a @p EFlashDriver instance
+ * @return                          The outcome of the last asynchronous
+ *                                  program operation.
+ * @retval FLASH_NO_ERROR           if the data has been programmed.
+ * @retval FLASH_ERROR_PROGRAM      if the program operation failed.
+ * @retval FLASH_ERROR_HW_FAILURE   if access to the memory failed.
+ *
+ * @api
+ */
+flash_error_t efl_lld_wait_program(void *instance) {
+  EFlashDriver *devp = (EFlashDriver *)instance;
+  msg_t msg;
+
+  osalDbgCheck(instance != NULL);
+
+  osalSysLock();
+  if (devp->state == FLASH_PGM) {
+    msg = osalThreadSuspendS(&devp->pgm_thread);
+  }
+  else {
+    msg = (msg_t)devp->pgm_err;
+  }
+  osalSysUnlock();
+
+  return (flash_error_t)msg;
+}
+#endif /* AT32_EFL_USE_ASYNC_PROGRAM == TRUE */
+
 /**
  * @brief   Starts a whole-device erase operation.
  * @note    This function does nothing, the flash memory is where the program
@@ -45,6 +45,22 @@
 #if !defined(AT32_FLASH_WAIT_TIME_MS) || defined(__DOXYGEN__)
 #define AT32_FLASH_WAIT_TIME_MS            50
 #endif
+
+/**
+ * @brief   Enables the interrupt driven program API.
+ * @details Adds @p efl_lld_start_program() and @p efl_lld_wait_program(),
+ *          the program units are chained by the FLASH interrupt.
+ */
+#if !defined(AT32_EFL_USE_ASYNC_PROGRAM) || defined(__DOXYGEN__)
+#define AT32_EFL_USE_ASYNC_PROGRAM         FALSE
+#endif
+
+/**
+ * @brief   FLASH interrupt priority level setting.
+ */
+#if !defined(AT32_EFL_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define AT32_EFL_IRQ_PRIORITY              15
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -63,10 +79,45 @@
 #error "AT32_FLASH_SECTORS_PER_BANK not defined in registry"
 #endif
 
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) &&                                 \
+    !OSAL_IRQ_IS_VALID_PRIORITY(AT32_EFL_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to FLASH"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Program operation cursor.
+ */
+typedef struct {
+  /**
+   * @brief   Next offset to be programmed.
+   */
+  flash_offset_t            offset;
+  /**
+   * @brief   Remaining bytes.
+   */
+  size_t                    n;
+  /**
+   * @brief   Next data byte.
+   */
+  const uint8_t             *pp;
+  /**
+   * @brief   Address of the unit in flight.
+   */
+  uint8_t                   *address;
+  /**
+   * @brief   Data of the unit in flight.
+   */
+  uint32_t                  data;
+  /**
+   * @brief   Size of the unit in flight, zero if none.
+   */
+  uint8_t                   width;
+} at32_efl_pgm_t;
+
 /**
  * @brief   Flash Bank type
  */
@@ -84,7 +135,13 @@ typedef enum {
  */
 #define efl_lld_driver_fields                                               \
   /* Flash registers.*/                                                     \
-  FLASH_TypeDef             *flash
+  FLASH_TypeDef             *flash;                                         \
+  /* Program cursors, one per bank.*/                                       \
+  at32_efl_pgm_t            pgm[AT32_FLASH_NUMBER_OF_BANKS];                \
+  /* Outcome of the last asynchronous program.*/                            \
+  flash_error_t             pgm_err;                                        \
+  /* Thread waiting for an asynchronous program.*/                          \
+  thread_reference_t        pgm_thread
 
 /**
  * @brief   Low level fields of the embedded flash configuration structure.
@@ -112,6 +169,11 @@ extern "C" {
                              size_t n, uint8_t *rp);
   flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
                                 size_t n, const uint8_t *pp);
+#if (AT32_EFL_USE_ASYNC_PROGRAM == TRUE) || defined(__DOXYGEN__)
+  flash_error_t efl_lld_start_program(void *instance, flash_offset_t offset,
+                                      size_t n, const uint8_t *pp);
+  flash_error_t efl_lld_wait_program(void *instance);
+#endif
   flash_error_t efl_lld_start_erase_all(void *instance);
   flash_error_t efl_lld_start_erase_sector(void *instance,
                                            flash_sector_t sector);
@@ -150,6 +150,10 @@ static struct {
      * @brief   EDMA callback parameter.
      */
     void             *param;
+    /**
+     * @brief   Node in progress when running a link list.
+     */
+    const at32_edma_node_t *node;
   } streams[AT32_EDMA_STREAMS];
 } edma;
 
@@ -157,6 +161,50 @@ static struct {
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Common stream interrupt service.
+ * @details When a link list is running the callbacks of the nodes
+ *          completed since the last interrupt are invoked first, the node
+ *          currently loaded is the one linking to the LLP register value.
+ *
+ * @param[in] i         stream index
+ * @param[in] flags     pre-shifted content of the STS register
+ */
+static void edma_serve_interrupt(uint32_t i, uint32_t flags) {
+  const at32_edma_node_t *np = edma.streams[i].node;
+
+  if ((np != NULL) && ((flags & AT32_EDMA_STS_FDTF) != 0U)) {
+    const at32_edma_stream_t *edmastp = AT32_EDMA_STREAM(i);
+    const at32_edma_node_t *cur = NULL;
+
+    if ((edmastp->stream->CTRL & AT32_EDMA_CTRL_SEN) != 0U) {
+      uint32_t llp = edmaStreamGetLL(edmastp)->LLP;
+
+      cur = np;
+      while ((uint32_t)cur->next != llp) {
+        cur = cur->next;
+        if ((cur == NULL) || (cur == np)) {
+          break;
+        }
+      }
+    }
+
+    while ((np != cur) && (np != NULL)) {
+      const at32_edma_node_t *done = np;
+
+      np = np->next;
+      if (done->func != NULL) {
+        done->func(done->param, done);
+      }
+    }
+    edma.streams[i].node = cur;
+  }
+
+  if (edma.streams[i].func != NULL) {
+    edma.streams[i].func(edma.streams[i].param, flags);
+  }
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -173,8 +221,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH1_HANDLER) {
 
   flags = (EDMA1->STS1 >> 0U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR1 = flags << 0U;
-  if (edma.streams[0].func)
-    edma.streams[0].func(edma.streams[0].param, flags);
+  edma_serve_interrupt(0U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -191,8 +238,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH2_HANDLER) {
 
   flags = (EDMA1->STS1 >> 6U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR1 = flags << 6U;
-  if (edma.streams[1].func)
-    edma.streams[1].func(edma.streams[1].param, flags);
+  edma_serve_interrupt(1U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -209,8 +255,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH3_HANDLER) {
 
   flags = (EDMA1->STS1 >> 16U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR1 = flags << 16U;
-  if (edma.streams[2].func)
-    edma.streams[2].func(edma.streams[2].param, flags);
+  edma_serve_interrupt(2U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -227,8 +272,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH4_HANDLER) {
 
   flags = (EDMA1->STS1 >> 22U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR1 = flags << 22U;
-  if (edma.streams[3].func)
-    edma.streams[3].func(edma.streams[3].param, flags);
+  edma_serve_interrupt(3U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -245,8 +289,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH5_HANDLER) {
 
   flags = (EDMA1->STS2 >> 0U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR2 = flags << 0U;
-  if (edma.streams[4].func)
-    edma.streams[4].func(edma.streams[4].param, flags);
+  edma_serve_interrupt(4U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -263,8 +306,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH6_HANDLER) {
 
   flags = (EDMA1->STS2 >> 6U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR2 = flags << 6U;
-  if (edma.streams[5].func)
-    edma.streams[5].func(edma.streams[5].param, flags);
+  edma_serve_interrupt(5U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -281,8 +323,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH7_HANDLER) {
 
   flags = (EDMA1->STS2 >> 16U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR2 = flags << 16U;
-  if (edma.streams[6].func)
-    edma.streams[6].func(edma.streams[6].param, flags);
+  edma_serve_interrupt(6U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -299,8 +340,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA1_CH8_HANDLER) {
 
   flags = (EDMA1->STS2 >> 22U) & AT32_EDMA_STS_MASK;
   EDMA1->CLR2 = flags << 22U;
-  if (edma.streams[7].func)
-    edma.streams[7].func(edma.streams[7].param, flags);
+  edma_serve_interrupt(7U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -319,8 +359,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH1_HANDLER) {
 
   flags = (EDMA2->STS1 >> 0U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR1 = flags << 0U;
-  if (edma.streams[8].func)
-    edma.streams[8].func(edma.streams[8].param, flags);
+  edma_serve_interrupt(8U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -337,8 +376,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH2_HANDLER) {
 
   flags = (EDMA2->STS1 >> 6U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR1 = flags << 6U;
-  if (edma.streams[9].func)
-    edma.streams[9].func(edma.streams[9].param, flags);
+  edma_serve_interrupt(9U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -355,8 +393,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH3_HANDLER) {
 
   flags = (EDMA2->STS1 >> 16U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR1 = flags << 16U;
-  if (edma.streams[10].func)
-    edma.streams[10].func(edma.streams[10].param, flags);
+  edma_serve_interrupt(10U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -373,8 +410,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH4_HANDLER) {
 
   flags = (EDMA2->STS1 >> 22U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR1 = flags << 22U;
-  if (edma.streams[11].func)
-    edma.streams[11].func(edma.streams[11].param, flags);
+  edma_serve_interrupt(11U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -391,8 +427,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH5_HANDLER) {
 
   flags = (EDMA2->STS2 >> 0U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR2 = flags << 0U;
-  if (edma.streams[12].func)
-    edma.streams[12].func(edma.streams[12].param, flags);
+  edma_serve_interrupt(12U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -409,8 +444,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH6_HANDLER) {
 
   flags = (EDMA2->STS2 >> 6U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR2 = flags << 6U;
-  if (edma.streams[13].func)
-    edma.streams[13].func(edma.streams[13].param, flags);
+  edma_serve_interrupt(13U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -427,8 +461,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH7_HANDLER) {
 
   flags = (EDMA2->STS2 >> 16U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR2 = flags << 16U;
-  if (edma.streams[14].func)
-    edma.streams[14].func(edma.streams[14].param, flags);
+  edma_serve_interrupt(14U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -445,8 +478,7 @@ OSAL_IRQ_HANDLER(AT32_EDMA2_CH8_HANDLER) {
 
   flags = (EDMA2->STS2 >> 22U) & AT32_EDMA_STS_MASK;
   EDMA2->CLR2 = flags << 22U;
-  if (edma.streams[15].func)
-    edma.streams[15].func(edma.streams[15].param, flags);
+  edma_serve_interrupt(15U, flags);
 
   OSAL_IRQ_EPILOGUE();
 }
@@ -569,6 +601,11 @@ const at32_edma_stream_t *edmaStreamAllocI(uint32_t id,
       edmaStreamDisable(edmastp);
       edmastp->stream->CTRL = AT32_EDMA_SCTRL_RESET_VALUE;
       edmastp->stream->FCTRL = AT32_EDMA_FCTRL_RESET_VALUE;
+      if (i < 8U) {
+        EDMA1->LLCTRL  &= ~AT32_EDMA_LLCTRL_LLEN(i);
+        EDMA1->S2DCTRL &= ~AT32_EDMA_S2DCTRL_S2DEN(i);
+      }
+      edma.streams[i].node = NULL;
 
       /* Enables the associated IRQ vector if a callback is defined.*/
       if (func != NULL) {
@@ -694,6 +731,192 @@ void edmaSetRequestSource(const at32_edma_stream_t *edmastp, uint32_t per) {
 }
 #endif
 
+/**
+ * @brief   Initializes a link list node.
+ * @details The node is the last one of a list, without 2D settings and
+ *          callback.
+ *
+ * @param[out] np       pointer to a at32_edma_node_t structure
+ * @param[in] mode      value for the CTRL register, @p AT32_EDMA_CTRL_SEN
+ *                      is implicitly ORed
+ * @param[in] paddr     peripheral address, or the source in
+ *                      memory-to-memory mode
+ * @param[in] maddr     memory address
+ * @param[in] n         number of data units
+ *
+ * @api
+ */
+void edmaNodeInit(at32_edma_node_t *np, uint32_t mode,
+                  volatile const void *paddr, const void *maddr, size_t n) {
+
+  osalDbgCheck((np != NULL) && (n > 0U) && (n < 65536U));
+
+  np->ctrl   = mode | AT32_EDMA_CTRL_SEN;
+  np->dtcnt  = (uint32_t)n;
+  np->paddr  = (uint32_t)paddr;
+  np->m0addr = (uint32_t)maddr;
+  np->m1addr = 0U;
+  np->fctrl  = AT32_EDMA_FCTRL_RESET_VALUE;
+  np->next   = NULL;
+  np->s2dcnt = 0U;
+  np->stride = 0U;
+  np->func   = NULL;
+  np->param  = NULL;
+}
+
+/**
+ * @brief   Returns the number of data units moved by a list.
+ *
+ * @param[in] np        first node of the list
+ * @return              The sum of the nodes transfer sizes.
+ *
+ * @api
+ */
+size_t edmaListGetSize(const at32_edma_node_t *np) {
+  const at32_edma_node_t *first = np;
+  size_t n = 0U;
+
+  do {
+    n += np->dtcnt;
+    np = np->next;
+  } while ((np != NULL) && (np != first));
+
+  return n;
+}
+
+/**
+ * @brief   Starts a link list on a stream.
+ * @details The first node is programmed in the stream registers, the
+ *          following ones are loaded by the EDMA as each node ends, without
+ *          CPU intervention. The list ends on a node with a @p NULL link,
+ *          a list closed on itself runs until stopped.
+ * @note    This function can be invoked in both ISR or thread context.
+ * @pre     The stream must be one of the EDMA1 streams and must have been
+ *          allocated using @p edmaStreamAlloc().
+ * @post    The stream can be returned to the normal mode using
+ *          @p edmaStreamStopList().
+ *
+ * @param[in] edmastp   pointer to a at32_edma_stream_t structure
+ * @param[in] np        first node of the list
+ *
+ * @special
+ */
+void edmaStreamStartList(const at32_edma_stream_t *edmastp,
+                         const at32_edma_node_t *np) {
+  EDMA_Stream_TypeDef *stream = edmastp->stream;
+
+  osalDbgCheck((np != NULL) && (edmastp->selfindex < 8U));
+
+  /* Callbacks dispatching state.*/
+  edma.streams[edmastp->selfindex].node = np;
+
+  /* First node in the stream registers.*/
+  stream->CTRL   = np->ctrl & ~AT32_EDMA_CTRL_SEN;
+  stream->FCTRL  = np->fctrl;
+  stream->DTCNT  = np->dtcnt;
+  stream->PADDR  = np->paddr;
+  stream->M0ADDR = np->m0addr;
+  stream->M1ADDR = np->m1addr;
+  if (np->s2dcnt != 0U) {
+    edmaStreamGet2D(edmastp)->S2DCNT = np->s2dcnt;
+    edmaStreamGet2D(edmastp)->STRIDE = np->stride;
+    EDMA1->S2DCTRL |= AT32_EDMA_S2DCTRL_S2DEN(edmastp->selfindex);
+  }
+  else {
+    EDMA1->S2DCTRL &= ~AT32_EDMA_S2DCTRL_S2DEN(edmastp->selfindex);
+  }
+
+  /* Link to the rest of the list.*/
+  edmaStreamGetLL(edmastp)->LLP = (uint32_t)np->next;
+  if (np->next != NULL) {
+    EDMA1->LLCTRL |= AT32_EDMA_LLCTRL_LLEN(edmastp->selfindex);
+  }
+  else {
+    EDMA1->LLCTRL &= ~AT32_EDMA_LLCTRL_LLEN(edmastp->selfindex);
+  }
+
+  stream->CTRL   = np->ctrl;
+}
+
+/**
+ * @brief   Stops a link list or 2D transfer.
+ * @details The stream is disabled and returned to the normal mode, the
+ *          callbacks of the pending nodes are not invoked.
+ * @note    This function can be invoked in both ISR or thread context.
+ *
+ * @param[in] edmastp   pointer to a at32_edma_stream_t structure
+ *
+ * @special
+ */
+void edmaStreamStopList(const at32_edma_stream_t *edmastp) {
+
+  osalDbgCheck(edmastp->selfindex < 8U);
+
+  edmaStreamDisable(edmastp);
+  EDMA1->LLCTRL  &= ~AT32_EDMA_LLCTRL_LLEN(edmastp->selfindex);
+  EDMA1->S2DCTRL &= ~AT32_EDMA_S2DCTRL_S2DEN(edmastp->selfindex);
+  edmaStreamGetLL(edmastp)->LLP = 0U;
+  edma.streams[edmastp->selfindex].node = NULL;
+}
+
+/**
+ * @brief   Returns the node in progress on a stream.
+ * @note    This function can be invoked in both ISR or thread context.
+ *
+ * @param[in] edmastp   pointer to a at32_edma_stream_t structure
+ * @return              The node being transferred.
+ * @retval NULL         if no list is running or the list has ended.
+ *
+ * @special
+ */
+const at32_edma_node_t *edmaStreamGetNode(const at32_edma_stream_t *edmastp) {
+
+  return edma.streams[edmastp->selfindex].node;
+}
+
+/**
+ * @brief   Starts a rectangle copy using the 2D mode.
+ * @details Copies @p height rows of @p width data units between two
+ *          images, e.g. a framebuffer sub-rectangle.
+ * @note    The data unit is the peripheral (source) width in @p mode.
+ * @pre     The stream must be one of the EDMA1 streams and must have been
+ *          allocated using @p edmaStreamAlloc().
+ * @post    The stream must be returned to the normal mode using
+ *          @p edmaStreamStopList() after completion.
+ *
+ * @param[in] edmastp   pointer to a at32_edma_stream_t structure
+ * @param[in] mode      value to be written in the CTRL register, this value
+ *                      is implicitly ORed with:
+ *                      - @p AT32_EDMA_CTRL_MINCM
+ *                      - @p AT32_EDMA_CTRL_PINCM
+ *                      - @p AT32_EDMA_CTRL_DTD_M2M
+ *                      - @p AT32_EDMA_CTRL_SEN
+ *                      .
+ * @param[in] src       address of the first source unit
+ * @param[in] srcpitch  distance in bytes between source rows
+ * @param[in] dst       address of the first destination unit
+ * @param[in] dstpitch  distance in bytes between destination rows
+ * @param[in] width     data units per row
+ * @param[in] height    number of rows
+ *
+ * @special
+ */
+void edmaStartRectCopy(const at32_edma_stream_t *edmastp, uint32_t mode,
+                       const void *src, size_t srcpitch,
+                       void *dst, size_t dstpitch,
+                       uint16_t width, uint16_t height) {
+  size_t row = (size_t)width << ((mode & AT32_EDMA_CTRL_PWIDTH_MASK) >> 11U);
+
+  osalDbgCheck((width > 0U) && (height > 0U) &&
+               ((uint32_t)width * (uint32_t)height < 65536U) &&
+               (srcpitch >= row) && (srcpitch - row < 32768U) &&
+               (dstpitch >= row) && (dstpitch - row < 32768U));
+  osalDbgCheck(edmastp->selfindex < 8U);
+
+  edmaStreamSet2D(edmastp, width, height, srcpitch - row, dstpitch - row);
+  edmaStartMemCopy(edmastp, mode, src, dst, (uint32_t)width * height);
+}
+
 #endif /* AT32_EDMA_REQUIRED */
 
 /** @} */
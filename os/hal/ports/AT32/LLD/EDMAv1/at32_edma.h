@@ -257,6 +257,19 @@
 #define AT32_EDMA_STS_FDTF            EDMA_STS1_FDTF1
 /** @} */
 
+/**
+ * @name    Link list and 2D registers constants
+ * @note    Only EDMA1 has link list and 2D modes.
+ * @{
+ */
+#define AT32_EDMA_LLCTRL_LLEN(n)      (1U << (n))
+#define AT32_EDMA_S2DCTRL_S2DEN(n)    (1U << (n))
+#define AT32_EDMA_S2DCNT(xcnt, ycnt)  ((((uint32_t)(ycnt) & 0xFFFFU) << 16U) | \
+                                       ((uint32_t)(xcnt) & 0xFFFFU))
+#define AT32_EDMA_STRIDE(src, dst)    ((((uint32_t)(dst) & 0xFFFFU) << 16U) |  \
+                                       ((uint32_t)(src) & 0xFFFFU))
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -447,6 +460,42 @@ typedef struct {
   uint8_t                 vector;         /**< @brief Associated IRQ vector.  */
 } at32_edma_stream_t;
 
+/**
+ * @brief   Type of an EDMA link list node.
+ */
+typedef struct at32_edma_node at32_edma_node_t;
+
+/**
+ * @brief   AT32 EDMA list node callback type.
+ *
+ * @param[in] p         parameter for the registered function
+ * @param[in] np        the node just completed
+ */
+typedef void (*at32_edmanode_t)(void *p, const at32_edma_node_t *np);
+
+/**
+ * @brief   AT32 EDMA link list node.
+ * @details The first nine words are the descriptor the EDMA loads when it
+ *          moves to a node: the stream registers, the link to the next
+ *          node and the 2D registers. The remaining fields are only used
+ *          by this driver.
+ * @note    Nodes must be word aligned in memory reachable by the EDMA and
+ *          must not be modified while the list is running.
+ */
+struct at32_edma_node {
+  uint32_t                ctrl;           /**< @brief CTRL, @p SEN set.     */
+  uint32_t                dtcnt;          /**< @brief DTCNT.                */
+  uint32_t                paddr;          /**< @brief PADDR.                */
+  uint32_t                m0addr;         /**< @brief M0ADDR.               */
+  uint32_t                m1addr;         /**< @brief M1ADDR.               */
+  uint32_t                fctrl;          /**< @brief FCTRL.                */
+  const at32_edma_node_t  *next;          /**< @brief Next node or @p NULL. */
+  uint32_t                s2dcnt;         /**< @brief S2DCNT.               */
+  uint32_t                stride;         /**< @brief STRIDE.               */
+  at32_edmanode_t         func;           /**< @brief Node callback.        */
+  void                    *param;         /**< @brief Callback parameter.   */
+};
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -664,6 +713,91 @@ typedef struct {
  */
 #define edmaStreamGetCurrentTarget(edmastp)                                     \
   (((edmastp)->stream->CTRL >> 19U) & 1U)
+
+/**
+ * @brief   Returns the link list pointer register of a stream.
+ *
+ * @param[in] edmastp    pointer to a at32_edma_stream_t structure
+ * @return              Pointer to the LLP register block.
+ */
+#define edmaStreamGetLL(edmastp)                                              \
+  ((EDMA_Stream_Link_List_TypeDef *)(EDMA_STREAM1_LL_BASE +                  \
+                                     (4U * (edmastp)->selfindex)))
+
+/**
+ * @brief   Returns the 2D registers of a stream.
+ *
+ * @param[in] edmastp    pointer to a at32_edma_stream_t structure
+ * @return              Pointer to the S2DCNT/STRIDE register block.
+ */
+#define edmaStreamGet2D(edmastp)                                              \
+  ((EDMA_Stream_2D_TypeDef *)(EDMA_STREAM1_2D_BASE +                         \
+                              (8U * (edmastp)->selfindex)))
+
+/**
+ * @brief   Programs the 2D mode of a stream.
+ * @details In 2D mode the stream moves @p ycnt rows of @p xcnt data
+ *          units, after each row the strides are added to the addresses.
+ * @note    This function can be invoked in both ISR or thread context.
+ * @pre     The stream must be one of the EDMA1 streams.
+ *
+ * @param[in] edmastp    pointer to a at32_edma_stream_t structure
+ * @param[in] xcnt      data units in a row
+ * @param[in] ycnt      number of rows
+ * @param[in] src       source stride in bytes, from the last unit of a row
+ *                      to the first unit of the next one
+ * @param[in] dst       destination stride in bytes
+ *
+ * @special
+ */
+#define edmaStreamSet2D(edmastp, xcnt, ycnt, src, dst) {                      \
+  edmaStreamGet2D(edmastp)->S2DCNT = AT32_EDMA_S2DCNT(xcnt, ycnt);            \
+  edmaStreamGet2D(edmastp)->STRIDE = AT32_EDMA_STRIDE(src, dst);              \
+  EDMA1->S2DCTRL |= AT32_EDMA_S2DCTRL_S2DEN((edmastp)->selfindex);            \
+}
+
+/**
+ * @brief   Links a node to the next one.
+ *
+ * @param[in] np        pointer to a at32_edma_node_t structure
+ * @param[in] nextp     next node or @p NULL for the last one
+ */
+#define edmaNodeLink(np, nextp) {                                             \
+  (np)->next = (nextp);                                                       \
+}
+
+/**
+ * @brief   Associates a callback to a node.
+ * @details The callback is invoked from the stream ISR once the node has
+ *          been transferred, the node mode must include
+ *          @p AT32_EDMA_CTRL_FDTIEN.
+ *
+ * @param[in] np        pointer to a at32_edma_node_t structure
+ * @param[in] f         callback function or @p NULL
+ * @param[in] p         callback parameter
+ */
+#define edmaNodeSetCallback(np, f, p) {                                       \
+  (np)->func  = (f);                                                          \
+  (np)->param = (p);                                                          \
+}
+
+/**
+ * @brief   Makes a node a 2D transfer.
+ * @note    2D is a stream setting, either all the nodes of a list are 2D
+ *          or none is.
+ *
+ * @param[in] np        pointer to a at32_edma_node_t structure
+ * @param[in] xcnt      data units in a row
+ * @param[in] ycnt      number of rows
+ * @param[in] src       source stride in bytes, from the last unit of a row
+ *                      to the first unit of the next one
+ * @param[in] dst       destination stride in bytes
+ */
+#define edmaNodeSet2D(np, xcnt, ycnt, src, dst) {                             \
+  (np)->dtcnt  = (uint32_t)(xcnt) * (uint32_t)(ycnt);                         \
+  (np)->s2dcnt = AT32_EDMA_S2DCNT(xcnt, ycnt);                                \
+  (np)->stride = AT32_EDMA_STRIDE(src, dst);                                  \
+}
 /** @} */
 
 /*===========================================================================*/
@@ -691,6 +825,17 @@ extern "C" {
 #if AT32_EDMA_SUPPORTS_EDMAMUX == TRUE
   void edmaSetRequestSource(const at32_edma_stream_t *edmastp, uint32_t per);
 #endif
+  void edmaNodeInit(at32_edma_node_t *np, uint32_t mode,
+                   volatile const void *paddr, const void *maddr, size_t n);
+  size_t edmaListGetSize(const at32_edma_node_t *np);
+  void edmaStreamStartList(const at32_edma_stream_t *edmastp,
+                           const at32_edma_node_t *np);
+  void edmaStreamStopList(const at32_edma_stream_t *edmastp);
+  const at32_edma_node_t *edmaStreamGetNode(const at32_edma_stream_t *edmastp);
+  void edmaStartRectCopy(const at32_edma_stream_t *edmastp, uint32_t mode,
+                         const void *src, size_t srcpitch,
+                         void *dst, size_t dstpitch,
+                         uint16_t width, uint16_t height);
 #ifdef __cplusplus
 }
 #endif
@@ -120,6 +120,23 @@ SPIDriver SPID6;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if AT32_SPI_USE_EDMA_LISTS || defined(__DOXYGEN__)
+/**
+ * @brief   Stops a list transfer, if any.
+ * @note    A list that already ended is left alone, the EDMA interrupt
+ *          may still have to invoke the callback of its last node.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void spi_lld_stop_list(SPIDriver *spip) {
+
+  if ((spip->edmatx != NULL) &&
+      ((spip->edmatx->stream->CTRL & AT32_EDMA_CTRL_SEN) != 0U)) {
+    edmaStreamStopList(spip->edmatx);
+  }
+}
+#endif
+
 static void spi_lld_configure(SPIDriver *spip) {
 
   /* SPI setup.*/
@@ -149,6 +166,9 @@ static msg_t spi_lld_stop_abort(SPIDriver *spip) {
 
     /* Stopping TX DMA channel.*/
     dmaStreamDisable(spip->dmatx);
+#if AT32_SPI_USE_EDMA_LISTS
+    spi_lld_stop_list(spip);
+#endif
 
     /* Waiting for current frame completion then stop SPI.*/
     while ((spip->spi->STS & SPI_STS_BF) != 0U) {
@@ -164,6 +184,9 @@ static msg_t spi_lld_stop_abort(SPIDriver *spip) {
     /* Stopping DMAs.*/
     dmaStreamDisable(spip->dmatx);
     dmaStreamDisable(spip->dmarx);
+#if AT32_SPI_USE_EDMA_LISTS
+    spi_lld_stop_list(spip);
+#endif
 
     /* Resetting SPI, this will stop it for sure and leave it
        in a clean state.*/
@@ -310,6 +333,54 @@ static msg_t spi_lld_get_dma(SPIDriver *spip, uint32_t rxstream,
   return HAL_RET_SUCCESS;
 }
 
+#if AT32_SPI_USE_EDMA_LISTS || defined(__DOXYGEN__)
+/**
+ * @brief   Shared list stream service routine.
+ * @note    The list completion is signaled by the RX DMA stream, only
+ *          errors are handled here.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] flags     pre-shifted content of the STS register
+ */
+static void spi_lld_serve_edma_interrupt(SPIDriver *spip, uint32_t flags) {
+
+  /* EDMA errors handling.*/
+  if ((flags & (AT32_EDMA_STS_DTERRF | AT32_EDMA_STS_DMERRF)) != 0U) {
+#if defined(AT32_SPI_DMA_ERROR_HOOK)
+    /* Hook first, if defined.*/
+    AT32_SPI_DMA_ERROR_HOOK(spip);
+#endif
+
+    /* Aborting the transfer.*/
+    (void) spi_lld_stop_abort(spip);
+
+    /* Reporting the failure.*/
+    __spi_isr_error_code(spip, HAL_RET_HW_FAILURE);
+  }
+}
+
+/**
+ * @brief   EDMA list stream allocation.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] request   EDMAMUX request of the SPI transmitter
+ * @return              The operation status.
+ */
+static msg_t spi_lld_get_edma(SPIDriver *spip, uint32_t request) {
+
+  spip->edmatx = edmaStreamAllocI(AT32_EDMA_STREAM_ID_ANY_EDMA1,
+                                  AT32_SPI_EDMA_IRQ_PRIORITY,
+                                  (at32_edmasts_t)spi_lld_serve_edma_interrupt,
+                                  (void *)spip);
+  if (spip->edmatx == NULL) {
+    return HAL_RET_NO_RESOURCE;
+  }
+  edmaSetRequestSource(spip->edmatx, request);
+
+  return HAL_RET_SUCCESS;
+}
+#endif /* AT32_SPI_USE_EDMA_LISTS */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -330,6 +401,9 @@ void spi_lld_init(void) {
   SPID1.spi       = SPI1;
   SPID1.dmarx     = NULL;
   SPID1.dmatx     = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+  SPID1.edmatx    = NULL;
+#endif
   SPID1.rxdmamode = AT32_DMA_CTRL_CHSEL(SPI1_RX_DMA_CHANNEL) |
                     AT32_DMA_CTRL_CHPL(AT32_SPI_SPI1_DMA_PRIORITY) |
                     AT32_DMA_CTRL_DTD_P2M  |
@@ -348,6 +422,9 @@ void spi_lld_init(void) {
   SPID2.spi       = SPI2;
   SPID2.dmarx     = NULL;
   SPID2.dmatx     = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+  SPID2.edmatx    = NULL;
+#endif
   SPID2.rxdmamode = AT32_DMA_CTRL_CHSEL(SPI2_RX_DMA_CHANNEL) |
                     AT32_DMA_CTRL_CHPL(AT32_SPI_SPI2_DMA_PRIORITY) |
                     AT32_DMA_CTRL_DTD_P2M  |
@@ -366,6 +443,9 @@ void spi_lld_init(void) {
   SPID3.spi       = SPI3;
   SPID3.dmarx     = NULL;
   SPID3.dmatx     = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+  SPID3.edmatx    = NULL;
+#endif
   SPID3.rxdmamode = AT32_DMA_CTRL_CHSEL(SPI3_RX_DMA_CHANNEL) |
                     AT32_DMA_CTRL_CHPL(AT32_SPI_SPI3_DMA_PRIORITY) |
                     AT32_DMA_CTRL_DTD_P2M  |
@@ -384,6 +464,9 @@ void spi_lld_init(void) {
   SPID4.spi       = SPI4;
   SPID4.dmarx     = NULL;
   SPID4.dmatx     = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+  SPID4.edmatx    = NULL;
+#endif
   SPID4.rxdmamode = AT32_DMA_CTRL_CHSEL(SPI4_RX_DMA_CHANNEL) |
                     AT32_DMA_CTRL_CHPL(AT32_SPI_SPI4_DMA_PRIORITY) |
                     AT32_DMA_CTRL_DTD_P2M  |
@@ -402,6 +485,9 @@ void spi_lld_init(void) {
   SPID5.spi       = SPI5;
   SPID5.dmarx     = NULL;
   SPID5.dmatx     = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+  SPID5.edmatx    = NULL;
+#endif
   SPID5.rxdmamode = AT32_DMA_CTRL_CHSEL(SPI5_RX_DMA_CHANNEL) |
                     AT32_DMA_CTRL_CHPL(AT32_SPI_SPI5_DMA_PRIORITY) |
                     AT32_DMA_CTRL_DTD_P2M  |
@@ -420,6 +506,9 @@ void spi_lld_init(void) {
   SPID6.spi       = SPI6;
   SPID6.dmarx     = NULL;
   SPID6.dmatx     = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+  SPID6.edmatx    = NULL;
+#endif
   SPID6.rxdmamode = AT32_DMA_CTRL_CHSEL(SPI6_RX_DMA_CHANNEL) |
                     AT32_DMA_CTRL_CHPL(AT32_SPI_SPI6_DMA_PRIORITY) |
                     AT32_DMA_CTRL_DTD_P2M  |
@@ -462,6 +551,14 @@ msg_t spi_lld_start(SPIDriver *spip) {
       if (msg != HAL_RET_SUCCESS) {
         return msg;
       }
+#if AT32_SPI_USE_EDMA_LISTS
+      msg = spi_lld_get_edma(spip, AT32_EDMAMUX_SPI1_TX);
+      if (msg != HAL_RET_SUCCESS) {
+        dmaStreamFreeI(spip->dmatx);
+        dmaStreamFreeI(spip->dmarx);
+        return msg;
+      }
+#endif
       crmEnableSPI1(true);
       crmResetSPI1();
 #if AT32_DMA_SUPPORTS_DMAMUX
@@ -485,6 +582,14 @@ msg_t spi_lld_start(SPIDriver *spip) {
       if (msg != HAL_RET_SUCCESS) {
         return msg;
       }
+#if AT32_SPI_USE_EDMA_LISTS
+      msg = spi_lld_get_edma(spip, AT32_EDMAMUX_SPI2_TX);
+      if (msg != HAL_RET_SUCCESS) {
+        dmaStreamFreeI(spip->dmatx);
+        dmaStreamFreeI(spip->dmarx);
+        return msg;
+      }
+#endif
       crmEnableSPI2(true);
       crmResetSPI2();
 #if AT32_DMA_SUPPORTS_DMAMUX
@@ -508,6 +613,14 @@ msg_t spi_lld_start(SPIDriver *spip) {
       if (msg != HAL_RET_SUCCESS) {
         return msg;
       }
+#if AT32_SPI_USE_EDMA_LISTS
+      msg = spi_lld_get_edma(spip, AT32_EDMAMUX_SPI3_TX);
+      if (msg != HAL_RET_SUCCESS) {
+        dmaStreamFreeI(spip->dmatx);
+        dmaStreamFreeI(spip->dmarx);
+        return msg;
+      }
+#endif
       crmEnableSPI3(true);
       crmResetSPI3();
 #if AT32_DMA_SUPPORTS_DMAMUX
@@ -531,6 +644,14 @@ msg_t spi_lld_start(SPIDriver *spip) {
       if (msg != HAL_RET_SUCCESS) {
         return msg;
       }
+#if AT32_SPI_USE_EDMA_LISTS
+      msg = spi_lld_get_edma(spip, AT32_EDMAMUX_SPI4_TX);
+      if (msg != HAL_RET_SUCCESS) {
+        dmaStreamFreeI(spip->dmatx);
+        dmaStreamFreeI(spip->dmarx);
+        return msg;
+      }
+#endif
       crmEnableSPI4(true);
       crmResetSPI4();
 #if AT32_DMA_SUPPORTS_DMAMUX
@@ -655,6 +776,12 @@ void spi_lld_stop(SPIDriver *spip) {
     dmaStreamFreeI(spip->dmarx);
     spip->dmarx = NULL;
     spip->dmatx = NULL;
+#if AT32_SPI_USE_EDMA_LISTS
+    if (spip->edmatx != NULL) {
+      edmaStreamFreeI(spip->edmatx);
+      spip->edmatx = NULL;
+    }
+#endif
 
     /* Clock shutdown.*/
     if (false) {
@@ -890,6 +1017,192 @@ msg_t spi_lld_stop_transfer(SPIDriver *spip, size_t *sizep) {
   return msg;
 }
 
+#if AT32_SPI_USE_EDMA_LISTS || defined(__DOXYGEN__)
+/**
+ * @brief   Sends an EDMA list over the SPI bus.
+ * @details The list is sent by the EDMA stream, the RX DMA stream
+ *          discards the received frames and signals the completion.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] np        first node of the list
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+msg_t spi_lld_send_list(SPIDriver *spip, const at32_edma_node_t *np) {
+  size_t n = edmaListGetSize(np);
+
+  osalDbgAssert((n > 0U) && (n < 65536U), "unsupported list size");
+
+  dmaStreamSetMemory0(spip->dmarx, &spip->rxsink);
+  dmaStreamSetTransactionSize(spip->dmarx, n);
+  dmaStreamSetMode(spip->dmarx, spip->rxdmamode);
+
+  dmaStreamEnable(spip->dmarx);
+  edmaStreamStartList(spip->edmatx, np);
+
+  spip->spi->CTRL1 |= SPI_CTRL1_SPIEN;
+
+  return HAL_RET_SUCCESS;
+}
+
+/**
+ * @brief   Initializes a list node sending a buffer.
+ * @note    The buffers are organized as uint8_t arrays for data sizes below
+ *          or equal to 8 bits else it is organized as uint16_t arrays.
+ * @note    The frame size is taken from the current configuration, nodes
+ *          must be initialized again after changing it.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[out] np       pointer to the node
+ * @param[in] n         number of frames to send
+ * @param[in] txbuf     the pointer to the transmit buffer
+ *
+ * @api
+ */
+void spiListNodeInit(SPIDriver *spip, at32_edma_node_t *np,
+                     size_t n, const void *txbuf) {
+  uint32_t mode;
+
+  osalDbgCheck((spip != NULL) && (np != NULL) && (txbuf != NULL) &&
+               (n > 0U) && (n < 65536U));
+  osalDbgAssert(spip->state != SPI_STOP, "not started");
+
+  mode = AT32_EDMA_CTRL_DTD_M2P  | AT32_EDMA_CTRL_MINCM    |
+         AT32_EDMA_CTRL_FDTIEN   | AT32_EDMA_CTRL_DMERRIEN |
+         AT32_EDMA_CTRL_DTERRIEN;
+  if ((spip->config->ctrl1 & SPI_CTRL1_FBN) == 0U) {
+    mode |= AT32_EDMA_CTRL_PWIDTH_BYTE | AT32_EDMA_CTRL_MWIDTH_BYTE;
+  }
+  else {
+    mode |= AT32_EDMA_CTRL_PWIDTH_HWORD | AT32_EDMA_CTRL_MWIDTH_HWORD;
+  }
+
+  edmaNodeInit(np, mode, &spip->spi->DT, txbuf, n);
+}
+
+/**
+ * @brief   Initializes a list node sending a framebuffer sub-rectangle.
+ * @details The rectangle rows are sent one after the other, the EDMA
+ *          skips the rest of each framebuffer line.
+ * @note    2D is a stream setting, it is enabled by the first node of the
+ *          list, the other nodes must be 2D nodes too.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[out] np       pointer to the node
+ * @param[in] fb        pointer to the first frame of the rectangle
+ * @param[in] pitch     framebuffer line length in frames
+ * @param[in] width     rectangle width in frames
+ * @param[in] height    rectangle height in lines
+ *
+ * @api
+ */
+void spiListNodeInitRect(SPIDriver *spip, at32_edma_node_t *np,
+                         const void *fb, size_t pitch,
+                         uint16_t width, uint16_t height) {
+  size_t skip;
+
+  osalDbgCheck((width > 0U) && (height > 0U) && (pitch >= width));
+
+  spiListNodeInit(spip, np, (size_t)width * (size_t)height, fb);
+
+  /* Memory stride in bytes from the end of a row to the next.*/
+  skip = pitch - width;
+  if ((spip->config->ctrl1 & SPI_CTRL1_FBN) != 0U) {
+    skip *= 2U;
+  }
+  osalDbgAssert(skip < 32768U, "stride out of range");
+
+  edmaNodeSet2D(np, width, height, skip, 0U);
+}
+
+/**
+ * @brief   Starts sending an EDMA list.
+ * @details The nodes are sent one after the other without CPU
+ *          intervention, the node callbacks are invoked as each node ends
+ *          and the end callback when the whole list has been sent.
+ * @pre     A slave must have been selected using @p spiSelect() or
+ *          @p spiSelectI().
+ * @note    The list must be terminated, the total size must be below
+ *          65536 frames.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] np        first node of the list
+ * @return              The operation status.
+ *
+ * @iclass
+ */
+msg_t spiStartSendListI(SPIDriver *spip, const at32_edma_node_t *np) {
+  msg_t msg;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((spip != NULL) && (np != NULL));
+  osalDbgAssert(spip->state == SPI_READY, "not ready");
+  osalDbgAssert(spip->config->circular == false, "circular mode");
+  osalDbgAssert(spip->edmatx != NULL, "no EDMA stream");
+
+  spip->state = SPI_ACTIVE;
+  msg = spi_lld_send_list(spip, np);
+  if (msg != HAL_RET_SUCCESS) {
+    spip->state = SPI_READY;
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Starts sending an EDMA list.
+ * @details The nodes are sent one after the other without CPU
+ *          intervention, the node callbacks are invoked as each node ends
+ *          and the end callback when the whole list has been sent.
+ * @pre     A slave must have been selected using @p spiSelect() or
+ *          @p spiSelectI().
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] np        first node of the list
+ * @return              The operation status.
+ *
+ * @api
+ */
+msg_t spiStartSendList(SPIDriver *spip, const at32_edma_node_t *np) {
+  msg_t msg;
+
+  osalSysLock();
+  msg = spiStartSendListI(spip, np);
+  osalSysUnlock();
+
+  return msg;
+}
+
+#if (SPI_USE_SYNCHRONIZATION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Sends an EDMA list.
+ * @pre     In order to use this function the option @p SPI_USE_SYNCHRONIZATION
+ *          must be enabled.
+ * @pre     A slave must have been selected using @p spiSelect() or
+ *          @p spiSelectI().
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] np        first node of the list
+ * @return              The operation status.
+ *
+ * @api
+ */
+msg_t spiSendList(SPIDriver *spip, const at32_edma_node_t *np) {
+  msg_t msg;
+
+  osalSysLock();
+  msg = spiStartSendListI(spip, np);
+  if (msg == MSG_OK) {
+    msg = spiSynchronizeS(spip, TIME_INFINITE);
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+#endif
+#endif /* AT32_SPI_USE_EDMA_LISTS */
+
 /**
  * @brief   Exchanges one frame using a polled wait.
  * @details This synchronous function exchanges one frame using a polled
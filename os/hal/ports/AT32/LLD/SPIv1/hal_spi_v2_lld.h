@@ -143,6 +143,28 @@
 #define AT32_SPI_FILLER_PATTERN            0xFFFFFFFFU
 #endif
 
+/**
+ * @brief   Enables the EDMA list transfers.
+ * @details If set to @p TRUE each driver allocates an additional EDMA
+ *          stream for @p spiStartSendList(), scattered buffers and 2D
+ *          sub-rectangles are then sent with a single arming.
+ * @note    Only on devices with EDMA, the request is routed through the
+ *          EDMAMUX so any free stream is used.
+ * @note    Only SPI1 to SPI4 have an EDMAMUX transmit request, the other
+ *          units get no list stream and the list functions must not be
+ *          used on them.
+ */
+#if !defined(AT32_SPI_USE_EDMA_LISTS) || defined(__DOXYGEN__)
+#define AT32_SPI_USE_EDMA_LISTS            FALSE
+#endif
+
+/**
+ * @brief   EDMA list stream interrupt priority level setting.
+ */
+#if !defined(AT32_SPI_EDMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define AT32_SPI_EDMA_IRQ_PRIORITY         10
+#endif
+
 /**
  * @brief   SPI1 interrupt priority level setting.
  */
@@ -475,6 +497,25 @@
 #define AT32_DMA_REQUIRED
 #endif
 
+#if AT32_SPI_USE_EDMA_LISTS
+#if !AT32_HAS_EDMA1
+#error "EDMA list transfers not supported in the selected device"
+#endif
+
+#if !AT32_SPI_USE_SPI1 && !AT32_SPI_USE_SPI2 &&                           \
+    !AT32_SPI_USE_SPI3 && !AT32_SPI_USE_SPI4
+#error "EDMA list transfers require at least one of SPI1, SPI2, SPI3, SPI4"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(AT32_SPI_EDMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to SPI EDMA"
+#endif
+
+#if !defined(AT32_EDMA_REQUIRED)
+#define AT32_EDMA_REQUIRED
+#endif
+#endif /* AT32_SPI_USE_EDMA_LISTS */
+
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_LLD
 #error "SPI_SELECT_MODE_LLD not supported by this driver"
 #endif
@@ -487,7 +528,16 @@
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if AT32_SPI_USE_EDMA_LISTS || defined(__DOXYGEN__)
+#define spi_lld_edma_fields                                                 \
+  /* Transmit EDMA stream for list transfers.*/                             \
+  const at32_edma_stream_t *edmatx;
+#else
+#define spi_lld_edma_fields
+#endif
+
 #define spi_lld_driver_fields                                               \
+  spi_lld_edma_fields                                                       \
   /* Pointer to the SPIx registers block.*/                                 \
   SPI_TypeDef               *spi;                                           \
   /** DMA type for this instance.*/                                         \
@@ -558,6 +608,19 @@ extern "C" {
   msg_t spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf);
   msg_t spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf);
   msg_t spi_lld_stop_transfer(SPIDriver *spip, size_t *sizep);
+#if AT32_SPI_USE_EDMA_LISTS || defined(__DOXYGEN__)
+  msg_t spi_lld_send_list(SPIDriver *spip, const at32_edma_node_t *np);
+  void spiListNodeInit(SPIDriver *spip, at32_edma_node_t *np,
+                       size_t n, const void *txbuf);
+  void spiListNodeInitRect(SPIDriver *spip, at32_edma_node_t *np,
+                           const void *fb, size_t pitch,
+                           uint16_t width, uint16_t height);
+  msg_t spiStartSendListI(SPIDriver *spip, const at32_edma_node_t *np);
+  msg_t spiStartSendList(SPIDriver *spip, const at32_edma_node_t *np);
+#if (SPI_USE_SYNCHRONIZATION == TRUE) || defined(__DOXYGEN__)
+  msg_t spiSendList(SPIDriver *spip, const at32_edma_node_t *np);
+#endif
+#endif
   uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame);
 #ifdef __cplusplus
 }
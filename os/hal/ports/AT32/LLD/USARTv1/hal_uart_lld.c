@@ -30,6 +30,12 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/* Devices with the 7 bits mode have two data length bits, DBN0 is the
+   9 bits one.*/
+#if !defined(USART_CTRL1_DBN)
+#define USART_CTRL1_DBN                     USART_CTRL1_DBN0
+#endif
+
 #define USART1_RX_DMA_CHANNEL                                             \
   AT32_DMA_GETCHANNEL(AT32_UART_USART1_RX_DMA_STREAM,                     \
                       AT32_USART1_RX_DMA_CHN)
@@ -340,6 +346,93 @@ static void uart_lld_serve_tx_end_irq(UARTDriver *uartp, uint32_t flags) {
   _uart_tx1_isr_code(uartp);
 }
 
+#if AT32_UART_USE_EDMA_LISTS || defined(__DOXYGEN__)
+/**
+ * @brief   TX EDMA list service routine.
+ * @note    The node callbacks have already been invoked by the EDMA driver
+ *          when this function is called.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] flags     pre-shifted content of the STS register
+ */
+static void uart_lld_serve_tx_list_irq(UARTDriver *uartp, uint32_t flags) {
+
+  /* EDMA errors handling.*/
+#if defined(AT32_UART_DMA_ERROR_HOOK)
+  if ((flags & (AT32_EDMA_STS_DTERRF | AT32_EDMA_STS_DMERRF)) != 0) {
+    AT32_UART_DMA_ERROR_HOOK(uartp);
+  }
+#endif
+
+  /* The end callback is generated after the last node, a list stopped
+     by uartStopSend() does not generate it.*/
+  if (((flags & AT32_EDMA_STS_FDTF) != 0U) &&
+      (uartp->txstate == UART_TX_ACTIVE) &&
+      (edmaStreamGetNode(uartp->edmatx) == NULL) &&
+      ((uartp->edmatx->stream->CTRL & AT32_EDMA_CTRL_SEN) == 0U)) {
+    edmaStreamStopList(uartp->edmatx);
+
+    /* A callback is generated, if enabled, after a completed transfer.*/
+    _uart_tx1_isr_code(uartp);
+  }
+}
+
+/**
+ * @brief   Returns the EDMAMUX request of an USART transmitter.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @return              The EDMAMUX request.
+ * @retval 0            if the unit has no EDMA request.
+ */
+static uint32_t uart_lld_edma_request(UARTDriver *uartp) {
+
+#if AT32_UART_USE_USART1 && defined(AT32_EDMAMUX_USART1_TX)
+  if (&UARTD1 == uartp) {
+    return AT32_EDMAMUX_USART1_TX;
+  }
+#endif
+#if AT32_UART_USE_USART2 && defined(AT32_EDMAMUX_USART2_TX)
+  if (&UARTD2 == uartp) {
+    return AT32_EDMAMUX_USART2_TX;
+  }
+#endif
+#if AT32_UART_USE_USART3 && defined(AT32_EDMAMUX_USART3_TX)
+  if (&UARTD3 == uartp) {
+    return AT32_EDMAMUX_USART3_TX;
+  }
+#endif
+#if AT32_UART_USE_UART4 && defined(AT32_EDMAMUX_UART4_TX)
+  if (&UARTD4 == uartp) {
+    return AT32_EDMAMUX_UART4_TX;
+  }
+#endif
+#if AT32_UART_USE_UART5 && defined(AT32_EDMAMUX_UART5_TX)
+  if (&UARTD5 == uartp) {
+    return AT32_EDMAMUX_UART5_TX;
+  }
+#endif
+#if AT32_UART_USE_USART6 && defined(AT32_EDMAMUX_USART6_TX)
+  if (&UARTD6 == uartp) {
+    return AT32_EDMAMUX_USART6_TX;
+  }
+#endif
+#if AT32_UART_USE_UART7 && defined(AT32_EDMAMUX_UART7_TX)
+  if (&UARTD7 == uartp) {
+    return AT32_EDMAMUX_UART7_TX;
+  }
+#endif
+#if AT32_UART_USE_UART8 && defined(AT32_EDMAMUX_UART8_TX)
+  if (&UARTD8 == uartp) {
+    return AT32_EDMAMUX_UART8_TX;
+  }
+#endif
+
+  (void)uartp;
+
+  return 0U;
+}
+#endif /* AT32_UART_USE_EDMA_LISTS */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -573,6 +666,9 @@ void uart_lld_init(void) {
   UARTD1.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD1.dmarx   = NULL;
   UARTD1.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD1.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_USART2
@@ -583,6 +679,9 @@ void uart_lld_init(void) {
   UARTD2.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD2.dmarx   = NULL;
   UARTD2.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD2.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_USART3
@@ -593,6 +692,9 @@ void uart_lld_init(void) {
   UARTD3.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD3.dmarx   = NULL;
   UARTD3.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD3.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_UART4
@@ -603,6 +705,9 @@ void uart_lld_init(void) {
   UARTD4.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD4.dmarx   = NULL;
   UARTD4.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD4.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_UART5
@@ -613,6 +718,9 @@ void uart_lld_init(void) {
   UARTD5.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD5.dmarx   = NULL;
   UARTD5.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD5.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_USART6
@@ -623,6 +731,9 @@ void uart_lld_init(void) {
   UARTD6.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD6.dmarx   = NULL;
   UARTD6.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD6.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_UART7
@@ -633,6 +744,9 @@ void uart_lld_init(void) {
   UARTD7.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD7.dmarx   = NULL;
   UARTD7.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD7.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_UART8
@@ -643,6 +757,9 @@ void uart_lld_init(void) {
   UARTD8.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD8.dmarx   = NULL;
   UARTD8.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD8.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_UART9
@@ -653,6 +770,9 @@ void uart_lld_init(void) {
   UARTD9.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD9.dmarx   = NULL;
   UARTD9.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD9.edmatx  = NULL;
+#endif
 #endif
 
 #if AT32_UART_USE_UART10
@@ -663,6 +783,9 @@ void uart_lld_init(void) {
   UARTD10.dmatxmode = AT32_DMA_CTRL_DMERRIEN | AT32_DMA_CTRL_DTERRIEN;
   UARTD10.dmarx   = NULL;
   UARTD10.dmatx   = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+  UARTD10.edmatx  = NULL;
+#endif
 #endif
 }
 
@@ -1031,6 +1154,18 @@ void uart_lld_start(UARTDriver *uartp) {
     dmaStreamSetPeripheral(uartp->dmarx, &uartp->usart->DT);
     dmaStreamSetPeripheral(uartp->dmatx, &uartp->usart->DT);
     uartp->rxbuf = 0;
+
+#if AT32_UART_USE_EDMA_LISTS
+    /* Stream for list transfers, units without an EDMA request have none.*/
+    if (uart_lld_edma_request(uartp) != 0U) {
+      uartp->edmatx = edmaStreamAllocI(AT32_EDMA_STREAM_ID_ANY_EDMA1,
+                                       AT32_UART_EDMA_IRQ_PRIORITY,
+                                       (at32_edmasts_t)uart_lld_serve_tx_list_irq,
+                                       (void *)uartp);
+      osalDbgAssert(uartp->edmatx != NULL, "unable to allocate stream");
+      edmaSetRequestSource(uartp->edmatx, uart_lld_edma_request(uartp));
+    }
+#endif
   }
 
   uartp->rxstate = UART_RX_IDLE;
@@ -1053,6 +1188,13 @@ void uart_lld_stop(UARTDriver *uartp) {
     dmaStreamFreeI(uartp->dmatx);
     uartp->dmarx = NULL;
     uartp->dmatx = NULL;
+#if AT32_UART_USE_EDMA_LISTS
+    if (uartp->edmatx != NULL) {
+      edmaStreamStopList(uartp->edmatx);
+      edmaStreamFreeI(uartp->edmatx);
+      uartp->edmatx = NULL;
+    }
+#endif
 
 #if AT32_UART_USE_USART1
     if (&UARTD1 == uartp) {
@@ -1184,6 +1326,18 @@ void uart_lld_start_send(UARTDriver *uartp, size_t n, const void *txbuf) {
  */
 size_t uart_lld_stop_send(UARTDriver *uartp) {
 
+#if AT32_UART_USE_EDMA_LISTS
+  if ((uartp->edmatx != NULL) &&
+      (edmaStreamGetNode(uartp->edmatx) != NULL)) {
+    size_t n = edmaStreamGetTransactionSize(uartp->edmatx);
+
+    /* List transfer, only the frames of the current node are counted.*/
+    edmaStreamStopList(uartp->edmatx);
+
+    return n;
+  }
+#endif
+
   dmaStreamDisable(uartp->dmatx);
 
   return dmaStreamGetTransactionSize(uartp->dmatx);
@@ -1270,6 +1424,119 @@ void uart_lld_serve_interrupt(UARTDriver *uartp) {
   }
 }
 
+#if AT32_UART_USE_EDMA_LISTS || defined(__DOXYGEN__)
+/**
+ * @brief   Starts sending an EDMA list on the UART peripheral.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] np        first node of the list
+ *
+ * @notapi
+ */
+void uart_lld_start_send_list(UARTDriver *uartp, const at32_edma_node_t *np) {
+
+  /* Only enable TC interrupt if there's a callback attached to it or
+     if called from uartSendFullTimeout(). Also we need to clear TC flag
+     which could be set before.*/
+#if UART_USE_WAIT == TRUE
+  if ((uartp->config->txend2_cb != NULL) || (uartp->early == false)) {
+#else
+  if (uartp->config->txend2_cb != NULL) {
+#endif
+    uartp->usart->STS = ~USART_STS_TDC;
+    uartp->usart->CTRL1 |= USART_CTRL1_TDCIEN;
+  }
+
+  /* Starting transfer.*/
+  edmaStreamStartList(uartp->edmatx, np);
+}
+
+/**
+ * @brief   Initializes a list node sending a buffer.
+ * @note    The buffers are organized as uint8_t arrays for data sizes below
+ *          or equal to 8 bits else it is organized as uint16_t arrays.
+ * @note    The frame size is taken from the current configuration, nodes
+ *          must be initialized again after changing it.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[out] np       pointer to the node
+ * @param[in] n         number of data frames to send
+ * @param[in] txbuf     the pointer to the transmit buffer
+ *
+ * @api
+ */
+void uartListNodeInit(UARTDriver *uartp, at32_edma_node_t *np,
+                      size_t n, const void *txbuf) {
+  uint32_t mode;
+
+  osalDbgCheck((uartp != NULL) && (np != NULL) && (txbuf != NULL) &&
+               (n > 0U) && (n < 65536U));
+  osalDbgAssert(uartp->state == UART_READY, "not active");
+
+  /* The transfer size depends on the USART settings, it is 16 bits if
+     M=1 and PCE=0 else it is 8 bits.*/
+  mode = AT32_EDMA_CTRL_DTD_M2P  | AT32_EDMA_CTRL_MINCM    |
+         AT32_EDMA_CTRL_FDTIEN   | AT32_EDMA_CTRL_DMERRIEN |
+         AT32_EDMA_CTRL_DTERRIEN;
+  if ((uartp->config->ctrl1 & (USART_CTRL1_DBN | USART_CTRL1_PEN)) == USART_CTRL1_DBN) {
+    mode |= AT32_EDMA_CTRL_PWIDTH_HWORD | AT32_EDMA_CTRL_MWIDTH_HWORD;
+  }
+  else {
+    mode |= AT32_EDMA_CTRL_PWIDTH_BYTE | AT32_EDMA_CTRL_MWIDTH_BYTE;
+  }
+
+  edmaNodeInit(np, mode, &uartp->usart->DT, txbuf, n);
+}
+
+/**
+ * @brief   Starts sending an EDMA list.
+ * @details The nodes are sent one after the other without CPU
+ *          intervention, the node callbacks are invoked as each node ends
+ *          and the transmission callbacks when the whole list has been
+ *          sent.
+ * @note    The last node must have the @p AT32_EDMA_CTRL_FDTIEN bit set,
+ *          this is the case for nodes initialized by @p uartListNodeInit().
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] np        first node of the list
+ *
+ * @iclass
+ */
+void uartStartSendListI(UARTDriver *uartp, const at32_edma_node_t *np) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((uartp != NULL) && (np != NULL));
+  osalDbgAssert(uartp->state == UART_READY, "is active");
+  osalDbgAssert(uartp->txstate != UART_TX_ACTIVE, "tx active");
+  osalDbgAssert(uartp->edmatx != NULL, "no EDMA stream");
+
+#if UART_USE_WAIT == TRUE
+  uartp->early = true;
+#endif
+  uart_lld_start_send_list(uartp, np);
+  uartp->txstate = UART_TX_ACTIVE;
+}
+
+/**
+ * @brief   Starts sending an EDMA list.
+ * @details The nodes are sent one after the other without CPU
+ *          intervention, the node callbacks are invoked as each node ends
+ *          and the transmission callbacks when the whole list has been
+ *          sent.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] np        first node of the list
+ *
+ * @api
+ */
+void uartStartSendList(UARTDriver *uartp, const at32_edma_node_t *np) {
+
+  osalSysLock();
+  uartStartSendListI(uartp, np);
+  osalSysUnlock();
+}
+#endif /* AT32_UART_USE_EDMA_LISTS */
+
 #endif /* HAL_USE_UART */
 
 /** @} */
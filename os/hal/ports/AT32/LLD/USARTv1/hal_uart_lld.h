@@ -308,6 +308,25 @@
 #define AT32_UART_DMA_ERROR_HOOK(uartp)    osalSysHalt("DMA failure")
 #endif
 
+/**
+ * @brief   Enables the EDMA list transfers.
+ * @details If set to @p TRUE each driver allocates an additional EDMA
+ *          stream for @p uartStartSendList(), scattered buffers are then
+ *          sent with a single arming.
+ * @note    Only on devices with EDMA, the request is routed through the
+ *          EDMAMUX so any free stream is used.
+ */
+#if !defined(AT32_UART_USE_EDMA_LISTS) || defined(__DOXYGEN__)
+#define AT32_UART_USE_EDMA_LISTS           FALSE
+#endif
+
+/**
+ * @brief   EDMA list stream interrupt priority level setting.
+ */
+#if !defined(AT32_UART_EDMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define AT32_UART_EDMA_IRQ_PRIORITY        12
+#endif
+
 #if AT32_DMA_SUPPORTS_DMAMUX && AT32_USE_DMA_V1 
 
 /**
@@ -419,13 +438,11 @@
 #error "USART3 not present in the selected device"
 #endif
 
-#if AT32_UART_USE_UART4
-#if !AT32_HAS_UART4
+#if AT32_UART_USE_UART4 && !AT32_HAS_UART4
 #error "UART4 not present in the selected device"
 #endif
 
-#if AT32_UART_USE_UART5
-#if !AT32_HAS_UART5
+#if AT32_UART_USE_UART5 && !AT32_HAS_UART5
 #error "UART5 not present in the selected device"
 #endif
 
@@ -739,6 +756,20 @@
 #define AT32_DMA_REQUIRED
 #endif
 
+#if AT32_UART_USE_EDMA_LISTS
+#if !AT32_HAS_EDMA1
+#error "EDMA list transfers not supported in the selected device"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(AT32_UART_EDMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to UART EDMA"
+#endif
+
+#if !defined(AT32_EDMA_REQUIRED)
+#define AT32_EDMA_REQUIRED
+#endif
+#endif /* AT32_UART_USE_EDMA_LISTS */
+
 /* Checks on allocation of USARTx units.*/
 #if AT32_UART_USE_USART1
 #if defined(AT32_USART1_IS_USED)
@@ -975,6 +1006,12 @@ struct hal_uart_driver {
    * @brief Transmit DMA channel.
    */
   const at32_dma_stream_t   *dmatx;
+#if AT32_UART_USE_EDMA_LISTS || defined(__DOXYGEN__)
+  /**
+   * @brief Transmit EDMA stream for list transfers.
+   */
+  const at32_edma_stream_t  *edmatx;
+#endif
   /**
    * @brief Default receive buffer while into @p UART_RX_IDLE state.
    */
@@ -1040,6 +1077,13 @@ extern "C" {
   void uart_lld_start_receive(UARTDriver *uartp, size_t n, void *rxbuf);
   size_t uart_lld_stop_receive(UARTDriver *uartp);
   void uart_lld_serve_interrupt(UARTDriver *uartp);
+#if AT32_UART_USE_EDMA_LISTS || defined(__DOXYGEN__)
+  void uart_lld_start_send_list(UARTDriver *uartp, const at32_edma_node_t *np);
+  void uartListNodeInit(UARTDriver *uartp, at32_edma_node_t *np,
+                        size_t n, const void *txbuf);
+  void uartStartSendListI(UARTDriver *uartp, const at32_edma_node_t *np);
+  void uartStartSendList(UARTDriver *uartp, const at32_edma_node_t *np);
+#endif
 #ifdef __cplusplus
 }
 #endif
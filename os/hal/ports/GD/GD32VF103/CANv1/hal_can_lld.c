@@ -40,6 +40,20 @@
 #endif
 #endif
 
+/**
+ * @name    Filter registers encoding
+ * @{
+ */
+#define CAN_FILTER32_STD(sid, rtr)  (((uint32_t)(sid) << 21) |              \
+                                     ((uint32_t)(rtr) << 1))
+#define CAN_FILTER32_EXT(eid, rtr)  (((uint32_t)(eid) << 3) | 4U |          \
+                                     ((uint32_t)(rtr) << 1))
+#define CAN_FILTER32_MASK(m)        (((uint32_t)(m) << 3) | 6U)
+#define CAN_FILTER16_STD(sid, rtr)  (((uint32_t)(sid) << 5) |               \
+                                     ((uint32_t)(rtr) << 4))
+#define CAN_FILTER16_MASK(m)        (((uint32_t)(m) << 5) | 0x18U)
+/** @} */
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -58,6 +72,64 @@ CANDriver CAND2;
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Filter compiler state of a receive FIFO.
+ * @details Entries sharing a bank are kept pending until the bank is full,
+ *          the leftovers are packed together at the end.
+ */
+typedef struct {
+  /**
+   * @brief   Pending 32 bits list entry.
+   */
+  uint32_t                  ext_list;
+  /**
+   * @brief   Pending 16 bits mask entry, mask in the upper half.
+   */
+  uint32_t                  std_mask;
+  /**
+   * @brief   Pending 16 bits list entries.
+   */
+  uint16_t                  std_list[3];
+  /**
+   * @brief   Number of pending 16 bits list entries.
+   */
+  uint8_t                   std_list_n;
+  /**
+   * @brief   Valid flag of @p ext_list.
+   */
+  bool                      has_ext_list;
+  /**
+   * @brief   Valid flag of @p std_mask.
+   */
+  bool                      has_std_mask;
+} can_fc_fifo_t;
+
+/**
+ * @brief   Filter compiler state.
+ */
+typedef struct {
+  /**
+   * @brief   Output filters array.
+   */
+  CANFilter                 *cfp;
+  /**
+   * @brief   First bank number.
+   */
+  uint32_t                  first;
+  /**
+   * @brief   Maximum number of banks.
+   */
+  uint32_t                  max;
+  /**
+   * @brief   Banks emitted so far.
+   */
+  uint32_t                  num;
+  /**
+   * @brief   Per FIFO state.
+   */
+  can_fc_fifo_t             fifo[2];
+} can_fc_t;
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -161,6 +233,266 @@ static void can_lld_set_filters(CANDriver* canp,
 #endif
 }
 
+/**
+ * @brief   Reads and releases the output mailbox of a receive FIFO.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] fifo      FIFO number, 0 or 1
+ * @param[out] crfp     pointer to the buffer where the CAN frame is copied
+ *
+ * @notapi
+ */
+static void can_lld_fetch(CANDriver *canp, uint32_t fifo, CANRxFrame *crfp) {
+  uint32_t rfifomi, rfifomp;
+
+  /* Fetches the message.*/
+  rfifomi  = canp->can->sFIFOMailBox[fifo].RFIFOMI;
+  rfifomp = canp->can->sFIFOMailBox[fifo].RFIFOMP;
+  crfp->data32[0] = canp->can->sFIFOMailBox[fifo].RFIFOMDATA0;
+  crfp->data32[1] = canp->can->sFIFOMailBox[fifo].RFIFOMDATA1;
+
+  /* Releases the mailbox.*/
+  if (fifo == 0U)
+    canp->can->RFIFO0 = CAN_RFIFO0_RFD0;
+  else
+    canp->can->RFIFO1 = CAN_RFIFO1_RFD1;
+
+  /* Decodes the various fields in the RX frame.*/
+  crfp->RTR = (rfifomi & CAN_RFIFOMI0_FT) >> 1;
+  crfp->IDE = (rfifomi & CAN_RFIFOMI0_FF) >> 2;
+  if (crfp->IDE)
+    crfp->EID = rfifomi >> 3;
+  else
+    crfp->SID = rfifomi >> 21;
+  crfp->DLC = rfifomp & CAN_RFIFOMP0_DLENC;
+  crfp->FMI = (uint8_t)(rfifomp >> 8);
+  crfp->TIME = (uint16_t)(rfifomp >> 16);
+}
+
+#if GD32_CAN_USE_RX_RING || defined(__DOXYGEN__)
+/**
+ * @brief   Moves all the frames of a receive FIFO into the software ring.
+ * @details Frames arriving with the ring full are released and counted,
+ *          the hardware FIFO is always emptied so that it cannot overflow
+ *          while the ring is being drained by the threads.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] fifo      FIFO number, 0 or 1
+ *
+ * @notapi
+ */
+static void can_lld_rx_drain(CANDriver *canp, uint32_t fifo) {
+  volatile uint32_t *rfifop = fifo == 0U ? &canp->can->RFIFO0 :
+                                           &canp->can->RFIFO1;
+  systime_t now = osalOsGetSystemTimeX();
+  bool received = false, dropped = false;
+
+  while ((*rfifop & CAN_RFIFO0_RFL0) != 0U) {
+    uint32_t fill = canp->rxwr - canp->rxrd;
+
+    if (fill < (uint32_t)GD32_CAN_RX_RING_SIZE) {
+      CANRxFrame *crfp = &canp->rxring[canp->rxwr &
+                                       ((uint32_t)GD32_CAN_RX_RING_SIZE - 1U)];
+
+      can_lld_fetch(canp, fifo, crfp);
+      crfp->STAMP = now;
+      canp->rxwr++;
+      if (fill + 1U > canp->rxpeak) {
+        canp->rxpeak = fill + 1U;
+      }
+      received = true;
+    }
+    else {
+      /* Ring full, the frame is released unread.*/
+      *rfifop = fifo == 0U ? CAN_RFIFO0_RFD0 : CAN_RFIFO1_RFD1;
+      canp->rx_sw_overruns++;
+      dropped = true;
+    }
+  }
+
+  if (received) {
+    _can_rx_full_isr(canp, CAN_MAILBOX_TO_MASK(fifo + 1U));
+  }
+  if (dropped) {
+    _can_error_isr(canp, CAN_OVERFLOW_ERROR);
+  }
+}
+#endif /* GD32_CAN_USE_RX_RING */
+
+/**
+ * @brief   Allocates the next filter bank.
+ *
+ * @param[in] fcp       pointer to the compiler state
+ * @param[in] fifo      FIFO assignment
+ * @param[in] mode      0=mask mode, 1=list mode
+ * @param[in] scale     0=16 bits, 1=32 bits
+ * @param[in] r1        filter register 1
+ * @param[in] r2        filter register 2
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the bank has been allocated.
+ * @retval HAL_FAILED   if the banks are exhausted.
+ *
+ * @notapi
+ */
+static bool can_fc_emit(can_fc_t *fcp, uint32_t fifo, uint32_t mode,
+                        uint32_t scale, uint32_t r1, uint32_t r2) {
+  CANFilter *cfp;
+
+  if (fcp->num >= fcp->max) {
+    return HAL_FAILED;
+  }
+  cfp = &fcp->cfp[fcp->num];
+  cfp->filter     = fcp->first + fcp->num;
+  cfp->mode       = mode;
+  cfp->scale      = scale;
+  cfp->assignment = fifo;
+  cfp->register1  = r1;
+  cfp->register2  = r2;
+  fcp->num++;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Adds an identifier/mask pair to the filter being compiled.
+ * @details Exact extended identifiers are paired in 32 bits list banks,
+ *          masked extended identifiers take a 32 bits mask bank each,
+ *          masked standard identifiers are paired in 16 bits mask banks
+ *          and exact standard identifiers go four per 16 bits list bank.
+ *
+ * @param[in] fcp       pointer to the compiler state
+ * @param[in] rp        rule the pair comes from
+ * @param[in] id        identifier
+ * @param[in] mask      identifier bits to be compared
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static bool can_fc_add(can_fc_t *fcp, const CANFilterRule *rp,
+                       uint32_t id, uint32_t mask) {
+  can_fc_fifo_t *ffp = &fcp->fifo[rp->fifo];
+  uint32_t v;
+
+  if (rp->ide) {
+    v = CAN_FILTER32_EXT(id, rp->rtr);
+    if (mask != 0x1FFFFFFFU) {
+      return can_fc_emit(fcp, rp->fifo, 0U, 1U, v, CAN_FILTER32_MASK(mask));
+    }
+    if (!ffp->has_ext_list) {
+      ffp->ext_list     = v;
+      ffp->has_ext_list = true;
+      return HAL_SUCCESS;
+    }
+    ffp->has_ext_list = false;
+    return can_fc_emit(fcp, rp->fifo, 1U, 1U, ffp->ext_list, v);
+  }
+
+  v = CAN_FILTER16_STD(id, rp->rtr);
+  if (mask != 0x7FFU) {
+    v |= CAN_FILTER16_MASK(mask) << 16;
+    if (!ffp->has_std_mask) {
+      ffp->std_mask     = v;
+      ffp->has_std_mask = true;
+      return HAL_SUCCESS;
+    }
+    ffp->has_std_mask = false;
+    return can_fc_emit(fcp, rp->fifo, 0U, 0U, ffp->std_mask, v);
+  }
+  if (ffp->std_list_n < 3U) {
+    ffp->std_list[ffp->std_list_n++] = (uint16_t)v;
+    return HAL_SUCCESS;
+  }
+  ffp->std_list_n = 0U;
+  return can_fc_emit(fcp, rp->fifo, 1U, 0U,
+                     ((uint32_t)ffp->std_list[1] << 16) | ffp->std_list[0],
+                     (v << 16) | ffp->std_list[2]);
+}
+
+/**
+ * @brief   Adds a rule to the filter being compiled.
+ * @details The range is split into the minimal set of aligned power of two
+ *          blocks, each one is an identifier/mask pair.
+ *
+ * @param[in] fcp       pointer to the compiler state
+ * @param[in] rp        rule to be added
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static bool can_fc_add_rule(can_fc_t *fcp, const CANFilterRule *rp) {
+  uint32_t full = rp->ide ? 0x1FFFFFFFU : 0x7FFU;
+  uint32_t lo = rp->first, hi = rp->last;
+
+  osalDbgCheck((lo <= hi) && (hi <= full));
+
+  while (true) {
+    uint32_t size = 1U;
+
+    while (((lo & ((size << 1) - 1U)) == 0U) &&
+           (((size << 1) - 1U) <= (hi - lo))) {
+      size <<= 1;
+    }
+    if (can_fc_add(fcp, rp, lo, full & ~(size - 1U)) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+    if ((hi - lo) == (size - 1U)) {
+      return HAL_SUCCESS;
+    }
+    lo += size;
+  }
+}
+
+/**
+ * @brief   Flushes the pending entries of a FIFO.
+ * @details Leftover exact standard identifiers fill the free slots of the
+ *          half used banks before a new 16 bits list bank is allocated,
+ *          unused slots repeat an entry already in the bank.
+ *
+ * @param[in] fcp       pointer to the compiler state
+ * @param[in] fifo      FIFO number
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static bool can_fc_flush(can_fc_t *fcp, uint32_t fifo) {
+  can_fc_fifo_t *ffp = &fcp->fifo[fifo];
+  uint32_t i = 0U, n = ffp->std_list_n;
+  uint32_t r2;
+
+  if (ffp->has_ext_list) {
+    r2 = ffp->ext_list;
+    if (i < n) {
+      uint32_t v = ffp->std_list[i++];
+      r2 = CAN_FILTER32_STD(v >> 5, (v >> 4) & 1U);
+    }
+    if (can_fc_emit(fcp, fifo, 1U, 1U, ffp->ext_list, r2) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+  }
+  if (ffp->has_std_mask) {
+    r2 = ffp->std_mask;
+    if (i < n) {
+      r2 = (CAN_FILTER16_MASK(0x7FFU) << 16) | ffp->std_list[i++];
+    }
+    if (can_fc_emit(fcp, fifo, 0U, 0U, ffp->std_mask, r2) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+  }
+  if (i < n) {
+    uint32_t v[4], k;
+
+    for (k = 0U; k < 4U; k++) {
+      v[k] = ffp->std_list[i + k < n ? i + k : n - 1U];
+    }
+    if (can_fc_emit(fcp, fifo, 1U, 0U, (v[1] << 16) | v[0],
+                    (v[3] << 16) | v[2]) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+  }
+
+  return HAL_SUCCESS;
+}
+
 /**
  * @brief   Common TX ISR handler.
  *
@@ -224,14 +556,21 @@ static void can_lld_rx0_handler(CANDriver *canp) {
   uint32_t rfifo0;
 
   rfifo0 = canp->can->RFIFO0;
+#if GD32_CAN_USE_RX_RING
+  can_lld_rx_drain(canp, 0U);
+#else
   if ((rfifo0 & CAN_RFIFO0_RFL0) > 0) {
     /* No more receive events until the queue 0 has been emptied.*/
     canp->can->INTEN &= ~CAN_INTEN_RFNEIE0;
     _can_rx_full_isr(canp, CAN_MAILBOX_TO_MASK(1U));
   }
+#endif
   if ((rfifo0 & CAN_RFIFO0_RFO0) > 0) {
     /* Overflow events handling.*/
     canp->can->RFIFO0 = CAN_RFIFO0_RFO0;
+#if GD32_CAN_USE_RX_RING
+    canp->rx_hw_overruns++;
+#endif
     _can_error_isr(canp, CAN_OVERFLOW_ERROR);
   }
 }
@@ -247,14 +586,21 @@ static void can_lld_rx1_handler(CANDriver *canp) {
   uint32_t rfifo1;
 
   rfifo1 = canp->can->RFIFO1;
+#if GD32_CAN_USE_RX_RING
+  can_lld_rx_drain(canp, 1U);
+#else
   if ((rfifo1 & CAN_RFIFO1_RFL1) > 0) {
     /* No more receive events until the queue 0 has been emptied.*/
     canp->can->INTEN &= ~CAN_INTEN_RFNEIE1;
     _can_rx_full_isr(canp, CAN_MAILBOX_TO_MASK(2U));
   }
+#endif
   if ((rfifo1 & CAN_RFIFO1_RFO1) > 0) {
     /* Overflow events handling.*/
     canp->can->RFIFO1 = CAN_RFIFO1_RFO1;
+#if GD32_CAN_USE_RX_RING
+    canp->rx_hw_overruns++;
+#endif
     _can_error_isr(canp, CAN_OVERFLOW_ERROR);
   }
 }
@@ -515,7 +861,17 @@ void can_lld_start(CANDriver *canp) {
   while ((canp->can->STAT & CAN_STAT_IWS) == 0)
     osalThreadSleepS(1);
   canp->can->BT = canp->config->bt;
+#if GD32_CAN_USE_RX_RING
+  /* Time triggered mode for the hardware time stamps.*/
+  canp->rxrd           = 0U;
+  canp->rxwr           = 0U;
+  canp->rxpeak         = 0U;
+  canp->rx_sw_overruns = 0U;
+  canp->rx_hw_overruns = 0U;
+  canp->can->CTL = canp->config->ctl | CAN_CTL_TTC;
+#else
   canp->can->CTL = canp->config->ctl;
+#endif
 
   /* Interrupt sources initialization.*/
 #if GD32_CAN_REPORT_ALL_ERRORS
@@ -660,6 +1016,12 @@ void can_lld_transmit(CANDriver *canp,
  */
 bool can_lld_is_rx_nonempty(CANDriver *canp, canmbx_t mailbox) {
 
+#if GD32_CAN_USE_RX_RING
+  if ((mailbox == CAN_ANY_MAILBOX) || (mailbox == 1U) || (mailbox == 2U)) {
+    return canp->rxwr != canp->rxrd;
+  }
+  return false;
+#else
   switch (mailbox) {
   case CAN_ANY_MAILBOX:
     return ((canp->can->RFIFO0 & CAN_RFIFO0_RFL0) != 0 ||
@@ -671,6 +1033,7 @@ bool can_lld_is_rx_nonempty(CANDriver *canp, canmbx_t mailbox) {
   default:
     return false;
   }
+#endif
 }
 
 /**
@@ -685,8 +1048,17 @@ bool can_lld_is_rx_nonempty(CANDriver *canp, canmbx_t mailbox) {
 void can_lld_receive(CANDriver *canp,
                      canmbx_t mailbox,
                      CANRxFrame *crfp) {
-  uint32_t rfifomi, rfifomp;
 
+#if GD32_CAN_USE_RX_RING
+  (void)mailbox;
+
+  if (canp->rxwr == canp->rxrd) {
+    /* Should not happen, do nothing.*/
+    return;
+  }
+  *crfp = canp->rxring[canp->rxrd & ((uint32_t)GD32_CAN_RX_RING_SIZE - 1U)];
+  canp->rxrd++;
+#else
   if (mailbox == CAN_ANY_MAILBOX) {
     if ((canp->can->RFIFO0 & CAN_RFIFO0_RFL0) != 0)
       mailbox = 1;
@@ -699,14 +1071,7 @@ void can_lld_receive(CANDriver *canp,
   }
   switch (mailbox) {
   case 1:
-    /* Fetches the message.*/
-    rfifomi  = canp->can->sFIFOMailBox[0].RFIFOMI;
-    rfifomp = canp->can->sFIFOMailBox[0].RFIFOMP;
-    crfp->data32[0] = canp->can->sFIFOMailBox[0].RFIFOMDATA0;
-    crfp->data32[1] = canp->can->sFIFOMailBox[0].RFIFOMDATA1;
-
-    /* Releases the mailbox.*/
-    canp->can->RFIFO0 = CAN_RFIFO0_RFD0;
+    can_lld_fetch(canp, 0U, crfp);
 
     /* If the queue is empty re-enables the interrupt in order to generate
        events again.*/
@@ -714,14 +1079,7 @@ void can_lld_receive(CANDriver *canp,
       canp->can->INTEN |= CAN_INTEN_RFNEIE0;
     break;
   case 2:
-    /* Fetches the message.*/
-    rfifomi  = canp->can->sFIFOMailBox[1].RFIFOMI;
-    rfifomp = canp->can->sFIFOMailBox[1].RFIFOMP;
-    crfp->data32[0] = canp->can->sFIFOMailBox[1].RFIFOMDATA0;
-    crfp->data32[1] = canp->can->sFIFOMailBox[1].RFIFOMDATA1;
-
-    /* Releases the mailbox.*/
-    canp->can->RFIFO1 = CAN_RFIFO1_RFD1;
+    can_lld_fetch(canp, 1U, crfp);
 
     /* If the queue is empty re-enables the interrupt in order to generate
        events again.*/
@@ -732,17 +1090,7 @@ void can_lld_receive(CANDriver *canp,
     /* Should not happen, do nothing.*/
     return;
   }
-
-  /* Decodes the various fields in the RX frame.*/
-  crfp->RTR = (rfifomi & CAN_RFIFOMI0_FT) >> 1;
-  crfp->IDE = (rfifomi & CAN_RFIFOMI0_FF) >> 2;
-  if (crfp->IDE)
-    crfp->EID = rfifomi >> 3;
-  else
-    crfp->SID = rfifomi >> 21;
-  crfp->DLC = rfifomp & CAN_RFIFOMP0_DLENC;
-  crfp->FMI = (uint8_t)(rfifomp >> 8);
-  crfp->TIME = (uint16_t)(rfifomp >> 16);
+#endif
 }
 
 /**
@@ -820,6 +1168,63 @@ void canGD32SetFilters(CANDriver *canp, uint32_t can2sb,
 #endif
 }
 
+/**
+ * @brief   Compiles a list of acceptance rules into filter banks.
+ * @details Single identifiers and identifier ranges are packed into the
+ *          minimal number of banks, mixing 32 and 16 bits scales and mask
+ *          and list modes, each bank is assigned to the FIFO of its rules.
+ *          The result can be passed to @p canGD32SetFilters().
+ * @note    An empty rules list compiles to zero banks, which
+ *          @p canGD32SetFilters() turns into the accept all filter.
+ * @note    This is an GD32-specific API.
+ *
+ * @param[in] rules     pointer to the rules array
+ * @param[in] n         number of rules
+ * @param[in] first     number of the first bank to be used, the value of
+ *                      @p can2sb for CAN1 filters
+ * @param[in] max       maximum number of banks to be used
+ * @param[out] cfp      pointer to an array of @p max filters
+ * @param[out] nump     number of filters written in @p cfp
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the rules have been compiled.
+ * @retval HAL_FAILED   if the rules do not fit in @p max banks.
+ *
+ * @api
+ */
+bool canGD32CompileFilters(const CANFilterRule *rules, uint32_t n,
+                           uint32_t first, uint32_t max,
+                           CANFilter *cfp, uint32_t *nump) {
+  can_fc_t fc;
+  uint32_t i;
+
+  osalDbgCheck(((rules != NULL) || (n == 0U)) && (cfp != NULL) &&
+               (nump != NULL) && (first + max <= GD32_CAN_MAX_FILTERS));
+
+  fc.cfp   = cfp;
+  fc.first = first;
+  fc.max   = max;
+  fc.num   = 0U;
+  for (i = 0U; i < 2U; i++) {
+    fc.fifo[i].std_list_n   = 0U;
+    fc.fifo[i].has_ext_list = false;
+    fc.fifo[i].has_std_mask = false;
+  }
+
+  for (i = 0U; i < n; i++) {
+    if (can_fc_add_rule(&fc, &rules[i]) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+  }
+  for (i = 0U; i < 2U; i++) {
+    if (can_fc_flush(&fc, i) != HAL_SUCCESS) {
+      return HAL_FAILED;
+    }
+  }
+  *nump = fc.num;
+
+  return HAL_SUCCESS;
+}
+
 #endif /* HAL_USE_CAN */
 
 /** @} */
@@ -73,6 +73,14 @@
 #define CAN_RTR_REMOTE              1           /**< @brief Remote frame.   */
 /** @} */
 
+/**
+ * @name    Filter FIFO assignments
+ * @{
+ */
+#define CAN_FILTER_FIFO0            0           /**< @brief Receive FIFO 0. */
+#define CAN_FILTER_FIFO1            1           /**< @brief Receive FIFO 1. */
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -136,6 +144,28 @@
 #endif
 /** @} */
 
+/**
+ * @brief   Software receive ring switch.
+ * @details If set to @p TRUE the receive ISRs drain both hardware FIFOs
+ *          into a software ring, so bursts longer than the three hardware
+ *          mailboxes are not lost while the receiving threads are busy.
+ *          Frames are stamped with the system time on reception and the
+ *          time triggered mode is enabled so that @p TIME holds the
+ *          hardware bit time counter captured at the SOF.
+ * @note    Both mailboxes read the same ring in arrival order.
+ */
+#if !defined(GD32_CAN_USE_RX_RING) || defined(__DOXYGEN__)
+#define GD32_CAN_USE_RX_RING               FALSE
+#endif
+
+/**
+ * @brief   Software receive ring depth in frames.
+ * @note    Must be a power of two.
+ */
+#if !defined(GD32_CAN_RX_RING_SIZE) || defined(__DOXYGEN__)
+#define GD32_CAN_RX_RING_SIZE              32
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -172,6 +202,12 @@
 #error "CAN sleep mode not supported in this architecture"
 #endif
 
+#if GD32_CAN_USE_RX_RING &&                                                 \
+    ((GD32_CAN_RX_RING_SIZE < 4) ||                                         \
+     ((GD32_CAN_RX_RING_SIZE & (GD32_CAN_RX_RING_SIZE - 1)) != 0))
+#error "GD32_CAN_RX_RING_SIZE must be a power of two not lower than 4"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -234,6 +270,9 @@ typedef struct {
     uint8_t                 FMI;            /**< @brief Filter id.          */
     uint16_t                TIME;           /**< @brief Time stamp.         */
   };
+#if GD32_CAN_USE_RX_RING || defined(__DOXYGEN__)
+  systime_t                 STAMP;          /**< @brief System time stamp.  */
+#endif
   struct {
     uint8_t                 DLC:4;          /**< @brief Data length.        */
     uint8_t                 RTR:1;          /**< @brief Frame type.         */
@@ -277,9 +316,9 @@ typedef struct {
    */
   uint32_t                  scale:1;
   /**
-   * @brief   Filter mode.
+   * @brief   Filter FIFO assignment.
    * @note    This bit represent the CAN_FAFIFO register bit associated to this
-   *          filter, must be set to zero in this version of the driver.
+   *          filter (0=FIFO 0, 1=FIFO 1).
    */
   uint32_t                  assignment:1;
   /**
@@ -292,6 +331,35 @@ typedef struct {
   uint32_t                  register2;
 } CANFilter;
 
+/**
+ * @brief   CAN acceptance rule.
+ * @details A rule accepts a single identifier or an identifier range, a
+ *          list of rules is compiled into filter banks by
+ *          @p canGD32CompileFilters().
+ */
+typedef struct {
+  /**
+   * @brief   First accepted identifier.
+   */
+  uint32_t                  first;
+  /**
+   * @brief   Last accepted identifier, equal to @p first for a single one.
+   */
+  uint32_t                  last;
+  /**
+   * @brief   Identifier type, @p CAN_IDE_STD or @p CAN_IDE_EXT.
+   */
+  uint8_t                   ide:1;
+  /**
+   * @brief   Accepted frame type, @p CAN_RTR_DATA or @p CAN_RTR_REMOTE.
+   */
+  uint8_t                   rtr:1;
+  /**
+   * @brief   Destination FIFO, @p CAN_FILTER_FIFO0 or @p CAN_FILTER_FIFO1.
+   */
+  uint8_t                   fifo:1;
+} CANFilterRule;
+
 /**
  * @brief   Driver configuration structure.
  */
@@ -404,12 +472,49 @@ struct CANDriver {
    * @brief   Pointer to the CAN registers.
    */
   CAN_TypeDef               *can;
+#if GD32_CAN_USE_RX_RING || defined(__DOXYGEN__)
+  /**
+   * @brief   Software receive ring.
+   */
+  CANRxFrame                rxring[GD32_CAN_RX_RING_SIZE];
+  /**
+   * @brief   Ring read counter.
+   */
+  uint32_t                  rxrd;
+  /**
+   * @brief   Ring write counter.
+   */
+  uint32_t                  rxwr;
+  /**
+   * @brief   Highest ring fill level seen.
+   */
+  uint32_t                  rxpeak;
+  /**
+   * @brief   Frames dropped because the ring was full.
+   */
+  uint32_t                  rx_sw_overruns;
+  /**
+   * @brief   Frames lost because a hardware FIFO overflowed.
+   */
+  uint32_t                  rx_hw_overruns;
+#endif
 };
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if GD32_CAN_USE_RX_RING || defined(__DOXYGEN__)
+/**
+ * @brief   Frames waiting in the software receive ring.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ *
+ * @xclass
+ */
+#define canGD32GetRxPendingX(canp) ((canp)->rxwr - (canp)->rxrd)
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -444,6 +549,9 @@ extern "C" {
 #endif /* CAN_USE_SLEEP_MODE */
   void canGD32SetFilters(CANDriver *canp, uint32_t can2sb,
                           uint32_t num, const CANFilter *cfp);
+  bool canGD32CompileFilters(const CANFilterRule *rules, uint32_t n,
+                             uint32_t first, uint32_t max,
+                             CANFilter *cfp, uint32_t *nump);
 #ifdef __cplusplus
 }
 #endif
@@ -117,6 +117,14 @@
 #endif
 #endif
 
+/**
+ * @brief   The unit cannot be reloaded, CRC contexts run in software.
+ * @details It has no INIT register and only takes whole words, MSB first,
+ *          so it can neither restore a context value nor feed a byte
+ *          stream in order.
+ */
+#define CRC_LLD_SUPPORTS_CONTEXTS           FALSE
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
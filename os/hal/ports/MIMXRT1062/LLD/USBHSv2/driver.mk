@@ -0,0 +1,19 @@
+# Shared by the MIMXRT1062 and MIMXRT1064 platforms, MIMXRT_DEVICE selects
+# the device support files.
+MIMXRT_DEVICE ?= MIMXRT1062
+
+HAL_USB_SRC = ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/USBHSv2/hal_usb_lld.c \
+              ${CHIBIOS_CONTRIB}/ext/mcux-sdk/devices/$(MIMXRT_DEVICE)/drivers/fsl_clock.c
+
+# fsl_clock.c is shared with other drivers, it must be built only once.
+ifeq ($(USE_SMART_BUILD),yes)
+ifneq ($(findstring HAL_USE_USB TRUE,$(HALCONF)),)
+PLATFORMSRC_CONTRIB += $(filter-out $(PLATFORMSRC_CONTRIB),${HAL_USB_SRC})
+endif
+else
+PLATFORMSRC_CONTRIB += $(filter-out $(PLATFORMSRC_CONTRIB),${HAL_USB_SRC})
+endif
+
+PLATFORMINC_CONTRIB += ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/USBHSv2 \
+                       ${CHIBIOS_CONTRIB}/ext/mcux-sdk/drivers/common \
+                       ${CHIBIOS_CONTRIB}/ext/mcux-sdk/devices/$(MIMXRT_DEVICE)
@@ -0,0 +1,815 @@
+/*
+    ChibiOS - Copyright (C) 2015 RedoX https://github.com/RedoXyde/
+                        (C) 2015-2016 flabbergast <s3+flabbergast@sdfeu.org>
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    USBHSv2/hal_usb_lld.c
+ * @brief   MIMXRT1062 and MIMXRT1064 USB subsystem low level driver source.
+ * @note    page 2203 in https://www.pjrc.com/teensy/IMXRT1060RM_rev2.pdf,
+ *          chapter 42 USB, "Device Data Structures".
+ *
+ * @addtogroup USB
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#include "fsl_clock.h"
+
+#if HAL_USE_USB || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @name    dQH capabilities word
+ * @{
+ */
+#define DQH_CONFIG_MULT(n)          ((uint32_t)(n) << 30U)
+#define DQH_CONFIG_ZLT_DISABLE      (1U << 29U)
+#define DQH_CONFIG_MAXPKT(n)        ((uint32_t)(n) << 16U)
+#define DQH_CONFIG_IOS              (1U << 15U)
+/** @} */
+
+/**
+ * @name    dTD link and token words
+ * @{
+ */
+#define DTD_TERMINATE               (1U << 0U)
+#define DTD_TOKEN_TOTAL(n)          ((uint32_t)(n) << 16U)
+#define DTD_TOKEN_GET_TOTAL(tok)    (((tok) >> 16U) & 0x7FFFU)
+#define DTD_TOKEN_IOC               (1U << 15U)
+#define DTD_TOKEN_MULTO(n)          ((uint32_t)(n) << 10U)
+#define DTD_TOKEN_ACTIVE            (1U << 7U)
+#define DTD_TOKEN_HALTED            (1U << 6U)
+#define DTD_TOKEN_BUFERR            (1U << 5U)
+#define DTD_TOKEN_XACTERR           (1U << 3U)
+#define DTD_TOKEN_ERRORS            (DTD_TOKEN_HALTED | DTD_TOKEN_BUFERR |  \
+                                     DTD_TOKEN_XACTERR)
+/** @} */
+
+/**
+ * @brief   Endpoint bit in the ENDPTPRIME/STAT/COMPLETE/FLUSH registers.
+ */
+#define EP_OUT_MASK(ep)             (1U << (ep))
+#define EP_IN_MASK(ep)              (1U << ((ep) + 16U))
+
+/**
+ * @brief   Index of an endpoint direction in the dQH list.
+ */
+#define DQH_OUT(ep)                 ((ep) * 2U)
+#define DQH_IN(ep)                  (((ep) * 2U) + 1U)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/** @brief USB1 driver identifier.*/
+#if MIMXRT106X_USB_USE_USB1 || defined(__DOXYGEN__)
+USBDriver USBD1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Device transfer descriptor.
+ */
+typedef struct {
+  volatile uint32_t             next;
+  volatile uint32_t             token;
+  volatile uint32_t             page[5];
+  /**
+   * @brief   Bytes requested with this descriptor, driver use.
+   */
+  uint32_t                      size;
+} usb_dtd_t;
+
+/**
+ * @brief   Device queue head.
+ */
+typedef struct {
+  volatile uint32_t             config;
+  volatile uint32_t             current;
+  /* Transfer overlay area.*/
+  volatile uint32_t             next;
+  volatile uint32_t             token;
+  volatile uint32_t             page[5];
+  volatile uint32_t             reserved;
+  /* Setup packet, written by the controller on control endpoints.*/
+  volatile uint32_t             setup[2];
+  /* Pads the dQH to 64 bytes.*/
+  uint32_t                      pad[4];
+} usb_dqh_t;
+
+/**
+ * @brief   dQH list, one per endpoint direction, OUT first.
+ * @note    The list must be aligned to 2kB. The default linker scripts place
+ *          .bss in the DTCM, which is not cached, so neither the dQHs nor
+ *          the dTDs need cache maintenance.
+ */
+static usb_dqh_t qhs[MIMXRT106X_USB_ENDPOINTS * 2U] __attribute__((aligned(2048)));
+
+/**
+ * @brief   dTD pool, a chain per endpoint direction.
+ */
+static usb_dtd_t tds[MIMXRT106X_USB_ENDPOINTS * 2U][MIMXRT106X_USB_DTDS_PER_EP] __attribute__((aligned(32)));
+
+/**
+ * @brief   IN EP0 state.
+ */
+static USBInEndpointState ep0in;
+
+/**
+ * @brief   OUT EP0 state.
+ */
+static USBOutEndpointState ep0out;
+
+/**
+ * @brief   Buffer for the EP0 setup packets.
+ */
+static uint8_t ep0setup_buffer[8];
+
+/**
+ * @brief   EP0 initialization structure.
+ */
+static const USBEndpointConfig ep0config = {
+  USB_EP_MODE_TYPE_CTRL,
+  _usb_ep0setup,
+  _usb_ep0in,
+  _usb_ep0out,
+  64,
+  64,
+  &ep0in,
+  &ep0out,
+  1,
+  ep0setup_buffer
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the control register of an endpoint.
+ */
+static volatile uint32_t *usb_epctrl(usbep_t ep) {
+
+  return ep == 0U ? &USB1->ENDPTCTRL0 : &USB1->ENDPTCTRL[ep - 1U];
+}
+
+/**
+ * @brief   Flushes primed buffers of the endpoints in @p mask.
+ */
+static void usb_flush(uint32_t mask) {
+
+  do {
+    USB1->ENDPTFLUSH = mask;
+    while ((USB1->ENDPTFLUSH & mask) != 0U) {
+    }
+  } while ((USB1->ENDPTSTAT & mask) != 0U);
+}
+
+/**
+ * @brief   Builds and primes the dTD chain of a transaction.
+ * @details The buffer is split in dTDs of up to 16kB linked together and
+ *          primed at once, the controller walks the chain without any
+ *          software intervention. IN chains interrupt on the last dTD
+ *          only, OUT chains on every dTD because a short packet retires
+ *          the dTD it lands in and the rest of the chain must be flushed.
+ *
+ * @param[in] idx       dQH index
+ * @param[in] buf       transfer buffer
+ * @param[in] n         transfer size, zero for a zero length packet
+ * @param[in] token     extra token bits for every dTD
+ * @param[in] allioc    interrupt on every dTD
+ * @param[in] mask      endpoint bit to prime
+ * @return              The number of dTDs in the chain.
+ */
+static uint8_t usb_prime(unsigned idx, const uint8_t *buf, size_t n,
+                         uint32_t token, bool allioc, uint32_t mask) {
+  usb_dtd_t *td = &tds[idx][0];
+  usb_dqh_t *qh = &qhs[idx];
+  uint8_t cnt = 0U;
+
+  osalDbgAssert(n <= (size_t)MIMXRT106X_USB_DTDS_PER_EP *
+                     MIMXRT106X_USB_DTD_MAX_SIZE,
+                "transaction exceeds the dTD chain");
+
+  do {
+    uint32_t addr = (uint32_t)buf;
+    uint32_t size = n > MIMXRT106X_USB_DTD_MAX_SIZE ?
+                    MIMXRT106X_USB_DTD_MAX_SIZE : (uint32_t)n;
+    unsigned i;
+
+    td->next  = DTD_TERMINATE;
+    td->token = DTD_TOKEN_TOTAL(size) | DTD_TOKEN_ACTIVE | token |
+                (allioc ? DTD_TOKEN_IOC : 0U);
+    td->size  = size;
+    td->page[0] = addr;
+    for (i = 1U; i < 5U; i++) {
+      td->page[i] = (addr & ~0xFFFU) + (i * 0x1000U);
+    }
+    if (cnt > 0U) {
+      td[-1].next = (uint32_t)td;
+    }
+    cnt++;
+    td++;
+    buf += size;
+    n -= size;
+  } while (n > 0U);
+  td[-1].token |= DTD_TOKEN_IOC;
+
+  /* Hands the chain to the queue head, the endpoint is idle so the overlay
+     can be written directly.*/
+  qh->next  = (uint32_t)&tds[idx][0];
+  qh->token = 0U;
+  __DSB();
+  USB1->ENDPTPRIME = mask;
+
+  return cnt;
+}
+
+/**
+ * @brief   Checks a completed OUT chain.
+ * @details The transaction ends when the last dTD retires or when a dTD
+ *          retires short, in the latter case the dTDs left are flushed.
+ *
+ * @param[in] ep        endpoint number
+ * @param[in] osp       endpoint state
+ * @return              @p true if the transaction is over.
+ */
+static bool usb_out_done(usbep_t ep, USBOutEndpointState *osp) {
+  usb_dtd_t *td = &tds[DQH_OUT(ep)][0];
+  size_t cnt = 0U;
+  uint8_t i;
+
+  for (i = 0U; i < osp->tdcnt; i++) {
+    uint32_t token = td[i].token;
+    uint32_t got;
+
+    if ((token & DTD_TOKEN_ACTIVE) != 0U) {
+      return false;
+    }
+    got = td[i].size - DTD_TOKEN_GET_TOTAL(token);
+    cnt += got;
+    if ((got < td[i].size) || ((token & DTD_TOKEN_ERRORS) != 0U)) {
+      if (i + 1U < osp->tdcnt) {
+        usb_flush(EP_OUT_MASK(ep));
+      }
+      break;
+    }
+  }
+  osp->rxcnt = cnt;
+
+  return true;
+}
+
+/**
+ * @brief   Reads a setup packet from the EP0 queue head.
+ * @note    The setup tripwire guards against a new setup packet overwriting
+ *          the buffer while it is being copied.
+ */
+static void usb_read_setup_packet(uint8_t *buf) {
+  usb_dqh_t *qh = &qhs[DQH_OUT(0U)];
+  uint32_t setup[2];
+
+  USB1->ENDPTSETUPSTAT = 1U;
+  do {
+    USB1->USBCMD |= USB_USBCMD_SUTW_MASK;
+    setup[0] = qh->setup[0];
+    setup[1] = qh->setup[1];
+  } while ((USB1->USBCMD & USB_USBCMD_SUTW_MASK) == 0U);
+  USB1->USBCMD &= ~USB_USBCMD_SUTW_MASK;
+  memcpy(buf, setup, 8U);
+}
+
+/**
+ * @brief   Serves the transfer completions.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ */
+static void usb_serve_endpoints(USBDriver *usbp) {
+  uint32_t complete = USB1->ENDPTCOMPLETE;
+  usbep_t ep;
+
+  USB1->ENDPTCOMPLETE = complete;
+
+  for (ep = 0U; ep < MIMXRT106X_USB_ENDPOINTS; ep++) {
+    const USBEndpointConfig *epcp = usbp->epc[ep];
+
+    if (epcp == NULL) {
+      continue;
+    }
+
+    if (((complete & EP_OUT_MASK(ep)) != 0U) &&
+        ((usbp->receiving & (1U << ep)) != 0U)) {
+      USBOutEndpointState *osp = epcp->out_state;
+
+      if (usb_out_done(ep, osp)) {
+        cacheBufferInvalidate(osp->rxbuf, osp->rxcnt);
+        _usb_isr_invoke_out_cb(usbp, ep);
+      }
+    }
+
+    if (((complete & EP_IN_MASK(ep)) != 0U) &&
+        ((usbp->transmitting & (1U << ep)) != 0U)) {
+      USBInEndpointState *isp = epcp->in_state;
+
+      if ((tds[DQH_IN(ep)][isp->tdcnt - 1U].token & DTD_TOKEN_ACTIVE) == 0U) {
+        isp->txcnt = isp->txsize;
+        _usb_isr_invoke_in_cb(usbp, ep);
+      }
+    }
+  }
+}
+
+/**
+ * @brief   USB shared ISR.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+static void usb_lld_serve_interrupt(USBDriver *usbp) {
+  uint32_t sts = USB1->USBSTS & USB1->USBINTR;
+
+  USB1->USBSTS = sts;
+
+  /* Bus reset, aborts everything.*/
+  if ((sts & USB_USBSTS_URI_MASK) != 0U) {
+    USB1->ENDPTSETUPSTAT = USB1->ENDPTSETUPSTAT;
+    USB1->ENDPTCOMPLETE  = USB1->ENDPTCOMPLETE;
+    while (USB1->ENDPTPRIME != 0U) {
+    }
+    USB1->ENDPTFLUSH = 0xFFFFFFFFU;
+    _usb_reset(usbp);
+    return;
+  }
+
+  /* Transfer completions first so that an EP0 status stage retires before
+     the next setup packet is processed.*/
+  if ((sts & (USB_USBSTS_UI_MASK | USB_USBSTS_UEI_MASK)) != 0U) {
+    usb_serve_endpoints(usbp);
+
+    if ((USB1->ENDPTSETUPSTAT & 1U) != 0U) {
+      usb_read_setup_packet(usbp->epc[0]->setup_buf);
+
+      /* A setup packet cancels whatever EP0 was doing.*/
+      usb_flush(EP_OUT_MASK(0U) | EP_IN_MASK(0U));
+      usbp->receiving    &= ~1U;
+      usbp->transmitting &= ~1U;
+      _usb_isr_invoke_setup_cb(usbp, 0U);
+    }
+  }
+
+  if ((sts & USB_USBSTS_SLI_MASK) != 0U) {
+    _usb_suspend(usbp);
+  }
+
+  if ((sts & USB_USBSTS_PCI_MASK) != 0U) {
+    if ((usbp->state == USB_SUSPENDED) &&
+        ((USB1->PORTSC1 & USB_PORTSC1_SUSP_MASK) == 0U)) {
+      _usb_wakeup(usbp);
+    }
+  }
+
+  if ((sts & USB_USBSTS_SRI_MASK) != 0U) {
+    _usb_isr_invoke_sof_cb(usbp);
+  }
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+#if MIMXRT106X_USB_USE_USB1 || defined(__DOXYGEN__)
+/**
+ * @brief   USB interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(MIMXRT106X_USB_OTG1_IRQ_VECTOR) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  usb_lld_serve_interrupt(&USBD1);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* MIMXRT106X_USB_USE_USB1 */
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level USB driver initialization.
+ *
+ * @notapi
+ */
+void usb_lld_init(void) {
+
+#if MIMXRT106X_USB_USE_USB1
+  /* Driver initialization.*/
+  usbObjectInit(&USBD1);
+#endif /* MIMXRT106X_USB_USE_USB1 */
+}
+
+/**
+ * @brief   Configures and activates the USB peripheral.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+void usb_lld_start(USBDriver *usbp) {
+
+  if (usbp->state == USB_STOP) {
+#if MIMXRT106X_USB_USE_USB1
+    if (&USBD1 == usbp) {
+      /* USB PHY configuration */
+#ifndef BOARD_USB_PHY_D_CAL
+#define BOARD_USB_PHY_D_CAL (0x0CU)
+#endif
+#ifndef BOARD_USB_PHY_TXCAL45DP
+#define BOARD_USB_PHY_TXCAL45DP (0x06U)
+#endif
+#ifndef BOARD_USB_PHY_TXCAL45DM
+#define BOARD_USB_PHY_TXCAL45DM (0x06U)
+#endif
+      CLOCK_EnableUsbhs0PhyPllClock(kCLOCK_Usbphy480M, 480000000U);
+      CLOCK_EnableUsbhs0Clock(kCLOCK_Usb480M, 480000000U);
+
+      USBPHY1->CTRL_CLR = USBPHY_CTRL_SFTRST_MASK | USBPHY_CTRL_CLKGATE_MASK;
+      USBPHY1->CTRL_SET = USBPHY_CTRL_ENUTMILEVEL2_MASK |
+                          USBPHY_CTRL_ENUTMILEVEL3_MASK;
+      USBPHY1->PWD = 0U;
+      USBPHY1->TX = (USBPHY1->TX & ~(USBPHY_TX_D_CAL_MASK |
+                                     USBPHY_TX_TXCAL45DM_MASK |
+                                     USBPHY_TX_TXCAL45DP_MASK)) |
+                    USBPHY_TX_D_CAL(BOARD_USB_PHY_D_CAL) |
+                    USBPHY_TX_TXCAL45DM(BOARD_USB_PHY_TXCAL45DM) |
+                    USBPHY_TX_TXCAL45DP(BOARD_USB_PHY_TXCAL45DP);
+
+      /* Controller reset, then device mode with setup lockouts off.*/
+      USB1->USBCMD |= USB_USBCMD_RST_MASK;
+      while ((USB1->USBCMD & USB_USBCMD_RST_MASK) != 0U) {
+      }
+      USB1->USBMODE = USB_USBMODE_CM(2U) | USB_USBMODE_SLOM_MASK;
+      USB1->BURSTSIZE = 0x0404U;
+
+      memset(qhs, 0, sizeof qhs);
+      USB1->ENDPTLISTADDR = (uint32_t)qhs;
+
+      USB1->USBINTR = USB_USBINTR_UE_MASK | USB_USBINTR_UEE_MASK |
+                      USB_USBINTR_PCE_MASK | USB_USBINTR_URE_MASK |
+                      USB_USBINTR_SLE_MASK |
+                      (usbp->config->sof_cb != NULL ? USB_USBINTR_SRE_MASK : 0U);
+
+      nvicEnableVector(USB_OTG1_IRQn, MIMXRT106X_USB_USB1_IRQ_PRIORITY);
+    }
+#endif /* MIMXRT106X_USB_USE_USB1 */
+  }
+}
+
+/**
+ * @brief   Deactivates the USB peripheral.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+void usb_lld_stop(USBDriver *usbp) {
+
+  if (usbp->state != USB_STOP) {
+#if MIMXRT106X_USB_USE_USB1
+    if (&USBD1 == usbp) {
+      nvicDisableVector(USB_OTG1_IRQn);
+      USB1->USBINTR = 0U;
+      USB1->USBCMD &= ~USB_USBCMD_RS_MASK;
+      USB1->ENDPTFLUSH = 0xFFFFFFFFU;
+      USBPHY1->CTRL_SET = USBPHY_CTRL_CLKGATE_MASK;
+    }
+#endif /* MIMXRT106X_USB_USE_USB1 */
+  }
+}
+
+/**
+ * @brief   USB low level reset routine.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+void usb_lld_reset(USBDriver *usbp) {
+  usbep_t ep;
+
+  USB1->DEVICEADDR = 0U;
+  for (ep = 1U; ep <= USB_MAX_ENDPOINTS; ep++) {
+    *usb_epctrl(ep) = 0U;
+  }
+
+  /* EP0 initialization.*/
+  usbp->epc[0] = &ep0config;
+  usb_lld_init_endpoint(usbp, 0U);
+}
+
+/**
+ * @brief   Sets the USB address.
+ * @note    The address is written with the advance bit set, the controller
+ *          switches to it after the IN status stage.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+void usb_lld_set_address(USBDriver *usbp) {
+
+  USB1->DEVICEADDR = USB_DEVICEADDR_USBADR(usbp->address) |
+                     USB_DEVICEADDR_USBADRA_MASK;
+}
+
+/**
+ * @brief   Enables an endpoint.
+ * @note    An unused direction of an enabled endpoint is configured as bulk,
+ *          the controller forbids leaving it as control.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_init_endpoint(USBDriver *usbp, usbep_t ep) {
+  const USBEndpointConfig *epcp = usbp->epc[ep];
+  uint32_t type = epcp->ep_mode & USB_EP_MODE_TYPE;
+  uint32_t config = DQH_CONFIG_ZLT_DISABLE;
+  uint32_t ctrl = 0U;
+
+  osalDbgAssert(ep < MIMXRT106X_USB_ENDPOINTS, "endpoint not available");
+
+  if (type == USB_EP_MODE_TYPE_CTRL) {
+    config |= DQH_CONFIG_IOS;
+  }
+  if (type == USB_EP_MODE_TYPE_ISOC) {
+    config |= DQH_CONFIG_MULT(1U);
+  }
+
+  memset(&qhs[DQH_OUT(ep)], 0, sizeof (usb_dqh_t));
+  memset(&qhs[DQH_IN(ep)], 0, sizeof (usb_dqh_t));
+  qhs[DQH_OUT(ep)].config = config | DQH_CONFIG_MAXPKT(epcp->out_maxsize);
+  qhs[DQH_OUT(ep)].next   = DTD_TERMINATE;
+  qhs[DQH_IN(ep)].config  = config | DQH_CONFIG_MAXPKT(epcp->in_maxsize);
+  qhs[DQH_IN(ep)].next    = DTD_TERMINATE;
+
+  if (epcp->in_state != NULL) {
+    epcp->in_state->tdcnt = 0U;
+  }
+  if (epcp->out_state != NULL) {
+    epcp->out_state->tdcnt = 0U;
+  }
+
+  /* EP0 is always enabled.*/
+  if (ep == 0U) {
+    return;
+  }
+
+  /* The ep_mode type encoding matches the TXT/RXT fields.*/
+  if (epcp->in_state != NULL) {
+    ctrl |= USB_ENDPTCTRL_TXE_MASK | USB_ENDPTCTRL_TXR_MASK |
+            USB_ENDPTCTRL_TXT(type);
+  }
+  else {
+    ctrl |= USB_ENDPTCTRL_TXT(USB_EP_MODE_TYPE_BULK);
+  }
+  if (epcp->out_state != NULL) {
+    ctrl |= USB_ENDPTCTRL_RXE_MASK | USB_ENDPTCTRL_RXR_MASK |
+            USB_ENDPTCTRL_RXT(type);
+  }
+  else {
+    ctrl |= USB_ENDPTCTRL_RXT(USB_EP_MODE_TYPE_BULK);
+  }
+  *usb_epctrl(ep) = ctrl;
+}
+
+/**
+ * @brief   Disables all the active endpoints except the endpoint zero.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+void usb_lld_disable_endpoints(USBDriver *usbp) {
+  usbep_t ep;
+
+  (void)usbp;
+
+  usb_flush(0xFFFEFFFEU);
+  for (ep = 1U; ep <= USB_MAX_ENDPOINTS; ep++) {
+    *usb_epctrl(ep) = USB_ENDPTCTRL_TXT(USB_EP_MODE_TYPE_BULK) |
+                      USB_ENDPTCTRL_RXT(USB_EP_MODE_TYPE_BULK);
+  }
+}
+
+/**
+ * @brief   Returns the status of an OUT endpoint.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ * @return              The endpoint status.
+ * @retval EP_STATUS_DISABLED The endpoint is not active.
+ * @retval EP_STATUS_STALLED  The endpoint is stalled.
+ * @retval EP_STATUS_ACTIVE   The endpoint is active.
+ *
+ * @notapi
+ */
+usbepstatus_t usb_lld_get_status_out(USBDriver *usbp, usbep_t ep) {
+  uint32_t ctrl;
+
+  (void)usbp;
+
+  if (ep > USB_MAX_ENDPOINTS) {
+    return EP_STATUS_DISABLED;
+  }
+  ctrl = *usb_epctrl(ep);
+  if ((ep != 0U) && ((ctrl & USB_ENDPTCTRL_RXE_MASK) == 0U)) {
+    return EP_STATUS_DISABLED;
+  }
+  if ((ctrl & USB_ENDPTCTRL_RXS_MASK) != 0U) {
+    return EP_STATUS_STALLED;
+  }
+  return EP_STATUS_ACTIVE;
+}
+
+/**
+ * @brief   Returns the status of an IN endpoint.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ * @return              The endpoint status.
+ * @retval EP_STATUS_DISABLED The endpoint is not active.
+ * @retval EP_STATUS_STALLED  The endpoint is stalled.
+ * @retval EP_STATUS_ACTIVE   The endpoint is active.
+ *
+ * @notapi
+ */
+usbepstatus_t usb_lld_get_status_in(USBDriver *usbp, usbep_t ep) {
+  uint32_t ctrl;
+
+  (void)usbp;
+
+  if (ep > USB_MAX_ENDPOINTS) {
+    return EP_STATUS_DISABLED;
+  }
+  ctrl = *usb_epctrl(ep);
+  if ((ep != 0U) && ((ctrl & USB_ENDPTCTRL_TXE_MASK) == 0U)) {
+    return EP_STATUS_DISABLED;
+  }
+  if ((ctrl & USB_ENDPTCTRL_TXS_MASK) != 0U) {
+    return EP_STATUS_STALLED;
+  }
+  return EP_STATUS_ACTIVE;
+}
+
+/**
+ * @brief   Reads a setup packet from the dedicated packet buffer.
+ * @details This function copies the last received setup packet, the
+ *          interrupt handler already pulled it out of the queue head.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ * @param[out] buf      buffer where to copy the packet data
+ *
+ * @notapi
+ */
+void usb_lld_read_setup(USBDriver *usbp, usbep_t ep, uint8_t *buf) {
+
+  memcpy(buf, usbp->epc[ep]->setup_buf, 8U);
+}
+
+/**
+ * @brief   Starts a receive operation on an OUT endpoint.
+ * @note    Buffers outside the DTCM must be cache line aligned and sized,
+ *          they are invalidated around the transfer.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_start_out(USBDriver *usbp, usbep_t ep) {
+  USBOutEndpointState *osp = usbp->epc[ep]->out_state;
+
+  cacheBufferInvalidate(osp->rxbuf, osp->rxsize);
+  osp->tdcnt = usb_prime(DQH_OUT(ep), osp->rxbuf, osp->rxsize, 0U, true,
+                         EP_OUT_MASK(ep));
+}
+
+/**
+ * @brief   Starts a transmit operation on an IN endpoint.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_start_in(USBDriver *usbp, usbep_t ep) {
+  const USBEndpointConfig *epcp = usbp->epc[ep];
+  USBInEndpointState *isp = epcp->in_state;
+  uint32_t token = 0U;
+
+  if ((epcp->ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_ISOC) {
+    token = DTD_TOKEN_MULTO(1U);
+  }
+  cacheBufferFlush(isp->txbuf, isp->txsize);
+  isp->txcnt = 0U;
+  isp->tdcnt = usb_prime(DQH_IN(ep), isp->txbuf, isp->txsize, token, false,
+                         EP_IN_MASK(ep));
+}
+
+/**
+ * @brief   Brings an OUT endpoint in the stalled state.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_stall_out(USBDriver *usbp, usbep_t ep) {
+
+  (void)usbp;
+
+  *usb_epctrl(ep) |= USB_ENDPTCTRL_RXS_MASK;
+}
+
+/**
+ * @brief   Brings an IN endpoint in the stalled state.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_stall_in(USBDriver *usbp, usbep_t ep) {
+
+  (void)usbp;
+
+  *usb_epctrl(ep) |= USB_ENDPTCTRL_TXS_MASK;
+}
+
+/**
+ * @brief   Brings an OUT endpoint in the active state.
+ * @note    The data toggle is reset as required by CLEAR_FEATURE.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_clear_out(USBDriver *usbp, usbep_t ep) {
+  volatile uint32_t *ctrlp = usb_epctrl(ep);
+
+  (void)usbp;
+
+  *ctrlp = (*ctrlp & ~USB_ENDPTCTRL_RXS_MASK) |
+           (ep != 0U ? USB_ENDPTCTRL_RXR_MASK : 0U);
+}
+
+/**
+ * @brief   Brings an IN endpoint in the active state.
+ * @note    The data toggle is reset as required by CLEAR_FEATURE.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ *
+ * @notapi
+ */
+void usb_lld_clear_in(USBDriver *usbp, usbep_t ep) {
+  volatile uint32_t *ctrlp = usb_epctrl(ep);
+
+  (void)usbp;
+
+  *ctrlp = (*ctrlp & ~USB_ENDPTCTRL_TXS_MASK) |
+           (ep != 0U ? USB_ENDPTCTRL_TXR_MASK : 0U);
+}
+
+#endif /* HAL_USE_USB */
+
+/** @} */
@@ -24,7 +24,13 @@ endif
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/GPIOv1/driver.mk
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/UARTv1/driver.mk
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/PITv1/driver.mk
+# The native USB driver is selected with USE_MIMXRT_USBHSV2 = yes.
+ifeq ($(USE_MIMXRT_USBHSV2),yes)
+MIMXRT_DEVICE = MIMXRT1062
+include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/USBHSv2/driver.mk
+else
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/USBHSv1/driver.mk
+endif
 
 # Shared variables
 ALLCSRC += $(PLATFORMSRC_CONTRIB)
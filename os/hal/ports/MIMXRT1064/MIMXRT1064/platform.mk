@@ -25,7 +25,13 @@ include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1064/LLD/GPIOv1/driver.mk
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1064/LLD/UARTv1/driver.mk
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1064/LLD/I2Cv1/driver.mk
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1064/LLD/PITv1/driver.mk
+# The native USB driver is selected with USE_MIMXRT_USBHSV2 = yes.
+ifeq ($(USE_MIMXRT_USBHSV2),yes)
+MIMXRT_DEVICE = MIMXRT1064
+include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1062/LLD/USBHSv2/driver.mk
+else
 include ${CHIBIOS_CONTRIB}/os/hal/ports/MIMXRT1064/LLD/USBHSv1/driver.mk
+endif
 
 # Shared variables
 ALLCSRC += $(PLATFORMSRC_CONTRIB)
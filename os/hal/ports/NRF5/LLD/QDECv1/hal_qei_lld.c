@@ -92,6 +92,13 @@ static void serve_interrupt(QEIDriver *qeip) {
 
     /* Adjust counter */
     qeiAdjustI(qeip, acc);
+
+#if QEI_USE_VELOCITY == TRUE
+    /* Report ends on the latest edge */
+    osalSysLockFromISR();
+    _qei_isr_velocity_edge(qeip, qeip->count, QEI_VELOCITY_TIMESTAMP());
+    osalSysUnlockFromISR();
+#endif
   }
 }
 
@@ -303,6 +303,12 @@ struct QEIDriver {
    * @brief Current configuration data.
    */
   const QEIConfig           *config;
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief Velocity estimator.
+   */
+  qeiestimator_t            vel;
+#endif
 #if defined(QEI_DRIVER_EXT_FIELDS)
   QEI_DRIVER_EXT_FIELDS
 #endif
@@ -354,6 +360,19 @@ struct QEIDriver {
         (qeip)->config->notify_cb(qeip);	\
     } while(0)
 
+/**
+ * @brief   Arms the capture of the next encoder edge.
+ * @details Nothing to do, every non-null report is an edge event and the
+ *          report interrupt is always enabled.
+ * @note    Edges are timestamped when their report is served, the time
+ *          resolution is the report period.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ *
+ * @notapi
+ */
+#define qei_lld_arm_velocity(qeip) (void)(qeip)
+
 
 /*===========================================================================*/
 /* External declarations.                                                    */
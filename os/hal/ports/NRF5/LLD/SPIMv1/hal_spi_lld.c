@@ -0,0 +1,723 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    SPIMv1/hal_spi_lld.c
+ * @brief   NRF52 SPIM (EasyDMA) low level SPI driver code.
+ * @details Transfers are handed to EasyDMA in chunks of at most
+ *          @p NRF5_SPIM_MAXCNT bytes, the END event of each chunk is the
+ *          only interrupt taken. Notes:
+ *          - EasyDMA only reaches RAM, transmit data located in flash is
+ *            copied through a small bounce buffer, chunk by chunk.
+ *          - nRF52832 anomaly 58: the SPIM clocks an extra byte when
+ *            RXD.MAXCNT is 1 and TXD.MAXCNT is 1 or less. Chunks never
+ *            leave a single byte tail and single byte receives run on the
+ *            legacy SPI core of the same instance.
+ *          .
+ *
+ * @addtogroup SPI
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if HAL_USE_SPI || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define SPI0_IRQ_NUM    SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn
+#define SPI1_IRQ_NUM    SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn
+#define SPI2_IRQ_NUM    SPIM2_SPIS2_SPI2_IRQn
+
+#define SPIM_INT_MASK   (SPIM_INTENCLR_STOPPED_Msk | SPIM_INTENCLR_ENDRX_Msk | \
+                         SPIM_INTENCLR_END_Msk | SPIM_INTENCLR_ENDTX_Msk |    \
+                         SPIM_INTENCLR_STARTED_Msk)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+#if NRF5_SPI_USE_SPI0 || defined(__DOXYGEN__)
+/** @brief SPI1 driver identifier.*/
+SPIDriver SPID1;
+#endif
+
+#if NRF5_SPI_USE_SPI1 || defined(__DOXYGEN__)
+/** @brief SPI2 driver identifier.*/
+SPIDriver SPID2;
+#endif
+
+#if NRF5_SPI_USE_SPI2 || defined(__DOXYGEN__)
+/** @brief SPI3 driver identifier.*/
+SPIDriver SPID3;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Clears an event register.
+ *
+ * @param[in] evp       pointer to the event register
+ */
+static inline void spim_clear_event(volatile uint32_t *evp) {
+
+  *evp = 0;
+#if CORTEX_MODEL >= 4
+  (void)*evp;
+#endif
+}
+
+/**
+ * @brief   Programs and starts the next EasyDMA chunk.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void spim_start_chunk(SPIDriver *spip) {
+  NRF_SPIM_Type *port = spip->port;
+  const uint8_t *txp = spip->txptr;
+  size_t max = NRF5_SPIM_MAXCNT;
+  size_t n = spip->cnt;
+
+  /* Flash sourced and ignored data go through the bounce buffer.*/
+  if ((txp == NULL) ? (spip->rxptr == NULL) : !NRF5_SPIM_IS_RAM(txp)) {
+    max = NRF5_SPI_BOUNCE_BUFFER_SIZE;
+  }
+  if (n > max) {
+    n = max;
+    /* Never leave a single byte tail behind, see anomaly 58.*/
+    if (spip->cnt - n == 1U) {
+      n--;
+    }
+  }
+
+  if (txp == NULL) {
+    if (spip->rxptr == NULL) {
+      /* Ignore, idle bytes are sent from the bounce buffer so that no
+         receive buffer is needed at all.*/
+      port->TXD.PTR = (uint32_t)spip->bounce;
+      port->TXD.MAXCNT = n;
+    }
+    else {
+      /* Receive only, the ORC byte is clocked out.*/
+      port->TXD.MAXCNT = 0;
+    }
+  }
+  else if (NRF5_SPIM_IS_RAM(txp)) {
+    port->TXD.PTR = (uint32_t)txp;
+    port->TXD.MAXCNT = n;
+  }
+  else {
+    memcpy(spip->bounce, txp, n);
+    port->TXD.PTR = (uint32_t)spip->bounce;
+    port->TXD.MAXCNT = n;
+  }
+
+  if (spip->rxptr != NULL) {
+    port->RXD.PTR = (uint32_t)spip->rxptr;
+    port->RXD.MAXCNT = n;
+  }
+  else {
+    port->RXD.MAXCNT = 0;
+  }
+
+  spip->chunk = n;
+  port->TASKS_START = 1;
+}
+
+/**
+ * @brief   Starts a single byte exchange on the legacy SPI core.
+ * @details Works around anomaly 58, the SPI and SPIM cores share the
+ *          pin, frequency and configuration registers of the instance.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void spim_start_single(SPIDriver *spip) {
+  NRF_SPI_Type *spi = (NRF_SPI_Type *)spip->port;
+
+  spip->single = true;
+  spi->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+  spi->ENABLE = (SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos);
+  spim_clear_event(&spi->EVENTS_READY);
+  spi->INTENSET = SPI_INTENSET_READY_Msk;
+  spi->TXD = (spip->txptr != NULL) ? *spip->txptr : 0xFFU;
+}
+
+/**
+ * @brief   Starts a transfer.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of bytes
+ * @param[in] txbuf     the pointer to the transmit buffer or @p NULL
+ * @param[out] rxbuf    the pointer to the receive buffer or @p NULL
+ */
+static void spim_start(SPIDriver *spip, size_t n,
+                       const void *txbuf, void *rxbuf) {
+
+  spip->txptr = txbuf;
+  spip->rxptr = rxbuf;
+  spip->cnt   = n;
+  spip->items = 0U;
+
+  if ((n == 1U) && (rxbuf != NULL)) {
+    spim_start_single(spip);
+    return;
+  }
+
+  spim_clear_event(&spip->port->EVENTS_END);
+  spip->port->INTENSET = SPIM_INTENSET_END_Msk;
+  spim_start_chunk(spip);
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+/**
+ * @brief   Common IRQ handler.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void serve_interrupt(SPIDriver *spip) {
+  NRF_SPIM_Type *port = spip->port;
+
+  if (spip->single) {
+    NRF_SPI_Type *spi = (NRF_SPI_Type *)port;
+
+    spim_clear_event(&spi->EVENTS_READY);
+    *spip->rxptr = (uint8_t)spi->RXD;
+    spi->INTENCLR = SPI_INTENCLR_READY_Msk;
+    spi->ENABLE  = (SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos);
+    port->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+    spip->single = false;
+
+    /* Portable SPI ISR code defined in the high level driver, note, it is
+       a macro.*/
+    _spi_isr_code(spip);
+    return;
+  }
+
+  /* Array list progress, the END->START short restarts the transfer on
+     its own, the short is removed while the last item is running.*/
+  if ((port->EVENTS_STARTED != 0U) &&
+      ((port->INTENSET & SPIM_INTENSET_STARTED_Msk) != 0U)) {
+    spim_clear_event(&port->EVENTS_STARTED);
+    if (--spip->items == 0U) {
+      port->SHORTS = 0;
+      spim_clear_event(&port->EVENTS_END);
+      port->INTENCLR = SPIM_INTENCLR_STARTED_Msk;
+      port->INTENSET = SPIM_INTENSET_END_Msk;
+    }
+  }
+
+  if ((port->EVENTS_END != 0U) &&
+      ((port->INTENSET & SPIM_INTENSET_END_Msk) != 0U)) {
+    spim_clear_event(&port->EVENTS_END);
+
+#if NRF5_SPI_USE_PPI_CS
+    /* Array list item done, PPI released the slave select, it is asserted
+       again before the next item is started.*/
+    if (spip->items > 1U) {
+      spip->items--;
+      NRF_GPIOTE->TASKS_CLR[spip->config->gpiote_channel] = 1;
+      port->TASKS_START = 1;
+      return;
+    }
+#endif
+
+    if (spip->txptr != NULL) {
+      spip->txptr += spip->chunk;
+    }
+    if (spip->rxptr != NULL) {
+      spip->rxptr += spip->chunk;
+    }
+    spip->cnt -= spip->chunk;
+    if (spip->cnt > 0U) {
+      spim_start_chunk(spip);
+      return;
+    }
+
+    /* Stops the IRQ sources.*/
+    port->INTENCLR = SPIM_INTENCLR_END_Msk;
+    port->TXD.LIST = (SPIM_TXD_LIST_LIST_Disabled << SPIM_TXD_LIST_LIST_Pos);
+    port->RXD.LIST = (SPIM_RXD_LIST_LIST_Disabled << SPIM_RXD_LIST_LIST_Pos);
+#if NRF5_SPI_USE_PPI_CS
+    NRF_PPI->CHENCLR = 1UL << spip->config->ppi_channel;
+#endif
+
+    /* Portable SPI ISR code defined in the high level driver, note, it is
+       a macro.*/
+    _spi_isr_code(spip);
+  }
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+#if NRF5_SPI_USE_SPI0 || defined(__DOXYGEN__)
+/**
+ * @brief   SPIM0 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(Vector4C) {
+
+  OSAL_IRQ_PROLOGUE();
+  serve_interrupt(&SPID1);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if NRF5_SPI_USE_SPI1 || defined(__DOXYGEN__)
+/**
+ * @brief   SPIM1 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(Vector50) {
+
+  OSAL_IRQ_PROLOGUE();
+  serve_interrupt(&SPID2);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+#if NRF5_SPI_USE_SPI2 || defined(__DOXYGEN__)
+/**
+ * @brief   SPIM2 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(VectorCC) {
+
+  OSAL_IRQ_PROLOGUE();
+  serve_interrupt(&SPID3);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level SPI driver initialization.
+ *
+ * @notapi
+ */
+void spi_lld_init(void) {
+
+#if NRF5_SPI_USE_SPI0
+  spiObjectInit(&SPID1);
+  SPID1.port   = NRF_SPIM0;
+  SPID1.single = false;
+#endif
+#if NRF5_SPI_USE_SPI1
+  spiObjectInit(&SPID2);
+  SPID2.port   = NRF_SPIM1;
+  SPID2.single = false;
+#endif
+#if NRF5_SPI_USE_SPI2
+  spiObjectInit(&SPID3);
+  SPID3.port   = NRF_SPIM2;
+  SPID3.single = false;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the SPI peripheral.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_start(SPIDriver *spip) {
+  NRF_SPIM_Type *port = spip->port;
+  uint32_t config;
+
+  if (spip->state == SPI_STOP) {
+#if NRF5_SPI_USE_SPI0
+    if (&SPID1 == spip)
+      nvicEnableVector(SPI0_IRQ_NUM, NRF5_SPI_SPI0_IRQ_PRIORITY);
+#endif
+#if NRF5_SPI_USE_SPI1
+    if (&SPID2 == spip)
+      nvicEnableVector(SPI1_IRQ_NUM, NRF5_SPI_SPI1_IRQ_PRIORITY);
+#endif
+#if NRF5_SPI_USE_SPI2
+    if (&SPID3 == spip)
+      nvicEnableVector(SPI2_IRQ_NUM, NRF5_SPI_SPI2_IRQ_PRIORITY);
+#endif
+  }
+
+  config = spip->config->lsbfirst ?
+    (SPIM_CONFIG_ORDER_LsbFirst << SPIM_CONFIG_ORDER_Pos) :
+    (SPIM_CONFIG_ORDER_MsbFirst << SPIM_CONFIG_ORDER_Pos);
+
+  switch (spip->config->mode) {
+    case 1:
+      config |= (SPIM_CONFIG_CPOL_ActiveLow << SPIM_CONFIG_CPOL_Pos);
+      config |= (SPIM_CONFIG_CPHA_Trailing << SPIM_CONFIG_CPHA_Pos);
+      break;
+    case 2:
+      config |= (SPIM_CONFIG_CPOL_ActiveHigh << SPIM_CONFIG_CPOL_Pos);
+      config |= (SPIM_CONFIG_CPHA_Leading << SPIM_CONFIG_CPHA_Pos);
+      break;
+    case 3:
+      config |= (SPIM_CONFIG_CPOL_ActiveHigh << SPIM_CONFIG_CPOL_Pos);
+      config |= (SPIM_CONFIG_CPHA_Trailing << SPIM_CONFIG_CPHA_Pos);
+      break;
+    default:
+      config |= (SPIM_CONFIG_CPOL_ActiveLow << SPIM_CONFIG_CPOL_Pos);
+      config |= (SPIM_CONFIG_CPHA_Leading << SPIM_CONFIG_CPHA_Pos);
+      break;
+  }
+
+  /* Configuration.*/
+  port->ENABLE    = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+  port->INTENCLR  = SPIM_INT_MASK;
+  port->SHORTS    = 0;
+  port->CONFIG    = config;
+  port->PSEL.SCK  = spip->config->sckpad;
+  port->PSEL.MOSI = spip->config->mosipad;
+  port->PSEL.MISO = spip->config->misopad;
+  port->FREQUENCY = spip->config->freq;
+  port->ORC       = 0xFFU;
+  port->TXD.LIST  = (SPIM_TXD_LIST_LIST_Disabled << SPIM_TXD_LIST_LIST_Pos);
+  port->RXD.LIST  = (SPIM_RXD_LIST_LIST_Disabled << SPIM_RXD_LIST_LIST_Pos);
+
+#if NRF5_SPI_USE_PPI_CS
+  {
+    uint8_t ch = spip->config->gpiote_channel;
+
+    /* The slave select pad is handed to the GPIOTE channel, idle high.*/
+    NRF_GPIOTE->CONFIG[ch] =
+      (GPIOTE_CONFIG_MODE_Task << GPIOTE_CONFIG_MODE_Pos) |
+      ((spip->config->sspad << GPIOTE_CONFIG_PSEL_Pos) & GPIOTE_CONFIG_PSEL_Msk) |
+      (GPIOTE_CONFIG_POLARITY_Toggle << GPIOTE_CONFIG_POLARITY_Pos) |
+      (GPIOTE_CONFIG_OUTINIT_High << GPIOTE_CONFIG_OUTINIT_Pos);
+
+    NRF_PPI->CHENCLR = 1UL << spip->config->ppi_channel;
+    NRF_PPI->CH[spip->config->ppi_channel].EEP =
+      (uint32_t)&port->EVENTS_END;
+    NRF_PPI->CH[spip->config->ppi_channel].TEP =
+      (uint32_t)&NRF_GPIOTE->TASKS_SET[ch];
+  }
+#endif
+
+  /* clear events flag */
+  spim_clear_event(&port->EVENTS_END);
+  spim_clear_event(&port->EVENTS_STARTED);
+  spim_clear_event(&port->EVENTS_STOPPED);
+
+  port->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+}
+
+/**
+ * @brief   Deactivates the SPI peripheral.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_stop(SPIDriver *spip) {
+
+  if (spip->state != SPI_STOP) {
+    spip->port->INTENCLR = SPIM_INT_MASK;
+    spip->port->SHORTS   = 0;
+    spip->port->ENABLE   = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+    spip->single = false;
+#if NRF5_SPI_USE_PPI_CS
+    NRF_PPI->CHENCLR = 1UL << spip->config->ppi_channel;
+    NRF_GPIOTE->CONFIG[spip->config->gpiote_channel] = 0;
+#endif
+#if NRF5_SPI_USE_SPI0
+    if (&SPID1 == spip)
+      nvicDisableVector(SPI0_IRQ_NUM);
+#endif
+#if NRF5_SPI_USE_SPI1
+    if (&SPID2 == spip)
+      nvicDisableVector(SPI1_IRQ_NUM);
+#endif
+#if NRF5_SPI_USE_SPI2
+    if (&SPID3 == spip)
+      nvicDisableVector(SPI2_IRQ_NUM);
+#endif
+  }
+}
+
+#if (SPI_SELECT_MODE == SPI_SELECT_MODE_LLD) || defined(__DOXYGEN__)
+/**
+ * @brief   Asserts the slave select signal and prepares for transfers.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_select(SPIDriver *spip) {
+
+#if NRF5_SPI_USE_PPI_CS
+  NRF_GPIOTE->TASKS_CLR[spip->config->gpiote_channel] = 1;
+#else
+  palClearPad(IOPORT1, spip->config->sspad);
+#endif
+}
+
+/**
+ * @brief   Deasserts the slave select signal.
+ * @details The previously selected peripheral is unselected.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_unselect(SPIDriver *spip) {
+
+#if NRF5_SPI_USE_PPI_CS
+  NRF_GPIOTE->TASKS_SET[spip->config->gpiote_channel] = 1;
+#else
+  palSetPad(IOPORT1, spip->config->sspad);
+#endif
+}
+#endif /* SPI_SELECT_MODE == SPI_SELECT_MODE_LLD */
+
+/**
+ * @brief   Ignores data on the SPI bus.
+ * @details This function transmits a series of idle words on the SPI bus and
+ *          ignores the received data. This function can be invoked even
+ *          when a slave select signal has not been yet asserted.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to be ignored
+ *
+ * @notapi
+ */
+void spi_lld_ignore(SPIDriver *spip, size_t n) {
+
+  memset(spip->bounce, 0xFF, sizeof (spip->bounce));
+  spim_start(spip, n, NULL, NULL);
+}
+
+/**
+ * @brief   Exchanges data on the SPI bus.
+ * @details This asynchronous function starts a simultaneous transmit/receive
+ *          operation.
+ * @post    At the end of the operation the configured callback is invoked.
+ * @note    The receive buffer must be located in RAM.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to be exchanged
+ * @param[in] txbuf     the pointer to the transmit buffer
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @notapi
+ */
+void spi_lld_exchange(SPIDriver *spip, size_t n,
+                      const void *txbuf, void *rxbuf) {
+
+  osalDbgCheck(NRF5_SPIM_IS_RAM(rxbuf));
+
+  spim_start(spip, n, txbuf, rxbuf);
+}
+
+/**
+ * @brief   Sends data over the SPI bus.
+ * @details This asynchronous function starts a transmit operation.
+ * @post    At the end of the operation the configured callback is invoked.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to send
+ * @param[in] txbuf     the pointer to the transmit buffer
+ *
+ * @notapi
+ */
+void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf) {
+
+  spim_start(spip, n, txbuf, NULL);
+}
+
+/**
+ * @brief   Receives data from the SPI bus.
+ * @details This asynchronous function starts a receive operation.
+ * @post    At the end of the operation the configured callback is invoked.
+ * @note    The receive buffer must be located in RAM.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to receive
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @notapi
+ */
+void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
+
+  osalDbgCheck(NRF5_SPIM_IS_RAM(rxbuf));
+
+  spim_start(spip, n, NULL, rxbuf);
+}
+
+/**
+ * @brief   Exchanges one frame using a polled wait.
+ * @details This synchronous function exchanges one frame using a polled
+ *          synchronization method. This function is useful when exchanging
+ *          small amount of data on high speed channels, usually in this
+ *          situation is much more efficient just wait for completion using
+ *          polling than suspending the thread waiting for an interrupt.
+ * @note    The frame is exchanged on the legacy SPI core, see anomaly 58.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] frame     the data frame to send over the SPI bus
+ * @return              The received data frame from the SPI bus.
+ */
+uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame) {
+  NRF_SPI_Type *spi = (NRF_SPI_Type *)spip->port;
+  uint16_t rx;
+
+  spi->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+  spi->ENABLE = (SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos);
+  spim_clear_event(&spi->EVENTS_READY);
+  spi->TXD = (uint8_t)frame;
+  while (spi->EVENTS_READY == 0)
+    ;
+  spim_clear_event(&spi->EVENTS_READY);
+  rx = (uint16_t)spi->RXD;
+  spi->ENABLE = (SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos);
+  spi->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+
+  return rx;
+}
+
+/**
+ * @brief   Starts an array list transfer.
+ * @details Exchanges @p items consecutive fixed size transactions, EasyDMA
+ *          advances the buffer pointers by @p size after each item and the
+ *          END->START short chains the items without CPU intervention,
+ *          the whole list is one frame.
+ *          With @p NRF5_SPI_USE_PPI_CS the slave select is pulsed around
+ *          every item instead, it is asserted before each item is started
+ *          and released by PPI on END, the caller must not select.
+ * @post    At the end of the operation the configured callback is invoked.
+ * @note    Buffers must be located in RAM and hold @p items * @p size
+ *          bytes, either buffer can be @p NULL but not both.
+ * @note    One interrupt is taken per item. Without
+ *          @p NRF5_SPI_USE_PPI_CS it removes the short before the last item
+ *          ends, an item must last longer than the interrupt latency.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] items     number of items
+ * @param[in] size      size of an item, 2...@p NRF5_SPIM_MAXCNT bytes
+ * @param[in] txbuf     the pointer to the transmit items or @p NULL
+ * @param[out] rxbuf    the pointer to the receive items or @p NULL
+ *
+ * @iclass
+ */
+void spiNrf5StartArrayListI(SPIDriver *spip, size_t items, size_t size,
+                            const void *txbuf, void *rxbuf) {
+  NRF_SPIM_Type *port;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((spip != NULL) && (items > 0U) &&
+               (size >= 2U) && (size <= NRF5_SPIM_MAXCNT));
+  osalDbgCheck((txbuf != NULL) || (rxbuf != NULL));
+  osalDbgCheck((txbuf == NULL) || NRF5_SPIM_IS_RAM(txbuf));
+  osalDbgCheck((rxbuf == NULL) || NRF5_SPIM_IS_RAM(rxbuf));
+  osalDbgAssert(spip->state == SPI_READY, "not ready");
+
+  port = spip->port;
+  spip->state = SPI_ACTIVE;
+  spip->txptr = NULL;
+  spip->rxptr = NULL;
+  spip->cnt   = 0U;
+  spip->chunk = 0U;
+
+  if (txbuf != NULL) {
+    port->TXD.PTR    = (uint32_t)txbuf;
+    port->TXD.MAXCNT = size;
+    port->TXD.LIST   = (SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos);
+  }
+  else {
+    port->TXD.MAXCNT = 0;
+  }
+  if (rxbuf != NULL) {
+    port->RXD.PTR    = (uint32_t)rxbuf;
+    port->RXD.MAXCNT = size;
+    port->RXD.LIST   = (SPIM_RXD_LIST_LIST_ArrayList << SPIM_RXD_LIST_LIST_Pos);
+  }
+  else {
+    port->RXD.MAXCNT = 0;
+  }
+
+  spim_clear_event(&port->EVENTS_STARTED);
+  spim_clear_event(&port->EVENTS_END);
+#if NRF5_SPI_USE_PPI_CS
+  /* The slave select is asserted before each item is started, the
+     following items are started by the ISR.*/
+  spip->items = items;
+  NRF_PPI->CHENSET = 1UL << spip->config->ppi_channel;
+  port->INTENSET = SPIM_INTENSET_END_Msk;
+  NRF_GPIOTE->TASKS_CLR[spip->config->gpiote_channel] = 1;
+#else
+  if (items > 1U) {
+    spip->items  = items;
+    port->SHORTS = SPIM_SHORTS_END_START_Msk;
+    port->INTENSET = SPIM_INTENSET_STARTED_Msk;
+  }
+  else {
+    spip->items  = 0U;
+    port->INTENSET = SPIM_INTENSET_END_Msk;
+  }
+#endif
+  port->TASKS_START = 1;
+}
+
+#if SPI_USE_WAIT || defined(__DOXYGEN__)
+/**
+ * @brief   Performs an array list transfer.
+ * @details Synchronous wrapper of @p spiNrf5StartArrayListI().
+ * @pre     In order to use this function the driver must have been
+ *          configured without callbacks (@p end_cb = @p NULL).
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] items     number of items
+ * @param[in] size      size of an item, 2...@p NRF5_SPIM_MAXCNT bytes
+ * @param[in] txbuf     the pointer to the transmit items or @p NULL
+ * @param[out] rxbuf    the pointer to the receive items or @p NULL
+ *
+ * @api
+ */
+void spiNrf5ArrayList(SPIDriver *spip, size_t items, size_t size,
+                      const void *txbuf, void *rxbuf) {
+
+  osalDbgCheck(spip != NULL);
+
+  osalSysLock();
+  spiNrf5StartArrayListI(spip, items, size, txbuf, rxbuf);
+  _spi_wait_s(spip);
+  osalSysUnlock();
+}
+#endif /* SPI_USE_WAIT */
+
+#endif /* HAL_USE_SPI */
+
+/** @} */
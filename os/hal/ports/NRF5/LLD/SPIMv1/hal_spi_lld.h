@@ -0,0 +1,296 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    SPIMv1/hal_spi_lld.h
+ * @brief   NRF52 SPIM (EasyDMA) low level SPI driver header.
+ *
+ * @addtogroup SPI
+ * @{
+ */
+
+#ifndef HAL_SPI_LLD_H
+#define HAL_SPI_LLD_H
+
+#if HAL_USE_SPI || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum EasyDMA transfer length in bytes.
+ * @details Longer transfers are split in chunks of at most this size.
+ */
+#define NRF5_SPIM_MAXCNT            255U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   SPI0 driver enable switch.
+ * @details If set to @p TRUE the support for SPIM0 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_SPI_USE_SPI0) || defined(__DOXYGEN__)
+#define NRF5_SPI_USE_SPI0           FALSE
+#endif
+
+/**
+ * @brief   SPI1 driver enable switch.
+ * @details If set to @p TRUE the support for SPIM1 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_SPI_USE_SPI1) || defined(__DOXYGEN__)
+#define NRF5_SPI_USE_SPI1           FALSE
+#endif
+
+/**
+ * @brief   SPI2 driver enable switch.
+ * @details If set to @p TRUE the support for SPIM2 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_SPI_USE_SPI2) || defined(__DOXYGEN__)
+#define NRF5_SPI_USE_SPI2           FALSE
+#endif
+
+/**
+ * @brief   SPI0 interrupt priority level setting.
+ */
+#if !defined(NRF5_SPI_SPI0_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define NRF5_SPI_SPI0_IRQ_PRIORITY  3
+#endif
+
+/**
+ * @brief   SPI1 interrupt priority level setting.
+ */
+#if !defined(NRF5_SPI_SPI1_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define NRF5_SPI_SPI1_IRQ_PRIORITY  3
+#endif
+
+/**
+ * @brief   SPI2 interrupt priority level setting.
+ */
+#if !defined(NRF5_SPI_SPI2_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define NRF5_SPI_SPI2_IRQ_PRIORITY  3
+#endif
+
+/**
+ * @brief   Chip select driven by GPIOTE tasks through PPI.
+ * @details If set to @p TRUE the slave select pad is owned by a GPIOTE
+ *          channel, the configuration must provide the GPIOTE channel and
+ *          one PPI channel. During array list transfers the pad is
+ *          asserted before every item is started and released by the END
+ *          event without CPU intervention.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_SPI_USE_PPI_CS) || defined(__DOXYGEN__)
+#define NRF5_SPI_USE_PPI_CS         FALSE
+#endif
+
+/**
+ * @brief   Size of the per-driver transmit bounce buffer.
+ * @details EasyDMA can only read RAM, transmit buffers located in flash
+ *          are copied here one chunk at a time.
+ */
+#if !defined(NRF5_SPI_BOUNCE_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define NRF5_SPI_BOUNCE_BUFFER_SIZE 32
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !NRF5_SPI_USE_SPI0 && !NRF5_SPI_USE_SPI1 && !NRF5_SPI_USE_SPI2
+#error "SPI driver activated but no SPI peripheral assigned"
+#endif
+
+#if NRF5_SPI_USE_SPI0 &&						    \
+    !OSAL_IRQ_IS_VALID_PRIORITY(NRF5_SPI_SPI0_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to SPI0"
+#endif
+
+#if NRF5_SPI_USE_SPI1 &&						    \
+    !OSAL_IRQ_IS_VALID_PRIORITY(NRF5_SPI_SPI1_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to SPI1"
+#endif
+
+#if NRF5_SPI_USE_SPI2 &&						    \
+    !OSAL_IRQ_IS_VALID_PRIORITY(NRF5_SPI_SPI2_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to SPI2"
+#endif
+
+#if NRF5_SPI_USE_SPI0 && defined(NRF5_I2C_USE_I2C0) && NRF5_I2C_USE_I2C0
+#error "SPIM0 and TWIM0 share the same peripheral instance"
+#endif
+
+#if NRF5_SPI_USE_SPI1 && defined(NRF5_I2C_USE_I2C1) && NRF5_I2C_USE_I2C1
+#error "SPIM1 and TWIM1 share the same peripheral instance"
+#endif
+
+#if NRF5_SPI_USE_PPI_CS && (SPI_SELECT_MODE != SPI_SELECT_MODE_LLD)
+#error "NRF5_SPI_USE_PPI_CS requires SPI_SELECT_MODE_LLD"
+#endif
+
+#if (NRF5_SPI_BOUNCE_BUFFER_SIZE < 2) ||                                    \
+    (NRF5_SPI_BOUNCE_BUFFER_SIZE > NRF5_SPIM_MAXCNT)
+#error "NRF5_SPI_BOUNCE_BUFFER_SIZE out of range"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   SPI frequency
+ */
+typedef enum {
+  NRF5_SPI_FREQ_125KBPS = (SPIM_FREQUENCY_FREQUENCY_K125 << SPIM_FREQUENCY_FREQUENCY_Pos),
+  NRF5_SPI_FREQ_250KBPS = (SPIM_FREQUENCY_FREQUENCY_K250 << SPIM_FREQUENCY_FREQUENCY_Pos),
+  NRF5_SPI_FREQ_500KBPS = (SPIM_FREQUENCY_FREQUENCY_K500 << SPIM_FREQUENCY_FREQUENCY_Pos),
+  NRF5_SPI_FREQ_1MBPS = (SPIM_FREQUENCY_FREQUENCY_M1 << SPIM_FREQUENCY_FREQUENCY_Pos),
+  NRF5_SPI_FREQ_2MBPS = (SPIM_FREQUENCY_FREQUENCY_M2 << SPIM_FREQUENCY_FREQUENCY_Pos),
+  NRF5_SPI_FREQ_4MBPS = (SPIM_FREQUENCY_FREQUENCY_M4 << SPIM_FREQUENCY_FREQUENCY_Pos),
+  NRF5_SPI_FREQ_8MBPS = (SPIM_FREQUENCY_FREQUENCY_M8 << SPIM_FREQUENCY_FREQUENCY_Pos),
+} spifreq_t;
+
+#if (SPI_SELECT_MODE == SPI_SELECT_MODE_LLD) || defined(__DOXYGEN__)
+/**
+ * @brief   Slave select fields of the SPI configuration structure.
+ */
+#define spi_lld_select_fields                                               \
+  /* @brief The slave select pad */                                         \
+  uint16_t              sspad;
+#else
+#define spi_lld_select_fields
+#endif
+
+#if NRF5_SPI_USE_PPI_CS || defined(__DOXYGEN__)
+/**
+ * @brief   PPI chip select fields of the SPI configuration structure.
+ */
+#define spi_lld_ppi_fields                                                  \
+  /* @brief GPIOTE channel driving the slave select pad */                  \
+  uint8_t               gpiote_channel;                                     \
+  /* @brief PPI channel, END->release */                                    \
+  uint8_t               ppi_channel;
+#else
+#define spi_lld_ppi_fields
+#endif
+
+/**
+ * @brief   Low level fields of the SPI configuration structure.
+ */
+#define spi_lld_config_fields                                               \
+  /* @brief The frequency of the SPI peripheral */                          \
+  spifreq_t             freq;                                               \
+  /* @brief The SCK pad */                                                  \
+  uint16_t              sckpad;                                             \
+  /* @brief The MOSI pad */                                                 \
+  uint16_t              mosipad;                                            \
+  /* @brief The MISO pad */                                                 \
+  uint16_t              misopad;                                            \
+  /* @brief Shift out least significant bit first */                        \
+  uint8_t               lsbfirst;                                           \
+  /* @brief SPI mode */                                                     \
+  uint8_t               mode;                                               \
+  spi_lld_select_fields                                                     \
+  spi_lld_ppi_fields
+
+/**
+ * @brief   Low level fields of the SPI driver structure.
+ */
+#define spi_lld_driver_fields                                               \
+  /* @brief Pointer to the SPIM port. */                                    \
+  NRF_SPIM_Type         *port;                                              \
+  /* @brief Bytes not yet handed to EasyDMA. */                             \
+  size_t                cnt;                                                \
+  /* @brief Length of the running chunk. */                                 \
+  size_t                chunk;                                              \
+  /* @brief Receive pointer or @p NULL. */                                  \
+  uint8_t               *rxptr;                                             \
+  /* @brief Transmit pointer or @p NULL. */                                 \
+  const uint8_t         *txptr;                                             \
+  /* @brief Array list items not yet started. */                            \
+  size_t                items;                                              \
+  /* @brief Single byte transfer running on the legacy SPI core. */         \
+  bool                  single;                                             \
+  /* @brief Transmit bounce buffer for flash resident data. */              \
+  uint8_t               bounce[NRF5_SPI_BOUNCE_BUFFER_SIZE];
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Tells whether a buffer is reachable by EasyDMA.
+ *
+ * @param[in] p         buffer address
+ */
+#define NRF5_SPIM_IS_RAM(p)                                                 \
+  (((uint32_t)(p) & 0xE0000000U) == 0x20000000U)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if NRF5_SPI_USE_SPI0 && !defined(__DOXYGEN__)
+extern SPIDriver SPID1;
+#endif
+#if NRF5_SPI_USE_SPI1 && !defined(__DOXYGEN__)
+extern SPIDriver SPID2;
+#endif
+#if NRF5_SPI_USE_SPI2 && !defined(__DOXYGEN__)
+extern SPIDriver SPID3;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void spi_lld_init(void);
+  void spi_lld_start(SPIDriver *spip);
+  void spi_lld_stop(SPIDriver *spip);
+#if SPI_SELECT_MODE == SPI_SELECT_MODE_LLD
+  void spi_lld_select(SPIDriver *spip);
+  void spi_lld_unselect(SPIDriver *spip);
+#endif
+  void spi_lld_ignore(SPIDriver *spip, size_t n);
+  void spi_lld_exchange(SPIDriver *spip, size_t n,
+                        const void *txbuf, void *rxbuf);
+  void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf);
+  void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf);
+  uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame);
+  void spiNrf5StartArrayListI(SPIDriver *spip, size_t items, size_t size,
+                              const void *txbuf, void *rxbuf);
+#if SPI_USE_WAIT
+  void spiNrf5ArrayList(SPIDriver *spip, size_t items, size_t size,
+                        const void *txbuf, void *rxbuf);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_SPI */
+
+#endif /* HAL_SPI_LLD_H */
+
+/** @} */
@@ -32,6 +32,23 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if (NRF5_UART_USE_RX_CONTINUOUS == TRUE) || defined(__DOXYGEN__)
+/*
+ * Virtual timer OSAL wrappers, mapped on the kernel API where the OSAL does
+ * not provide them.
+ */
+#if !defined(osalVTObjectInit)
+#define osalVTObjectInit(vtp)             chVTObjectInit(vtp)
+#endif
+#if !defined(osalVTSetContinuousI)
+#define osalVTSetContinuousI(vtp, delay, vtfunc, par)                       \
+  chVTSetContinuousI(vtp, delay, vtfunc, par)
+#endif
+#if !defined(osalVTResetI)
+#define osalVTResetI(vtp)                 chVTResetI(vtp)
+#endif
+#endif /* NRF5_UART_USE_RX_CONTINUOUS == TRUE */
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -70,6 +87,169 @@ static uartflags_t translate_errors(uint32_t sr) {
   return sts;
 }
 
+#if (NRF5_UART_USE_RX_CONTINUOUS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of bytes received since reception start.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ */
+static uint32_t uart_rx_count(UARTDriver *uartp) {
+  NRF_TIMER_Type *t = uartp->config->rx_timer;
+
+  t->TASKS_CAPTURE[0] = 1;
+  return t->CC[0];
+}
+
+/**
+ * @brief   Delivers the DMA buffers content up to a byte count.
+ * @details The bytes are pushed into the input queue within short critical
+ *          zones, the callbacks are invoked outside of them.
+ * @note    Must be invoked from the UART IRQ handler only, the delivery
+ *          state is not shared with other contexts.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] upto      byte count since reception start
+ */
+static void uart_rx_deliver(UARTDriver *uartp, uint32_t upto) {
+  uartflags_t sts = 0;
+  msg_t msg;
+  uint8_t c;
+
+  while ((int32_t)(upto - uartp->rxdone) > 0) {
+    c = uartp->rxdbuf[uartp->rxrd][uartp->rxoff];
+    if (++uartp->rxoff >= NRF5_UART_RX_DMA_BUFFER_SIZE) {
+      uartp->rxoff = 0U;
+      uartp->rxrd ^= 1U;
+    }
+    uartp->rxdone++;
+
+    osalSysLockFromISR();
+    msg = iqPutI(&uartp->iqueue, c);
+    osalSysUnlockFromISR();
+    if (msg != MSG_OK) {
+      sts |= UART_OVERRUN_ERROR;
+    }
+    if (uartp->config->rxchar_cb != NULL) {
+      uartp->config->rxchar_cb(uartp, c);
+    }
+  }
+
+  if (sts != 0) {
+    _uart_rx_error_isr_code(uartp, sts);
+  }
+}
+
+/**
+ * @brief   Idle line check.
+ * @details Partially filled buffers are delivered once the byte counter
+ *          did not move for a whole period, by then the counted bytes have
+ *          been written to RAM. The delivery is left to the UART IRQ
+ *          handler, the only context invoking the receive callbacks.
+ *
+ * @param[in] vtp       pointer to the timer
+ * @param[in] p         pointer to the @p UARTDriver object
+ */
+static void uart_rx_idle_cb(virtual_timer_t *vtp, void *p) {
+  UARTDriver *uartp = (UARTDriver *)p;
+
+  (void)vtp;
+
+  osalSysLockFromISR();
+  if (uartp->rxcont) {
+    uint32_t cnt = uart_rx_count(uartp);
+
+    if (cnt == uartp->rxlast) {
+      uartp->rxidle = cnt;
+      uartp->rxpend = true;
+      NVIC_SetPendingIRQ(UARTE0_UART0_IRQn);
+    }
+    uartp->rxlast = cnt;
+  }
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Starts the continuous double buffered reception.
+ * @details The first buffer is started, the second one is queued on the
+ *          RXSTARTED event and the ENDRX->STARTRX short chains them.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ */
+static void uart_start_rx_continuous(UARTDriver *uartp) {
+  NRF_UARTE_Type *u = uartp->uart;
+  NRF_TIMER_Type *t = uartp->config->rx_timer;
+
+  t->TASKS_STOP = 1;
+  t->TASKS_CLEAR = 1;
+
+  uartp->rxnext = 1U;
+  uartp->rxrd   = 0U;
+  uartp->rxoff  = 0U;
+  uartp->rxdone = 0U;
+  uartp->rxfill = 0U;
+  uartp->rxlast = 0U;
+  uartp->rxpend = false;
+
+  u->SHORTS = UARTE_SHORTS_ENDRX_STARTRX_Msk;
+  u->RXD.PTR = (uint32_t)uartp->rxdbuf[0];
+  u->RXD.MAXCNT = NRF5_UART_RX_DMA_BUFFER_SIZE;
+
+  u->EVENTS_RXSTARTED = 0;
+  u->EVENTS_ENDRX = 0;
+#if CORTEX_MODEL >= 4
+  (void)u->EVENTS_RXSTARTED;
+  (void)u->EVENTS_ENDRX;
+#endif
+  u->INTENSET = UARTE_INTENSET_RXSTARTED_Msk | UARTE_INTENSET_ENDRX_Msk;
+
+  t->TASKS_START = 1;
+  NRF_PPI->CHENSET = 1UL << uartp->config->rx_ppi_channel;
+
+  uartp->rxcont = true;
+  u->TASKS_STARTRX = 1;
+
+  if (uartp->config->rx_idle_timeout > (sysinterval_t)0) {
+    osalVTSetContinuousI(&uartp->rxvt, uartp->config->rx_idle_timeout,
+                         uart_rx_idle_cb, uartp);
+  }
+}
+
+/**
+ * @brief   Stops the continuous reception.
+ * @details The receiver is stopped without waiting for it, bytes not
+ *          delivered yet are discarded.
+ * @note    Must be invoked from a locked zone.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ */
+static void uart_stop_rx_continuous(UARTDriver *uartp) {
+  NRF_UARTE_Type *u = uartp->uart;
+
+  if (!uartp->rxcont) {
+    return;
+  }
+
+  osalVTResetI(&uartp->rxvt);
+  uartp->rxcont = false;
+  uartp->rxpend = false;
+
+  u->SHORTS = 0;
+  u->INTENCLR = UARTE_INTENCLR_RXSTARTED_Msk;
+  u->TASKS_STOPRX = 1;
+
+  NRF_PPI->CHENCLR = 1UL << uartp->config->rx_ppi_channel;
+  uartp->config->rx_timer->TASKS_STOP = 1;
+
+  u->EVENTS_RXSTARTED = 0;
+  u->EVENTS_ENDRX = 0;
+#if CORTEX_MODEL >= 4
+  (void)u->EVENTS_RXSTARTED;
+  (void)u->EVENTS_ENDRX;
+#endif
+}
+
+#endif /* NRF5_UART_USE_RX_CONTINUOUS == TRUE */
+
 /**
  * @brief   Puts the receiver in the UART_RX_IDLE state.
  *
@@ -77,7 +257,14 @@ static uartflags_t translate_errors(uint32_t sr) {
  */
 static void uart_enter_rx_idle_loop(UARTDriver *uartp) {
   NRF_UARTE_Type *u = uartp->uart;
-  
+
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  if (uartp->config->rx_pad != NRF5_UART_PAD_DISCONNECTED) {
+    uart_start_rx_continuous(uartp);
+    return;
+  }
+#endif
+
   /* RX DMA channel preparation, if the char callback is defined then the
      interrupt is enabled too.*/
   if (uartp->config->rxchar_cb == NULL)
@@ -213,6 +400,10 @@ static void configure_uart(UARTDriver *uartp, const UARTConfig *config)
 static void uart_stop(UARTDriver *uartp) {
   NRF_UARTE_Type *u = uartp->uart;
 
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  uart_stop_rx_continuous(uartp);
+#endif
+
   /* Stops RX and TX.*/
   u->TASKS_STOPRX = 1;
   u->TASKS_STOPTX = 1;
@@ -283,6 +474,23 @@ static void serve_uart_irq(UARTDriver *uartp) {
   NRF_UARTE_Type *u = uartp->uart;
   uint32_t isr = u->INTENSET;
 
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  if (uartp->rxpend) {
+    uint32_t upto;
+    bool cont;
+
+    /* Idle line found by the timer, the counted bytes are in RAM.*/
+    osalSysLockFromISR();
+    upto = uartp->rxidle;
+    cont = uartp->rxcont;
+    uartp->rxpend = false;
+    osalSysUnlockFromISR();
+    if (cont) {
+      uart_rx_deliver(uartp, upto);
+    }
+  }
+#endif
+
   if (u->EVENTS_ERROR) {
 	uint32_t sr = u->ERRORSRC;
 
@@ -326,9 +534,40 @@ static void serve_uart_irq(UARTDriver *uartp) {
 	(void)u->EVENTS_ENDRX;
 #endif
 
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+    if (uartp->rxcont) {
+      /* A whole buffer reached RAM, delivered at once. A shorter one is
+         the late end of a reception stopped without waiting.*/
+      if (u->RXD.AMOUNT == NRF5_UART_RX_DMA_BUFFER_SIZE) {
+        uartp->rxfill += NRF5_UART_RX_DMA_BUFFER_SIZE;
+        uart_rx_deliver(uartp, uartp->rxfill);
+      }
+    }
+    else
+#endif
     /* End of reception, a callback is generated.*/
     uart_lld_serve_rx_end_irq(uartp, isr);
   }
+
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  if (u->EVENTS_RXSTARTED && isr & UARTE_INTENSET_RXSTARTED_Msk) {
+	u->EVENTS_RXSTARTED = 0;
+#if CORTEX_MODEL >= 4
+	(void)u->EVENTS_RXSTARTED;
+#endif
+
+    /* Queuing the other buffer, the ENDRX->STARTRX short picks it up.*/
+    u->RXD.PTR = (uint32_t)uartp->rxdbuf[uartp->rxnext];
+    uartp->rxnext ^= 1U;
+  }
+#endif
+
+  if (u->EVENTS_RXTO && isr & UARTE_INTENSET_RXTO_Msk) {
+	u->EVENTS_RXTO = 0;
+#if CORTEX_MODEL >= 4
+	(void)u->EVENTS_RXTO;
+#endif
+  }
 }
 
 /*===========================================================================*/
@@ -363,6 +602,12 @@ void uart_lld_init(void) {
 #if NRF5_UART_USE_UART0
   uartObjectInit(&UARTD1);
   UARTD1.uart = NRF_UARTE0;
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  UARTD1.rxcont = false;
+  iqObjectInit(&UARTD1.iqueue, UARTD1.ib, NRF5_UART_RX_QUEUE_SIZE,
+               NULL, NULL);
+  osalVTObjectInit(&UARTD1.rxvt);
+#endif
 #endif
 }
 
@@ -393,6 +638,15 @@ void uart_lld_start(UARTDriver *uartp) {
       nvicEnableVector(UARTE0_UART0_IRQn, NRF5_UART_UART0_IRQ_PRIORITY);
   }
 
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  /* Byte counter, RXDRDY->COUNT through PPI.*/
+  config->rx_timer->TASKS_STOP = 1;
+  config->rx_timer->MODE = TIMER_MODE_MODE_LowPowerCounter << TIMER_MODE_MODE_Pos;
+  config->rx_timer->BITMODE = TIMER_BITMODE_BITMODE_32Bit << TIMER_BITMODE_BITMODE_Pos;
+  NRF_PPI->CH[config->rx_ppi_channel].EEP = (uint32_t)&u->EVENTS_RXDRDY;
+  NRF_PPI->CH[config->rx_ppi_channel].TEP = (uint32_t)&config->rx_timer->TASKS_COUNT;
+#endif
+
   uartp->rxstate = UART_RX_IDLE;
   uartp->txstate = UART_TX_IDLE;
   uart_start(uartp);
@@ -500,6 +754,9 @@ void uart_lld_start_receive(UARTDriver *uartp, uint8_t n, void *rxbuf) {
   NRF_UARTE_Type *u=uartp->uart;
 
   /* Stopping previous activity (idle state).*/
+#if NRF5_UART_USE_RX_CONTINUOUS == TRUE
+  uart_stop_rx_continuous(uartp);
+#endif
   u->TASKS_STOPRX = 1;
   u->SHORTS = 0;
 
@@ -65,6 +65,38 @@
 #define NRF5_UART_UART0_IRQ_PRIORITY      3
 #endif
 
+/**
+ * @brief   Continuous double buffered reception switch.
+ * @details If set to @p TRUE the receiver idle loop fills two EasyDMA
+ *          buffers back to back instead of one byte per interrupt. A
+ *          TIMER counts the received bytes through PPI and an idle
+ *          timeout flushes partially filled buffers. Received data is
+ *          pushed into an input queue and to the @p rxchar_cb callback,
+ *          the callbacks are invoked from the UART IRQ handler outside
+ *          of the critical zone.
+ * @note    Bytes not delivered yet when the reception is stopped, by
+ *          @p uartStop() or @p uartStartReceive(), are discarded.
+ * @note    The idle timeout requires kernel virtual timers.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_UART_USE_RX_CONTINUOUS) || defined(__DOXYGEN__)
+#define NRF5_UART_USE_RX_CONTINUOUS       FALSE
+#endif
+
+/**
+ * @brief   Size of each of the two continuous reception DMA buffers.
+ */
+#if !defined(NRF5_UART_RX_DMA_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define NRF5_UART_RX_DMA_BUFFER_SIZE      128
+#endif
+
+/**
+ * @brief   Size of the continuous reception input queue.
+ */
+#if !defined(NRF5_UART_RX_QUEUE_SIZE) || defined(__DOXYGEN__)
+#define NRF5_UART_RX_QUEUE_SIZE           256
+#endif
+
 /* Value indicating that no pad is connected to this UART register. */
 #define  NRF5_UART_PAD_DISCONNECTED 0xFFFFFFFFU
 #define  NRF5_UART_INVALID_BAUDRATE 0xFFFFFFFFU
@@ -85,6 +117,12 @@
 #error "Invalid IRQ priority assigned to UART0"
 #endif
 
+#if NRF5_UART_USE_RX_CONTINUOUS &&                                        \
+    ((NRF5_UART_RX_DMA_BUFFER_SIZE < 2) ||                                \
+     (NRF5_UART_RX_DMA_BUFFER_SIZE > 255))
+#error "NRF5_UART_RX_DMA_BUFFER_SIZE out of range (2...255)"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -170,6 +208,22 @@ typedef struct {
    */
   uint32_t                  cts_pad;
 #endif
+#if (NRF5_UART_USE_RX_CONTINUOUS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief TIMER counting the received bytes.
+   */
+  NRF_TIMER_Type            *rx_timer;
+  /**
+   * @brief PPI channel routing RXDRDY to the counting TIMER.
+   */
+  uint8_t                   rx_ppi_channel;
+  /**
+   * @brief Line idle time after which partial buffers are delivered.
+   * @note  Zero disables the idle timeout, data is only delivered on
+   *        buffer completion.
+   */
+  sysinterval_t             rx_idle_timeout;
+#endif
 } UARTConfig;
 
 /**
@@ -224,12 +278,80 @@ struct UARTDriver {
    * @brief Default receive buffer while into @p UART_RX_IDLE state.
    */
   volatile uint32_t         rxbuf;
+#if (NRF5_UART_USE_RX_CONTINUOUS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief Continuous reception running.
+   */
+  bool                      rxcont;
+  /**
+   * @brief Buffer to be queued on the next RXSTARTED event.
+   */
+  uint8_t                   rxnext;
+  /**
+   * @brief Buffer holding the next byte to be delivered.
+   */
+  uint8_t                   rxrd;
+  /**
+   * @brief Offset of the next byte to be delivered.
+   */
+  size_t                    rxoff;
+  /**
+   * @brief Bytes delivered since reception start.
+   */
+  uint32_t                  rxdone;
+  /**
+   * @brief Bytes known to be in RAM, completed buffers.
+   */
+  uint32_t                  rxfill;
+  /**
+   * @brief Byte counter seen by the previous idle check.
+   */
+  uint32_t                  rxlast;
+  /**
+   * @brief Byte counter of the last idle line, known to be in RAM.
+   */
+  uint32_t                  rxidle;
+  /**
+   * @brief Idle line delivery pending in the IRQ handler.
+   */
+  bool                      rxpend;
+  /**
+   * @brief Idle check timer.
+   */
+  virtual_timer_t           rxvt;
+  /**
+   * @brief Input queue, same semantic of the serial driver one.
+   */
+  input_queue_t             iqueue;
+  /**
+   * @brief Input queue buffer.
+   */
+  uint8_t                   ib[NRF5_UART_RX_QUEUE_SIZE];
+  /**
+   * @brief EasyDMA reception buffers.
+   */
+  uint8_t                   rxdbuf[2][NRF5_UART_RX_DMA_BUFFER_SIZE];
+#endif
 };
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if (NRF5_UART_USE_RX_CONTINUOUS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the continuous reception input queue.
+ * @details The queue can be read with the usual @p iqGetTimeout() and
+ *          @p iqReadTimeout() functions, like the serial driver one.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @return              Pointer to the @p input_queue_t object.
+ *
+ * @api
+ */
+#define uartNrf5GetInputQueue(uartp) (&(uartp)->iqueue)
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
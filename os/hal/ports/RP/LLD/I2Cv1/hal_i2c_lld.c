@@ -148,6 +148,173 @@ static msg_t i2c_lld_abort_transmissionS(I2CDriver *i2cp) {
   return ok;
 }
 
+#if (RP_I2C_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief    Fills a staging buffer with command words for the current phase.
+ *
+ * @return              The number of command words written.
+ */
+static size_t i2c_lld_dma_fill(I2CDriver *i2cp, uint16_t *buf) {
+  size_t n = 0U;
+
+  if (i2cp->state == I2C_ACTIVE_TX) {
+    while ((n < RP_I2C_DMA_BUFFER_SIZE) && (i2cp->txbytes > 0U)) {
+      uint16_t data = (uint16_t)*i2cp->txptr;
+
+      /* Send STOP after last byte. */
+      if (i2cp->txbytes == 1U) {
+        data |= I2C_IC_DATA_CMD_STOP;
+      }
+      buf[n++] = data;
+
+      i2cp->txptr++;
+      i2cp->txbytes--;
+    }
+  } else {
+    while ((n < RP_I2C_DMA_BUFFER_SIZE) && (i2cp->rxbytes > 0U)) {
+      uint16_t data = I2C_IC_DATA_CMD_CMD;
+
+      if (i2cp->send_restart) {
+        data |= I2C_IC_DATA_CMD_RESTART;
+        i2cp->send_restart = false;
+      }
+      /* Send STOP after last byte. */
+      if (i2cp->rxbytes == 1U) {
+        data |= I2C_IC_DATA_CMD_STOP;
+      }
+      buf[n++] = data;
+
+      i2cp->rxbytes--;
+    }
+  }
+
+  return n;
+}
+
+/**
+ * @brief    Starts sending a staging buffer through the TX DMA channel.
+ */
+static void i2c_lld_dma_send(I2CDriver *i2cp, size_t n) {
+
+  dmaChannelSetSourceX(i2cp->dmatx, (uint32_t)i2cp->dmabuf[i2cp->dmacur]);
+  dmaChannelSetDestinationX(i2cp->dmatx, (uint32_t)&i2cp->i2c->DATACMD);
+  dmaChannelSetCounterX(i2cp->dmatx, (uint32_t)n);
+  dmaChannelSetModeX(i2cp->dmatx, i2cp->txdmamode);
+  dmaChannelEnableX(i2cp->dmatx);
+}
+
+/**
+ * @brief    Starts the current phase through DMA.
+ * @details  In receive phases the RX channel drains the FIFO directly into
+ *           the user buffer while the TX channel feeds the read commands.
+ */
+static void i2c_lld_dma_start_phase(I2CDriver *i2cp) {
+  I2C_TypeDef *dp = i2cp->i2c;
+  size_t n;
+
+  i2cp->dma_active = true;
+
+  if (i2cp->state == I2C_ACTIVE_RX) {
+    dmaChannelSetSourceX(i2cp->dmarx, (uint32_t)&dp->DATACMD);
+    dmaChannelSetDestinationX(i2cp->dmarx, (uint32_t)i2cp->rxptr);
+    dmaChannelSetCounterX(i2cp->dmarx, (uint32_t)i2cp->rxbytes);
+    dmaChannelSetModeX(i2cp->dmarx, i2cp->rxdmamode);
+    dmaChannelEnableX(i2cp->dmarx);
+    dp->DMARDLR = 0U;
+  }
+
+  /* Both staging buffers are prepared upfront, the second one is sent as
+     soon as the first completes and is then refilled in the background.*/
+  i2cp->dmacur = 0U;
+  n = i2c_lld_dma_fill(i2cp, i2cp->dmabuf[0]);
+  i2cp->dmaqueued = i2c_lld_dma_fill(i2cp, i2cp->dmabuf[1]);
+  i2c_lld_dma_send(i2cp, n);
+
+  dp->DMATDLR = 8U;
+  dp->DMACR = I2C_IC_DMA_CR_TDMAE |
+              (i2cp->state == I2C_ACTIVE_RX ? I2C_IC_DMA_CR_RDMAE : 0U);
+}
+
+/**
+ * @brief    Stops any DMA activity of the driver.
+ */
+static void i2c_lld_dma_stop(I2CDriver *i2cp) {
+
+  if (i2cp->dma_active) {
+    i2cp->i2c->DMACR = 0U;
+    dmaChannelDisableX(i2cp->dmatx);
+    dmaChannelDisableX(i2cp->dmarx);
+    i2cp->dma_active = false;
+  }
+}
+
+/**
+ * @brief    Checks whether the next phase should be served through DMA.
+ */
+static bool i2c_lld_dma_wanted(I2CDriver *i2cp, size_t n) {
+  size_t threshold = i2cp->config->dma_threshold;
+
+  return (threshold > 0U) && (n >= threshold);
+}
+
+/**
+ * @brief   Shared end-of-tx service routine.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] ct        content of the CTRL_TRIG register
+ */
+static void i2c_lld_serve_tx_interrupt(I2CDriver *i2cp, uint32_t ct) {
+
+  /* DMA errors handling.*/
+  if ((ct & DMA_CTRL_TRIG_AHB_ERROR) != 0U) {
+    RP_I2C_DMA_ERROR_HOOK(i2cp);
+  }
+
+  if (!i2cp->dma_active) {
+    return;
+  }
+
+  if (i2cp->dmaqueued > 0U) {
+    /* The other staging buffer is already prepared, send it and refill
+       the one that just completed.*/
+    i2cp->dmacur ^= 1U;
+    i2c_lld_dma_send(i2cp, i2cp->dmaqueued);
+    i2cp->dmaqueued = i2c_lld_dma_fill(i2cp, i2cp->dmabuf[i2cp->dmacur ^ 1U]);
+  }
+  else {
+    /* All commands are in the FIFO, completion is detected by STOP_DET or
+       by the RX channel.*/
+    i2cp->i2c->DMACR &= ~I2C_IC_DMA_CR_TDMAE;
+  }
+}
+
+/**
+ * @brief   Shared end-of-rx service routine.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] ct        content of the CTRL_TRIG register
+ */
+static void i2c_lld_serve_rx_interrupt(I2CDriver *i2cp, uint32_t ct) {
+  I2C_TypeDef *dp = i2cp->i2c;
+
+  /* DMA errors handling.*/
+  if ((ct & DMA_CTRL_TRIG_AHB_ERROR) != 0U) {
+    RP_I2C_DMA_ERROR_HOOK(i2cp);
+  }
+
+  if (!i2cp->dma_active) {
+    return;
+  }
+
+  /* Every byte is in the user buffer, transmission complete.*/
+  i2c_lld_dma_stop(i2cp);
+  dp->INTRMASK = 0U;
+  (void)dp->CLRINTR;
+
+  _i2c_wakeup_isr(i2cp);
+}
+#endif /* RP_I2C_USE_DMA == TRUE */
+
 /**
  * @brief    Handles transmission errors by waking the sleeping thread
  *           and setting the error reasons.
@@ -163,6 +330,10 @@ void i2c_lld_handle_errors(I2CDriver *i2cp) {
       i2cp->errors |= I2C_OVERRUN;
     }
 
+#if RP_I2C_USE_DMA == TRUE
+    i2c_lld_dma_stop(i2cp);
+#endif
+
     /* Disable all interrupts. */
     dp->INTRMASK = 0U;
     (void)dp->CLRINTR;
@@ -339,10 +510,26 @@ static void i2c_lld_serve_interrupt(I2CDriver *i2cp) {
       /* Restart communication. */
       i2cp->send_restart = true;
 
+#if RP_I2C_USE_DMA == TRUE
+      i2c_lld_dma_stop(i2cp);
+      if (i2c_lld_dma_wanted(i2cp, i2cp->rxbytes)) {
+        i2c_lld_dma_start_phase(i2cp);
+        return;
+      }
+#endif
+
       /* Enable TX FIFO empty IRQ to request more data to be received. */
       dp->SET.INTRMASK = I2C_IC_INTR_STAT_R_TX_EMPTY;
       return;
     }
+#if RP_I2C_USE_DMA == TRUE
+    if (i2cp->state == I2C_ACTIVE_RX && i2cp->dma_active) {
+      /* Completion is signaled by the RX channel once the FIFO has been
+         drained.*/
+      return;
+    }
+    i2c_lld_dma_stop(i2cp);
+#endif
   }
 
   /* Transmission complete, disable and clear all interrupts. */
@@ -394,6 +581,19 @@ void i2c_lld_init(void) {
   i2cObjectInit(&I2CD0);
   I2CD0.i2c = I2C0;
   I2CD0.thread = NULL;
+#if RP_I2C_USE_DMA == TRUE
+  I2CD0.dma_active = false;
+  I2CD0.dmarx = NULL;
+  I2CD0.dmatx = NULL;
+  I2CD0.rxdmamode = DMA_CTRL_TRIG_TREQ_SEL(RP_DMA_DREQ_I2C0_RX) |
+                    DMA_CTRL_TRIG_PRIORITY(RP_I2C_I2C0_DMA_PRIORITY) |
+                    DMA_CTRL_TRIG_DATA_SIZE_BYTE |
+                    DMA_CTRL_TRIG_INCR_WRITE;
+  I2CD0.txdmamode = DMA_CTRL_TRIG_TREQ_SEL(RP_DMA_DREQ_I2C0_TX) |
+                    DMA_CTRL_TRIG_PRIORITY(RP_I2C_I2C0_DMA_PRIORITY) |
+                    DMA_CTRL_TRIG_DATA_SIZE_HWORD |
+                    DMA_CTRL_TRIG_INCR_READ;
+#endif
 
   /* Reset I2C */
   hal_lld_peripheral_reset(RESETS_ALLREG_I2C0);
@@ -403,6 +603,19 @@ void i2c_lld_init(void) {
   i2cObjectInit(&I2CD1);
   I2CD1.i2c = I2C1;
   I2CD1.thread = NULL;
+#if RP_I2C_USE_DMA == TRUE
+  I2CD1.dma_active = false;
+  I2CD1.dmarx = NULL;
+  I2CD1.dmatx = NULL;
+  I2CD1.rxdmamode = DMA_CTRL_TRIG_TREQ_SEL(RP_DMA_DREQ_I2C1_RX) |
+                    DMA_CTRL_TRIG_PRIORITY(RP_I2C_I2C1_DMA_PRIORITY) |
+                    DMA_CTRL_TRIG_DATA_SIZE_BYTE |
+                    DMA_CTRL_TRIG_INCR_WRITE;
+  I2CD1.txdmamode = DMA_CTRL_TRIG_TREQ_SEL(RP_DMA_DREQ_I2C1_TX) |
+                    DMA_CTRL_TRIG_PRIORITY(RP_I2C_I2C1_DMA_PRIORITY) |
+                    DMA_CTRL_TRIG_DATA_SIZE_HWORD |
+                    DMA_CTRL_TRIG_INCR_READ;
+#endif
 
   /* Reset I2C */
   hal_lld_peripheral_reset(RESETS_ALLREG_I2C1);
@@ -426,6 +639,19 @@ void i2c_lld_start(I2CDriver *i2cp) {
       hal_lld_peripheral_unreset(RESETS_ALLREG_I2C0);
 
       nvicEnableVector(RP_I2C0_IRQ_NUMBER, RP_IRQ_I2C0_PRIORITY);
+
+#if RP_I2C_USE_DMA == TRUE
+      i2cp->dmarx = dmaChannelAllocI(RP_I2C_I2C0_RX_DMA_CHANNEL,
+                                     RP_IRQ_I2C0_PRIORITY,
+                                     (rp_dmaisr_t)i2c_lld_serve_rx_interrupt,
+                                     (void *)i2cp);
+      osalDbgAssert(i2cp->dmarx != NULL, "unable to allocate channel");
+      i2cp->dmatx = dmaChannelAllocI(RP_I2C_I2C0_TX_DMA_CHANNEL,
+                                     RP_IRQ_I2C0_PRIORITY,
+                                     (rp_dmaisr_t)i2c_lld_serve_tx_interrupt,
+                                     (void *)i2cp);
+      osalDbgAssert(i2cp->dmatx != NULL, "unable to allocate channel");
+#endif
     }
 #endif
 
@@ -434,6 +660,19 @@ void i2c_lld_start(I2CDriver *i2cp) {
       hal_lld_peripheral_unreset(RESETS_ALLREG_I2C1);
 
       nvicEnableVector(RP_I2C1_IRQ_NUMBER, RP_IRQ_I2C1_PRIORITY);
+
+#if RP_I2C_USE_DMA == TRUE
+      i2cp->dmarx = dmaChannelAllocI(RP_I2C_I2C1_RX_DMA_CHANNEL,
+                                     RP_IRQ_I2C1_PRIORITY,
+                                     (rp_dmaisr_t)i2c_lld_serve_rx_interrupt,
+                                     (void *)i2cp);
+      osalDbgAssert(i2cp->dmarx != NULL, "unable to allocate channel");
+      i2cp->dmatx = dmaChannelAllocI(RP_I2C_I2C1_TX_DMA_CHANNEL,
+                                     RP_IRQ_I2C1_PRIORITY,
+                                     (rp_dmaisr_t)i2c_lld_serve_tx_interrupt,
+                                     (void *)i2cp);
+      osalDbgAssert(i2cp->dmatx != NULL, "unable to allocate channel");
+#endif
     }
 #endif
   }
@@ -482,6 +721,13 @@ void i2c_lld_stop(I2CDriver *i2cp) {
       if (i2c_lld_disableS(i2cp) != MSG_OK) {
         i2c_lld_abort_transmissionS(i2cp);
       }
+#if RP_I2C_USE_DMA == TRUE
+      i2c_lld_dma_stop(i2cp);
+      dmaChannelFreeI(i2cp->dmarx);
+      dmaChannelFreeI(i2cp->dmatx);
+      i2cp->dmarx = NULL;
+      i2cp->dmatx = NULL;
+#endif
 #if RP_I2C_USE_I2C0 == TRUE
     if (&I2CD0 == i2cp) {
       nvicDisableVector(RP_I2C0_IRQ_NUMBER);
@@ -578,15 +824,29 @@ msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
   /* Clear interrupts. */
   (void)dp->CLRINTR;
 
-  /* Set interrupt mask. */
-  dp->INTRMASK = I2C_IC_INTR_MASK_M_STOP_DET |
-                 I2C_IC_INTR_MASK_M_TX_EMPTY |
-                 I2C_ERROR_INTERRUPTS;
+#if RP_I2C_USE_DMA == TRUE
+  if (i2c_lld_dma_wanted(i2cp, rxbytes)) {
+    /* Set interrupt mask, FIFO servicing is done by the DMA channels. */
+    dp->INTRMASK = I2C_IC_INTR_MASK_M_STOP_DET |
+                   I2C_ERROR_INTERRUPTS;
+    i2c_lld_dma_start_phase(i2cp);
+  }
+  else
+#endif
+  {
+    /* Set interrupt mask. */
+    dp->INTRMASK = I2C_IC_INTR_MASK_M_STOP_DET |
+                   I2C_IC_INTR_MASK_M_TX_EMPTY |
+                   I2C_ERROR_INTERRUPTS;
+  }
 
   /* Waits for the operation completion or a timeout.*/
   msg = osalThreadSuspendTimeoutS(&i2cp->thread, timeout);
 
   if (msg == MSG_TIMEOUT) {
+#if RP_I2C_USE_DMA == TRUE
+    i2c_lld_dma_stop(i2cp);
+#endif
     /* Disable and clear interrupts. */
     dp->INTRMASK = 0U;
     (void)dp->CLRINTR;
@@ -676,15 +936,29 @@ msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
   /* Clear interrupts. */
   (void)dp->CLRINTR;
 
-  /* Set interrupt mask. */
-  dp->INTRMASK = I2C_IC_INTR_MASK_M_STOP_DET |
-                 I2C_IC_INTR_MASK_M_TX_EMPTY |
-                 I2C_ERROR_INTERRUPTS;
+#if RP_I2C_USE_DMA == TRUE
+  if (i2c_lld_dma_wanted(i2cp, txbytes)) {
+    /* Set interrupt mask, FIFO servicing is done by the DMA channels. */
+    dp->INTRMASK = I2C_IC_INTR_MASK_M_STOP_DET |
+                   I2C_ERROR_INTERRUPTS;
+    i2c_lld_dma_start_phase(i2cp);
+  }
+  else
+#endif
+  {
+    /* Set interrupt mask. */
+    dp->INTRMASK = I2C_IC_INTR_MASK_M_STOP_DET |
+                   I2C_IC_INTR_MASK_M_TX_EMPTY |
+                   I2C_ERROR_INTERRUPTS;
+  }
 
   /* Waits for the operation completion or a timeout.*/
   msg = osalThreadSuspendTimeoutS(&i2cp->thread, timeout);
 
   if (msg == MSG_TIMEOUT) {
+#if RP_I2C_USE_DMA == TRUE
+    i2c_lld_dma_stop(i2cp);
+#endif
     /* Disable and clear interrupts. */
     dp->INTRMASK = 0U;
     (void)dp->CLRINTR;
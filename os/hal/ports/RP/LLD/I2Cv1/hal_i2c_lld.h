@@ -65,12 +65,85 @@
 #define RP_I2C_BUSY_TIMEOUT              50
 #endif
 
+/**
+ * @brief   I2C DMA support switch.
+ * @details If set to @p TRUE the driver is able to move long transfers
+ *          through DMA channels instead of the FIFO interrupts, see the
+ *          @p dma_threshold field of @p I2CConfig.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(RP_I2C_USE_DMA) || defined(__DOXYGEN__)
+#define RP_I2C_USE_DMA                   FALSE
+#endif
+
+/**
+ * @brief   Size in command words of each half of the DMA staging buffer.
+ * @note    The staging buffer is double buffered, so each driver reserves
+ *          twice this amount of half words.
+ */
+#if !defined(RP_I2C_DMA_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define RP_I2C_DMA_BUFFER_SIZE           32
+#endif
+
+/**
+ * @brief   I2C0 RX DMA channel setting.
+ */
+#if !defined(RP_I2C_I2C0_RX_DMA_CHANNEL) || defined(__DOXYGEN__)
+#define RP_I2C_I2C0_RX_DMA_CHANNEL       RP_DMA_CHANNEL_ID_ANY
+#endif
+
+/**
+ * @brief   I2C0 TX DMA channel setting.
+ */
+#if !defined(RP_I2C_I2C0_TX_DMA_CHANNEL) || defined(__DOXYGEN__)
+#define RP_I2C_I2C0_TX_DMA_CHANNEL       RP_DMA_CHANNEL_ID_ANY
+#endif
+
+/**
+ * @brief   I2C1 RX DMA channel setting.
+ */
+#if !defined(RP_I2C_I2C1_RX_DMA_CHANNEL) || defined(__DOXYGEN__)
+#define RP_I2C_I2C1_RX_DMA_CHANNEL       RP_DMA_CHANNEL_ID_ANY
+#endif
+
+/**
+ * @brief   I2C1 TX DMA channel setting.
+ */
+#if !defined(RP_I2C_I2C1_TX_DMA_CHANNEL) || defined(__DOXYGEN__)
+#define RP_I2C_I2C1_TX_DMA_CHANNEL       RP_DMA_CHANNEL_ID_ANY
+#endif
+
+/**
+ * @brief   I2C0 DMA priority (0..1|lowest..highest).
+ */
+#if !defined(RP_I2C_I2C0_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define RP_I2C_I2C0_DMA_PRIORITY         0
+#endif
+
+/**
+ * @brief   I2C1 DMA priority (0..1|lowest..highest).
+ */
+#if !defined(RP_I2C_I2C1_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define RP_I2C_I2C1_DMA_PRIORITY         0
+#endif
+
+/**
+ * @brief   I2C DMA error hook.
+ */
+#if !defined(RP_I2C_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define RP_I2C_DMA_ERROR_HOOK(i2cp)      osalSysHalt("DMA failure")
+#endif
+
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (RP_I2C_USE_DMA == TRUE) && (RP_I2C_DMA_BUFFER_SIZE < 16)
+#error "RP_I2C_DMA_BUFFER_SIZE must be at least the FIFO depth (16)"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -93,6 +166,15 @@ typedef uint32_t i2cflags_t;
 typedef struct {
   /* Baudrate setting. */
   uint32_t                  baudrate;
+#if (RP_I2C_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Minimum phase length in bytes served through DMA.
+   * @details Transmit or receive phases shorter than this value are
+   *          served by the FIFO interrupts, zero disables DMA for this
+   *          configuration.
+   */
+  size_t                    dma_threshold;
+#endif
 } I2CConfig;
 
 /**
@@ -151,6 +233,40 @@ struct I2CDriver {
    * @brief     Buffer for RX.
    */
   uint8_t                   *rxptr;
+#if (RP_I2C_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief     The current phase is served through DMA.
+   */
+  bool                      dma_active;
+  /**
+   * @brief     Staging buffer currently being sent by the TX DMA channel.
+   */
+  uint8_t                   dmacur;
+  /**
+   * @brief     Command words ready in the other staging buffer.
+   */
+  size_t                    dmaqueued;
+  /**
+   * @brief     RX DMA channel.
+   */
+  const rp_dma_channel_t    *dmarx;
+  /**
+   * @brief     TX DMA channel.
+   */
+  const rp_dma_channel_t    *dmatx;
+  /**
+   * @brief     RX DMA mode bit mask.
+   */
+  uint32_t                  rxdmamode;
+  /**
+   * @brief     TX DMA mode bit mask.
+   */
+  uint32_t                  txdmamode;
+  /**
+   * @brief     Double buffered command words fed to the DATA_CMD register.
+   */
+  uint16_t                  dmabuf[2][RP_I2C_DMA_BUFFER_SIZE];
+#endif
 };
 
 /*===========================================================================*/
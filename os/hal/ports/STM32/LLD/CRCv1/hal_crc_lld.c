@@ -95,6 +95,45 @@ void _crc_lld_calc_word(CRCDriver *crcp, uint32_t data) {
   crcp->crc->DR = data;
 }
 
+#if STM32_CRC_PROGRAMMABLE == TRUE
+/*
+ * @brief   Programs the unit from the current configuration.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] value     value loaded in the CRC register
+ *
+ * @notapi
+ */
+static void _crc_lld_program(CRCDriver *crcp, uint32_t value) {
+  crcp->crc->INIT = value;
+  crcp->crc->POL = crcp->config->poly;
+
+  crcp->crc->CR = 0;
+  switch(crcp->config->poly_size) {
+    case 32:
+      break;
+    case 16:
+      crcp->crc->CR |= CRC_CR_POLYSIZE_0;
+      break;
+    case 8:
+      crcp->crc->CR |= CRC_CR_POLYSIZE_1;
+      break;
+    case 7:
+      crcp->crc->CR |= CRC_CR_POLYSIZE_1 | CRC_CR_POLYSIZE_0;
+      break;
+    default:
+      osalDbgAssert(false, "hardware doesn't support polynomial size");
+      break;
+  };
+  if (crcp->config->reflect_data) {
+    crcp->crc->CR |= CRC_CR_REV_IN_1 | CRC_CR_REV_IN_0;
+  }
+  if (crcp->config->reflect_remainder) {
+    crcp->crc->CR |= CRC_CR_REV_OUT;
+  }
+}
+#endif
+
 
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
@@ -160,32 +199,7 @@ void crc_lld_start(CRCDriver *crcp) {
   rccEnableCRC( FALSE );
 
 #if STM32_CRC_PROGRAMMABLE == TRUE
-  crcp->crc->INIT = crcp->config->initial_val;
-  crcp->crc->POL = crcp->config->poly;
-
-  crcp->crc->CR = 0;
-  switch(crcp->config->poly_size) {
-    case 32:
-      break;
-    case 16:
-      crcp->crc->CR |= CRC_CR_POLYSIZE_0;
-      break;
-    case 8:
-      crcp->crc->CR |= CRC_CR_POLYSIZE_1;
-      break;
-    case 7:
-      crcp->crc->CR |= CRC_CR_POLYSIZE_1 | CRC_CR_POLYSIZE_0;
-      break;
-    default:
-      osalDbgAssert(false, "hardware doesn't support polynomial size");
-      break;
-  };
-  if (crcp->config->reflect_data) {
-    crcp->crc->CR |= CRC_CR_REV_IN_1 | CRC_CR_REV_IN_0;
-  }
-  if (crcp->config->reflect_remainder) {
-    crcp->crc->CR |= CRC_CR_REV_OUT;
-  }
+  _crc_lld_program(crcp, crcp->config->initial_val);
 #else
   osalDbgAssert(crcp->config->initial_val == default_config.initial_val,
       "hardware doesn't support programmable initial value");
@@ -260,9 +274,15 @@ void crc_lld_reset(CRCDriver *crcp) {
  */
 uint32_t crc_lld_calc(CRCDriver *crcp, size_t n, const void *buf) {
 #if CRC_USE_DMA == TRUE
-  crc_lld_start_calc(crcp, n, buf);
-  (void) osalThreadSuspendS(&crcp->thread);
-#else
+  if (n >= CRC_DMA_THRESHOLD) {
+    crc_lld_start_calc(crcp, n, buf);
+    (void) osalThreadSuspendS(&crcp->thread);
+    return crcp->crc->DR ^ crcp->config->final_val;
+  }
+
+  /* Short buffer, no ISR will move the driver back to ready.*/
+  crcp->state = CRC_READY;
+#endif
   /**
    * BUG: Only peform byte writes to DR reg if reflect_data is disabled.
    * The STM32 hardware unit seems to incorrectly calculate CRCs when all
@@ -314,7 +334,6 @@ uint32_t crc_lld_calc(CRCDriver *crcp, size_t n, const void *buf) {
   osalDbgAssert(n == 0, "STM32 CRC Unit only supports WORD accesses");
 #endif
 
-#endif
   return crcp->crc->DR ^ crcp->config->final_val;
 }
 
@@ -328,6 +347,10 @@ void crc_lld_start_calc(CRCDriver *crcp, size_t n, const void *buf) {
   dmaStreamSetPeripheral(crcp->dmastp, buf);
   dmaStreamSetMemory0(crcp->dmastp, &crcp->crc->DR);
 #if STM32_CRC_PROGRAMMABLE == TRUE
+  /* The DMA writes bytes, reverse the input bits byte by byte.*/
+  if (crcp->config->reflect_data != 0) {
+    crcp->crc->CR = (crcp->crc->CR & ~CRC_CR_REV_IN_Msk) | CRC_CR_REV_IN_0;
+  }
   dmaStreamSetTransactionSize(crcp->dmastp, sz);
 #else
   dmaStreamSetTransactionSize(crcp->dmastp, (sz / 4));
@@ -338,6 +361,63 @@ void crc_lld_start_calc(CRCDriver *crcp, size_t n, const void *buf) {
 }
 #endif
 
+#if (STM32_CRC_PROGRAMMABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Tells whether the unit can compute a configuration.
+ *
+ * @param[in] config    CRC parameters
+ * @return              @p true if the unit handles the polynomial size.
+ *
+ * @notapi
+ */
+bool crc_lld_can_offload(const CRCConfig *config) {
+  switch (config->poly_size) {
+  case 7:
+  case 8:
+  case 16:
+  case 32:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief   Loads the unit with the current configuration and a value.
+ * @details The value is the CRC register in its normal, not reflected,
+ *          form, as returned by @p crc_lld_save().
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] value     CRC register value
+ *
+ * @notapi
+ */
+void crc_lld_load(CRCDriver *crcp, uint32_t value) {
+  _crc_lld_program(crcp, value);
+  crcp->crc->CR |= CRC_CR_RESET;
+}
+
+/**
+ * @brief   Reads back the CRC register in its normal form.
+ * @note    With @p reflect_remainder the data register reads the register
+ *          reversed, it is turned back here so @p crc_lld_load() can
+ *          restore it through INIT.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @return              CRC register value
+ *
+ * @notapi
+ */
+uint32_t crc_lld_save(CRCDriver *crcp) {
+  uint32_t value = crcp->crc->DR;
+
+  if (crcp->config->reflect_remainder) {
+    value = __RBIT(value) >> (32U - crcp->config->poly_size);
+  }
+  return value;
+}
+#endif
+
 #endif /* CRCSW_USE_CRC1 */
 
 #endif /* HAL_USE_CRC */
@@ -117,6 +117,11 @@
 #endif
 #endif
 
+/**
+ * @brief   Programmable units can be reloaded with any polynomial and value.
+ */
+#define CRC_LLD_SUPPORTS_CONTEXTS           STM32_CRC_PROGRAMMABLE
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -242,6 +247,11 @@ extern "C" {
 #if CRC_USE_DMA
   void crc_lld_start_calc(CRCDriver *crcp, size_t n, const void *buf);
 #endif
+#if STM32_CRC_PROGRAMMABLE == TRUE
+  bool crc_lld_can_offload(const CRCConfig *config);
+  void crc_lld_load(CRCDriver *crcp, uint32_t value);
+  uint32_t crc_lld_save(CRCDriver *crcp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,7 @@
  */
 
 #include "hal.h"
+#include "hal_trace_points.h"
 
 #include "hal_stm32_dma2d.h"
 
@@ -90,9 +91,16 @@ OSAL_IRQ_HANDLER(STM32_DMA2D_HANDLER) {
   DMA2DDriver *const dma2dp = &DMA2DD1;
   bool job_done = false;
   thread_t *tp = NULL;
+#if HAL_USE_TRACE_POINTS == TRUE
+  uint32_t isr;
+#endif
 
   OSAL_IRQ_PROLOGUE();
 
+#if HAL_USE_TRACE_POINTS == TRUE
+  isr = DMA2D->ISR;
+#endif
+
   /* Handle Configuration Error ISR.*/
   if ((DMA2D->ISR & DMA2D_ISR_CEIF) && (DMA2D->CR & DMA2D_CR_CEIE)) {
     if (dma2dp->config->cfgerr_isr != NULL)
@@ -141,6 +149,8 @@ OSAL_IRQ_HANDLER(STM32_DMA2D_HANDLER) {
   }
 
   if (job_done) {
+    _hal_trace_point(HAL_TRACE_MODULE_DMA2D, HAL_TRACE_DMA2D_JOB_END,
+                     isr, 0, 0);
     osalSysLockFromISR();
     osalDbgAssert(dma2dp->state == DMA2D_ACTIVE, "invalid state");
 
@@ -983,6 +993,9 @@ void dma2dJobStartI(DMA2DDriver *dma2dp) {
   osalDbgAssert(dma2dp->state == DMA2D_READY, "not ready");
 
   dma2dp->state = DMA2D_ACTIVE;
+  _hal_trace_point(HAL_TRACE_MODULE_DMA2D, HAL_TRACE_DMA2D_JOB_START,
+                   DMA2D->CR & DMA2D_CR_MODE, (DMA2D->NLR & DMA2D_NLR_PL) >> 16,
+                   DMA2D->NLR & DMA2D_NLR_NL);
   DMA2D->CR |= DMA2D_CR_START;
 }
 
@@ -450,6 +450,52 @@ static void start_channels(EICUDriver *eicup) {
   }
 }
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared streaming DMA service routine.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] flags     Pre-shifted content of the ISR register
+ */
+static void eicu_lld_serve_dma_interrupt(EICUDriver *eicup, uint32_t flags) {
+  size_t half = eicup->stream_n / 2U;
+
+  /* DMA errors handling.*/
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0U) {
+    STM32_EICU_DMA_ERROR_HOOK(eicup);
+    return;
+  }
+
+  /* First half filled, the DMA is now writing the second one.*/
+  if ((flags & STM32_DMA_ISR_HTIF) != 0U)
+    _eicu_isr_invoke_stream_cb(eicup, &eicup->stream_buf[0], half);
+
+  /* Second half filled, the DMA wrapped to the first one.*/
+  if ((flags & STM32_DMA_ISR_TCIF) != 0U)
+    _eicu_isr_invoke_stream_cb(eicup, &eicup->stream_buf[half], half);
+}
+
+/**
+ * @brief   Sets the capture polarity of a channel.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] channel   The timer channel
+ * @param[in] both      Capture on both edges
+ */
+static void set_channel_polarity(EICUDriver *eicup, eicuchannel_t channel,
+                                 bool both) {
+  uint32_t ccer = STM32_TIM_CCER_CC1E;
+
+  if (both)
+    ccer |= STM32_TIM_CCER_CC1P | STM32_TIM_CCER_CC1NP;
+  else if (eicup->channel[channel].config->alvl == EICU_INPUT_ACTIVE_LOW)
+    ccer |= STM32_TIM_CCER_CC1P;
+
+  eicup->tim->CCER = (eicup->tim->CCER & ~(0xFU << (channel * 4U))) |
+                     (ccer << (channel * 4U));
+}
+#endif /* EICU_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -1035,6 +1081,10 @@ void eicu_lld_start(EICUDriver *eicup) {
   }
 
   start_channels(eicup);
+
+#if EICU_USE_DMA == TRUE
+  eicup->dma = NULL;
+#endif
 }
 
 /**
@@ -1173,4 +1223,91 @@ void eicu_lld_disable(EICUDriver *eicup) {
   eicup->tim->DIER &= ~STM32_TIM_DIER_IRQ_MASK;
 }
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts streaming the captures of a channel.
+ * @details Capture requests of the channel move the capture register into
+ *          the circular buffer, no capture interrupts are enabled.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] channel   Channel to be streamed
+ * @param[out] buf      Circular buffer
+ * @param[in] n         Number of samples in the buffer
+ *
+ * @notapi
+ */
+void eicu_lld_start_stream(EICUDriver *eicup, eicuchannel_t channel,
+                           eicusample_t *buf, size_t n) {
+  const EICUConfig *config = eicup->config;
+  uint32_t mode;
+
+  osalDbgCheck((channel < eicup->channels) && (n <= 0xFFFFU));
+  osalDbgAssert(eicup->channel[channel].config != NULL,
+                "channel not configured");
+
+  eicup->dma = dmaStreamAllocI(config->dma_stream,
+                               STM32_EICU_DMA_IRQ_PRIORITY,
+                               (stm32_dmaisr_t)eicu_lld_serve_dma_interrupt,
+                               (void *)eicup);
+  osalDbgAssert(eicup->dma != NULL, "unable to allocate stream");
+
+  eicup->stream_channel = channel;
+  eicup->stream_buf     = buf;
+  eicup->stream_n       = n;
+
+  /* Circular word transfers from the capture register, the half and full
+     transfer interrupts split the buffer in two halves.*/
+  mode = STM32_DMA_CR_PL(STM32_EICU_DMA_PRIORITY) |
+         STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC |
+         STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+         STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE |
+         STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+#if STM32_DMA_SUPPORTS_DMAMUX
+  dmaSetRequestSource(eicup->dma, config->dma_request);
+#else
+  mode |= STM32_DMA_CR_CHSEL(config->dma_request);
+#endif
+  dmaStreamSetPeripheral(eicup->dma, eicup->channel[channel].ccrp);
+  dmaStreamSetMemory0(eicup->dma, buf);
+  dmaStreamSetTransactionSize(eicup->dma, n);
+  dmaStreamSetMode(eicup->dma, mode);
+
+  /* The polarity cannot be flipped between edges without interrupts,
+     pulse measurements capture both edges instead.*/
+  set_channel_polarity(eicup, channel,
+                       eicup->channel[channel].config->mode != EICU_INPUT_EDGE);
+
+  eicup->tim->EGR = STM32_TIM_EGR_UG;
+  eicup->tim->SR = 0;                         /* Clear pending IRQs (if any). */
+  dmaStreamEnable(eicup->dma);
+
+  eicup->tim->DIER = (eicup->tim->DIER & ~STM32_TIM_DIER_IRQ_MASK) |
+                     (STM32_TIM_DIER_CC1DE << channel);
+  eicup->tim->CR1 = STM32_TIM_CR1_URS | STM32_TIM_CR1_CEN;
+}
+
+/**
+ * @brief   Stops streaming.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ *
+ * @notapi
+ */
+void eicu_lld_stop_stream(EICUDriver *eicup) {
+
+  eicup->tim->CR1   = 0;                      /* Timer stopped.               */
+  eicup->tim->DIER &= ~(STM32_TIM_DIER_IRQ_MASK |
+                        (STM32_TIM_DIER_CC1DE << eicup->stream_channel));
+  eicup->tim->SR    = 0;                      /* Clear pending IRQs (if any). */
+
+  dmaStreamDisable(eicup->dma);
+  dmaStreamFreeI(eicup->dma);
+  eicup->dma = NULL;
+
+  /* Back to the single edge polarity used by the interrupt mode.*/
+  set_channel_polarity(eicup, eicup->stream_channel, false);
+  eicup->channel[eicup->stream_channel].state = EICU_CH_IDLE;
+}
+#endif /* EICU_USE_DMA == TRUE */
+
 #endif /* HAL_USE_EICU */
@@ -196,6 +196,29 @@
 #if !defined(STM32_EICU_TIM14_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_EICU_TIM14_IRQ_PRIORITY         7
 #endif
+
+/**
+ * @brief   Streaming DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_EICU_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_EICU_DMA_PRIORITY              2
+#endif
+
+/**
+ * @brief   Streaming DMA interrupt priority level setting.
+ */
+#if !defined(STM32_EICU_DMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_EICU_DMA_IRQ_PRIORITY          7
+#endif
+
+/**
+ * @brief   Streaming DMA error hook.
+ * @note    The default action for DMA errors is a system halt because DMA
+ *          error can only happen because programming errors.
+ */
+#if !defined(STM32_EICU_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_EICU_DMA_ERROR_HOOK(eicup)     osalSysHalt("DMA failure")
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -319,6 +342,20 @@
 #error "Invalid IRQ priority assigned to TIM14"
 #endif
 
+#if EICU_USE_DMA == TRUE
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_EICU_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to EICU"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_EICU_DMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to EICU DMA"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* EICU_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -446,6 +483,25 @@ typedef struct {
    * @brief   TIM DIER register initialization data.
    */
   uint32_t                dier;
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Callback for each filled half of the stream buffer.
+   */
+  eicustreamcb_t          stream_cb;
+  /**
+   * @brief   DMA stream used for streaming.
+   * @note    The stream must be able to serve the capture request of the
+   *          streamed channel, @p STM32_DMA_STREAM_ID_ANY can be used on
+   *          devices with a DMAMUX.
+   */
+  uint32_t                dma_stream;
+  /**
+   * @brief   DMA request of the streamed channel.
+   * @note    This is the channel selection on devices with fixed DMA
+   *          mapping or the DMAMUX request on devices with a DMAMUX.
+   */
+  uint32_t                dma_request;
+#endif
 } EICUConfig;
 
 /** 
@@ -480,6 +536,24 @@ struct EICUDriver {
    * @brief   Pointer to configuration for the driver.
    */
   const EICUConfig        *config;
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   DMA stream, @p NULL when not streaming.
+   */
+  const stm32_dma_stream_t *dma;
+  /**
+   * @brief   Streamed channel.
+   */
+  eicuchannel_t           stream_channel;
+  /**
+   * @brief   Stream buffer.
+   */
+  eicusample_t            *stream_buf;
+  /**
+   * @brief   Number of samples in the stream buffer.
+   */
+  size_t                  stream_n;
+#endif
 };
 
 /*===========================================================================*/
@@ -545,6 +619,11 @@ extern "C" {
   void eicu_lld_stop(EICUDriver *eicup);
   void eicu_lld_enable(EICUDriver *eicup);
   void eicu_lld_disable(EICUDriver *eicup);
+#if EICU_USE_DMA == TRUE
+  void eicu_lld_start_stream(EICUDriver *eicup, eicuchannel_t channel,
+                             eicusample_t *buf, size_t n);
+  void eicu_lld_stop_stream(EICUDriver *eicup);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -90,10 +90,148 @@ QEIDriver QEID8;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared IRQ handler.
+ * @details The only source is the armed CC1 capture, the counter value
+ *          latched at the edge is passed to the velocity estimator.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ */
+static void qei_lld_serve_interrupt(QEIDriver *qeip) {
+  uint32_t time = QEI_VELOCITY_TIMESTAMP();
+
+  if ((qeip->tim->SR & qeip->tim->DIER & TIM_SR_CC1IF) != 0U) {
+    qeip->tim->DIER &= ~TIM_DIER_CC1IE;
+    qeip->tim->SR    = ~TIM_SR_CC1IF;
+
+    osalSysLockFromISR();
+    _qei_isr_velocity_edge(qeip, (qeicnt_t)qeip->tim->CCR[0], time);
+    osalSysUnlockFromISR();
+  }
+}
+#endif /* QEI_USE_VELOCITY == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+#if STM32_QEI_USE_TIM1
+#if !defined(STM32_TIM1_CC_HANDLER)
+#error "STM32_TIM1_CC_HANDLER not defined"
+#endif
+/**
+ * @brief   TIM1 compare interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_TIM1_CC_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  qei_lld_serve_interrupt(&QEID1);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* STM32_QEI_USE_TIM1 */
+
+#if STM32_QEI_USE_TIM2
+#if !defined(STM32_TIM2_HANDLER)
+#error "STM32_TIM2_HANDLER not defined"
+#endif
+/**
+ * @brief   TIM2 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_TIM2_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  qei_lld_serve_interrupt(&QEID2);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* STM32_QEI_USE_TIM2 */
+
+#if STM32_QEI_USE_TIM3
+#if !defined(STM32_TIM3_HANDLER)
+#error "STM32_TIM3_HANDLER not defined"
+#endif
+/**
+ * @brief   TIM3 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_TIM3_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  qei_lld_serve_interrupt(&QEID3);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* STM32_QEI_USE_TIM3 */
+
+#if STM32_QEI_USE_TIM4
+#if !defined(STM32_TIM4_HANDLER)
+#error "STM32_TIM4_HANDLER not defined"
+#endif
+/**
+ * @brief   TIM4 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_TIM4_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  qei_lld_serve_interrupt(&QEID4);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* STM32_QEI_USE_TIM4 */
+
+#if STM32_QEI_USE_TIM5
+#if !defined(STM32_TIM5_HANDLER)
+#error "STM32_TIM5_HANDLER not defined"
+#endif
+/**
+ * @brief   TIM5 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_TIM5_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  qei_lld_serve_interrupt(&QEID5);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* STM32_QEI_USE_TIM5 */
+
+#if STM32_QEI_USE_TIM8
+#if !defined(STM32_TIM8_CC_HANDLER)
+#error "STM32_TIM8_CC_HANDLER not defined"
+#endif
+/**
+ * @brief   TIM8 compare interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_TIM8_CC_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  qei_lld_serve_interrupt(&QEID8);
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif /* STM32_QEI_USE_TIM8 */
+#endif /* QEI_USE_VELOCITY == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -159,24 +297,36 @@ void qei_lld_start(QEIDriver *qeip) {
     if (&QEID1 == qeip) {
       rccEnableTIM1(FALSE);
       rccResetTIM1();
+#if QEI_USE_VELOCITY == TRUE
+      nvicEnableVector(STM32_TIM1_CC_NUMBER, STM32_QEI_TIM1_IRQ_PRIORITY);
+#endif
     }
 #endif
 #if STM32_QEI_USE_TIM2
     if (&QEID2 == qeip) {
       rccEnableTIM2(FALSE);
       rccResetTIM2();
+#if QEI_USE_VELOCITY == TRUE
+      nvicEnableVector(STM32_TIM2_NUMBER, STM32_QEI_TIM2_IRQ_PRIORITY);
+#endif
     }
 #endif
 #if STM32_QEI_USE_TIM3
     if (&QEID3 == qeip) {
       rccEnableTIM3(FALSE);
       rccResetTIM3();
+#if QEI_USE_VELOCITY == TRUE
+      nvicEnableVector(STM32_TIM3_NUMBER, STM32_QEI_TIM3_IRQ_PRIORITY);
+#endif
     }
 #endif
 #if STM32_QEI_USE_TIM4
     if (&QEID4 == qeip) {
       rccEnableTIM4(FALSE);
       rccResetTIM4();
+#if QEI_USE_VELOCITY == TRUE
+      nvicEnableVector(STM32_TIM4_NUMBER, STM32_QEI_TIM4_IRQ_PRIORITY);
+#endif
     }
 #endif
 
@@ -184,12 +334,18 @@ void qei_lld_start(QEIDriver *qeip) {
     if (&QEID5 == qeip) {
       rccEnableTIM5(FALSE);
       rccResetTIM5();
+#if QEI_USE_VELOCITY == TRUE
+      nvicEnableVector(STM32_TIM5_NUMBER, STM32_QEI_TIM5_IRQ_PRIORITY);
+#endif
     }
 #endif
 #if STM32_QEI_USE_TIM8
     if (&QEID8 == qeip) {
       rccEnableTIM8(FALSE);
       rccResetTIM8();
+#if QEI_USE_VELOCITY == TRUE
+      nvicEnableVector(STM32_TIM8_CC_NUMBER, STM32_QEI_TIM8_IRQ_PRIORITY);
+#endif
     }
 #endif
   }
@@ -235,32 +391,50 @@ void qei_lld_stop(QEIDriver *qeip) {
     /* Clock deactivation.*/
 #if STM32_QEI_USE_TIM1
     if (&QEID1 == qeip) {
+#if QEI_USE_VELOCITY == TRUE
+      nvicDisableVector(STM32_TIM1_CC_NUMBER);
+#endif
       rccDisableTIM1();
     }
 #endif
 #if STM32_QEI_USE_TIM2
     if (&QEID2 == qeip) {
+#if QEI_USE_VELOCITY == TRUE
+      nvicDisableVector(STM32_TIM2_NUMBER);
+#endif
       rccDisableTIM2();
     }
 #endif
 #if STM32_QEI_USE_TIM3
     if (&QEID3 == qeip) {
+#if QEI_USE_VELOCITY == TRUE
+      nvicDisableVector(STM32_TIM3_NUMBER);
+#endif
       rccDisableTIM3();
     }
 #endif
 #if STM32_QEI_USE_TIM4
     if (&QEID4 == qeip) {
+#if QEI_USE_VELOCITY == TRUE
+      nvicDisableVector(STM32_TIM4_NUMBER);
+#endif
       rccDisableTIM4();
     }
 #endif
 #if STM32_QEI_USE_TIM5
     if (&QEID5 == qeip) {
+#if QEI_USE_VELOCITY == TRUE
+      nvicDisableVector(STM32_TIM5_NUMBER);
+#endif
       rccDisableTIM5();
     }
 #endif
   }
 #if STM32_QEI_USE_TIM8
     if (&QEID8 == qeip) {
+#if QEI_USE_VELOCITY == TRUE
+      nvicDisableVector(STM32_TIM8_CC_NUMBER);
+#endif
       rccDisableTIM8();
     }
 #endif
@@ -287,7 +461,8 @@ void qei_lld_enable(QEIDriver *qeip) {
  */
 void qei_lld_disable(QEIDriver *qeip) {
 
-  qeip->tim->CR1 = 0;                    /* Timer disabled. */
+  qeip->tim->CR1  = 0;                   /* Timer disabled. */
+  qeip->tim->DIER = 0;                   /* Edge capture disarmed. */
 }
 
 #endif /* HAL_USE_QEI */
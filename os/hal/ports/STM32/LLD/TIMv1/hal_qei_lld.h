@@ -383,6 +383,12 @@ struct QEIDriver {
    * @brief Current configuration data.
    */
   const QEIConfig           *config;
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief Velocity estimator.
+   */
+  qeiestimator_t            vel;
+#endif
 #if defined(QEI_DRIVER_EXT_FIELDS)
   QEI_DRIVER_EXT_FIELDS
 #endif
@@ -417,6 +423,20 @@ struct QEIDriver {
  */
 #define qei_lld_set_count(qeip, value) ((qeip)->tim->CNT = (value))
 
+/**
+ * @brief   Arms the capture of the next encoder edge.
+ * @details The next TI1 edge latches the counter into CCR1 and raises a
+ *          single interrupt, the interrupt disables itself.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ *
+ * @notapi
+ */
+#define qei_lld_arm_velocity(qeip) do {                                     \
+  (qeip)->tim->SR    = ~TIM_SR_CC1IF;                                       \
+  (qeip)->tim->DIER |= TIM_DIER_CC1IE;                                      \
+} while (0)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -248,6 +248,35 @@ static void timcap_lld_serve_interrupt(TIMCAPDriver *timcapp) {
     _timcap_isr_invoke_overflow_cb(timcapp);
 }
 
+#if (TIMCAP_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared streaming DMA service routine.
+ *
+ * @param[in] timcapp      pointer to the @p TIMCAPDriver object
+ * @param[in] flags        pre-shifted content of the ISR register
+ */
+static void timcap_lld_serve_dma_interrupt(TIMCAPDriver *timcapp,
+                                           uint32_t flags) {
+  size_t half = timcapp->stream_n / 2U;
+
+  /* DMA errors handling.*/
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0U) {
+    STM32_TIMCAP_DMA_ERROR_HOOK(timcapp);
+    return;
+  }
+
+  /* First half filled, the DMA is now writing the second one.*/
+  if ((flags & STM32_DMA_ISR_HTIF) != 0U) {
+    _timcap_isr_invoke_stream_cb(timcapp, &timcapp->stream_buf[0], half);
+  }
+
+  /* Second half filled, the DMA wrapped to the first one.*/
+  if ((flags & STM32_DMA_ISR_TCIF) != 0U) {
+    _timcap_isr_invoke_stream_cb(timcapp, &timcapp->stream_buf[half], half);
+  }
+}
+#endif /* TIMCAP_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -636,7 +665,8 @@ void timcap_lld_start(TIMCAPDriver *timcapp) {
     /* The CCER settings depend on the selected trigger mode.
        TIMCAP_INPUT_DISABLED: Input not used.
        TIMCAP_INPUT_ACTIVE_HIGH: Active on rising edge, idle on falling edge.
-       TIMCAP_INPUT_ACTIVE_LOW:  Active on falling edge, idle on rising edge.*/
+       TIMCAP_INPUT_ACTIVE_LOW:  Active on falling edge, idle on rising edge.
+       TIMCAP_INPUT_BOTH_EDGES:  Active on both edges.*/
     if (timcapp->config->modes[chan] == TIMCAP_INPUT_ACTIVE_HIGH) {
       switch (chan) {
         case TIMCAP_CHANNEL_1:
@@ -669,6 +699,10 @@ void timcap_lld_start(TIMCAPDriver *timcapp) {
           break;
       }
     }
+    else if (timcapp->config->modes[chan] == TIMCAP_INPUT_BOTH_EDGES) {
+      timcapp->tim->CCER |= (STM32_TIM_CCER_CC1E | STM32_TIM_CCER_CC1P |
+                             STM32_TIM_CCER_CC1NP) << (chan * 4U);
+    }
     else {
       switch (chan) {
         case TIMCAP_CHANNEL_1:
@@ -692,6 +726,10 @@ void timcap_lld_start(TIMCAPDriver *timcapp) {
 
   /* SMCR_TS  = 101, input is TI1FP1.*/
   timcapp->tim->SMCR  = STM32_TIM_SMCR_TS(5);
+
+#if TIMCAP_USE_DMA == TRUE
+  timcapp->dma = NULL;
+#endif
 }
 
 /**
@@ -812,6 +850,106 @@ void timcap_lld_disable(TIMCAPDriver *timcapp) {
   timcapp->tim->DIER &= ~STM32_TIM_DIER_IRQ_MASK;
 }
 
+#if (TIMCAP_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts streaming the captures of a channel.
+ * @details The channel is configured as input capture on its own input
+ *          using the polarity in @p modes, the capture request moves the
+ *          capture register into the circular buffer. Only the overflow
+ *          interrupt is kept enabled.
+ *
+ * @param[in] timcapp      pointer to the @p TIMCAPDriver object
+ * @param[in] channel      channel to be streamed
+ * @param[out] buf         pointer to the circular buffer
+ * @param[in] n            number of samples in the buffer
+ *
+ * @notapi
+ */
+void timcap_lld_start_stream(TIMCAPDriver *timcapp, timcapchannel_t channel,
+                             timcapsample_t *buf, size_t n) {
+  const TIMCAPConfig *config = timcapp->config;
+  timcapmode_t mode = config->modes[channel];
+  uint32_t ccer, mode_bits;
+
+  osalDbgCheck((channel <= timcap_get_max_timer_channel(timcapp)) &&
+               (n <= 0xFFFFU));
+  osalDbgAssert(mode != TIMCAP_INPUT_DISABLED, "channel disabled");
+
+  timcapp->dma = dmaStreamAllocI(config->dma_stream,
+                                 STM32_TIMCAP_DMA_IRQ_PRIORITY,
+                                 (stm32_dmaisr_t)timcap_lld_serve_dma_interrupt,
+                                 (void *)timcapp);
+  osalDbgAssert(timcapp->dma != NULL, "unable to allocate stream");
+
+  timcapp->stream_channel = channel;
+  timcapp->stream_buf     = buf;
+  timcapp->stream_n       = n;
+
+  /* Circular word transfers from the capture register, the half and full
+     transfer interrupts split the buffer in two halves.*/
+  mode_bits = STM32_DMA_CR_PL(STM32_TIMCAP_DMA_PRIORITY) |
+              STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC |
+              STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+              STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE |
+              STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+#if STM32_DMA_SUPPORTS_DMAMUX
+  dmaSetRequestSource(timcapp->dma, config->dma_request);
+#else
+  mode_bits |= STM32_DMA_CR_CHSEL(config->dma_request);
+#endif
+  dmaStreamSetPeripheral(timcapp->dma, &timcapp->tim->CCR[channel]);
+  dmaStreamSetMemory0(timcapp->dma, buf);
+  dmaStreamSetTransactionSize(timcapp->dma, n);
+  dmaStreamSetMode(timcapp->dma, mode_bits);
+
+  /* Channel as input capture on its own TI, it could have been left
+     unconfigured by timcap_lld_start() if it has no capture callback.*/
+  if (channel <= TIMCAP_CHANNEL_2)
+    timcapp->tim->CCMR1 |= STM32_TIM_CCMR1_CC1S(1) << (channel * 8U);
+  else
+    timcapp->tim->CCMR2 |= STM32_TIM_CCMR2_CC3S(1) << ((channel - 2U) * 8U);
+  ccer = STM32_TIM_CCER_CC1E;
+  if (mode == TIMCAP_INPUT_ACTIVE_LOW)
+    ccer |= STM32_TIM_CCER_CC1P;
+  else if (mode == TIMCAP_INPUT_BOTH_EDGES)
+    ccer |= STM32_TIM_CCER_CC1P | STM32_TIM_CCER_CC1NP;
+  timcapp->tim->CCER = (timcapp->tim->CCER & ~(0xFU << (channel * 4U))) |
+                       (ccer << (channel * 4U));
+  timcapp->ccr_p[channel] = &timcapp->tim->CCR[channel];
+
+  timcapp->tim->EGR |= STM32_TIM_EGR_UG;
+  timcapp->tim->SR = 0;                        /* Clear pending IRQs (if any). */
+  dmaStreamEnable(timcapp->dma);
+
+  /* Capture requests go to the DMA, no per-edge interrupts.*/
+  timcapp->tim->DIER = (timcapp->tim->DIER & ~STM32_TIM_DIER_IRQ_MASK) |
+                       (STM32_TIM_DIER_CC1DE << channel);
+  if (config->overflow_cb != NULL)
+    timcapp->tim->DIER |= STM32_TIM_DIER_UIE;
+
+  timcapp->tim->CR1 = STM32_TIM_CR1_URS | STM32_TIM_CR1_CEN | config->cr1;
+}
+
+/**
+ * @brief   Stops streaming.
+ *
+ * @param[in] timcapp      pointer to the @p TIMCAPDriver object
+ *
+ * @notapi
+ */
+void timcap_lld_stop_stream(TIMCAPDriver *timcapp) {
+
+  timcapp->tim->CR1   = 0;                     /* Timer stopped.               */
+  timcapp->tim->DIER &= ~(STM32_TIM_DIER_IRQ_MASK |
+                          (STM32_TIM_DIER_CC1DE << timcapp->stream_channel));
+  timcapp->tim->SR    = 0;                     /* Clear pending IRQs (if any). */
+
+  dmaStreamDisable(timcapp->dma);
+  dmaStreamFreeI(timcapp->dma);
+  timcapp->dma = NULL;
+}
+#endif /* TIMCAP_USE_DMA == TRUE */
+
 #endif /* HAL_USE_TIMCAP */
 
 /** @} */
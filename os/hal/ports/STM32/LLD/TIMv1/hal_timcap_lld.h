@@ -154,6 +154,29 @@
 #if !defined(STM32_TIMCAP_TIM9_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_TIMCAP_TIM9_IRQ_PRIORITY         7
 #endif
+
+/**
+ * @brief   Streaming DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_TIMCAP_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_TIMCAP_DMA_PRIORITY              2
+#endif
+
+/**
+ * @brief   Streaming DMA interrupt priority level setting.
+ */
+#if !defined(STM32_TIMCAP_DMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_TIMCAP_DMA_IRQ_PRIORITY          7
+#endif
+
+/**
+ * @brief   Streaming DMA error hook.
+ * @note    The default action for DMA errors is a system halt because DMA
+ *          error can only happen because programming errors.
+ */
+#if !defined(STM32_TIMCAP_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_TIMCAP_DMA_ERROR_HOOK(timcapp)   osalSysHalt("DMA failure")
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -230,6 +253,20 @@
 #error "Invalid IRQ priority assigned to TIM9"
 #endif
 
+#if TIMCAP_USE_DMA == TRUE
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_TIMCAP_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to TIMCAP"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_TIMCAP_DMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to TIMCAP DMA"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* TIMCAP_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -241,6 +278,8 @@ typedef enum {
   TIMCAP_INPUT_DISABLED = 0,
   TIMCAP_INPUT_ACTIVE_HIGH = 1,        /**< Trigger on rising edge.            */
   TIMCAP_INPUT_ACTIVE_LOW = 2,         /**< Trigger on falling edge.           */
+  TIMCAP_INPUT_BOTH_EDGES = 3,         /**< Trigger on both edges, not
+                                            supported by STM32F1 timers.      */
 } timcapmode_t;
 
 /**
@@ -285,6 +324,13 @@ typedef struct {
    */
   timcapcallback_t             overflow_cb;
 
+#if (TIMCAP_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Callback for each filled half of the stream buffer.
+   */
+  timcapstreamcb_t             stream_cb;
+#endif
+
   /* End of the mandatory fields.*/
 
   /**
@@ -299,6 +345,24 @@ typedef struct {
    * @note  The value of this field should normally be equal to zero.
    */
   uint32_t                  cr1;
+
+#if (TIMCAP_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief DMA stream used for streaming.
+   * @note  The stream must be able to serve the capture request of the
+   *        streamed channel, @p STM32_DMA_STREAM_ID_ANY can be used on
+   *        devices with a DMAMUX.
+   */
+  uint32_t                  dma_stream;
+
+  /**
+   * @brief DMA request of the streamed channel.
+   * @note  This is the channel selection on devices with fixed DMA
+   *        mapping or the DMAMUX request on devices with a DMAMUX,
+   *        for example @p STM32_DMAMUX1_TIM2_CH1.
+   */
+  uint32_t                  dma_request;
+#endif
 } TIMCAPConfig;
 
 /**
@@ -329,6 +393,24 @@ struct TIMCAPDriver {
    * @brief CCR register used for capture.
    */
   volatile uint32_t         *ccr_p[4];
+#if (TIMCAP_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief DMA stream, @p NULL when not streaming.
+   */
+  const stm32_dma_stream_t  *dma;
+  /**
+   * @brief Streamed channel.
+   */
+  timcapchannel_t           stream_channel;
+  /**
+   * @brief Stream buffer.
+   */
+  timcapsample_t            *stream_buf;
+  /**
+   * @brief Number of samples in the stream buffer.
+   */
+  size_t                    stream_n;
+#endif
 };
 
 /*===========================================================================*/
@@ -378,6 +460,11 @@ extern "C" {
   void timcap_lld_stop(TIMCAPDriver *timcapp);
   void timcap_lld_enable(TIMCAPDriver *timcapp);
   void timcap_lld_disable(TIMCAPDriver *timcapp);
+#if TIMCAP_USE_DMA == TRUE
+  void timcap_lld_start_stream(TIMCAPDriver *timcapp, timcapchannel_t channel,
+                               timcapsample_t *buf, size_t n);
+  void timcap_lld_stop_stream(TIMCAPDriver *timcapp);
+#endif
 #ifdef __cplusplus
 }
 #endif
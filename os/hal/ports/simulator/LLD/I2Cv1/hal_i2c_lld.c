@@ -0,0 +1,287 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/I2Cv1/hal_i2c_lld.c
+ * @brief   Simulator I2C subsystem low level driver source.
+ *
+ * @addtogroup I2C
+ * @{
+ */
+
+#include "hal.h"
+
+#if HAL_USE_I2C || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Bit times of one byte plus its acknowledge.
+ */
+#define I2C_BYTE_BITS               9U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   I2C1 driver identifier.
+ */
+#if SIM_I2C_USE_I2C1 || defined(__DOXYGEN__)
+I2CDriver I2CD1;
+#endif
+
+/**
+ * @brief   I2C2 driver identifier.
+ */
+#if SIM_I2C_USE_I2C2 || defined(__DOXYGEN__)
+I2CDriver I2CD2;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Looks up the device answering to an address.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave address
+ * @return              The device model or @p NULL if nobody answers.
+ *
+ * @notapi
+ */
+static sim_i2c_device_t *i2c_lld_find(I2CDriver *i2cp, i2caddr_t addr) {
+  sim_i2c_device_t *devp;
+
+  for (devp = i2cp->devices; devp != NULL; devp = devp->next) {
+    if (devp->addr == addr) {
+      break;
+    }
+  }
+  return devp;
+}
+
+/**
+ * @brief   Runs a complete bus transaction against the device models.
+ * @details The transaction is START, address, @p txbytes writes, an
+ *          optional repeated START followed by @p rxbytes reads, and STOP.
+ *          A NACK in any phase aborts the transaction like a real master
+ *          would.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave address
+ * @param[in] txbuf     pointer to the transmit buffer
+ * @param[in] txbytes   number of bytes to be transmitted
+ * @param[out] rxbuf    pointer to the receive buffer
+ * @param[in] rxbytes   number of bytes to be received
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static msg_t i2c_lld_transfer(I2CDriver *i2cp, i2caddr_t addr,
+                              const uint8_t *txbuf, size_t txbytes,
+                              uint8_t *rxbuf, size_t rxbytes) {
+  sim_i2c_device_t *devp = i2c_lld_find(i2cp, addr);
+  uint32_t bits = 2U;               /* START and STOP.*/
+  uint32_t moved = 0U;
+  msg_t msg = MSG_OK;
+  size_t i;
+
+  i2cp->errors = I2C_NO_ERROR;
+
+  /* Write phase, skipped by pure reads.*/
+  if (txbytes > 0U) {
+    bits += I2C_BYTE_BITS;
+    if ((devp == NULL) || !devp->start(devp, false)) {
+      msg = MSG_RESET;
+    }
+    for (i = 0U; (msg == MSG_OK) && (i < txbytes); i++) {
+      bits += I2C_BYTE_BITS;
+      if (!devp->write(devp, txbuf[i])) {
+        msg = MSG_RESET;
+      }
+      else {
+        moved++;
+      }
+    }
+    if ((msg == MSG_OK) && (rxbytes > 0U)) {
+      bits += 1U;                   /* Repeated START.*/
+    }
+  }
+
+  /* Read phase.*/
+  if ((msg == MSG_OK) && (rxbytes > 0U)) {
+    bits += I2C_BYTE_BITS;
+    if ((devp == NULL) || !devp->start(devp, true)) {
+      msg = MSG_RESET;
+    }
+    for (i = 0U; (msg == MSG_OK) && (i < rxbytes); i++) {
+      bits += I2C_BYTE_BITS;
+      rxbuf[i] = devp->read(devp);
+      moved++;
+    }
+  }
+
+  if (devp != NULL) {
+    devp->stop(devp);
+  }
+
+  if (msg != MSG_OK) {
+    i2cp->errors |= I2C_ACK_FAILURE;
+    i2cp->stats.busy++;
+  }
+  simStatsAccount(&i2cp->stats, moved,
+                  simTimeBits(bits, i2cp->config->clock_speed));
+
+  return msg;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level I2C driver initialization.
+ *
+ * @notapi
+ */
+void i2c_lld_init(void) {
+
+#if SIM_I2C_USE_I2C1
+  i2cObjectInit(&I2CD1);
+  I2CD1.devices = NULL;
+#endif
+
+#if SIM_I2C_USE_I2C2
+  i2cObjectInit(&I2CD2);
+  I2CD2.devices = NULL;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the I2C peripheral.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+void i2c_lld_start(I2CDriver *i2cp) {
+
+  osalDbgCheck(i2cp->config->clock_speed > 0U);
+
+  if (i2cp->state == I2C_STOP) {
+    i2cp->stats = (sim_stats_t){0};
+  }
+}
+
+/**
+ * @brief   Deactivates the I2C peripheral.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+void i2c_lld_stop(I2CDriver *i2cp) {
+
+  (void)i2cp;
+}
+
+/**
+ * @brief   Receives data via the I2C bus as master.
+ * @note    The transfer completes synchronously, @p timeout is never hit.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave device address
+ * @param[out] rxbuf    pointer to the receive buffer
+ * @param[in] rxbytes   number of bytes to be received
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if the device did not acknowledge.
+ *
+ * @notapi
+ */
+msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
+                                     uint8_t *rxbuf, size_t rxbytes,
+                                     sysinterval_t timeout) {
+
+  (void)timeout;
+
+  return i2c_lld_transfer(i2cp, addr, NULL, 0U, rxbuf, rxbytes);
+}
+
+/**
+ * @brief   Transmits data via the I2C bus as master.
+ * @note    The transfer completes synchronously, @p timeout is never hit.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] addr      slave device address
+ * @param[in] txbuf     pointer to the transmit buffer
+ * @param[in] txbytes   number of bytes to be transmitted
+ * @param[out] rxbuf    pointer to the receive buffer
+ * @param[in] rxbytes   number of bytes to be received
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if the device did not acknowledge.
+ *
+ * @notapi
+ */
+msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
+                                      const uint8_t *txbuf, size_t txbytes,
+                                      uint8_t *rxbuf, size_t rxbytes,
+                                      sysinterval_t timeout) {
+
+  (void)timeout;
+
+  return i2c_lld_transfer(i2cp, addr, txbuf, txbytes, rxbuf, rxbytes);
+}
+
+/**
+ * @brief   Attaches a device model to a simulated bus.
+ * @note    Must be called before the first transfer involving the device.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] devp      pointer to the device model
+ *
+ * @api
+ */
+void simI2cAttach(I2CDriver *i2cp, sim_i2c_device_t *devp) {
+
+  osalDbgCheck((devp != NULL) && (devp->start != NULL) &&
+               (devp->write != NULL) && (devp->read != NULL) &&
+               (devp->stop != NULL));
+
+  osalSysLock();
+  devp->next    = i2cp->devices;
+  i2cp->devices = devp;
+  osalSysUnlock();
+}
+
+#endif /* HAL_USE_I2C */
+
+/** @} */
@@ -0,0 +1,225 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/I2Cv1/hal_i2c_lld.h
+ * @brief   Simulator I2C subsystem low level driver header.
+ * @details The bus is populated by software device models attached with
+ *          @p simI2cAttach(). Transfers complete synchronously and advance
+ *          the virtual clock by the time the real bus would need.
+ *
+ * @addtogroup I2C
+ * @{
+ */
+
+#ifndef HAL_I2C_LLD_H
+#define HAL_I2C_LLD_H
+
+#if HAL_USE_I2C || defined(__DOXYGEN__)
+
+#include "sim_timing.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   I2C1 driver enable switch.
+ * @details If set to @p TRUE the support for I2C1 is included.
+ * @note    The default is @p TRUE.
+ */
+#if !defined(SIM_I2C_USE_I2C1) || defined(__DOXYGEN__)
+#define SIM_I2C_USE_I2C1                    TRUE
+#endif
+
+/**
+ * @brief   I2C2 driver enable switch.
+ * @details If set to @p TRUE the support for I2C2 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(SIM_I2C_USE_I2C2) || defined(__DOXYGEN__)
+#define SIM_I2C_USE_I2C2                    FALSE
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !SIM_I2C_USE_I2C1 && !SIM_I2C_USE_I2C2
+#error "I2C driver activated but no I2C peripheral assigned"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type representing an I2C address.
+ */
+typedef uint16_t i2caddr_t;
+
+/**
+ * @brief   Type of I2C driver condition flags.
+ */
+typedef uint32_t i2cflags_t;
+
+/**
+ * @brief   Type of a simulated I2C device.
+ */
+typedef struct sim_i2c_device sim_i2c_device_t;
+
+/**
+ * @brief   Simulated I2C device model.
+ * @details Models are byte oriented: the driver addresses the device, then
+ *          pushes or pulls one byte at a time and finally signals the STOP
+ *          condition. Returning @p false from @p start or @p write makes
+ *          the device NACK the byte.
+ */
+struct sim_i2c_device {
+  /**
+   * @brief   Next device on the same bus.
+   */
+  sim_i2c_device_t          *next;
+  /**
+   * @brief   7 bits slave address.
+   */
+  i2caddr_t                 addr;
+  /**
+   * @brief   Address phase, @p read is the R/W bit.
+   */
+  bool                      (*start)(sim_i2c_device_t *devp, bool read);
+  /**
+   * @brief   Byte written by the master.
+   */
+  bool                      (*write)(sim_i2c_device_t *devp, uint8_t b);
+  /**
+   * @brief   Byte requested by the master.
+   */
+  uint8_t                   (*read)(sim_i2c_device_t *devp);
+  /**
+   * @brief   STOP condition.
+   */
+  void                      (*stop)(sim_i2c_device_t *devp);
+};
+
+/**
+ * @brief   Type of I2C driver configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Simulated SCL frequency in Hz.
+   */
+  uint32_t                  clock_speed;
+} I2CConfig;
+
+/**
+ * @brief   Type of a structure representing an I2C driver.
+ */
+typedef struct I2CDriver I2CDriver;
+
+/**
+ * @brief   Structure representing an I2C driver.
+ */
+struct I2CDriver {
+  /**
+   * @brief   Driver state.
+   */
+  i2cstate_t                state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const I2CConfig           *config;
+  /**
+   * @brief   Error flags.
+   */
+  i2cflags_t                errors;
+#if I2C_USE_MUTUAL_EXCLUSION || defined(__DOXYGEN__)
+  /**
+   * @brief   Mutex protecting the bus.
+   */
+  mutex_t                   mutex;
+#endif /* I2C_USE_MUTUAL_EXCLUSION */
+#if defined(I2C_DRIVER_EXT_FIELDS)
+  I2C_DRIVER_EXT_FIELDS
+#endif
+  /* End of the mandatory fields.*/
+  /**
+   * @brief   Devices attached to the bus.
+   */
+  sim_i2c_device_t          *devices;
+  /**
+   * @brief   Bus statistics.
+   */
+  sim_stats_t               stats;
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Get errors from I2C driver.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+#define i2c_lld_get_errors(i2cp) ((i2cp)->errors)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if SIM_I2C_USE_I2C1 && !defined(__DOXYGEN__)
+extern I2CDriver I2CD1;
+#endif
+
+#if SIM_I2C_USE_I2C2 && !defined(__DOXYGEN__)
+extern I2CDriver I2CD2;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void i2c_lld_init(void);
+  void i2c_lld_start(I2CDriver *i2cp);
+  void i2c_lld_stop(I2CDriver *i2cp);
+  msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
+                                        const uint8_t *txbuf, size_t txbytes,
+                                        uint8_t *rxbuf, size_t rxbytes,
+                                        sysinterval_t timeout);
+  msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
+                                       uint8_t *rxbuf, size_t rxbytes,
+                                       sysinterval_t timeout);
+  void simI2cAttach(I2CDriver *i2cp, sim_i2c_device_t *devp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_I2C */
+
+#endif /* HAL_I2C_LLD_H */
+
+/** @} */
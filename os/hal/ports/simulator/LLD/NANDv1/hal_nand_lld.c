@@ -0,0 +1,473 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/NANDv1/hal_nand_lld.c
+ * @brief   Simulator NAND driver subsystem low level driver source.
+ *
+ * @addtogroup NAND
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if (HAL_USE_NAND == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Status register value of a successful operation.
+ */
+#define NAND_STATUS_OK      (SIM_NAND_STATUS_READY | SIM_NAND_STATUS_NOT_WP)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   NAND1 driver identifier.
+ */
+#if SIM_NAND_USE_NAND1 || defined(__DOXYGEN__)
+NANDDriver NANDD1;
+#endif
+
+/*===========================================================================*/
+/* Driver local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Full page size including the spare area.
+ *
+ * @notapi
+ */
+static size_t page_size(const NANDConfig *cfg) {
+
+  return cfg->page_data_size + cfg->page_spare_size;
+}
+
+/**
+ * @brief   Decodes a column and row address.
+ * @details Column bytes come first, least significant first, followed by
+ *          the row bytes, see @p calc_addr() in the high level driver.
+ *
+ * @param[in] nandp     pointer to the @p NANDDriver object
+ * @param[in] addr      address cycles
+ * @param[in] addrlen   number of address cycles
+ * @param[out] row      decoded page number
+ * @return              The decoded column.
+ *
+ * @notapi
+ */
+static uint32_t decode_addr(NANDDriver *nandp, const uint8_t *addr,
+                            size_t addrlen, uint32_t *row) {
+  const NANDConfig *cfg = nandp->config;
+  uint32_t col = 0U;
+  size_t i;
+
+  osalDbgCheck(addrlen == (size_t)(cfg->colcycles + cfg->rowcycles));
+
+  for (i = 0U; i < cfg->colcycles; i++) {
+    col |= (uint32_t)addr[i] << (8U * i);
+  }
+  *row = 0U;
+  for (i = 0U; i < cfg->rowcycles; i++) {
+    *row |= (uint32_t)addr[cfg->colcycles + i] << (8U * i);
+  }
+
+  osalDbgCheck(*row < cfg->blocks * cfg->pages_per_block);
+  return col;
+}
+
+/**
+ * @brief   Tells whether a block is in the factory bad list.
+ *
+ * @notapi
+ */
+static bool is_factory_bad(const NANDConfig *cfg, uint32_t block) {
+  size_t i;
+
+  for (i = 0U; i < cfg->bad_blocks_num; i++) {
+    if (cfg->bad_blocks[i] == block) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief   Tells whether a program or erase on a block has to fail.
+ * @note    An injected failure is consumed by this call.
+ *
+ * @notapi
+ */
+static bool must_fail(NANDDriver *nandp, uint32_t block) {
+
+  if (nandp->fail_block == (int32_t)block) {
+    nandp->fail_block = -1;
+    return true;
+  }
+  return is_factory_bad(nandp->config, block);
+}
+
+/**
+ * @brief   Column parity code of a buffer.
+ * @details Byte parity XOR'ed with the index of every odd parity byte,
+ *          which locates any single flipped bit like the FSMC hamming code
+ *          does. The layout is not bit compatible with the FSMC ECCR.
+ *
+ * @notapi
+ */
+static uint32_t calc_ecc(const uint8_t *p, size_t n) {
+  uint32_t x = 0U, pos = 0U;
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    uint8_t b = p[i];
+
+    x ^= b;
+    b ^= b >> 4;
+    b ^= b >> 2;
+    b ^= b >> 1;
+    if ((b & 1U) != 0U) {
+      pos ^= (uint32_t)i;
+    }
+  }
+  return (pos << 8) | x;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level NAND driver initialization.
+ *
+ * @notapi
+ */
+void nand_lld_init(void) {
+
+#if SIM_NAND_USE_NAND1
+  nandObjectInit(&NANDD1);
+  NANDD1.bb_map     = NULL;
+  NANDD1.fail_block = -1;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the NAND peripheral.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ *
+ * @notapi
+ */
+void nand_lld_start(NANDDriver *nandp) {
+
+  osalDbgCheck(nandp->config->array != NULL);
+  osalDbgCheck((nandp->config->dies == 1U) &&
+               (nandp->config->loguns == 1U) &&
+               (nandp->config->planes == 1U));
+
+  if (nandp->state == NAND_STOP) {
+    nandp->stats  = (sim_stats_t){0};
+    nandp->status = NAND_STATUS_OK;
+  }
+}
+
+/**
+ * @brief   Deactivates the NAND peripheral.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ *
+ * @notapi
+ */
+void nand_lld_stop(NANDDriver *nandp) {
+
+  (void)nandp;
+}
+
+/**
+ * @brief   Read data from NAND.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[out] data         pointer to data buffer
+ * @param[in] datalen       size of data buffer in bytes
+ * @param[in] addr          pointer to address buffer
+ * @param[in] addrlen       length of address
+ * @param[out] ecc          pointer to store computed ECC. Ignored when NULL.
+ *
+ * @notapi
+ */
+void nand_lld_read_data(NANDDriver *nandp, uint16_t *data, size_t datalen,
+                        uint8_t *addr, size_t addrlen, uint32_t *ecc) {
+  const NANDConfig *cfg = nandp->config;
+  uint32_t row, col;
+
+  nandp->state = NAND_READ;
+  col = decode_addr(nandp, addr, addrlen, &row);
+  osalDbgCheck(col + datalen <= page_size(cfg));
+
+  memcpy(data, &cfg->array[(row * page_size(cfg)) + col], datalen);
+  if (NULL != ecc) {
+    *ecc = calc_ecc((const uint8_t *)data, datalen);
+  }
+
+  simStatsAccount(&nandp->stats, (uint32_t)datalen,
+                  cfg->t_read + (cfg->t_cycle * (addrlen + 2U + datalen)));
+  nandp->state = NAND_READY;
+}
+
+/**
+ * @brief   Write data to NAND.
+ * @note    Like the real array, programming can only clear bits.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] data          buffer with data to be written
+ * @param[in] datalen       size of data buffer in bytes
+ * @param[in] addr          pointer to address buffer
+ * @param[in] addrlen       length of address
+ * @param[out] ecc          pointer to store computed ECC. Ignored when NULL.
+ *
+ * @return    The operation status reported by NAND IC (0x70 command).
+ *
+ * @notapi
+ */
+uint8_t nand_lld_write_data(NANDDriver *nandp, const uint16_t *data,
+                size_t datalen, uint8_t *addr, size_t addrlen, uint32_t *ecc) {
+  const NANDConfig *cfg = nandp->config;
+  const uint8_t *src = (const uint8_t *)data;
+  uint32_t row, col;
+  uint8_t *dst;
+  size_t i;
+
+  nandp->state = NAND_WRITE;
+  col = decode_addr(nandp, addr, addrlen, &row);
+  osalDbgCheck(col + datalen <= page_size(cfg));
+
+  if (NULL != ecc) {
+    *ecc = calc_ecc(src, datalen);
+  }
+
+  if (must_fail(nandp, row / cfg->pages_per_block)) {
+    nandp->status = NAND_STATUS_OK | SIM_NAND_STATUS_FAIL;
+  }
+  else {
+    dst = &cfg->array[(row * page_size(cfg)) + col];
+    for (i = 0U; i < datalen; i++) {
+      dst[i] &= src[i];
+    }
+    nandp->status = NAND_STATUS_OK;
+  }
+
+  simStatsAccount(&nandp->stats, (uint32_t)datalen,
+                  cfg->t_prog + (cfg->t_cycle * (addrlen + 2U + datalen)));
+  nandp->state = NAND_READY;
+
+  return nand_lld_read_status(nandp);
+}
+
+/**
+ * @brief   Soft reset NAND device.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ *
+ * @notapi
+ */
+void nand_lld_reset(NANDDriver *nandp) {
+
+  nandp->state = NAND_RESET;
+  nand_lld_write_cmd(nandp, NAND_CMD_RESET);
+  nandp->status = NAND_STATUS_OK;
+  nandp->state = NAND_READY;
+}
+
+/**
+ * @brief   Erase block.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] addr          pointer to address buffer
+ * @param[in] addrlen       length of address
+ *
+ * @return    The operation status reported by NAND IC (0x70 command).
+ *
+ * @notapi
+ */
+uint8_t nand_lld_erase(NANDDriver *nandp, uint8_t *addr, size_t addrlen) {
+  const NANDConfig *cfg = nandp->config;
+  size_t blksize = page_size(cfg) * cfg->pages_per_block;
+  uint32_t row = 0U, block;
+  size_t i;
+
+  nandp->state = NAND_ERASE;
+
+  osalDbgCheck(addrlen == cfg->rowcycles);
+  for (i = 0U; i < addrlen; i++) {
+    row |= (uint32_t)addr[i] << (8U * i);
+  }
+  block = row / cfg->pages_per_block;
+  osalDbgCheck(block < cfg->blocks);
+
+  if (must_fail(nandp, block)) {
+    nandp->status = NAND_STATUS_OK | SIM_NAND_STATUS_FAIL;
+  }
+  else {
+    memset(&cfg->array[block * blksize], 0xFF, blksize);
+    if (cfg->erase_counts != NULL) {
+      cfg->erase_counts[block]++;
+    }
+    nandp->status = NAND_STATUS_OK;
+  }
+
+  simStatsAccount(&nandp->stats, 0U,
+                  cfg->t_erase + (cfg->t_cycle * (addrlen + 2U)));
+  nandp->state = NAND_READY;
+
+  return nand_lld_read_status(nandp);
+}
+
+/**
+ * @brief   Send address to NAND.
+ * @note    The simulated device decodes addresses per operation, the
+ *          cycles are only accounted.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] len           length of address array
+ * @param[in] addr          pointer to address array
+ *
+ * @notapi
+ */
+void nand_lld_write_addr(NANDDriver *nandp, const uint8_t *addr, size_t len) {
+
+  (void)addr;
+  simTimeAdvance(nandp->config->t_cycle * len);
+}
+
+/**
+ * @brief   Send command to NAND.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] cmd           command value
+ *
+ * @notapi
+ */
+void nand_lld_write_cmd(NANDDriver *nandp, uint8_t cmd) {
+
+  nandp->cmd = cmd;
+  simTimeAdvance(nandp->config->t_cycle);
+}
+
+/**
+ * @brief   Read status byte from NAND.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ *
+ * @return    Status byte.
+ *
+ * @notapi
+ */
+uint8_t nand_lld_read_status(NANDDriver *nandp) {
+
+  nand_lld_write_cmd(nandp, NAND_CMD_STATUS);
+  simTimeAdvance(nandp->config->t_cycle);
+
+  return nandp->status;
+}
+
+/**
+ * @brief   Read ID of the nand flash
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ *
+ * @return    4 bytes ID of the nandflash
+ *
+ * @notapi
+ */
+uint32_t nand_lld_read_id(NANDDriver *nandp) {
+
+  nand_lld_write_cmd(nandp, NAND_CMD_READID);
+  simTimeAdvance(nandp->config->t_cycle * 5U);
+
+  return nandp->config->id;
+}
+
+/**
+ * @brief   Puts the memory array in its factory state.
+ * @details Every block is erased, then the bad block mark of the first two
+ *          pages of each factory bad block is cleared. Erase counters are
+ *          zeroed.
+ * @note    Call it before @p nandStart(), the high level driver scans the
+ *          bad block marks on start.
+ *
+ * @param[in] config        pointer to the @p NANDConfig to be formatted
+ *
+ * @api
+ */
+void simNandFormat(const NANDConfig *config) {
+  size_t psize = page_size(config);
+  size_t i;
+
+  memset(config->array, 0xFF,
+         psize * config->pages_per_block * config->blocks);
+
+  for (i = 0U; i < config->bad_blocks_num; i++) {
+    uint8_t *blk = &config->array[config->bad_blocks[i] *
+                                  config->pages_per_block * psize];
+
+    osalDbgCheck(config->bad_blocks[i] < config->blocks);
+    memset(&blk[config->page_data_size], 0x00, 2U);
+    memset(&blk[psize + config->page_data_size], 0x00, 2U);
+  }
+
+  if (config->erase_counts != NULL) {
+    memset(config->erase_counts, 0, config->blocks * sizeof (uint32_t));
+  }
+}
+
+/**
+ * @brief   Makes the next program or erase of a block fail.
+ * @details Simulates a block going bad in the field so the bad block
+ *          handling of the upper layers can be exercised.
+ *
+ * @param[in] nandp         pointer to the @p NANDDriver object
+ * @param[in] block         block number
+ *
+ * @api
+ */
+void simNandInjectFailure(NANDDriver *nandp, uint32_t block) {
+
+  osalSysLock();
+  nandp->fail_block = (int32_t)block;
+  osalSysUnlock();
+}
+
+#endif /* HAL_USE_NAND */
+
+/** @} */
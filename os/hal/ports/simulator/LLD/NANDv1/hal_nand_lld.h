@@ -0,0 +1,253 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/NANDv1/hal_nand_lld.h
+ * @brief   Simulator NAND driver subsystem low level driver header.
+ * @details The memory array is a RAM buffer provided by the configuration.
+ *          Programming can only clear bits, erasing sets a whole block to
+ *          0xFF, factory bad blocks carry a zeroed bad block mark and any
+ *          program or erase on them reports a failure status. Array and
+ *          bus timings advance the virtual clock.
+ *
+ * @addtogroup NAND
+ * @{
+ */
+
+#ifndef HAL_NAND_LLD_H
+#define HAL_NAND_LLD_H
+
+#if (HAL_USE_NAND == TRUE) || defined(__DOXYGEN__)
+
+#include "sim_timing.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+#define NAND_MIN_PAGE_SIZE       256
+#define NAND_MAX_PAGE_SIZE       8192
+
+/**
+ * @name    Status register bits
+ * @{
+ */
+#define SIM_NAND_STATUS_FAIL     0x01U
+#define SIM_NAND_STATUS_READY    0x40U
+#define SIM_NAND_STATUS_NOT_WP   0x80U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   NAND driver enable switch.
+ * @details If set to @p TRUE the support for NAND1 is included.
+ */
+#if !defined(SIM_NAND_USE_NAND1) || defined(__DOXYGEN__)
+#define SIM_NAND_USE_NAND1                TRUE
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !SIM_NAND_USE_NAND1
+#error "NAND driver activated but no NAND peripheral assigned"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a structure representing an NAND driver.
+ */
+typedef struct NANDDriver NANDDriver;
+
+/**
+ * @brief   Driver configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Number of dies in NAND device.
+   */
+  uint32_t                  dies;
+  /**
+   * @brief   Number of logical units in NAND device.
+   */
+  uint32_t                  loguns;
+  /**
+   * @brief   Number of planes in NAND device.
+   */
+  uint32_t                  planes;
+  /**
+   * @brief   Number of erase blocks in NAND device.
+   */
+  uint32_t                  blocks;
+  /**
+   * @brief   Number of data bytes in page.
+   */
+  uint32_t                  page_data_size;
+  /**
+   * @brief   Number of spare bytes in page.
+   */
+  uint32_t                  page_spare_size;
+  /**
+   * @brief   Number of pages in block.
+   */
+  uint32_t                  pages_per_block;
+  /**
+   * @brief   Number of write cycles for row addressing.
+   */
+  uint8_t                   rowcycles;
+  /**
+   * @brief   Number of write cycles for column addressing.
+   */
+  uint8_t                   colcycles;
+
+  /* End of the mandatory fields.*/
+  /**
+   * @brief   Memory array storage.
+   * @details Must hold blocks * pages_per_block *
+   *          (page_data_size + page_spare_size) bytes. The contents are
+   *          preserved across starts so a test can power cycle the device.
+   */
+  uint8_t                   *array;
+  /**
+   * @brief   Factory bad blocks, marked when @p array is formatted.
+   */
+  const uint32_t            *bad_blocks;
+  /**
+   * @brief   Number of entries in @p bad_blocks.
+   */
+  size_t                    bad_blocks_num;
+  /**
+   * @brief   Per block erase counters or @p NULL.
+   */
+  uint32_t                  *erase_counts;
+  /**
+   * @brief   Value returned by the READ ID command.
+   */
+  uint32_t                  id;
+  /**
+   * @brief   Bus cycle time in nanoseconds.
+   */
+  simtime_t                 t_cycle;
+  /**
+   * @brief   Page read time (tR) in nanoseconds.
+   */
+  simtime_t                 t_read;
+  /**
+   * @brief   Page program time (tPROG) in nanoseconds.
+   */
+  simtime_t                 t_prog;
+  /**
+   * @brief   Block erase time (tBERS) in nanoseconds.
+   */
+  simtime_t                 t_erase;
+} NANDConfig;
+
+/**
+ * @brief   Structure representing an NAND driver.
+ */
+struct NANDDriver {
+  /**
+   * @brief   Driver state.
+   */
+  nandstate_t               state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const NANDConfig          *config;
+#if NAND_USE_MUTUAL_EXCLUSION || defined(__DOXYGEN__)
+#if CH_CFG_USE_MUTEXES || defined(__DOXYGEN__)
+  /**
+   * @brief   Mutex protecting the bus.
+   */
+  mutex_t                   mutex;
+#elif CH_CFG_USE_SEMAPHORES
+  semaphore_t               semaphore;
+#endif
+#endif /* NAND_USE_MUTUAL_EXCLUSION */
+  /* End of the mandatory fields.*/
+  /**
+   * @brief   Pointer to bad block map.
+   * @details One bit per block. All memory allocation is user's responsibility.
+   */
+  bitmap_t                  *bb_map;
+  /**
+   * @brief   Last latched command.
+   */
+  uint8_t                   cmd;
+  /**
+   * @brief   Status register.
+   */
+  uint8_t                   status;
+  /**
+   * @brief   Block whose next program or erase will fail, or -1.
+   */
+  int32_t                   fail_block;
+  /**
+   * @brief   Array statistics.
+   */
+  sim_stats_t               stats;
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if SIM_NAND_USE_NAND1 && !defined(__DOXYGEN__)
+extern NANDDriver NANDD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void nand_lld_init(void);
+  void nand_lld_start(NANDDriver *nandp);
+  void nand_lld_stop(NANDDriver *nandp);
+  uint8_t nand_lld_erase(NANDDriver *nandp, uint8_t *addr, size_t addrlen);
+  void nand_lld_read_data(NANDDriver *nandp, uint16_t *data,
+                size_t datalen, uint8_t *addr, size_t addrlen, uint32_t *ecc);
+  void nand_lld_write_addr(NANDDriver *nandp, const uint8_t *addr, size_t len);
+  void nand_lld_write_cmd(NANDDriver *nandp, uint8_t cmd);
+  uint8_t nand_lld_write_data(NANDDriver *nandp, const uint16_t *data,
+                size_t datalen, uint8_t *addr, size_t addrlen, uint32_t *ecc);
+  uint8_t nand_lld_read_status(NANDDriver *nandp);
+  void nand_lld_reset(NANDDriver *nandp);
+  uint32_t nand_lld_read_id(NANDDriver *nandp);
+  void simNandFormat(const NANDConfig *config);
+  void simNandInjectFailure(NANDDriver *nandp, uint32_t block);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_NAND */
+
+#endif /* HAL_NAND_LLD_H */
+
+/** @} */
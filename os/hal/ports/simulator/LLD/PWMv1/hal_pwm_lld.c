@@ -0,0 +1,303 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/PWMv1/hal_pwm_lld.c
+ * @brief   Simulator PWM subsystem low level driver source.
+ *
+ * @addtogroup PWM
+ * @{
+ */
+
+#include "hal.h"
+
+#if HAL_USE_PWM || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Notification mask bit of the periodic callback.
+ */
+#define PWM_NOTIFY_PERIODIC         ((pwmchnmsk_t)1U << PWM_CHANNELS)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   PWMD1 driver identifier.
+ */
+#if SIM_PWM_USE_PWM1 || defined(__DOXYGEN__)
+PWMDriver PWMD1;
+#endif
+
+/**
+ * @brief   PWMD2 driver identifier.
+ */
+#if SIM_PWM_USE_PWM2 || defined(__DOXYGEN__)
+PWMDriver PWMD2;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Generates one PWM cycle.
+ * @details The observer sees the compare values as programmed at cycle
+ *          start, then the compare events fire in counter order and the
+ *          counter reset event closes the cycle. Values written by the
+ *          callbacks take effect on the next cycle, like preloaded compare
+ *          registers.
+ *
+ * @param[in] vtp       pointer to the timer
+ * @param[in] p         pointer to the @p PWMDriver object
+ *
+ * @notapi
+ */
+static void pwm_lld_cycle(virtual_timer_t *vtp, void *p) {
+  PWMDriver *pwmp = (PWMDriver *)p;
+  pwmcnt_t width[PWM_CHANNELS];
+  pwmchnmsk_t fired = 0U;
+  pwmchannel_t ch;
+
+  (void)vtp;
+
+  for (ch = 0U; ch < PWM_CHANNELS; ch++) {
+    width[ch] = simPwmGetWidth(pwmp, ch);
+  }
+
+  if (pwmp->observer != NULL) {
+    pwmp->observer(pwmp, false, pwmp->observer_param);
+  }
+
+  /* Compare events, earliest first.*/
+  while (true) {
+    pwmchannel_t next = PWM_CHANNELS;
+
+    for (ch = 0U; ch < PWM_CHANNELS; ch++) {
+      if ((((pwmp->notify & ~fired) >> ch) & 1U) == 0U) {
+        continue;
+      }
+      if ((width[ch] == 0U) || (width[ch] >= pwmp->period) ||
+          (pwmp->config->channels[ch].callback == NULL)) {
+        continue;
+      }
+      if ((next == PWM_CHANNELS) || (width[ch] < width[next])) {
+        next = ch;
+      }
+    }
+    if (next == PWM_CHANNELS) {
+      break;
+    }
+    fired |= (pwmchnmsk_t)1U << next;
+    pwmp->config->channels[next].callback(pwmp);
+  }
+
+  /* Counter reset event.*/
+  if (((pwmp->notify & PWM_NOTIFY_PERIODIC) != 0U) &&
+      (pwmp->config->callback != NULL)) {
+    pwmp->config->callback(pwmp);
+  }
+
+  if (pwmp->observer != NULL) {
+    pwmp->observer(pwmp, true, pwmp->observer_param);
+  }
+
+  pwmp->cycles++;
+  simTimeAdvance(simTimeBits(pwmp->period, pwmp->config->frequency));
+
+  osalSysLockFromISR();
+  if (pwmp->state == PWM_READY) {
+    chVTSetI(&pwmp->vt, (sysinterval_t)1, pwm_lld_cycle, pwmp);
+  }
+  osalSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level PWM driver initialization.
+ *
+ * @notapi
+ */
+void pwm_lld_init(void) {
+
+#if SIM_PWM_USE_PWM1
+  pwmObjectInit(&PWMD1);
+  PWMD1.channels = PWM_CHANNELS;
+  PWMD1.observer = NULL;
+  chVTObjectInit(&PWMD1.vt);
+#endif
+
+#if SIM_PWM_USE_PWM2
+  pwmObjectInit(&PWMD2);
+  PWMD2.channels = PWM_CHANNELS;
+  PWMD2.observer = NULL;
+  chVTObjectInit(&PWMD2.vt);
+#endif
+}
+
+/**
+ * @brief   Configures and activates the PWM peripheral.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ *
+ * @notapi
+ */
+void pwm_lld_start(PWMDriver *pwmp) {
+  pwmchannel_t ch;
+
+  osalDbgCheck((pwmp->config->frequency > 0U) && (pwmp->period > 0U));
+
+  for (ch = 0U; ch < PWM_CHANNELS; ch++) {
+    pwmp->width[ch] = 0U;
+  }
+  pwmp->notify = 0U;
+  pwmp->cycles = 0U;
+
+  chVTResetI(&pwmp->vt);
+  chVTSetI(&pwmp->vt, (sysinterval_t)1, pwm_lld_cycle, pwmp);
+}
+
+/**
+ * @brief   Deactivates the PWM peripheral.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ *
+ * @notapi
+ */
+void pwm_lld_stop(PWMDriver *pwmp) {
+
+  chVTResetI(&pwmp->vt);
+  pwmp->notify = 0U;
+}
+
+/**
+ * @brief   Enables a PWM channel.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] channel   PWM channel identifier (0...channels-1)
+ * @param[in] width     PWM pulse width as clock pulses number
+ *
+ * @notapi
+ */
+void pwm_lld_enable_channel(PWMDriver *pwmp,
+                            pwmchannel_t channel,
+                            pwmcnt_t width) {
+
+  pwmp->width[channel] = width;
+}
+
+/**
+ * @brief   Disables a PWM channel and its notification.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] channel   PWM channel identifier (0...channels-1)
+ *
+ * @notapi
+ */
+void pwm_lld_disable_channel(PWMDriver *pwmp, pwmchannel_t channel) {
+
+  pwmp->width[channel] = 0U;
+  pwmp->notify &= ~((pwmchnmsk_t)1U << channel);
+}
+
+/**
+ * @brief   Enables the periodic activation edge notification.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ *
+ * @notapi
+ */
+void pwm_lld_enable_periodic_notification(PWMDriver *pwmp) {
+
+  pwmp->notify |= PWM_NOTIFY_PERIODIC;
+}
+
+/**
+ * @brief   Disables the periodic activation edge notification.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ *
+ * @notapi
+ */
+void pwm_lld_disable_periodic_notification(PWMDriver *pwmp) {
+
+  pwmp->notify &= ~PWM_NOTIFY_PERIODIC;
+}
+
+/**
+ * @brief   Enables a channel de-activation edge notification.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] channel   PWM channel identifier (0...channels-1)
+ *
+ * @notapi
+ */
+void pwm_lld_enable_channel_notification(PWMDriver *pwmp,
+                                         pwmchannel_t channel) {
+
+  pwmp->notify |= (pwmchnmsk_t)1U << channel;
+}
+
+/**
+ * @brief   Disables a channel de-activation edge notification.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] channel   PWM channel identifier (0...channels-1)
+ *
+ * @notapi
+ */
+void pwm_lld_disable_channel_notification(PWMDriver *pwmp,
+                                          pwmchannel_t channel) {
+
+  pwmp->notify &= ~((pwmchnmsk_t)1U << channel);
+}
+
+/**
+ * @brief   Registers the cycle observer of a simulated timer.
+ * @note    Only one observer per timer is supported, @p NULL removes it.
+ *
+ * @param[in] pwmp      pointer to a @p PWMDriver object
+ * @param[in] observer  observer function
+ * @param[in] param     parameter passed to the observer
+ *
+ * @api
+ */
+void simPwmObserve(PWMDriver *pwmp, simpwmobserver_t observer, void *param) {
+
+  osalSysLock();
+  pwmp->observer       = observer;
+  pwmp->observer_param = param;
+  osalSysUnlock();
+}
+
+#endif /* HAL_USE_PWM */
+
+/** @} */
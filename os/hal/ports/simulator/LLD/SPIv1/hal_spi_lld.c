@@ -0,0 +1,283 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/SPIv1/hal_spi_lld.c
+ * @brief   Simulator SPI subsystem low level driver source.
+ *
+ * @addtogroup SPI
+ * @{
+ */
+
+#include "hal.h"
+
+#if HAL_USE_SPI || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   SPI1 driver identifier.
+ */
+#if SIM_SPI_USE_SPI1 || defined(__DOXYGEN__)
+SPIDriver SPID1;
+#endif
+
+/**
+ * @brief   SPI2 driver identifier.
+ */
+#if SIM_SPI_USE_SPI2 || defined(__DOXYGEN__)
+SPIDriver SPID2;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Completion of a simulated transfer.
+ * @note    Runs from the virtual timer, i.e. in ISR context, exactly like
+ *          the DMA or TX-complete interrupt of a real port.
+ *
+ * @param[in] vtp       pointer to the timer
+ * @param[in] p         pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+static void spi_lld_complete(virtual_timer_t *vtp, void *p) {
+  SPIDriver *spip = (SPIDriver *)p;
+
+  (void)vtp;
+
+  _spi_isr_code(spip);
+}
+
+/**
+ * @brief   Clocks a buffer through the selected device.
+ * @details The data moves at once; completion is reported one system tick
+ *          later, so the HAL sees an asynchronous transfer and the caller
+ *          thread really suspends.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of frames
+ * @param[in] txbuf     frames to send or @p NULL for 0xFF fill
+ * @param[out] rxbuf    received frames or @p NULL to drop them
+ *
+ * @notapi
+ */
+static void spi_lld_transfer(SPIDriver *spip, size_t n,
+                             const uint8_t *txbuf, uint8_t *rxbuf) {
+  sim_spi_device_t *devp = spip->config->device;
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    uint8_t b = (txbuf != NULL) ? txbuf[i] : 0xFFU;
+
+    if ((devp != NULL) && spip->selected) {
+      b = devp->exchange(devp, b);
+    }
+    else {
+      b = 0xFFU;                    /* Floating MISO.*/
+    }
+    if (rxbuf != NULL) {
+      rxbuf[i] = b;
+    }
+  }
+  simStatsAccount(&spip->stats, (uint32_t)n,
+                  simTimeBits((uint32_t)n * 8U, spip->config->clock_speed));
+
+  chVTSetI(&spip->vt, (sysinterval_t)1, spi_lld_complete, spip);
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level SPI driver initialization.
+ *
+ * @notapi
+ */
+void spi_lld_init(void) {
+
+#if SIM_SPI_USE_SPI1
+  spiObjectInit(&SPID1);
+  chVTObjectInit(&SPID1.vt);
+  SPID1.selected = false;
+#endif
+
+#if SIM_SPI_USE_SPI2
+  spiObjectInit(&SPID2);
+  chVTObjectInit(&SPID2.vt);
+  SPID2.selected = false;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the SPI peripheral.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_start(SPIDriver *spip) {
+
+  osalDbgCheck(spip->config->clock_speed > 0U);
+
+  if (spip->state == SPI_STOP) {
+    spip->stats = (sim_stats_t){0};
+  }
+}
+
+/**
+ * @brief   Deactivates the SPI peripheral.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_stop(SPIDriver *spip) {
+
+  chVTResetI(&spip->vt);
+}
+
+/**
+ * @brief   Asserts the slave select signal and prepares for transfers.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_select(SPIDriver *spip) {
+  sim_spi_device_t *devp = spip->config->device;
+
+  if (!spip->selected && (devp != NULL)) {
+    devp->select(devp);
+  }
+  spip->selected = true;
+}
+
+/**
+ * @brief   Deasserts the slave select signal.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+void spi_lld_unselect(SPIDriver *spip) {
+  sim_spi_device_t *devp = spip->config->device;
+
+  if (spip->selected && (devp != NULL)) {
+    devp->unselect(devp);
+  }
+  spip->selected = false;
+}
+
+/**
+ * @brief   Ignores data on the SPI bus.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to be ignored
+ *
+ * @notapi
+ */
+void spi_lld_ignore(SPIDriver *spip, size_t n) {
+
+  spi_lld_transfer(spip, n, NULL, NULL);
+}
+
+/**
+ * @brief   Exchanges data on the SPI bus.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to be exchanged
+ * @param[in] txbuf     the pointer to the transmit buffer
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @notapi
+ */
+void spi_lld_exchange(SPIDriver *spip, size_t n,
+                      const void *txbuf, void *rxbuf) {
+
+  spi_lld_transfer(spip, n, txbuf, rxbuf);
+}
+
+/**
+ * @brief   Sends data over the SPI bus.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to send
+ * @param[in] txbuf     the pointer to the transmit buffer
+ *
+ * @notapi
+ */
+void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf) {
+
+  spi_lld_transfer(spip, n, txbuf, NULL);
+}
+
+/**
+ * @brief   Receives data from the SPI bus.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words to receive
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @notapi
+ */
+void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
+
+  spi_lld_transfer(spip, n, NULL, rxbuf);
+}
+
+/**
+ * @brief   Exchanges one frame using a polled wait.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] frame     the data frame to send over the SPI bus
+ * @return              The received data frame from the SPI bus.
+ *
+ * @notapi
+ */
+uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame) {
+  sim_spi_device_t *devp = spip->config->device;
+  uint8_t b = 0xFFU;
+
+  if ((devp != NULL) && spip->selected) {
+    b = devp->exchange(devp, (uint8_t)frame);
+  }
+  simStatsAccount(&spip->stats, 1U,
+                  simTimeBits(8U, spip->config->clock_speed));
+
+  return (uint16_t)b;
+}
+
+#endif /* HAL_USE_SPI */
+
+/** @} */
@@ -0,0 +1,167 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/LLD/SPIv1/hal_spi_lld.h
+ * @brief   Simulator SPI subsystem low level driver header.
+ * @details Each configuration points to the device model sitting behind
+ *          its chip select. Frames are 8 bits wide.
+ *
+ * @addtogroup SPI
+ * @{
+ */
+
+#ifndef HAL_SPI_LLD_H
+#define HAL_SPI_LLD_H
+
+#if HAL_USE_SPI || defined(__DOXYGEN__)
+
+#include "sim_timing.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Circular mode support flag.
+ */
+#define SPI_SUPPORTS_CIRCULAR               FALSE
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   SPI1 driver enable switch.
+ * @details If set to @p TRUE the support for SPI1 is included.
+ * @note    The default is @p TRUE.
+ */
+#if !defined(SIM_SPI_USE_SPI1) || defined(__DOXYGEN__)
+#define SIM_SPI_USE_SPI1                    TRUE
+#endif
+
+/**
+ * @brief   SPI2 driver enable switch.
+ * @details If set to @p TRUE the support for SPI2 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(SIM_SPI_USE_SPI2) || defined(__DOXYGEN__)
+#define SIM_SPI_USE_SPI2                    FALSE
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !SIM_SPI_USE_SPI1 && !SIM_SPI_USE_SPI2
+#error "SPI driver activated but no SPI peripheral assigned"
+#endif
+
+#if SPI_SELECT_MODE != SPI_SELECT_MODE_LLD
+#error "the simulated SPI requires SPI_SELECT_MODE_LLD, device models track the chip select"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a simulated SPI device.
+ */
+typedef struct sim_spi_device sim_spi_device_t;
+
+/**
+ * @brief   Simulated SPI device model.
+ */
+struct sim_spi_device {
+  /**
+   * @brief   Chip select asserted.
+   */
+  void                      (*select)(sim_spi_device_t *devp);
+  /**
+   * @brief   Chip select released.
+   */
+  void                      (*unselect)(sim_spi_device_t *devp);
+  /**
+   * @brief   Full duplex exchange of one frame.
+   */
+  uint8_t                   (*exchange)(sim_spi_device_t *devp, uint8_t b);
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level fields of the SPI driver structure.
+ */
+#define spi_lld_driver_fields                                               \
+  /* Timer deferring the completion callback.*/                             \
+  virtual_timer_t           vt;                                             \
+  /* Chip select state.*/                                                   \
+  bool                      selected;                                       \
+  /* Bus statistics.*/                                                      \
+  sim_stats_t               stats
+
+/**
+ * @brief   Low level fields of the SPI configuration structure.
+ */
+#define spi_lld_config_fields                                               \
+  /* Simulated SCK frequency in Hz.*/                                       \
+  uint32_t                  clock_speed;                                    \
+  /* Device behind the chip select.*/                                       \
+  sim_spi_device_t          *device
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if SIM_SPI_USE_SPI1 && !defined(__DOXYGEN__)
+extern SPIDriver SPID1;
+#endif
+
+#if SIM_SPI_USE_SPI2 && !defined(__DOXYGEN__)
+extern SPIDriver SPID2;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void spi_lld_init(void);
+  void spi_lld_start(SPIDriver *spip);
+  void spi_lld_stop(SPIDriver *spip);
+  void spi_lld_select(SPIDriver *spip);
+  void spi_lld_unselect(SPIDriver *spip);
+  void spi_lld_ignore(SPIDriver *spip, size_t n);
+  void spi_lld_exchange(SPIDriver *spip, size_t n,
+                        const void *txbuf, void *rxbuf);
+  void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf);
+  void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf);
+  uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_SPI */
+
+#endif /* HAL_SPI_LLD_H */
+
+/** @} */
@@ -0,0 +1,495 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_ds18b20.c
+ * @brief   Simulated 1-Wire bus with DS18B20 sensors code.
+ *
+ * @addtogroup SIM_DS18B20
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_ds18b20.h"
+
+#if HAL_USE_PWM || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @name    Slot classification thresholds
+ * @{
+ */
+#define OW_RESET_MIN_NS             SIM_US2NS(480)
+#define OW_SLOT_ONE_MAX_NS          SIM_US2NS(15)
+/** @} */
+
+/**
+ * @name    ROM and function commands
+ * @{
+ */
+#define OW_CMD_READ_ROM             0x33U
+#define OW_CMD_MATCH_ROM            0x55U
+#define OW_CMD_SKIP_ROM             0xCCU
+#define OW_CMD_SEARCH_ROM           0xF0U
+#define OW_CMD_CONVERT_T            0x44U
+#define OW_CMD_READ_SCRATCHPAD      0xBEU
+#define OW_CMD_WRITE_SCRATCHPAD     0x4EU
+#define OW_CMD_COPY_SCRATCHPAD      0x48U
+#define OW_CMD_RECALL_EEPROM        0xB8U
+#define OW_CMD_READ_POWER_SUPPLY    0xB4U
+/** @} */
+
+/**
+ * @brief   Conversion time at 9 bits resolution.
+ */
+#define DS18B20_CONV_9BIT_NS        SIM_US2NS(93750)
+
+/**
+ * @brief   EEPROM copy time.
+ */
+#define DS18B20_COPY_NS             SIM_MS2NS(10)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Dallas/Maxim CRC8.
+ */
+static uint8_t ow_crc8(const uint8_t *p, size_t n) {
+  uint8_t crc = 0U;
+
+  while (n-- > 0U) {
+    uint8_t b = *p++;
+    unsigned i;
+
+    for (i = 0U; i < 8U; i++) {
+      uint8_t mix = (crc ^ b) & 1U;
+
+      crc >>= 1;
+      if (mix != 0U) {
+        crc ^= 0x8CU;
+      }
+      b >>= 1;
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief   Refreshes the scratchpad CRC.
+ */
+static void ds18b20_seal(sim_ds18b20_t *devp) {
+
+  devp->scratchpad[8] = ow_crc8(devp->scratchpad, 8U);
+}
+
+/**
+ * @brief   Latches a new temperature into the scratchpad.
+ * @details Undefined low bits are cleared according to the resolution.
+ */
+static void ds18b20_convert(sim_ds18b20_t *devp) {
+  unsigned res = (devp->scratchpad[4] >> 5) & 3U;
+  int16_t t = (int16_t)(devp->temperature & ~((1 << (3U - res)) - 1));
+
+  devp->scratchpad[0] = (uint8_t)t;
+  devp->scratchpad[1] = (uint8_t)((uint16_t)t >> 8);
+  ds18b20_seal(devp);
+  devp->conv_until = simTimeNow() + (DS18B20_CONV_9BIT_NS << res);
+  devp->conversions++;
+}
+
+/**
+ * @brief   Drives the sampled pad.
+ */
+static void ow_drive(sim_onewire_t *busp, bool level) {
+
+  if (level) {
+    busp->port->pin |= (uint32_t)1U << busp->pad;
+  }
+  else {
+    busp->port->pin &= ~((uint32_t)1U << busp->pad);
+  }
+}
+
+/**
+ * @brief   Enters a new protocol phase.
+ */
+static void ow_enter(sim_onewire_t *busp, sim_ow_state_t state,
+                     uint32_t bits) {
+
+  busp->state = state;
+  busp->bit   = 0U;
+  busp->bits  = bits;
+  busp->shift = 0U;
+  busp->step  = 0U;
+}
+
+/**
+ * @brief   Executes a ROM command.
+ */
+static void ow_rom_command(sim_onewire_t *busp, uint8_t cmd) {
+
+  switch (cmd) {
+  case OW_CMD_READ_ROM:
+    busp->tx_rom   = true;
+    busp->after_tx = SIM_OW_FUNC_CMD;
+    ow_enter(busp, SIM_OW_TX, 64U);
+    break;
+  case OW_CMD_SKIP_ROM:
+    ow_enter(busp, SIM_OW_FUNC_CMD, 8U);
+    break;
+  case OW_CMD_MATCH_ROM:
+    ow_enter(busp, SIM_OW_MATCH, 64U);
+    break;
+  case OW_CMD_SEARCH_ROM:
+    ow_enter(busp, SIM_OW_SEARCH, 64U);
+    break;
+  default:
+    ow_enter(busp, SIM_OW_IDLE, 0U);
+    break;
+  }
+}
+
+/**
+ * @brief   Executes a function command on the addressed sensors.
+ */
+static void ow_function_command(sim_onewire_t *busp, uint8_t cmd) {
+  sim_ds18b20_t *devp;
+
+  switch (cmd) {
+  case OW_CMD_CONVERT_T:
+    for (devp = busp->devices; devp != NULL; devp = devp->next) {
+      if (devp->active) {
+        ds18b20_convert(devp);
+      }
+    }
+    ow_enter(busp, SIM_OW_STATUS, 0U);
+    break;
+  case OW_CMD_READ_SCRATCHPAD:
+    busp->tx_rom   = false;
+    busp->after_tx = SIM_OW_IDLE;
+    ow_enter(busp, SIM_OW_TX, 72U);
+    break;
+  case OW_CMD_WRITE_SCRATCHPAD:
+    ow_enter(busp, SIM_OW_RX, 24U);
+    break;
+  case OW_CMD_COPY_SCRATCHPAD:
+  case OW_CMD_RECALL_EEPROM:
+    for (devp = busp->devices; devp != NULL; devp = devp->next) {
+      if (!devp->active) {
+        continue;
+      }
+      if (cmd == OW_CMD_COPY_SCRATCHPAD) {
+        devp->eeprom[0]  = devp->scratchpad[2];
+        devp->eeprom[1]  = devp->scratchpad[3];
+        devp->eeprom[2]  = devp->scratchpad[4];
+        devp->conv_until = simTimeNow() + DS18B20_COPY_NS;
+      }
+      else {
+        devp->scratchpad[2] = devp->eeprom[0];
+        devp->scratchpad[3] = devp->eeprom[1];
+        devp->scratchpad[4] = devp->eeprom[2];
+        ds18b20_seal(devp);
+      }
+    }
+    ow_enter(busp, SIM_OW_STATUS, 0U);
+    break;
+  case OW_CMD_READ_POWER_SUPPLY:
+    /* Externally powered sensors answer with ones.*/
+    ow_enter(busp, SIM_OW_STATUS, 0U);
+    break;
+  default:
+    ow_enter(busp, SIM_OW_IDLE, 0U);
+    break;
+  }
+}
+
+/**
+ * @brief   Wired-AND of a bit of the addressed sensors.
+ *
+ * @param[in] busp      pointer to the @p sim_onewire_t object
+ * @param[in] bit       bit index inside the source
+ * @param[in] invert    answer with the complement
+ * @return              The bus level, @p true if released.
+ */
+static bool ow_wired_and(sim_onewire_t *busp, uint32_t bit, bool invert) {
+  sim_ds18b20_t *devp;
+  bool level = true;
+
+  for (devp = busp->devices; devp != NULL; devp = devp->next) {
+    const uint8_t *src = busp->tx_rom ? devp->rom : devp->scratchpad;
+    bool b;
+
+    if (!devp->active) {
+      continue;
+    }
+    b = ((src[bit >> 3] >> (bit & 7U)) & 1U) != 0U;
+    level = level && (b != invert);
+  }
+  return level;
+}
+
+/**
+ * @brief   Runs one read or write slot through the sensors.
+ *
+ * @param[in] busp      pointer to the @p sim_onewire_t object
+ * @param[in] mbit      bit written by the master, read slots write ones
+ * @return              The level driven by the sensors, @p true if released.
+ */
+static bool ow_slot(sim_onewire_t *busp, bool mbit) {
+  sim_ds18b20_t *devp;
+  bool level = true;
+
+  switch (busp->state) {
+  case SIM_OW_ROM_CMD:
+  case SIM_OW_FUNC_CMD:
+  case SIM_OW_RX:
+    busp->shift |= (uint8_t)((mbit ? 1U : 0U) << (busp->bit & 7U));
+    busp->bit++;
+    if ((busp->bit & 7U) != 0U) {
+      break;
+    }
+    busp->stats.bytes++;
+    if (busp->state == SIM_OW_ROM_CMD) {
+      ow_rom_command(busp, busp->shift);
+    }
+    else if (busp->state == SIM_OW_FUNC_CMD) {
+      ow_function_command(busp, busp->shift);
+    }
+    else {
+      busp->rx[(busp->bit / 8U) - 1U] = busp->shift;
+      busp->shift = 0U;
+      if (busp->bit == busp->bits) {
+        for (devp = busp->devices; devp != NULL; devp = devp->next) {
+          if (devp->active) {
+            devp->scratchpad[2] = busp->rx[0];
+            devp->scratchpad[3] = busp->rx[1];
+            devp->scratchpad[4] = (busp->rx[2] & 0x60U) | 0x1FU;
+            ds18b20_seal(devp);
+          }
+        }
+        ow_enter(busp, SIM_OW_IDLE, 0U);
+      }
+    }
+    break;
+  case SIM_OW_MATCH:
+    busp->tx_rom = true;
+    for (devp = busp->devices; devp != NULL; devp = devp->next) {
+      bool b = ((devp->rom[busp->bit >> 3] >> (busp->bit & 7U)) & 1U) != 0U;
+
+      if (b != mbit) {
+        devp->active = false;
+      }
+    }
+    if (++busp->bit == busp->bits) {
+      ow_enter(busp, SIM_OW_FUNC_CMD, 8U);
+    }
+    break;
+  case SIM_OW_SEARCH:
+    busp->tx_rom = true;
+    if (busp->step < 2U) {
+      level = ow_wired_and(busp, busp->bit, busp->step == 1U);
+      busp->step++;
+      break;
+    }
+    for (devp = busp->devices; devp != NULL; devp = devp->next) {
+      bool b = ((devp->rom[busp->bit >> 3] >> (busp->bit & 7U)) & 1U) != 0U;
+
+      if (b != mbit) {
+        devp->active = false;
+      }
+    }
+    busp->step = 0U;
+    if (++busp->bit == busp->bits) {
+      ow_enter(busp, SIM_OW_FUNC_CMD, 8U);
+    }
+    break;
+  case SIM_OW_TX:
+    level = ow_wired_and(busp, busp->bit, false);
+    busp->bit++;
+    if ((busp->bit & 7U) == 0U) {
+      busp->stats.bytes++;
+    }
+    if (busp->bit == busp->bits) {
+      ow_enter(busp, busp->after_tx,
+               (busp->after_tx == SIM_OW_FUNC_CMD) ? 8U : 0U);
+    }
+    break;
+  case SIM_OW_STATUS:
+    for (devp = busp->devices; devp != NULL; devp = devp->next) {
+      if (devp->active && (simTimeNow() < devp->conv_until)) {
+        level = false;
+      }
+    }
+    break;
+  default:
+    break;
+  }
+
+  return level && mbit;
+}
+
+/**
+ * @brief   PWM cycle observer.
+ * @details A cycle whose master pulse is at least 480us long is a reset,
+ *          up to 15us it is a write-1 or read slot, a write-0 otherwise.
+ *          The pad is released at the end of every cycle.
+ */
+static void ow_observer(PWMDriver *pwmp, bool end, void *param) {
+  sim_onewire_t *busp = (sim_onewire_t *)param;
+  sim_ds18b20_t *devp;
+  pwmcnt_t width;
+  simtime_t low;
+
+  if (end) {
+    ow_drive(busp, true);
+    return;
+  }
+
+  width = simPwmGetWidth(pwmp, busp->master);
+  if (width == 0U) {
+    ow_drive(busp, true);
+    return;
+  }
+
+  low = simTimeBits(width, pwmp->config->frequency);
+  if (low >= OW_RESET_MIN_NS) {
+    for (devp = busp->devices; devp != NULL; devp = devp->next) {
+      devp->active = true;
+    }
+    busp->stats.transactions++;
+    ow_enter(busp, SIM_OW_ROM_CMD, 8U);
+    /* Presence pulse.*/
+    ow_drive(busp, busp->devices == NULL);
+  }
+  else {
+    ow_drive(busp, ow_slot(busp, low <= OW_SLOT_ONE_MAX_NS));
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated 1-Wire bus and hooks it to a timer.
+ * @note    Use the same timer, master channel and pad given to the
+ *          @p onewireConfig of the driver under test.
+ *
+ * @param[out] busp     pointer to the @p sim_onewire_t object
+ * @param[in] pwmp      simulated timer generating the slots
+ * @param[in] master    channel pulling the bus low
+ * @param[in] port      port of the sampled pad
+ * @param[in] pad       sampled pad
+ */
+void simOnewireObjectInit(sim_onewire_t *busp, PWMDriver *pwmp,
+                          pwmchannel_t master, ioportid_t port,
+                          iopadid_t pad) {
+
+  busp->pwmp    = pwmp;
+  busp->master  = master;
+  busp->port    = port;
+  busp->pad     = pad;
+  busp->devices = NULL;
+  busp->stats   = (sim_stats_t){0};
+  ow_enter(busp, SIM_OW_IDLE, 0U);
+
+  /* Idle bus is pulled up.*/
+  ow_drive(busp, true);
+  simPwmObserve(pwmp, ow_observer, busp);
+}
+
+/**
+ * @brief   Attaches a sensor to a simulated bus.
+ *
+ * @param[in] busp      pointer to the @p sim_onewire_t object
+ * @param[in] devp      pointer to the @p sim_ds18b20_t object
+ */
+void simOnewireAttach(sim_onewire_t *busp, sim_ds18b20_t *devp) {
+
+  osalSysLock();
+  devp->next    = busp->devices;
+  busp->devices = devp;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Initializes a simulated DS18B20 in its power-on state.
+ *
+ * @param[out] devp     pointer to the @p sim_ds18b20_t object
+ * @param[in] serial    48 bits serial number, least significant byte first
+ */
+void simDs18b20ObjectInit(sim_ds18b20_t *devp, const uint8_t serial[6]) {
+  static const uint8_t por[9] = {0x50U, 0x05U, 0x4BU, 0x46U, 0x7FU,
+                                 0xFFU, 0x0CU, 0x10U, 0x00U};
+  unsigned i;
+
+  devp->next   = NULL;
+  devp->rom[0] = SIM_DS18B20_FAMILY;
+  for (i = 0U; i < 6U; i++) {
+    devp->rom[1U + i] = serial[i];
+  }
+  devp->rom[7] = ow_crc8(devp->rom, 7U);
+
+  for (i = 0U; i < 9U; i++) {
+    devp->scratchpad[i] = por[i];
+  }
+  ds18b20_seal(devp);
+  devp->eeprom[0]   = por[2];
+  devp->eeprom[1]   = por[3];
+  devp->eeprom[2]   = por[4];
+  devp->temperature = 0x0550;       /* 85C, power-on value.*/
+  devp->conv_until  = 0U;
+  devp->active      = false;
+  devp->conversions = 0U;
+}
+
+/**
+ * @brief   Sets the temperature seen by a sensor.
+ * @note    The value is latched by the next CONVERT T.
+ *
+ * @param[in] devp          pointer to the @p sim_ds18b20_t object
+ * @param[in] millicelsius  temperature, clamped to -55..125C
+ */
+void simDs18b20SetTemperature(sim_ds18b20_t *devp, int32_t millicelsius) {
+
+  if (millicelsius < -55000) {
+    millicelsius = -55000;
+  }
+  else if (millicelsius > 125000) {
+    millicelsius = 125000;
+  }
+
+  osalSysLock();
+  devp->temperature = (int16_t)((millicelsius * 16) / 1000);
+  osalSysUnlock();
+}
+
+#endif /* HAL_USE_PWM */
+
+/** @} */
@@ -0,0 +1,202 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_ds18b20.h
+ * @brief   Simulated 1-Wire bus with DS18B20 sensors header.
+ * @details The bus observes the master channel of a simulated PWM timer,
+ *          classifies every cycle as reset, write-0 or write-1/read slot
+ *          from the low pulse width and drives the sampled pad through the
+ *          virtual I/O port, wired-AND with all the attached sensors.
+ *          ROM commands: READ, SKIP, MATCH and SEARCH. Function commands:
+ *          CONVERT T, READ/WRITE SCRATCHPAD, COPY SCRATCHPAD, RECALL and
+ *          READ POWER SUPPLY.
+ *
+ * @addtogroup SIM_DS18B20
+ * @{
+ */
+
+#ifndef SIM_DS18B20_H
+#define SIM_DS18B20_H
+
+#if HAL_USE_PWM || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   DS18B20 family code.
+ */
+#define SIM_DS18B20_FAMILY          0x28U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a simulated DS18B20.
+ */
+typedef struct sim_ds18b20 sim_ds18b20_t;
+
+/**
+ * @brief   Simulated DS18B20.
+ */
+struct sim_ds18b20 {
+  /**
+   * @brief   Next sensor on the same bus.
+   */
+  sim_ds18b20_t             *next;
+  /**
+   * @brief   ROM code, family first, CRC last.
+   */
+  uint8_t                   rom[8];
+  /**
+   * @brief   Scratchpad, CRC last.
+   */
+  uint8_t                   scratchpad[9];
+  /**
+   * @brief   Alarm and configuration registers in EEPROM.
+   */
+  uint8_t                   eeprom[3];
+  /**
+   * @brief   Temperature seen by the sensor in 1/16 degrees C.
+   */
+  int16_t                   temperature;
+  /**
+   * @brief   End of the running conversion.
+   */
+  simtime_t                 conv_until;
+  /**
+   * @brief   Still addressed in the current transaction.
+   */
+  bool                      active;
+  /**
+   * @brief   Completed conversions.
+   */
+  uint32_t                  conversions;
+};
+
+/**
+ * @brief   Bus protocol state.
+ */
+typedef enum {
+  SIM_OW_IDLE = 0,                  /**< Waiting for a reset pulse.         */
+  SIM_OW_ROM_CMD = 1,               /**< Receiving a ROM command.           */
+  SIM_OW_MATCH = 2,                 /**< Receiving a ROM code to match.     */
+  SIM_OW_SEARCH = 3,                /**< Running a search ROM tree step.    */
+  SIM_OW_FUNC_CMD = 4,              /**< Receiving a function command.      */
+  SIM_OW_TX = 5,                    /**< Sensors transmitting.              */
+  SIM_OW_RX = 6,                    /**< Receiving scratchpad bytes.        */
+  SIM_OW_STATUS = 7                 /**< Read slots return busy status.     */
+} sim_ow_state_t;
+
+/**
+ * @brief   Simulated 1-Wire bus.
+ */
+typedef struct {
+  /**
+   * @brief   Timer generating the slots.
+   */
+  PWMDriver                 *pwmp;
+  /**
+   * @brief   Channel driving the bus low.
+   */
+  pwmchannel_t              master;
+  /**
+   * @brief   Port of the sampled pad.
+   */
+  ioportid_t                port;
+  /**
+   * @brief   Sampled pad.
+   */
+  iopadid_t                 pad;
+  /**
+   * @brief   Sensors on the bus.
+   */
+  sim_ds18b20_t             *devices;
+  /**
+   * @brief   Protocol state.
+   */
+  sim_ow_state_t            state;
+  /**
+   * @brief   State entered at the end of a transmission.
+   */
+  sim_ow_state_t            after_tx;
+  /**
+   * @brief   Shift register of the byte being received.
+   */
+  uint8_t                   shift;
+  /**
+   * @brief   Bit counter of the current phase.
+   */
+  uint32_t                  bit;
+  /**
+   * @brief   Length of the current phase in bits.
+   */
+  uint32_t                  bits;
+  /**
+   * @brief   Search ROM sub-step, bit, complement, direction.
+   */
+  uint8_t                   step;
+  /**
+   * @brief   Transmission source, rom or scratchpad.
+   */
+  bool                      tx_rom;
+  /**
+   * @brief   Bytes received for WRITE SCRATCHPAD.
+   */
+  uint8_t                   rx[3];
+  /**
+   * @brief   Bus statistics, one byte every 8 slots.
+   */
+  sim_stats_t               stats;
+} sim_onewire_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simOnewireObjectInit(sim_onewire_t *busp, PWMDriver *pwmp,
+                            pwmchannel_t master, ioportid_t port,
+                            iopadid_t pad);
+  void simOnewireAttach(sim_onewire_t *busp, sim_ds18b20_t *devp);
+  void simDs18b20ObjectInit(sim_ds18b20_t *devp, const uint8_t serial[6]);
+  void simDs18b20SetTemperature(sim_ds18b20_t *devp, int32_t millicelsius);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_PWM */
+
+#endif /* SIM_DS18B20_H */
+
+/** @} */
@@ -0,0 +1,153 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_ee24xx.c
+ * @brief   Simulated 24xx I2C EEPROM code.
+ *
+ * @addtogroup SIM_EE24XX
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_ee24xx.h"
+
+#if HAL_USE_I2C || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of address bytes following the device address.
+ */
+static uint8_t ee24xx_addr_bytes(const sim_ee24xx_t *eep) {
+
+  return (eep->size > 256U) ? 2U : 1U;
+}
+
+/*
+ * Bus device callbacks.
+ */
+static bool ee24xx_start(sim_i2c_device_t *devp, bool read) {
+  sim_ee24xx_t *eep = (sim_ee24xx_t *)devp;
+
+  if (simTimeNow() < eep->busy_until) {
+    return false;
+  }
+  if (!read) {
+    eep->addr_left = ee24xx_addr_bytes(eep);
+    eep->written   = 0U;
+  }
+  return true;
+}
+
+static bool ee24xx_write(sim_i2c_device_t *devp, uint8_t b) {
+  sim_ee24xx_t *eep = (sim_ee24xx_t *)devp;
+
+  if (eep->addr_left > 0U) {
+    eep->ptr = ((eep->ptr << 8) | b) & (uint32_t)(eep->size - 1U);
+    eep->addr_left--;
+    return true;
+  }
+
+  /* Roll over inside the page like the real page buffer.*/
+  eep->mem[eep->ptr] = b;
+  eep->ptr = (eep->ptr & ~(uint32_t)(eep->pagesize - 1U)) |
+             ((eep->ptr + 1U) & (uint32_t)(eep->pagesize - 1U));
+  eep->written++;
+  return true;
+}
+
+static uint8_t ee24xx_read(sim_i2c_device_t *devp) {
+  sim_ee24xx_t *eep = (sim_ee24xx_t *)devp;
+  uint8_t b = eep->mem[eep->ptr];
+
+  eep->ptr = (eep->ptr + 1U) & (uint32_t)(eep->size - 1U);
+  return b;
+}
+
+static void ee24xx_stop(sim_i2c_device_t *devp) {
+  sim_ee24xx_t *eep = (sim_ee24xx_t *)devp;
+
+  if (eep->written == 0U) {
+    return;
+  }
+  eep->written = 0U;
+  eep->write_cycles++;
+  if (eep->ack_polling) {
+    eep->busy_until = simTimeNow() + eep->t_wr;
+  }
+  else {
+    simTimeAdvance(eep->t_wr);
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated 24xx EEPROM.
+ * @note    The array contents are left untouched.
+ *
+ * @param[out] eep      pointer to the @p sim_ee24xx_t object
+ * @param[in] addr      7 bits slave address
+ * @param[in] mem       memory array
+ * @param[in] size      array size, a power of two
+ * @param[in] pagesize  page size, a power of two
+ * @param[in] t_wr      internal write cycle time
+ */
+void simEe24xxObjectInit(sim_ee24xx_t *eep, i2caddr_t addr, uint8_t *mem,
+                         size_t size, size_t pagesize, simtime_t t_wr) {
+
+  osalDbgCheck((mem != NULL) && (size > 0U) && ((size & (size - 1U)) == 0U));
+  osalDbgCheck((pagesize > 0U) && ((pagesize & (pagesize - 1U)) == 0U) &&
+               (pagesize <= size));
+
+  eep->dev.next     = NULL;
+  eep->dev.addr     = addr;
+  eep->dev.start    = ee24xx_start;
+  eep->dev.write    = ee24xx_write;
+  eep->dev.read     = ee24xx_read;
+  eep->dev.stop     = ee24xx_stop;
+  eep->mem          = mem;
+  eep->size         = size;
+  eep->pagesize     = pagesize;
+  eep->t_wr         = t_wr;
+  eep->ack_polling  = false;
+  eep->busy_until   = 0U;
+  eep->ptr          = 0U;
+  eep->addr_left    = 0U;
+  eep->written      = 0U;
+  eep->write_cycles = 0U;
+}
+
+#endif /* HAL_USE_I2C */
+
+/** @} */
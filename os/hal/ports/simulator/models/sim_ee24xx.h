@@ -0,0 +1,123 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_ee24xx.h
+ * @brief   Simulated 24xx I2C EEPROM header.
+ * @details Devices up to 256 bytes take one address byte, larger ones two.
+ *          Written bytes wrap inside the current page and the internal
+ *          write cycle starts on STOP. During the cycle the device either
+ *          NACKs its address (acknowledge polling) or, by default, the
+ *          cycle is charged to the virtual clock at once, which matches
+ *          drivers that simply sleep for the write time.
+ *
+ * @addtogroup SIM_EE24XX
+ * @{
+ */
+
+#ifndef SIM_EE24XX_H
+#define SIM_EE24XX_H
+
+#if HAL_USE_I2C || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated 24xx EEPROM.
+ */
+typedef struct {
+  /**
+   * @brief   Bus device, must be the first field.
+   */
+  sim_i2c_device_t          dev;
+  /**
+   * @brief   Memory array.
+   */
+  uint8_t                   *mem;
+  /**
+   * @brief   Array size in bytes.
+   */
+  size_t                    size;
+  /**
+   * @brief   Page size in bytes, a power of two.
+   */
+  size_t                    pagesize;
+  /**
+   * @brief   Internal write cycle time (tWR).
+   */
+  simtime_t                 t_wr;
+  /**
+   * @brief   NACK during the write cycle instead of charging it at STOP.
+   */
+  bool                      ack_polling;
+  /**
+   * @brief   End of the current write cycle.
+   */
+  simtime_t                 busy_until;
+  /**
+   * @brief   Address pointer.
+   */
+  uint32_t                  ptr;
+  /**
+   * @brief   Address bytes still expected in the current transaction.
+   */
+  uint8_t                   addr_left;
+  /**
+   * @brief   Data bytes written in the current transaction.
+   */
+  size_t                    written;
+  /**
+   * @brief   Completed write cycles.
+   */
+  uint32_t                  write_cycles;
+} sim_ee24xx_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simEe24xxObjectInit(sim_ee24xx_t *eep, i2caddr_t addr, uint8_t *mem,
+                           size_t size, size_t pagesize, simtime_t t_wr);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_I2C */
+
+#endif /* SIM_EE24XX_H */
+
+/** @} */
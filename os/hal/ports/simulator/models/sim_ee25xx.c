@@ -0,0 +1,221 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_ee25xx.c
+ * @brief   Simulated 25xx SPI EEPROM code.
+ *
+ * @addtogroup SIM_EE25XX
+ * @{
+ */
+
+#include "hal.h"
+#include "sim_ee25xx.h"
+
+#if HAL_USE_SPI || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define CMD_WRSR            0x01U
+#define CMD_WRITE           0x02U
+#define CMD_READ            0x03U
+#define CMD_WRDI            0x04U
+#define CMD_RDSR            0x05U
+#define CMD_WREN            0x06U
+
+#define STAT_WIP            0x01U
+#define STAT_WEL            0x02U
+#define STAT_BP_MASK        0x0CU
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of address bytes following the command.
+ */
+static uint32_t ee25xx_addr_bytes(const sim_ee25xx_t *eep) {
+
+  if (eep->size > 0xFFFFU) {
+    return 3U;
+  }
+  return (eep->size > 0xFFU) ? 2U : 1U;
+}
+
+/**
+ * @brief   Tells whether an internal write cycle is running.
+ */
+static bool ee25xx_busy(const sim_ee25xx_t *eep) {
+
+  return simTimeNow() < eep->busy_until;
+}
+
+/*
+ * Bus device callbacks.
+ */
+static void ee25xx_select(sim_spi_device_t *devp) {
+  sim_ee25xx_t *eep = (sim_ee25xx_t *)devp;
+
+  eep->count   = 0U;
+  eep->ptr     = 0U;
+  eep->written = 0U;
+}
+
+static void ee25xx_unselect(sim_spi_device_t *devp) {
+  sim_ee25xx_t *eep = (sim_ee25xx_t *)devp;
+
+  if ((eep->count == 0U) || ee25xx_busy(eep)) {
+    return;
+  }
+
+  switch (eep->cmd) {
+  case CMD_WREN:
+    eep->status |= STAT_WEL;
+    break;
+  case CMD_WRDI:
+    eep->status &= ~STAT_WEL;
+    break;
+  case CMD_WRSR:
+  case CMD_WRITE:
+    if ((eep->status & STAT_WEL) == 0U) {
+      break;
+    }
+    eep->status &= ~STAT_WEL;
+    if ((eep->cmd == CMD_WRITE) && (eep->written == 0U)) {
+      break;
+    }
+    eep->write_cycles++;
+    if (eep->wip_polling) {
+      eep->busy_until = simTimeNow() + eep->t_wr;
+    }
+    else {
+      simTimeAdvance(eep->t_wr);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+static uint8_t ee25xx_exchange(sim_spi_device_t *devp, uint8_t b) {
+  sim_ee25xx_t *eep = (sim_ee25xx_t *)devp;
+  uint32_t nab = ee25xx_addr_bytes(eep);
+  uint32_t n = eep->count++;
+  uint8_t out = 0xFFU;
+
+  if (n == 0U) {
+    eep->cmd = b;
+    return out;
+  }
+
+  /* Only the status register answers during a write cycle.*/
+  if (ee25xx_busy(eep) && (eep->cmd != CMD_RDSR)) {
+    return out;
+  }
+
+  switch (eep->cmd) {
+  case CMD_RDSR:
+    out = eep->status | (ee25xx_busy(eep) ? STAT_WIP : 0U);
+    break;
+  case CMD_WRSR:
+    if ((n == 1U) && ((eep->status & STAT_WEL) != 0U)) {
+      eep->status = (eep->status & ~STAT_BP_MASK) | (b & STAT_BP_MASK);
+    }
+    break;
+  case CMD_READ:
+    if (n <= nab) {
+      eep->ptr = (eep->ptr << 8) | b;
+      if (n == nab) {
+        eep->ptr &= (uint32_t)(eep->size - 1U);
+      }
+      break;
+    }
+    out = eep->mem[eep->ptr];
+    eep->ptr = (eep->ptr + 1U) & (uint32_t)(eep->size - 1U);
+    break;
+  case CMD_WRITE:
+    if (n <= nab) {
+      eep->ptr = (eep->ptr << 8) | b;
+      if (n == nab) {
+        eep->ptr &= (uint32_t)(eep->size - 1U);
+      }
+      break;
+    }
+    if ((eep->status & STAT_WEL) == 0U) {
+      break;
+    }
+    eep->mem[eep->ptr] = b;
+    eep->ptr = (eep->ptr & ~(uint32_t)(eep->pagesize - 1U)) |
+               ((eep->ptr + 1U) & (uint32_t)(eep->pagesize - 1U));
+    eep->written++;
+    break;
+  default:
+    break;
+  }
+  return out;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a simulated 25xx EEPROM.
+ * @note    The array contents are left untouched.
+ *
+ * @param[out] eep      pointer to the @p sim_ee25xx_t object
+ * @param[in] mem       memory array
+ * @param[in] size      array size, a power of two
+ * @param[in] pagesize  page size, a power of two
+ * @param[in] t_wr      internal write cycle time
+ */
+void simEe25xxObjectInit(sim_ee25xx_t *eep, uint8_t *mem, size_t size,
+                         size_t pagesize, simtime_t t_wr) {
+
+  osalDbgCheck((mem != NULL) && (size > 0U) && ((size & (size - 1U)) == 0U));
+  osalDbgCheck((pagesize > 0U) && ((pagesize & (pagesize - 1U)) == 0U) &&
+               (pagesize <= size));
+
+  eep->dev.select   = ee25xx_select;
+  eep->dev.unselect = ee25xx_unselect;
+  eep->dev.exchange = ee25xx_exchange;
+  eep->mem          = mem;
+  eep->size         = size;
+  eep->pagesize     = pagesize;
+  eep->t_wr         = t_wr;
+  eep->wip_polling  = false;
+  eep->busy_until   = 0U;
+  eep->status       = 0U;
+  eep->cmd          = 0U;
+  eep->count        = 0U;
+  eep->ptr          = 0U;
+  eep->written      = 0U;
+  eep->write_cycles = 0U;
+}
+
+#endif /* HAL_USE_SPI */
+
+/** @} */
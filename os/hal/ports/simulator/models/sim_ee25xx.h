@@ -0,0 +1,133 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_ee25xx.h
+ * @brief   Simulated 25xx SPI EEPROM header.
+ * @details Implements WREN, WRDI, RDSR, WRSR, READ and WRITE with 1, 2 or 3
+ *          address bytes depending on the array size. WRITE requires the
+ *          write enable latch, wraps inside the page and starts the
+ *          internal cycle when the chip select is released. By default
+ *          the cycle is charged to the virtual clock on release so the
+ *          first RDSR poll already reads the device ready; set
+ *          @p wip_polling to keep WIP set until the virtual clock has
+ *          moved past the cycle.
+ *
+ * @addtogroup SIM_EE25XX
+ * @{
+ */
+
+#ifndef SIM_EE25XX_H
+#define SIM_EE25XX_H
+
+#if HAL_USE_SPI || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated 25xx EEPROM.
+ */
+typedef struct {
+  /**
+   * @brief   Bus device, must be the first field.
+   */
+  sim_spi_device_t          dev;
+  /**
+   * @brief   Memory array.
+   */
+  uint8_t                   *mem;
+  /**
+   * @brief   Array size in bytes.
+   */
+  size_t                    size;
+  /**
+   * @brief   Page size in bytes, a power of two.
+   */
+  size_t                    pagesize;
+  /**
+   * @brief   Internal write cycle time (tWC).
+   */
+  simtime_t                 t_wr;
+  /**
+   * @brief   Keep WIP set in virtual time instead of charging the cycle.
+   */
+  bool                      wip_polling;
+  /**
+   * @brief   End of the current write cycle.
+   */
+  simtime_t                 busy_until;
+  /**
+   * @brief   Status register, WEL and block protect bits.
+   */
+  uint8_t                   status;
+  /**
+   * @brief   Command of the current frame.
+   */
+  uint8_t                   cmd;
+  /**
+   * @brief   Bytes clocked since chip select.
+   */
+  uint32_t                  count;
+  /**
+   * @brief   Address pointer.
+   */
+  uint32_t                  ptr;
+  /**
+   * @brief   Data bytes written in the current frame.
+   */
+  size_t                    written;
+  /**
+   * @brief   Completed write cycles.
+   */
+  uint32_t                  write_cycles;
+} sim_ee25xx_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simEe25xxObjectInit(sim_ee25xx_t *eep, uint8_t *mem, size_t size,
+                           size_t pagesize, simtime_t t_wr);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_SPI */
+
+#endif /* SIM_EE25XX_H */
+
+/** @} */
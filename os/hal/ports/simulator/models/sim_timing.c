@@ -0,0 +1,129 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_timing.c
+ * @brief   Simulator virtual bus time model code.
+ *
+ * @addtogroup SIM_TIMING
+ * @{
+ */
+
+#include "sim_timing.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Current virtual time.
+ * @note    The simulator runs all ChibiOS threads on a single host thread
+ *          so no locking is required around this counter.
+ */
+static volatile simtime_t sim_now;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Rewinds the virtual clock to zero.
+ */
+void simTimeReset(void) {
+
+  sim_now = 0;
+}
+
+/**
+ * @brief   Returns the current virtual time.
+ *
+ * @return              The virtual time in nanoseconds.
+ */
+simtime_t simTimeNow(void) {
+
+  return sim_now;
+}
+
+/**
+ * @brief   Advances the virtual clock.
+ *
+ * @param[in] ns        time spent by the simulated hardware
+ */
+void simTimeAdvance(simtime_t ns) {
+
+  sim_now += ns;
+}
+
+/**
+ * @brief   Time needed to shift a number of bits at a given bus clock.
+ *
+ * @param[in] bits      number of bit times
+ * @param[in] hz        bus clock in Hz, zero is treated as 1Hz
+ * @return              The time in nanoseconds, rounded up.
+ */
+simtime_t simTimeBits(uint32_t bits, uint32_t hz) {
+
+  if (hz == 0U) {
+    hz = 1U;
+  }
+  return (((simtime_t)bits * SIM_NS_PER_SECOND) + hz - 1U) / hz;
+}
+
+/**
+ * @brief   Accounts a completed transaction and advances the clock.
+ *
+ * @param[in] stp       pointer to the model statistics or @p NULL
+ * @param[in] bytes     payload bytes moved by the transaction
+ * @param[in] t         virtual time taken by the transaction
+ */
+void simStatsAccount(sim_stats_t *stp, uint32_t bytes, simtime_t t) {
+
+  if (stp != NULL) {
+    stp->transactions++;
+    stp->bytes    += bytes;
+    stp->bus_time += t;
+  }
+  simTimeAdvance(t);
+}
+
+/**
+ * @brief   Average payload throughput of a model.
+ *
+ * @param[in] stp       pointer to the model statistics
+ * @return              The throughput in bytes per second of bus time.
+ */
+uint32_t simStatsThroughput(const sim_stats_t *stp) {
+
+  if (stp->bus_time == 0U) {
+    return 0U;
+  }
+  return (uint32_t)(((simtime_t)stp->bytes * SIM_NS_PER_SECOND) /
+                    stp->bus_time);
+}
+
+/** @} */
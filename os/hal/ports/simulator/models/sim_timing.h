@@ -0,0 +1,119 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    models/sim_timing.h
+ * @brief   Simulator virtual bus time model header.
+ * @details The simulated LLDs do not depend on the host scheduler for
+ *          their timing figures. Every bus transfer, memory array
+ *          operation and device busy period advances a single virtual
+ *          clock by the amount of time the real hardware would need, so
+ *          throughput and latency measured against this clock are
+ *          deterministic and reproducible on any workstation.
+ *
+ * @addtogroup SIM_TIMING
+ * @{
+ */
+
+#ifndef SIM_TIMING_H
+#define SIM_TIMING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Virtual clock resolution.
+ */
+#define SIM_NS_PER_SECOND           1000000000ULL
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Virtual time, in nanoseconds.
+ */
+typedef uint64_t simtime_t;
+
+/**
+ * @brief   Per-model counters, collected into the global statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Number of completed bus transactions.
+   */
+  uint32_t                  transactions;
+  /**
+   * @brief   Number of payload bytes moved.
+   */
+  uint32_t                  bytes;
+  /**
+   * @brief   Number of transactions refused by a busy device.
+   */
+  uint32_t                  busy;
+  /**
+   * @brief   Virtual time spent on the bus.
+   */
+  simtime_t                 bus_time;
+} sim_stats_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Converts microseconds to virtual time.
+ */
+#define SIM_US2NS(us)               ((simtime_t)(us) * 1000ULL)
+
+/**
+ * @brief   Converts milliseconds to virtual time.
+ */
+#define SIM_MS2NS(ms)               ((simtime_t)(ms) * 1000000ULL)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simTimeReset(void);
+  simtime_t simTimeNow(void);
+  void simTimeAdvance(simtime_t ns);
+  simtime_t simTimeBits(uint32_t bits, uint32_t hz);
+  void simStatsAccount(sim_stats_t *stp, uint32_t bytes, simtime_t t);
+  uint32_t simStatsThroughput(const sim_stats_t *stp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_TIMING_H */
+
+/** @} */
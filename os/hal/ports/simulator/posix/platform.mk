@@ -0,0 +1,26 @@
+# Upstream simulator platform, provides hal_lld, PAL, serial and ST.
+include ${CHIBIOS}/os/hal/ports/simulator/posix/platform.mk
+
+PLATFORMSRC_CONTRIB :=
+PLATFORMINC_CONTRIB :=
+
+ifeq ($(USE_SMART_BUILD),yes)
+
+# Configuration files directory
+ifeq ($(CONFDIR),)
+  CONFDIR = .
+endif
+
+HALCONF := $(strip $(shell cat $(CONFDIR)/halconf.h $(CONFDIR)/halconf_community.h | egrep -e "\#define"))
+
+endif
+
+include ${CHIBIOS_CONTRIB}/os/hal/ports/simulator/models/models.mk
+include ${CHIBIOS_CONTRIB}/os/hal/ports/simulator/LLD/I2Cv1/driver.mk
+include ${CHIBIOS_CONTRIB}/os/hal/ports/simulator/LLD/SPIv1/driver.mk
+include ${CHIBIOS_CONTRIB}/os/hal/ports/simulator/LLD/PWMv1/driver.mk
+include ${CHIBIOS_CONTRIB}/os/hal/ports/simulator/LLD/NANDv1/driver.mk
+
+# Shared variables
+ALLCSRC += $(PLATFORMSRC_CONTRIB)
+ALLINC  += $(PLATFORMINC_CONTRIB)
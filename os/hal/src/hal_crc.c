@@ -29,6 +29,198 @@
 /* Driver exported variables.                                                */
 /*===========================================================================*/
 
+#if (CRC_USE_CRC32_TABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC-32 table, polynomial 0x04C11DB7, reflected.
+ */
+const uint32_t crc_crc32_table[256] = {
+  0x00000000U, 0x77073096U, 0xEE0E612CU, 0x990951BAU,
+  0x076DC419U, 0x706AF48FU, 0xE963A535U, 0x9E6495A3U,
+  0x0EDB8832U, 0x79DCB8A4U, 0xE0D5E91EU, 0x97D2D988U,
+  0x09B64C2BU, 0x7EB17CBDU, 0xE7B82D07U, 0x90BF1D91U,
+  0x1DB71064U, 0x6AB020F2U, 0xF3B97148U, 0x84BE41DEU,
+  0x1ADAD47DU, 0x6DDDE4EBU, 0xF4D4B551U, 0x83D385C7U,
+  0x136C9856U, 0x646BA8C0U, 0xFD62F97AU, 0x8A65C9ECU,
+  0x14015C4FU, 0x63066CD9U, 0xFA0F3D63U, 0x8D080DF5U,
+  0x3B6E20C8U, 0x4C69105EU, 0xD56041E4U, 0xA2677172U,
+  0x3C03E4D1U, 0x4B04D447U, 0xD20D85FDU, 0xA50AB56BU,
+  0x35B5A8FAU, 0x42B2986CU, 0xDBBBC9D6U, 0xACBCF940U,
+  0x32D86CE3U, 0x45DF5C75U, 0xDCD60DCFU, 0xABD13D59U,
+  0x26D930ACU, 0x51DE003AU, 0xC8D75180U, 0xBFD06116U,
+  0x21B4F4B5U, 0x56B3C423U, 0xCFBA9599U, 0xB8BDA50FU,
+  0x2802B89EU, 0x5F058808U, 0xC60CD9B2U, 0xB10BE924U,
+  0x2F6F7C87U, 0x58684C11U, 0xC1611DABU, 0xB6662D3DU,
+  0x76DC4190U, 0x01DB7106U, 0x98D220BCU, 0xEFD5102AU,
+  0x71B18589U, 0x06B6B51FU, 0x9FBFE4A5U, 0xE8B8D433U,
+  0x7807C9A2U, 0x0F00F934U, 0x9609A88EU, 0xE10E9818U,
+  0x7F6A0DBBU, 0x086D3D2DU, 0x91646C97U, 0xE6635C01U,
+  0x6B6B51F4U, 0x1C6C6162U, 0x856530D8U, 0xF262004EU,
+  0x6C0695EDU, 0x1B01A57BU, 0x8208F4C1U, 0xF50FC457U,
+  0x65B0D9C6U, 0x12B7E950U, 0x8BBEB8EAU, 0xFCB9887CU,
+  0x62DD1DDFU, 0x15DA2D49U, 0x8CD37CF3U, 0xFBD44C65U,
+  0x4DB26158U, 0x3AB551CEU, 0xA3BC0074U, 0xD4BB30E2U,
+  0x4ADFA541U, 0x3DD895D7U, 0xA4D1C46DU, 0xD3D6F4FBU,
+  0x4369E96AU, 0x346ED9FCU, 0xAD678846U, 0xDA60B8D0U,
+  0x44042D73U, 0x33031DE5U, 0xAA0A4C5FU, 0xDD0D7CC9U,
+  0x5005713CU, 0x270241AAU, 0xBE0B1010U, 0xC90C2086U,
+  0x5768B525U, 0x206F85B3U, 0xB966D409U, 0xCE61E49FU,
+  0x5EDEF90EU, 0x29D9C998U, 0xB0D09822U, 0xC7D7A8B4U,
+  0x59B33D17U, 0x2EB40D81U, 0xB7BD5C3BU, 0xC0BA6CADU,
+  0xEDB88320U, 0x9ABFB3B6U, 0x03B6E20CU, 0x74B1D29AU,
+  0xEAD54739U, 0x9DD277AFU, 0x04DB2615U, 0x73DC1683U,
+  0xE3630B12U, 0x94643B84U, 0x0D6D6A3EU, 0x7A6A5AA8U,
+  0xE40ECF0BU, 0x9309FF9DU, 0x0A00AE27U, 0x7D079EB1U,
+  0xF00F9344U, 0x8708A3D2U, 0x1E01F268U, 0x6906C2FEU,
+  0xF762575DU, 0x806567CBU, 0x196C3671U, 0x6E6B06E7U,
+  0xFED41B76U, 0x89D32BE0U, 0x10DA7A5AU, 0x67DD4ACCU,
+  0xF9B9DF6FU, 0x8EBEEFF9U, 0x17B7BE43U, 0x60B08ED5U,
+  0xD6D6A3E8U, 0xA1D1937EU, 0x38D8C2C4U, 0x4FDFF252U,
+  0xD1BB67F1U, 0xA6BC5767U, 0x3FB506DDU, 0x48B2364BU,
+  0xD80D2BDAU, 0xAF0A1B4CU, 0x36034AF6U, 0x41047A60U,
+  0xDF60EFC3U, 0xA867DF55U, 0x316E8EEFU, 0x4669BE79U,
+  0xCB61B38CU, 0xBC66831AU, 0x256FD2A0U, 0x5268E236U,
+  0xCC0C7795U, 0xBB0B4703U, 0x220216B9U, 0x5505262FU,
+  0xC5BA3BBEU, 0xB2BD0B28U, 0x2BB45A92U, 0x5CB36A04U,
+  0xC2D7FFA7U, 0xB5D0CF31U, 0x2CD99E8BU, 0x5BDEAE1DU,
+  0x9B64C2B0U, 0xEC63F226U, 0x756AA39CU, 0x026D930AU,
+  0x9C0906A9U, 0xEB0E363FU, 0x72076785U, 0x05005713U,
+  0x95BF4A82U, 0xE2B87A14U, 0x7BB12BAEU, 0x0CB61B38U,
+  0x92D28E9BU, 0xE5D5BE0DU, 0x7CDCEFB7U, 0x0BDBDF21U,
+  0x86D3D2D4U, 0xF1D4E242U, 0x68DDB3F8U, 0x1FDA836EU,
+  0x81BE16CDU, 0xF6B9265BU, 0x6FB077E1U, 0x18B74777U,
+  0x88085AE6U, 0xFF0F6A70U, 0x66063BCAU, 0x11010B5CU,
+  0x8F659EFFU, 0xF862AE69U, 0x616BFFD3U, 0x166CCF45U,
+  0xA00AE278U, 0xD70DD2EEU, 0x4E048354U, 0x3903B3C2U,
+  0xA7672661U, 0xD06016F7U, 0x4969474DU, 0x3E6E77DBU,
+  0xAED16A4AU, 0xD9D65ADCU, 0x40DF0B66U, 0x37D83BF0U,
+  0xA9BCAE53U, 0xDEBB9EC5U, 0x47B2CF7FU, 0x30B5FFE9U,
+  0xBDBDF21CU, 0xCABAC28AU, 0x53B39330U, 0x24B4A3A6U,
+  0xBAD03605U, 0xCDD70693U, 0x54DE5729U, 0x23D967BFU,
+  0xB3667A2EU, 0xC4614AB8U, 0x5D681B02U, 0x2A6F2B94U,
+  0xB40BBE37U, 0xC30C8EA1U, 0x5A05DF1BU, 0x2D02EF8DU
+};
+#endif
+
+#if (CRC_USE_CRC16_ARC_TABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC-16/ARC table, polynomial 0x8005, reflected.
+ */
+const uint32_t crc_crc16_arc_table[256] = {
+  0x0000U, 0xC0C1U, 0xC181U, 0x0140U, 0xC301U, 0x03C0U, 0x0280U, 0xC241U,
+  0xC601U, 0x06C0U, 0x0780U, 0xC741U, 0x0500U, 0xC5C1U, 0xC481U, 0x0440U,
+  0xCC01U, 0x0CC0U, 0x0D80U, 0xCD41U, 0x0F00U, 0xCFC1U, 0xCE81U, 0x0E40U,
+  0x0A00U, 0xCAC1U, 0xCB81U, 0x0B40U, 0xC901U, 0x09C0U, 0x0880U, 0xC841U,
+  0xD801U, 0x18C0U, 0x1980U, 0xD941U, 0x1B00U, 0xDBC1U, 0xDA81U, 0x1A40U,
+  0x1E00U, 0xDEC1U, 0xDF81U, 0x1F40U, 0xDD01U, 0x1DC0U, 0x1C80U, 0xDC41U,
+  0x1400U, 0xD4C1U, 0xD581U, 0x1540U, 0xD701U, 0x17C0U, 0x1680U, 0xD641U,
+  0xD201U, 0x12C0U, 0x1380U, 0xD341U, 0x1100U, 0xD1C1U, 0xD081U, 0x1040U,
+  0xF001U, 0x30C0U, 0x3180U, 0xF141U, 0x3300U, 0xF3C1U, 0xF281U, 0x3240U,
+  0x3600U, 0xF6C1U, 0xF781U, 0x3740U, 0xF501U, 0x35C0U, 0x3480U, 0xF441U,
+  0x3C00U, 0xFCC1U, 0xFD81U, 0x3D40U, 0xFF01U, 0x3FC0U, 0x3E80U, 0xFE41U,
+  0xFA01U, 0x3AC0U, 0x3B80U, 0xFB41U, 0x3900U, 0xF9C1U, 0xF881U, 0x3840U,
+  0x2800U, 0xE8C1U, 0xE981U, 0x2940U, 0xEB01U, 0x2BC0U, 0x2A80U, 0xEA41U,
+  0xEE01U, 0x2EC0U, 0x2F80U, 0xEF41U, 0x2D00U, 0xEDC1U, 0xEC81U, 0x2C40U,
+  0xE401U, 0x24C0U, 0x2580U, 0xE541U, 0x2700U, 0xE7C1U, 0xE681U, 0x2640U,
+  0x2200U, 0xE2C1U, 0xE381U, 0x2340U, 0xE101U, 0x21C0U, 0x2080U, 0xE041U,
+  0xA001U, 0x60C0U, 0x6180U, 0xA141U, 0x6300U, 0xA3C1U, 0xA281U, 0x6240U,
+  0x6600U, 0xA6C1U, 0xA781U, 0x6740U, 0xA501U, 0x65C0U, 0x6480U, 0xA441U,
+  0x6C00U, 0xACC1U, 0xAD81U, 0x6D40U, 0xAF01U, 0x6FC0U, 0x6E80U, 0xAE41U,
+  0xAA01U, 0x6AC0U, 0x6B80U, 0xAB41U, 0x6900U, 0xA9C1U, 0xA881U, 0x6840U,
+  0x7800U, 0xB8C1U, 0xB981U, 0x7940U, 0xBB01U, 0x7BC0U, 0x7A80U, 0xBA41U,
+  0xBE01U, 0x7EC0U, 0x7F80U, 0xBF41U, 0x7D00U, 0xBDC1U, 0xBC81U, 0x7C40U,
+  0xB401U, 0x74C0U, 0x7580U, 0xB541U, 0x7700U, 0xB7C1U, 0xB681U, 0x7640U,
+  0x7200U, 0xB2C1U, 0xB381U, 0x7340U, 0xB101U, 0x71C0U, 0x7080U, 0xB041U,
+  0x5000U, 0x90C1U, 0x9181U, 0x5140U, 0x9301U, 0x53C0U, 0x5280U, 0x9241U,
+  0x9601U, 0x56C0U, 0x5780U, 0x9741U, 0x5500U, 0x95C1U, 0x9481U, 0x5440U,
+  0x9C01U, 0x5CC0U, 0x5D80U, 0x9D41U, 0x5F00U, 0x9FC1U, 0x9E81U, 0x5E40U,
+  0x5A00U, 0x9AC1U, 0x9B81U, 0x5B40U, 0x9901U, 0x59C0U, 0x5880U, 0x9841U,
+  0x8801U, 0x48C0U, 0x4980U, 0x8941U, 0x4B00U, 0x8BC1U, 0x8A81U, 0x4A40U,
+  0x4E00U, 0x8EC1U, 0x8F81U, 0x4F40U, 0x8D01U, 0x4DC0U, 0x4C80U, 0x8C41U,
+  0x4400U, 0x84C1U, 0x8581U, 0x4540U, 0x8701U, 0x47C0U, 0x4680U, 0x8641U,
+  0x8201U, 0x42C0U, 0x4380U, 0x8341U, 0x4100U, 0x81C1U, 0x8081U, 0x4040U
+};
+#endif
+
+#if (CRC_USE_CRC16_CCITT_TABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC-16/CCITT table, polynomial 0x1021, not reflected.
+ */
+const uint32_t crc_crc16_ccitt_table[256] = {
+  0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+  0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+  0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+  0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+  0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+  0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+  0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+  0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+  0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+  0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+  0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+  0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+  0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+  0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+  0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+  0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+  0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+  0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+  0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+  0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+  0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+  0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+  0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+  0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+  0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+  0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+  0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+  0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+  0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+  0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+  0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+  0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U
+};
+#endif
+
+#if (CRC_USE_CRC8_TABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC-8 table, polynomial 0x07, not reflected.
+ */
+const uint32_t crc_crc8_table[256] = {
+  0x00U, 0x07U, 0x0EU, 0x09U, 0x1CU, 0x1BU, 0x12U, 0x15U,
+  0x38U, 0x3FU, 0x36U, 0x31U, 0x24U, 0x23U, 0x2AU, 0x2DU,
+  0x70U, 0x77U, 0x7EU, 0x79U, 0x6CU, 0x6BU, 0x62U, 0x65U,
+  0x48U, 0x4FU, 0x46U, 0x41U, 0x54U, 0x53U, 0x5AU, 0x5DU,
+  0xE0U, 0xE7U, 0xEEU, 0xE9U, 0xFCU, 0xFBU, 0xF2U, 0xF5U,
+  0xD8U, 0xDFU, 0xD6U, 0xD1U, 0xC4U, 0xC3U, 0xCAU, 0xCDU,
+  0x90U, 0x97U, 0x9EU, 0x99U, 0x8CU, 0x8BU, 0x82U, 0x85U,
+  0xA8U, 0xAFU, 0xA6U, 0xA1U, 0xB4U, 0xB3U, 0xBAU, 0xBDU,
+  0xC7U, 0xC0U, 0xC9U, 0xCEU, 0xDBU, 0xDCU, 0xD5U, 0xD2U,
+  0xFFU, 0xF8U, 0xF1U, 0xF6U, 0xE3U, 0xE4U, 0xEDU, 0xEAU,
+  0xB7U, 0xB0U, 0xB9U, 0xBEU, 0xABU, 0xACU, 0xA5U, 0xA2U,
+  0x8FU, 0x88U, 0x81U, 0x86U, 0x93U, 0x94U, 0x9DU, 0x9AU,
+  0x27U, 0x20U, 0x29U, 0x2EU, 0x3BU, 0x3CU, 0x35U, 0x32U,
+  0x1FU, 0x18U, 0x11U, 0x16U, 0x03U, 0x04U, 0x0DU, 0x0AU,
+  0x57U, 0x50U, 0x59U, 0x5EU, 0x4BU, 0x4CU, 0x45U, 0x42U,
+  0x6FU, 0x68U, 0x61U, 0x66U, 0x73U, 0x74U, 0x7DU, 0x7AU,
+  0x89U, 0x8EU, 0x87U, 0x80U, 0x95U, 0x92U, 0x9BU, 0x9CU,
+  0xB1U, 0xB6U, 0xBFU, 0xB8U, 0xADU, 0xAAU, 0xA3U, 0xA4U,
+  0xF9U, 0xFEU, 0xF7U, 0xF0U, 0xE5U, 0xE2U, 0xEBU, 0xECU,
+  0xC1U, 0xC6U, 0xCFU, 0xC8U, 0xDDU, 0xDAU, 0xD3U, 0xD4U,
+  0x69U, 0x6EU, 0x67U, 0x60U, 0x75U, 0x72U, 0x7BU, 0x7CU,
+  0x51U, 0x56U, 0x5FU, 0x58U, 0x4DU, 0x4AU, 0x43U, 0x44U,
+  0x19U, 0x1EU, 0x17U, 0x10U, 0x05U, 0x02U, 0x0BU, 0x0CU,
+  0x21U, 0x26U, 0x2FU, 0x28U, 0x3DU, 0x3AU, 0x33U, 0x34U,
+  0x4EU, 0x49U, 0x40U, 0x47U, 0x52U, 0x55U, 0x5CU, 0x5BU,
+  0x76U, 0x71U, 0x78U, 0x7FU, 0x6AU, 0x6DU, 0x64U, 0x63U,
+  0x3EU, 0x39U, 0x30U, 0x37U, 0x22U, 0x25U, 0x2CU, 0x2BU,
+  0x06U, 0x01U, 0x08U, 0x0FU, 0x1AU, 0x1DU, 0x14U, 0x13U,
+  0xAEU, 0xA9U, 0xA0U, 0xA7U, 0xB2U, 0xB5U, 0xBCU, 0xBBU,
+  0x96U, 0x91U, 0x98U, 0x9FU, 0x8AU, 0x8DU, 0x84U, 0x83U,
+  0xDEU, 0xD9U, 0xD0U, 0xD7U, 0xC2U, 0xC5U, 0xCCU, 0xCBU,
+  0xE6U, 0xE1U, 0xE8U, 0xEFU, 0xFAU, 0xFDU, 0xF4U, 0xF3U
+};
+#endif
+
 /*===========================================================================*/
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
@@ -37,6 +229,132 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (CRC_USE_CONTEXTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Reverses the bit order of the low @p bits bits of a value.
+ */
+static uint32_t crc_reflect(uint32_t value, uint32_t bits) {
+  uint32_t r = 0U;
+
+  while (bits-- > 0U) {
+    r = (r << 1) | (value & 1U);
+    value >>= 1;
+  }
+  return r;
+}
+
+/**
+ * @brief   Mask of the register bits for a polynomial size.
+ */
+static uint32_t crc_mask(const CRCConfig *config) {
+  return 0xFFFFFFFFU >> (32U - config->poly_size);
+}
+
+/**
+ * @brief   Tells whether the table engine can compute a configuration.
+ * @details The table engine shifts whole bytes, in one direction, so the
+ *          input and the output must be reflected alike and the register
+ *          must be at least one byte wide.
+ */
+static bool crc_table_capable(const CRCConfig *config) {
+  return (config->poly_size >= 8U) &&
+         (config->reflect_data == config->reflect_remainder);
+}
+
+/**
+ * @brief   Bitwise engine, also the reference for the other two.
+ * @note    The register is kept in the normal, MSB first, form.
+ */
+static uint32_t crc_update_bitwise(const CRCConfig *config, uint32_t crc,
+                                   size_t n, const uint8_t *p) {
+  uint32_t top = 1U << (config->poly_size - 1U);
+  uint32_t mask = crc_mask(config);
+
+  while (n-- > 0U) {
+    uint32_t data = *p++;
+    unsigned i;
+
+    if (config->reflect_data) {
+      data = crc_reflect(data, 8U);
+    }
+    for (i = 0U; i < 8U; i++) {
+      bool feedback = ((crc & top) != 0U) != ((data & 0x80U) != 0U);
+
+      crc = (crc << 1) & mask;
+      if (feedback) {
+        crc ^= config->poly;
+      }
+      data <<= 1;
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief   Table engine.
+ * @note    The register is kept reflected when the configuration is.
+ */
+static uint32_t crc_update_table(const CRCConfig *config,
+                                 const uint32_t *table, uint32_t crc,
+                                 size_t n, const uint8_t *p) {
+
+  if (config->reflect_data) {
+    while (n-- > 0U) {
+      crc = table[(crc ^ *p++) & 0xFFU] ^ (crc >> 8);
+    }
+  }
+  else {
+    uint32_t shift = config->poly_size - 8U;
+    uint32_t mask = crc_mask(config);
+
+    while (n-- > 0U) {
+      crc = (table[((crc >> shift) ^ *p++) & 0xFFU] ^ (crc << 8)) & mask;
+    }
+  }
+  return crc;
+}
+
+#if (CRC_LLD_SUPPORTS_CONTEXTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Runs a context update on the CRC unit.
+ * @details The unit is loaded with the context parameters and value, fed,
+ *          and its register is read back. The driver configuration is then
+ *          put back so that plain @p crcCalc() users find the unit as
+ *          after a @p crcReset().
+ */
+static uint32_t crc_update_unit(CRCContext *ctxp, size_t n, const void *buf) {
+  CRCDriver *crcp = ctxp->crcp;
+  const CRCConfig *saved;
+  uint32_t crc;
+
+#if CRC_USE_MUTUAL_EXCLUSION == TRUE
+  crcAcquireUnit(crcp);
+#endif
+
+  osalSysLock();
+  osalDbgAssert(crcp->state == CRC_READY, "not ready");
+  saved = crcp->config;
+  crcp->config = ctxp->config;
+  crc_lld_load(crcp, ctxp->value);
+  osalSysUnlock();
+
+  (void) crcCalc(crcp, n, buf);
+
+  osalSysLock();
+  crc = crc_lld_save(crcp);
+  crcp->config = saved;
+  crc_lld_load(crcp, saved->initial_val);
+  osalSysUnlock();
+
+#if CRC_USE_MUTUAL_EXCLUSION == TRUE
+  crcReleaseUnit(crcp);
+#endif
+
+  return crc;
+}
+#endif
+#endif /* CRC_USE_CONTEXTS == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -261,4 +579,196 @@ void crcReleaseUnit(CRCDriver *crcp) {
 }
 #endif /* CRC_USE_MUTUAL_EXCLUSION == TRUE */
 
+#if (CRC_USE_CONTEXTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Builds the lookup table of the software table engine.
+ * @details The table depends only on the polynomial, its size and the
+ *          reflection, contexts with the same parameters can share it.
+ * @note    Common polynomials have constant tables in flash, see the
+ *          @p CRC_USE_CRC32_TABLE option and the following ones.
+ *
+ * @param[in] config    CRC parameters
+ * @param[out] table    256 entries table
+ * @return              The operation status.
+ * @retval false        if the table was built.
+ * @retval true         if the configuration needs the bitwise engine,
+ *                      see @p crcContextObjectInit().
+ *
+ * @api
+ */
+bool crcGenerateTable(const CRCConfig *config, uint32_t *table) {
+  uint32_t i, b;
+
+  osalDbgCheck((config != NULL) && (table != NULL));
+
+  if (!crc_table_capable(config)) {
+    return HAL_FAILED;
+  }
+
+  if (config->reflect_data) {
+    uint32_t poly = crc_reflect(config->poly, config->poly_size);
+
+    for (i = 0U; i < 256U; i++) {
+      uint32_t crc = i;
+
+      for (b = 0U; b < 8U; b++) {
+        crc = (crc & 1U) ? (crc >> 1) ^ poly : (crc >> 1);
+      }
+      table[i] = crc;
+    }
+  }
+  else {
+    uint32_t top = 1U << (config->poly_size - 1U);
+    uint32_t mask = crc_mask(config);
+
+    for (i = 0U; i < 256U; i++) {
+      uint32_t crc = i << (config->poly_size - 8U);
+
+      for (b = 0U; b < 8U; b++) {
+        crc = ((crc & top) ? (crc << 1) ^ config->poly : (crc << 1)) & mask;
+      }
+      table[i] = crc;
+    }
+  }
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Initializes a CRC context.
+ * @details The engine is chosen once, here:
+ *          - the CRC unit, when @p crcp is not @p NULL and its low level
+ *            driver can save and restore the unit state for this polynomial,
+ *          - the table engine, when @p table is not @p NULL,
+ *          - the bitwise engine otherwise, or when the configuration
+ *            reflects the input and the output differently.
+ *          .
+ * @note    The CRC unit must have been started, it can be shared by any
+ *          number of contexts. The @p end_cb of @p config, if any, must be
+ *          @p NULL.
+ *
+ * @param[out] ctxp     pointer to the @p CRCContext object
+ * @param[in] config    CRC parameters, only the mandatory fields are used
+ * @param[in] crcp      CRC unit to offload to or @p NULL
+ * @param[in] table     constant table, table built by @p crcGenerateTable()
+ *                      or @p NULL
+ *
+ * @init
+ */
+void crcContextObjectInit(CRCContext *ctxp, const CRCConfig *config,
+                          CRCDriver *crcp, const uint32_t *table) {
+
+  osalDbgCheck((ctxp != NULL) && (config != NULL) &&
+               (config->poly_size >= 1U) && (config->poly_size <= 32U));
+
+  ctxp->config = config;
+  ctxp->table  = NULL;
+  ctxp->crcp   = NULL;
+#if CRC_LLD_SUPPORTS_CONTEXTS == TRUE
+  if ((crcp != NULL) && crc_lld_can_offload(config)) {
+    ctxp->engine = CRC_ENGINE_UNIT;
+    ctxp->crcp   = crcp;
+  }
+  else
+#else
+  (void)crcp;
+#endif
+  if ((table != NULL) && crc_table_capable(config)) {
+    /* The entry of the top input bit is the polynomial itself.*/
+    osalDbgAssert(config->reflect_data ?
+                  table[0x80U] == crc_reflect(config->poly, config->poly_size) :
+                  table[0x01U] == config->poly,
+                  "table does not match the polynomial");
+    ctxp->engine = CRC_ENGINE_TABLE;
+    ctxp->table  = table;
+  }
+  else {
+    ctxp->engine = CRC_ENGINE_BITWISE;
+  }
+
+  crcContextReset(ctxp);
+}
+
+/**
+ * @brief   Restarts a CRC context from the initial value.
+ *
+ * @param[in] ctxp      pointer to the @p CRCContext object
+ *
+ * @api
+ */
+void crcContextReset(CRCContext *ctxp) {
+  const CRCConfig *config;
+
+  osalDbgCheck(ctxp != NULL);
+
+  config = ctxp->config;
+  ctxp->value = config->initial_val & crc_mask(config);
+  if ((ctxp->engine == CRC_ENGINE_TABLE) && config->reflect_data) {
+    ctxp->value = crc_reflect(ctxp->value, config->poly_size);
+  }
+}
+
+/**
+ * @brief   Adds data to a CRC context.
+ * @note    With the @p CRC_ENGINE_UNIT engine the unit is acquired for the
+ *          duration of the call and, when @p CRC_USE_DMA is enabled,
+ *          buffers of at least @p CRC_DMA_THRESHOLD bytes are fed by DMA.
+ *
+ * @param[in] ctxp      pointer to the @p CRCContext object
+ * @param[in] n         number of bytes
+ * @param[in] buf       pointer to the data
+ *
+ * @api
+ */
+void crcContextUpdate(CRCContext *ctxp, size_t n, const void *buf) {
+
+  osalDbgCheck((ctxp != NULL) && ((n == 0U) || (buf != NULL)));
+
+  if (n == 0U) {
+    return;
+  }
+
+  switch (ctxp->engine) {
+#if CRC_LLD_SUPPORTS_CONTEXTS == TRUE
+  case CRC_ENGINE_UNIT:
+    ctxp->value = crc_update_unit(ctxp, n, buf);
+    break;
+#endif
+  case CRC_ENGINE_TABLE:
+    ctxp->value = crc_update_table(ctxp->config, ctxp->table, ctxp->value,
+                                   n, (const uint8_t *)buf);
+    break;
+  default:
+    ctxp->value = crc_update_bitwise(ctxp->config, ctxp->value,
+                                     n, (const uint8_t *)buf);
+    break;
+  }
+}
+
+/**
+ * @brief   Returns the CRC of the data added since the last reset.
+ * @note    The context is not modified, more data can be added.
+ *
+ * @param[in] ctxp      pointer to the @p CRCContext object
+ * @return              The CRC, reflected and xor-ed as configured.
+ *
+ * @api
+ */
+uint32_t crcContextGet(const CRCContext *ctxp) {
+  const CRCConfig *config;
+  uint32_t crc;
+
+  osalDbgCheck(ctxp != NULL);
+
+  config = ctxp->config;
+  crc = ctxp->value;
+
+  /* Only the table engine keeps a reflected register.*/
+  if ((ctxp->engine != CRC_ENGINE_TABLE) && config->reflect_remainder) {
+    crc = crc_reflect(crc, config->poly_size);
+  }
+  return (crc ^ config->final_val) & crc_mask(config);
+}
+#endif /* CRC_USE_CONTEXTS == TRUE */
+
 #endif /* HAL_USE_CRC */
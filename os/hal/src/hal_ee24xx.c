@@ -171,6 +171,8 @@ static msg_t eeprom_write(const I2CEepromFileConfig *eepcfg, uint32_t offset,
   i2cAcquireBus(eepcfg->i2cp);
 #endif
 
+  _hal_trace_point(HAL_TRACE_MODULE_EE24XX, HAL_TRACE_EE24XX_PAGE_WRITE_START,
+                   eepcfg->addr, offset, len);
   status = i2cMasterTransmitTimeout(eepcfg->i2cp, eepcfg->addr,
                                     eepcfg->write_buf, (len + 2), NULL, 0, tmo);
 
@@ -180,6 +182,8 @@ static msg_t eeprom_write(const I2CEepromFileConfig *eepcfg, uint32_t offset,
 
   /* wait until EEPROM process data */
   chThdSleep(eepcfg->write_time);
+  _hal_trace_point(HAL_TRACE_MODULE_EE24XX, HAL_TRACE_EE24XX_PAGE_WRITE_END,
+                   eepcfg->addr, offset, status);
 
   return status;
 }
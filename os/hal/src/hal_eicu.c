@@ -150,4 +150,57 @@ void eicuDisable(EICUDriver *eicup) {
   osalSysUnlock();
 }
 
+#if (EICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts streaming the captures of a channel.
+ * @details The capture register of the channel is moved by DMA into a
+ *          circular buffer, the @p stream_cb callback is invoked each time
+ *          a half of the buffer has been filled. Channels in
+ *          @p EICU_INPUT_EDGE mode stream their active edges, channels in
+ *          the other modes stream both edges.
+ * @note    When both edges are streamed the first sample is the first edge
+ *          seen after the start, read the input level before starting in
+ *          order to know whether it is an active or an idle edge.
+ * @note    The samples are raw counter values, see the @p capstats module
+ *          for converting them into periods and widths.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ * @param[in] channel   Channel to be streamed, it must be configured
+ * @param[out] buf      Circular buffer
+ * @param[in] n         Number of samples in the buffer, it must be even
+ *
+ * @api
+ */
+void eicuStartStream(EICUDriver *eicup, eicuchannel_t channel,
+                     eicusample_t *buf, size_t n) {
+
+  osalDbgCheck((eicup != NULL) && (channel < EICU_CHANNEL_ENUM_END) &&
+               (buf != NULL) && (n >= 2U) && ((n & 1U) == 0U));
+
+  osalSysLock();
+  osalDbgAssert(eicup->state == EICU_READY, "invalid state");
+  eicu_lld_start_stream(eicup, channel, buf, n);
+  eicup->state = EICU_STREAMING;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops streaming.
+ *
+ * @param[in] eicup     Pointer to the @p EICUDriver object
+ *
+ * @api
+ */
+void eicuStopStream(EICUDriver *eicup) {
+
+  osalDbgCheck(eicup != NULL);
+
+  osalSysLock();
+  osalDbgAssert(eicup->state == EICU_STREAMING, "invalid state");
+  eicu_lld_stop_stream(eicup);
+  eicup->state = EICU_READY;
+  osalSysUnlock();
+}
+#endif /* EICU_USE_DMA == TRUE */
+
 #endif /* HAL_USE_EICU */
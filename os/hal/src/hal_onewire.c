@@ -34,6 +34,13 @@
 
 For data write it is only master channel needed. Data bit width updates
 on every timer overflow event.
+
+3) UART backend (ONEWIRE_USE_UART). TX pin in open drain mode wired to RX,
+   every time slot is one UART character and the echo carries the bus state:
+   0xFF writes 1 or reads a bit, 0x00 writes 0, received 0xFF means 1.
+   Reset pulse is 0xF0 at 9600 baud (0x80 at 115200 for overdrive), any
+   other echo means presence. Slots are moved by the UART driver so with
+   DMA capable UART there is no per bit interrupt at all.
 */
 
 /*===========================================================================*/
@@ -80,7 +87,40 @@ on every timer overflow event.
 #define ONEWIRE_RESET_LOW_WIDTH       480
 #define ONEWIRE_RESET_SAMPLE_WIDTH    550
 #define ONEWIRE_RESET_TOTAL_WIDTH     960
+#define ONEWIRE_RESET_RELEASE_US      500
+
+/**
+ * @brief     Overdrive pulse width constants in microseconds.
+ * @note      Sample point is 2us after slot start, so interrupt latency of
+ *            the sample channel must stay well below 1us. Use UART backend
+ *            if the MCU can not guarantee that.
+ */
+#define ONEWIRE_OD_ZERO_WIDTH         8
+#define ONEWIRE_OD_ONE_WIDTH          1
+#define ONEWIRE_OD_SAMPLE_WIDTH       2
+#define ONEWIRE_OD_RECOVERY_WIDTH     2
+#define ONEWIRE_OD_RESET_LOW_WIDTH    70
+#define ONEWIRE_OD_RESET_SAMPLE_WIDTH 79
+#define ONEWIRE_OD_RESET_RELEASE_US   50
+
+/**
+ * @brief     UART backend reset characters.
+ */
+#define ONEWIRE_UART_RESET            0xF0
+#define ONEWIRE_OD_UART_RESET         0x80
+
+/**
+ * @brief     UART backend time slot characters.
+ */
+#define ONEWIRE_UART_BIT_0            0x00
+#define ONEWIRE_UART_BIT_1            0xFF
+
+/**
+ * @brief     UART backend transfer timeout.
+ */
+#define ONEWIRE_UART_TIMEOUT          TIME_MS2I(100)
 
+#if !ONEWIRE_USE_UART
 /**
  * @brief     Local function declarations.
  */
@@ -94,6 +134,7 @@ static void pwm_write_bit_cb(PWMDriver *pwmp);
 static void ow_search_rom_cb(PWMDriver *pwmp, onewireDriver *owp);
 static void pwm_search_rom_cb(PWMDriver *pwmp);
 #endif
+#endif /* !ONEWIRE_USE_UART */
 
 /*===========================================================================*/
 /* Driver exported variables.                                                */
@@ -144,9 +185,60 @@ static const uint8_t onewire_crc_table[256] = {
     0xb6, 0xe8, 0xa,  0x54, 0xd7, 0x89, 0x6b, 0x35
 };
 
+#if !ONEWIRE_USE_UART
+/**
+ * @brief     Time slot widths of single bus speed in PWM clock cycles.
+ */
+typedef struct {
+  pwmcnt_t      zero;
+  pwmcnt_t      one;
+  pwmcnt_t      sample;
+  pwmcnt_t      recovery;
+  pwmcnt_t      reset_low;
+  pwmcnt_t      reset_sample;
+  /**
+   * @brief   Time needed to slaves for presence pulse release in us.
+   */
+  uint32_t      reset_release;
+} onewire_timing_t;
+
+/**
+ * @brief     Time slot widths indexed by @p onewire_speed_t.
+ */
+static const onewire_timing_t onewire_timing[2] = {
+  {
+    ONEWIRE_ZERO_WIDTH,
+    ONEWIRE_ONE_WIDTH,
+    ONEWIRE_SAMPLE_WIDTH,
+    ONEWIRE_RECOVERY_WIDTH,
+    ONEWIRE_RESET_LOW_WIDTH,
+    ONEWIRE_RESET_SAMPLE_WIDTH,
+    ONEWIRE_RESET_RELEASE_US
+  },
+  {
+    ONEWIRE_OD_ZERO_WIDTH,
+    ONEWIRE_OD_ONE_WIDTH,
+    ONEWIRE_OD_SAMPLE_WIDTH,
+    ONEWIRE_OD_RECOVERY_WIDTH,
+    ONEWIRE_OD_RESET_LOW_WIDTH,
+    ONEWIRE_OD_RESET_SAMPLE_WIDTH,
+    ONEWIRE_OD_RESET_RELEASE_US
+  }
+};
+#endif /* !ONEWIRE_USE_UART */
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
+#if !ONEWIRE_USE_UART
+/**
+ * @brief     Returns time slot widths of current bus speed.
+ */
+static const onewire_timing_t *ow_timing(const onewireDriver *owp) {
+
+  return &onewire_timing[owp->reg.speed];
+}
+
 /**
  * @brief     Put bus in idle mode.
  */
@@ -229,11 +321,11 @@ static void ow_write_bit_I(onewireDriver *owp, ioline_t bit) {
   osalSysLockFromISR();
   if (0 == bit) {
     pwmEnableChannelI(owp->config->pwmd, owp->config->master_channel,
-                      ONEWIRE_ZERO_WIDTH);
+                      ow_timing(owp)->zero);
   }
   else {
     pwmEnableChannelI(owp->config->pwmd, owp->config->master_channel,
-                      ONEWIRE_ONE_WIDTH);
+                      ow_timing(owp)->one);
   }
   osalSysUnlockFromISR();
 #endif
@@ -340,6 +432,7 @@ static void ow_write_bit_cb(PWMDriver *pwmp, onewireDriver *owp) {
   ow_write_bit_I(owp, (*owp->buf >> owp->reg.bit) & 1);
   owp->reg.bit++;
 }
+#endif /* !ONEWIRE_USE_UART */
 
 #if ONEWIRE_USE_SEARCH_ROM
 /**
@@ -422,6 +515,7 @@ static uint8_t collision_handler(onewire_search_rom_t *sr) {
   }
 }
 
+#if !ONEWIRE_USE_UART
 /**
  * @brief     1-wire search ROM callback.
  * @note      Must be called from PWM's ISR.
@@ -495,6 +589,7 @@ THE_END:
   osalSysUnlockFromISR();
 #endif
 }
+#endif /* !ONEWIRE_USE_UART */
 
 /**
  * @brief       Helper function. Initialize structures required by 'search ROM'.
@@ -532,6 +627,241 @@ static void search_clean_iteration(onewire_search_rom_t *sr) {
 }
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
+#if ONEWIRE_USE_UART
+/**
+ * @brief     UART receive end callback.
+ * @note      Echo of the last slot ends the transfer.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ *
+ * @notapi
+ */
+static void ow_uart_rxend_cb(UARTDriver *uartp) {
+
+  (void)uartp;
+
+  osalSysLockFromISR();
+  osalThreadResumeI(&OWD1.thread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief     Switches UART to the bit rate needed by next slots.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] cfg       pointer to the @p UARTConfig object
+ *
+ * @notapi
+ */
+static void ow_uart_set_config(onewireDriver *owp, UARTConfig *cfg) {
+
+  if (owp->uartcfg != cfg) {
+    owp->uartcfg = cfg;
+    uartStart(owp->config->uartd, cfg);
+  }
+}
+
+/**
+ * @brief     Transmits time slots and collects their echo in place.
+ * @note      Safe in place because every character is received after
+ *            it was fetched for transmission.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] n         number of slots in @p slots buffer
+ *
+ * @return              Operation status.
+ * @retval MSG_OK       all slots echoed.
+ * @retval MSG_TIMEOUT  timeout, bus or UART failure.
+ *
+ * @notapi
+ */
+static msg_t ow_uart_exchange(onewireDriver *owp, size_t n) {
+  UARTDriver *uartp = owp->config->uartd;
+  msg_t msg;
+
+  osalSysLock();
+  uartStartReceiveI(uartp, n, owp->slots);
+  uartStartSendI(uartp, n, owp->slots);
+  msg = osalThreadSuspendTimeoutS(&owp->thread, ONEWIRE_UART_TIMEOUT);
+  if (MSG_OK != msg) {
+    (void)uartStopSendI(uartp);
+    (void)uartStopReceiveI(uartp);
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief     Generates reset pulse using UART backend.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ *
+ * @return              Bool flag denoting device presence.
+ *
+ * @notapi
+ */
+static bool ow_uart_reset(onewireDriver *owp) {
+  const onewireConfig *cfg = owp->config;
+  uint8_t pulse;
+  bool ok;
+
+  if (ONEWIRE_SPEED_OVERDRIVE == owp->reg.speed) {
+    pulse = ONEWIRE_OD_UART_RESET;
+    ow_uart_set_config(owp, cfg->uartcfg_od_reset);
+  }
+  else {
+    pulse = ONEWIRE_UART_RESET;
+    ow_uart_set_config(owp, cfg->uartcfg_reset);
+  }
+
+  owp->slots[0] = pulse;
+  ok = (MSG_OK == ow_uart_exchange(owp, 1));
+
+  if (ONEWIRE_SPEED_OVERDRIVE == owp->reg.speed)
+    ow_uart_set_config(owp, cfg->uartcfg_od_data);
+  else
+    ow_uart_set_config(owp, cfg->uartcfg_data);
+
+  /* pulled down echo means presence, nothing at all means short circuit */
+  return ok && (pulse != owp->slots[0]) && (0 != owp->slots[0]);
+}
+
+/**
+ * @brief     Writes bytes using UART backend.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] txbuf     pointer to the buffer with data to be written
+ * @param[in] txbytes   amount of data to be written
+ *
+ * @return              Operation status.
+ * @retval MSG_OK       all bytes written.
+ * @retval MSG_TIMEOUT  timeout, bus or UART failure.
+ *
+ * @notapi
+ */
+static msg_t ow_uart_write(onewireDriver *owp, const uint8_t *txbuf,
+                           size_t txbytes) {
+  size_t i, n;
+
+  while (txbytes > 0) {
+    n = txbytes;
+    if (n > (ONEWIRE_UART_BUFFER_SIZE / 8U))
+      n = ONEWIRE_UART_BUFFER_SIZE / 8U;
+
+    for (i=0; i<(n * 8U); i++) {
+      if (0 != ((txbuf[i / 8U] >> (i % 8U)) & 1U))
+        owp->slots[i] = ONEWIRE_UART_BIT_1;
+      else
+        owp->slots[i] = ONEWIRE_UART_BIT_0;
+    }
+    if (MSG_OK != ow_uart_exchange(owp, n * 8U))
+      return MSG_TIMEOUT;
+
+    txbuf += n;
+    txbytes -= n;
+  }
+  return MSG_OK;
+}
+
+/**
+ * @brief     Reads bytes using UART backend.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[out] rxbuf    pointer to the zeroed buffer for read data
+ * @param[in] rxbytes   amount of data to be received
+ *
+ * @return              Operation status.
+ * @retval MSG_OK       all bytes read.
+ * @retval MSG_TIMEOUT  timeout, bus or UART failure.
+ *
+ * @notapi
+ */
+static msg_t ow_uart_read(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
+  size_t i, n;
+
+  while (rxbytes > 0) {
+    n = rxbytes;
+    if (n > (ONEWIRE_UART_BUFFER_SIZE / 8U))
+      n = ONEWIRE_UART_BUFFER_SIZE / 8U;
+
+    memset(owp->slots, ONEWIRE_UART_BIT_1, n * 8U);
+    if (MSG_OK != ow_uart_exchange(owp, n * 8U))
+      return MSG_TIMEOUT;
+
+    for (i=0; i<(n * 8U); i++) {
+      if (ONEWIRE_UART_BIT_1 == owp->slots[i])
+        rxbuf[i / 8U] |= 1U << (i % 8U);
+    }
+
+    rxbuf += n;
+    rxbytes -= n;
+  }
+  return MSG_OK;
+}
+
+#if ONEWIRE_USE_SEARCH_ROM
+/**
+ * @brief     Single 'search ROM' pass using UART backend.
+ * @details   Same algorithm as @p ow_search_rom_cb() but bit triplets are
+ *            exchanged from thread context.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ *
+ * @notapi
+ */
+static void ow_uart_search_rom(onewireDriver *owp) {
+  onewire_search_rom_t *sr = &owp->search_rom;
+  uint8_t bit;
+
+  while (sr->reg.rombit < 64) {
+    owp->slots[0] = ONEWIRE_UART_BIT_1;
+    owp->slots[1] = ONEWIRE_UART_BIT_1;
+    if (MSG_OK != ow_uart_exchange(owp, 2)) {
+      sr->reg.result = ONEWIRE_SEARCH_ROM_ERROR;
+      return;
+    }
+    sr->reg.bit_buf = (ONEWIRE_UART_BIT_1 == owp->slots[0]) |
+                      ((ONEWIRE_UART_BIT_1 == owp->slots[1]) << 1);
+
+    switch(sr->reg.bit_buf){
+    case 0b11:
+      /* no one device on bus or any other fail happened */
+      sr->reg.result = ONEWIRE_SEARCH_ROM_ERROR;
+      return;
+    case 0b01:
+      /* all slaves have 1 in this position */
+      store_bit(sr, 1);
+      bit = 1;
+      break;
+    case 0b10:
+      /* all slaves have 0 in this position */
+      store_bit(sr, 0);
+      bit = 0;
+      break;
+    default:
+      /* collision */
+      sr->reg.single_device = false;
+      bit = collision_handler(sr);
+      break;
+    }
+
+    owp->slots[0] = (0 == bit) ? ONEWIRE_UART_BIT_0 : ONEWIRE_UART_BIT_1;
+    if (MSG_OK != ow_uart_exchange(owp, 1)) {
+      sr->reg.result = ONEWIRE_SEARCH_ROM_ERROR;
+      return;
+    }
+  }
+
+  /* one ROM successfully discovered */
+  sr->reg.devices_found++;
+  sr->reg.search_iter = ONEWIRE_SEARCH_ROM_NEXT;
+  if (true == sr->reg.single_device)
+    sr->reg.result = ONEWIRE_SEARCH_ROM_LAST;
+}
+#endif /* ONEWIRE_USE_SEARCH_ROM */
+#endif /* ONEWIRE_USE_UART */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -573,8 +903,16 @@ void onewireObjectInit(onewireDriver *owp) {
   owp->reg.bytes = 0;
   owp->reg.bit = 0;
   owp->reg.final_timeslot = false;
+  owp->reg.speed = ONEWIRE_SPEED_STANDARD;
   owp->buf = NULL;
 
+#if ONEWIRE_USE_SEARCH_ROM
+  owp->roms = NULL;
+  owp->roms_cnt = 0;
+#endif
+#if ONEWIRE_USE_UART
+  owp->uartcfg = NULL;
+#endif
 #if ONEWIRE_USE_STRONG_PULLUP
   owp->reg.need_pullup = false;
 #endif
@@ -591,8 +929,15 @@ void onewireObjectInit(onewireDriver *owp) {
 void onewireStart(onewireDriver *owp, const onewireConfig *config) {
 
   osalDbgCheck((NULL != owp) && (NULL != config));
+#if ONEWIRE_USE_UART
+  osalDbgCheck((NULL != config->uartcfg_reset) &&
+               (NULL != config->uartcfg_data));
+  osalDbgAssert(UART_STOP == config->uartd->state,
+      "UART will be started by onewire driver internally");
+#else
   osalDbgAssert(PWM_STOP == config->pwmd->state,
       "PWM will be started by onewire driver internally");
+#endif
   osalDbgAssert(ONEWIRE_STOP == owp->reg.state, "Invalid state");
 #if ONEWIRE_USE_STRONG_PULLUP
   osalDbgCheck((NULL != config->pullup_assert) &&
@@ -600,6 +945,21 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
 #endif
 
   owp->config = config;
+  owp->reg.speed = ONEWIRE_SPEED_STANDARD;
+
+#if ONEWIRE_USE_UART
+  config->uartcfg_reset->rxend_cb = ow_uart_rxend_cb;
+  config->uartcfg_data->rxend_cb = ow_uart_rxend_cb;
+  if (NULL != config->uartcfg_od_reset)
+    config->uartcfg_od_reset->rxend_cb = ow_uart_rxend_cb;
+  if (NULL != config->uartcfg_od_data)
+    config->uartcfg_od_data->rxend_cb = ow_uart_rxend_cb;
+
+  owp->uartcfg = NULL;
+  ow_uart_set_config(owp, config->uartcfg_data);
+  palSetPadMode(owp->config->port, owp->config->pad,
+      owp->config->pad_mode_active);
+#else
   owp->config->pwmcfg->frequency = ONEWIRE_PWM_FREQUENCY;
   owp->config->pwmcfg->period = ONEWIRE_RESET_TOTAL_WIDTH;
 
@@ -608,6 +968,7 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
       owp->config->pad_mode_active);
 #endif
   ow_bus_idle(owp);
+#endif /* ONEWIRE_USE_UART */
   owp->reg.state = ONEWIRE_READY;
 }
 
@@ -623,8 +984,13 @@ void onewireStop(onewireDriver *owp) {
 #if ONEWIRE_USE_STRONG_PULLUP
   owp->config->pullup_release();
 #endif
+#if ONEWIRE_USE_UART
+  uartStop(owp->config->uartd);
+  owp->uartcfg = NULL;
+#else
   ow_bus_idle(owp);
   pwmStop(owp->config->pwmd);
+#endif
   owp->config = NULL;
   owp->reg.state = ONEWIRE_STOP;
 }
@@ -638,24 +1004,31 @@ void onewireStop(onewireDriver *owp) {
  * @retval true         There is at least one device on bus.
  */
 bool onewireReset(onewireDriver *owp) {
+#if !ONEWIRE_USE_UART
+  const onewire_timing_t *t;
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck(NULL != owp);
   osalDbgAssert(owp->reg.state == ONEWIRE_READY, "Invalid state");
 
+#if ONEWIRE_USE_UART
+  return ow_uart_reset(owp);
+#else
   /* short circuit on bus or any other device transmit data */
   if (PAL_LOW == ow_read_bit(owp))
     return false;
 
+  t = ow_timing(owp);
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
   sch = owp->config->sample_channel;
 
 
-  pwmcfg->period = ONEWIRE_RESET_LOW_WIDTH + ONEWIRE_RESET_SAMPLE_WIDTH;
+  pwmcfg->period = t->reset_low + t->reset_sample;
   pwmcfg->callback = NULL;
   pwmcfg->channels[mch].callback = NULL;
   pwmcfg->channels[mch].mode = owp->config->pwmmode;
@@ -665,8 +1038,8 @@ bool onewireReset(onewireDriver *owp) {
   ow_bus_active(owp);
 
   osalSysLock();
-  pwmEnableChannelI(pwmd, mch, ONEWIRE_RESET_LOW_WIDTH);
-  pwmEnableChannelI(pwmd, sch, ONEWIRE_RESET_SAMPLE_WIDTH);
+  pwmEnableChannelI(pwmd, mch, t->reset_low);
+  pwmEnableChannelI(pwmd, sch, t->reset_sample);
   pwmEnableChannelNotificationI(pwmd, sch);
   osalThreadSuspendS(&owp->thread);
   osalSysUnlock();
@@ -674,8 +1047,9 @@ bool onewireReset(onewireDriver *owp) {
   ow_bus_idle(owp);
 
   /* wait until slave release bus to discriminate short circuit condition */
-  osalThreadSleepMicroseconds(500);
+  osalThreadSleepMicroseconds(t->reset_release);
   return (PAL_HIGH == ow_read_bit(owp)) && (true == owp->reg.slave_present);
+#endif /* ONEWIRE_USE_UART */
 }
 
 /**
@@ -684,11 +1058,19 @@ bool onewireReset(onewireDriver *owp) {
  * @param[in] owp       pointer to the @p onewireDriver object
  * @param[out] rxbuf    pointer to the buffer for read data
  * @param[in] rxbytes   amount of data to be received
+ *
+ * @return              Operation status, @p rxbuf content is undefined
+ *                      on failure.
+ * @retval MSG_OK       data read.
+ * @retval MSG_TIMEOUT  UART backend only, the transfer timed out.
  */
-void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
+msg_t onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
+#if !ONEWIRE_USE_UART
+  const onewire_timing_t *t;
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck((NULL != owp) && (NULL != rxbuf));
   osalDbgCheck((rxbytes > 0) && (rxbytes <= ONEWIRE_MAX_TRANSACTION_LEN));
@@ -698,6 +1080,10 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
      bits using |= operation.*/
   memset(rxbuf, 0, rxbytes);
 
+#if ONEWIRE_USE_UART
+  return ow_uart_read(owp, rxbuf, rxbytes);
+#else
+  t = ow_timing(owp);
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -708,7 +1094,7 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
   owp->buf = rxbuf;
   owp->reg.bytes = rxbytes;
 
-  pwmcfg->period = ONEWIRE_ZERO_WIDTH + ONEWIRE_RECOVERY_WIDTH;
+  pwmcfg->period = t->zero + t->recovery;
   pwmcfg->callback = NULL;
   pwmcfg->channels[mch].callback = NULL;
   pwmcfg->channels[mch].mode = owp->config->pwmmode;
@@ -717,13 +1103,15 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
 
   ow_bus_active(owp);
   osalSysLock();
-  pwmEnableChannelI(pwmd, mch, ONEWIRE_ONE_WIDTH);
-  pwmEnableChannelI(pwmd, sch, ONEWIRE_SAMPLE_WIDTH);
+  pwmEnableChannelI(pwmd, mch, t->one);
+  pwmEnableChannelI(pwmd, sch, t->sample);
   pwmEnableChannelNotificationI(pwmd, sch);
   osalThreadSuspendS(&owp->thread);
   osalSysUnlock();
 
   ow_bus_idle(owp);
+  return MSG_OK;
+#endif /* ONEWIRE_USE_UART */
 }
 
 /**
@@ -734,12 +1122,19 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
  * @param[in] txbytes       amount of data to be written
  * @param[in] pullup_time   how long strong pull up must be activated. Set
  *                          it to 0 if not needed.
+ *
+ * @return                  Operation status.
+ * @retval MSG_OK           data written.
+ * @retval MSG_TIMEOUT      UART backend only, the transfer timed out and
+ *                          the strong pull up was not activated.
  */
-void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
-                  size_t txbytes, systime_t pullup_time) {
+msg_t onewireWrite(onewireDriver *owp, uint8_t *txbuf,
+                   size_t txbytes, systime_t pullup_time) {
+#if !ONEWIRE_USE_UART
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck((NULL != owp) && (NULL != txbuf));
   osalDbgCheck((txbytes > 0) && (txbytes <= ONEWIRE_MAX_TRANSACTION_LEN));
@@ -749,6 +1144,18 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
       "Non zero time is valid only when strong pull enabled");
 #endif
 
+#if ONEWIRE_USE_UART
+  if (MSG_OK != ow_uart_write(owp, txbuf, txbytes))
+    return MSG_TIMEOUT;
+
+#if ONEWIRE_USE_STRONG_PULLUP
+  /* Asserted from thread context so expect some more jitter than PWM.*/
+  if (pullup_time > 0) {
+    owp->reg.state = ONEWIRE_PULL_UP;
+    owp->config->pullup_assert();
+  }
+#endif
+#else /* !ONEWIRE_USE_UART */
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -759,7 +1166,7 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
   owp->reg.final_timeslot = false;
   owp->reg.bytes = txbytes;
 
-  pwmcfg->period = ONEWIRE_ZERO_WIDTH + ONEWIRE_RECOVERY_WIDTH;
+  pwmcfg->period = ow_timing(owp)->zero + ow_timing(owp)->recovery;
   pwmcfg->callback = pwm_write_bit_cb;
   pwmcfg->channels[mch].callback = NULL;
   pwmcfg->channels[mch].mode = owp->config->pwmmode;
@@ -781,6 +1188,7 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
 
   pwmDisablePeriodicNotification(pwmd);
   ow_bus_idle(owp);
+#endif /* !ONEWIRE_USE_UART */
 
 #if ONEWIRE_USE_STRONG_PULLUP
   if (pullup_time > 0) {
@@ -789,6 +1197,105 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
     owp->reg.state = ONEWIRE_READY;
   }
 #endif
+  return MSG_OK;
+}
+
+/**
+ * @brief     Switches bus speed.
+ * @details   Standard speed reset pulse always returns all slaves to
+ *            standard speed. For overdrive the 'overdrive skip ROM' command
+ *            is sent to all slaves after it and the presence is checked
+ *            again with overdrive reset pulse.
+ * @note      Slaves without overdrive support stay silent until next
+ *            standard speed reset.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] speed     new bus speed
+ *
+ * @return              Bool flag denoting device presence at new speed.
+ *
+ * @api
+ */
+bool onewireSetSpeed(onewireDriver *owp, onewire_speed_t speed) {
+  uint8_t cmd = ONEWIRE_CMD_OVERDRIVE_SKIP_ROM;
+
+  osalDbgCheck(NULL != owp);
+  osalDbgAssert(owp->reg.state == ONEWIRE_READY, "Invalid state");
+#if ONEWIRE_USE_UART
+  osalDbgAssert((ONEWIRE_SPEED_STANDARD == speed) ||
+                ((NULL != owp->config->uartcfg_od_reset) &&
+                 (NULL != owp->config->uartcfg_od_data)),
+                "overdrive UART configurations missing");
+#endif
+
+  owp->reg.speed = ONEWIRE_SPEED_STANDARD;
+  if (false == onewireReset(owp))
+    return false;
+
+  if (ONEWIRE_SPEED_OVERDRIVE == speed) {
+    if (MSG_OK != onewireWrite(owp, &cmd, 1, 0))
+      return false;
+    owp->reg.speed = ONEWIRE_SPEED_OVERDRIVE;
+    return onewireReset(owp);
+  }
+  return true;
+}
+
+/**
+ * @brief     Addresses slaves and sends function command to them.
+ * @details   Reset pulse followed by 'skip ROM' or 'match ROM' sequence and
+ *            function command sent in single write transaction.
+ *
+ * @param[in] owp           pointer to the @p onewireDriver object
+ * @param[in] rom           pointer to 8 bytes ROM code of the slave or
+ *                          @p NULL to address all slaves on bus
+ * @param[in] cmd           function command
+ * @param[in] pullup_time   how long strong pull up must be activated after
+ *                          command. Set it to 0 if not needed.
+ *
+ * @return                  Bool flag denoting device presence.
+ *
+ * @api
+ */
+bool onewireSelect(onewireDriver *owp, const uint8_t *rom, uint8_t cmd,
+                   systime_t pullup_time) {
+  uint8_t txbuf[10];
+  size_t txbytes;
+
+  if (false == onewireReset(owp))
+    return false;
+
+  if (NULL == rom) {
+    txbuf[0] = ONEWIRE_CMD_SKIP_ROM;
+    txbuf[1] = cmd;
+    txbytes = 2;
+  }
+  else {
+    txbuf[0] = ONEWIRE_CMD_MATCH_ROM;
+    memcpy(&txbuf[1], rom, 8);
+    txbuf[9] = cmd;
+    txbytes = 10;
+  }
+
+  return MSG_OK == onewireWrite(owp, txbuf, txbytes, pullup_time);
+}
+
+/**
+ * @brief     Starts temperature conversion on all slaves at once.
+ * @note      Without strong pull up the end of conversion can be polled
+ *            by single byte reads, bus reads 0 until all slaves are done.
+ *
+ * @param[in] owp           pointer to the @p onewireDriver object
+ * @param[in] pullup_time   conversion time for parasite powered slaves,
+ *                          0 if not needed.
+ *
+ * @return                  Bool flag denoting device presence.
+ *
+ * @api
+ */
+bool onewireConvertAll(onewireDriver *owp, systime_t pullup_time) {
+
+  return onewireSelect(owp, NULL, ONEWIRE_CMD_CONVERT_TEMP, pullup_time);
 }
 
 #if ONEWIRE_USE_SEARCH_ROM
@@ -796,6 +1303,9 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
  * @brief   Performs tree search on bus.
  * @note    This function does internal 1-wire reset calls every search
  *          iteration.
+ * @note    Discovered ROMs stay cached in the driver for
+ *          @p onewireMatchRom(), so @p result buffer must not be
+ *          reused until next search.
  *
  * @param[in] owp         pointer to a @p OWDriver object
  * @param[out] result     pointer to buffer for discovered ROMs
@@ -806,21 +1316,29 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
  */
 size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
                         size_t max_rom_cnt) {
+#if !ONEWIRE_USE_UART
+  const onewire_timing_t *t;
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
-  uint8_t cmd;
   size_t mch, sch;
+#endif
+  uint8_t cmd;
 
   osalDbgCheck(NULL != owp);
   osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
   osalDbgCheck((max_rom_cnt <= 256) && (max_rom_cnt > 0));
 
+#if !ONEWIRE_USE_UART
+  t = ow_timing(owp);
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
-  cmd = ONEWIRE_CMD_SEARCH_ROM;
   mch = owp->config->master_channel;
   sch = owp->config->sample_channel;
+#endif
+  cmd = ONEWIRE_CMD_SEARCH_ROM;
 
+  owp->roms = NULL;
+  owp->roms_cnt = 0;
   search_clean_start(&owp->search_rom);
 
   do {
@@ -839,10 +1357,14 @@ size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
     search_clean_iteration(&owp->search_rom);
 
     /**/
-    onewireWrite(&OWD1, &cmd, 1, 0);
+    if (MSG_OK != onewireWrite(&OWD1, &cmd, 1, 0))
+      return 0;
 
+#if ONEWIRE_USE_UART
+    ow_uart_search_rom(owp);
+#else
     /* Reconfiguration always needed because of previous call onewireWrite.*/
-    pwmcfg->period = ONEWIRE_ZERO_WIDTH + ONEWIRE_RECOVERY_WIDTH;
+    pwmcfg->period = t->zero + t->recovery;
     pwmcfg->callback = NULL;
     pwmcfg->channels[mch].callback = NULL;
     pwmcfg->channels[mch].mode = owp->config->pwmmode;
@@ -851,13 +1373,14 @@ size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
 
     ow_bus_active(owp);
     osalSysLock();
-    pwmEnableChannelI(pwmd, mch, ONEWIRE_ONE_WIDTH);
-    pwmEnableChannelI(pwmd, sch, ONEWIRE_SAMPLE_WIDTH);
+    pwmEnableChannelI(pwmd, mch, t->one);
+    pwmEnableChannelI(pwmd, sch, t->sample);
     pwmEnableChannelNotificationI(pwmd, sch);
     osalThreadSuspendS(&owp->thread);
     osalSysUnlock();
 
     ow_bus_idle(owp);
+#endif /* ONEWIRE_USE_UART */
 
     if (ONEWIRE_SEARCH_ROM_ERROR != owp->search_rom.reg.result) {
       /* check CRC and return 0 (0 == error) if mismatch */
@@ -872,8 +1395,68 @@ size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
   /**/
   if (ONEWIRE_SEARCH_ROM_ERROR == owp->search_rom.reg.result)
     return 0;
-  else
-    return owp->search_rom.reg.devices_found;
+
+  owp->roms = result;
+  owp->roms_cnt = owp->search_rom.reg.devices_found;
+  if (owp->roms_cnt > max_rom_cnt)
+    owp->roms_cnt = max_rom_cnt;
+  return owp->search_rom.reg.devices_found;
+}
+
+/**
+ * @brief     Addresses one slave found by last search.
+ * @details   Reset pulse, 'match ROM' with cached ROM code and function
+ *            command go out in single write transaction.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] n         index of the slave in ROM cache
+ * @param[in] cmd       function command
+ *
+ * @return              Bool flag denoting device presence.
+ *
+ * @api
+ */
+bool onewireMatchRom(onewireDriver *owp, size_t n, uint8_t cmd) {
+
+  osalDbgCheck(NULL != owp);
+  osalDbgCheck(n < owp->roms_cnt);
+
+  return onewireSelect(owp, onewireGetRom(owp, n), cmd, 0);
+}
+
+/**
+ * @brief     Reads scratchpads of all slaves found by last search.
+ * @details   Slaves are addressed one by one in ROM cache order, only
+ *            first @p rxbytes of every scratchpad are read so reading just
+ *            temperature bytes of a thermometer takes 2 bytes instead of 9.
+ * @note      Area of the slaves not answering is filled by 0xFF.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[out] rxbuf    buffer for @p rxbytes multiplied by cached ROMs count
+ * @param[in] rxbytes   bytes to be read from every scratchpad
+ *
+ * @return              Count of slaves answered.
+ *
+ * @api
+ */
+size_t onewireReadScratchpads(onewireDriver *owp, uint8_t *rxbuf,
+                              size_t rxbytes) {
+  size_t i, answered = 0;
+
+  osalDbgCheck((NULL != owp) && (NULL != rxbuf) && (rxbytes > 0));
+
+  for (i=0; i<owp->roms_cnt; i++) {
+    if (onewireMatchRom(owp, i, ONEWIRE_CMD_READ_SCRATCHPAD) &&
+        (MSG_OK == onewireRead(owp, rxbuf, rxbytes))) {
+      answered++;
+    }
+    else {
+      memset(rxbuf, 0xFF, rxbytes);
+    }
+    rxbuf += rxbytes;
+  }
+
+  return answered;
 }
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
@@ -128,6 +128,44 @@ bool qei_adjust_count(qeicnt_t *count, qeidelta_t *delta,
   }
 }
 
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Restarts the velocity estimator.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ *
+ * @notapi
+ */
+static void qei_velocity_reset(QEIDriver *qeip) {
+
+  qeip->vel.primed                = false;
+  qeip->vel.period                = 0U;
+  qeip->vel.step                  = 0;
+  qeip->vel.window_velocity       = 0;
+  qeip->vel.motion.velocity       = 0;
+  qeip->vel.motion.acceleration   = 0;
+  qeip->vel.armed                 = true;
+  qei_lld_arm_velocity(qeip);
+}
+
+/**
+ * @brief   Velocity of a count change over a time interval.
+ *
+ * @param[in] step      count change
+ * @param[in] dt        time interval in timestamp ticks, not zero
+ * @return              The velocity in 1/QEI_VELOCITY_SCALE counts per
+ *                      second.
+ *
+ * @notapi
+ */
+static qeivelocity_t qei_velocity(int32_t step, uint32_t dt) {
+
+  return (qeivelocity_t)(((int64_t)step * QEI_VELOCITY_SCALE *
+                          (int64_t)QEI_VELOCITY_TIMESTAMP_FREQ) /
+                         (int64_t)dt);
+}
+#endif /* QEI_USE_VELOCITY == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -212,6 +250,9 @@ void qeiEnable(QEIDriver *qeip) {
   osalSysLock();
   osalDbgAssert(qeip->state == QEI_READY, "invalid state");
   qei_lld_enable(qeip);
+#if QEI_USE_VELOCITY == TRUE
+  qei_velocity_reset(qeip);
+#endif
   qeip->state = QEI_ACTIVE;
   osalSysUnlock();
 }
@@ -268,6 +309,11 @@ void qeiSetCount(QEIDriver *qeip, qeicnt_t value) {
 
   osalSysLock();
   qei_lld_set_count(qeip, value);
+#if QEI_USE_VELOCITY == TRUE
+  /* The count jump would be taken as motion.*/
+  if (qeip->state == QEI_ACTIVE)
+    qei_velocity_reset(qeip);
+#endif
   osalSysUnlock();
 }
 
@@ -370,6 +416,112 @@ qeidelta_t qeiUpdateI(QEIDriver *qeip) {
   return delta;
 }
 
+#if (QEI_USE_VELOCITY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the velocity and acceleration estimate.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ * @param[out] mp       pointer to the @p qeimotion_t structure to be filled
+ *
+ * @api
+ */
+void qeiGetMotion(QEIDriver *qeip, qeimotion_t *mp) {
+
+  osalSysLock();
+  qeiGetMotionI(qeip, mp);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Returns the velocity and acceleration estimate.
+ * @details If an edge has been recorded since the previous reading the
+ *          estimate is updated from the window ending on that edge and
+ *          the estimator is armed again. Otherwise the velocity is
+ *          limited to what the last window step over the time elapsed
+ *          since the last edge allows, and falls to zero after
+ *          @p QEI_VELOCITY_TIMEOUT.
+ * @note    The estimate is only refreshed on reading, it must be read
+ *          more often than the timestamp counter wraps.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ * @param[out] mp       pointer to the @p qeimotion_t structure to be filled
+ *
+ * @iclass
+ */
+void qeiGetMotionI(QEIDriver *qeip, qeimotion_t *mp) {
+  qeiestimator_t *vp = &qeip->vel;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((qeip != NULL) && (mp != NULL));
+  osalDbgAssert(qeip->state == QEI_ACTIVE, "invalid state");
+
+  if (!vp->armed) {
+    int32_t count = vp->edge_count;
+    uint32_t time = vp->edge_time;
+
+    if (vp->primed && (time != vp->ref_time)) {
+      uint32_t dt = time - vp->ref_time;
+      int32_t step = (qeicnt_t)(count - vp->ref_count);
+      qeivelocity_t v = qei_velocity(step, dt);
+
+      /* Windows are adjacent, their centres are half of each apart.*/
+      if (vp->period != 0U) {
+        vp->motion.acceleration =
+          (qeivelocity_t)(((int64_t)(v - vp->window_velocity) * 2 *
+                           (int64_t)QEI_VELOCITY_TIMESTAMP_FREQ) /
+                          ((int64_t)dt + (int64_t)vp->period));
+      }
+      vp->window_velocity = v;
+      vp->motion.velocity = v;
+      vp->step            = step;
+      vp->period          = dt;
+    }
+    vp->ref_count = count;
+    vp->ref_time  = time;
+    vp->primed    = true;
+
+    vp->armed = true;
+    qei_lld_arm_velocity(qeip);
+  }
+  else if (vp->primed) {
+    uint32_t elapsed = QEI_VELOCITY_TIMESTAMP() - vp->ref_time;
+
+    if (elapsed > (uint32_t)(((uint64_t)QEI_VELOCITY_TIMESTAMP_FREQ *
+                              QEI_VELOCITY_TIMEOUT) / 1000U)) {
+      /* Still, the next edge starts from scratch.*/
+      vp->primed              = false;
+      vp->period              = 0U;
+      vp->window_velocity     = 0;
+      vp->motion.velocity     = 0;
+      vp->motion.acceleration = 0;
+    }
+    else if ((vp->period != 0U) && (elapsed > vp->period)) {
+      /* Slower than the last window, the next edge is at least this far.*/
+      vp->motion.velocity = qei_velocity(vp->step, elapsed);
+    }
+  }
+
+  *mp = vp->motion;
+}
+
+/**
+ * @brief   Returns the velocity estimate.
+ *
+ * @param[in] qeip      pointer to the @p QEIDriver object
+ * @return              The velocity in 1/QEI_VELOCITY_SCALE counts per
+ *                      second.
+ *
+ * @api
+ */
+qeivelocity_t qeiGetVelocity(QEIDriver *qeip) {
+  qeimotion_t motion;
+
+  qeiGetMotion(qeip, &motion);
+
+  return motion.velocity;
+}
+#endif /* QEI_USE_VELOCITY == TRUE */
+
 #endif /* HAL_USE_QEI == TRUE */
 
 /** @} */
@@ -154,6 +154,55 @@ void timcapDisable(TIMCAPDriver *timcapp) {
   osalSysUnlock();
 }
 
+#if (TIMCAP_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts streaming the captures of a channel.
+ * @details The capture register of the channel is moved by DMA into a
+ *          circular buffer, the @p stream_cb callback is invoked each time
+ *          a half of the buffer has been filled. Per-edge capture
+ *          callbacks are not invoked while streaming.
+ * @note    The samples are raw counter values, see the @p capstats module
+ *          for converting them into periods and widths.
+ *
+ * @param[in] timcapp      pointer to the @p TIMCAPDriver object
+ * @param[in] channel      channel to be streamed
+ * @param[out] buf         pointer to the circular buffer
+ * @param[in] n            number of samples in the buffer, it must be even
+ *
+ * @api
+ */
+void timcapStartStream(TIMCAPDriver *timcapp, timcapchannel_t channel,
+                       timcapsample_t *buf, size_t n) {
+
+  osalDbgCheck((timcapp != NULL) && (buf != NULL) &&
+               (n >= 2U) && ((n & 1U) == 0U));
+
+  osalSysLock();
+  osalDbgAssert(timcapp->state == TIMCAP_READY, "invalid state");
+  timcap_lld_start_stream(timcapp, channel, buf, n);
+  timcapp->state = TIMCAP_STREAMING;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops streaming.
+ *
+ * @param[in] timcapp      pointer to the @p TIMCAPDriver object
+ *
+ * @api
+ */
+void timcapStopStream(TIMCAPDriver *timcapp) {
+
+  osalDbgCheck(timcapp != NULL);
+
+  osalSysLock();
+  osalDbgAssert(timcapp->state == TIMCAP_STREAMING, "invalid state");
+  timcap_lld_stop_stream(timcapp);
+  timcapp->state = TIMCAP_READY;
+  osalSysUnlock();
+}
+#endif /* TIMCAP_USE_DMA == TRUE */
+
 #endif /* HAL_USE_TIMCAP */
 
 /** @} */
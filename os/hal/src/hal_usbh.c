@@ -225,6 +225,8 @@ void usbhURBSubmitI(usbh_urb_t *urb) {
 		return;
 	}
 	urb->status = USBH_URBSTATUS_PENDING;
+	_hal_trace_point(HAL_TRACE_MODULE_USBH, HAL_TRACE_USBH_URB_SUBMIT,
+			(uintptr_t)urb, ep->address | (ep->in ? 0x80 : 0), urb->requestedLength);
 	usbh_lld_urb_submit(urb);
 }
 
@@ -307,6 +309,8 @@ void _usbh_urb_completeI(usbh_urb_t *urb, usbh_urbstatus_t status) {
 	osalDbgCheckClassI();
 	_check_urb(urb);
 	urb->status = status;
+	_hal_trace_point(HAL_TRACE_MODULE_USBH, HAL_TRACE_USBH_URB_COMPLETE,
+			(uintptr_t)urb, status, urb->actualLength);
 	osalThreadResumeI(&urb->waitingThread, _wakeup_message(status));
 	osalThreadResumeI(&urb->abortingThread, MSG_RESET);
 	if (urb->callback)
@@ -23,9 +23,11 @@
 #include "usbh/debug.h"
 #include "chprintf.h"
 #include <stdarg.h>
+#include <string.h>
 
 #define TEMP_BUFF_LEN	255
 
+#if !USBH_DEBUG_BINARY
 /* ************************ */
 /* Circular queue structure */
 /* ************************ */
@@ -160,6 +162,375 @@ void usbDbgPuts(const char *s) {
 	syssts_t sts = _dbg_prologue(debug, hfnum, hfir, s, &len);
 	dbg_epilogue(debug, sts, len);
 }
+#else
+/* ************************* */
+/* Binary record ring buffer */
+/* ************************* */
+
+/* Record layout, in words:
+ *  [0] header: length in words (bits 0-7), flags, HFIR (bits 16-31)
+ *  [1] format string (or usbDbgPuts string) pointer
+ *  [2] system time
+ *  [3] HFNUM
+ *  [4...] arguments: one word per integer, pointer, character or '*',
+ *         two words per %f, a length word followed by the characters
+ *         (truncated to USBH_DEBUG_BINARY_MAX_STRING) per %s.
+ * The header is written last, the record is consumed only after the
+ * producer has set BQ_READY. */
+#define BQ_LEN_MASK			0xffU
+#define BQ_READY			0x100U
+#define BQ_PUTS				0x200U
+#define BQ_SKIP				0x400U
+#define BQ_HEADER_WORDS		4U
+#define BQ_STRING_WORDS		(1U + (USBH_DEBUG_BINARY_MAX_STRING + 3U) / 4U)
+#define BQ_ARG_WORDS		(BQ_STRING_WORDS > 2U ? BQ_STRING_WORDS : 2U)
+#define BQ_MAX_RECORD		(BQ_HEADER_WORDS + USBH_DEBUG_BINARY_MAX_ARGS * BQ_ARG_WORDS)
+
+#if BQ_MAX_RECORD > BQ_LEN_MASK
+#error "USBH_DEBUG_BINARY_MAX_ARGS/USBH_DEBUG_BINARY_MAX_STRING too large"
+#endif
+
+#if USBH_DEBUG_BUFFER / 4 <= BQ_MAX_RECORD
+#error "USBH_DEBUG_BUFFER too small for USBH_DEBUG_BINARY"
+#endif
+
+static void bq_init(usbh_bq_t *q, uint32_t *buff, uint32_t sz) {
+	q->start = buff;
+	q->sz = sz;
+	q->rd = q->wr = 0;
+	q->dropped = 0;
+}
+
+/* Reserves n words; only the index update runs with the lock held, the
+ * caller fills the record and publishes it with bq_commit(). Nothing is
+ * evicted: when the ring is full the message is dropped and counted. */
+static uint32_t *bq_reserve(usbh_bq_t *q, uint32_t n) {
+	syssts_t sts = chSysGetStatusAndLockX();
+	uint32_t wr = q->wr;
+	uint32_t rd = q->rd;
+	uint32_t *rec = NULL;
+
+	if (wr >= rd) {
+		if ((wr + n < q->sz) || ((wr + n == q->sz) && (rd != 0))) {
+			rec = &q->start[wr];
+			q->wr = (wr + n == q->sz) ? 0 : wr + n;
+		} else if (n < rd) {
+			/* doesn't fit at the end, wrap */
+			q->start[wr] = BQ_SKIP | BQ_READY;
+			rec = q->start;
+			q->wr = n;
+		}
+	} else if (wr + n < rd) {
+		rec = &q->start[wr];
+		q->wr = wr + n;
+	}
+
+	if (rec) {
+		rec[0] = 0;
+		rec[2] = (uint32_t)osalOsGetSystemTimeX();
+	} else {
+		q->dropped++;
+	}
+
+	chSysRestoreStatusX(sts);
+	return rec;
+}
+
+static void bq_commit(struct usbh_debug_helper *debug, uint32_t *rec,
+		uint32_t hdr) {
+	__DMB();
+	*(volatile uint32_t *)rec = hdr | BQ_READY;
+
+	syssts_t sts = chSysGetStatusAndLockX();
+	if (debug->on) {
+		chThdResumeI(&debug->tr, MSG_OK);
+	}
+	chSysRestoreStatusX(sts);
+}
+
+/* Scans the chprintf conversion starting at the '%' pointed by *p, leaves
+ * *p past it and returns the conversion character. */
+static char bq_scan_spec(const char **p, unsigned *nstar, bool *islong) {
+	const char *f = *p + 1;
+	char c;
+
+	*nstar = 0;
+	while ((*f == '-') || (*f == '+') || (*f == '0'))
+		f++;
+	if (*f == '*') {
+		f++;
+		(*nstar)++;
+	} else {
+		while ((*f >= '0') && (*f <= '9'))
+			f++;
+	}
+	if (*f == '.') {
+		f++;
+		if (*f == '*') {
+			f++;
+			(*nstar)++;
+		} else {
+			while ((*f >= '0') && (*f <= '9'))
+				f++;
+		}
+	}
+	*islong = false;
+	if ((*f == 'l') || (*f == 'L')) {
+		f++;
+		*islong = true;
+	}
+	c = *f;
+	if (c) {
+		f++;
+		if ((c >= 'A') && (c <= 'Z'))
+			*islong = true;
+	}
+	*p = f;
+	return c;
+}
+
+/* Stores the arguments of fmt at d, or only measures them if d is NULL.
+ * Returns the number of words. */
+static uint32_t bq_capture(const char *fmt, va_list ap, uint32_t *d) {
+	uint32_t n = 0;
+	unsigned nargs = 0;
+
+	while ((fmt = strchr(fmt, '%')) != NULL) {
+		unsigned nstar;
+		bool islong;
+		char c = bq_scan_spec(&fmt, &nstar, &islong);
+
+		while (nstar--) {
+			if (nargs++ == USBH_DEBUG_BINARY_MAX_ARGS)
+				return n;
+			int w = va_arg(ap, int);
+			if (d) d[n] = (uint32_t)w;
+			n++;
+		}
+
+		switch (c) {
+		case 's': {
+			if (nargs++ == USBH_DEBUG_BINARY_MAX_ARGS)
+				return n;
+			const char *s = va_arg(ap, const char *);
+			uint32_t len = 0;
+			if (s == NULL)
+				s = "(null)";
+			while ((len < USBH_DEBUG_BINARY_MAX_STRING) && s[len])
+				len++;
+			if (d) {
+				d[n] = len;
+				memcpy(&d[n + 1], s, len);
+			}
+			n += 1 + (len + 3) / 4;
+			break;
+		}
+		case 'f': {
+			if (nargs++ == USBH_DEBUG_BINARY_MAX_ARGS)
+				return n;
+			double v = va_arg(ap, double);
+			if (d) memcpy(&d[n], &v, sizeof(v));
+			n += 2;
+			break;
+		}
+		case 'p': {
+			if (nargs++ == USBH_DEBUG_BINARY_MAX_ARGS)
+				return n;
+			void *v = va_arg(ap, void *);
+			if (d) d[n] = (uint32_t)v;
+			n++;
+			break;
+		}
+		case 'c': case 'd': case 'i': case 'u': case 'x': case 'o':
+		case 'D': case 'I': case 'U': case 'X': case 'O': {
+			if (nargs++ == USBH_DEBUG_BINARY_MAX_ARGS)
+				return n;
+			uint32_t v = islong ? (uint32_t)va_arg(ap, long) : (uint32_t)va_arg(ap, int);
+			if (d) d[n] = v;
+			n++;
+			break;
+		}
+		case 0:
+			return n;
+		default:
+			/* no argument (e.g. "%%") */
+			break;
+		}
+	}
+	return n;
+}
+
+/* Formats a record's message, one chsnprintf() call per conversion. */
+static int bq_format(char *out, int size, const char *fmt,
+		const uint32_t *a, const uint32_t *end) {
+	int len = 0;
+
+	while (*fmt && (len < size - 1)) {
+		if (*fmt != '%') {
+			out[len++] = *fmt++;
+			continue;
+		}
+
+		const char *spec = fmt;
+		unsigned nstar;
+		bool islong;
+		char c = bq_scan_spec(&fmt, &nstar, &islong);
+		char sbuf[24];
+		size_t slen = 0;
+		bool ok = true;
+		int r = 0;
+
+		/* rebuild the conversion with the recorded '*' values */
+		for (const char *p = spec; p < fmt; p++) {
+			if (slen >= sizeof(sbuf) - 12) {
+				ok = false;
+			} else if (*p != '*') {
+				sbuf[slen++] = *p;
+			} else if (a < end) {
+				int w = (int)*a++;
+				slen += chsnprintf(&sbuf[slen], sizeof(sbuf) - slen, "%d", w < 0 ? 0 : w);
+			} else {
+				ok = false;
+			}
+		}
+		sbuf[slen] = 0;
+
+		if (ok) switch (c) {
+		case 's':
+			if ((a < end) && (*a <= USBH_DEBUG_BINARY_MAX_STRING)
+					&& (a + 1 + (*a + 3) / 4 <= end)) {
+				char str[USBH_DEBUG_BINARY_MAX_STRING + 1];
+				uint32_t n = *a;
+				memcpy(str, a + 1, n);
+				str[n] = 0;
+				a += 1 + (n + 3) / 4;
+				r = chsnprintf(out + len, size - len, sbuf, str);
+			} else {
+				ok = false;
+			}
+			break;
+		case 'f':
+			if (a + 2 <= end) {
+				double v;
+				memcpy(&v, a, sizeof(v));
+				a += 2;
+				r = chsnprintf(out + len, size - len, sbuf, v);
+			} else {
+				ok = false;
+			}
+			break;
+		case 'p':
+			if (a < end) {
+				r = chsnprintf(out + len, size - len, sbuf, (void *)*a++);
+			} else {
+				ok = false;
+			}
+			break;
+		case 'c': case 'd': case 'i': case 'u': case 'x': case 'o':
+		case 'D': case 'I': case 'U': case 'X': case 'O':
+			if (a >= end) {
+				ok = false;
+			} else if (islong) {
+				r = chsnprintf(out + len, size - len, sbuf, (long)(int32_t)*a++);
+			} else {
+				r = chsnprintf(out + len, size - len, sbuf, (int)*a++);
+			}
+			break;
+		default:
+			r = chsnprintf(out + len, size - len, sbuf);
+			break;
+		}
+
+		if (!ok) {
+			/* arguments not recorded (USBH_DEBUG_BINARY_MAX_ARGS), print the
+			 * conversion as is */
+			r = 0;
+			while ((spec < fmt) && (len + r < size - 1))
+				out[len + r++] = *spec++;
+		}
+
+		len += r;
+		if (len > size - 1)
+			len = size - 1;
+	}
+
+	out[len] = 0;
+	return len;
+}
+
+/* Same time stamp as the text mode: elapsed time since the last message
+ * at SOF, frame number and position within the frame otherwise. */
+static int bq_stamp(struct usbh_debug_helper *debug, const uint32_t *rec,
+		char *out, int size) {
+	uint32_t hfnum = rec[3];
+	uint16_t hfir = (uint16_t)(rec[0] >> 16);
+
+	debug->last = (systime_t)rec[2];
+	if (debug->ena) {
+		debug->first = debug->last;
+	}
+
+	if (((hfnum & 0x3fff) == 0x3fff) && (hfir == (hfnum >> 16))) {
+		debug->ena = FALSE;
+		return chsnprintf(out, size, "+%08d ", debug->last - debug->first);
+	}
+
+	uint32_t f = hfnum & 0xffff;
+	uint32_t p = (hfir >= 1000) ? 1000 - ((hfnum >> 16) / (hfir / 1000)) : 0;
+	debug->ena = TRUE;
+	return chsnprintf(out, size, "%05d.%03d ", f, p);
+}
+
+#if USBH_DEBUG_MULTI_HOST
+void usbDbgPrintf(USBHDriver *host, const char *fmt, ...) {
+	if (!host) return;
+	struct usbh_debug_helper *const debug = &host->debug;
+	uint32_t hfnum = host->otg->HFNUM;
+	uint16_t hfir = host->otg->HFIR;
+#else
+void usbDbgPrintf(const char *fmt, ...) {
+	struct usbh_debug_helper *const debug = &usbh_debug;
+	uint32_t hfnum = USBH_DEBUG_SINGLE_HOST_SELECTION.otg->HFNUM;
+	uint16_t hfir = USBH_DEBUG_SINGLE_HOST_SELECTION.otg->HFIR;
+#endif
+	va_list ap, aq;
+	va_start(ap, fmt);
+
+	va_copy(aq, ap);
+	uint32_t n = BQ_HEADER_WORDS + bq_capture(fmt, aq, NULL);
+	va_end(aq);
+
+	uint32_t *rec = bq_reserve(&debug->bq, n);
+	if (rec) {
+		rec[1] = (uint32_t)fmt;
+		rec[3] = hfnum;
+		bq_capture(fmt, ap, rec + BQ_HEADER_WORDS);
+		bq_commit(debug, rec, n | ((uint32_t)hfir << 16));
+	}
+
+	va_end(ap);
+}
+
+#if USBH_DEBUG_MULTI_HOST
+void usbDbgPuts(USBHDriver *host, const char *s) {
+	if (!host) return;
+	struct usbh_debug_helper *const debug = &host->debug;
+	uint32_t hfnum = host->otg->HFNUM;
+	uint16_t hfir = host->otg->HFIR;
+#else
+void usbDbgPuts(const char *s) {
+	struct usbh_debug_helper *const debug = &usbh_debug;
+	uint32_t hfnum = USBH_DEBUG_SINGLE_HOST_SELECTION.otg->HFNUM;
+	uint16_t hfir = USBH_DEBUG_SINGLE_HOST_SELECTION.otg->HFIR;
+#endif
+	uint32_t *rec = bq_reserve(&debug->bq, BQ_HEADER_WORDS);
+	if (rec) {
+		rec[1] = (uint32_t)s;
+		rec[3] = hfnum;
+		bq_commit(debug, rec, BQ_HEADER_WORDS | BQ_PUTS | ((uint32_t)hfir << 16));
+	}
+}
+#endif
 
 #if USBH_DEBUG_MULTI_HOST
 void usbDbgEnable(USBHDriver *host, bool enable) {
@@ -183,6 +554,7 @@ static void usb_debug_thread(void *arg) {
 	uint8_t rdbuff[TEMP_BUFF_LEN + 1];
 
 	chRegSetThreadName("USBH_DBG");
+#if !USBH_DEBUG_BINARY
 	while (true) {
 		chSysLock();
 		int len = dq_read_oldest_string(&debug->dq, rdbuff);
@@ -199,6 +571,74 @@ static void usb_debug_thread(void *arg) {
 #endif
 		}
 	}
+#else
+	usbh_bq_t *const q = &debug->bq;
+	uint32_t rec[BQ_MAX_RECORD];
+
+	while (true) {
+		uint32_t rd, hdr = 0, dropped;
+		int len;
+
+		chSysLock();
+		rd = q->rd;
+		if (rd != q->wr) {
+			hdr = q->start[rd];
+			if ((hdr & (BQ_READY | BQ_SKIP)) == (BQ_READY | BQ_SKIP)) {
+				q->rd = 0;
+				chSysUnlock();
+				continue;
+			}
+		}
+		dropped = q->dropped;
+		q->dropped = 0;
+		if (!(hdr & BQ_READY) && !dropped) {
+			/* empty, or the oldest record is still being written */
+			chThdSuspendS(&debug->tr);
+			chSysUnlock();
+			continue;
+		}
+		chSysUnlock();
+
+		if (dropped) {
+			len = chsnprintf((char *)rdbuff, sizeof(rdbuff),
+					"USBH debug: %u messages lost", dropped);
+#if USBH_DEBUG_MULTI_HOST
+			USBH_DEBUG_OUTPUT_CALLBACK(host, rdbuff, len);
+#else
+			USBH_DEBUG_OUTPUT_CALLBACK(rdbuff, len);
+#endif
+		}
+
+		if (!(hdr & BQ_READY))
+			continue;
+
+		/* the record can't be overwritten until rd moves past it */
+		uint32_t n = hdr & BQ_LEN_MASK;
+		memcpy(rec, &q->start[rd], n * sizeof(uint32_t));
+
+		chSysLock();
+		q->rd = (rd + n == q->sz) ? 0 : rd + n;
+		chSysUnlock();
+
+		len = bq_stamp(debug, rec, (char *)rdbuff, sizeof(rdbuff));
+		if (len > TEMP_BUFF_LEN)
+			len = TEMP_BUFF_LEN;
+		if (hdr & BQ_PUTS) {
+			len += chsnprintf((char *)rdbuff + len, sizeof(rdbuff) - len,
+					"%s", (const char *)rec[1]);
+			if (len > TEMP_BUFF_LEN)
+				len = TEMP_BUFF_LEN;
+		} else {
+			len += bq_format((char *)rdbuff + len, sizeof(rdbuff) - len,
+					(const char *)rec[1], rec + BQ_HEADER_WORDS, rec + n);
+		}
+#if USBH_DEBUG_MULTI_HOST
+		USBH_DEBUG_OUTPUT_CALLBACK(host, rdbuff, len);
+#else
+		USBH_DEBUG_OUTPUT_CALLBACK(rdbuff, len);
+#endif
+	}
+#endif
 }
 
 #if USBH_DEBUG_MULTI_HOST
@@ -210,7 +650,11 @@ void usbDbgInit(void) {
 	struct usbh_debug_helper *const debug = &usbh_debug;
 	void *param = NULL;
 #endif
+#if USBH_DEBUG_BINARY
+	bq_init(&debug->bq, debug->buff, sizeof(debug->buff) / sizeof(debug->buff[0]));
+#else
 	dq_init(&debug->dq, debug->buff, sizeof(debug->buff));
+#endif
 	debug->on = true;
 	chThdCreateStatic(debug->thd_wa, sizeof(debug->thd_wa),
 			NORMALPRIO, usb_debug_thread, param);
@@ -0,0 +1,434 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkcache.c
+ * @brief   Caching block device wrapper code.
+ *
+ * @addtogroup blkcache
+ * @{
+ */
+
+#include "hal.h"
+
+#include "blkcache.h"
+
+#include <string.h>
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static bool overflow(const BlockCache *bcp, uint32_t startblk, uint32_t n) {
+  return (startblk + n) > bcp->blk_num;
+}
+
+static uint8_t *line_data(const BlockCache *bcp, const blkcacheline_t *lp) {
+  return &bcp->config->buffer[(size_t)(lp - bcp->config->lines) *
+                              BLKCACHE_BLOCK_SIZE];
+}
+
+static blkcacheline_t *lookup(const BlockCache *bcp, uint32_t blk) {
+  uint32_t i;
+
+  for (i = 0U; i < bcp->config->nlines; i++) {
+    blkcacheline_t *lp = &bcp->config->lines[i];
+    if (lp->valid && (lp->blk == blk)) {
+      return lp;
+    }
+  }
+  return NULL;
+}
+
+static void touch(BlockCache *bcp, blkcacheline_t *lp) {
+  lp->stamp = ++bcp->clock;
+}
+
+/*
+ * Free line if any, least recently used one otherwise.
+ */
+static blkcacheline_t *victim(const BlockCache *bcp) {
+  blkcacheline_t *vp = &bcp->config->lines[0];
+  uint32_t i;
+
+  for (i = 0U; i < bcp->config->nlines; i++) {
+    blkcacheline_t *lp = &bcp->config->lines[i];
+    if (!lp->valid) {
+      return lp;
+    }
+    if ((bcp->clock - lp->stamp) > (bcp->clock - vp->stamp)) {
+      vp = lp;
+    }
+  }
+  return vp;
+}
+
+static bool writeback(BlockCache *bcp, blkcacheline_t *lp) {
+
+  if (lp->valid && lp->dirty) {
+    uint8_t *data = line_data(bcp, lp);
+
+    cacheBufferFlush(data, bcp->blk_size);
+    if (blkWrite(bcp->config->blkdev, lp->blk, data, 1)) {
+      return HAL_FAILED;
+    }
+    lp->dirty = false;
+    bcp->stats.writebacks++;
+  }
+  return HAL_SUCCESS;
+}
+
+/*
+ * Copies the blocks of a transfer overlapping the read-ahead window into
+ * the window, the window always holds the newest data of its blocks.
+ */
+static void ahead_update(BlockCache *bcp, uint32_t startblk,
+                         const uint8_t *buffer, uint32_t n) {
+  uint32_t first, last;
+
+  first = startblk > bcp->ahead_blk ? startblk : bcp->ahead_blk;
+  last  = (startblk + n) < (bcp->ahead_blk + bcp->ahead_n) ?
+          (startblk + n) : (bcp->ahead_blk + bcp->ahead_n);
+  if (first < last) {
+    memcpy(&bcp->config->ahead[(first - bcp->ahead_blk) * bcp->blk_size],
+           &buffer[(first - startblk) * bcp->blk_size],
+           (last - first) * bcp->blk_size);
+  }
+}
+
+/*
+ * Interface implementation.
+ */
+static bool is_inserted(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkIsInserted(bcp->config->blkdev);
+}
+
+static bool is_protected(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkIsWriteProtected(bcp->config->blkdev);
+}
+
+static bool connect(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkConnect(bcp->config->blkdev);
+}
+
+static bool disconnect(void *instance) {
+  BlockCache *bcp = instance;
+
+  return blkDisconnect(bcp->config->blkdev);
+}
+
+static bool read(void *instance, uint32_t startblk,
+                 uint8_t *buffer, uint32_t n) {
+  BlockCache *bcp = instance;
+  const BlockCacheConfig *config = bcp->config;
+  blkcacheline_t *lp;
+  uint32_t i;
+
+  if ((BLK_READY != bcp->state) || overflow(bcp, startblk, n)) {
+    return HAL_FAILED;
+  }
+
+  if (n > 1U) {
+    /* Multiple blocks, straight from the device then the blocks only
+       present in the cache are patched in.*/
+    if (blkRead(config->blkdev, startblk, buffer, n)) {
+      return HAL_FAILED;
+    }
+    for (i = 0U; i < config->nlines; i++) {
+      lp = &config->lines[i];
+      if (lp->valid && lp->dirty && ((lp->blk - startblk) < n)) {
+        memcpy(&buffer[(lp->blk - startblk) * bcp->blk_size],
+               line_data(bcp, lp), bcp->blk_size);
+      }
+    }
+    bcp->stats.misses += n;
+    bcp->next = startblk + n;
+    return HAL_SUCCESS;
+  }
+
+  lp = lookup(bcp, startblk);
+  if (lp != NULL) {
+    memcpy(buffer, line_data(bcp, lp), bcp->blk_size);
+    touch(bcp, lp);
+    bcp->stats.hits++;
+  }
+  else if ((startblk - bcp->ahead_blk) < bcp->ahead_n) {
+    memcpy(buffer,
+           &config->ahead[(startblk - bcp->ahead_blk) * bcp->blk_size],
+           bcp->blk_size);
+    bcp->stats.hits++;
+  }
+  else if ((config->nahead > 0U) && (startblk == bcp->next)) {
+    /* Sequential access, the following blocks are fetched in the same
+       device transaction. Streamed data does not enter the cache lines,
+       they are kept for the metadata.*/
+    uint32_t cnt = bcp->blk_num - startblk;
+
+    if (cnt > config->nahead) {
+      cnt = config->nahead;
+    }
+    bcp->ahead_n = 0U;
+    if (blkRead(config->blkdev, startblk, config->ahead, cnt)) {
+      return HAL_FAILED;
+    }
+    bcp->ahead_blk = startblk;
+    bcp->ahead_n   = cnt;
+    for (i = 0U; i < config->nlines; i++) {
+      lp = &config->lines[i];
+      if (lp->valid && lp->dirty) {
+        ahead_update(bcp, lp->blk, line_data(bcp, lp), 1U);
+      }
+    }
+    memcpy(buffer, config->ahead, bcp->blk_size);
+    bcp->stats.readaheads++;
+    bcp->stats.misses++;
+  }
+  else {
+    lp = victim(bcp);
+    if (writeback(bcp, lp)) {
+      return HAL_FAILED;
+    }
+    lp->valid = false;
+    if (blkRead(config->blkdev, startblk, line_data(bcp, lp), 1)) {
+      return HAL_FAILED;
+    }
+    lp->blk   = startblk;
+    lp->valid = true;
+    lp->dirty = false;
+    touch(bcp, lp);
+    memcpy(buffer, line_data(bcp, lp), bcp->blk_size);
+    bcp->stats.misses++;
+  }
+  bcp->next = startblk + 1U;
+  return HAL_SUCCESS;
+}
+
+static bool write(void *instance, uint32_t startblk,
+                  const uint8_t *buffer, uint32_t n) {
+  BlockCache *bcp = instance;
+  const BlockCacheConfig *config = bcp->config;
+  blkcacheline_t *lp;
+  uint32_t i;
+
+  if ((BLK_READY != bcp->state) || overflow(bcp, startblk, n)) {
+    return HAL_FAILED;
+  }
+
+  if (n > 1U) {
+    /* Multiple blocks, written through, the cached copies are
+       refreshed.*/
+    cacheBufferFlush(buffer, n * bcp->blk_size);
+    if (blkWrite(config->blkdev, startblk, buffer, n)) {
+      return HAL_FAILED;
+    }
+    for (i = 0U; i < config->nlines; i++) {
+      lp = &config->lines[i];
+      if (lp->valid && ((lp->blk - startblk) < n)) {
+        memcpy(line_data(bcp, lp),
+               &buffer[(lp->blk - startblk) * bcp->blk_size], bcp->blk_size);
+        lp->dirty = false;
+      }
+    }
+  }
+  else {
+    /* Single block, written back on eviction or synchronization.*/
+    lp = lookup(bcp, startblk);
+    if (lp == NULL) {
+      lp = victim(bcp);
+      if (writeback(bcp, lp)) {
+        return HAL_FAILED;
+      }
+      lp->blk   = startblk;
+      lp->valid = true;
+    }
+    memcpy(line_data(bcp, lp), buffer, bcp->blk_size);
+    lp->dirty = true;
+    touch(bcp, lp);
+  }
+  ahead_update(bcp, startblk, buffer, n);
+  return HAL_SUCCESS;
+}
+
+static bool sync(void *instance) {
+  BlockCache *bcp = instance;
+  const BlockCacheConfig *config = bcp->config;
+
+  if (BLK_READY != bcp->state) {
+    return HAL_FAILED;
+  }
+
+  /* Dirty lines are written in ascending block order.*/
+  while (true) {
+    blkcacheline_t *lp = NULL;
+    uint32_t i;
+
+    for (i = 0U; i < config->nlines; i++) {
+      blkcacheline_t *cp = &config->lines[i];
+      if (cp->valid && cp->dirty && ((lp == NULL) || (cp->blk < lp->blk))) {
+        lp = cp;
+      }
+    }
+    if (lp == NULL) {
+      break;
+    }
+    if (writeback(bcp, lp)) {
+      return HAL_FAILED;
+    }
+  }
+  return blkSync(config->blkdev);
+}
+
+static bool get_info(void *instance, BlockDeviceInfo *bdip) {
+  BlockCache *bcp = instance;
+
+  if (BLK_READY != bcp->state) {
+    return HAL_FAILED;
+  }
+  bdip->blk_num  = bcp->blk_num;
+  bdip->blk_size = bcp->blk_size;
+  return HAL_SUCCESS;
+}
+
+/**
+ *
+ */
+static const struct BaseBlockDeviceVMT vmt = {
+    (size_t)0,
+    is_inserted,
+    is_protected,
+    connect,
+    disconnect,
+    read,
+    write,
+    sync,
+    get_info
+};
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Block cache object initialization.
+ *
+ * @param[out] bcp      pointer to @p BlockCache object
+ *
+ * @init
+ */
+void blkcacheObjectInit(BlockCache *bcp) {
+
+  bcp->vmt    = &vmt;
+  bcp->state  = BLK_STOP;
+  bcp->config = NULL;
+}
+
+/**
+ * @brief   Starts the cache in front of a block device.
+ * @pre     The cached device must be connected.
+ *
+ * @param[in] bcp       pointer to @p BlockCache object
+ * @param[in] config    pointer to the cache configuration
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the cache has been started.
+ * @retval HAL_FAILED   if the device geometry could not be read.
+ *
+ * @api
+ */
+bool blkcacheStart(BlockCache *bcp, const BlockCacheConfig *config) {
+  BlockDeviceInfo bdi;
+
+  osalDbgCheck((bcp != NULL) && (config != NULL) &&
+               (config->blkdev != NULL) && (config->lines != NULL) &&
+               (config->buffer != NULL) && (config->nlines > 0U) &&
+               ((config->nahead == 0U) || (config->ahead != NULL)));
+  osalDbgAssert((bcp->state == BLK_STOP) || (bcp->state == BLK_READY),
+                "invalid state");
+
+  if (blkGetInfo(config->blkdev, &bdi)) {
+    return HAL_FAILED;
+  }
+  osalDbgAssert(bdi.blk_size <= BLKCACHE_BLOCK_SIZE, "block size too large");
+
+  bcp->config   = config;
+  bcp->blk_size = bdi.blk_size;
+  bcp->blk_num  = bdi.blk_num;
+  memset(&bcp->stats, 0, sizeof(bcp->stats));
+  blkcacheInvalidate(bcp);
+  bcp->state    = BLK_READY;
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Writes back the dirty blocks and stops the cache.
+ *
+ * @param[in] bcp       pointer to @p BlockCache object
+ * @return              The write back status.
+ *
+ * @api
+ */
+bool blkcacheStop(BlockCache *bcp) {
+  bool result = HAL_SUCCESS;
+
+  osalDbgCheck(bcp != NULL);
+
+  if (bcp->state == BLK_READY) {
+    result = sync(bcp);
+  }
+  bcp->state = BLK_STOP;
+  return result;
+}
+
+/**
+ * @brief   Drops every cached block, dirty ones included.
+ * @details To be used after a media change.
+ *
+ * @param[in] bcp       pointer to @p BlockCache object
+ *
+ * @api
+ */
+void blkcacheInvalidate(BlockCache *bcp) {
+  uint32_t i;
+
+  osalDbgCheck((bcp != NULL) && (bcp->config != NULL));
+
+  for (i = 0U; i < bcp->config->nlines; i++) {
+    bcp->config->lines[i].valid = false;
+    bcp->config->lines[i].dirty = false;
+  }
+  bcp->clock   = 0U;
+  bcp->next    = 0U;
+  bcp->ahead_n = 0U;
+}
+
+/** @} */
@@ -0,0 +1,198 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkcache.h
+ * @brief   Caching block device wrapper header.
+ * @details The cache is itself a @p BaseBlockDevice placed in front of any
+ *          other block device:
+ *          - single block accesses go through an LRU set of cache lines,
+ *            writes are kept in the cache until evicted or synchronized
+ *            with @p blkSync(),
+ *          - single block reads following the previous read are detected
+ *            as sequential and served from a read-ahead window filled
+ *            with one multiple blocks read,
+ *          - multiple blocks accesses go straight to the device, the
+ *            cache lines they overlap are kept coherent.
+ * @note    There is no locking, accesses must be serialized by the
+ *          caller, as FatFS does for a volume.
+ *
+ * @addtogroup blkcache
+ * @{
+ */
+
+#ifndef BLKCACHE_H
+#define BLKCACHE_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of a cache line, the largest block size supported.
+ */
+#if !defined(BLKCACHE_BLOCK_SIZE) || defined(__DOXYGEN__)
+#define BLKCACHE_BLOCK_SIZE                 512U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Cache line descriptor.
+ */
+typedef struct {
+  /**
+   * @brief   Cached block number.
+   */
+  uint32_t                  blk;
+  /**
+   * @brief   Last use, the line with the oldest one is evicted first.
+   */
+  uint32_t                  stamp;
+  /**
+   * @brief   The line holds a block.
+   */
+  bool                      valid;
+  /**
+   * @brief   The block is newer than the device copy.
+   */
+  bool                      dirty;
+} blkcacheline_t;
+
+/**
+ * @brief   Cache configuration.
+ */
+typedef struct {
+  /**
+   * @brief   Cached block device.
+   */
+  BaseBlockDevice           *blkdev;
+  /**
+   * @brief   Cache lines descriptors.
+   */
+  blkcacheline_t            *lines;
+  /**
+   * @brief   Cache lines data, @p nlines * @p BLKCACHE_BLOCK_SIZE bytes.
+   */
+  uint8_t                   *buffer;
+  /**
+   * @brief   Number of cache lines.
+   */
+  uint32_t                  nlines;
+  /**
+   * @brief   Read-ahead window, @p nahead * @p BLKCACHE_BLOCK_SIZE bytes,
+   *          can be @p NULL.
+   */
+  uint8_t                   *ahead;
+  /**
+   * @brief   Number of blocks in the read-ahead window, zero disables the
+   *          read-ahead.
+   */
+  uint32_t                  nahead;
+} BlockCacheConfig;
+
+/**
+ * @brief   Cache statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Blocks read from a cache line or from the read-ahead window.
+   */
+  uint32_t                  hits;
+  /**
+   * @brief   Blocks read from the device.
+   */
+  uint32_t                  misses;
+  /**
+   * @brief   Read-ahead window fills.
+   */
+  uint32_t                  readaheads;
+  /**
+   * @brief   Dirty blocks written back to the device.
+   */
+  uint32_t                  writebacks;
+} BlockCacheStats;
+
+typedef struct BlockCache BlockCache;
+
+/**
+ * @brief   @p BlockCache specific data.
+ */
+#define _blkcache_data                                                      \
+  _base_block_device_data                                                   \
+  const BlockCacheConfig    *config;                                        \
+  /* Block size of the cached device.*/                                     \
+  uint32_t                  blk_size;                                       \
+  /* Number of blocks of the cached device.*/                               \
+  uint32_t                  blk_num;                                        \
+  /* LRU clock.*/                                                           \
+  uint32_t                  clock;                                          \
+  /* Block following the last one read.*/                                   \
+  uint32_t                  next;                                           \
+  /* First block and number of blocks held by the read-ahead window.*/      \
+  uint32_t                  ahead_blk;                                      \
+  uint32_t                  ahead_n;                                        \
+  BlockCacheStats           stats;
+
+/**
+ * @brief   Caching block device.
+ */
+struct BlockCache {
+  /** @brief Virtual Methods Table.*/
+  const struct BaseBlockDeviceVMT *vmt;
+  _blkcache_data
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the cache statistics.
+ *
+ * @param[in] bcp       pointer to the @p BlockCache object
+ * @return              Pointer to the @p BlockCacheStats counters.
+ */
+#define blkcacheGetStats(bcp) (&(bcp)->stats)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void blkcacheObjectInit(BlockCache *bcp);
+  bool blkcacheStart(BlockCache *bcp, const BlockCacheConfig *config);
+  bool blkcacheStop(BlockCache *bcp);
+  void blkcacheInvalidate(BlockCache *bcp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLKCACHE_H */
+
+/** @} */
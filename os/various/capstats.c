@@ -0,0 +1,218 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    capstats.c
+ * @brief   Capture timestamp statistics code.
+ *
+ * @addtogroup CAPSTATS
+ * @{
+ */
+
+#include "capstats.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void interval_reset(capinterval_t *ip) {
+
+  ip->count = 0U;
+  ip->min   = UINT32_MAX;
+  ip->max   = 0U;
+  ip->sum   = 0U;
+}
+
+static void interval_add(capinterval_t *ip, uint32_t t) {
+
+  ip->count++;
+  ip->sum += t;
+  if (t < ip->min) {
+    ip->min = t;
+  }
+  if (t > ip->max) {
+    ip->max = t;
+  }
+}
+
+static uint32_t interval_mean(const capinterval_t *ip) {
+
+  if (ip->count == 0U) {
+    return 0U;
+  }
+  return (uint32_t)(ip->sum / ip->count);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a statistics object.
+ * @details The next timestamp fed to the object is taken as a reference
+ *          active edge.
+ *
+ * @param[out] csp      pointer to the @p capstats_t object
+ * @param[in] mask      counter mask, @p CAPSTATS_MASK_16 for 16 bits timers
+ *                      or @p CAPSTATS_MASK_32 for 32 bits timers
+ */
+void capstatsObjectInit(capstats_t *csp, uint32_t mask) {
+
+  csp->mask        = mask;
+  csp->last_active = 0U;
+  csp->primed      = false;
+  csp->active      = false;
+  capstatsReset(csp);
+}
+
+/**
+ * @brief   Clears the accumulated statistics.
+ * @details The edge tracking state is kept so the next batch continues
+ *          from the previous one, use this to start a new measurement
+ *          window on a running stream.
+ *
+ * @param[in] csp       pointer to the @p capstats_t object
+ */
+void capstatsReset(capstats_t *csp) {
+
+  interval_reset(&csp->period);
+  interval_reset(&csp->width);
+}
+
+/**
+ * @brief   Accumulates a batch of single edge timestamps.
+ * @details Every timestamp is an active edge, the intervals between
+ *          consecutive timestamps are accumulated as periods.
+ *
+ * @param[in] csp       pointer to the @p capstats_t object
+ * @param[in] ts        timestamps buffer
+ * @param[in] n         number of timestamps
+ */
+void capstatsAddEdges(capstats_t *csp, const uint32_t *ts, size_t n) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    if (csp->primed) {
+      interval_add(&csp->period, (ts[i] - csp->last_active) & csp->mask);
+    }
+    csp->last_active = ts[i];
+    csp->primed = true;
+  }
+}
+
+/**
+ * @brief   Accumulates a batch of both edges timestamps.
+ * @details Timestamps alternate between active and idle edges, the first
+ *          timestamp after @p capstatsObjectInit() must be an active edge.
+ *          Idle edges close a width, active edges close a period.
+ *
+ * @param[in] csp       pointer to the @p capstats_t object
+ * @param[in] ts        timestamps buffer
+ * @param[in] n         number of timestamps
+ */
+void capstatsAddPulses(capstats_t *csp, const uint32_t *ts, size_t n) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    if (csp->active) {
+      interval_add(&csp->width, (ts[i] - csp->last_active) & csp->mask);
+      csp->active = false;
+    }
+    else {
+      if (csp->primed) {
+        interval_add(&csp->period, (ts[i] - csp->last_active) & csp->mask);
+      }
+      csp->last_active = ts[i];
+      csp->primed = true;
+      csp->active = true;
+    }
+  }
+}
+
+/**
+ * @brief   Returns the mean period.
+ *
+ * @param[in] csp       pointer to the @p capstats_t object
+ * @return              The mean period in counter ticks, zero if no
+ *                      period has been measured.
+ */
+uint32_t capstatsGetPeriod(const capstats_t *csp) {
+
+  return interval_mean(&csp->period);
+}
+
+/**
+ * @brief   Returns the mean pulse width.
+ *
+ * @param[in] csp       pointer to the @p capstats_t object
+ * @return              The mean width in counter ticks, zero if no width
+ *                      has been measured.
+ */
+uint32_t capstatsGetWidth(const capstats_t *csp) {
+
+  return interval_mean(&csp->width);
+}
+
+/**
+ * @brief   Returns the mean duty cycle.
+ *
+ * @param[in] csp       pointer to the @p capstats_t object
+ * @return              The duty cycle scaled to @p CAPSTATS_DUTY_SCALE,
+ *                      zero if no period has been measured.
+ */
+uint32_t capstatsGetDuty(const capstats_t *csp) {
+  uint32_t period = interval_mean(&csp->period);
+
+  if (period == 0U) {
+    return 0U;
+  }
+  return (uint32_t)(((uint64_t)interval_mean(&csp->width) *
+                     CAPSTATS_DUTY_SCALE) / period);
+}
+
+/**
+ * @brief   Converts a batch of timestamps into intervals.
+ * @details Each output element is the time elapsed since the previous
+ *          timestamp, as needed by pulse length protocol decoders.
+ * @note    The conversion can be done in place, @p dp can be equal
+ *          to @p ts.
+ *
+ * @param[out] dp       intervals buffer
+ * @param[in] ts        timestamps buffer
+ * @param[in] n         number of timestamps
+ * @param[in] last      timestamp preceding the batch
+ * @param[in] mask      counter mask
+ * @return              The last timestamp of the batch, to be passed as
+ *                      @p last for the next batch.
+ */
+uint32_t capstatsDeltas(uint32_t *dp, const uint32_t *ts, size_t n,
+                        uint32_t last, uint32_t mask) {
+  size_t i;
+
+  for (i = 0U; i < n; i++) {
+    uint32_t t = ts[i];
+
+    dp[i] = (t - last) & mask;
+    last = t;
+  }
+  return last;
+}
+
+/** @} */
@@ -0,0 +1,139 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    capstats.h
+ * @brief   Capture timestamp statistics header.
+ * @details Batch helpers turning the raw counter values produced by the
+ *          TIMCAP and EICU streaming modes into period, width and duty
+ *          statistics. Timestamps are free running counter values, the
+ *          counter wrap is handled by masking the differences with the
+ *          timer width so any interval shorter than a full counter cycle
+ *          is measured correctly.
+ * @note    The module has no HAL or kernel dependencies and can be
+ *          compiled on the host.
+ *
+ * @addtogroup CAPSTATS
+ * @{
+ */
+
+#ifndef CAPSTATS_H
+#define CAPSTATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Counter masks
+ * @{
+ */
+#define CAPSTATS_MASK_16                0x0000FFFFU
+#define CAPSTATS_MASK_32                0xFFFFFFFFU
+/** @} */
+
+/**
+ * @brief   Duty cycle full scale, 10000 is 100.00%.
+ */
+#define CAPSTATS_DUTY_SCALE             10000U
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Statistics of one kind of interval.
+ */
+typedef struct {
+  /**
+   * @brief   Number of intervals accumulated.
+   */
+  uint32_t                  count;
+  /**
+   * @brief   Shortest interval, @p UINT32_MAX if none.
+   */
+  uint32_t                  min;
+  /**
+   * @brief   Longest interval.
+   */
+  uint32_t                  max;
+  /**
+   * @brief   Sum of the intervals.
+   */
+  uint64_t                  sum;
+} capinterval_t;
+
+/**
+ * @brief   Capture statistics object.
+ */
+typedef struct {
+  /**
+   * @brief   Counter mask, @p CAPSTATS_MASK_16 or @p CAPSTATS_MASK_32.
+   */
+  uint32_t                  mask;
+  /**
+   * @brief   Active edge to active edge intervals.
+   */
+  capinterval_t             period;
+  /**
+   * @brief   Active edge to idle edge intervals.
+   */
+  capinterval_t             width;
+  /**
+   * @brief   Timestamp of the last active edge.
+   */
+  uint32_t                  last_active;
+  /**
+   * @brief   @p last_active holds a valid timestamp.
+   */
+  bool                      primed;
+  /**
+   * @brief   The next pulse timestamp is an idle edge.
+   */
+  bool                      active;
+} capstats_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void capstatsObjectInit(capstats_t *csp, uint32_t mask);
+  void capstatsReset(capstats_t *csp);
+  void capstatsAddEdges(capstats_t *csp, const uint32_t *ts, size_t n);
+  void capstatsAddPulses(capstats_t *csp, const uint32_t *ts, size_t n);
+  uint32_t capstatsGetPeriod(const capstats_t *csp);
+  uint32_t capstatsGetWidth(const capstats_t *csp);
+  uint32_t capstatsGetDuty(const capstats_t *csp);
+  uint32_t capstatsDeltas(uint32_t *dp, const uint32_t *ts, size_t n,
+                          uint32_t last, uint32_t mask);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPSTATS_H */
+
+/** @} */
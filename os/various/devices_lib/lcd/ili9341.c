@@ -77,12 +77,235 @@ ILI9341Driver ILI9341D1;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (TRUE == ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+
+/* Fixed cost of a rectangle, window and memory write commands.*/
+#define FB_RECT_COST    (11U + (5U * (uint32_t)ILI9341_FB_TRANSFER_COST))
+
+static void fb_union(ILI9341Rect *up, const ILI9341Rect *ap,
+                     const ILI9341Rect *bp) {
+
+  up->x0 = ap->x0 < bp->x0 ? ap->x0 : bp->x0;
+  up->y0 = ap->y0 < bp->y0 ? ap->y0 : bp->y0;
+  up->x1 = ap->x1 > bp->x1 ? ap->x1 : bp->x1;
+  up->y1 = ap->y1 > bp->y1 ? ap->y1 : bp->y1;
+}
+
+/**
+ * @brief   Tells whether a rectangle is better sent as full rows.
+ * @details A partial width rectangle needs one transfer per row, the full
+ *          rows band is contiguous in the framebuffer and goes out at once.
+ */
+static bool fb_widen(const ILI9341Driver *driverp, const ILI9341Rect *rectp) {
+  uint32_t fw = driverp->config->width;
+  uint32_t w = (uint32_t)rectp->x1 - rectp->x0 + 1U;
+  uint32_t h = (uint32_t)rectp->y1 - rectp->y0 + 1U;
+
+  return (w != fw) &&
+         ((2U * (fw - w) * h) + ILI9341_FB_TRANSFER_COST <=
+          h * ILI9341_FB_TRANSFER_COST);
+}
+
+/**
+ * @brief   Cost of pushing a rectangle, in bytes.
+ */
+static uint32_t fb_cost(const ILI9341Driver *driverp,
+                        const ILI9341Rect *rectp) {
+  uint32_t w = (uint32_t)rectp->x1 - rectp->x0 + 1U;
+  uint32_t h = (uint32_t)rectp->y1 - rectp->y0 + 1U;
+
+  if (fb_widen(driverp, rectp)) {
+    w = driverp->config->width;
+  }
+  if (w == driverp->config->width) {
+    return FB_RECT_COST + (2U * w * h) + ILI9341_FB_TRANSFER_COST;
+  }
+  return FB_RECT_COST + (2U * w * h) + (h * ILI9341_FB_TRANSFER_COST);
+}
+
+/**
+ * @brief   Makes room in a full dirty list.
+ * @details Among the entries and the new rectangle, the pair whose bounding
+ *          box costs the least over the two parts is merged. Merging only
+ *          the new rectangle would pull far apart areas together when it is
+ *          isolated and two entries are close.
+ *
+ * @return              The index of the entry to be merged with the new
+ *                      rectangle, or @p ndirty if two entries have been
+ *                      merged instead.
+ */
+static unsigned fb_make_room(ILI9341Driver *driverp, const ILI9341Rect *rectp) {
+  const unsigned n = driverp->ndirty;
+  ILI9341Rect u;
+  unsigned i, j, best_i = 0U, best_j = n;
+  int32_t growth, least = INT32_MAX;
+
+  for (i = 0; i < n; i++) {
+    for (j = i + 1U; j <= n; j++) {
+      const ILI9341Rect *bp = j < n ? &driverp->dirty[j] : rectp;
+
+      fb_union(&u, &driverp->dirty[i], bp);
+      growth = (int32_t)fb_cost(driverp, &u) -
+               (int32_t)fb_cost(driverp, &driverp->dirty[i]) -
+               (int32_t)fb_cost(driverp, bp);
+      if (growth < least) {
+        least = growth;
+        best_i = i;
+        best_j = j;
+      }
+    }
+  }
+
+  if (best_j == n) {
+    return best_i;
+  }
+  fb_union(&driverp->dirty[best_i], &driverp->dirty[best_i],
+           &driverp->dirty[best_j]);
+  driverp->dirty[best_j] = driverp->dirty[--driverp->ndirty];
+  return driverp->ndirty;
+}
+
+/**
+ * @brief   Adds a rectangle to the dirty list.
+ * @details The rectangle absorbs any entry whose bounding box is not more
+ *          expensive to push than the two parts, this repeats because the
+ *          grown rectangle could now absorb other entries. When the list is
+ *          full the cheapest merge is done anyway, see @p fb_make_room().
+ */
+static void fb_add(ILI9341Driver *driverp, ILI9341Rect rect) {
+  ILI9341Rect u;
+  unsigned i;
+  uint32_t cost;
+
+  while (true) {
+    cost = fb_cost(driverp, &rect);
+    for (i = 0; i < driverp->ndirty; i++) {
+      fb_union(&u, &driverp->dirty[i], &rect);
+      if (fb_cost(driverp, &u) <= fb_cost(driverp, &driverp->dirty[i]) + cost) {
+        break;
+      }
+    }
+    if (i == driverp->ndirty) {
+      if (driverp->ndirty < ILI9341_FB_MAX_DIRTY) {
+        break;
+      }
+      i = fb_make_room(driverp, &rect);
+      if (i == driverp->ndirty) {
+        /* Two entries merged, the rectangle is checked again.*/
+        continue;
+      }
+      fb_union(&u, &driverp->dirty[i], &rect);
+    }
+
+    /* The entry is removed and the merged rectangle is added again.*/
+    rect = u;
+    driverp->dirty[i] = driverp->dirty[--driverp->ndirty];
+  }
+  driverp->dirty[driverp->ndirty++] = rect;
+}
+
+/**
+ * @brief   Sends framebuffer memory, split in DMA sized transfers.
+ */
+static void fb_send(ILI9341Driver *driverp, const uint16_t *p, size_t n) {
+  const uint8_t *bp = (const uint8_t *)p;
+  size_t chunk;
+
+  while (n > 0U) {
+    chunk = n > ILI9341_FB_MAX_TRANSFER ? ILI9341_FB_MAX_TRANSFER : n;
+    ili9341WriteChunk(driverp, bp, chunk);
+    driverp->pixel_bytes += chunk;
+    driverp->transfers++;
+    bp += chunk;
+    n -= chunk;
+  }
+}
+
+/**
+ * @brief   Pushes a list of rectangles, one address window each.
+ * @pre     The bus is owned and the driver is ready.
+ */
+static void fb_push(ILI9341Driver *driverp, const ILI9341Rect *rects,
+                    unsigned n) {
+  const ILI9341Config *configp = driverp->config;
+  ILI9341Rect rect;
+  uint32_t w, y;
+
+  ili9341Select(driverp);
+  while (n-- > 0U) {
+    rect = *rects++;
+    if (fb_widen(driverp, &rect)) {
+      rect.x0 = 0U;
+      rect.x1 = configp->width - 1U;
+    }
+    w = (uint32_t)rect.x1 - rect.x0 + 1U;
+
+    ili9341SetWindow(driverp, &rect);
+    ili9341WriteCommand(driverp, ILI9341_SET_MEM);
+    driverp->cmd_bytes++;
+    driverp->transfers++;
+
+    if (w == configp->width) {
+      /* Full rows are contiguous, a single transfer for the whole band.*/
+      fb_send(driverp, &configp->framebuffer[(size_t)rect.y0 * w],
+              2U * w * ((uint32_t)rect.y1 - rect.y0 + 1U));
+    }
+    else {
+      /* Rows are sent back to back, the window wraps them in place.*/
+      for (y = rect.y0; y <= rect.y1; y++) {
+        fb_send(driverp,
+                &configp->framebuffer[(size_t)y * configp->width + rect.x0],
+                2U * w);
+      }
+    }
+  }
+  ili9341Unselect(driverp);
+}
+
+/**
+ * @brief   Asynchronous flush thread.
+ */
+static THD_FUNCTION(fb_flusher, arg) {
+  ILI9341Driver *driverp = (ILI9341Driver *)arg;
+  ili9341flushcb_t cb;
+
+  chRegSetThreadName("ili9341");
+  while (true) {
+    chBSemWait(&driverp->flush_req);
+    if (chThdShouldTerminateX()) {
+      break;
+    }
+
+#if (TRUE == ILI9341_USE_MUTUAL_EXCLUSION)
+    ili9341AcquireBus(driverp);
+#endif
+    fb_push(driverp, driverp->flush, driverp->nflush);
+#if (TRUE == ILI9341_USE_MUTUAL_EXCLUSION)
+    ili9341ReleaseBus(driverp);
+#endif
+
+    /* The flush is complete before the callback so that the callback can
+       start the next one.*/
+    cb = driverp->flush_cb;
+    driverp->flush_cb = NULL;
+    driverp->nflush = 0U;
+    chBSemSignal(&driverp->flush_done);
+    if (cb != NULL) {
+      cb(driverp);
+    }
+  }
+}
+
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
 
 /**
  * @brief   Initializes the standard part of a @p ILI9341Driver structure.
+ * @note    The driver must not be started, @p ili9341Stop() terminates the
+ *          asynchronous flush thread.
  *
  * @param[out] driverp  pointer to the @p ILI9341Driver object
  *
@@ -101,6 +324,14 @@ void ili9341ObjectInit(ILI9341Driver *driverp) {
   chSemObjectInit(&driverp->lock, 1);
 #endif
 #endif /* (TRUE == ILI9341_USE_MUTUAL_EXCLUSION) */
+#if (TRUE == ILI9341_USE_FRAMEBUFFER)
+  driverp->ndirty = 0U;
+  driverp->nflush = 0U;
+  driverp->flush_cb = NULL;
+  driverp->flusher = NULL;
+  chBSemObjectInit(&driverp->flush_req, true);
+  chBSemObjectInit(&driverp->flush_done, false);
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
 }
 
 /**
@@ -125,10 +356,27 @@ void ili9341Start(ILI9341Driver *driverp, const ILI9341Config *configp) {
   driverp->config = configp;
   driverp->state = ILI9341_READY;
   chSysUnlock();
+
+#if (TRUE == ILI9341_USE_FRAMEBUFFER)
+  if (configp->framebuffer != NULL) {
+    osalDbgCheck((configp->width > 0U) && (configp->height > 0U));
+
+    osalDbgAssert(driverp->flusher == NULL, "flush thread running");
+
+    driverp->ndirty = 0U;
+    ili9341FbResetStatistics(driverp);
+    driverp->flusher = chThdCreateStatic(driverp->flusher_wa,
+                                         sizeof (driverp->flusher_wa),
+                                         ILI9341_FB_THREAD_PRIO,
+                                         fb_flusher, driverp);
+  }
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
 }
 
 /**
  * @brief   Deactivates the ILI9341 peripheral.
+ * @details A pending asynchronous flush is completed, then the flush thread
+ *          is terminated.
  * @pre     ILI9341 is ready.
  *
  * @param[in] driverp   pointer to the @p ILI9341Driver object
@@ -137,8 +385,19 @@ void ili9341Start(ILI9341Driver *driverp, const ILI9341Config *configp) {
  */
 void ili9341Stop(ILI9341Driver *driverp) {
 
-  chSysLock();
   osalDbgCheck(driverp != NULL);
+
+#if (TRUE == ILI9341_USE_FRAMEBUFFER)
+  if (driverp->flusher != NULL) {
+    ili9341FbWaitFlush(driverp);
+    chThdTerminate(driverp->flusher);
+    chBSemSignal(&driverp->flush_req);
+    chThdWait(driverp->flusher);
+    driverp->flusher = NULL;
+  }
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
+
+  chSysLock();
   osalDbgAssert(driverp->state == ILI9341_READY, "invalid state");
 
   driverp->state = ILI9341_STOP;
@@ -411,6 +670,206 @@ void ili9341ReadChunk(ILI9341Driver *driverp, uint8_t chunk[],
   }
 }
 
+#if (TRUE == ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+
+/**
+ * @brief   Sets the column and page address window.
+ * @details Sends @p ILI9341_SET_COL_ADDR and @p ILI9341_SET_PAGE_ADDR, each
+ *          with its four parameters in a single transfer.
+ * @pre     ILI9341 is active.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ * @param[in] rectp     window, bounds are inclusive
+ *
+ * @api
+ */
+void ili9341SetWindow(ILI9341Driver *driverp, const ILI9341Rect *rectp) {
+
+  osalDbgCheck((driverp != NULL) && (rectp != NULL));
+  osalDbgCheck((rectp->x0 <= rectp->x1) && (rectp->y0 <= rectp->y1));
+
+  ili9341WriteCommand(driverp, ILI9341_SET_COL_ADDR);
+  driverp->window[0] = (uint8_t)(rectp->x0 >> 8);
+  driverp->window[1] = (uint8_t)rectp->x0;
+  driverp->window[2] = (uint8_t)(rectp->x1 >> 8);
+  driverp->window[3] = (uint8_t)rectp->x1;
+  ili9341WriteChunk(driverp, driverp->window, 4);
+
+  ili9341WriteCommand(driverp, ILI9341_SET_PAGE_ADDR);
+  driverp->window[0] = (uint8_t)(rectp->y0 >> 8);
+  driverp->window[1] = (uint8_t)rectp->y0;
+  driverp->window[2] = (uint8_t)(rectp->y1 >> 8);
+  driverp->window[3] = (uint8_t)rectp->y1;
+  ili9341WriteChunk(driverp, driverp->window, 4);
+
+  driverp->cmd_bytes += 10U;
+  driverp->transfers += 4U;
+}
+
+/**
+ * @brief   Marks a framebuffer area as modified.
+ * @details The area is clipped to the framebuffer and merged into the dirty
+ *          list, see @p ILI9341_FB_TRANSFER_COST.
+ * @note    The dirty list belongs to the rendering thread, it is not
+ *          protected against concurrent invalidations.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ * @param[in] x         left column
+ * @param[in] y         top row
+ * @param[in] width     area width
+ * @param[in] height    area height
+ *
+ * @api
+ */
+void ili9341FbInvalidate(ILI9341Driver *driverp, uint16_t x, uint16_t y,
+                         uint16_t width, uint16_t height) {
+  const ILI9341Config *configp;
+  ILI9341Rect rect;
+
+  osalDbgCheck(driverp != NULL);
+  configp = driverp->config;
+  osalDbgCheck((configp != NULL) && (configp->framebuffer != NULL));
+
+  if ((x >= configp->width) || (y >= configp->height) ||
+      (width == 0U) || (height == 0U)) {
+    return;
+  }
+  if (width > configp->width - x) {
+    width = configp->width - x;
+  }
+  if (height > configp->height - y) {
+    height = configp->height - y;
+  }
+
+  rect.x0 = x;
+  rect.y0 = y;
+  rect.x1 = x + width - 1U;
+  rect.y1 = y + height - 1U;
+  fb_add(driverp, rect);
+}
+
+/**
+ * @brief   Marks the whole framebuffer as modified.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ *
+ * @api
+ */
+void ili9341FbInvalidateAll(ILI9341Driver *driverp) {
+
+  osalDbgCheck(driverp != NULL);
+  osalDbgCheck((driverp->config != NULL) &&
+               (driverp->config->framebuffer != NULL));
+
+  driverp->dirty[0].x0 = 0U;
+  driverp->dirty[0].y0 = 0U;
+  driverp->dirty[0].x1 = driverp->config->width - 1U;
+  driverp->dirty[0].y1 = driverp->config->height - 1U;
+  driverp->ndirty = 1U;
+}
+
+/**
+ * @brief   Pushes the dirty rectangles to the display.
+ * @details Each rectangle sets the address window once and then sends its
+ *          pixels, full width rectangles with a single transfer.
+ * @pre     ILI9341 is ready, the bus is owned by the caller, no asynchronous
+ *          flush is pending.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ *
+ * @api
+ */
+void ili9341FbFlush(ILI9341Driver *driverp) {
+
+  osalDbgCheck(driverp != NULL);
+  osalDbgCheck((driverp->config != NULL) &&
+               (driverp->config->framebuffer != NULL));
+  osalDbgAssert(driverp->nflush == 0U, "flush pending");
+
+  fb_push(driverp, driverp->dirty, driverp->ndirty);
+  driverp->ndirty = 0U;
+}
+
+/**
+ * @brief   Starts pushing the dirty rectangles to the display.
+ * @details The dirty list is handed to the flush thread and emptied, the
+ *          caller can render and invalidate the next frame while the
+ *          transfer is in progress. A previous flush is waited for first.
+ * @note    With @p ILI9341_USE_MUTUAL_EXCLUSION the flush thread acquires
+ *          the bus, otherwise the caller must not use the bus until the
+ *          flush is complete.
+ * @note    Pixels of the flushed rectangles must not be modified until the
+ *          flush is complete.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ * @param[in] cb        completion callback, invoked from the flush thread,
+ *                      or directly if there is nothing to flush, can be
+ *                      @p NULL
+ *
+ * @api
+ */
+void ili9341FbStartFlush(ILI9341Driver *driverp, ili9341flushcb_t cb) {
+  unsigned i;
+
+  osalDbgCheck(driverp != NULL);
+  osalDbgCheck((driverp->config != NULL) &&
+               (driverp->config->framebuffer != NULL));
+
+  ili9341FbWaitFlush(driverp);
+  if (driverp->ndirty == 0U) {
+    if (cb != NULL) {
+      cb(driverp);
+    }
+    return;
+  }
+
+  for (i = 0; i < driverp->ndirty; i++) {
+    driverp->flush[i] = driverp->dirty[i];
+  }
+  driverp->nflush = driverp->ndirty;
+  driverp->ndirty = 0U;
+  driverp->flush_cb = cb;
+
+  chBSemReset(&driverp->flush_done, true);
+  chBSemSignal(&driverp->flush_req);
+}
+
+/**
+ * @brief   Waits for the asynchronous flush to complete.
+ * @details Returns immediately if no flush is pending.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ *
+ * @api
+ */
+void ili9341FbWaitFlush(ILI9341Driver *driverp) {
+
+  osalDbgCheck(driverp != NULL);
+
+  chBSemWait(&driverp->flush_done);
+  chBSemSignal(&driverp->flush_done);
+}
+
+/**
+ * @brief   Clears the framebuffer transfer statistics.
+ * @details The @p pixel_bytes, @p cmd_bytes and @p transfers driver fields
+ *          count what the framebuffer APIs sent since the last reset.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ *
+ * @api
+ */
+void ili9341FbResetStatistics(ILI9341Driver *driverp) {
+
+  osalDbgCheck(driverp != NULL);
+
+  driverp->pixel_bytes = 0U;
+  driverp->cmd_bytes = 0U;
+  driverp->transfers = 0U;
+}
+
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
+
 #else /* ILI9341_IM == * */
 #error "Only the ILI9341_IM_4LSI_1 interface mode is currently supported"
 #endif /* ILI9341_IM == * */
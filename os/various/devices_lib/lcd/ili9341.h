@@ -163,6 +163,63 @@
 #define ILI9341_USE_CHECKS                  TRUE
 #endif
 
+/**
+ * @brief   Enables the framebuffer and dirty rectangles APIs.
+ * @note    Requires @p CH_CFG_USE_SEMAPHORES and @p CH_CFG_USE_WAITEXIT
+ *          for the asynchronous flush thread.
+ */
+#if !defined(ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+#define ILI9341_USE_FRAMEBUFFER             FALSE
+#endif
+
+/**
+ * @brief   Maximum number of dirty rectangles tracked between flushes.
+ * @details When the list is full the two rectangles, the new one included,
+ *          whose bounding box costs the least over the two parts are
+ *          merged, far apart areas then cost the pixels in between. Each
+ *          entry takes 16 bytes of RAM, the dirty and the flushed lists.
+ */
+#if !defined(ILI9341_FB_MAX_DIRTY) || defined(__DOXYGEN__)
+#define ILI9341_FB_MAX_DIRTY                16
+#endif
+
+/**
+ * @brief   Cost of one more SPI transfer, expressed in bytes.
+ * @details Accounts for the window commands, the DMA setup and the bus
+ *          turnaround. Two rectangles are merged, and a partial width
+ *          rectangle is widened to full rows so that it goes out with a
+ *          single transfer, when the extra pixel bytes do not exceed the
+ *          transfers saved.
+ */
+#if !defined(ILI9341_FB_TRANSFER_COST) || defined(__DOXYGEN__)
+#define ILI9341_FB_TRANSFER_COST            32
+#endif
+
+/**
+ * @brief   Maximum length of a single SPI transfer, in bytes.
+ * @note    Must be even, it is bounded by the DMA counter width.
+ */
+#if !defined(ILI9341_FB_MAX_TRANSFER) || defined(__DOXYGEN__)
+#define ILI9341_FB_MAX_TRANSFER             65534U
+#endif
+
+/**
+ * @brief   Asynchronous flush thread working area size.
+ * @details The default covers the flush itself, the SPI and PAL calls and
+ *          the port interrupt frames. The completion callback runs on this
+ *          thread, its own stack usage must be added.
+ */
+#if !defined(ILI9341_FB_THREAD_WA_SIZE) || defined(__DOXYGEN__)
+#define ILI9341_FB_THREAD_WA_SIZE           512
+#endif
+
+/**
+ * @brief   Asynchronous flush thread priority.
+ */
+#if !defined(ILI9341_FB_THREAD_PRIO) || defined(__DOXYGEN__)
+#define ILI9341_FB_THREAD_PRIO              (NORMALPRIO + 1)
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -180,6 +237,19 @@
 #error "Only ILI9341_IM_4LSI_1 interface mode is supported currently"
 #endif
 
+#if ((TRUE == ILI9341_USE_FRAMEBUFFER) && \
+     ((TRUE != CH_CFG_USE_SEMAPHORES) || (TRUE != CH_CFG_USE_WAITEXIT)))
+#error "ILI9341_USE_FRAMEBUFFER requires CH_CFG_USE_SEMAPHORES and CH_CFG_USE_WAITEXIT"
+#endif
+
+#if (ILI9341_FB_MAX_DIRTY < 1) || (ILI9341_FB_MAX_DIRTY > 255)
+#error "invalid ILI9341_FB_MAX_DIRTY value"
+#endif
+
+#if (ILI9341_FB_MAX_TRANSFER < 2) || ((ILI9341_FB_MAX_TRANSFER & 1) != 0)
+#error "invalid ILI9341_FB_MAX_TRANSFER value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -189,6 +259,24 @@ typedef struct ILI9341Config ILI9341Config;
 typedef enum ili9341state_t ili9341state_t;
 typedef struct ILI9341Driver ILI9341Driver;
 
+#if (TRUE == ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+/**
+ * @brief   Framebuffer rectangle, bounds are inclusive.
+ */
+typedef struct {
+  uint16_t      x0;                 /**< Left column.*/
+  uint16_t      y0;                 /**< Top row.*/
+  uint16_t      x1;                 /**< Right column.*/
+  uint16_t      y1;                 /**< Bottom row.*/
+} ILI9341Rect;
+
+/**
+ * @brief   Asynchronous flush completion callback.
+ * @note    Invoked from the flush thread, the bus has already been released.
+ */
+typedef void (*ili9341flushcb_t)(ILI9341Driver *driverp);
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
+
 /**
  * @brief   ILI9341 driver configuration.
  */
@@ -198,6 +286,16 @@ typedef struct ILI9341Config {
   ioportid_t    dcx_port;           /**< <tt>D/!C</tt> signal port.*/
   uint16_t      dcx_pad;            /**< <tt>D/!C</tt> signal pad.*/
 #endif /* ILI9341_IM == * */ /* TODO: Add all modes.*/
+#if (TRUE == ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+  /**
+   * @brief   RGB565 framebuffer, @p width * @p height pixels in wire byte
+   *          order (see @p ILI9341_FB_PIXEL()), row major.
+   * @note    Must be accessible by DMA, @p NULL disables the framebuffer.
+   */
+  uint16_t      *framebuffer;
+  uint16_t      width;              /**< Framebuffer width, in pixels.*/
+  uint16_t      height;             /**< Framebuffer height, in pixels.*/
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
 } ILI9341Config;
 
 /**
@@ -228,6 +326,23 @@ typedef struct ILI9341Driver {
 
   /* Temporary variables.*/
   uint8_t               value;      /**< Non-stacked value, for SPI with CCM.*/
+
+#if (TRUE == ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+  /* Framebuffer stuff.*/
+  uint8_t               window[4];  /**< Non-stacked window parameters.*/
+  uint8_t               ndirty;     /**< Dirty rectangles count.*/
+  uint8_t               nflush;     /**< Rectangles being flushed count.*/
+  ILI9341Rect           dirty[ILI9341_FB_MAX_DIRTY];  /**< Dirty list.*/
+  ILI9341Rect           flush[ILI9341_FB_MAX_DIRTY];  /**< Flushed list.*/
+  ili9341flushcb_t      flush_cb;   /**< Pending flush callback.*/
+  thread_t              *flusher;   /**< Asynchronous flush thread.*/
+  binary_semaphore_t    flush_req;  /**< Flush requested.*/
+  binary_semaphore_t    flush_done; /**< No flush pending.*/
+  uint32_t              pixel_bytes;  /**< Pixel bytes sent, statistics.*/
+  uint32_t              cmd_bytes;  /**< Command bytes sent, statistics.*/
+  uint32_t              transfers;  /**< SPI transfers, statistics.*/
+  THD_WORKING_AREA(flusher_wa, ILI9341_FB_THREAD_WA_SIZE);  /**< Flusher.*/
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
 } ILI9341Driver;
 
 /**
@@ -553,6 +668,32 @@ typedef union {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if (TRUE == ILI9341_USE_FRAMEBUFFER) || defined(__DOXYGEN__)
+/**
+ * @brief   Converts an RGB565 color to the framebuffer wire byte order.
+ * @details The controller expects the most significant byte first while the
+ *          SPI sends the framebuffer memory in address order.
+ *
+ * @param[in] rgb565    RGB565 color
+ */
+#define ILI9341_FB_PIXEL(rgb565)                                            \
+  ((uint16_t)((((uint16_t)(rgb565) & 0xFFU) << 8) |                         \
+              ((uint16_t)(rgb565) >> 8)))
+
+/**
+ * @brief   Framebuffer pixel lvalue.
+ * @note    Pixels of rectangles being flushed asynchronously must not be
+ *          modified until the completion callback.
+ *
+ * @param[in] driverp   pointer to the @p ILI9341Driver object
+ * @param[in] x         column
+ * @param[in] y         row
+ */
+#define ili9341FbPixel(driverp, x, y)                                       \
+  ((driverp)->config->framebuffer[(size_t)(y) * (driverp)->config->width +  \
+                                  (x)])
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -583,6 +724,16 @@ extern "C" {
                          size_t length);
   void ili9341ReadChunk(ILI9341Driver *driverp, uint8_t chunk[],
                         size_t length);
+#if (TRUE == ILI9341_USE_FRAMEBUFFER)
+  void ili9341SetWindow(ILI9341Driver *driverp, const ILI9341Rect *rectp);
+  void ili9341FbInvalidate(ILI9341Driver *driverp, uint16_t x, uint16_t y,
+                           uint16_t width, uint16_t height);
+  void ili9341FbInvalidateAll(ILI9341Driver *driverp);
+  void ili9341FbFlush(ILI9341Driver *driverp);
+  void ili9341FbStartFlush(ILI9341Driver *driverp, ili9341flushcb_t cb);
+  void ili9341FbWaitFlush(ILI9341Driver *driverp);
+  void ili9341FbResetStatistics(ILI9341Driver *driverp);
+#endif /* TRUE == ILI9341_USE_FRAMEBUFFER */
 
 #ifdef __cplusplus
 }
@@ -34,6 +34,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "ch.h"
 #include "hal.h"
 
@@ -55,6 +57,42 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Tells whether an address is one of the device registers.
+ */
+static bool is_register(uint16_t adr) {
+
+  switch (adr) {
+    case MAX7219_AD_DIGIT_0:
+    case MAX7219_AD_DIGIT_1:
+    case MAX7219_AD_DIGIT_2:
+    case MAX7219_AD_DIGIT_3:
+    case MAX7219_AD_DIGIT_4:
+    case MAX7219_AD_DIGIT_5:
+    case MAX7219_AD_DIGIT_6:
+    case MAX7219_AD_DIGIT_7:
+    case MAX7219_AD_DECODE_MODE:
+    case MAX7219_AD_INTENSITY:
+    case MAX7219_AD_SCAN_LIMIT:
+    case MAX7219_AD_SHUTDOWN:
+    case MAX7219_AD_DISPLAY_TEST:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief   Sends the frame prepared in the chain buffer.
+ * @details All the devices latch their word on the same CS rising edge.
+ */
+static void chain_send(MAX7219_Chain *chp) {
+
+  spiSelect(chp->spip);
+  spiSend(chp->spip, chp->n, chp->txbuf);
+  spiUnselect(chp->spip);
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -91,4 +129,83 @@ void max7219WriteRegister(SPIDriver *spip, uint16_t adr, uint8_t data) {
       spiUnselect(spip);
   }
 }
+
+/**
+ * @brief   Initializes a chain object.
+ * @note    The framebuffer is cleared, the devices are refreshed by the
+ *          first flush.
+ *
+ * @param[out] chp      pointer to the chain object
+ * @param[in] spip      pointer to the SPI interface
+ * @param[in] n         number of cascaded devices
+ */
+void max7219ChainObjectInit(MAX7219_Chain *chp, SPIDriver *spip, uint8_t n) {
+
+  chDbgCheck((n > 0) && (n <= MAX7219_CHAIN_MAX_DEVICES));
+
+  chp->spip = spip;
+  chp->n = n;
+  memset(chp->fb, 0, sizeof(chp->fb));
+  chp->invalid = true;
+}
+
+/**
+ * @brief   Writes the same register in every device of the chain.
+ * @pre     The SPI interface must be initialized and the driver started.
+ *
+ * @param[in] chp       pointer to the chain object
+ * @param[in] adr       address number
+ * @param[in] data      data value.
+ */
+void max7219ChainWriteRegister(MAX7219_Chain *chp, uint16_t adr,
+                               uint8_t data) {
+  unsigned i;
+
+  chDbgCheck((chp != NULL) && is_register(adr));
+
+  /* Unknown addresses are ignored, as by max7219WriteRegister().*/
+  if (!is_register(adr))
+    return;
+
+  for (i = 0; i < chp->n; i++) {
+    chp->txbuf[i] = adr | data;
+  }
+  chain_send(chp);
+}
+
+/**
+ * @brief   Sends the framebuffer digits changed since the last flush.
+ * @details A digit row changed in any device is sent to the whole chain
+ *          in a single frame, 8 frames at most refresh the whole chain.
+ * @pre     The SPI interface must be initialized and the driver started.
+ *
+ * @param[in] chp       pointer to the chain object
+ *
+ * @return              the number of frames sent.
+ */
+unsigned max7219ChainFlush(MAX7219_Chain *chp) {
+  unsigned digit, dev, frames = 0;
+
+  for (digit = 0; digit < 8; digit++) {
+    bool changed = chp->invalid;
+
+    for (dev = 0; !changed && (dev < chp->n); dev++) {
+      changed = chp->fb[dev][digit] != chp->shadow[dev][digit];
+    }
+    if (!changed) {
+      continue;
+    }
+
+    /* The first word shifted in ends up in the farthest device.*/
+    for (dev = 0; dev < chp->n; dev++) {
+      uint8_t data = chp->fb[dev][digit];
+      chp->txbuf[chp->n - 1 - dev] = (MAX7219_AD_DIGIT_0 + (digit << 8)) | data;
+      chp->shadow[dev][digit] = data;
+    }
+    chain_send(chp);
+    frames++;
+  }
+  chp->invalid = false;
+  return frames;
+}
 /** @} */
@@ -89,6 +89,13 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Maximum number of cascaded devices handled by a chain object.
+ */
+#if !defined(MAX7219_CHAIN_MAX_DEVICES) || defined(__DOXYGEN__)
+#define MAX7219_CHAIN_MAX_DEVICES           8
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -164,11 +171,63 @@ typedef enum {
   MAX7219_SL_6          = 0x06,                 /*!< Scanned digit 0 - 6 */
   MAX7219_SL_7          = 0x07                  /*!< Scanned digit 0 - 7 */
 } MAX7219_SL_t;
+
+/**
+ * @brief  MAX7219 cascaded chain
+ *
+ * @details Device 0 is the one connected to the MCU. The application
+ *          draws into @p fb, @p max7219ChainFlush() sends the digits that
+ *          differ from @p shadow, the last values sent to the devices.
+ */
+typedef struct {
+  /**
+   * @brief Pointer to the SPI driver, configured for 16 bits frames.
+   */
+  SPIDriver                 *spip;
+  /**
+   * @brief Number of cascaded devices.
+   */
+  uint8_t                   n;
+  /**
+   * @brief Framebuffer, one byte per device and digit.
+   */
+  uint8_t                   fb[MAX7219_CHAIN_MAX_DEVICES][8];
+  /**
+   * @brief Digits currently displayed.
+   */
+  uint8_t                   shadow[MAX7219_CHAIN_MAX_DEVICES][8];
+  /**
+   * @brief The shadow buffer does not match the devices.
+   */
+  bool                      invalid;
+  /**
+   * @brief Frame for the whole chain, farthest device first.
+   */
+  uint16_t                  txbuf[MAX7219_CHAIN_MAX_DEVICES];
+} MAX7219_Chain;
 /** @}  */
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @brief   Sets a digit in the chain framebuffer.
+ *
+ * @param[in] chp       pointer to the chain object
+ * @param[in] dev       device index, 0 is the nearest to the MCU
+ * @param[in] digit     digit number, from 0 to 7
+ * @param[in] data      digit value
+ */
+#define max7219ChainSetDigit(chp, dev, digit, data)                          \
+  ((chp)->fb[(dev)][(digit)] = (uint8_t)(data))
+
+/**
+ * @brief   Forces the next flush to send every digit.
+ *
+ * @param[in] chp       pointer to the chain object
+ */
+#define max7219ChainInvalidate(chp) ((chp)->invalid = true)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -178,6 +237,10 @@ extern "C" {
 #endif
 
   void max7219WriteRegister(SPIDriver *spip, uint16_t adr, uint8_t data);
+  void max7219ChainObjectInit(MAX7219_Chain *chp, SPIDriver *spip, uint8_t n);
+  void max7219ChainWriteRegister(MAX7219_Chain *chp, uint16_t adr,
+                                 uint8_t data);
+  unsigned max7219ChainFlush(MAX7219_Chain *chp);
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "ch.h"
 #include "hal.h"
 
@@ -44,6 +46,23 @@
 /*===========================================================================*/
 
 #define ACTIVATE                  0x73
+
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Depth of the hardware TX FIFO.
+ */
+#define TX_FIFO_DEPTH             3
+
+/**
+ * @brief   Pipe number of the top RX FIFO payload, 7 if the FIFO is empty.
+ */
+#define STATUS_RX_P_NO(status)    (((status) >> 1) & 0x07)
+#define RX_P_NO_EMPTY             0x07
+
+#define STATUS_IRQ_FLAGS          (NRF24L01_DI_STATUS_RX_DR |                \
+                                   NRF24L01_DI_STATUS_TX_DS |                \
+                                   NRF24L01_DI_STATUS_MAX_RT)
+#endif /* NRF24L01_USE_DRIVER */
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -56,6 +75,209 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Runs one command, the status comes with its first byte.
+ *
+ * @param[in] drvp      pointer to the driver object
+ * @param[in] n         command length including the command byte
+ *
+ * @return              the status register value
+ */
+static NRF24L01_status_t xfer(NRF24L01_Driver *drvp, size_t n) {
+  SPIDriver *spip = drvp->config->rfcfg->spip;
+
+  spiSelect(spip);
+  spiExchange(spip, n, drvp->txbuf, drvp->rxbuf);
+  spiUnselect(spip);
+  return drvp->rxbuf[0];
+}
+
+static NRF24L01_status_t xfer_cmd(NRF24L01_Driver *drvp, uint8_t cmd,
+                                  uint8_t arg, size_t n) {
+
+  drvp->txbuf[0] = cmd;
+  drvp->txbuf[1] = arg;
+  return xfer(drvp, n);
+}
+
+static void tx_release(NRF24L01_Driver *drvp, unsigned n) {
+
+  chSysLock();
+  drvp->txrd   = (drvp->txrd + n) % NRF24L01_TXQ_SIZE;
+  drvp->txcnt -= n;
+  while (n-- > 0U) {
+    chSemSignalI(&drvp->txfree);
+  }
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Accounts the packets completed by the TX FIFO.
+ * @details The TX_DS flags of back to back packets can merge, the number
+ *          of packets left in the FIFO is taken from FIFO_STATUS when it
+ *          is unambiguous, otherwise one packet per TX_DS is assumed.
+ */
+static void tx_complete(NRF24L01_Driver *drvp, NRF24L01_status_t status) {
+  uint8_t remaining;
+
+  /* Retransmissions of the last packet.*/
+  xfer_cmd(drvp, NRF24L01_CMD_READ | NRF24L01_AD_OBSERVE_TX,
+           NRF24L01_CMD_NOP, 2);
+  drvp->stats.tx_retransmits += drvp->rxbuf[1] & 0x0F;
+
+  if (status & NRF24L01_DI_STATUS_TX_DS) {
+    xfer_cmd(drvp, NRF24L01_CMD_READ | NRF24L01_AD_FIFO_STATUS,
+             NRF24L01_CMD_NOP, 2);
+    if (drvp->rxbuf[1] & NRF24L01_DI_FIFO_STATUS_TX_EMPTY) {
+      remaining = 0;
+    }
+    else if ((drvp->rxbuf[1] & NRF24L01_DI_FIFO_STATUS_TX_FULL) ||
+             (drvp->inflight <= 1)) {
+      remaining = drvp->inflight;
+    }
+    else {
+      remaining = drvp->inflight - 1;
+    }
+    drvp->stats.tx_packets += drvp->inflight - remaining;
+    tx_release(drvp, drvp->inflight - remaining);
+    drvp->inflight = remaining;
+  }
+
+  if (status & NRF24L01_DI_STATUS_MAX_RT) {
+    /* The FIFO can only be flushed as a whole, the packets following the
+       failed one are written again from the queue.*/
+    xfer_cmd(drvp, NRF24L01_CMD_FLUSH_TX, 0, 1);
+    if (drvp->inflight > 0U) {
+      drvp->stats.tx_lost++;
+      tx_release(drvp, 1);
+    }
+    drvp->inflight = 0;
+  }
+}
+
+/**
+ * @brief   Drains the RX FIFO into the RX queue.
+ * @details The FIFO is left untouched while the queue is full, the
+ *          transceiver then stops acknowledging and the transmitter
+ *          retries.
+ */
+static NRF24L01_status_t rx_drain(NRF24L01_Driver *drvp,
+                                  NRF24L01_status_t status) {
+  const NRF24L01_DriverConfig *config = drvp->config;
+
+  while (drvp->rxcnt < NRF24L01_RXQ_SIZE) {
+    uint8_t len = config->payload_len;
+
+#if NRF24L01_USE_FEATURE
+    if (config->rfcfg->en_dpl == NRF24L01_DPL_enabled) {
+      status = xfer_cmd(drvp, NRF24L01_CMD_R_RX_PL_WID, NRF24L01_CMD_NOP, 2);
+      len = drvp->rxbuf[1];
+    }
+    else
+#endif
+    {
+      status = xfer_cmd(drvp, NRF24L01_CMD_NOP, 0, 1);
+    }
+    if (STATUS_RX_P_NO(status) == RX_P_NO_EMPTY) {
+      break;
+    }
+    if (len > NRF24L01_MAX_PL_LENGHT) {
+      /* Corrupted length, the datasheet requires the FIFO to be flushed.*/
+      status = xfer_cmd(drvp, NRF24L01_CMD_FLUSH_RX, 0, 1);
+      break;
+    }
+
+    /* Payload read in the same frame as the command.*/
+    drvp->txbuf[0] = NRF24L01_CMD_R_RX_PAYLOAD;
+    memset(&drvp->txbuf[1], NRF24L01_CMD_NOP, len);
+    xfer(drvp, len + 1);
+
+    chSysLock();
+    NRF24L01_packet_t *pp = &drvp->rxq[(drvp->rxrd + drvp->rxcnt) %
+                                       NRF24L01_RXQ_SIZE];
+    pp->len  = len;
+    pp->pipe = STATUS_RX_P_NO(status);
+    memcpy(pp->data, &drvp->rxbuf[1], len);
+    drvp->rxcnt++;
+    drvp->stats.rx_packets++;
+    chSemSignalI(&drvp->rxfull);
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+  return status;
+}
+
+/**
+ * @brief   Keeps the TX FIFO filled from the TX queue.
+ */
+static NRF24L01_status_t tx_fill(NRF24L01_Driver *drvp,
+                                 NRF24L01_status_t status) {
+
+  while ((drvp->inflight < TX_FIFO_DEPTH) &&
+         (drvp->inflight < drvp->txcnt)) {
+    const NRF24L01_packet_t *pp = &drvp->txq[(drvp->txrd + drvp->inflight) %
+                                             NRF24L01_TXQ_SIZE];
+
+    drvp->txbuf[0] = NRF24L01_CMD_W_TX_PAYLOAD;
+    memcpy(&drvp->txbuf[1], pp->data, pp->len);
+    status = xfer(drvp, pp->len + 1);
+    drvp->inflight++;
+  }
+  return status;
+}
+
+/**
+ * @brief   Services the transceiver until no interrupt flag is pending.
+ */
+static void service(NRF24L01_Driver *drvp) {
+  NRF24L01_status_t status;
+
+#if SPI_USE_MUTUAL_EXCLUSION
+  spiAcquireBus(drvp->config->rfcfg->spip);
+#endif
+  status = xfer_cmd(drvp, NRF24L01_CMD_NOP, 0, 1);
+  do {
+    /* The TX FIFO is flushed on MAX_RT before the flag is cleared, the
+       transceiver would otherwise resume with the failed packet.*/
+    if (status & (NRF24L01_DI_STATUS_TX_DS | NRF24L01_DI_STATUS_MAX_RT)) {
+      tx_complete(drvp, status);
+    }
+    if (status & STATUS_IRQ_FLAGS) {
+      xfer_cmd(drvp, NRF24L01_CMD_WRITE | NRF24L01_AD_STATUS,
+               status & STATUS_IRQ_FLAGS, 2);
+    }
+    status = rx_drain(drvp, status);
+    status = tx_fill(drvp, status);
+
+    /* Flags raised during the service did not produce a new edge.*/
+    status = xfer_cmd(drvp, NRF24L01_CMD_NOP, 0, 1);
+  } while (status & STATUS_IRQ_FLAGS);
+#if SPI_USE_MUTUAL_EXCLUSION
+  spiReleaseBus(drvp->config->rfcfg->spip);
+#endif
+}
+
+static void irq_cb(void *arg) {
+  NRF24L01_Driver *drvp = (NRF24L01_Driver *)arg;
+
+  chSysLockFromISR();
+  chBSemSignalI(&drvp->wakeup);
+  chSysUnlockFromISR();
+}
+
+static THD_FUNCTION(nrf24l01_thread, arg) {
+  NRF24L01_Driver *drvp = (NRF24L01_Driver *)arg;
+
+  chRegSetThreadName("nrf24l01");
+  while (!chThdShouldTerminateX()) {
+    chBSemWaitTimeout(&drvp->wakeup, TIME_MS2I(NRF24L01_POLL_INTERVAL));
+    service(drvp);
+  }
+}
+#endif /* NRF24L01_USE_DRIVER */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -91,13 +313,13 @@ NRF24L01_status_t nrf24l01GetStatus(SPIDriver *spip) {
  */
 NRF24L01_status_t nrf24l01ReadRegister(SPIDriver *spip, uint8_t reg,
                                        uint8_t* pvalue) {
-  uint8_t txbuf = (NRF24L01_CMD_READ | reg);
-  uint8_t status = 0xFF;
+  uint8_t txbuf[2] = {(NRF24L01_CMD_READ | reg), NRF24L01_CMD_NOP};
+  uint8_t rxbuf[2] = {0xFF, 0xFF};
   spiSelect(spip);
-  spiExchange(spip, 1, &txbuf, &status);
-  spiReceive(spip, 1, pvalue);
+  spiExchange(spip, 2, txbuf, rxbuf);
   spiUnselect(spip);
-  return status;
+  *pvalue = rxbuf[1];
+  return rxbuf[0];
 }
 
 /**
@@ -247,16 +469,18 @@ NRF24L01_status_t nrf24l01WriteAddress(SPIDriver *spip, uint8_t reg,
 NRF24L01_status_t nrf24l01GetRxPl(SPIDriver *spip, uint8_t paylen,
                                   uint8_t* rxbuf) {
 
-  uint8_t txbuf = NRF24L01_CMD_R_RX_PAYLOAD;
-  uint8_t status;
+  uint8_t txbuf[NRF24L01_MAX_PL_LENGHT + 1];
+  uint8_t buf[NRF24L01_MAX_PL_LENGHT + 1];
   if(paylen > NRF24L01_MAX_PL_LENGHT) {
     return 0;
   }
+  txbuf[0] = NRF24L01_CMD_R_RX_PAYLOAD;
+  memset(&txbuf[1], NRF24L01_CMD_NOP, paylen);
   spiSelect(spip);
-  spiExchange(spip, 1, &txbuf, &status);
-  spiReceive(spip, paylen, rxbuf);
+  spiExchange(spip, paylen + 1, txbuf, buf);
   spiUnselect(spip);
-  return status;
+  memcpy(rxbuf, &buf[1], paylen);
+  return buf[0];
 }
 
 /**
@@ -274,16 +498,17 @@ NRF24L01_status_t nrf24l01GetRxPl(SPIDriver *spip, uint8_t paylen,
 NRF24L01_status_t nrf24l01WriteTxPl(SPIDriver *spip, uint8_t paylen,
                                     uint8_t* txbuf) {
 
-  uint8_t cmd = NRF24L01_CMD_W_TX_PAYLOAD;
-  uint8_t status;
+  uint8_t buf[NRF24L01_MAX_PL_LENGHT + 1];
+  uint8_t rxbuf[NRF24L01_MAX_PL_LENGHT + 1];
   if(paylen > NRF24L01_MAX_PL_LENGHT) {
     return 0;
   }
+  buf[0] = NRF24L01_CMD_W_TX_PAYLOAD;
+  memcpy(&buf[1], txbuf, paylen);
   spiSelect(spip);
-  spiExchange(spip, 1, &cmd, &status);
-  spiSend(spip, paylen, txbuf);
+  spiExchange(spip, paylen + 1, buf, rxbuf);
   spiUnselect(spip);
-  return status;
+  return rxbuf[0];
 }
 
 /**
@@ -348,7 +573,7 @@ NRF24L01_status_t nrf24l01FlushRx(SPIDriver *spip) {
  */
 NRF24L01_status_t nrf24l01Activate(SPIDriver *spip) {
 
-  uint8_t txbuf[2] = {NRF24L01_CMD_FLUSH_RX, ACTIVATE};
+  uint8_t txbuf[2] = {NRF24L01_CMD_ACTIVATE, ACTIVATE};
   uint8_t rxbuf[2];
   spiSelect(spip);
   spiExchange(spip, 2, txbuf, rxbuf);
@@ -437,4 +662,203 @@ NRF24L01_status_t nrf24l01WriteTxPlNoAck(SPIDriver *spip, uint8_t paylen,
 }
 #endif /* NRF24L01_USE_FEATURE */
 
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a driver object.
+ *
+ * @param[out] drvp     pointer to the driver object
+ */
+void nrf24l01ObjectInit(NRF24L01_Driver *drvp) {
+
+  memset(drvp, 0, sizeof(*drvp));
+  chBSemObjectInit(&drvp->wakeup, TRUE);
+  chSemObjectInit(&drvp->txfree, NRF24L01_TXQ_SIZE);
+  chSemObjectInit(&drvp->rxfull, 0);
+}
+
+/**
+ * @brief   Configures the transceiver and starts the service thread.
+ * @details The link uses pipe 0 on @p address with auto acknowledge, the
+ *          IRQ line is serviced through a PAL event on its falling edge.
+ * @note    On the nRF24L01 (non plus) the features must have been enabled
+ *          with @p nrf24l01Activate() before starting the driver.
+ *
+ * @param[in] drvp      pointer to the driver object
+ * @param[in] config    pointer to the driver configuration
+ */
+void nrf24l01Start(NRF24L01_Driver *drvp, const NRF24L01_DriverConfig *config) {
+  const NRF24L01_Config *rfcfg = config->rfcfg;
+  SPIDriver *spip = rfcfg->spip;
+  uint8_t aw = (uint8_t)rfcfg->address_width + 2;
+
+  chDbgCheck((drvp != NULL) && (config != NULL) && (config->address != NULL));
+  chDbgAssert(drvp->thread == NULL, "already started");
+  chDbgAssert(config->payload_len <= NRF24L01_MAX_PL_LENGHT,
+              "invalid payload length");
+
+  drvp->config = config;
+  spiStart(spip, rfcfg->spicfg);
+  palClearPad(rfcfg->ceport, rfcfg->cepad);
+
+  nrf24l01WriteRegister(spip, NRF24L01_AD_CONFIG,
+                        NRF24L01_DI_CONFIG_EN_CRC | NRF24L01_DI_CONFIG_CRCO |
+                        NRF24L01_DI_CONFIG_PWR_UP |
+                        (config->prx ? NRF24L01_DI_CONFIG_PRIM_RX : 0));
+  nrf24l01WriteRegister(spip, NRF24L01_AD_EN_AA, NRF24L01_DI_EN_AA_P0);
+  nrf24l01WriteRegister(spip, NRF24L01_AD_EN_RXADDR, NRF24L01_DI_EN_RXADDR_P0);
+  nrf24l01WriteRegister(spip, NRF24L01_AD_SETUP_AW, rfcfg->address_width);
+  nrf24l01WriteRegister(spip, NRF24L01_AD_SETUP_RETR,
+                        rfcfg->auto_retr_delay | rfcfg->auto_retr_count);
+  nrf24l01WriteRegister(spip, NRF24L01_AD_RF_CH, rfcfg->channel_freq);
+  nrf24l01WriteRegister(spip, NRF24L01_AD_RF_SETUP,
+                        rfcfg->data_rate | rfcfg->out_pwr | rfcfg->lna);
+#if NRF24L01_USE_FEATURE
+  nrf24l01WriteRegister(spip, NRF24L01_AD_FEATURE,
+                        rfcfg->en_dpl | rfcfg->en_ack_pay | rfcfg->en_dyn_ack);
+  nrf24l01WriteRegister(spip, NRF24L01_AD_DYNPD,
+                        rfcfg->en_dpl == NRF24L01_DPL_enabled ?
+                        NRF24L01_DI_DYNPD_DPL_P0 : 0);
+#endif
+  nrf24l01WriteRegister(spip, NRF24L01_AD_RX_PW_P0, config->payload_len);
+  nrf24l01WriteAddress(spip, NRF24L01_AD_RX_ADDR_P0,
+                       (uint8_t *)config->address, aw);
+  nrf24l01WriteAddress(spip, NRF24L01_AD_TX_ADDR,
+                       (uint8_t *)config->address, aw);
+  nrf24l01FlushTx(spip);
+  nrf24l01FlushRx(spip);
+  nrf24l01Reset(spip);
+
+  /* Power down to standby-I transition, Tpd2stby is 1.5ms.*/
+  chThdSleepMilliseconds(2);
+
+  palSetPadCallback(rfcfg->irqport, rfcfg->irqpad, irq_cb, drvp);
+  palEnablePadEvent(rfcfg->irqport, rfcfg->irqpad, PAL_EVENT_MODE_FALLING_EDGE);
+  drvp->last_time = chVTGetSystemTime();
+  drvp->thread = chThdCreateStatic(drvp->wa, sizeof(drvp->wa),
+                                   NRF24L01_THREAD_PRIO, nrf24l01_thread,
+                                   drvp);
+
+  /* Receiving, or transmitting as soon as the TX FIFO is filled.*/
+  palSetPad(rfcfg->ceport, rfcfg->cepad);
+}
+
+/**
+ * @brief   Stops the service thread and powers the transceiver down.
+ * @note    Queued packets are kept, they are sent after the next start.
+ *
+ * @param[in] drvp      pointer to the driver object
+ */
+void nrf24l01Stop(NRF24L01_Driver *drvp) {
+  const NRF24L01_Config *rfcfg = drvp->config->rfcfg;
+
+  chDbgAssert(drvp->thread != NULL, "not started");
+
+  palClearPad(rfcfg->ceport, rfcfg->cepad);
+  palDisablePadEvent(rfcfg->irqport, rfcfg->irqpad);
+  chThdTerminate(drvp->thread);
+  chBSemSignal(&drvp->wakeup);
+  chThdWait(drvp->thread);
+  drvp->thread = NULL;
+
+  nrf24l01FlushTx(rfcfg->spip);
+  drvp->inflight = 0;
+  nrf24l01WriteRegister(rfcfg->spip, NRF24L01_AD_CONFIG, 0);
+  spiStop(rfcfg->spip);
+}
+
+/**
+ * @brief   Queues a packet for transmission.
+ *
+ * @param[in] drvp      pointer to the driver object
+ * @param[in] buf       payload
+ * @param[in] len       payload length
+ * @param[in] timeout   time to wait for a free queue slot
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the packet has been queued.
+ * @retval MSG_TIMEOUT  if the queue stayed full.
+ */
+msg_t nrf24l01Send(NRF24L01_Driver *drvp, const uint8_t *buf, uint8_t len,
+                   sysinterval_t timeout) {
+  msg_t msg;
+
+  chDbgCheck((buf != NULL) && (len > 0) && (len <= NRF24L01_MAX_PL_LENGHT));
+
+  chSysLock();
+  msg = chSemWaitTimeoutS(&drvp->txfree, timeout);
+  if (msg == MSG_OK) {
+    NRF24L01_packet_t *pp = &drvp->txq[(drvp->txrd + drvp->txcnt) %
+                                       NRF24L01_TXQ_SIZE];
+    pp->len = len;
+    memcpy(pp->data, buf, len);
+    drvp->txcnt++;
+    chBSemSignalI(&drvp->wakeup);
+    chSchRescheduleS();
+  }
+  chSysUnlock();
+  return msg;
+}
+
+/**
+ * @brief   Dequeues a received packet.
+ *
+ * @param[in] drvp      pointer to the driver object
+ * @param[out] buf      payload buffer of @p NRF24L01_MAX_PL_LENGHT bytes
+ * @param[out] pipep    pipe the packet was received on, can be @p NULL
+ * @param[in] timeout   time to wait for a packet
+ *
+ * @return              The payload length or @p MSG_TIMEOUT.
+ */
+msg_t nrf24l01Receive(NRF24L01_Driver *drvp, uint8_t *buf, uint8_t *pipep,
+                      sysinterval_t timeout) {
+  msg_t msg;
+
+  chDbgCheck(buf != NULL);
+
+  chSysLock();
+  msg = chSemWaitTimeoutS(&drvp->rxfull, timeout);
+  if (msg == MSG_OK) {
+    const NRF24L01_packet_t *pp = &drvp->rxq[drvp->rxrd];
+    memcpy(buf, pp->data, pp->len);
+    if (pipep != NULL) {
+      *pipep = pp->pipe;
+    }
+    msg = pp->len;
+    drvp->rxrd = (drvp->rxrd + 1) % NRF24L01_RXQ_SIZE;
+
+    /* The RX FIFO may have been left undrained on a full queue.*/
+    if (drvp->rxcnt-- == NRF24L01_RXQ_SIZE) {
+      chBSemSignalI(&drvp->wakeup);
+      chSchRescheduleS();
+    }
+  }
+  chSysUnlock();
+  return msg;
+}
+
+/**
+ * @brief   Returns the link statistics.
+ * @details The rates are computed over the time elapsed since the
+ *          previous call.
+ *
+ * @param[in] drvp      pointer to the driver object
+ * @param[out] sp       pointer to the statistics
+ */
+void nrf24l01GetStats(NRF24L01_Driver *drvp, NRF24L01_stats_t *sp) {
+  systime_t now = chVTGetSystemTime();
+  time_msecs_t ms = chTimeI2MS(chTimeDiffX(drvp->last_time, now));
+
+  chSysLock();
+  *sp = drvp->stats;
+  chSysUnlock();
+  if (ms > 0) {
+    sp->tx_rate = ((sp->tx_packets - drvp->last_tx) * 1000U) / ms;
+    sp->rx_rate = ((sp->rx_packets - drvp->last_rx) * 1000U) / ms;
+  }
+  drvp->last_tx   = sp->tx_packets;
+  drvp->last_rx   = sp->rx_packets;
+  drvp->last_time = now;
+}
+#endif /* NRF24L01_USE_DRIVER */
+
 /** @} */
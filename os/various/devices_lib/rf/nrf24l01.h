@@ -51,6 +51,52 @@
 #define NRF24L01_USE_FEATURE                     TRUE
 #endif
 
+/**
+ * @brief   Enables the IRQ driven driver object.
+ * @details The driver object services the IRQ line through PAL events
+ *          and streams packets through software queues.
+ */
+#if !defined(NRF24L01_USE_DRIVER) || defined(__DOXYGEN__)
+#define NRF24L01_USE_DRIVER                      FALSE
+#endif
+
+/**
+ * @brief   Driver object TX software queue size, in packets.
+ */
+#if !defined(NRF24L01_TXQ_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_TXQ_SIZE                        8
+#endif
+
+/**
+ * @brief   Driver object RX software queue size, in packets.
+ */
+#if !defined(NRF24L01_RXQ_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_RXQ_SIZE                        8
+#endif
+
+/**
+ * @brief   Driver object service thread working area size.
+ */
+#if !defined(NRF24L01_THREAD_WA_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_THREAD_WA_SIZE                  256
+#endif
+
+/**
+ * @brief   Driver object service thread priority.
+ */
+#if !defined(NRF24L01_THREAD_PRIO) || defined(__DOXYGEN__)
+#define NRF24L01_THREAD_PRIO                     (NORMALPRIO + 2)
+#endif
+
+/**
+ * @brief   Driver object IRQ line polling interval in milliseconds.
+ * @details The line is edge triggered, polling recovers from an edge
+ *          lost while a flag was still pending.
+ */
+#if !defined(NRF24L01_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define NRF24L01_POLL_INTERVAL                   100
+#endif
+
 /**
  * @name    NRF24L01 register names
  * @{
@@ -280,8 +326,8 @@
 #error "RF_NRF24L01 requires HAL_USE_SPI."
 #endif
 
-#if !(HAL_USE_EXT)
-#error "RF_NRF24L01 requires HAL_USE_EXT."
+#if NRF24L01_USE_DRIVER && !(PAL_USE_CALLBACKS)
+#error "NRF24L01_USE_DRIVER requires PAL_USE_CALLBACKS."
 #endif
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
@@ -458,6 +504,7 @@ typedef struct {
    * @brief Pointer to the SPI configuration .
    */
   const SPIConfig           *spicfg;
+#if HAL_USE_EXT || defined(__DOXYGEN__)
   /**
    * @brief Pointer to the EXT driver associated to this RF.
    */
@@ -466,6 +513,7 @@ typedef struct {
    * @brief EXT configuration.
    */
   EXTConfig                 *extcfg;
+#endif /* HAL_USE_EXT */
   /**
    * @brief RF Transceiver auto retransmit count.
    */
@@ -516,6 +564,98 @@ typedef struct {
  * @brief   RF Transceiver status register value.
  */
 typedef  uint8_t             NRF24L01_status_t;
+
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+/**
+ * @brief   Driver object configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief RF Transceiver configuration.
+   */
+  const NRF24L01_Config     *rfcfg;
+  /**
+   * @brief Primary receiver if TRUE, primary transmitter otherwise.
+   */
+  bool                      prx;
+  /**
+   * @brief Link address, TX address and pipe 0 RX address.
+   */
+  const uint8_t             *address;
+  /**
+   * @brief Payload length when the dynamic payload length is disabled.
+   */
+  uint8_t                   payload_len;
+} NRF24L01_DriverConfig;
+
+/**
+ * @brief   Packet held in the software queues.
+ */
+typedef struct {
+  uint8_t                   len;
+  uint8_t                   pipe;
+  uint8_t                   data[NRF24L01_MAX_PL_LENGHT];
+} NRF24L01_packet_t;
+
+/**
+ * @brief   Link statistics.
+ */
+typedef struct {
+  uint32_t                  tx_packets;     /*!< Packets acknowledged.   */
+  uint32_t                  tx_lost;        /*!< Packets dropped on MAX_RT. */
+  uint32_t                  tx_retransmits; /*!< Auto retransmissions.   */
+  uint32_t                  rx_packets;     /*!< Packets received.       */
+  uint32_t                  tx_rate;        /*!< TX packets/s.           */
+  uint32_t                  rx_rate;        /*!< RX packets/s.           */
+} NRF24L01_stats_t;
+
+/**
+ * @brief   Driver object.
+ */
+typedef struct {
+  const NRF24L01_DriverConfig *config;
+  thread_t                  *thread;
+  /**
+   * @brief Wakes up the service thread, signaled by the IRQ line and
+   *        by the queues.
+   */
+  binary_semaphore_t        wakeup;
+  /**
+   * @brief Free slots in the TX queue.
+   */
+  semaphore_t               txfree;
+  /**
+   * @brief Packets waiting in the RX queue.
+   */
+  semaphore_t               rxfull;
+  /**
+   * @brief TX queue, packets stay queued until acknowledged.
+   */
+  NRF24L01_packet_t         txq[NRF24L01_TXQ_SIZE];
+  uint8_t                   txrd;
+  uint8_t                   txcnt;
+  /**
+   * @brief Oldest packets of the TX queue also held in the TX FIFO.
+   */
+  uint8_t                   inflight;
+  NRF24L01_packet_t         rxq[NRF24L01_RXQ_SIZE];
+  uint8_t                   rxrd;
+  uint8_t                   rxcnt;
+  /**
+   * @brief SPI transaction buffers.
+   */
+  uint8_t                   txbuf[NRF24L01_MAX_PL_LENGHT + 1];
+  uint8_t                   rxbuf[NRF24L01_MAX_PL_LENGHT + 1];
+  NRF24L01_stats_t          stats;
+  /**
+   * @brief Counters and time of the previous statistics snapshot.
+   */
+  uint32_t                  last_tx;
+  uint32_t                  last_rx;
+  systime_t                 last_time;
+  THD_WORKING_AREA(wa, NRF24L01_THREAD_WA_SIZE);
+} NRF24L01_Driver;
+#endif /* NRF24L01_USE_DRIVER */
 /** @}  */
 /*===========================================================================*/
 /* Driver macros.                                                            */
@@ -566,6 +706,16 @@ NRF24L01_status_t nrf24l01WriteAckPl(SPIDriver *spip, uint8_t ppp, uint8_t payle
 NRF24L01_status_t nrf24l01WriteTxPlNoAck(SPIDriver *spip, uint8_t paylen,
                                          uint8_t* txbuf);
 #endif /* NRF24L01_USE_FEATURE */
+#if NRF24L01_USE_DRIVER || defined(__DOXYGEN__)
+void nrf24l01ObjectInit(NRF24L01_Driver *drvp);
+void nrf24l01Start(NRF24L01_Driver *drvp, const NRF24L01_DriverConfig *config);
+void nrf24l01Stop(NRF24L01_Driver *drvp);
+msg_t nrf24l01Send(NRF24L01_Driver *drvp, const uint8_t *buf, uint8_t len,
+                   sysinterval_t timeout);
+msg_t nrf24l01Receive(NRF24L01_Driver *drvp, uint8_t *buf, uint8_t *pipep,
+                      sysinterval_t timeout);
+void nrf24l01GetStats(NRF24L01_Driver *drvp, NRF24L01_stats_t *sp);
+#endif /* NRF24L01_USE_DRIVER */
 #ifdef __cplusplus
 }
 #endif
@@ -32,6 +32,7 @@
 // Constant parameters
 #define RX_WAIT_FOR_ACK_TIMEOUT_US_2MBPS      (48)        /**< 2MBit RX wait for ack timeout value. Smallest reliable value - 43 */
 #define RX_WAIT_FOR_ACK_TIMEOUT_US_1MBPS      (64)        /**< 1MBit RX wait for ack timeout value. Smallest reliable value - 59 */
+#define RADIO_RAMP_UP_US                      (130)       /**< RX/TX ramp-up time. */
 
 #define NRF52_ADDR_UPDATE_MASK_BASE0          (1 << 0)    /*< Mask value to signal updating BASE0 radio address. */
 #define NRF52_ADDR_UPDATE_MASK_BASE1          (1 << 1)    /*< Mask value to signal updating BASE1 radio address. */
@@ -65,6 +66,14 @@
 #define NRF52_RADIO_IRQ_PRIORITY			  3                   /**< RADIO interrupt priority. */
 #endif
 
+#if NRF52_RX_FIFO_SIZE > 32
+#error "NRF52_RX_FIFO_SIZE must not exceed 32"
+#endif
+
+#if NRF52_RX_PIPE_FIFO_SIZE > NRF52_RX_FIFO_SIZE
+#error "NRF52_RX_PIPE_FIFO_SIZE must not exceed NRF52_RX_FIFO_SIZE"
+#endif
+
 #ifndef NRF52_RADIO_PPI_TIMER_START
 #error "PPI channel NRF52_RADIO_PPI_TIMER_START need to be defined"
 #endif
@@ -87,6 +96,7 @@
 #error "At least one hardware TIMER must be defined"
 #endif
 
+#if NRF52_RADIO_USE_ISR_DIRECT == FALSE
 #ifndef NRF52_RADIO_INTTHD_PRIORITY
 #error "Interrupt handle thread priority need to be defined"
 #endif
@@ -94,6 +104,16 @@
 #ifndef NRF52_RADIO_EVTTHD_PRIORITY
 #error "Event thread priority need to be defined"
 #endif
+#endif
+
+#if (NRF52_RADIO_USE_ISR_DIRECT == TRUE) && (NRF52_RADIO_HW_TURNAROUND == TRUE)
+#define RADIO_USE_HW_TURNAROUND               TRUE
+#ifndef NRF52_RADIO_PPI_TURNAROUND
+#error "PPI channel NRF52_RADIO_PPI_TURNAROUND need to be defined"
+#endif
+#else
+#define RADIO_USE_HW_TURNAROUND               FALSE
+#endif
 
 #define VERIFY_PAYLOAD_LENGTH(p)                            \
 do                                                          \
@@ -124,10 +144,11 @@ typedef struct
     uint32_t            count;                              /**< Current number of elements in the queue. */
 } nrf52_payload_tx_fifo_t;
 
-// First in first out queue of received payloads.
+// First in first out queue of received payloads, one for each pipe. The
+// payloads are held in a pool shared by all the pipes.
 typedef struct
 {
-    nrf52_payload_t *   p_payload[NRF52_RX_FIFO_SIZE];      /**< Pointer to the actual queue. */
+    uint8_t             slot[NRF52_RX_PIPE_FIFO_SIZE];      /**< Pool slots of the queued payloads. */
     uint32_t            entry_point;                        /**< Current start of queue. */
     uint32_t            exit_point;                         /**< Current end of queue. */
     uint32_t            count;                              /**< Current number of elements in the queue. */
@@ -151,9 +172,12 @@ static nrf52_payload_t * p_current_payload;
 static nrf52_payload_t            tx_fifo_payload[NRF52_TX_FIFO_SIZE];
 static nrf52_payload_tx_fifo_t    tx_fifo;
 
-// RX FIFO
+// RX FIFOs
 static nrf52_payload_t            rx_fifo_payload[NRF52_RX_FIFO_SIZE];
-static nrf52_payload_rx_fifo_t    rx_fifo;
+static uint32_t                   rx_fifo_seq[NRF52_RX_FIFO_SIZE];   /**< Reception order across the pipes. */
+static uint32_t                   rx_fifo_free;                      /**< Free pool slots mask. */
+static nrf52_payload_rx_fifo_t    rx_fifo[NRF52_RX_PIPES];
+static uint32_t                   rx_seq;
 
 // Payload buffers
 static uint8_t                    tx_payload_buffer[NRF52_MAX_PAYLOAD_LENGTH + 2];
@@ -162,9 +186,11 @@ static uint8_t                    rx_payload_buffer[NRF52_MAX_PAYLOAD_LENGTH + 2
 static uint8_t                    pids[NRF52_PIPE_COUNT];
 static pipe_info_t                rx_pipe_info[NRF52_PIPE_COUNT];
 
+#if NRF52_RADIO_USE_ISR_DIRECT == FALSE
  // disable and events semaphores.
 static binary_semaphore_t disable_sem;
 static binary_semaphore_t events_sem;
+#endif
 
 RFDriver RFD1;
 
@@ -180,6 +206,43 @@ static uint32_t addr_conv(uint8_t const* p_addr) {
     return __REV(bytewise_bit_swap(p_addr)); //lint -esym(628, __rev) -esym(526, __rev) */
 }
 
+// Handles the DISABLED event of the current radio state.
+static void on_radio_disabled(RFDriver *rfp) {
+    switch (rfp->state) {
+      case NRF52_STATE_PTX_TX:
+        on_radio_disabled_tx_noack(rfp);
+        break;
+      case NRF52_STATE_PTX_TX_ACK:
+        on_radio_disabled_tx(rfp);
+        break;
+      case NRF52_STATE_PTX_RX_ACK:
+        on_radio_disabled_tx_wait_for_ack(rfp);
+        break;
+      case NRF52_STATE_PRX:
+        on_radio_disabled_rx(rfp);
+        break;
+      case NRF52_STATE_PRX_SEND_ACK:
+        on_radio_disabled_rx_ack(rfp);
+        break;
+      default:
+        break;
+    }
+}
+
+// Reports the pending interrupt flags to the event listeners.
+static void notify_events(RFDriver *rfp) {
+#if NRF52_RADIO_USE_ISR_DIRECT
+    chSysLockFromISR();
+    chEvtBroadcastFlagsI(&rfp->eventsrc, (eventflags_t) rfp->flags);
+    chSysUnlockFromISR();
+    rfp->flags = 0;
+#else
+    (void)rfp;
+    chBSemSignal(&events_sem);
+#endif
+}
+
+#if NRF52_RADIO_USE_ISR_DIRECT == FALSE
 static thread_t *rfEvtThread_p;
 static THD_WORKING_AREA(waRFEvtThread, 128);
 static THD_FUNCTION(rfEvtThread, arg) {
@@ -215,28 +278,11 @@ static THD_FUNCTION(rfIntThread, arg) {
 
     while (!chThdShouldTerminateX()) {
     	chBSemWait(&disable_sem);
-    	switch (RFD1.state) {
-    	  case NRF52_STATE_PTX_TX:
-    		  on_radio_disabled_tx_noack(&RFD1);
-    		  break;
-    	  case NRF52_STATE_PTX_TX_ACK:
-    		  on_radio_disabled_tx(&RFD1);
-    		  break;
-    	  case NRF52_STATE_PTX_RX_ACK:
-    		  on_radio_disabled_tx_wait_for_ack(&RFD1);
-    		  break;
-    	  case NRF52_STATE_PRX:
-    		  on_radio_disabled_rx(&RFD1);
-    		  break;
-    	  case NRF52_STATE_PRX_SEND_ACK:
-    		  on_radio_disabled_rx_ack(&RFD1);
-    		  break;
-    	  default:
-    		  break;
-    	}
+    	on_radio_disabled(&RFD1);
     }
 	chThdExit((msg_t) 0);
 }
+#endif /* NRF52_RADIO_USE_ISR_DIRECT == FALSE */
 
 static void serve_radio_interrupt(RFDriver *rfp) {
     if ((NRF_RADIO->INTENSET & RADIO_INTENSET_READY_Msk) && NRF_RADIO->EVENTS_READY) {
@@ -246,9 +292,14 @@ static void serve_radio_interrupt(RFDriver *rfp) {
     if ((NRF_RADIO->INTENSET & RADIO_INTENSET_DISABLED_Msk) && NRF_RADIO->EVENTS_DISABLED) {
         NRF_RADIO->EVENTS_DISABLED = 0;
         (void) NRF_RADIO->EVENTS_DISABLED;
+#if NRF52_RADIO_USE_ISR_DIRECT
+        // Hot path, the state machine runs here without a context switch
+        on_radio_disabled(rfp);
+#else
         chSysLockFromISR();
        	chBSemSignalI(&disable_sem);
        	chSysUnlockFromISR();
+#endif
     }
 }
 
@@ -375,6 +426,15 @@ static void ppi_init(RFDriver *rfp) {
 
     NRF_PPI->CH[NRF52_RADIO_PPI_TX_START].EEP    = (uint32_t)&rfp->timer->EVENTS_COMPARE[1];
     NRF_PPI->CH[NRF52_RADIO_PPI_TX_START].TEP    = (uint32_t)&NRF_RADIO->TASKS_TXEN;
+
+#if RADIO_USE_HW_TURNAROUND
+    // The turnaround channel disables itself and the TIMER_START channel
+    // after the first DISABLED event, see arm_hw_turnaround()
+    NRF_PPI->CH[NRF52_RADIO_PPI_TURNAROUND].EEP  = (uint32_t)&NRF_RADIO->EVENTS_DISABLED;
+    NRF_PPI->CH[NRF52_RADIO_PPI_TURNAROUND].TEP  = (uint32_t)&NRF_PPI->TASKS_CHG[NRF52_RADIO_PPI_GROUP].DIS;
+    NRF_PPI->CHG[NRF52_RADIO_PPI_GROUP]          = (1 << NRF52_RADIO_PPI_TIMER_START) |
+                                                   (1 << NRF52_RADIO_PPI_TURNAROUND);
+#endif
 }
 
 static void set_parameters(RFDriver *rfp) {
@@ -385,14 +445,26 @@ static void set_parameters(RFDriver *rfp) {
     set_rf_payload_format(rfp, rfp->config.payload_length);
 }
 
+static void reset_rx_fifo(void) {
+    for (int i = 0; i < NRF52_RX_PIPES; i++) {
+        rx_fifo[i].entry_point = 0;
+        rx_fifo[i].exit_point  = 0;
+        rx_fifo[i].count       = 0;
+    }
+    rx_fifo_free = 0xFFFFFFFFU >> (32 - NRF52_RX_FIFO_SIZE);
+}
+
+// True if a packet received on the pipe has no room.
+static bool rx_fifo_full(uint8_t pipe) {
+    return rx_fifo[pipe].count >= NRF52_RX_PIPE_FIFO_SIZE || rx_fifo_free == 0;
+}
+
 static void reset_fifo(void) {
     tx_fifo.entry_point = 0;
     tx_fifo.exit_point  = 0;
     tx_fifo.count       = 0;
 
-    rx_fifo.entry_point = 0;
-    rx_fifo.exit_point  = 0;
-    rx_fifo.count       = 0;
+    reset_rx_fifo();
 }
 
 static void init_fifo(void) {
@@ -401,10 +473,6 @@ static void init_fifo(void) {
     for (int i = 0; i < NRF52_TX_FIFO_SIZE; i++) {
         tx_fifo.p_payload[i] = &tx_fifo_payload[i];
     }
-
-    for (int i = 0; i < NRF52_RX_FIFO_SIZE; i++) {
-        rx_fifo.p_payload[i] = &rx_fifo_payload[i];
-    }
 }
 
 static void tx_fifo_remove_last(void) {
@@ -420,52 +488,77 @@ static void tx_fifo_remove_last(void) {
     }
 }
 
-/** @brief  Function to push the content of the rx_buffer to the RX FIFO.
+/** @brief  Function to push the content of a radio buffer to the pipe RX FIFO.
  *
  *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for receiving packets.
  *  After receiving a packet the module will call this function to copy the received data to
- *  the RX FIFO.
+ *  the RX FIFO of the pipe, together with the reception time.
  *
- *  @param  pipe Pipe number to set for the packet.
- *  @param  pid  Packet ID.
+ *  @param  p_buf Radio buffer holding the packet.
+ *  @param  pipe  Pipe number to set for the packet.
+ *  @param  pid   Packet ID.
  *
  *  @retval true   Operation successful.
  *  @retval false  Operation failed.
  */
-static bool rx_fifo_push_rfbuf(RFDriver *rfp, uint8_t pipe, uint8_t pid) {
-    if (rx_fifo.count < NRF52_RX_FIFO_SIZE) {
+static bool rx_fifo_push_rfbuf(RFDriver *rfp, uint8_t const *p_buf, uint8_t pipe, uint8_t pid) {
+    nrf52_payload_rx_fifo_t *p_fifo = &rx_fifo[pipe];
+    nrf52_payload_t *p_payload;
+    uint8_t slot;
+
+    if (!rx_fifo_full(pipe)) {
+        slot = (uint8_t)__builtin_ctz(rx_fifo_free);
+        p_payload = &rx_fifo_payload[slot];
+
         if (rfp->config.protocol == NRF52_PROTOCOL_ESB_DPL) {
-            if (rx_payload_buffer[0] > NRF52_MAX_PAYLOAD_LENGTH) {
+            if (p_buf[0] > NRF52_MAX_PAYLOAD_LENGTH) {
                 return false;
             }
 
-            rx_fifo.p_payload[rx_fifo.entry_point]->length = rx_payload_buffer[0];
+            p_payload->length = p_buf[0];
         }
         else if (rfp->state == NRF52_STATE_PTX_RX_ACK) {
             // Received packet is an acknowledgment
-            rx_fifo.p_payload[rx_fifo.entry_point]->length = 0;
+            p_payload->length = 0;
         }
         else {
-            rx_fifo.p_payload[rx_fifo.entry_point]->length = rfp->config.payload_length;
+            p_payload->length = rfp->config.payload_length;
         }
 
-        memcpy(rx_fifo.p_payload[rx_fifo.entry_point]->data, &rx_payload_buffer[2],
-               rx_fifo.p_payload[rx_fifo.entry_point]->length);
-
-        rx_fifo.p_payload[rx_fifo.entry_point]->pipe = pipe;
-        rx_fifo.p_payload[rx_fifo.entry_point]->rssi = NRF_RADIO->RSSISAMPLE;
-        rx_fifo.p_payload[rx_fifo.entry_point]->pid = pid;
-        if (++rx_fifo.entry_point >= NRF52_RX_FIFO_SIZE) {
-            rx_fifo.entry_point = 0;
+        memcpy(p_payload->data, &p_buf[2], p_payload->length);
+
+        p_payload->pipe = pipe;
+        p_payload->rssi = NRF_RADIO->RSSISAMPLE;
+        p_payload->pid = pid;
+        p_payload->timestamp = chVTGetSystemTimeX();
+        rx_fifo_seq[slot] = rx_seq++;
+        rx_fifo_free &= ~(1U << slot);
+        p_fifo->slot[p_fifo->entry_point] = slot;
+        if (++p_fifo->entry_point >= NRF52_RX_PIPE_FIFO_SIZE) {
+            p_fifo->entry_point = 0;
         }
-        rx_fifo.count++;
+        p_fifo->count++;
+        rfp->stats.rx_packets++;
 
         return true;
     }
 
+    rfp->stats.rx_overflows++;
     return false;
 }
 
+// Accounts a packet sent successfully.
+static void tx_done(RFDriver *rfp) {
+    uint32_t latency = chVTTimeElapsedSinceX(p_current_payload->timestamp);
+
+    rfp->stats.tx_packets++;
+    rfp->stats.latency_last = latency;
+    rfp->stats.latency_total += latency;
+    if (latency > rfp->stats.latency_max) {
+        rfp->stats.latency_max = latency;
+    }
+}
+
 static void timer_init(RFDriver *rfp) {
     // Configure the system timer with a 1 MHz base frequency
     rfp->timer->PRESCALER = 4;
@@ -473,11 +566,65 @@ static void timer_init(RFDriver *rfp) {
     rfp->timer->SHORTS    = TIMER_SHORTS_COMPARE1_CLEAR_Msk | TIMER_SHORTS_COMPARE1_STOP_Msk;
 }
 
+// Fills the TX buffer from the current payload.
+static void load_tx_buffer(RFDriver *rfp, bool ack) {
+    switch (rfp->config.protocol) {
+        case NRF52_PROTOCOL_ESB:
+            tx_payload_buffer[0] = p_current_payload->pid;
+            tx_payload_buffer[1] = 0;
+            break;
+
+        case NRF52_PROTOCOL_ESB_DPL:
+            tx_payload_buffer[0] = p_current_payload->length;
+            tx_payload_buffer[1] = p_current_payload->pid << 1;
+            tx_payload_buffer[1] |= ack ? 0x00 : 0x01;
+            break;
+    }
+    memcpy(&tx_payload_buffer[2], p_current_payload->data, p_current_payload->length);
+}
+
+// Programs the ACK wait timer: CC[0] disables the radio if no address is
+// received in time, CC[1] starts the retransmission.
+static void set_ack_timer(RFDriver *rfp, uint32_t start_offset_us) {
+    rfp->timer->CC[0]    = wait_for_ack_timeout_us + RADIO_RAMP_UP_US + start_offset_us;
+    rfp->timer->CC[1]    = rfp->config.retransmit.delay - RADIO_RAMP_UP_US + start_offset_us;
+    rfp->timer->TASKS_CLEAR = 1;
+    rfp->timer->EVENTS_COMPARE[0] = 0;
+    rfp->timer->EVENTS_COMPARE[1] = 0;
+    (void)rfp->timer->EVENTS_COMPARE[0];
+    (void)rfp->timer->EVENTS_COMPARE[1];
+}
+
+#if RADIO_USE_HW_TURNAROUND
+/* Arms the TX->RX turnaround before TX starts. The TX DISABLED event enables
+   RX and starts the ACK timer through the TIMER_START channel, the turnaround
+   channel disables both on the same event so the RX DISABLED event does not
+   trigger them again. The ACK is received in the TX buffer, the timer starts
+   one ramp-up earlier than in the CPU driven sequence. */
+static void arm_hw_turnaround(RFDriver *rfp) {
+    set_ack_timer(rfp, RADIO_RAMP_UP_US);
+
+    NRF_PPI->CH[NRF52_RADIO_PPI_TIMER_START].EEP = (uint32_t)&NRF_RADIO->EVENTS_DISABLED;
+    NRF_PPI->CH[NRF52_RADIO_PPI_TIMER_START].TEP = (uint32_t)&NRF_RADIO->TASKS_RXEN;
+    NRF_PPI->FORK[NRF52_RADIO_PPI_TIMER_START].TEP = (uint32_t)&rfp->timer->TASKS_START;
+
+    NRF_RADIO->EVENTS_CRCOK = 0;
+    (void)NRF_RADIO->EVENTS_CRCOK;
+
+    NRF_PPI->CHENSET = (1 << NRF52_RADIO_PPI_TIMER_START) |
+                       (1 << NRF52_RADIO_PPI_TURNAROUND)  |
+                       (1 << NRF52_RADIO_PPI_RX_TIMEOUT)  |
+                       (1 << NRF52_RADIO_PPI_TIMER_STOP);
+    NRF_PPI->CHENCLR = (1 << NRF52_RADIO_PPI_TX_START);
+}
+#endif
+
 static void start_tx_transaction(RFDriver *rfp) {
     bool ack;
 
     rfp->tx_attempt = 1;
     rfp->tx_remaining = rfp->config.retransmit.count;
+    rfp->hw_turnaround = false;
 
     // Prepare the payload
     p_current_payload = tx_fifo.p_payload[tx_fifo.exit_point];
@@ -485,12 +632,11 @@ static void start_tx_transaction(RFDriver *rfp) {
     // Handling ack if noack is set to false or if selctive auto ack is turned turned off
     ack = !p_current_payload->noack || !rfp->config.selective_auto_ack;
 
+    load_tx_buffer(rfp, ack);
+
     switch (rfp->config.protocol) {
         case NRF52_PROTOCOL_ESB:
             set_rf_payload_format(rfp, p_current_payload->length);
-            tx_payload_buffer[0] = p_current_payload->pid;
-            tx_payload_buffer[1] = 0;
-            memcpy(&tx_payload_buffer[2], p_current_payload->data, p_current_payload->length);
 
             NRF_RADIO->SHORTS   = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
             NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk | RADIO_INTENSET_READY_Msk;
@@ -501,13 +647,13 @@ static void start_tx_transaction(RFDriver *rfp) {
             break;
 
         case NRF52_PROTOCOL_ESB_DPL:
-            tx_payload_buffer[0] = p_current_payload->length;
-            tx_payload_buffer[1] = p_current_payload->pid << 1;
-            tx_payload_buffer[1] |= ack ? 0x00 : 0x01;
-            memcpy(&tx_payload_buffer[2], p_current_payload->data, p_current_payload->length);
-
             if (ack) {
-                NRF_RADIO->SHORTS   = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
+#if RADIO_USE_HW_TURNAROUND
+                // No payload format change between TX and ACK, PPI only
+                rfp->hw_turnaround = rfp->config.crc != NRF52_CRC_OFF;
+#endif
+                NRF_RADIO->SHORTS   = RADIO_SHORTS_COMMON |
+                                      (rfp->hw_turnaround ? 0 : RADIO_SHORTS_DISABLED_RXEN_Msk);
                 NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk | RADIO_INTENSET_READY_Msk;
 
                 // Configure the retransmit counter
@@ -533,6 +679,12 @@ static void start_tx_transaction(RFDriver *rfp) {
     (void)NRF_RADIO->EVENTS_READY;
     (void)NRF_RADIO->EVENTS_DISABLED;
 
+#if RADIO_USE_HW_TURNAROUND
+    if (rfp->hw_turnaround) {
+        arm_hw_turnaround(rfp);
+    }
+#endif
+
     nvicClearPending(RADIO_IRQn);
     nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
 
@@ -541,9 +693,10 @@ static void start_tx_transaction(RFDriver *rfp) {
 
 static void on_radio_disabled_tx_noack(RFDriver *rfp) {
     rfp->flags |= NRF52_INT_TX_SUCCESS_MSK;
+    tx_done(rfp);
     tx_fifo_remove_last();
 
-	chBSemSignal(&events_sem);
+	notify_events(rfp);
 
 	if (tx_fifo.count == 0) {
         rfp->state = NRF52_STATE_IDLE;
@@ -554,6 +707,21 @@ static void on_radio_disabled_tx_noack(RFDriver *rfp) {
 }
 
 static void on_radio_disabled_tx(RFDriver *rfp) {
+#if RADIO_USE_HW_TURNAROUND
+    if (rfp->hw_turnaround) {
+        // PPI already moved the radio to RX, if the interrupt came late the
+        // RX window could be over too and the two DISABLED events merged
+        rfp->state = NRF52_STATE_PTX_RX_ACK;
+        if (NRF_RADIO->STATE == RADIO_STATE_STATE_Disabled) {
+            NRF_RADIO->EVENTS_DISABLED = 0;
+            (void)NRF_RADIO->EVENTS_DISABLED;
+            nvicClearPending(RADIO_IRQn);
+            on_radio_disabled_tx_wait_for_ack(rfp);
+        }
+        return;
+    }
+#endif
+
     // Remove the DISABLED -> RXEN shortcut, to make sure the radio stays
     // disabled after the RX window
     NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON;
@@ -561,13 +729,13 @@ static void on_radio_disabled_tx(RFDriver *rfp) {
     // Make sure the timer is started the next time the radio is ready,
     // and that it will disable the radio automatically if no packet is
     // received by the time defined in m_wait_for_ack_timeout_us
-    rfp->timer->CC[0]    = wait_for_ack_timeout_us + 130;
-    rfp->timer->CC[1]    = rfp->config.retransmit.delay - 130;
-    rfp->timer->TASKS_CLEAR = 1;
-    rfp->timer->EVENTS_COMPARE[0] = 0;
-    rfp->timer->EVENTS_COMPARE[1] = 0;
-    (void)rfp->timer->EVENTS_COMPARE[0];
-    (void)rfp->timer->EVENTS_COMPARE[1];
+    set_ack_timer(rfp, 0);
+
+#if RADIO_USE_HW_TURNAROUND
+    NRF_PPI->CH[NRF52_RADIO_PPI_TIMER_START].EEP = (uint32_t)&NRF_RADIO->EVENTS_READY;
+    NRF_PPI->CH[NRF52_RADIO_PPI_TIMER_START].TEP = (uint32_t)&rfp->timer->TASKS_START;
+    NRF_PPI->FORK[NRF52_RADIO_PPI_TIMER_START].TEP = 0;
+#endif
 
     NRF_PPI->CHENSET = (1 << NRF52_RADIO_PPI_TIMER_START) |
                        (1 << NRF52_RADIO_PPI_RX_TIMEOUT) |
@@ -588,27 +756,43 @@ static void on_radio_disabled_tx(RFDriver *rfp) {
 static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp) {
     // This marks the completion of a TX_RX sequence (TX with ACK)
 
+    bool received;
+    uint8_t const *p_ack_buffer = rx_payload_buffer;
+
     // Make sure the timer will not deactivate the radio if a packet is received
     NRF_PPI->CHENCLR = (1 << NRF52_RADIO_PPI_TIMER_START) |
                        (1 << NRF52_RADIO_PPI_RX_TIMEOUT)  |
                        (1 << NRF52_RADIO_PPI_TIMER_STOP);
 
     // If the radio has received a packet and the CRC status is OK
-    if (NRF_RADIO->EVENTS_END && NRF_RADIO->CRCSTATUS != 0) {
+#if RADIO_USE_HW_TURNAROUND
+    if (rfp->hw_turnaround) {
+        // EVENTS_END is also set by the TX part, CRCOK only by RX
+        received = NRF_RADIO->EVENTS_CRCOK != 0;
+        p_ack_buffer = tx_payload_buffer;
+    }
+    else
+#endif
+    {
+        received = NRF_RADIO->EVENTS_END && NRF_RADIO->CRCSTATUS != 0;
+    }
+
+    if (received) {
         rfp->timer->TASKS_STOP = 1;
         NRF_PPI->CHENCLR = (1 << NRF52_RADIO_PPI_TX_START);
         rfp->flags |= NRF52_INT_TX_SUCCESS_MSK;
         rfp->tx_attempt++;// = rfp->config.retransmit.count - rfp->tx_remaining + 1;
 
+        tx_done(rfp);
         tx_fifo_remove_last();
 
-        if (rfp->config.protocol != NRF52_PROTOCOL_ESB && rx_payload_buffer[0] > 0) {
-            if (rx_fifo_push_rfbuf(rfp, (uint8_t)NRF_RADIO->TXADDRESS, 0)) {
+        if (rfp->config.protocol != NRF52_PROTOCOL_ESB && p_ack_buffer[0] > 0) {
+            if (rx_fifo_push_rfbuf(rfp, p_ack_buffer, (uint8_t)NRF_RADIO->TXADDRESS, 0)) {
                 rfp->flags |= NRF52_INT_RX_DR_MSK;
             }
         }
 
-    	chBSemSignal(&events_sem);
+    	notify_events(rfp);
 
         if ((tx_fifo.count == 0) || (rfp->config.tx_mode == NRF52_TXMODE_MANUAL)) {
             rfp->state = NRF52_STATE_IDLE;
@@ -624,14 +808,24 @@ static void on_radio_disabled_tx_wait_for_ack(RFDriver *rfp) {
             // All retransmits are expended, and the TX operation is suspended
             rfp->tx_attempt = rfp->config.retransmit.count + 1;
             rfp->flags |= NRF52_INT_TX_FAILED_MSK;
+            rfp->stats.tx_failed++;
 
-            chBSemSignal(&events_sem);
+            notify_events(rfp);
 
             rfp->state = NRF52_STATE_IDLE;
         }
         else {
             // There are still have more retransmits left, TX mode should be
             // entered again as soon as the system timer reaches CC[1].
+            // Retransmits always use the CPU driven turnaround, the RX timeout
+            // channel cannot be armed while the timer runs to CC[1].
+            rfp->stats.tx_retransmits++;
+            if (rfp->hw_turnaround) {
+                NRF_PPI->CHENCLR = (1 << NRF52_RADIO_PPI_TURNAROUND);
+                rfp->hw_turnaround = false;
+                // The ACK window wrote in the TX buffer
+                load_tx_buffer(rfp, true);
+            }
             NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_DISABLED_RXEN_Msk;
             set_rf_payload_format(rfp, p_current_payload->length);
             NRF_RADIO->PACKETPTR = (uint32_t)tx_payload_buffer;
@@ -671,11 +865,14 @@ static void on_radio_disabled_rx(RFDriver *rfp) {
     pipe_info_t *   p_pipe_info;
 
     if (NRF_RADIO->CRCSTATUS == 0) {
+        rfp->stats.rx_crc_errors++;
         clear_events_restart_rx(rfp);
         return;
     }
 
-    if(rx_fifo.count >= NRF52_RX_FIFO_SIZE) {
+    // Not acknowledged, the sender retransmits once the pipe is read
+    if(rx_fifo_full((uint8_t)NRF_RADIO->RXMATCH)) {
+        rfp->stats.rx_overflows++;
         clear_events_restart_rx(rfp);
         return;
     }
@@ -685,6 +882,7 @@ static void on_radio_disabled_rx(RFDriver *rfp) {
        (rx_payload_buffer[1] >> 1) == p_pipe_info->m_pid  ) {
         retransmit_payload = true;
         send_rx_event = false;
+        rfp->stats.rx_duplicates++;
     }
 
     p_pipe_info->m_pid = rx_payload_buffer[1] >> 1;
@@ -756,9 +954,9 @@ static void on_radio_disabled_rx(RFDriver *rfp) {
     if (send_rx_event) {
         // Push the new packet to the RX buffer and trigger a received event if the operation was
         // successful.
-        if (rx_fifo_push_rfbuf(rfp, NRF_RADIO->RXMATCH, p_pipe_info->m_pid)) {
+        if (rx_fifo_push_rfbuf(rfp, rx_payload_buffer, NRF_RADIO->RXMATCH, p_pipe_info->m_pid)) {
             rfp->flags |= NRF52_INT_RX_DR_MSK;
-            chBSemSignal(&events_sem);
+            notify_events(rfp);
         }
     }
 }
@@ -791,12 +989,16 @@ nrf52_error_t radio_disable(void) {
                        (1 << NRF52_RADIO_PPI_TIMER_STOP)  |
                        (1 << NRF52_RADIO_PPI_RX_TIMEOUT)  |
 					   (1 << NRF52_RADIO_PPI_TX_START);
+#if RADIO_USE_HW_TURNAROUND
+    NRF_PPI->CHENCLR = (1 << NRF52_RADIO_PPI_TURNAROUND);
+#endif
 
     reset_fifo();
 
     memset(rx_pipe_info, 0, sizeof(rx_pipe_info));
     memset(pids, 0, sizeof(pids));
 
+#if NRF52_RADIO_USE_ISR_DIRECT == FALSE
     // Terminate interrupts handle thread
     chThdTerminate(rfIntThread_p);
     chBSemSignal(&disable_sem);
@@ -807,6 +1009,9 @@ nrf52_error_t radio_disable(void) {
     RFD1.flags = 0;
     chBSemSignal(&events_sem);
     chThdWait(rfEvtThread_p);
+#else
+    RFD1.flags = 0;
+#endif
 
     RFD1.state = NRF52_STATE_UNINIT;
 
@@ -831,6 +1036,8 @@ nrf52_error_t radio_init(nrf52_config_t const *config) {
     RFD1.radio = NRF_RADIO;
 	RFD1.config = *config;
     RFD1.flags    = 0;
+    RFD1.hw_turnaround = false;
+    memset(&RFD1.stats, 0, sizeof(RFD1.stats));
 
     init_fifo();
 
@@ -859,11 +1066,12 @@ nrf52_error_t radio_init(nrf52_config_t const *config) {
     ppi_init(&RFD1);
     timer_init(&RFD1);
 
+    chEvtObjectInit(&RFD1.eventsrc);
+
+#if NRF52_RADIO_USE_ISR_DIRECT == FALSE
     chBSemObjectInit(&disable_sem, TRUE);
     chBSemObjectInit(&events_sem, TRUE);
 
-    chEvtObjectInit(&RFD1.eventsrc);
-
     // interrupt handle thread
     rfIntThread_p = chThdCreateStatic(waRFIntThread, sizeof(waRFIntThread),
     		NRF52_RADIO_INTTHD_PRIORITY, rfIntThread, NULL);
@@ -871,6 +1079,7 @@ nrf52_error_t radio_init(nrf52_config_t const *config) {
     // events handle thread
     rfEvtThread_p = chThdCreateStatic(waRFEvtThread, sizeof(waRFEvtThread),
     		NRF52_RADIO_EVTTHD_PRIORITY, rfEvtThread, NULL);
+#endif
 
     nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
 
@@ -897,6 +1106,7 @@ nrf52_error_t radio_write_payload(nrf52_payload_t const * p_payload) {
     nvicDisableVector(RADIO_IRQn);
 
     memcpy(tx_fifo.p_payload[tx_fifo.entry_point], p_payload, sizeof(nrf52_payload_t));
+    tx_fifo.p_payload[tx_fifo.entry_point]->timestamp = chVTGetSystemTimeX();
 
     pids[p_payload->pipe] = (pids[p_payload->pipe] + 1) % (NRF52_PID_MAX + 1);
     tx_fifo.p_payload[tx_fifo.entry_point]->pid = pids[p_payload->pipe];
@@ -919,29 +1129,74 @@ nrf52_error_t radio_write_payload(nrf52_payload_t const * p_payload) {
     return NRF52_SUCCESS;
 }
 
+// Pops the oldest payload of a pipe, called with the RADIO vector disabled.
+static void rx_fifo_pop(uint8_t pipe, nrf52_payload_t * p_payload) {
+    nrf52_payload_rx_fifo_t *p_fifo = &rx_fifo[pipe];
+    uint8_t slot = p_fifo->slot[p_fifo->exit_point];
+    nrf52_payload_t *p_entry = &rx_fifo_payload[slot];
+
+    p_payload->length    = p_entry->length;
+    p_payload->pipe      = p_entry->pipe;
+    p_payload->rssi      = p_entry->rssi;
+    p_payload->pid       = p_entry->pid;
+    p_payload->timestamp = p_entry->timestamp;
+    memcpy(p_payload->data, p_entry->data, p_payload->length);
+    rx_fifo_free |= 1U << slot;
+
+    if (++p_fifo->exit_point >= NRF52_RX_PIPE_FIFO_SIZE) {
+        p_fifo->exit_point = 0;
+    }
+
+    p_fifo->count--;
+}
+
+// Reads the oldest received payload among all the pipes.
 nrf52_error_t radio_read_rx_payload(nrf52_payload_t * p_payload) {
+    int pipe = -1;
+    uint32_t age, oldest = 0;
+
     if (RFD1.state == NRF52_STATE_UNINIT)
     	return NRF52_INVALID_STATE;
     if (p_payload == NULL)
     	return NRF52_ERROR_NULL;
 
-    if (rx_fifo.count == 0) {
-        return NRF52_ERROR_INVALID_LENGTH;
+    nvicDisableVector(RADIO_IRQn);
+
+    for (int i = 0; i < NRF52_RX_PIPES; i++) {
+        if (rx_fifo[i].count > 0) {
+            age = rx_seq - rx_fifo_seq[rx_fifo[i].slot[rx_fifo[i].exit_point]];
+            if (pipe < 0 || age > oldest) {
+                oldest = age;
+                pipe = i;
+            }
+        }
     }
 
-    nvicDisableVector(RADIO_IRQn);
+    if (pipe >= 0) {
+        rx_fifo_pop((uint8_t)pipe, p_payload);
+    }
 
-    p_payload->length = rx_fifo.p_payload[rx_fifo.exit_point]->length;
-    p_payload->pipe   = rx_fifo.p_payload[rx_fifo.exit_point]->pipe;
-    p_payload->rssi   = rx_fifo.p_payload[rx_fifo.exit_point]->rssi;
-    p_payload->pid    = rx_fifo.p_payload[rx_fifo.exit_point]->pid;
-    memcpy(p_payload->data, rx_fifo.p_payload[rx_fifo.exit_point]->data, p_payload->length);
+    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
 
-    if (++rx_fifo.exit_point >= NRF52_RX_FIFO_SIZE) {
-        rx_fifo.exit_point = 0;
+    return pipe >= 0 ? NRF52_SUCCESS : NRF52_ERROR_INVALID_LENGTH;
+}
+
+// Reads the oldest received payload of a pipe.
+nrf52_error_t radio_read_rx_pipe_payload(uint8_t pipe, nrf52_payload_t * p_payload) {
+    if (RFD1.state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+    if (p_payload == NULL)
+    	return NRF52_ERROR_NULL;
+    if (pipe >= NRF52_RX_PIPES)
+    	return NRF52_ERROR_INVALID_PARAM;
+
+    if (rx_fifo[pipe].count == 0) {
+        return NRF52_ERROR_INVALID_LENGTH;
     }
 
-    rx_fifo.count--;
+    nvicDisableVector(RADIO_IRQn);
+
+    rx_fifo_pop(pipe, p_payload);
 
     nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
 
@@ -1047,9 +1302,7 @@ nrf52_error_t radio_flush_rx(void) {
 
     nvicDisableVector(RADIO_IRQn);
 
-    rx_fifo.count = 0;
-    rx_fifo.entry_point = 0;
-    rx_fifo.exit_point = 0;
+    reset_rx_fifo();
 
     memset(rx_pipe_info, 0, sizeof(rx_pipe_info));
 
@@ -1112,3 +1365,27 @@ nrf52_error_t radio_set_prefix(uint8_t pipe, uint8_t prefix) {
 
     return NRF52_SUCCESS;
 }
+
+nrf52_error_t radio_get_stats(nrf52_stats_t * p_stats) {
+    if (RFD1.state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+    if (p_stats == NULL)
+        return NRF52_ERROR_NULL;
+
+    nvicDisableVector(RADIO_IRQn);
+    *p_stats = RFD1.stats;
+    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+
+    return NRF52_SUCCESS;
+}
+
+nrf52_error_t radio_reset_stats(void) {
+    if (RFD1.state == NRF52_STATE_UNINIT)
+    	return NRF52_INVALID_STATE;
+
+    nvicDisableVector(RADIO_IRQn);
+    memset(&RFD1.stats, 0, sizeof(RFD1.stats));
+    nvicEnableVector(RADIO_IRQn, NRF52_RADIO_IRQ_PRIORITY);
+
+    return NRF52_SUCCESS;
+}
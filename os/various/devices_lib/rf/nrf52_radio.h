@@ -27,7 +27,13 @@
 #define NRF52_CRC_RESET_VALUE             	0xFFFF              /**< CRC reset value*/
 
 #define NRF52_TX_FIFO_SIZE                  8                   /**< The size of the transmission first in first out buffer. */
-#define NRF52_RX_FIFO_SIZE                  8                   /**< The size of the reception first in first out buffer. */
+#ifndef NRF52_RX_FIFO_SIZE
+#define NRF52_RX_FIFO_SIZE                  8                   /**< Received payloads buffered, shared by all the pipes, sizeof(nrf52_payload_t) + 4 bytes of RAM each. At most 32. */
+#endif
+#ifndef NRF52_RX_PIPE_FIFO_SIZE
+#define NRF52_RX_PIPE_FIFO_SIZE             4                   /**< Payloads a single pipe can hold, 1 byte of RAM per pipe and entry. */
+#endif
+#define NRF52_RX_PIPES                      8                   /**< Number of pipes with a reception queue. */
 
 #define NRF52_RADIO_USE_TIMER0            	FALSE               /**< TIMER0 will be used by the module. */
 #define NRF52_RADIO_USE_TIMER1            	TRUE                /**< TIMER1 will be used by the module. */
@@ -43,6 +49,23 @@
 #define NRF52_RADIO_PPI_TIMER_STOP          11                  /**< The PPI channel used for timer stop. */
 #define NRF52_RADIO_PPI_RX_TIMEOUT          12                  /**< The PPI channel used for RX timeout. */
 #define NRF52_RADIO_PPI_TX_START            13                  /**< The PPI channel used for starting TX. */
+#define NRF52_RADIO_PPI_TURNAROUND          14                  /**< The PPI channel used for the TX->RX ACK turnaround. */
+
+/* Radio events are handled in the RADIO interrupt instead of the "rfint" and
+   "rfevent" threads, event flags are broadcast from the interrupt. */
+#ifndef NRF52_RADIO_USE_ISR_DIRECT
+#define NRF52_RADIO_USE_ISR_DIRECT          FALSE
+#endif
+
+/* In ISR direct mode the PTX TX->RX ACK turnaround of dynamic payload packets
+   runs on shortcuts and PPI only, the ACK timeout timer is armed before TX. */
+#ifndef NRF52_RADIO_HW_TURNAROUND
+#define NRF52_RADIO_HW_TURNAROUND           TRUE
+#endif
+
+#ifndef NRF52_RADIO_PPI_GROUP
+#define NRF52_RADIO_PPI_GROUP               0                   /**< The PPI group used for the one-shot timer start. */
+#endif
 
 
 typedef enum {
@@ -170,9 +193,29 @@ typedef struct
     int8_t  rssi;                                /**< RSSI for received packet. */
     uint8_t noack;                               /**< Flag indicating that this packet will not be acknowledged. */
     uint8_t pid;                                 /**< PID assigned during communication. */
+    systime_t timestamp;                         /**< Reception time, or queuing time for TX packets. */
     uint8_t data[NRF52_MAX_PAYLOAD_LENGTH];      /**< The payload data. */
 } nrf52_payload_t;
 
+/**@brief Radio statistics, latencies are in system ticks.
+ *
+ * @details The TX latency is measured from radio_write_payload() to the
+ *          successful end of the transaction, including queuing and
+ *          retransmissions.
+ */
+typedef struct {
+    uint32_t              tx_packets;             /**< Packets sent successfully. */
+    uint32_t              tx_failed;              /**< Packets dropped after all retransmits. */
+    uint32_t              tx_retransmits;         /**< Retransmissions of unacked packets. */
+    uint32_t              rx_packets;             /**< Packets pushed to the pipe queues. */
+    uint32_t              rx_duplicates;          /**< Retransmitted packets discarded. */
+    uint32_t              rx_crc_errors;          /**< Packets received with a bad CRC. */
+    uint32_t              rx_overflows;           /**< Packets refused because the pipe queue was full. */
+    uint32_t              latency_last;           /**< Latency of the last packet sent. */
+    uint32_t              latency_max;            /**< Highest latency. */
+    uint32_t              latency_total;          /**< Sum of the latencies, divide by tx_packets for the average. */
+} nrf52_stats_t;
+
 /**@brief Retransmit attempts delay and counter. */
 typedef struct {
     uint16_t              delay;                  /**< The delay between each retransmission of unacked packets. */
@@ -230,6 +273,14 @@ typedef struct {
    * @brief TX retransmits remaining.
    */
   uint16_t                tx_remaining;
+  /**
+   * @brief Current TX attempt turns around to RX without the CPU.
+   */
+  bool                    hw_turnaround;
+  /**
+   * @brief Radio statistics.
+   */
+  nrf52_stats_t           stats;
   /**
    * @brief Radio events source.
    */
@@ -242,6 +293,7 @@ nrf52_error_t radio_init(nrf52_config_t const *config);
 nrf52_error_t radio_disable(void);
 nrf52_error_t radio_write_payload(nrf52_payload_t const * p_payload);
 nrf52_error_t radio_read_rx_payload(nrf52_payload_t * p_payload);
+nrf52_error_t radio_read_rx_pipe_payload(uint8_t pipe, nrf52_payload_t * p_payload);
 nrf52_error_t radio_start_tx(void);
 nrf52_error_t radio_start_rx(void);
 nrf52_error_t radio_stop_rx(void);
@@ -252,5 +304,7 @@ nrf52_error_t radio_set_base_address_0(uint8_t const * p_addr);
 nrf52_error_t radio_set_base_address_1(uint8_t const * p_addr);
 nrf52_error_t radio_set_prefixes(uint8_t const * p_prefixes, uint8_t num_pipes);
 nrf52_error_t radio_set_prefix(uint8_t pipe, uint8_t prefix);
+nrf52_error_t radio_get_stats(nrf52_stats_t * p_stats);
+nrf52_error_t radio_reset_stats(void);
 
 #endif /* NRF52_RADIO_H_ */
@@ -262,4 +262,32 @@ HDC1000_readTemperatureHumidity(HDC1000_drv *drv,
 }
 
 
+/*===========================================================================*/
+/* Scheduler bindings.                                                       */
+/*===========================================================================*/
+
+static msg_t
+_sched_start(void *drv) {
+    return HDC1000_startMeasure((HDC1000_drv *)drv);
+}
+
+static unsigned int
+_sched_acquisition_time(void *drv) {
+    return HDC1000_getAcquisitionTime((HDC1000_drv *)drv);
+}
+
+static msg_t
+_sched_read(void *drv, void *value) {
+    HDC1000_measure *m = value;
+    return HDC1000_readMeasure((HDC1000_drv *)drv,
+			       &m->temperature, &m->humidity);
+}
+
+const SENSOR_sched_ops HDC1000_sched_ops = {
+    _sched_start,
+    _sched_acquisition_time,
+    _sched_read,
+};
+
+
 /** @} */
@@ -34,6 +34,7 @@
 #include <stdbool.h>
 #include "i2c_helpers.h"
 #include "sensor.h"
+#include "sensor_sched.h"
 
 
 /*===========================================================================*/
@@ -93,6 +94,14 @@ typedef struct {
     uint16_t         cfg;
 } HDC1000_drv;
 
+/**
+ * @brief   HDC1000 measure reading
+ */
+typedef struct {
+    float temperature;
+    float humidity;
+} HDC1000_measure;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -102,6 +111,11 @@ typedef struct {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+/**
+ * @brief   Operations for SENSOR_schedAcquire()
+ */
+extern const SENSOR_sched_ops HDC1000_sched_ops;
+
 /**
  * @brief Initialize the sensor driver
  */
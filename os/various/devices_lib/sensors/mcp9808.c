@@ -205,3 +205,25 @@ MCP9808_readTemperature(MCP9808_drv *drv,
 
     return _decode_measure(drv, val, temperature);    
 }
+
+
+/*===========================================================================*/
+/* Scheduler bindings.                                                       */
+/*===========================================================================*/
+
+static unsigned int
+_sched_acquisition_time(void *drv) {
+    return MCP9808_getAcquisitionTime((MCP9808_drv *)drv);
+}
+
+static msg_t
+_sched_read(void *drv, void *value) {
+    MCP9808_measure *m = value;
+    return MCP9808_readMeasure((MCP9808_drv *)drv, &m->temperature);
+}
+
+const SENSOR_sched_ops MCP9808_sched_ops = {
+    NULL,
+    _sched_acquisition_time,
+    _sched_read,
+};
@@ -20,6 +20,7 @@
 #include <math.h>
 #include "i2c_helpers.h"
 #include "sensor.h"
+#include "sensor_sched.h"
 
 /*===========================================================================*/
 /* Driver constants.                                                         */
@@ -97,6 +98,11 @@ typedef struct {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+/**
+ * @brief   Operations for SENSOR_schedAcquire()
+ */
+extern const SENSOR_sched_ops MCP9808_sched_ops;
+
 /**
  * @brief   Initialize the sensor driver
  */
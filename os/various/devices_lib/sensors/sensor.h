@@ -52,7 +52,10 @@
  * while(true) {
  *   SENSOR_readValue(&sensor_drv, ...);
  * }
- * @encode
+ * @endcode
+ *
+ * When acquiring from several sensors, use SENSOR_schedAcquire()
+ * (see sensor_sched.h) to overlap their acquisition times.
  */
 #ifndef _SENSOR_H_
 #define _SENSOR_H_
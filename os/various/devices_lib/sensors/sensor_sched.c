@@ -0,0 +1,147 @@
+/*
+    Sensor scheduler for ChibiOS/RT
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensor_sched.c
+ * @brief   Interleaved acquisition of several sensors.
+ *
+ * @addtogroup sensor_sched
+ * @{
+ */
+
+#include "hal.h"
+#include "sensor_sched.h"
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+typedef enum {
+    SCHED_START,
+    SCHED_READ,
+} sched_op_t;
+
+static bool
+_is_due(SENSOR_sched_entry *e, sched_op_t op, sysinterval_t elapsed) {
+    if (!e->pending)
+	return false;
+    if (op == SCHED_START)
+	return e->ops->start_measure != NULL;
+    return e->due <= elapsed;
+}
+
+static void
+_run(SENSOR_sched_entry *e, sched_op_t op) {
+    if (op == SCHED_START) {
+	if ((e->status = e->ops->start_measure(e->drv)) < MSG_OK)
+	    e->pending = false;
+    } else {
+	e->status  = e->ops->read_measure(e->drv, e->value);
+	e->pending = false;
+    }
+}
+
+/**
+ * @brief   Process the due entries, one bus acquisition per bus.
+ */
+static void
+_batch(SENSOR_sched_entry *entries, size_t n,
+       sched_op_t op, sysinterval_t elapsed) {
+    for (size_t i = 0 ; i < n ; i++) {
+	I2CDriver *bus = entries[i].bus;
+
+	/* Bus already handled with a previous entry */
+	size_t k;
+	for (k = 0 ; (k < i) && (entries[k].bus != bus) ; k++)
+	    ;
+	if ((k < i) && (bus != NULL))
+	    continue;
+
+	bool locked = false;
+	for (size_t j = i ; j < n ; j++) {
+	    SENSOR_sched_entry *e = &entries[j];
+	    if ((e->bus != bus) || ((bus == NULL) && (j != i)))
+		continue;
+	    if (!_is_due(e, op, elapsed))
+		continue;
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+	    if (!locked && (bus != NULL))
+		i2cAcquireBus(bus);
+#endif
+	    locked = true;
+	    _run(e, op);
+	}
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+	if (locked && (bus != NULL))
+	    i2cReleaseBus(bus);
+#else
+	(void)locked;
+#endif
+    }
+}
+
+/*===========================================================================*/
+/* Interface implementation.                                                 */
+/*===========================================================================*/
+
+msg_t
+SENSOR_schedAcquire(SENSOR_sched_entry *entries, size_t n) {
+    osalDbgCheck((entries != NULL) || (n == 0));
+
+    /* Start all the measures */
+    for (size_t i = 0 ; i < n ; i++) {
+	SENSOR_sched_entry *e = &entries[i];
+	osalDbgCheck((e->ops != NULL) && (e->drv != NULL));
+	e->due     = OSAL_MS2I(e->ops->acquisition_time(e->drv));
+	e->status  = SENSOR_OK;
+	e->pending = true;
+    }
+    _batch(entries, n, SCHED_START, 0);
+
+    /* Read them as they become ready */
+    systime_t start = osalOsGetSystemTimeX();
+    while (true) {
+	sysinterval_t elapsed = osalTimeDiffX(start, osalOsGetSystemTimeX());
+	_batch(entries, n, SCHED_READ, elapsed);
+
+	/* Earliest pending deadline */
+	bool          pending = false;
+	sysinterval_t next    = 0;
+	for (size_t i = 0 ; i < n ; i++) {
+	    if (entries[i].pending && (!pending || (entries[i].due < next))) {
+		next    = entries[i].due;
+		pending = true;
+	    }
+	}
+	if (!pending)
+	    break;
+
+	elapsed = osalTimeDiffX(start, osalOsGetSystemTimeX());
+	if (next > elapsed)
+	    osalThreadSleep(next - elapsed);
+    }
+
+    /* First error */
+    for (size_t i = 0 ; i < n ; i++) {
+	if (entries[i].status < MSG_OK)
+	    return entries[i].status;
+    }
+    return SENSOR_OK;
+}
+
+/**
+ * @}
+ */
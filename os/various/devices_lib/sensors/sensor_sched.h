@@ -0,0 +1,129 @@
+/*
+    Sensor scheduler for ChibiOS/RT
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensor_sched.h
+ * @brief   Interleaved acquisition of several sensors.
+ *
+ * Instead of serialising SENSOR_startMeasure(), sleep and
+ * SENSOR_readMeasure() for each sensor, all the measures are
+ * started together, the calling thread sleeps until the earliest
+ * acquisition deadline, reads the sensors that are ready and goes
+ * back to sleep until the next deadline. The acquisition period
+ * is then close to the longest acquisition time instead of the
+ * sum of all of them.
+ *
+ * Bus transactions falling at the same time are batched: the
+ * I2C bus is acquired once for all the sensors sharing it.
+ *
+ * @code
+ * static HDC1000_measure th;
+ * static MCP9808_measure t;
+ * static unsigned int    lux;
+ *
+ * static SENSOR_sched_entry entries[] = {
+ *   SENSOR_SCHED_ENTRY(HDC1000_sched_ops, &hdc1000, &I2CD1, &th ),
+ *   SENSOR_SCHED_ENTRY(MCP9808_sched_ops, &mcp9808, &I2CD1, &t  ),
+ *   SENSOR_SCHED_ENTRY(TSL2591_sched_ops, &tsl2591, &I2CD1, &lux),
+ * };
+ *
+ * while(true) {
+ *   SENSOR_schedAcquire(entries, sizeof(entries) / sizeof(entries[0]));
+ *   ...
+ * }
+ * @endcode
+ *
+ * @{
+ */
+
+#ifndef _SENSOR_SCHED_H_
+#define _SENSOR_SCHED_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal.h"
+#include "sensor.h"
+
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Sensor operations used by the scheduler.
+ */
+typedef struct {
+    /**
+     * @brief Trigger a measure, NULL if acquisition is continuous.
+     */
+    msg_t        (*start_measure)(void *drv);
+    /**
+     * @brief Acquisition time in milli-seconds.
+     */
+    unsigned int (*acquisition_time)(void *drv);
+    /**
+     * @brief Read the measure into the sensor specific value.
+     */
+    msg_t        (*read_measure)(void *drv, void *value);
+} SENSOR_sched_ops;
+
+/**
+ * @brief   Sensor scheduled by SENSOR_schedAcquire().
+ */
+typedef struct {
+    const SENSOR_sched_ops *ops;
+    void                   *drv;     /**< @brief Sensor driver.           */
+    I2CDriver              *bus;     /**< @brief Bus, NULL if not shared. */
+    void                   *value;   /**< @brief Measure destination.     */
+    sysinterval_t           due;     /**< @brief Read time from start.    */
+    msg_t                   status;  /**< @brief Last acquisition status. */
+    bool                    pending;
+} SENSOR_sched_entry;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Static initializer of a scheduler entry.
+ */
+#define SENSOR_SCHED_ENTRY(ops, drv, bus, value)			\
+    { &(ops), (drv), (bus), (value), 0, SENSOR_OK, false }
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+/**
+ * @brief   Acquire a measure from each sensor.
+ *
+ * @details All the measures are started, then each sensor is read
+ *          as soon as its acquisition time has elapsed. The status of
+ *          each sensor is available in its entry.
+ *
+ * @note    The sensors must have been started.
+ *
+ * @return  SENSOR_OK if all the measures have been read, otherwise
+ *          the first error encountered.
+ */
+msg_t
+SENSOR_schedAcquire(SENSOR_sched_entry *entries, size_t n);
+
+#endif
+
+/**
+ * @}
+ */
@@ -384,3 +384,30 @@ TSL2561_readIlluminance(TSL2561_drv *drv,
     return SENSOR_OK;
 }
 
+msg_t
+TSL2561_readMeasure(TSL2561_drv *drv,
+	unsigned int *illuminance) {
+    return TSL2561_readIlluminance(drv, illuminance);
+}
+
+
+/*===========================================================================*/
+/* Scheduler bindings.                                                       */
+/*===========================================================================*/
+
+static unsigned int
+_sched_acquisition_time(void *drv) {
+    return TSL2561_getAcquisitionTime((TSL2561_drv *)drv);
+}
+
+static msg_t
+_sched_read(void *drv, void *value) {
+    unsigned int *m = value;
+    return TSL2561_readMeasure((TSL2561_drv *)drv, m);
+}
+
+const SENSOR_sched_ops TSL2561_sched_ops = {
+    NULL,
+    _sched_acquisition_time,
+    _sched_read,
+};
@@ -27,6 +27,7 @@
 #include <math.h>
 #include "i2c_helpers.h"
 #include "sensor.h"
+#include "sensor_sched.h"
 
 
 /*===========================================================================*/
@@ -131,6 +132,11 @@ typedef struct {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+/**
+ * @brief   Operations for SENSOR_schedAcquire()
+ */
+extern const SENSOR_sched_ops TSL2561_sched_ops;
+
 /**
  * @brief Initialize the sensor driver
  */
@@ -185,7 +191,7 @@ TSL2561_startMeasure(TSL2561_drv *drv) {
  */
 msg_t
 TSL2561_readMeasure(TSL2561_drv *drv,
-	unsigned int illuminance);
+	unsigned int *illuminance);
 
 msg_t
 TSL2561_setGain(TSL2561_drv *drv,
@@ -270,3 +270,30 @@ TSL2591_readIlluminance(TSL2591_drv *drv,
     return SENSOR_OK;
 }
 
+msg_t
+TSL2591_readMeasure(TSL2591_drv *drv,
+	unsigned int *illuminance) {
+    return TSL2591_readIlluminance(drv, illuminance);
+}
+
+
+/*===========================================================================*/
+/* Scheduler bindings.                                                       */
+/*===========================================================================*/
+
+static unsigned int
+_sched_acquisition_time(void *drv) {
+    return TSL2591_getAcquisitionTime((TSL2591_drv *)drv);
+}
+
+static msg_t
+_sched_read(void *drv, void *value) {
+    unsigned int *m = value;
+    return TSL2591_readMeasure((TSL2591_drv *)drv, m);
+}
+
+const SENSOR_sched_ops TSL2591_sched_ops = {
+    NULL,
+    _sched_acquisition_time,
+    _sched_read,
+};
@@ -27,6 +27,7 @@
 #include <math.h>
 #include "i2c_helpers.h"
 #include "sensor.h"
+#include "sensor_sched.h"
 
 
 /*===========================================================================*/
@@ -126,6 +127,11 @@ typedef struct {
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+/**
+ * @brief   Operations for SENSOR_schedAcquire()
+ */
+extern const SENSOR_sched_ops TSL2591_sched_ops;
+
 /**
  * @brief Initialize the sensor driver
  */
@@ -189,7 +195,7 @@ TSL2591_setIntegrationTime(TSL2591_drv *drv,
  */
 msg_t
 TSL2591_readMeasure(TSL2591_drv *drv,
-	unsigned int illuminance);
+	unsigned int *illuminance);
 
 
 /**
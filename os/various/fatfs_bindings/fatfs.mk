@@ -6,6 +6,16 @@ FATFSSRC = ${CHIBIOS_CONTRIB}/os/various/fatfs_bindings/fatfs_diskio.c \
 
 FATFSINC = ${CHIBIOS}/ext/fatfs/source ${CHIBIOS_CONTRIB}/os/various/fatfs_bindings
 
+# Sector cache, FATFS_USE_BLKCACHE is looked up in ffconf.h and halconf.h.
+ifeq ($(CONFDIR),)
+  CONFDIR = .
+endif
+FATFSCONF := $(strip $(shell cat /dev/null $(wildcard $(CONFDIR)/ffconf.h $(CONFDIR)/halconf.h) | egrep -e "\#define"))
+ifneq ($(findstring FATFS_USE_BLKCACHE TRUE,$(FATFSCONF)),)
+FATFSSRC += ${CHIBIOS_CONTRIB}/os/various/blkcache.c
+FATFSINC += ${CHIBIOS_CONTRIB}/os/various
+endif
+
 # Shared variables
 ALLCSRC += $(FATFSSRC)
 ALLINC  += $(FATFSINC)
@@ -38,4 +38,43 @@
 #endif
 #endif
 
+/*-----------------------------------------------------------------------*/
+/* Sector cache between FatFS and the block devices.                     */
+
+/**
+ * @brief   Enables the sector cache.
+ * @note    Define it in ffconf.h or halconf.h, fatfs.mk adds blkcache.c
+ *          to the build only when it finds it there.
+ */
+#if !defined(FATFS_USE_BLKCACHE) || defined(__DOXYGEN__)
+#define FATFS_USE_BLKCACHE   FALSE
+#endif
+
+/**
+ * @brief   Number of cached sectors per drive.
+ */
+#if !defined(FATFS_BLKCACHE_LINES) || defined(__DOXYGEN__)
+#define FATFS_BLKCACHE_LINES 8
+#endif
+
+/**
+ * @brief   Number of sectors read ahead on sequential reads, zero
+ *          disables the read-ahead.
+ */
+#if !defined(FATFS_BLKCACHE_AHEAD) || defined(__DOXYGEN__)
+#define FATFS_BLKCACHE_AHEAD 4
+#endif
+
+#if FATFS_USE_BLKCACHE
+#include "blkcache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  BlockCache *fatfsGetBlockCache(uint8_t pdrv);
+#ifdef __cplusplus
+}
+#endif
+#endif
+
 #endif /* FATFS_DEVICES_H_ */
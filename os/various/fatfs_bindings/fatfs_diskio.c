@@ -43,6 +43,79 @@ extern SDCDriver FATFS_HAL_DEVICE;
 extern RTCDriver RTCD1;
 #endif
 
+#if FATFS_USE_BLKCACHE
+#define FATFS_BLKCACHE_DRIVES 2
+
+static BlockCache cache[FATFS_BLKCACHE_DRIVES];
+static BlockCacheConfig cache_cfg[FATFS_BLKCACHE_DRIVES];
+static blkcacheline_t cache_lines[FATFS_BLKCACHE_DRIVES][FATFS_BLKCACHE_LINES];
+static uint8_t cache_buffer[FATFS_BLKCACHE_DRIVES]
+                          [FATFS_BLKCACHE_LINES * BLKCACHE_BLOCK_SIZE];
+#if FATFS_BLKCACHE_AHEAD > 0
+static uint8_t cache_ahead[FATFS_BLKCACHE_DRIVES]
+                         [FATFS_BLKCACHE_AHEAD * BLKCACHE_BLOCK_SIZE];
+#endif
+
+static BaseBlockDevice *cache_device(BYTE pdrv) {
+  switch (pdrv) {
+#if HAL_USE_MMC_SPI || HAL_USE_SDC
+  case FATFSDEV_MMC:
+    return (BaseBlockDevice *)&FATFS_HAL_DEVICE;
+#endif
+#if HAL_USBH_USE_MSD
+  case FATFSDEV_MSD:
+    return (BaseBlockDevice *)&MSBLKD[0];
+#endif
+  }
+  return NULL;
+}
+
+/*
+ * (Re)starts the cache of a drive. A running cache writes its dirty
+ * sectors back first, FatFS initializes the drive again on every mount.
+ * After a media change the application drops the cached sectors with
+ * blkcacheInvalidate() before mounting.
+ */
+static bool cache_start(BYTE pdrv) {
+  BlockCache *bcp = &cache[pdrv];
+  BlockCacheConfig *cfgp = &cache_cfg[pdrv];
+  bool result = HAL_SUCCESS;
+
+  if (blkGetDriverState(bcp) == BLK_READY)
+    result = blkcacheStop(bcp);
+  else
+    blkcacheObjectInit(bcp);
+
+  cfgp->blkdev = cache_device(pdrv);
+  cfgp->lines  = cache_lines[pdrv];
+  cfgp->buffer = cache_buffer[pdrv];
+  cfgp->nlines = FATFS_BLKCACHE_LINES;
+#if FATFS_BLKCACHE_AHEAD > 0
+  cfgp->ahead  = cache_ahead[pdrv];
+  cfgp->nahead = FATFS_BLKCACHE_AHEAD;
+#else
+  cfgp->ahead  = NULL;
+  cfgp->nahead = 0;
+#endif
+  if ((cfgp->blkdev != NULL) && blkcacheStart(bcp, cfgp))
+    result = HAL_FAILED;
+  return result;
+}
+
+/**
+ * @brief   Returns the sector cache of a drive.
+ *
+ * @param[in] pdrv      physical drive number
+ * @return              The started cache, @p NULL if none.
+ */
+BlockCache *fatfsGetBlockCache(uint8_t pdrv) {
+  if ((pdrv >= FATFS_BLKCACHE_DRIVES) ||
+      (blkGetDriverState(&cache[pdrv]) != BLK_READY))
+    return NULL;
+  return &cache[pdrv];
+}
+#endif /* FATFS_USE_BLKCACHE */
+
 
 /*-----------------------------------------------------------------------*/
 /* Inidialize a Drive                                                    */
@@ -51,6 +124,15 @@ DSTATUS disk_initialize (
     BYTE pdrv         /* Physical drive number (0..) */
 )
 {
+#if FATFS_USE_BLKCACHE
+  DSTATUS stat = disk_status(pdrv);
+
+  /* A failed write back fails the mount instead of losing the sectors.*/
+  if (!(stat & STA_NOINIT) && (pdrv < FATFS_BLKCACHE_DRIVES) &&
+      cache_start(pdrv))
+    stat |= STA_NOINIT;
+  return stat;
+#else
   DSTATUS stat;
 
   switch (pdrv) {
@@ -83,6 +165,7 @@ DSTATUS disk_initialize (
 #endif
   }
   return STA_NOINIT;
+#endif /* FATFS_USE_BLKCACHE */
 }
 
 
@@ -140,6 +223,16 @@ DRESULT disk_read (
     UINT count        /* Number of sectors to read (1..255) */
 )
 {
+#if FATFS_USE_BLKCACHE
+  BlockCache *bcp = fatfsGetBlockCache(pdrv);
+
+  if (bcp != NULL) {
+    if (blkRead(bcp, sector, buff, count))
+      return RES_ERROR;
+    return RES_OK;
+  }
+#endif
+
   switch (pdrv) {
 #if HAL_USE_MMC_SPI
   case FATFSDEV_MMC:
@@ -190,6 +283,17 @@ DRESULT disk_write (
     UINT count        /* Number of sectors to write (1..255) */
 )
 {
+#if FATFS_USE_BLKCACHE
+  BlockCache *bcp = fatfsGetBlockCache(pdrv);
+
+  if (bcp != NULL) {
+    if (blkIsWriteProtected(bcp))
+      return RES_WRPRT;
+    if (blkWrite(bcp, sector, buff, count))
+      return RES_ERROR;
+    return RES_OK;
+  }
+#endif
 
   switch (pdrv) {
 #if HAL_USE_MMC_SPI
@@ -257,6 +361,19 @@ DRESULT disk_ioctl (
 {
   (void)buff;
 
+#if FATFS_USE_BLKCACHE
+  if (cmd == CTRL_SYNC) {
+    BlockCache *bcp = fatfsGetBlockCache(pdrv);
+
+    /* Dirty sectors are written back, then the device is synchronized.*/
+    if (bcp != NULL) {
+      if (blkSync(bcp))
+        return RES_ERROR;
+      return RES_OK;
+    }
+  }
+#endif
+
   switch (pdrv) {
 #if HAL_USE_MMC_SPI
   case FATFSDEV_MMC:
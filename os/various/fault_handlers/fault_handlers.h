@@ -10,6 +10,17 @@
  * 1) #define FAULT_NO_PRINT to remove chprintf, etc
  * 2) #define FAULT_INFO_HOOK(fault_info) to receive a struct fault_info when
  *    a fault is produced.
+ * 3) #define FAULT_CRASH_RECORD to keep a binary struct fault_crash_record
+ *    (registers, fault status, stack window, threads with their unused
+ *    stack, last trace events) across a reset. It is placed in
+ *    FAULT_CRASH_RECORD_SECTION, by default in the .ram0 section which the
+ *    startup code does not clear. Read it on the next boot with
+ *    faultGetCrashRecord() and decode it on the host with
+ *    tools/fault_decode.py.
+ * 4) #define FAULT_CRASH_RECORD_HOOK(record) to receive the record once it is
+ *    complete, for example to copy it to a reserved flash sector.
+ * 5) #define FAULT_CRASH_RESET to reset the MCU after the fault has been
+ *    recorded when no debugger is attached, instead of halting.
  */
 
 struct fault_info {
@@ -19,4 +30,15 @@ struct fault_info {
 #endif
 };
 
+#if defined(FAULT_CRASH_RECORD)
+#ifdef __cplusplus
+extern "C" {
+#endif
+	bool faultGetCrashRecord(struct fault_crash_record *record);
+	void faultClearCrashRecord(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
+
 #endif /* FAULT_HANDLERS_H_ */
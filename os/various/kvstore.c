@@ -0,0 +1,864 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    kvstore.c
+ * @brief   Flash key-value store code.
+ * @details Flash layout, all fields little endian:
+ *          - sector header: magic, sequence number, erase count (32 bits
+ *            each), CRC16 of the previous fields, 16 bits of padding.
+ *            The sequence number orders the sectors from oldest to newest.
+ *          - records, from the end of the sector header up to the first
+ *            erased byte: magic (8 bits), flags (8 bits), key, value
+ *            length and CRC16 of the header and value (16 bits each),
+ *            then the value padded to @p KVSTORE_PROGRAM_ALIGN.
+ *          .
+ *          A record is programmed with a single @p flashProgram() call and
+ *          is valid only if its CRC matches, an update interrupted by a
+ *          power loss is therefore ignored and the previous value is kept.
+ *          When the head sector is full the next erased sector is opened;
+ *          one sector is always kept erased, when the last one is taken
+ *          the oldest sector is reclaimed: its live records are copied to
+ *          the head and it is erased. @p kvsCompact() does the same ahead
+ *          of time from a low priority thread so that appends do not wait
+ *          for a reclaim.
+ *
+ * @addtogroup KVSTORE
+ * @{
+ */
+
+#include "kvstore.h"
+
+#include <string.h>
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define KVS_SECTOR_MAGIC                0x3153564BU
+#define KVS_RECORD_MAGIC                0x5AU
+
+#define KVS_FLAG_VALUE                  0x01U
+#define KVS_FLAG_DELETED                0x02U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+typedef struct {
+  uint32_t                  magic;
+  uint32_t                  seq;
+  uint32_t                  erases;
+  uint16_t                  crc;
+  uint16_t                  pad;
+} kvs_sector_header_t;
+
+typedef struct {
+  uint8_t                   magic;
+  uint8_t                   flags;
+  uint16_t                  key;
+  uint16_t                  len;
+  uint16_t                  crc;
+} kvs_record_header_t;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static uint16_t kvs_crc16(uint16_t crc, const uint8_t *p, size_t n) {
+
+  while (n-- > 0U) {
+    unsigned i;
+
+    crc ^= (uint16_t)*p++ << 8;
+    for (i = 0U; i < 8U; i++) {
+      crc = (crc & 0x8000U) != 0U ? (uint16_t)((crc << 1) ^ 0x1021U)
+                                  : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static uint16_t kvs_record_crc(const uint8_t *rec, size_t len) {
+
+  /* Header fields before the CRC, then the value.*/
+  return kvs_crc16(kvs_crc16(0xFFFFU, rec, 6U),
+                   rec + KVSTORE_RECORD_HEADER_SIZE, len);
+}
+
+static uint32_t kvs_record_size(size_t len) {
+
+  return KVSTORE_ALIGN(KVSTORE_RECORD_HEADER_SIZE + (uint32_t)len);
+}
+
+static bool kvs_is_erased(const KVStore *kvp, const uint8_t *p, size_t n) {
+
+  while (n-- > 0U) {
+    if (*p++ != kvp->erased) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static kvstore_error_t kvs_read(KVStore *kvp, uint32_t offset,
+                                size_t n, void *p) {
+
+  if (flashRead(kvp->config->flashp, kvp->base + offset,
+                n, (uint8_t *)p) != FLASH_NO_ERROR) {
+    return KVSTORE_ERROR_FLASH;
+  }
+  return KVSTORE_NO_ERROR;
+}
+
+static kvstore_error_t kvs_read_header(KVStore *kvp, uint32_t offset,
+                                       kvs_record_header_t *hp) {
+
+  return kvs_read(kvp, offset, sizeof (kvs_record_header_t), hp);
+}
+
+static flash_sector_t kvs_sector_of(const KVStore *kvp, uint32_t offset) {
+
+  return (flash_sector_t)(offset / kvp->sector_size);
+}
+
+static kvstore_error_t kvs_erase(KVStore *kvp, flash_sector_t s) {
+  BaseFlash *flashp = kvp->config->flashp;
+  flash_error_t err;
+
+  kvp->sectors[s].seq = 0U;
+  err = flashStartEraseSector(flashp, kvp->config->first_sector + s);
+  if (err == FLASH_NO_ERROR) {
+    err = flashWaitErase(flashp);
+  }
+  kvp->sectors[s].erases++;
+  if (err != FLASH_NO_ERROR) {
+    return KVSTORE_ERROR_FLASH;
+  }
+  kvp->free++;
+
+  return KVSTORE_NO_ERROR;
+}
+
+/* Makes the next erased sector after the current head the new head.*/
+static kvstore_error_t kvs_open_next(KVStore *kvp) {
+  flash_sector_t n = kvp->config->sectors;
+  flash_sector_t s = kvp->head;
+  union {
+    kvs_sector_header_t     h;
+    uint8_t                 b[KVSTORE_SECTOR_HEADER_SIZE];
+  } hdr;
+
+  do {
+    s = (s + 1U) % n;
+  } while (kvp->sectors[s].seq != 0U);
+
+  memset(hdr.b, kvp->erased, sizeof hdr.b);
+  hdr.h.magic  = KVS_SECTOR_MAGIC;
+  hdr.h.seq    = kvp->seq + 1U;
+  hdr.h.erases = kvp->sectors[s].erases;
+  hdr.h.crc    = kvs_crc16(0xFFFFU, hdr.b, 12U);
+  hdr.h.pad    = 0U;
+
+  kvp->free--;
+  kvp->seq++;
+  kvp->sectors[s].seq = kvp->seq;
+  kvp->head = s;
+  kvp->wp = kvp->sector_size;
+  if (flashProgram(kvp->config->flashp,
+                   kvp->base + (uint32_t)s * kvp->sector_size,
+                   sizeof hdr.b, hdr.b) != FLASH_NO_ERROR) {
+    /* The sector stays full until it is reclaimed.*/
+    return KVSTORE_ERROR_FLASH;
+  }
+  kvp->wp = KVSTORE_SECTOR_HEADER_SIZE;
+
+  return KVSTORE_NO_ERROR;
+}
+
+/* Oldest sector in use other than the head, or the number of sectors.*/
+static flash_sector_t kvs_oldest(const KVStore *kvp) {
+  flash_sector_t s, oldest = kvp->config->sectors;
+
+  for (s = 0U; s < kvp->config->sectors; s++) {
+    if ((s != kvp->head) && (kvp->sectors[s].seq != 0U) &&
+        ((oldest == kvp->config->sectors) ||
+         (kvp->sectors[s].seq < kvp->sectors[oldest].seq))) {
+      oldest = s;
+    }
+  }
+  return oldest;
+}
+
+/* Programs the record in the buffer at the append position.*/
+static kvstore_error_t kvs_append(KVStore *kvp, uint32_t size,
+                                  uint32_t *offsetp) {
+  uint32_t offset = (uint32_t)kvp->head * kvp->sector_size + kvp->wp;
+
+  kvp->wp += size;
+  if (flashProgram(kvp->config->flashp, kvp->base + offset,
+                   size, kvp->buf.b) != FLASH_NO_ERROR) {
+    return KVSTORE_ERROR_FLASH;
+  }
+  *offsetp = offset;
+
+  return KVSTORE_NO_ERROR;
+}
+
+static kvstore_error_t kvs_reclaim(KVStore *kvp, flash_sector_t victim);
+
+/* Makes room for a record of the specified size in the head sector.*/
+static kvstore_error_t kvs_make_room(KVStore *kvp, uint32_t size,
+                                     bool reclaim) {
+  unsigned i;
+
+  for (i = 0U; i <= 2U * kvp->config->sectors; i++) {
+    kvstore_error_t err;
+
+    if (kvp->wp + size <= kvp->sector_size) {
+      return KVSTORE_NO_ERROR;
+    }
+    if (kvp->free == 0U) {
+      return KVSTORE_NO_SPACE;
+    }
+    err = kvs_open_next(kvp);
+    if ((err == KVSTORE_NO_ERROR) && (kvp->free == 0U) && reclaim) {
+      err = kvs_reclaim(kvp, kvs_oldest(kvp));
+    }
+    if (err != KVSTORE_NO_ERROR) {
+      return err;
+    }
+  }
+  return KVSTORE_NO_SPACE;
+}
+
+/* Copies the live records of a sector to the head, then erases it.*/
+static kvstore_error_t kvs_reclaim(KVStore *kvp, flash_sector_t victim) {
+  uint16_t key;
+
+  for (key = 0U; key < KVSTORE_MAX_KEYS; key++) {
+    uint32_t offset = kvp->index[key];
+    kvs_record_header_t h;
+    kvstore_error_t err;
+    uint32_t size = 0U;
+
+    if ((offset == 0U) || (kvs_sector_of(kvp, offset) != victim)) {
+      continue;
+    }
+
+    err = kvs_read_header(kvp, offset, &h);
+    if (err == KVSTORE_NO_ERROR) {
+      size = kvs_record_size(h.len);
+      err = kvs_make_room(kvp, size, false);
+    }
+    if (err == KVSTORE_NO_ERROR) {
+      err = kvs_read(kvp, offset, size, kvp->buf.b);
+    }
+    if (err == KVSTORE_NO_ERROR) {
+      err = kvs_append(kvp, size, &kvp->index[key]);
+    }
+    if (err != KVSTORE_NO_ERROR) {
+      /* The victim is intact, nothing is lost.*/
+      return err;
+    }
+    kvp->stats.copies++;
+  }
+
+  kvp->stats.reclaims++;
+  return kvs_erase(kvp, victim);
+}
+
+/* Loads the records of a sector into the index, reports interrupted
+   writes.*/
+static kvstore_error_t kvs_scan(KVStore *kvp, flash_sector_t s, bool *tornp) {
+  uint32_t start = (uint32_t)s * kvp->sector_size;
+  uint32_t off = KVSTORE_SECTOR_HEADER_SIZE;
+
+  while (off + KVSTORE_RECORD_HEADER_SIZE <= kvp->sector_size) {
+    kvs_record_header_t h;
+    kvstore_error_t err;
+    uint32_t size;
+
+    err = kvs_read_header(kvp, start + off, &h);
+    if (err != KVSTORE_NO_ERROR) {
+      return err;
+    }
+    if (kvs_is_erased(kvp, (const uint8_t *)&h, sizeof h)) {
+      break;
+    }
+    size = kvs_record_size(h.len);
+    if ((h.magic != KVS_RECORD_MAGIC) || (h.len > KVSTORE_MAX_VALUE_SIZE) ||
+        (off + size > kvp->sector_size)) {
+      /* Torn header, the rest of the sector can't be trusted.*/
+      off = kvp->sector_size;
+      *tornp = true;
+      break;
+    }
+    err = kvs_read(kvp, start + off, size, kvp->buf.b);
+    if (err != KVSTORE_NO_ERROR) {
+      return err;
+    }
+    if (kvs_record_crc(kvp->buf.b, h.len) != h.crc) {
+      *tornp = true;
+    }
+    else if (h.key < KVSTORE_MAX_KEYS) {
+      kvp->index[h.key] = (h.flags & KVS_FLAG_VALUE) != 0U ? start + off : 0U;
+    }
+    off += size;
+  }
+
+  if (s == kvp->head) {
+    uint32_t p;
+
+    /* Appending is only safe on erased space.*/
+    for (p = off; p < kvp->sector_size; p += sizeof kvp->buf.b) {
+      uint32_t n = kvp->sector_size - p;
+      kvstore_error_t err;
+
+      if (n > sizeof kvp->buf.b) {
+        n = sizeof kvp->buf.b;
+      }
+      err = kvs_read(kvp, start + p, n, kvp->buf.b);
+      if (err != KVSTORE_NO_ERROR) {
+        return err;
+      }
+      if (!kvs_is_erased(kvp, kvp->buf.b, n)) {
+        off = kvp->sector_size;
+        *tornp = true;
+        break;
+      }
+    }
+    kvp->wp = off;
+  }
+
+  return KVSTORE_NO_ERROR;
+}
+
+static kvstore_error_t kvs_mount(KVStore *kvp) {
+  const KVStoreConfig *config = kvp->config;
+  bool known[KVSTORE_MAX_SECTORS];
+  bool dirty[KVSTORE_MAX_SECTORS];
+  uint32_t max_erases = 0U, last;
+  bool torn = false;
+  flash_sector_t s;
+  kvstore_error_t err;
+  uint16_t key;
+
+  kvp->free = 0U;
+  kvp->seq  = 0U;
+  kvp->head = 0U;
+  kvp->wp   = kvp->sector_size;
+  memset(kvp->index, 0, sizeof kvp->index);
+
+  /* Sector headers.*/
+  for (s = 0U; s < config->sectors; s++) {
+    kvs_sector_header_t h;
+
+    err = kvs_read(kvp, (uint32_t)s * kvp->sector_size, sizeof h, &h);
+    if (err != KVSTORE_NO_ERROR) {
+      return err;
+    }
+    known[s] = false;
+    dirty[s] = false;
+    kvp->sectors[s].seq = 0U;
+    if ((h.magic == KVS_SECTOR_MAGIC) && (h.seq != 0U) &&
+        (h.crc == kvs_crc16(0xFFFFU, (const uint8_t *)&h, 12U))) {
+      known[s] = true;
+      kvp->sectors[s].seq = h.seq;
+      kvp->sectors[s].erases = h.erases;
+      if (h.erases > max_erases) {
+        max_erases = h.erases;
+      }
+      if (h.seq > kvp->seq) {
+        kvp->seq = h.seq;
+        kvp->head = s;
+      }
+    }
+    else if (kvs_is_erased(kvp, (const uint8_t *)&h, sizeof h) &&
+             (flashVerifyErase(config->flashp, config->first_sector + s) ==
+              FLASH_NO_ERROR)) {
+      kvp->free++;
+    }
+    else {
+      /* Torn header or interrupted erase.*/
+      dirty[s] = true;
+    }
+  }
+
+  /* Erase counts of blank sectors are lost, assume the worst case.*/
+  for (s = 0U; s < config->sectors; s++) {
+    if (!known[s]) {
+      kvp->sectors[s].erases = max_erases;
+    }
+    if (dirty[s]) {
+      err = kvs_erase(kvp, s);
+      if (err != KVSTORE_NO_ERROR) {
+        return err;
+      }
+    }
+  }
+
+  if (kvp->seq == 0U) {
+    /* Empty store.*/
+    kvp->head = config->sectors - 1U;
+    return kvs_open_next(kvp);
+  }
+
+  /* Records, oldest sector first.*/
+  last = 0U;
+  while (true) {
+    flash_sector_t next = config->sectors;
+
+    for (s = 0U; s < config->sectors; s++) {
+      if ((kvp->sectors[s].seq > last) &&
+          ((next == config->sectors) ||
+           (kvp->sectors[s].seq < kvp->sectors[next].seq))) {
+        next = s;
+      }
+    }
+    if (next == config->sectors) {
+      break;
+    }
+    torn = false;
+    err = kvs_scan(kvp, next, &torn);
+    if (err != KVSTORE_NO_ERROR) {
+      return err;
+    }
+    last = kvp->sectors[next].seq;
+  }
+
+  kvp->live = 0U;
+  for (key = 0U; key < KVSTORE_MAX_KEYS; key++) {
+    if (kvp->index[key] != 0U) {
+      kvs_record_header_t h;
+
+      err = kvs_read_header(kvp, kvp->index[key], &h);
+      if (err != KVSTORE_NO_ERROR) {
+        return err;
+      }
+      kvp->live += kvs_record_size(h.len);
+    }
+  }
+
+  /* Power lost during a reclaim. While no sector is erased the head only
+     holds copies; if a copy was torn the victim was not being erased yet,
+     the head is dropped and the reclaim starts over, otherwise it is
+     completed.*/
+  if (kvp->free == 0U) {
+    if (torn) {
+      err = kvs_erase(kvp, kvp->head);
+      if (err != KVSTORE_NO_ERROR) {
+        return err;
+      }
+      return kvs_mount(kvp);
+    }
+    return kvs_reclaim(kvp, kvs_oldest(kvp));
+  }
+
+  return KVSTORE_NO_ERROR;
+}
+
+static kvstore_error_t kvs_write(KVStore *kvp, uint16_t key, uint8_t flags,
+                                 const void *buf, size_t len) {
+  uint32_t offset = kvp->index[key];
+  uint32_t old = 0U, size, capacity;
+  kvs_record_header_t *hp = (kvs_record_header_t *)kvp->buf.b;
+  kvstore_error_t err;
+
+  if (offset != 0U) {
+    kvs_record_header_t h;
+
+    err = kvs_read_header(kvp, offset, &h);
+    if (err != KVSTORE_NO_ERROR) {
+      return err;
+    }
+    old = kvs_record_size(h.len);
+
+    /* Rewriting the same value costs nothing.*/
+    if ((flags == KVS_FLAG_VALUE) && (h.len == len)) {
+      size_t i;
+
+      for (i = 0U; i < len; i += sizeof kvp->buf.b) {
+        size_t n = len - i < sizeof kvp->buf.b ? len - i : sizeof kvp->buf.b;
+
+        err = kvs_read(kvp, offset + KVSTORE_RECORD_HEADER_SIZE + i,
+                       n, kvp->buf.b);
+        if (err != KVSTORE_NO_ERROR) {
+          return err;
+        }
+        if (memcmp(kvp->buf.b, (const uint8_t *)buf + i, n) != 0) {
+          break;
+        }
+      }
+      if (i >= len) {
+        return KVSTORE_NO_ERROR;
+      }
+    }
+  }
+  else if (flags == KVS_FLAG_DELETED) {
+    return KVSTORE_NOT_FOUND;
+  }
+
+  size = kvs_record_size(len);
+  capacity = (uint32_t)(kvp->config->sectors - 1U) *
+             (kvp->sector_size - KVSTORE_SECTOR_HEADER_SIZE);
+  if ((flags == KVS_FLAG_VALUE) && (kvp->live - old + size > capacity)) {
+    return KVSTORE_NO_SPACE;
+  }
+
+  /* Room first, a reclaim uses the record buffer.*/
+  err = kvs_make_room(kvp, size, true);
+  if (err != KVSTORE_NO_ERROR) {
+    return err;
+  }
+
+  memset(kvp->buf.b, kvp->erased, size);
+  hp->magic = KVS_RECORD_MAGIC;
+  hp->flags = flags;
+  hp->key   = key;
+  hp->len   = (uint16_t)len;
+  if (len > 0U) {
+    memcpy(kvp->buf.b + KVSTORE_RECORD_HEADER_SIZE, buf, len);
+  }
+  hp->crc   = kvs_record_crc(kvp->buf.b, len);
+
+  err = kvs_append(kvp, size, &offset);
+  if (err != KVSTORE_NO_ERROR) {
+    return err;
+  }
+
+  kvp->live -= old;
+  if (flags == KVS_FLAG_VALUE) {
+    kvp->index[key] = offset;
+    kvp->live += size;
+  }
+  else {
+    kvp->index[key] = 0U;
+  }
+
+  return KVSTORE_NO_ERROR;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a key-value store object.
+ *
+ * @param[out] kvp      pointer to the @p KVStore object
+ *
+ * @init
+ */
+void kvsObjectInit(KVStore *kvp) {
+
+  osalDbgCheck(kvp != NULL);
+
+  memset(kvp, 0, sizeof (KVStore));
+  kvp->state = KVSTORE_STOP;
+  osalMutexObjectInit(&kvp->mutex);
+}
+
+/**
+ * @brief   Mounts a key-value store.
+ * @details The sectors are scanned and the RAM index is rebuilt, sectors
+ *          that are neither valid nor erased are erased. An empty or
+ *          foreign region results in an empty store.
+ * @note    The flash driver must have been started.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @param[in] config    pointer to the @p KVStoreConfig object
+ * @return              The operation status.
+ * @retval KVSTORE_ERROR_LAYOUT if the sectors are not suitable.
+ *
+ * @api
+ */
+kvstore_error_t kvsStart(KVStore *kvp, const KVStoreConfig *config) {
+  const flash_descriptor_t *fdp;
+  kvstore_error_t err;
+  flash_sector_t s;
+
+  osalDbgCheck((kvp != NULL) && (config != NULL) && (config->flashp != NULL));
+  osalDbgAssert((kvp->state == KVSTORE_STOP) || (kvp->state == KVSTORE_READY),
+                "invalid state");
+
+  osalMutexLock(&kvp->mutex);
+
+  kvp->config = config;
+  kvp->state  = KVSTORE_STOP;
+
+  fdp = flashGetDescriptor(config->flashp);
+  kvp->erased = (fdp->attributes & FLASH_ATTR_ERASED_IS_ONE) != 0U ? 0xFFU
+                                                                   : 0x00U;
+  kvp->base = flashGetSectorOffset(config->flashp, config->first_sector);
+  kvp->sector_size = flashGetSectorSize(config->flashp, config->first_sector);
+
+  if ((config->sectors < 2U) || (config->sectors > KVSTORE_MAX_SECTORS) ||
+      (config->first_sector + config->sectors > fdp->sectors_count) ||
+      (kvp->sector_size < KVSTORE_SECTOR_HEADER_SIZE +
+                          KVSTORE_RECORD_MAX_SIZE)) {
+    osalMutexUnlock(&kvp->mutex);
+    return KVSTORE_ERROR_LAYOUT;
+  }
+  for (s = 1U; s < config->sectors; s++) {
+    if ((flashGetSectorSize(config->flashp, config->first_sector + s) !=
+         kvp->sector_size) ||
+        (flashGetSectorOffset(config->flashp, config->first_sector + s) !=
+         kvp->base + (uint32_t)s * kvp->sector_size)) {
+      osalMutexUnlock(&kvp->mutex);
+      return KVSTORE_ERROR_LAYOUT;
+    }
+  }
+
+  err = kvs_mount(kvp);
+  if (err == KVSTORE_NO_ERROR) {
+    kvp->state = KVSTORE_READY;
+  }
+
+  osalMutexUnlock(&kvp->mutex);
+
+  return err;
+}
+
+/**
+ * @brief   Unmounts a key-value store.
+ * @note    Nothing is cached, the flash is always up to date.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ *
+ * @api
+ */
+void kvsStop(KVStore *kvp) {
+
+  osalDbgCheck(kvp != NULL);
+
+  osalMutexLock(&kvp->mutex);
+  kvp->state = KVSTORE_STOP;
+  osalMutexUnlock(&kvp->mutex);
+}
+
+/**
+ * @brief   Reads the value of a key.
+ * @note    Values longer than @p size are truncated, the actual length
+ *          is always returned in @p lenp.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @param[in] key       the key
+ * @param[out] buf      value buffer
+ * @param[in] size      size of the value buffer
+ * @param[out] lenp     length of the stored value, can be @p NULL
+ * @return              The operation status.
+ * @retval KVSTORE_NOT_FOUND if the key has no value.
+ *
+ * @api
+ */
+kvstore_error_t kvsGet(KVStore *kvp, uint16_t key, void *buf, size_t size,
+                       size_t *lenp) {
+  kvs_record_header_t h;
+  kvstore_error_t err;
+  uint32_t offset;
+
+  osalDbgCheck((kvp != NULL) && (key < KVSTORE_MAX_KEYS) &&
+               ((buf != NULL) || (size == 0U)));
+  osalDbgAssert(kvp->state == KVSTORE_READY, "not ready");
+
+  osalMutexLock(&kvp->mutex);
+
+  offset = kvp->index[key];
+  if (offset == 0U) {
+    osalMutexUnlock(&kvp->mutex);
+    return KVSTORE_NOT_FOUND;
+  }
+
+  err = kvs_read_header(kvp, offset, &h);
+  if (err == KVSTORE_NO_ERROR) {
+    if (lenp != NULL) {
+      *lenp = h.len;
+    }
+    if (size > h.len) {
+      size = h.len;
+    }
+    if (size > 0U) {
+      err = kvs_read(kvp, offset + KVSTORE_RECORD_HEADER_SIZE, size, buf);
+    }
+  }
+
+  osalMutexUnlock(&kvp->mutex);
+
+  return err;
+}
+
+/**
+ * @brief   Writes the value of a key.
+ * @details The record is appended to the head sector; writing the value
+ *          already stored does not touch the flash. The call may have to
+ *          reclaim a sector if @p kvsCompact() is not used.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @param[in] key       the key
+ * @param[in] buf       the value
+ * @param[in] len       length of the value, up to
+ *                      @p KVSTORE_MAX_VALUE_SIZE
+ * @return              The operation status.
+ * @retval KVSTORE_NO_SPACE if the live data would exceed the capacity.
+ *
+ * @api
+ */
+kvstore_error_t kvsPut(KVStore *kvp, uint16_t key, const void *buf,
+                       size_t len) {
+  kvstore_error_t err;
+
+  osalDbgCheck((kvp != NULL) && (key < KVSTORE_MAX_KEYS) &&
+               ((buf != NULL) || (len == 0U)) &&
+               (len <= KVSTORE_MAX_VALUE_SIZE));
+  osalDbgAssert(kvp->state == KVSTORE_READY, "not ready");
+
+  osalMutexLock(&kvp->mutex);
+  err = kvs_write(kvp, key, KVS_FLAG_VALUE, buf, len);
+  osalMutexUnlock(&kvp->mutex);
+
+  return err;
+}
+
+/**
+ * @brief   Deletes a key.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @param[in] key       the key
+ * @return              The operation status.
+ * @retval KVSTORE_NOT_FOUND if the key has no value.
+ *
+ * @api
+ */
+kvstore_error_t kvsDelete(KVStore *kvp, uint16_t key) {
+  kvstore_error_t err;
+
+  osalDbgCheck((kvp != NULL) && (key < KVSTORE_MAX_KEYS));
+  osalDbgAssert(kvp->state == KVSTORE_READY, "not ready");
+
+  osalMutexLock(&kvp->mutex);
+  err = kvs_write(kvp, key, KVS_FLAG_DELETED, NULL, 0U);
+  osalMutexUnlock(&kvp->mutex);
+
+  return err;
+}
+
+/**
+ * @brief   Reclaims the oldest sector ahead of time.
+ * @details When fewer than two sectors are erased the oldest one is
+ *          reclaimed, so the next sector switch in @p kvsPut() does not
+ *          have to. Meant to be called periodically from a low priority
+ *          thread, the erase wait sleeps.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @return              The operation status.
+ *
+ * @api
+ */
+kvstore_error_t kvsCompact(KVStore *kvp) {
+  kvstore_error_t err = KVSTORE_NO_ERROR;
+  flash_sector_t victim;
+
+  osalDbgCheck(kvp != NULL);
+  osalDbgAssert(kvp->state == KVSTORE_READY, "not ready");
+
+  osalMutexLock(&kvp->mutex);
+  victim = kvs_oldest(kvp);
+  if ((kvp->free < 2U) && (victim < kvp->config->sectors)) {
+    err = kvs_reclaim(kvp, victim);
+  }
+  osalMutexUnlock(&kvp->mutex);
+
+  return err;
+}
+
+/**
+ * @brief   Erases all the keys.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @return              The operation status.
+ *
+ * @api
+ */
+kvstore_error_t kvsFormat(KVStore *kvp) {
+  kvstore_error_t err = KVSTORE_NO_ERROR;
+  flash_sector_t s;
+
+  osalDbgCheck(kvp != NULL);
+  osalDbgAssert(kvp->state == KVSTORE_READY, "not ready");
+
+  osalMutexLock(&kvp->mutex);
+
+  memset(kvp->index, 0, sizeof kvp->index);
+  kvp->live = 0U;
+  for (s = 0U; (s < kvp->config->sectors) && (err == KVSTORE_NO_ERROR); s++) {
+    if (kvp->sectors[s].seq != 0U) {
+      err = kvs_erase(kvp, s);
+    }
+  }
+  if (err == KVSTORE_NO_ERROR) {
+    err = kvs_open_next(kvp);
+  }
+
+  osalMutexUnlock(&kvp->mutex);
+
+  return err;
+}
+
+/**
+ * @brief   Returns the store statistics.
+ *
+ * @param[in] kvp       pointer to the @p KVStore object
+ * @param[out] statsp   pointer to the statistics
+ *
+ * @api
+ */
+void kvsGetStats(KVStore *kvp, kvstats_t *statsp) {
+  flash_sector_t s;
+
+  osalDbgCheck((kvp != NULL) && (statsp != NULL));
+  osalDbgAssert(kvp->state == KVSTORE_READY, "not ready");
+
+  osalMutexLock(&kvp->mutex);
+
+  *statsp = kvp->stats;
+  statsp->live_bytes = kvp->live;
+  statsp->free_bytes = (kvp->sector_size - kvp->wp) +
+                       (uint32_t)kvp->free *
+                       (kvp->sector_size - KVSTORE_SECTOR_HEADER_SIZE);
+  statsp->min_erases = kvp->sectors[0].erases;
+  statsp->max_erases = kvp->sectors[0].erases;
+  for (s = 1U; s < kvp->config->sectors; s++) {
+    if (kvp->sectors[s].erases < statsp->min_erases) {
+      statsp->min_erases = kvp->sectors[s].erases;
+    }
+    if (kvp->sectors[s].erases > statsp->max_erases) {
+      statsp->max_erases = kvp->sectors[s].erases;
+    }
+  }
+
+  osalMutexUnlock(&kvp->mutex);
+}
+
+/** @} */
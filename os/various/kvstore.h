@@ -0,0 +1,311 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    kvstore.h
+ * @brief   Flash key-value store header.
+ * @details Log-structured store for small settings on top of any
+ *          @p BaseFlash implementation (typically an @p EFlashDriver).
+ *          Updates are appended to the current sector, a RAM index keeps
+ *          the position of the latest record of each key. Sectors are
+ *          used in rotation and reclaimed oldest first, so erases are
+ *          spread evenly over the region.
+ *
+ * @addtogroup KVSTORE
+ * @{
+ */
+
+#ifndef KVSTORE_H
+#define KVSTORE_H
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Key-value store configuration options
+ * @{
+ */
+/**
+ * @brief   Number of keys, valid keys are 0 to @p KVSTORE_MAX_KEYS - 1.
+ * @note    The RAM index takes 4 bytes per key.
+ */
+#if !defined(KVSTORE_MAX_KEYS) || defined(__DOXYGEN__)
+#define KVSTORE_MAX_KEYS                64U
+#endif
+
+/**
+ * @brief   Maximum value size in bytes.
+ * @note    A record buffer of this size is part of the store object.
+ */
+#if !defined(KVSTORE_MAX_VALUE_SIZE) || defined(__DOXYGEN__)
+#define KVSTORE_MAX_VALUE_SIZE          128U
+#endif
+
+/**
+ * @brief   Maximum number of flash sectors in a store.
+ */
+#if !defined(KVSTORE_MAX_SECTORS) || defined(__DOXYGEN__)
+#define KVSTORE_MAX_SECTORS             4U
+#endif
+
+/**
+ * @brief   Record alignment in bytes.
+ * @details Every record starts on a multiple of this value and is padded
+ *          with erased bytes, so no flash word is ever programmed twice.
+ *          It must be a power of two not smaller than the flash program
+ *          unit.
+ */
+#if !defined(KVSTORE_PROGRAM_ALIGN) || defined(__DOXYGEN__)
+#define KVSTORE_PROGRAM_ALIGN           8U
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (KVSTORE_MAX_KEYS < 1U) || (KVSTORE_MAX_KEYS > 0xFFFFU)
+#error "invalid KVSTORE_MAX_KEYS value"
+#endif
+
+#if (KVSTORE_MAX_VALUE_SIZE < 1U) || (KVSTORE_MAX_VALUE_SIZE > 0xFFFFU)
+#error "invalid KVSTORE_MAX_VALUE_SIZE value"
+#endif
+
+#if KVSTORE_MAX_SECTORS < 2U
+#error "KVSTORE_MAX_SECTORS must be at least 2"
+#endif
+
+#if (KVSTORE_PROGRAM_ALIGN & (KVSTORE_PROGRAM_ALIGN - 1U)) != 0U
+#error "KVSTORE_PROGRAM_ALIGN must be a power of two"
+#endif
+
+/**
+ * @brief   Aligns a size to @p KVSTORE_PROGRAM_ALIGN.
+ */
+#define KVSTORE_ALIGN(n)                                                    \
+  (((n) + KVSTORE_PROGRAM_ALIGN - 1U) & ~(KVSTORE_PROGRAM_ALIGN - 1U))
+
+/**
+ * @brief   Size of a record header.
+ */
+#define KVSTORE_RECORD_HEADER_SIZE      8U
+
+/**
+ * @brief   Size of a sector header.
+ */
+#define KVSTORE_SECTOR_HEADER_SIZE      KVSTORE_ALIGN(16U)
+
+/**
+ * @brief   Size of the largest record.
+ */
+#define KVSTORE_RECORD_MAX_SIZE                                             \
+  KVSTORE_ALIGN(KVSTORE_RECORD_HEADER_SIZE + KVSTORE_MAX_VALUE_SIZE)
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Key-value store states.
+ */
+typedef enum {
+  KVSTORE_UNINIT = 0,
+  KVSTORE_STOP = 1,
+  KVSTORE_READY = 2
+} kvstate_t;
+
+/**
+ * @brief   Key-value store error codes.
+ */
+typedef enum {
+  KVSTORE_NO_ERROR = 0,             /**< No error.                          */
+  KVSTORE_NOT_FOUND = 1,            /**< The key has no value.              */
+  KVSTORE_NO_SPACE = 2,             /**< The live data would not fit.       */
+  KVSTORE_ERROR_FLASH = 3,          /**< The flash reported an error.       */
+  KVSTORE_ERROR_LAYOUT = 4          /**< Unsuitable flash sectors.          */
+} kvstore_error_t;
+
+/**
+ * @brief   Key-value store configuration.
+ * @note    All the sectors of the region must have the same size.
+ */
+typedef struct {
+  /**
+   * @brief   Flash holding the store.
+   */
+  BaseFlash                 *flashp;
+  /**
+   * @brief   First sector of the region.
+   */
+  flash_sector_t            first_sector;
+  /**
+   * @brief   Number of sectors, from 2 to @p KVSTORE_MAX_SECTORS.
+   * @note    One sector is always kept erased, the capacity is the
+   *          remaining sectors minus their headers.
+   */
+  flash_sector_t            sectors;
+} KVStoreConfig;
+
+/**
+ * @brief   Per-sector bookkeeping.
+ */
+typedef struct {
+  /**
+   * @brief   Sequence number from the sector header, 0 if not in use.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief   Number of times the sector has been erased.
+   */
+  uint32_t                  erases;
+} kvsector_t;
+
+/**
+ * @brief   Key-value store statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Bytes taken by the latest record of each key.
+   */
+  uint32_t                  live_bytes;
+  /**
+   * @brief   Bytes available for appends without reclaiming a sector.
+   */
+  uint32_t                  free_bytes;
+  /**
+   * @brief   Lowest erase count in the region.
+   */
+  uint32_t                  min_erases;
+  /**
+   * @brief   Highest erase count in the region.
+   */
+  uint32_t                  max_erases;
+  /**
+   * @brief   Sectors reclaimed since start.
+   */
+  uint32_t                  reclaims;
+  /**
+   * @brief   Records copied by reclaims since start.
+   */
+  uint32_t                  copies;
+} kvstats_t;
+
+/**
+ * @brief   Key-value store object.
+ */
+typedef struct {
+  /**
+   * @brief   Store state.
+   */
+  kvstate_t                 state;
+  /**
+   * @brief   Current configuration.
+   */
+  const KVStoreConfig       *config;
+  /**
+   * @brief   Offset of the region within the flash.
+   */
+  flash_offset_t            base;
+  /**
+   * @brief   Sector size.
+   */
+  uint32_t                  sector_size;
+  /**
+   * @brief   Value of an erased byte.
+   */
+  uint8_t                   erased;
+  /**
+   * @brief   Sector being appended to.
+   */
+  flash_sector_t            head;
+  /**
+   * @brief   Append offset within the head sector.
+   */
+  uint32_t                  wp;
+  /**
+   * @brief   Number of erased sectors.
+   */
+  flash_sector_t            free;
+  /**
+   * @brief   Highest sequence number in use.
+   */
+  uint32_t                  seq;
+  /**
+   * @brief   Sum of the live record sizes.
+   */
+  uint32_t                  live;
+  /**
+   * @brief   Sectors bookkeeping.
+   */
+  kvsector_t                sectors[KVSTORE_MAX_SECTORS];
+  /**
+   * @brief   Region offset of the latest record of each key, 0 if none.
+   */
+  uint32_t                  index[KVSTORE_MAX_KEYS];
+  /**
+   * @brief   Statistics.
+   */
+  kvstats_t                 stats;
+  /**
+   * @brief   Record buffer.
+   */
+  union {
+    uint32_t                w[KVSTORE_RECORD_MAX_SIZE / 4U];
+    uint8_t                 b[KVSTORE_RECORD_MAX_SIZE];
+  } buf;
+  /**
+   * @brief   Mutex protecting the store.
+   */
+  mutex_t                   mutex;
+} KVStore;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void kvsObjectInit(KVStore *kvp);
+  kvstore_error_t kvsStart(KVStore *kvp, const KVStoreConfig *config);
+  void kvsStop(KVStore *kvp);
+  kvstore_error_t kvsGet(KVStore *kvp, uint16_t key, void *buf, size_t size,
+                         size_t *lenp);
+  kvstore_error_t kvsPut(KVStore *kvp, uint16_t key, const void *buf,
+                         size_t len);
+  kvstore_error_t kvsDelete(KVStore *kvp, uint16_t key);
+  kvstore_error_t kvsCompact(KVStore *kvp);
+  kvstore_error_t kvsFormat(KVStore *kvp);
+  void kvsGetStats(KVStore *kvp, kvstats_t *statsp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KVSTORE_H */
+
+/** @} */
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "hal.h"
+#include "hal_trace_points.h"
 
 #include "lib_scsi.h"
 
@@ -426,6 +427,18 @@ bool scsiExecCmd(SCSITarget *scsip, const uint8_t *cmd) {
 
   bool ret = SCSI_SUCCESS;
 
+#if HAL_USE_TRACE_POINTS == TRUE
+  if ((cmd[0] == SCSI_CMD_READ_10) || (cmd[0] == SCSI_CMD_WRITE_10)) {
+    data_request_t req = decode_data_request(cmd);
+    _hal_trace_point(HAL_TRACE_MODULE_SCSI, HAL_TRACE_SCSI_CMD_START,
+                     cmd[0], req.first_lba, req.blk_cnt);
+  }
+  else {
+    _hal_trace_point(HAL_TRACE_MODULE_SCSI, HAL_TRACE_SCSI_CMD_START,
+                     cmd[0], 0, 0);
+  }
+#endif
+
   switch (cmd[0]) {
   case SCSI_CMD_INQUIRY:
     dbgprintf("SCSI_CMD_INQUIRY\r\n");
@@ -486,6 +499,9 @@ bool scsiExecCmd(SCSITarget *scsip, const uint8_t *cmd) {
   if (ret == SCSI_SUCCESS)
     set_sense_ok(scsip);
 
+  _hal_trace_point(HAL_TRACE_MODULE_SCSI, HAL_TRACE_SCSI_CMD_END,
+                   cmd[0], ret, scsip->residue);
+
   return ret;
 }
 
@@ -308,3 +308,447 @@ void memtest_run(memtest_t *testp, uint32_t testmask) {
   }
 }
 
+
+/*
+ ******************************************************************************
+ * Fast mode. Works on 64-bit words with unrolled loops and non virtual
+ * pattern sources. Periodic patterns can be filled by an external copy
+ * engine (DMA) from a template held in the scratch buffer.
+ ******************************************************************************
+ */
+
+/*
+ * Period in words of the periodic patterns template.
+ */
+#define FAST_PERIOD       64U
+
+static_assert(MEMTEST_SCRATCH_GRANULE % (FAST_PERIOD * sizeof(uint64_t)) == 0,
+              "the scratch granule must hold whole template periods");
+
+/*
+ *
+ */
+enum fast_kind {
+  FAST_TEMPLATE,
+  FAST_ADDRESS,
+  FAST_RAND
+};
+
+/*
+ *
+ */
+struct fast_pass {
+  testtype  type;
+  fast_kind kind;
+  uint64_t  seed;
+};
+
+/*
+ *
+ */
+class SourceTemplate {
+public:
+  SourceTemplate(const uint64_t *tpl) : tpl(tpl), idx(0) {;}
+  uint64_t get(void) {
+    return tpl[idx++ & (FAST_PERIOD - 1)];
+  }
+private:
+  const uint64_t *tpl;
+  size_t idx;
+};
+
+/*
+ *
+ */
+class SourceAddress {
+public:
+  SourceAddress(uint64_t base) : pattern(base) {;}
+  uint64_t get(void) {
+    return pattern++;
+  }
+private:
+  uint64_t pattern;
+};
+
+/*
+ * xorshift64 words followed by their inversion.
+ */
+class SourceRand {
+public:
+  SourceRand(uint64_t seed) : state(seed | 1U), prev(0), step(0) {;}
+  uint64_t get(void) {
+    if ((step++ & 1U) == 0) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      prev = state;
+      return prev;
+    }
+    return ~prev;
+  }
+private:
+  uint64_t state;
+  uint64_t prev;
+  size_t step;
+};
+
+/*
+ *
+ */
+template <typename S>
+static void fast_fill(uint64_t *mem, size_t words, S &src) {
+  size_t i;
+
+  for (i=0; i+8<=words; i+=8) {
+    mem[i+0] = src.get();
+    mem[i+1] = src.get();
+    mem[i+2] = src.get();
+    mem[i+3] = src.get();
+    mem[i+4] = src.get();
+    mem[i+5] = src.get();
+    mem[i+6] = src.get();
+    mem[i+7] = src.get();
+  }
+  for (; i<words; i++)
+    mem[i] = src.get();
+}
+
+/*
+ * Reports a mismatching 64-bit word as the first of its 32-bit halves that
+ * differs, with the index of that half, so that the callback gets the whole
+ * faulty value.
+ */
+static void fast_error(memtest_t *testp, testtype type, size_t index,
+                       uint64_t got, uint64_t expect) {
+  uint32_t g[2], e[2];
+  size_t h;
+
+  if (nullptr == testp->errcb)
+    return;
+
+  memcpy(g, &got, sizeof(g));
+  memcpy(e, &expect, sizeof(e));
+  h = g[0] != e[0] ? 0 : 1;
+  testp->errcb(testp, type, index * 2 + h, sizeof(uint32_t), g[h], e[h]);
+}
+
+/*
+ * Returns false and calls the error callback on the first mismatch.
+ * The block is checked as a whole and searched only if it differs.
+ */
+template <typename S>
+static bool fast_verify(memtest_t *testp, testtype type, const uint64_t *mem,
+                        size_t words, size_t base, S &src) {
+  uint64_t expect[8];
+  uint64_t diff;
+  size_t i, j, n;
+
+  for (i=0; i<words; i+=n) {
+    n = words - i < 8 ? words - i : 8;
+    diff = 0;
+    for (j=0; j<n; j++) {
+      expect[j] = src.get();
+      diff |= mem[i+j] ^ expect[j];
+    }
+    if (diff != 0) {
+      for (j=0; j<n; j++) {
+        uint64_t got = mem[i+j];
+        if (got != expect[j]) {
+          fast_error(testp, type, base + i + j, got, expect[j]);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/*
+ *
+ */
+static void fast_template(const fast_pass *pass, uint64_t *tpl) {
+  size_t i;
+
+  for (i=0; i<FAST_PERIOD; i++) {
+    switch (pass->type) {
+    case MEMTEST_WALKING_ONE:
+      tpl[i] = (uint64_t)1 << i;
+      break;
+    case MEMTEST_WALKING_ZERO:
+      tpl[i] = ~((uint64_t)1 << i);
+      break;
+    default:
+      tpl[i] = (i & 1U) ? ~pass->seed : pass->seed;
+      break;
+    }
+  }
+}
+
+/*
+ *
+ */
+static size_t fast_passes(uint32_t testmask, fast_pass *passes) {
+  size_t n = 0;
+
+  if (testmask & MEMTEST_WALKING_ONE)
+    passes[n++] = {MEMTEST_WALKING_ONE, FAST_TEMPLATE, 0};
+  if (testmask & MEMTEST_WALKING_ZERO)
+    passes[n++] = {MEMTEST_WALKING_ZERO, FAST_TEMPLATE, 0};
+  if (testmask & MEMTEST_OWN_ADDRESS)
+    passes[n++] = {MEMTEST_OWN_ADDRESS, FAST_ADDRESS, 0};
+  if (testmask & MEMTEST_MOVING_INVERSION_ZERO) {
+    passes[n++] = {MEMTEST_MOVING_INVERSION_ZERO, FAST_TEMPLATE, 0};
+    passes[n++] = {MEMTEST_MOVING_INVERSION_ZERO, FAST_TEMPLATE, ~(uint64_t)0};
+  }
+  if (testmask & MEMTEST_MOVING_INVERSION_55AA) {
+    passes[n++] = {MEMTEST_MOVING_INVERSION_55AA, FAST_TEMPLATE,
+                   0x5555555555555555ULL};
+    passes[n++] = {MEMTEST_MOVING_INVERSION_55AA, FAST_TEMPLATE,
+                   0xAAAAAAAAAAAAAAAAULL};
+  }
+  if (testmask & MEMTEST_MOVING_INVERSION_RAND) {
+    prng_seed++;
+    passes[n++] = {MEMTEST_MOVING_INVERSION_RAND, FAST_RAND, prng_seed};
+  }
+
+  return n;
+}
+
+/*
+ *
+ */
+static void fast_stat(memtest_t *testp, testtype type, size_t words,
+                      uint32_t start) {
+  size_t i;
+
+  if (nullptr == testp->clock)
+    return;
+
+  for (i=0; i<MEMTEST_TYPES; i++) {
+    if (type == ((testtype)1 << i)) {
+      testp->stats[i].bytes += 2 * words * sizeof(uint64_t);
+      testp->stats[i].us += testp->clock() - start;
+    }
+  }
+}
+
+/*
+ * Fills the region with the copy engine, one scratch sized chunk at a time.
+ */
+static void fast_copy_fill(memtest_t *testp, uint64_t *mem, size_t words,
+                           size_t chunk) {
+  size_t i, n;
+
+  for (i=0; i<words; i+=n) {
+    n = words - i < chunk ? words - i : chunk;
+    testp->copy(testp, &mem[i], testp->scratch, n * sizeof(uint64_t));
+    testp->wait(testp);
+  }
+}
+
+/*
+ * Loads the scratch buffer with repetitions of a template.
+ */
+static void fast_load_scratch(memtest_t *testp, const uint64_t *tpl) {
+  SourceTemplate src(tpl);
+
+  fast_fill(static_cast<uint64_t *>(testp->scratch),
+            testp->scratch_size / sizeof(uint64_t), src);
+}
+
+/*
+ * Verifies a template pass chunk by chunk. If next_tpl is not NULL the copy
+ * engine fills every verified chunk with the next pass while the CPU goes
+ * on with the following one, so the next pass needs no fill phase.
+ */
+static bool fast_verify_refill(memtest_t *testp, testtype type,
+                               const uint64_t *tpl, uint64_t *mem,
+                               size_t words, size_t base, size_t chunk,
+                               const uint64_t *next_tpl) {
+  SourceTemplate src(tpl);
+  bool busy = false;
+  bool ok;
+  size_t i, n;
+
+  if (nullptr != next_tpl)
+    fast_load_scratch(testp, next_tpl);
+
+  for (i=0; i<words; i+=n) {
+    n = words - i < chunk ? words - i : chunk;
+    ok = fast_verify(testp, type, &mem[i], n, base + i, src);
+    if (busy)
+      testp->wait(testp);
+    busy = false;
+    if (!ok)
+      return false;
+    if (nullptr != next_tpl) {
+      testp->copy(testp, &mem[i], testp->scratch, n * sizeof(uint64_t));
+      busy = true;
+    }
+  }
+  if (busy)
+    testp->wait(testp);
+
+  return true;
+}
+
+/*
+ * Runs a list of passes over a region. base is the index of the first word
+ * of the region in the whole test area.
+ */
+static bool fast_region(memtest_t *testp, const fast_pass *passes, size_t n,
+                        uint64_t *mem, size_t words, size_t base,
+                        bool use_copy) {
+  uint64_t tpl[2][FAST_PERIOD];
+  const size_t chunk = use_copy ? testp->scratch_size / sizeof(uint64_t)
+                                : words;
+  bool prefilled = false;
+  bool ok = true;
+  uint32_t start = 0;
+  size_t k, cur = 0;
+
+  if (n > 0 && passes[0].kind == FAST_TEMPLATE)
+    fast_template(&passes[0], tpl[cur]);
+
+  for (k=0; k<n && ok; k++) {
+    const fast_pass *pass = &passes[k];
+    const fast_pass *next = k + 1 < n ? &passes[k+1] : nullptr;
+    bool refill = use_copy && nullptr != next && next->kind == FAST_TEMPLATE;
+
+    if (nullptr != testp->clock)
+      start = testp->clock();
+
+    if ((nullptr != next) && (next->kind == FAST_TEMPLATE))
+      fast_template(next, tpl[cur ^ 1U]);
+
+    switch (pass->kind) {
+    case FAST_TEMPLATE:
+      if (!prefilled) {
+        if (use_copy) {
+          fast_load_scratch(testp, tpl[cur]);
+          fast_copy_fill(testp, mem, words, chunk);
+        }
+        else {
+          SourceTemplate src(tpl[cur]);
+          fast_fill(mem, words, src);
+        }
+      }
+      ok = fast_verify_refill(testp, pass->type, tpl[cur], mem, words, base,
+                              chunk, refill ? tpl[cur ^ 1U] : nullptr);
+      break;
+    case FAST_ADDRESS: {
+      SourceAddress fill(base), check(base);
+      fast_fill(mem, words, fill);
+      ok = fast_verify(testp, pass->type, mem, words, base, check);
+      refill = false;
+      break;
+    }
+    case FAST_RAND: {
+      SourceRand fill(pass->seed + base), check(pass->seed + base);
+      fast_fill(mem, words, fill);
+      ok = fast_verify(testp, pass->type, mem, words, base, check);
+      refill = false;
+      break;
+    }
+    }
+
+    fast_stat(testp, pass->type, words, start);
+    prefilled = refill;
+    cur ^= 1U;
+  }
+
+  return ok;
+}
+
+/*
+ ******************************************************************************
+ * EXPORTED FUNCTIONS
+ ******************************************************************************
+ */
+
+/*
+ * Fast mode. Tests the area with 64-bit accesses only, width_mask is ignored.
+ * Uses the copy engine for periodic patterns if copy, wait and scratch
+ * are set, and updates the statistics if clock is set.
+ * Returns false if a fault has been found, the error callback has the
+ * details.
+ */
+bool memtest_fast_run(memtest_t *testp, uint32_t testmask) {
+  fast_pass passes[2 * MEMTEST_TYPES];
+  size_t n = fast_passes(testmask, passes);
+  bool use_copy = (nullptr != testp->copy) && (nullptr != testp->wait) &&
+                  (nullptr != testp->scratch);
+
+  MEMTEST_CHECK((nullptr == testp->scratch) ||
+                ((testp->scratch_size > 0U) &&
+                 ((testp->scratch_size % MEMTEST_SCRATCH_GRANULE) == 0U)));
+
+  return fast_region(testp, passes, n, static_cast<uint64_t *>(testp->start),
+                     testp->size / sizeof(uint64_t), 0, use_copy);
+}
+
+/*
+ * Non destructive background test. Every slice of scratch_size bytes is
+ * saved in the scratch buffer, tested with the CPU and restored. Slices are
+ * processed until budget_us is spent (a single slice if clock is NULL).
+ * Returns true when the end of the area has been reached, the next call
+ * restarts from its beginning. A faulty slice increments bg_errors, calls
+ * the error callback and ends the call.
+ * The caller must guarantee that nobody accesses the slices under test.
+ */
+bool memtest_background(memtest_t *testp, uint32_t testmask,
+                        uint32_t budget_us) {
+  fast_pass passes[2 * MEMTEST_TYPES];
+  size_t n = fast_passes(testmask, passes);
+  uint8_t *area = static_cast<uint8_t *>(testp->start);
+  uint32_t start = 0;
+  size_t len;
+  bool ok;
+
+  if (nullptr == testp->scratch)
+    return true;
+
+  MEMTEST_CHECK((testp->scratch_size > 0U) &&
+                ((testp->scratch_size % MEMTEST_SCRATCH_GRANULE) == 0U));
+
+  if (nullptr != testp->clock)
+    start = testp->clock();
+
+  while (true) {
+    len = testp->size - testp->bg_offset;
+    if (len > testp->scratch_size)
+      len = testp->scratch_size;
+    len &= ~(sizeof(uint64_t) - 1U);
+
+    memcpy(testp->scratch, &area[testp->bg_offset], len);
+    ok = fast_region(testp, passes, n,
+                     reinterpret_cast<uint64_t *>(&area[testp->bg_offset]),
+                     len / sizeof(uint64_t),
+                     testp->bg_offset / sizeof(uint64_t), false);
+    memcpy(&area[testp->bg_offset], testp->scratch, len);
+    if (!ok)
+      testp->bg_errors++;
+
+    testp->bg_offset += testp->scratch_size;
+    if (testp->bg_offset + sizeof(uint64_t) > testp->size) {
+      testp->bg_offset = 0;
+      return true;
+    }
+    if (!ok || (nullptr == testp->clock) ||
+        (testp->clock() - start >= budget_us))
+      return false;
+  }
+}
+
+/*
+ * Fast mode throughput of a test type in MB/s.
+ */
+uint32_t memtest_mbps(const memtest_t *testp, testtype type) {
+  size_t i;
+
+  for (i=0; i<MEMTEST_TYPES; i++) {
+    if ((type == ((testtype)1 << i)) && (testp->stats[i].us > 0))
+      return (uint32_t)(testp->stats[i].bytes / testp->stats[i].us);
+  }
+  return 0;
+}
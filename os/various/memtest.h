@@ -45,6 +45,25 @@
 #define MEMTEST_WIDTH_32  (1 << 2)
 #define MEMTEST_WIDTH_64  (1 << 3)
 
+/*
+ * Number of test types, size of the statistics array
+ */
+#define MEMTEST_TYPES     6
+
+/*
+ * The scratch buffer size must be a multiple of this value, it holds whole
+ * periods of the fast mode patterns.
+ */
+#define MEMTEST_SCRATCH_GRANULE   512U
+
+/*
+ * Parameter check hook, may be defined as osalDbgCheck. Checks nothing by
+ * default so that the tester does not depend on the OS.
+ */
+#if !defined(MEMTEST_CHECK)
+#define MEMTEST_CHECK(c)          ((void)0)
+#endif
+
 typedef struct memtest_t memtest_t;
 typedef uint32_t testtype;
 
@@ -54,6 +73,39 @@ typedef uint32_t testtype;
 typedef void (*memtestecb_t)(memtest_t *testp, testtype type, size_t index,
                            size_t current_width, uint32_t got, uint32_t expect);
 
+/*
+ * Asynchronous copy call back used by the fast mode, typically a DMA
+ * memory-to-memory transfer. Must start copying size bytes from src to dst
+ * and return immediately.
+ */
+typedef void (*memtestcopy_t)(memtest_t *testp, void *dst, const void *src,
+                              size_t size);
+
+/*
+ * Waits for completion of the copy started by memtestcopy_t.
+ */
+typedef void (*memtestwait_t)(memtest_t *testp);
+
+/*
+ * Free running time counter in microseconds, used for statistics and for
+ * the background test time budget.
+ */
+typedef uint32_t (*memtestclock_t)(void);
+
+/*
+ * Fast mode per test type statistics.
+ */
+typedef struct {
+  /*
+   * Bytes written and read back.
+   */
+  uint64_t      bytes;
+  /*
+   * Time spent in microseconds.
+   */
+  uint32_t      us;
+} memtest_stat_t;
+
 /*
  *
  */
@@ -74,6 +126,40 @@ struct memtest_t {
    * Error callback pointer. Set to NULL if unused.
    */
   memtestecb_t  errcb;
+  /*
+   * Fast mode and background test fields, all of them are optional.
+   */
+  /*
+   * Scratch buffer in known good memory, 8 bytes aligned. Its size is the
+   * chunk size of the fast mode copy engine and of the background test,
+   * must be a multiple of MEMTEST_SCRATCH_GRANULE.
+   */
+  void          *scratch;
+  /*
+   * Scratch buffer size in bytes.
+   */
+  size_t        scratch_size;
+  /*
+   * Copy engine call backs. Set to NULL to fill with the CPU only.
+   */
+  memtestcopy_t copy;
+  memtestwait_t wait;
+  /*
+   * Time counter. Set to NULL if unused.
+   */
+  memtestclock_t clock;
+  /*
+   * Background test position in bytes.
+   */
+  size_t        bg_offset;
+  /*
+   * Number of faulty slices found by the background test.
+   */
+  size_t        bg_errors;
+  /*
+   * Fast mode statistics, indexed by test type bit number.
+   */
+  memtest_stat_t stats[MEMTEST_TYPES];
 };
 
 /*
@@ -83,6 +169,10 @@ struct memtest_t {
 extern "C" {
 #endif
   void memtest_run(memtest_t *testp, uint32_t testmask);
+  bool memtest_fast_run(memtest_t *testp, uint32_t testmask);
+  bool memtest_background(memtest_t *testp, uint32_t testmask,
+                          uint32_t budget_us);
+  uint32_t memtest_mbps(const memtest_t *testp, testtype type);
 #ifdef __cplusplus
 }
 #endif
@@ -43,42 +43,59 @@ void pid_create(pidc_t* p, float* Input, float* Output, float* Setpoint,
 *   false when nothing has been done.
 **********************************************************************************/
 bool pid_compute(pidc_t* p)
+{
+    return pid_computeAt(p, TIME_MS);
+}
+
+/* ComputeAt(...) *****************************************************************
+*   Same as Compute() but the current time is given by the caller, in the same unit
+*   as the sample time, so that the loop can be driven by any timebase.
+**********************************************************************************/
+bool pid_computeAt(pidc_t* p, unsigned long now)
 {
     if(!p->inAuto) return false;
-    unsigned long now = TIME_MS;
     unsigned long timeChange = (now - p->lastTime);
     if(timeChange >= p->sampleTime)
     {
-        /* Compute all the working error variables */
-        float input = *p->input;
-        float error = *p->setPoint - input;
-        float dInput = (input - p->lastInput);
-        p->outputSum += (p->ki * error);
+        pid_computeFixed(p);
+        p->lastTime = now;
+        return true;
+    }
+    else return false;
+}
 
-        /* Add Proportional on Measurement, if PID_ON_M is specified */
-        if(!p->pOnE) p->outputSum -= p->kp * dInput;
+/* ComputeFixed() *****************************************************************
+*   Performs the calculation unconditionally. Meant for loops that are already
+*   triggered at the sample time, by a timer or a conversion complete interrupt.
+**********************************************************************************/
+void pid_computeFixed(pidc_t* p)
+{
+    /* Compute all the working error variables */
+    float input = *p->input;
+    float error = *p->setPoint - input;
+    float dInput = (input - p->lastInput);
+    p->outputSum += (p->ki * error);
 
-        if(p->outputSum > p->outMax) p->outputSum = p->outMax;
-        else if(p->outputSum < p->outMin) p->outputSum = p->outMin;
+    /* Add Proportional on Measurement, if PID_ON_M is specified */
+    if(!p->pOnE) p->outputSum -= p->kp * dInput;
 
-        /* Add Proportional on Error, if P_ON_E is specified */
-        float output;
-        if(p->pOnE) output = p->kp * error;
-        else output = 0;
+    if(p->outputSum > p->outMax) p->outputSum = p->outMax;
+    else if(p->outputSum < p->outMin) p->outputSum = p->outMin;
 
-        /* Compute Rest of PID Output */
-        output += p->outputSum - p->kd * dInput;
+    /* Add Proportional on Error, if P_ON_E is specified */
+    float output;
+    if(p->pOnE) output = p->kp * error;
+    else output = 0;
 
-        if(output > p->outMax) output = p->outMax;
-        else if(output < p->outMin) output = p->outMin;
-            *p->output = output;
+    /* Compute Rest of PID Output */
+    output += p->outputSum - p->kd * dInput;
 
-        /* Remember some variables for next time */
-        p->lastInput = input;
-        p->lastTime = now;
-        return true;
-    }
-    else return false;
+    if(output > p->outMax) output = p->outMax;
+    else if(output < p->outMin) output = p->outMin;
+    *p->output = output;
+
+    /* Remember some variables for next time */
+    p->lastInput = input;
 }
 
 /* SetTunings(...)*************************************************************
@@ -192,3 +209,336 @@ void pid_setDirection(pidc_t* p, int Direction)
     p->direction = Direction;
 }
 
+
+/* Saturating arithmetic helpers **********************************************
+* The DSP extension of Cortex-M4/M7 provides them as single instructions,
+* other cores (and host builds) use the portable versions.
+******************************************************************************/
+static inline int32_t pid_sat32(int64_t x)
+{
+    if(x > INT32_MAX) return INT32_MAX;
+    if(x < INT32_MIN) return INT32_MIN;
+    return (int32_t)x;
+}
+
+static inline int64_t pid_clamp64(int64_t x, int64_t min, int64_t max)
+{
+    if(x > max) return max;
+    if(x < min) return min;
+    return x;
+}
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define pid_qadd32(a, b) __QADD((a), (b))
+#define pid_qsub32(a, b) __QSUB((a), (b))
+#define pid_ssat16(x)    ((int16_t)__SSAT((x), 16))
+#else
+static inline int32_t pid_qadd32(int32_t a, int32_t b)
+{
+    return pid_sat32((int64_t)a + b);
+}
+
+static inline int32_t pid_qsub32(int32_t a, int32_t b)
+{
+    return pid_sat32((int64_t)a - b);
+}
+
+static inline int16_t pid_ssat16(int32_t x)
+{
+    if(x > INT16_MAX) return INT16_MAX;
+    if(x < INT16_MIN) return INT16_MIN;
+    return (int16_t)x;
+}
+#endif
+
+static inline int64_t pid_qadd64(int64_t a, int64_t b)
+{
+    if(b > 0 && a > INT64_MAX - b) return INT64_MAX;
+    if(b < 0 && a < INT64_MIN - b) return INT64_MIN;
+    return a + b;
+}
+
+/* Converts a gain to a fraction of full scale 2^shift, in Q(fbits). The
+   limit 2^fbits - 1 is not representable in a float for fbits 31, the
+   clamp is done on the powers of two and then on the rounded integer. */
+static int64_t pid_gain_to_fixed(float k, unsigned shift, unsigned fbits)
+{
+    float lim = (float)(1ULL << fbits);
+    int64_t max = (int64_t)(1ULL << fbits) - 1;
+    float q = k * (lim / (float)(1UL << shift));
+
+    if(q >= lim) return max;
+    if(q <= -lim) return -max;
+    return pid_clamp64((int64_t)(q < 0 ? q - 0.5f : q + 0.5f), -max, max);
+}
+
+/* Scales the user gains by the sample time and splits the proportional gain
+   between error and measurement, as SetTunings() does for a single PID */
+static void pid_bank_gains(float g[4], float Kp, float Ki, float Kd,
+                           int POn, int Direction, unsigned long SampleTime)
+{
+    float SampleTimeInSec = ((float)SampleTime) / 1000.0f;
+    float sign = Direction == PID_REVERSE ? -1.0f : 1.0f;
+
+    g[0] = POn == PID_ON_E ? sign * Kp : 0.0f;
+    g[1] = POn == PID_ON_E ? 0.0f : sign * Kp;
+    g[2] = sign * Ki * SampleTimeInSec;
+    g[3] = sign * Kd / SampleTimeInSec;
+}
+
+/* Bank create(...) ***********************************************************
+*   Lays out the arrays of a bank of n controllers in the provided storage.
+*   Every controller starts with zero gains and the 0..4095 default limits.
+******************************************************************************/
+void pid_bank_create(pid_bank_t* b, float* storage, size_t n)
+{
+    b->n = n;
+    b->kpE = storage;
+    b->kpM = b->kpE + n;
+    b->ki = b->kpM + n;
+    b->kd = b->ki + n;
+    b->outputSum = b->kd + n;
+    b->lastInput = b->outputSum + n;
+    b->outMin = b->lastInput + n;
+    b->outMax = b->outMin + n;
+
+    for(size_t i = 0; i < n * PID_BANK_FLOATS; i++) storage[i] = 0;
+    for(size_t i = 0; i < n; i++) b->outMax[i] = 4095;
+}
+
+void pid_bank_setTunings(pid_bank_t* b, size_t i, float Kp, float Ki, float Kd,
+                         int POn, int Direction, unsigned long SampleTime)
+{
+    float g[4];
+
+    if (Kp < 0 || Ki < 0 || Kd < 0 || SampleTime == 0) return;
+
+    pid_bank_gains(g, Kp, Ki, Kd, POn, Direction, SampleTime);
+    b->kpE[i] = g[0];
+    b->kpM[i] = g[1];
+    b->ki[i] = g[2];
+    b->kd[i] = g[3];
+}
+
+void pid_bank_setOutputLimits(pid_bank_t* b, size_t i, float Min, float Max)
+{
+    if(Min >= Max) return;
+    b->outMin[i] = Min;
+    b->outMax[i] = Max;
+
+    if(b->outputSum[i] > Max) b->outputSum[i] = Max;
+    else if(b->outputSum[i] < Min) b->outputSum[i] = Min;
+}
+
+void pid_bank_initialize(pid_bank_t* b, size_t i, float Input, float Output)
+{
+    b->lastInput[i] = Input;
+    if(Output > b->outMax[i]) Output = b->outMax[i];
+    else if(Output < b->outMin[i]) Output = b->outMin[i];
+    b->outputSum[i] = Output;
+}
+
+void pid_bank_load(pid_bank_t* b, size_t i, const pidc_t* p)
+{
+    /* The single controller gains already include direction and sample time */
+    b->kpE[i] = p->pOnE ? p->kp : 0.0f;
+    b->kpM[i] = p->pOnE ? 0.0f : p->kp;
+    b->ki[i] = p->ki;
+    b->kd[i] = p->kd;
+    b->outMin[i] = p->outMin;
+    b->outMax[i] = p->outMax;
+    b->outputSum[i] = p->outputSum;
+    b->lastInput[i] = p->lastInput;
+}
+
+/* Bank compute(...) **********************************************************
+*   Performs the calculation of all the controllers of the bank, it must be
+*   called at the sample time. Input, Setpoint and Output are arrays of n
+*   elements, Output may alias Setpoint.
+******************************************************************************/
+void pid_bank_compute(pid_bank_t* b, const float* Input,
+                      const float* Setpoint, float* Output)
+{
+    for(size_t i = 0; i < b->n; i++)
+    {
+        float input = Input[i];
+        float error = Setpoint[i] - input;
+        float dInput = input - b->lastInput[i];
+        float min = b->outMin[i];
+        float max = b->outMax[i];
+
+        float sum = b->outputSum[i] + b->ki[i] * error - b->kpM[i] * dInput;
+        if(sum > max) sum = max;
+        else if(sum < min) sum = min;
+
+        float output = b->kpE[i] * error + sum - b->kd[i] * dInput;
+        if(output > max) output = max;
+        else if(output < min) output = min;
+
+        b->outputSum[i] = sum;
+        b->lastInput[i] = input;
+        Output[i] = output;
+    }
+}
+
+/* Q15 bank *******************************************************************/
+
+void pid_bank_q15_create(pid_bank_q15_t* b, int32_t* storage, size_t n, unsigned shift)
+{
+    int16_t* s16 = (int16_t*)(storage + n);
+
+    b->n = n;
+    b->shift = shift > 7 ? 7 : shift;
+    b->outputSum = storage;
+    b->kpE = s16;
+    b->kpM = b->kpE + n;
+    b->ki = b->kpM + n;
+    b->kd = b->ki + n;
+    b->lastInput = b->kd + n;
+    b->outMin = b->lastInput + n;
+    b->outMax = b->outMin + n;
+
+    for(size_t i = 0; i < PID_BANK_FIXED_WORDS(n); i++) storage[i] = 0;
+    for(size_t i = 0; i < n; i++) b->outMax[i] = INT16_MAX;
+}
+
+void pid_bank_q15_setTunings(pid_bank_q15_t* b, size_t i, float Kp, float Ki, float Kd,
+                             int POn, int Direction, unsigned long SampleTime)
+{
+    float g[4];
+
+    if (Kp < 0 || Ki < 0 || Kd < 0 || SampleTime == 0) return;
+
+    pid_bank_gains(g, Kp, Ki, Kd, POn, Direction, SampleTime);
+    b->kpE[i] = (int16_t)pid_gain_to_fixed(g[0], b->shift, 15);
+    b->kpM[i] = (int16_t)pid_gain_to_fixed(g[1], b->shift, 15);
+    b->ki[i] = (int16_t)pid_gain_to_fixed(g[2], b->shift, 15);
+    b->kd[i] = (int16_t)pid_gain_to_fixed(g[3], b->shift, 15);
+}
+
+void pid_bank_q15_setOutputLimits(pid_bank_q15_t* b, size_t i, int16_t Min, int16_t Max)
+{
+    if(Min >= Max) return;
+    b->outMin[i] = Min;
+    b->outMax[i] = Max;
+    b->outputSum[i] = (int32_t)pid_clamp64(b->outputSum[i],
+                                           (int32_t)Min * 256, (int32_t)Max * 256);
+}
+
+void pid_bank_q15_initialize(pid_bank_q15_t* b, size_t i, int16_t Input, int16_t Output)
+{
+    b->lastInput[i] = Input;
+    b->outputSum[i] = (int32_t)pid_clamp64(Output, b->outMin[i], b->outMax[i]) * 256;
+}
+
+void pid_bank_q15_compute(pid_bank_q15_t* b, const int16_t* Input,
+                          const int16_t* Setpoint, int16_t* Output)
+{
+    /* Products are Q30 fractions of 2^shift: the integral is kept in Q23 and
+       the other terms are brought back to Q15. */
+    const unsigned ish = 7 - b->shift;
+    const unsigned osh = 15 - b->shift;
+
+    for(size_t i = 0; i < b->n; i++)
+    {
+        int16_t input = Input[i];
+        int32_t error = pid_ssat16((int32_t)Setpoint[i] - input);
+        int32_t dInput = pid_ssat16((int32_t)input - b->lastInput[i]);
+        int32_t min = b->outMin[i];
+        int32_t max = b->outMax[i];
+
+        int32_t sum = pid_qadd32(b->outputSum[i], (b->ki[i] * error) >> ish);
+        sum = pid_qsub32(sum, (b->kpM[i] * dInput) >> ish);
+        sum = (int32_t)pid_clamp64(sum, min * 256, max * 256);
+
+        int32_t output = pid_qadd32(sum >> 8, (b->kpE[i] * error) >> osh);
+        output = pid_qsub32(output, (b->kd[i] * dInput) >> osh);
+        output = (int32_t)pid_clamp64(output, min, max);
+
+        b->outputSum[i] = sum;
+        b->lastInput[i] = input;
+        Output[i] = (int16_t)output;
+    }
+}
+
+/* Q31 bank *******************************************************************/
+
+void pid_bank_q31_create(pid_bank_q31_t* b, int64_t* storage, size_t n, unsigned shift)
+{
+    int32_t* s32 = (int32_t*)(storage + n);
+
+    b->n = n;
+    b->shift = shift > 15 ? 15 : shift;
+    b->outputSum = storage;
+    b->kpE = s32;
+    b->kpM = b->kpE + n;
+    b->ki = b->kpM + n;
+    b->kd = b->ki + n;
+    b->lastInput = b->kd + n;
+    b->outMin = b->lastInput + n;
+    b->outMax = b->outMin + n;
+
+    for(size_t i = 0; i < PID_BANK_FIXED_WORDS(n); i++) storage[i] = 0;
+    for(size_t i = 0; i < n; i++) b->outMax[i] = INT32_MAX;
+}
+
+void pid_bank_q31_setTunings(pid_bank_q31_t* b, size_t i, float Kp, float Ki, float Kd,
+                             int POn, int Direction, unsigned long SampleTime)
+{
+    float g[4];
+
+    if (Kp < 0 || Ki < 0 || Kd < 0 || SampleTime == 0) return;
+
+    pid_bank_gains(g, Kp, Ki, Kd, POn, Direction, SampleTime);
+    b->kpE[i] = (int32_t)pid_gain_to_fixed(g[0], b->shift, 31);
+    b->kpM[i] = (int32_t)pid_gain_to_fixed(g[1], b->shift, 31);
+    b->ki[i] = (int32_t)pid_gain_to_fixed(g[2], b->shift, 31);
+    b->kd[i] = (int32_t)pid_gain_to_fixed(g[3], b->shift, 31);
+}
+
+void pid_bank_q31_setOutputLimits(pid_bank_q31_t* b, size_t i, int32_t Min, int32_t Max)
+{
+    if(Min >= Max) return;
+    b->outMin[i] = Min;
+    b->outMax[i] = Max;
+    b->outputSum[i] = pid_clamp64(b->outputSum[i],
+                                  (int64_t)Min * 65536, (int64_t)Max * 65536);
+}
+
+void pid_bank_q31_initialize(pid_bank_q31_t* b, size_t i, int32_t Input, int32_t Output)
+{
+    b->lastInput[i] = Input;
+    b->outputSum[i] = pid_clamp64(Output, b->outMin[i], b->outMax[i]) * 65536;
+}
+
+void pid_bank_q31_compute(pid_bank_q31_t* b, const int32_t* Input,
+                          const int32_t* Setpoint, int32_t* Output)
+{
+    /* Products are Q62 fractions of 2^shift: the integral is kept in Q47 and
+       the other terms are brought back to Q31. */
+    const unsigned ish = 15 - b->shift;
+    const unsigned osh = 31 - b->shift;
+
+    for(size_t i = 0; i < b->n; i++)
+    {
+        int32_t input = Input[i];
+        int64_t error = pid_sat32((int64_t)Setpoint[i] - input);
+        int64_t dInput = pid_sat32((int64_t)input - b->lastInput[i]);
+        int64_t min = b->outMin[i];
+        int64_t max = b->outMax[i];
+
+        /* The products fit in 63 bits but their sum does not when the
+           shift is large, every addition saturates. */
+        int64_t sum = pid_qadd64(b->outputSum[i], (b->ki[i] * error) >> ish);
+        sum = pid_qadd64(sum, -((b->kpM[i] * dInput) >> ish));
+        sum = pid_clamp64(sum, min * 65536, max * 65536);
+
+        int64_t output = pid_qadd64(sum >> 16, (b->kpE[i] * error) >> osh);
+        output = pid_qadd64(output, -((b->kd[i] * dInput) >> osh));
+        output = pid_clamp64(output, min, max);
+
+        b->outputSum[i] = sum;
+        b->lastInput[i] = input;
+        Output[i] = (int32_t)output;
+    }
+}
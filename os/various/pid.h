@@ -2,6 +2,8 @@
 #define PID_h
 
 #include "chtypes.h"
+#include <stddef.h>
+#include <stdint.h>
 
 //Constants used in some of the functions below
 #define PID_AUTOMATIC 1
@@ -75,4 +77,98 @@ void pid_setSampleTime(pidc_t* p, int NewSampleTime);  // * sets the frequency,
 
 void pid_initialize(pidc_t* p);
 
+bool pid_computeAt(pidc_t* p, unsigned long now);  // * same as pid_compute() but driven by the caller's timebase
+                                                   //   (in the same unit as the sample time) instead of TIME_MS
+
+void pid_computeFixed(pidc_t* p);          // * performs the PID calculation unconditionally, for loops
+                                           //   already triggered at the sample time by a timer or ADC
+
+
+
+//batch engine *************************************************************************************
+// Updates an array of controllers laid out structure-of-arrays in one call, without time checks:
+// the caller invokes it at the sample time given to pid_bank_setTunings(). Proportional on error
+// and on measurement are folded into two gains so that the inner loop has no mode branches.
+
+#define PID_BANK_FLOATS 8                  // * floats of storage needed per controller
+#define PID_BANK_FIXED_WORDS(n) ((n) + (7 * (n) + 1) / 2)  // * storage words needed by n fixed-point
+                                                           //   controllers (int32_t for Q15, int64_t for Q31)
+
+typedef struct {
+    size_t n;                  // * number of controllers
+    float *kpE;                // * proportional on error gain (0 when PID_ON_M)
+    float *kpM;                // * proportional on measurement gain (0 when PID_ON_E)
+    float *ki;                 // * integral gain, scaled by the sample time
+    float *kd;                 // * derivative gain, scaled by the sample time
+    float *outputSum;
+    float *lastInput;
+    float *outMin;
+    float *outMax;
+} pid_bank_t;
+
+void pid_bank_create(pid_bank_t* b, float* storage, size_t n);  // * storage must hold n * PID_BANK_FLOATS floats
+
+void pid_bank_setTunings(pid_bank_t* b, size_t i, float Kp, float Ki, float Kd,
+                         int POn, int Direction, unsigned long SampleTime);   // * SampleTime in milliseconds
+
+void pid_bank_setOutputLimits(pid_bank_t* b, size_t i, float Min, float Max);
+
+void pid_bank_initialize(pid_bank_t* b, size_t i, float Input, float Output);  // * bumpless transfer
+
+void pid_bank_load(pid_bank_t* b, size_t i, const pidc_t* p);  // * copies tunings, limits and state from a
+                                                                //   single controller
+
+void pid_bank_compute(pid_bank_t* b, const float* Input,
+                      const float* Setpoint, float* Output);  // * updates all the controllers of the bank
+
+
+
+//fixed-point batch engines ************************************************************************
+// Inputs, setpoints and outputs are normalized fractions (Q15 or Q31). Gains are stored as fractions
+// scaled by 2^shift, so the largest representable gain is 2^shift (shift 0..7 for Q15, 0..15 for Q31);
+// the same shift applies to the whole bank. The integral term keeps extra fractional bits so that
+// small integral gains still accumulate. All the arithmetic saturates instead of wrapping.
+
+typedef struct {
+    size_t n;
+    unsigned shift;
+    int16_t *kpE;
+    int16_t *kpM;
+    int16_t *ki;
+    int16_t *kd;
+    int32_t *outputSum;        // * Q23
+    int16_t *lastInput;
+    int16_t *outMin;
+    int16_t *outMax;
+} pid_bank_q15_t;
+
+typedef struct {
+    size_t n;
+    unsigned shift;
+    int32_t *kpE;
+    int32_t *kpM;
+    int32_t *ki;
+    int32_t *kd;
+    int64_t *outputSum;        // * Q47
+    int32_t *lastInput;
+    int32_t *outMin;
+    int32_t *outMax;
+} pid_bank_q31_t;
+
+void pid_bank_q15_create(pid_bank_q15_t* b, int32_t* storage, size_t n, unsigned shift);
+void pid_bank_q15_setTunings(pid_bank_q15_t* b, size_t i, float Kp, float Ki, float Kd,
+                             int POn, int Direction, unsigned long SampleTime);
+void pid_bank_q15_setOutputLimits(pid_bank_q15_t* b, size_t i, int16_t Min, int16_t Max);
+void pid_bank_q15_initialize(pid_bank_q15_t* b, size_t i, int16_t Input, int16_t Output);
+void pid_bank_q15_compute(pid_bank_q15_t* b, const int16_t* Input,
+                          const int16_t* Setpoint, int16_t* Output);
+
+void pid_bank_q31_create(pid_bank_q31_t* b, int64_t* storage, size_t n, unsigned shift);
+void pid_bank_q31_setTunings(pid_bank_q31_t* b, size_t i, float Kp, float Ki, float Kd,
+                             int POn, int Direction, unsigned long SampleTime);
+void pid_bank_q31_setOutputLimits(pid_bank_q31_t* b, size_t i, int32_t Min, int32_t Max);
+void pid_bank_q31_initialize(pid_bank_q31_t* b, size_t i, int32_t Input, int32_t Output);
+void pid_bank_q31_compute(pid_bank_q31_t* b, const int32_t* Input,
+                          const int32_t* Setpoint, int32_t* Output);
+
 #endif
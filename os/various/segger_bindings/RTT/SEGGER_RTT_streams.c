@@ -15,33 +15,116 @@
     limitations under the License.
 */
 
+#include <string.h>
+
 #include "hal.h"
 #include "SEGGER_RTT_streams.h"
 
 RTTDriver RTTD0;
 static bool rtt_global_init;
 
+/*
+ * Single producer path.
+ *
+ * The host only moves RdOff of the up buffers and the target is the only
+ * writer of WrOff, so a buffer with one producer thread needs no lock: the
+ * data is copied first and WrOff is published after a barrier. One byte of
+ * the buffer is never used so that full and empty can be told apart, as in
+ * SEGGER_RTT.c.
+ */
+static inline SEGGER_RTT_BUFFER_UP *_up(RTTDriver *rttdp) {
+	return &_SEGGER_RTT.aUp[rttdp->up_buffer_index];
+}
+
+static size_t _up_space(const SEGGER_RTT_BUFFER_UP *ring) {
+	unsigned rd = ring->RdOff;
+	unsigned wr = ring->WrOff;
+
+	if (rd <= wr)
+		return ring->SizeOfBuffer - 1U - wr + rd;
+	return rd - wr - 1U;
+}
+
+static size_t _up_contiguous_space(const SEGGER_RTT_BUFFER_UP *ring) {
+	unsigned rd = ring->RdOff;
+	unsigned wr = ring->WrOff;
+
+	if (rd > wr)
+		return rd - wr - 1U;
+	if (rd == 0U)
+		return ring->SizeOfBuffer - 1U - wr;
+	return ring->SizeOfBuffer - wr;
+}
+
+static void _up_commit(SEGGER_RTT_BUFFER_UP *ring, size_t n) {
+	unsigned wr = ring->WrOff + (unsigned)n;
+
+	if (wr >= ring->SizeOfBuffer)
+		wr = 0U;
+	RTT_STREAMS_BARRIER();
+	ring->WrOff = wr;
+}
+
+static size_t _write_single(RTTDriver *rttdp, const uint8_t *bp, size_t n) {
+	SEGGER_RTT_BUFFER_UP *ring = _up(rttdp);
+	unsigned mode = ring->Flags & SEGGER_RTT_MODE_MASK;
+	size_t done = 0;
+
+	if ((mode == SEGGER_RTT_MODE_NO_BLOCK_SKIP) && (_up_space(ring) < n)) {
+		rttdp->counters.up_dropped += n;
+		return 0;
+	}
+
+	while (done < n) {
+		size_t chunk = _up_contiguous_space(ring);
+
+		if (chunk == 0) {
+			if (mode != SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL)
+				break;
+			osalThreadSleep(RTT_STREAMS_POLL_INTERVAL);
+			continue;
+		}
+		if (chunk > n - done)
+			chunk = n - done;
+		memcpy(ring->pBuffer + ring->WrOff, bp + done, chunk);
+		_up_commit(ring, chunk);
+		done += chunk;
+	}
+
+	rttdp->counters.up_bytes += done;
+	rttdp->counters.up_dropped += n - done;
+	return done;
+}
+
 static size_t _write(RTTDriver *rttdp, const uint8_t *bp, size_t n) {
-	return SEGGER_RTT_Write(rttdp->up_buffer_index, bp, n);
+	size_t done;
+
+	osalDbgAssert(rttdp->reserved == 0, "reservation pending");
+
+	if (rttdp->single_producer)
+		return _write_single(rttdp, bp, n);
+
+	SEGGER_RTT_LOCK();
+	done = SEGGER_RTT_WriteNoLock(rttdp->up_buffer_index, bp, n);
+	rttdp->counters.up_bytes += done;
+	rttdp->counters.up_dropped += n - done;
+	SEGGER_RTT_UNLOCK();
+	return done;
 }
 
 static size_t _read(RTTDriver *rttdp, uint8_t *bp, size_t n) {
-	(void)rttdp, (void)bp, (void)n;
-	/* TODO: implement */
-	return 0;
+	return rttReadTimeout(rttdp, bp, n, TIME_INFINITE);
 }
 
 static msg_t _put(RTTDriver *rttdp, uint8_t b) {
-	if (SEGGER_RTT_PutChar(rttdp->up_buffer_index, b) == 1) {
+	if (_write(rttdp, &b, 1) == 1) {
 		return MSG_OK;
 	}
 	return MSG_TIMEOUT;
 }
 
 static msg_t _get(RTTDriver *rttdp) {
-	(void)rttdp;
-	/* TODO: implement */
-	return MSG_TIMEOUT;
+	return rttGetTimeout(rttdp, TIME_INFINITE);
 }
 
 static const struct RTTDriverVMT vmt = {
@@ -55,6 +138,9 @@ static const struct RTTDriverVMT vmt = {
 static inline void _object_init(RTTDriver *rttdp) {
 	rttdp->state = RTT_STATE_READY;
 	rttdp->vmt = &vmt;
+	rttdp->single_producer = false;
+	rttdp->reserved = 0;
+	rttResetCounters(rttdp);
 }
 
 void rttInit(void) {
@@ -94,6 +180,7 @@ void rttObjectInit(RTTDriver *rttdp, const RTTConfig *cfg) {
 	}
 
 	_object_init(rttdp);
+	rttdp->single_producer = cfg->single_producer;
 	SEGGER_RTT_UNLOCK();
 }
 
@@ -114,3 +201,99 @@ void rttStart(RTTDriver *rttdp) {
 			|| (rttdp->state == RTT_STATE_READY), "wrong state");
 	rttdp->state = RTT_STATE_READY;
 }
+
+/*
+ * Marks the up buffer as written by a single thread. Writes then skip the
+ * interrupt masking of SEGGER_RTT_Write() and blocking writes sleep instead
+ * of spinning. Writing from two threads, or from a thread and an ISR, is not
+ * allowed while this is set.
+ */
+void rttSetSingleProducer(RTTDriver *rttdp, bool single_producer) {
+	osalDbgCheck(rttdp);
+	osalDbgAssert(rttdp->reserved == 0, "reservation pending");
+	rttdp->single_producer = single_producer;
+}
+
+/*
+ * Zero-copy write, first step. Returns in *bpp a pointer into the up buffer
+ * and the number of bytes that can be written there, 0 if the buffer is
+ * full. The space is contiguous, so it can be less than the total free space
+ * when the write offset is close to the end of the buffer. Fill any part of
+ * it and publish it with rttWriteCommit(). Single producer only.
+ */
+size_t rttWriteReserve(RTTDriver *rttdp, uint8_t **bpp) {
+	SEGGER_RTT_BUFFER_UP *ring;
+
+	osalDbgCheck(rttdp && bpp);
+	osalDbgAssert(rttdp->single_producer, "single producer only");
+	osalDbgAssert(rttdp->reserved == 0, "reservation pending");
+
+	ring = _up(rttdp);
+	*bpp = (uint8_t *)ring->pBuffer + ring->WrOff;
+	rttdp->reserved = _up_contiguous_space(ring);
+	return rttdp->reserved;
+}
+
+/*
+ * Zero-copy write, second step. Publishes the first n bytes of the last
+ * reservation to the host, n may be 0 to drop the reservation.
+ */
+void rttWriteCommit(RTTDriver *rttdp, size_t n) {
+	osalDbgCheck(rttdp);
+	osalDbgAssert(n <= rttdp->reserved, "commit exceeds reservation");
+
+	rttdp->reserved = 0;
+	if (n == 0)
+		return;
+	_up_commit(_up(rttdp), n);
+	rttdp->counters.up_bytes += n;
+}
+
+/*
+ * Reads up to n bytes from the down buffer, waiting for the host to send
+ * them until the timeout expires. TIME_IMMEDIATE only returns what is
+ * already buffered. The down buffer must have a single reader.
+ */
+size_t rttReadTimeout(RTTDriver *rttdp, uint8_t *bp, size_t n,
+		sysinterval_t timeout) {
+	systime_t start = osalOsGetSystemTimeX();
+	systime_t deadline = osalTimeAddX(start, timeout);
+	size_t done = 0;
+
+	osalDbgCheck(rttdp && (bp || !n));
+
+	while (true) {
+		done += SEGGER_RTT_ReadNoLock(rttdp->down_buffer_index,
+				bp + done, (unsigned)(n - done));
+		if (done >= n)
+			break;
+		if (timeout == TIME_IMMEDIATE)
+			break;
+		if ((timeout != TIME_INFINITE) &&
+				!osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, deadline))
+			break;
+		osalThreadSleep(RTT_STREAMS_POLL_INTERVAL);
+	}
+
+	rttdp->counters.down_bytes += done;
+	return done;
+}
+
+/*
+ * Reads one byte from the down buffer, MSG_TIMEOUT if none arrived before
+ * the timeout expired.
+ */
+msg_t rttGetTimeout(RTTDriver *rttdp, sysinterval_t timeout) {
+	uint8_t b;
+
+	if (rttReadTimeout(rttdp, &b, 1, timeout) == 1)
+		return (msg_t)b;
+	return MSG_TIMEOUT;
+}
+
+void rttResetCounters(RTTDriver *rttdp) {
+	osalDbgCheck(rttdp);
+	rttdp->counters.up_bytes = 0;
+	rttdp->counters.up_dropped = 0;
+	rttdp->counters.down_bytes = 0;
+}
@@ -25,6 +25,24 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Polling interval of the blocking reads and of the blocking writes
+ *          of the single producer path.
+ * @note    The host only looks at the buffers when it polls them, so there
+ *          is no event to wait on.
+ */
+#if !defined(RTT_STREAMS_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define RTT_STREAMS_POLL_INTERVAL           OSAL_MS2I(1)
+#endif
+
+/**
+ * @brief   Barrier between filling the up buffer and publishing the new
+ *          write offset to the host.
+ */
+#if !defined(RTT_STREAMS_BARRIER) || defined(__DOXYGEN__)
+#define RTT_STREAMS_BARRIER()               __DMB()
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -57,6 +75,20 @@ typedef struct RTTDriver RTTDriver;
 typedef struct RTTConfig RTTConfig;
 typedef struct RTTBufferConfig RTTBufferConfig;
 
+/**
+ * @brief   Throughput counters.
+ * @note    The counters wrap around, compute rates from the difference
+ *          of two snapshots.
+ */
+typedef struct {
+	/* bytes written to the up buffer */
+	uint32_t up_bytes;
+	/* bytes discarded because the up buffer was full */
+	uint32_t up_dropped;
+	/* bytes read from the down buffer */
+	uint32_t down_bytes;
+} RTTCounters;
+
 struct RTTDriver {
 	/* inherited from abstract asyncrhonous channel driver */
 	const struct RTTDriverVMT *vmt;
@@ -65,6 +97,11 @@ struct RTTDriver {
 	rtt_state_t state;
 	unsigned int up_buffer_index;
 	unsigned int down_buffer_index;
+	/* the up buffer is written by one thread only, no interrupt masking */
+	bool single_producer;
+	/* size of the pending zero-copy reservation */
+	size_t reserved;
+	RTTCounters counters;
 };
 
 struct RTTBufferConfig {
@@ -77,6 +114,8 @@ struct RTTConfig {
 	const char *name;
 	RTTBufferConfig up;
 	RTTBufferConfig down;
+	/* see rttSetSingleProducer() */
+	bool single_producer;
 };
 
 /*===========================================================================*/
@@ -85,6 +124,7 @@ struct RTTConfig {
 #define rttGetState(rttdp) ((rttdp)->state)
 #define rttGetUpBufferIndex(rttdp) ((rttdp)->up_buffer_index)
 #define rttGetDownBufferIndex(rttdp) ((rttdp)->down_buffer_index)
+#define rttGetCounters(rttdp) (&(rttdp)->counters)
 
 /*===========================================================================*/
 /* External declarations.                                                    */
@@ -100,6 +140,13 @@ extern "C" {
 	void rttStart(RTTDriver *rttdp);
 	void rttSetUpFlags(RTTDriver *rttdp, rtt_mode_flags_t flags);
 	void rttSetDownFlags(RTTDriver *rttdp, rtt_mode_flags_t flags);
+	void rttSetSingleProducer(RTTDriver *rttdp, bool single_producer);
+	size_t rttWriteReserve(RTTDriver *rttdp, uint8_t **bpp);
+	void rttWriteCommit(RTTDriver *rttdp, size_t n);
+	size_t rttReadTimeout(RTTDriver *rttdp, uint8_t *bp, size_t n,
+			sysinterval_t timeout);
+	msg_t rttGetTimeout(RTTDriver *rttdp, sysinterval_t timeout);
+	void rttResetCounters(RTTDriver *rttdp);
 #ifdef __cplusplus
 }
 #endif
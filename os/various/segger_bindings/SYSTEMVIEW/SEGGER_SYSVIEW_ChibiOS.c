@@ -16,6 +16,7 @@
 #include "ch.h"
 #include "SEGGER_SYSVIEW.h"
 #include "hal.h"
+#include "hal_trace_points.h"
 
 #include <string.h>
 
@@ -86,10 +87,64 @@ static const SEGGER_SYSVIEW_OS_API os_api = {
   _cbSendTaskList,
 };
 
+#if HAL_USE_TRACE_POINTS == TRUE
+/* One SystemView module per HAL trace module, indexed by
+ * HAL_TRACE_MODULE_xxx. The descriptions are sent to the host when the
+ * module is registered, so no description file is needed for them.*/
+static SEGGER_SYSVIEW_MODULE trace_modules[HAL_TRACE_MODULES] = {
+  [HAL_TRACE_MODULE_USBH] = {
+    "M=USBH, "
+    "0 URBSubmit urb=%p ep=%x len=%u, "
+    "1 URBComplete urb=%p status=%u len=%u",
+    2, 0, NULL, NULL
+  },
+  [HAL_TRACE_MODULE_SCSI] = {
+    "M=SCSI, "
+    "0 CmdStart op=%x lba=%u blocks=%u, "
+    "1 CmdEnd op=%x result=%u residue=%u",
+    2, 0, NULL, NULL
+  },
+  [HAL_TRACE_MODULE_EE24XX] = {
+    "M=EE24XX, "
+    "0 PageWrite addr=%x offset=%u len=%u, "
+    "1 PageWriteDone addr=%x offset=%u status=%d",
+    2, 0, NULL, NULL
+  },
+  [HAL_TRACE_MODULE_DMA2D] = {
+    "M=DMA2D, "
+    "0 JobStart mode=%x w=%u h=%u, "
+    "1 JobEnd isr=%x",
+    2, 0, NULL, NULL
+  },
+};
+
+void halTracePoint(uint32_t module, uint32_t event,
+                   uint32_t a, uint32_t b, uint32_t c) {
+  U32 offset;
+
+  if (module >= HAL_TRACE_MODULES) {
+    return;
+  }
+
+  /* Trace points hit before SYSVIEW_ChibiOS_Start() are dropped, the
+     module has no event offset yet.*/
+  offset = trace_modules[module].EventOffset;
+  if (offset == 0U) {
+    return;
+  }
+  SEGGER_SYSVIEW_RecordU32x3(offset + event, a, b, c);
+}
+#endif
+
 void SYSVIEW_ChibiOS_Start(U32 SysFreq, U32 CPUFreq, const char *isr_description) {
   start = chVTGetSystemTimeX();
   isr_desc = isr_description;
   SEGGER_SYSVIEW_Init(SysFreq, CPUFreq, &os_api, _cbSendSystemDesc);
+#if HAL_USE_TRACE_POINTS == TRUE
+  for (unsigned i = 0U; i < HAL_TRACE_MODULES; i++) {
+    SEGGER_SYSVIEW_RegisterModule(&trace_modules[i]);
+  }
+#endif
   SEGGER_SYSVIEW_Start();
 }
 
@@ -68,6 +68,13 @@
  *
  *  This will allow SystemView to map the ChibiOS's task state values to names.
  *
+ *
+ *  5) (optional)
+ *  Define HAL_USE_TRACE_POINTS as TRUE in halconf_community.h to record the
+ *  driver trace points (USBH URBs, SCSI commands, 24xx EEPROM page writes,
+ *  DMA2D jobs) on the same timeline. SYSVIEW_ChibiOS_Start() registers one
+ *  SystemView module per driver, the events show up under the module names.
+ *
  */
 
 #ifndef SYSVIEW_CHIBIOS_H
@@ -0,0 +1,146 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "ch.h"
+
+#define MAX_THREADS     8
+
+static pthread_mutex_t sys_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sys_cond = PTHREAD_COND_INITIALIZER;
+static thread_t threads[MAX_THREADS];
+static __thread thread_t *current;
+
+void chSysLock(void) {
+
+  pthread_mutex_lock(&sys_lock);
+}
+
+void chSysUnlock(void) {
+
+  pthread_mutex_unlock(&sys_lock);
+}
+
+static void *thread_entry(void *p) {
+
+  current = (thread_t *)p;
+  current->func(current->arg);
+  return NULL;
+}
+
+unsigned hostLiveThreads(void) {
+  unsigned i, n = 0U;
+
+  chSysLock();
+  for (i = 0; i < MAX_THREADS; i++) {
+    n += threads[i].wa != NULL ? 1U : 0U;
+  }
+  chSysUnlock();
+  return n;
+}
+
+thread_t *chThdCreateStatic(void *wa, size_t size, tprio_t prio,
+                            tfunc_t pf, void *arg) {
+  thread_t *tp = NULL;
+  unsigned i;
+
+  (void)size;
+  (void)prio;
+  chSysLock();
+  for (i = 0; i < MAX_THREADS; i++) {
+    /* A second thread on a live working area would corrupt its stack.*/
+    assert(threads[i].wa != wa);
+    if ((tp == NULL) && (threads[i].wa == NULL)) {
+      tp = &threads[i];
+    }
+  }
+  assert(tp != NULL);
+  tp->wa = wa;
+  tp->func = pf;
+  tp->arg = arg;
+  tp->terminate = false;
+  chSysUnlock();
+  if (pthread_create(&tp->handle, NULL, thread_entry, tp) != 0) {
+    abort();
+  }
+  return tp;
+}
+
+void chThdTerminate(thread_t *tp) {
+
+  chSysLock();
+  tp->terminate = true;
+  chSysUnlock();
+}
+
+bool chThdShouldTerminateX(void) {
+  bool t;
+
+  chSysLock();
+  t = current->terminate;
+  chSysUnlock();
+  return t;
+}
+
+msg_t chThdWait(thread_t *tp) {
+
+  pthread_join(tp->handle, NULL);
+  chSysLock();
+  tp->wa = NULL;
+  chSysUnlock();
+  return 0;
+}
+
+void chBSemObjectInit(binary_semaphore_t *bsp, bool taken) {
+
+  bsp->taken = taken;
+}
+
+void chBSemReset(binary_semaphore_t *bsp, bool taken) {
+
+  chSysLock();
+  bsp->taken = taken;
+  chSysUnlock();
+}
+
+msg_t chBSemWait(binary_semaphore_t *bsp) {
+
+  chSysLock();
+  while (bsp->taken) {
+    pthread_cond_wait(&sys_cond, &sys_lock);
+  }
+  bsp->taken = true;
+  chSysUnlock();
+  return 0;
+}
+
+void chBSemSignal(binary_semaphore_t *bsp) {
+
+  chSysLock();
+  bsp->taken = false;
+  pthread_cond_broadcast(&sys_cond);
+  chSysUnlock();
+}
+
+void chMtxObjectInit(mutex_t *mp) {
+
+  mp->locked = 0;
+}
+
+void chMtxLockS(mutex_t *mp) {
+
+  while (mp->locked != 0) {
+    pthread_cond_wait(&sys_cond, &sys_lock);
+  }
+  mp->locked = 1;
+}
+
+void chMtxUnlockS(mutex_t *mp) {
+
+  assert(mp->locked == 1);
+  mp->locked = 0;
+  pthread_cond_broadcast(&sys_cond);
+}
@@ -0,0 +1,72 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#ifndef CH_H
+#define CH_H
+
+#include <pthread.h>
+#include "osal.h"
+
+#ifndef TRUE
+#define TRUE                    1
+#endif
+#ifndef FALSE
+#define FALSE                   0
+#endif
+
+#define CH_CFG_USE_MUTEXES      TRUE
+#define CH_CFG_USE_SEMAPHORES   TRUE
+#define CH_CFG_USE_WAITEXIT     TRUE
+
+#define NORMALPRIO              128
+
+typedef int32_t                 tprio_t;
+typedef uint64_t                stkalign_t;
+typedef void (*tfunc_t)(void *p);
+
+#define THD_WORKING_AREA(s, n)  stkalign_t s[((n) + 7) / 8]
+#define THD_FUNCTION(tname, arg) void tname(void *arg)
+
+/*
+ * The kernel lock is a single host mutex, blocking primitives wait on a
+ * condition variable bound to it. Threads are host threads, a working area
+ * can only hold one live thread at a time.
+ */
+typedef struct {
+  pthread_t             handle;
+  void                  *wa;
+  tfunc_t               func;
+  void                  *arg;
+  bool                  terminate;
+} thread_t;
+
+typedef struct {
+  bool                  taken;
+} binary_semaphore_t;
+
+#define chRegSetThreadName(n)   ((void)(n))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chSysLock(void);
+  void chSysUnlock(void);
+  unsigned hostLiveThreads(void);
+  thread_t *chThdCreateStatic(void *wa, size_t size, tprio_t prio,
+                              tfunc_t pf, void *arg);
+  void chThdTerminate(thread_t *tp);
+  bool chThdShouldTerminateX(void);
+  msg_t chThdWait(thread_t *tp);
+  void chBSemObjectInit(binary_semaphore_t *bsp, bool taken);
+  void chBSemReset(binary_semaphore_t *bsp, bool taken);
+  msg_t chBSemWait(binary_semaphore_t *bsp);
+  void chBSemSignal(binary_semaphore_t *bsp);
+  void chMtxObjectInit(mutex_t *mp);
+  void chMtxLockS(mutex_t *mp);
+  void chMtxUnlockS(mutex_t *mp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CH_H */
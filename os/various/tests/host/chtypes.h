@@ -0,0 +1,16 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#ifndef CHTYPES_H
+#define CHTYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int32_t         msg_t;
+typedef uint32_t        systime_t;
+typedef uint32_t        sysinterval_t;
+
+#endif /* CHTYPES_H */
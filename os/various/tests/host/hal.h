@@ -0,0 +1,13 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#ifndef HAL_H
+#define HAL_H
+
+#include "osal.h"
+#include "hal_flash.h"
+#include "hal_pal.h"
+#include "hal_spi.h"
+
+#endif /* HAL_H */
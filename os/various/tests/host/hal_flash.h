@@ -0,0 +1,110 @@
+/*
+    Host build shim, see ../readme.txt.
+
+    Subset of the ChibiOS HAL generic flash interface.
+*/
+
+#ifndef HAL_FLASH_H
+#define HAL_FLASH_H
+
+#include "osal.h"
+
+#define FLASH_ATTR_ERASED_IS_ONE        0x00000001U
+#define FLASH_ATTR_MEMORY_MAPPED        0x00000002U
+#define FLASH_ATTR_REWRITABLE           0x00000004U
+
+typedef enum {
+  FLASH_NO_ERROR = 0,
+  FLASH_BUSY_ERASING = 1,
+  FLASH_ERROR_READ = 2,
+  FLASH_ERROR_PROGRAM = 3,
+  FLASH_ERROR_ERASE = 4,
+  FLASH_ERROR_VERIFY = 5,
+  FLASH_ERROR_HW_FAILURE = 6,
+  FLASH_ERROR_UNIMPLEMENTED = 7
+} flash_error_t;
+
+typedef uint32_t flash_offset_t;
+typedef uint32_t flash_sector_t;
+
+typedef struct {
+  flash_offset_t        offset;
+  uint32_t              size;
+} flash_sector_descriptor_t;
+
+typedef struct {
+  uint32_t                          attributes;
+  uint32_t                          page_size;
+  flash_sector_t                    sectors_count;
+  const flash_sector_descriptor_t   *sectors;
+  uint32_t                          sectors_size;
+  uint8_t                           *address;
+  uint32_t                          size;
+} flash_descriptor_t;
+
+typedef struct BaseFlash BaseFlash;
+
+struct BaseFlashVMT {
+  size_t instance_offset;
+  const flash_descriptor_t *(*get_descriptor)(void *instance);
+  flash_error_t (*read)(void *instance, flash_offset_t offset,
+                        size_t n, uint8_t *rp);
+  flash_error_t (*program)(void *instance, flash_offset_t offset,
+                           size_t n, const uint8_t *pp);
+  flash_error_t (*start_erase_all)(void *instance);
+  flash_error_t (*start_erase_sector)(void *instance, flash_sector_t sector);
+  flash_error_t (*query_erase)(void *instance, uint32_t *msec);
+  flash_error_t (*verify_erase)(void *instance, flash_sector_t sector);
+};
+
+struct BaseFlash {
+  const struct BaseFlashVMT *vmt;
+};
+
+#define flashGetDescriptor(ip)                                              \
+  (ip)->vmt->get_descriptor(ip)
+#define flashRead(ip, offset, n, rp)                                        \
+  (ip)->vmt->read(ip, offset, n, rp)
+#define flashProgram(ip, offset, n, pp)                                     \
+  (ip)->vmt->program(ip, offset, n, pp)
+#define flashStartEraseAll(ip)                                              \
+  (ip)->vmt->start_erase_all(ip)
+#define flashStartEraseSector(ip, sector)                                   \
+  (ip)->vmt->start_erase_sector(ip, sector)
+#define flashQueryErase(ip, msec)                                           \
+  (ip)->vmt->query_erase(ip, msec)
+#define flashVerifyErase(ip, sector)                                        \
+  (ip)->vmt->verify_erase(ip, sector)
+
+static inline flash_error_t flashWaitErase(BaseFlash *devp) {
+
+  while (true) {
+    uint32_t msec;
+    flash_error_t err = flashQueryErase(devp, &msec);
+    if (err != FLASH_BUSY_ERASING) {
+      return err;
+    }
+  }
+}
+
+static inline flash_offset_t flashGetSectorOffset(BaseFlash *devp,
+                                                  flash_sector_t sector) {
+  const flash_descriptor_t *descriptor = flashGetDescriptor(devp);
+
+  if (descriptor->sectors != NULL) {
+    return descriptor->sectors[sector].offset;
+  }
+  return (flash_offset_t)sector * (flash_offset_t)descriptor->sectors_size;
+}
+
+static inline uint32_t flashGetSectorSize(BaseFlash *devp,
+                                          flash_sector_t sector) {
+  const flash_descriptor_t *descriptor = flashGetDescriptor(devp);
+
+  if (descriptor->sectors != NULL) {
+    return descriptor->sectors[sector].size;
+  }
+  return descriptor->sectors_size;
+}
+
+#endif /* HAL_FLASH_H */
@@ -0,0 +1,22 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#ifndef HAL_PAL_H
+#define HAL_PAL_H
+
+#include "osal.h"
+
+typedef void *ioportid_t;
+
+/* Provided by the test.*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void palSetPad(ioportid_t port, uint16_t pad);
+  void palClearPad(ioportid_t port, uint16_t pad);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_PAL_H */
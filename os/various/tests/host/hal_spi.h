@@ -0,0 +1,24 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#ifndef HAL_SPI_H
+#define HAL_SPI_H
+
+#include "osal.h"
+
+typedef struct SPIDriver SPIDriver;
+
+/* Provided by the test.*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void spiSelectI(SPIDriver *spip);
+  void spiUnselectI(SPIDriver *spip);
+  void spiSend(SPIDriver *spip, size_t n, const void *txbuf);
+  void spiReceive(SPIDriver *spip, size_t n, void *rxbuf);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_SPI_H */
@@ -0,0 +1,44 @@
+/*
+    Host build shim, see ../readme.txt.
+*/
+
+#ifndef OSAL_H
+#define OSAL_H
+
+#include <assert.h>
+#include <time.h>
+#include "chtypes.h"
+
+#define OSAL_ST_FREQUENCY       1000U
+
+#define osalDbgCheck(c)         assert(c)
+#define osalDbgAssert(c, r)     assert((c) && (r))
+#define osalDbgCheckClassI()
+#define osalDbgCheckClassS()
+
+typedef struct {
+  int                   locked;
+} mutex_t;
+
+static inline void osalMutexObjectInit(mutex_t *mp) {
+  mp->locked = 0;
+}
+
+static inline void osalMutexLock(mutex_t *mp) {
+  assert(mp->locked == 0);
+  mp->locked = 1;
+}
+
+static inline void osalMutexUnlock(mutex_t *mp) {
+  assert(mp->locked == 1);
+  mp->locked = 0;
+}
+
+static inline systime_t osalOsGetSystemTimeX(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (systime_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+#endif /* OSAL_H */
@@ -0,0 +1,328 @@
+/*
+    Copyright (C) 2013-2015 Andrea Zoppi
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Host test of the ILI9341 framebuffer layer against a simulated controller.
+ *
+ * The SPI shim decodes the command stream as the panel does: column and
+ * page address windows, then memory writes that wrap inside the window.
+ * Every update is compared pixel for pixel with the framebuffer. The flush
+ * thread runs as a host thread, its lifecycle across start, stop and
+ * re-initialization is checked, followed by the traffic of typical
+ * updates against a full frame and against one window per rectangle.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "ili9341.h"
+#include "test_util.h"
+
+#define WIDTH             240
+#define HEIGHT            320
+#define FRAME_BYTES       (2U * WIDTH * HEIGHT)
+
+/*
+ * Simulated controller.
+ */
+struct SPIDriver {
+  int       dummy;
+};
+
+static struct {
+  bool      data;
+  bool      selected;
+  uint8_t   cmd;
+  unsigned  nparam;
+  unsigned  x0, x1, y0, y1;
+  unsigned  x, y;
+  uint8_t   screen[HEIGHT][WIDTH][2];
+} lcd;
+
+static SPIDriver spi;
+static uint16_t fb[WIDTH * HEIGHT];
+
+void palSetPad(ioportid_t port, uint16_t pad) {
+
+  (void)port;
+  (void)pad;
+  lcd.data = true;
+}
+
+void palClearPad(ioportid_t port, uint16_t pad) {
+
+  (void)port;
+  (void)pad;
+  lcd.data = false;
+}
+
+void spiSelectI(SPIDriver *spip) {
+
+  (void)spip;
+  lcd.selected = true;
+}
+
+void spiUnselectI(SPIDriver *spip) {
+
+  (void)spip;
+  lcd.selected = false;
+}
+
+static void lcd_param(uint8_t b) {
+  unsigned *lo = lcd.cmd == ILI9341_SET_COL_ADDR ? &lcd.x0 : &lcd.y0;
+  unsigned *hi = lcd.cmd == ILI9341_SET_COL_ADDR ? &lcd.x1 : &lcd.y1;
+  unsigned *v = lcd.nparam < 2U ? lo : hi;
+
+  *v = (lcd.nparam & 1U) ? ((*v << 8) | b) : b;
+  lcd.nparam++;
+}
+
+static void lcd_pixel(uint8_t b) {
+
+  TEST_ASSERT((lcd.y <= lcd.y1) && (lcd.x <= lcd.x1));
+  if ((lcd.y >= HEIGHT) || (lcd.x >= WIDTH)) {
+    return;
+  }
+  lcd.screen[lcd.y][lcd.x][lcd.nparam & 1U] = b;
+  if ((lcd.nparam++ & 1U) && (++lcd.x > lcd.x1)) {
+    lcd.x = lcd.x0;
+    lcd.y++;
+  }
+}
+
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf) {
+  const uint8_t *p = txbuf;
+
+  (void)spip;
+  TEST_ASSERT(lcd.selected);
+  if (!lcd.data) {
+    TEST_ASSERT(n == 1U);
+    lcd.cmd = p[0];
+    lcd.nparam = 0U;
+    lcd.x = lcd.x0;
+    lcd.y = lcd.y0;
+    return;
+  }
+  while (n-- > 0U) {
+    if (lcd.cmd == ILI9341_SET_MEM) {
+      lcd_pixel(*p++);
+    }
+    else {
+      lcd_param(*p++);
+    }
+  }
+}
+
+void spiReceive(SPIDriver *spip, size_t n, void *rxbuf) {
+
+  (void)spip;
+  memset(rxbuf, 0, n);
+}
+
+static const ILI9341Config config = {
+  &spi, NULL, 0U, fb, WIDTH, HEIGHT
+};
+
+static bool lcd_matches(void) {
+
+  return memcmp(lcd.screen, fb, sizeof(fb)) == 0;
+}
+
+/*
+ * Drawing.
+ */
+typedef struct {
+  uint16_t  x, y, w, h;
+} area_t;
+
+static void draw(ILI9341Driver *driverp, const area_t *a) {
+  static unsigned color = 1U;
+  unsigned i, j;
+
+  color++;
+  for (j = a->y; j < (unsigned)a->y + a->h; j++) {
+    for (i = a->x; i < (unsigned)a->x + a->w; i++) {
+      fb[j * WIDTH + i] = (uint16_t)(color * 7U + i * 3U + j);
+    }
+  }
+  ili9341FbInvalidate(driverp, a->x, a->y, a->w, a->h);
+}
+
+/*
+ * Flush thread lifecycle.
+ */
+static struct {
+  unsigned  calls;
+  pthread_t thread;
+} flushed;
+
+static void flush_cb(ILI9341Driver *driverp) {
+
+  (void)driverp;
+  flushed.calls++;
+  flushed.thread = pthread_self();
+}
+
+static void test_lifecycle(void) {
+  static const area_t a = {10, 20, 50, 30};
+  static const area_t b = {0, 100, 240, 200};
+  ILI9341Driver *driverp = &ILI9341D1;
+
+  printf("flush thread lifecycle\n");
+  ili9341ObjectInit(driverp);
+  ili9341Start(driverp, &config);
+  TEST_ASSERT(hostLiveThreads() == 1U);
+
+  draw(driverp, &a);
+  ili9341FbStartFlush(driverp, flush_cb);
+  ili9341FbWaitFlush(driverp);
+  TEST_ASSERT(lcd_matches());
+
+  /* Stopping completes the pending flush, then the thread exits. The
+     callbacks run after the flush completion, they are only known to be
+     done once the thread is gone.*/
+  draw(driverp, &b);
+  ili9341FbStartFlush(driverp, flush_cb);
+  ili9341Stop(driverp);
+  TEST_ASSERT(flushed.calls == 2U);
+  TEST_ASSERT(!pthread_equal(flushed.thread, pthread_self()));
+  TEST_ASSERT(lcd_matches());
+  TEST_ASSERT(hostLiveThreads() == 0U);
+  TEST_ASSERT(driverp->flusher == NULL);
+
+  /* The working area is free again, restarting after a new
+     initialization gives a single thread.*/
+  ili9341ObjectInit(driverp);
+  ili9341Start(driverp, &config);
+  TEST_ASSERT(hostLiveThreads() == 1U);
+  ili9341Stop(driverp);
+  ili9341Start(driverp, &config);
+  TEST_ASSERT(hostLiveThreads() == 1U);
+  ili9341Stop(driverp);
+  TEST_ASSERT(hostLiveThreads() == 0U);
+}
+
+/*
+ * Dirty rectangles.
+ */
+#define MAX_AREAS         12
+
+static const struct {
+  const char  *name;
+  unsigned    n;
+  area_t      a[MAX_AREAS];
+} updates[] = {
+  {"full screen", 1, {{0, 0, 240, 320}}},
+  {"status clock 48x16", 1, {{186, 2, 48, 16}}},
+  {"progress bar step 8x12", 1, {{20, 150, 8, 12}}},
+  {"two 100x40 buttons", 2, {{10, 250, 100, 40}, {130, 250, 100, 40}}},
+  {"10 icons 16x16 in a row", 10,
+   {{4, 30, 16, 16}, {28, 30, 16, 16}, {52, 30, 16, 16}, {76, 30, 16, 16},
+    {100, 30, 16, 16}, {124, 30, 16, 16}, {148, 30, 16, 16},
+    {172, 30, 16, 16}, {196, 30, 16, 16}, {220, 30, 16, 16}}},
+  {"list scroll 240x280", 1, {{0, 20, 240, 280}}},
+  {"3 text lines ~180x14", 3,
+   {{10, 100, 180, 14}, {10, 114, 160, 14}, {10, 128, 200, 14}}},
+  {"12 scattered widgets", 12,
+   {{5, 5, 30, 10}, {200, 5, 30, 10}, {5, 300, 30, 10}, {200, 300, 30, 10},
+    {100, 150, 40, 20}, {60, 60, 20, 20}, {160, 60, 20, 20},
+    {60, 240, 20, 20}, {160, 240, 20, 20}, {110, 10, 20, 8},
+    {110, 300, 20, 8}, {0, 160, 10, 10}}},
+};
+
+#define NUPDATES          (sizeof updates / sizeof updates[0])
+
+/* Transfers of a full width band, split for the DMA counter.*/
+static uint32_t band_transfers(uint32_t bytes) {
+
+  return (bytes + ILI9341_FB_MAX_TRANSFER - 1U) / ILI9341_FB_MAX_TRANSFER;
+}
+
+/* Traffic of one address window per area, without merging.*/
+static void per_rect(unsigned u, uint32_t *bytes, uint32_t *transfers) {
+  unsigned k;
+
+  *bytes = 0U;
+  *transfers = 0U;
+  for (k = 0; k < updates[u].n; k++) {
+    const area_t *a = &updates[u].a[k];
+
+    *bytes += 11U + 2U * a->w * a->h;
+    *transfers += 5U + (a->w == WIDTH ? band_transfers(2U * a->w * a->h) :
+                                        a->h);
+  }
+}
+
+static uint32_t cost(uint32_t bytes, uint32_t transfers) {
+
+  return bytes + ILI9341_FB_TRANSFER_COST * transfers;
+}
+
+static void test_updates(bool print) {
+  ILI9341Driver *driverp = &ILI9341D1;
+  uint32_t bytes, transfers, rbytes, rtransfers;
+  const uint32_t frame_transfers = 5U + band_transfers(FRAME_BYTES);
+  const uint32_t frame = cost(11U + FRAME_BYTES, frame_transfers);
+  unsigned u, k;
+
+  printf("dirty rectangles, synchronous and asynchronous flushes\n");
+  ili9341ObjectInit(driverp);
+  ili9341Start(driverp, &config);
+  if (print) {
+    printf("  bytes/transfers      full frame     rect each   this driver\n");
+  }
+  for (u = 0; u < NUPDATES; u++) {
+    ili9341FbResetStatistics(driverp);
+    for (k = 0; k < updates[u].n; k++) {
+      draw(driverp, &updates[u].a[k]);
+    }
+    if (u & 1U) {
+      ili9341FbStartFlush(driverp, NULL);
+      ili9341FbWaitFlush(driverp);
+    }
+    else {
+      ili9341FbFlush(driverp);
+    }
+    TEST_ASSERT(lcd_matches());
+
+    /* Merging is never worse than the full frame nor than the separate
+       windows, as long as the list is not forced to merge.*/
+    bytes = driverp->pixel_bytes + driverp->cmd_bytes;
+    transfers = driverp->transfers;
+    per_rect(u, &rbytes, &rtransfers);
+    TEST_ASSERT(cost(bytes, transfers) <= frame);
+    if (updates[u].n <= ILI9341_FB_MAX_DIRTY) {
+      TEST_ASSERT(cost(bytes, transfers) <= cost(rbytes, rtransfers));
+    }
+    if (print) {
+      printf("  %-24s %6u/%-4u %6u/%-4u %6u/%u\n", updates[u].name,
+             11U + FRAME_BYTES, (unsigned)frame_transfers, (unsigned)rbytes, (unsigned)rtransfers,
+             (unsigned)bytes, (unsigned)transfers);
+    }
+  }
+  ili9341Stop(driverp);
+}
+
+int main(int argc, char *argv[]) {
+
+  test_lifecycle();
+  test_updates(test_bench_enabled(argc, argv));
+
+  return test_result("ili9341");
+}
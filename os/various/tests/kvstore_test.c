@@ -0,0 +1,473 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Host test of the key-value store over a simulated NOR flash.
+ *
+ * The simulated flash counts the erases of each sector, rejects programming
+ * of non erased bytes and can lose power in the middle of a program or of
+ * an erase, leaving a partially written record or a partially erased
+ * sector behind.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kvstore.h"
+#include "test_util.h"
+
+#define SIM_SECTORS         6U
+#define SIM_SECTOR_SIZE     2048U
+#define SIM_SIZE            (SIM_SECTORS * SIM_SECTOR_SIZE)
+
+#define KV_FIRST_SECTOR     1U
+#define KV_SECTORS          4U
+#define KV_KEYS             16U
+
+/*
+ * Simulated flash.
+ */
+typedef struct {
+  BaseFlash         base;
+  uint8_t           mem[SIM_SIZE];
+  uint32_t          erases[SIM_SECTORS];
+  uint32_t          programs;
+  uint32_t          violations;
+  /* Operations left before the power is lost, negative if disabled.*/
+  int               budget;
+  bool              dead;
+} sim_flash_t;
+
+static sim_flash_t sim;
+
+static const flash_descriptor_t sim_descriptor = {
+  .attributes       = FLASH_ATTR_ERASED_IS_ONE,
+  .page_size        = 8U,
+  .sectors_count    = SIM_SECTORS,
+  .sectors          = NULL,
+  .sectors_size     = SIM_SECTOR_SIZE,
+  .address          = NULL,
+  .size             = SIM_SIZE
+};
+
+static uint32_t rnd_state = 1U;
+
+static uint32_t rnd(void) {
+
+  rnd_state ^= rnd_state << 13;
+  rnd_state ^= rnd_state >> 17;
+  rnd_state ^= rnd_state << 5;
+  return rnd_state;
+}
+
+/* Returns true if the power is lost by this operation.*/
+static bool sim_power_lost(void) {
+
+  if (sim.budget < 0) {
+    return false;
+  }
+  if (sim.budget-- == 0) {
+    sim.dead = true;
+    return true;
+  }
+  return false;
+}
+
+static const flash_descriptor_t *sim_get_descriptor(void *ip) {
+
+  (void)ip;
+  return &sim_descriptor;
+}
+
+static flash_error_t sim_read(void *ip, flash_offset_t offset,
+                              size_t n, uint8_t *rp) {
+
+  (void)ip;
+  if (sim.dead) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  TEST_ASSERT(offset + n <= SIM_SIZE);
+  memcpy(rp, &sim.mem[offset], n);
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_program(void *ip, flash_offset_t offset,
+                                 size_t n, const uint8_t *pp) {
+  size_t i;
+
+  (void)ip;
+  if (sim.dead) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  TEST_ASSERT(offset + n <= SIM_SIZE);
+  for (i = 0; i < n; i++) {
+    if (sim.mem[offset + i] != 0xFFU) {
+      sim.violations++;
+      return FLASH_ERROR_PROGRAM;
+    }
+  }
+  sim.programs++;
+  if (sim_power_lost()) {
+    /* Torn program, a prefix is written and the last byte partially.*/
+    n = rnd() % (n + 1U);
+    memcpy(&sim.mem[offset], pp, n);
+    if (n > 0U) {
+      sim.mem[offset + n - 1U] |= (uint8_t)rnd();
+    }
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  memcpy(&sim.mem[offset], pp, n);
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_start_erase_all(void *ip) {
+
+  (void)ip;
+  return FLASH_ERROR_UNIMPLEMENTED;
+}
+
+static flash_error_t sim_start_erase_sector(void *ip, flash_sector_t sector) {
+  uint8_t *p = &sim.mem[sector * SIM_SECTOR_SIZE];
+
+  (void)ip;
+  if (sim.dead) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  TEST_ASSERT(sector < SIM_SECTORS);
+  sim.erases[sector]++;
+  if (sim_power_lost()) {
+    /* Partially erased sector.*/
+    for (uint32_t i = 0; i < SIM_SECTOR_SIZE; i++) {
+      if ((rnd() & 3U) != 0U) {
+        p[i] = 0xFFU;
+      }
+    }
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  memset(p, 0xFF, SIM_SECTOR_SIZE);
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_query_erase(void *ip, uint32_t *msec) {
+
+  (void)ip;
+  if (msec != NULL) {
+    *msec = 0U;
+  }
+  return sim.dead ? FLASH_ERROR_HW_FAILURE : FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_verify_erase(void *ip, flash_sector_t sector) {
+  const uint8_t *p = &sim.mem[sector * SIM_SECTOR_SIZE];
+
+  (void)ip;
+  if (sim.dead) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+  for (uint32_t i = 0; i < SIM_SECTOR_SIZE; i++) {
+    if (p[i] != 0xFFU) {
+      return FLASH_ERROR_VERIFY;
+    }
+  }
+  return FLASH_NO_ERROR;
+}
+
+static const struct BaseFlashVMT sim_vmt = {
+  0,
+  sim_get_descriptor,
+  sim_read,
+  sim_program,
+  sim_start_erase_all,
+  sim_start_erase_sector,
+  sim_query_erase,
+  sim_verify_erase
+};
+
+static void sim_init(void) {
+
+  memset(&sim, 0, sizeof sim);
+  sim.base.vmt = &sim_vmt;
+  sim.budget = -1;
+  /* Random content, as a foreign region would be.*/
+  for (uint32_t i = 0; i < SIM_SIZE; i++) {
+    sim.mem[i] = (uint8_t)rnd();
+  }
+}
+
+static uint32_t sim_total_erases(void) {
+  uint32_t n = 0;
+
+  for (unsigned s = KV_FIRST_SECTOR; s < KV_FIRST_SECTOR + KV_SECTORS; s++) {
+    n += sim.erases[s];
+  }
+  return n;
+}
+
+/*
+ * Reference model of the store content.
+ */
+typedef struct {
+  bool      present;
+  size_t    len;
+  uint8_t   value[KVSTORE_MAX_VALUE_SIZE];
+} ref_t;
+
+static ref_t ref[KV_KEYS];
+
+static const KVStoreConfig kvcfg = {
+  .flashp       = &sim.base,
+  .first_sector = KV_FIRST_SECTOR,
+  .sectors      = KV_SECTORS
+};
+
+static KVStore kvs;
+
+static kvstore_error_t mount(void) {
+
+  kvsObjectInit(&kvs);
+  return kvsStart(&kvs, &kvcfg);
+}
+
+static void random_value(ref_t *r) {
+
+  r->present = true;
+  r->len = 1U + rnd() % 48U;
+  for (size_t i = 0; i < r->len; i++) {
+    r->value[i] = (uint8_t)rnd();
+  }
+}
+
+static bool matches(uint16_t key, const ref_t *r) {
+  uint8_t buf[KVSTORE_MAX_VALUE_SIZE];
+  size_t len;
+  kvstore_error_t err;
+
+  err = kvsGet(&kvs, key, buf, sizeof buf, &len);
+  if (!r->present) {
+    return err == KVSTORE_NOT_FOUND;
+  }
+  return (err == KVSTORE_NO_ERROR) && (len == r->len) &&
+         (memcmp(buf, r->value, len) == 0);
+}
+
+static bool check_all(void) {
+
+  for (uint16_t k = 0; k < KV_KEYS; k++) {
+    if (!matches(k, &ref[k])) {
+      printf("  key %u differs\n", k);
+      return false;
+    }
+  }
+  return true;
+}
+
+/* One random update of the store and of the reference.*/
+static kvstore_error_t random_op(uint16_t *keyp, ref_t *next) {
+  uint16_t key = (uint16_t)(rnd() % KV_KEYS);
+
+  *keyp = key;
+  if ((rnd() % 8U) == 0U) {
+    next->present = false;
+    return kvsDelete(&kvs, key);
+  }
+  random_value(next);
+  return kvsPut(&kvs, key, next->value, next->len);
+}
+
+static void test_basic(void) {
+  static const char v1[] = "keymap", v2[] = "rgb";
+  char buf[16];
+  size_t len;
+
+  printf("basic operations\n");
+  sim_init();
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+  TEST_ASSERT(kvsGet(&kvs, 1, buf, sizeof buf, &len) == KVSTORE_NOT_FOUND);
+  TEST_ASSERT(kvsPut(&kvs, 1, v1, sizeof v1) == KVSTORE_NO_ERROR);
+  TEST_ASSERT(kvsPut(&kvs, 2, v2, sizeof v2) == KVSTORE_NO_ERROR);
+  TEST_ASSERT(kvsDelete(&kvs, 3) == KVSTORE_NOT_FOUND);
+
+  /* Same value, no flash access.*/
+  uint32_t programs = sim.programs;
+  TEST_ASSERT(kvsPut(&kvs, 1, v1, sizeof v1) == KVSTORE_NO_ERROR);
+  TEST_ASSERT(sim.programs == programs);
+
+  kvsStop(&kvs);
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+  TEST_ASSERT(kvsGet(&kvs, 1, buf, sizeof buf, &len) == KVSTORE_NO_ERROR);
+  TEST_ASSERT((len == sizeof v1) && (memcmp(buf, v1, len) == 0));
+  TEST_ASSERT(kvsGet(&kvs, 2, buf, 2, &len) == KVSTORE_NO_ERROR);
+  TEST_ASSERT((len == sizeof v2) && (memcmp(buf, v2, 2) == 0));
+  TEST_ASSERT(kvsDelete(&kvs, 1) == KVSTORE_NO_ERROR);
+  kvsStop(&kvs);
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+  TEST_ASSERT(kvsGet(&kvs, 1, buf, sizeof buf, &len) == KVSTORE_NOT_FOUND);
+  TEST_ASSERT(sim.erases[0] == 0U && sim.erases[SIM_SECTORS - 1U] == 0U);
+  TEST_ASSERT(sim.violations == 0U);
+}
+
+/*
+ * Many small updates, the erases must be few and spread evenly over the
+ * sectors.
+ */
+static void test_wear(void) {
+  const unsigned updates = 200000U;
+  kvstats_t st;
+  uint32_t total, min = UINT32_MAX, max = 0;
+  uint16_t key;
+
+  printf("wear levelling, %u updates of %u keys on %u sectors:\n",
+         updates, KV_KEYS, KV_SECTORS);
+  sim_init();
+  memset(ref, 0, sizeof ref);
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+  memset(sim.erases, 0, sizeof sim.erases);
+
+  for (unsigned i = 0; i < updates; i++) {
+    ref_t next;
+    kvstore_error_t err = random_op(&key, &next);
+    TEST_ASSERT((err == KVSTORE_NO_ERROR) ||
+                ((err == KVSTORE_NOT_FOUND) && !ref[key].present));
+    ref[key] = next;
+  }
+  TEST_ASSERT(check_all());
+
+  for (unsigned s = KV_FIRST_SECTOR; s < KV_FIRST_SECTOR + KV_SECTORS; s++) {
+    printf("  sector %u: %u erases\n", s, sim.erases[s]);
+    min = sim.erases[s] < min ? sim.erases[s] : min;
+    max = sim.erases[s] > max ? sim.erases[s] : max;
+  }
+  total = sim_total_erases();
+  kvsGetStats(&kvs, &st);
+  printf("  %u erases in total, %.1f updates per erase, %u records copied\n",
+         total, (double)updates / total, st.copies);
+  TEST_ASSERT(max - min <= 1U);
+  TEST_ASSERT(st.max_erases - st.min_erases <= 1U);
+  TEST_ASSERT(total * 50U < updates);
+  TEST_ASSERT(sim.violations == 0U);
+
+  /* The erase counts survive a remount.*/
+  kvsStop(&kvs);
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+  TEST_ASSERT(check_all());
+  kvsGetStats(&kvs, &st);
+  TEST_ASSERT(st.max_erases >= max - 1U);
+}
+
+/*
+ * With kvsCompact() called between the updates, kvsPut() never erases.
+ */
+static void test_compact(void) {
+  uint32_t put_erases = 0;
+  uint16_t key;
+
+  printf("background compaction\n");
+  sim_init();
+  memset(ref, 0, sizeof ref);
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+
+  for (unsigned i = 0; i < 20000U; i++) {
+    ref_t next;
+    uint32_t before = sim_total_erases();
+
+    if (random_op(&key, &next) == KVSTORE_NO_ERROR) {
+      ref[key] = next;
+    }
+    put_erases += sim_total_erases() - before;
+    TEST_ASSERT(kvsCompact(&kvs) == KVSTORE_NO_ERROR);
+  }
+  TEST_ASSERT(put_erases == 0U);
+  TEST_ASSERT(check_all());
+}
+
+/*
+ * Power lost at a random flash operation, the store must mount again with
+ * every key holding either its previous or its new value.
+ */
+static void test_power_loss(void) {
+  const unsigned runs = 20000U;
+  unsigned lost = 0;
+  uint16_t key;
+
+  printf("power loss, %u runs\n", runs);
+  sim_init();
+  memset(ref, 0, sizeof ref);
+  TEST_ASSERT(mount() == KVSTORE_NO_ERROR);
+
+  for (unsigned i = 0; i < runs; i++) {
+    ref_t next, prev;
+    kvstore_error_t err;
+
+    sim.budget = (int)(rnd() % 8U);
+    if ((rnd() % 4U) == 0U) {
+      err = kvsCompact(&kvs);
+      key = 0;
+      next = ref[0];
+    }
+    else {
+      err = random_op(&key, &next);
+    }
+    prev = ref[key];
+    if (!sim.dead) {
+      sim.budget = -1;
+      TEST_ASSERT((err == KVSTORE_NO_ERROR) ||
+                  ((err == KVSTORE_NOT_FOUND) && !prev.present));
+      ref[key] = next;
+      continue;
+    }
+
+    /* Reboot, the power can be lost again while the mount completes an
+       interrupted reclaim.*/
+    lost++;
+    do {
+      sim.dead = false;
+      sim.budget = (rnd() % 4U) == 0U ? (int)(rnd() % 4U) : -1;
+      err = mount();
+    } while (sim.dead);
+    sim.budget = -1;
+    TEST_ASSERT(err == KVSTORE_NO_ERROR);
+    if (matches(key, &next)) {
+      ref[key] = next;
+    }
+    else if (!matches(key, &prev)) {
+      printf("  run %u: key %u lost\n", i, key);
+      test_failures++;
+      ref[key] = prev;
+    }
+    if (!check_all()) {
+      printf("  run %u: inconsistent store after power loss\n", i);
+      test_failures++;
+      break;
+    }
+  }
+  printf("  %u power losses\n", lost);
+  TEST_ASSERT(lost > runs / 10U);
+  TEST_ASSERT(sim.violations == 0U);
+}
+
+int main(int argc, char *argv[]) {
+
+  (void)argc;
+  (void)argv;
+
+  test_basic();
+  test_wear();
+  test_compact();
+  test_power_loss();
+
+  return test_result("kvstore");
+}
@@ -0,0 +1,352 @@
+/*
+    ChibiOS/RT - Copyright (C) 2013-2014 Uladzimir Pylinsky aka barthess
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Host test of memtest against a fault-injecting memory model.
+ *
+ * The memory under test is a memfd mapped page by page, faults are
+ * injected in two ways:
+ * - data bits stuck at 0 or 1, applied to every write done by the
+ *   simulated copy engine, which is deferred until wait() as a real DMA
+ *   would be,
+ * - a shorted address line, modelled by mapping two pages of the area on
+ *   the same page of the file, so that CPU writes to one overwrite the
+ *   other.
+ * Followed by the fast mode throughput per pattern.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "memtest.h"
+#include "test_util.h"
+
+#define PAGE              4096U
+#define AREA_PAGES        64U
+#define AREA_SIZE         (AREA_PAGES * PAGE)
+#define SCRATCH_SIZE      (2U * PAGE)
+#define BENCH_SIZE        (32U * 1024U * 1024U)
+
+/*
+ * Memory model.
+ */
+struct stuck_bit {
+  size_t    word;
+  uint64_t  mask;
+  uint64_t  value;
+};
+
+static struct {
+  int               fd;
+  uint8_t           *area;
+  const stuck_bit   *stuck;
+  size_t            nstuck;
+  /* Copy started and not waited for yet.*/
+  void              *dst;
+  const void        *src;
+  size_t            size;
+} model;
+
+static uint64_t scratch[SCRATCH_SIZE / sizeof(uint64_t)];
+
+/*
+ * Maps the area, page alias_from shows page alias_to of the file when
+ * they differ.
+ */
+static void model_map(size_t alias_from, size_t alias_to) {
+  size_t p;
+
+  for (p = 0; p < AREA_PAGES; p++) {
+    off_t off = (off_t)((p == alias_from ? alias_to : p) * PAGE);
+    void *m = mmap(model.area + p * PAGE, PAGE, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_FIXED, model.fd, off);
+    if (m == MAP_FAILED) {
+      perror("mmap");
+      exit(2);
+    }
+  }
+}
+
+static void model_init(void) {
+
+  model.fd = memfd_create("memtest", 0);
+  if ((model.fd < 0) || (ftruncate(model.fd, AREA_SIZE) != 0)) {
+    perror("memfd");
+    exit(2);
+  }
+  model.area = static_cast<uint8_t *>(mmap(nullptr, AREA_SIZE, PROT_NONE,
+                                           MAP_PRIVATE | MAP_ANONYMOUS,
+                                           -1, 0));
+  if (model.area == MAP_FAILED) {
+    perror("mmap");
+    exit(2);
+  }
+  model_map(0, 0);
+}
+
+static void model_apply(void) {
+  uint64_t *mem = reinterpret_cast<uint64_t *>(model.area);
+  size_t first = (static_cast<uint8_t *>(model.dst) - model.area) /
+                 sizeof(uint64_t);
+  size_t last = first + model.size / sizeof(uint64_t);
+
+  memcpy(model.dst, model.src, model.size);
+  for (size_t i = 0; i < model.nstuck; i++) {
+    const stuck_bit *s = &model.stuck[i];
+    if ((s->word >= first) && (s->word < last)) {
+      mem[s->word] = (mem[s->word] & ~s->mask) | (s->value & s->mask);
+    }
+  }
+  model.size = 0;
+}
+
+static void model_copy(memtest_t *testp, void *dst, const void *src,
+                       size_t size) {
+
+  (void)testp;
+  TEST_ASSERT(model.size == 0);
+  model.dst = dst;
+  model.src = src;
+  model.size = size;
+}
+
+static void model_wait(memtest_t *testp) {
+
+  (void)testp;
+  if (model.size > 0) {
+    model_apply();
+  }
+}
+
+static uint32_t model_clock(void) {
+
+  return (uint32_t)(test_now() * 1e6);
+}
+
+/*
+ * Error collection.
+ */
+static struct {
+  unsigned  count;
+  testtype  type;
+  size_t    index;
+  size_t    width;
+  uint32_t  got;
+  uint32_t  expect;
+} err;
+
+static void errcb(memtest_t *testp, testtype type, size_t index,
+                  size_t current_width, uint32_t got, uint32_t expect) {
+
+  (void)testp;
+  if (err.count++ == 0) {
+    err.type = type;
+    err.index = index;
+    err.width = current_width;
+    err.got = got;
+    err.expect = expect;
+  }
+}
+
+static void setup(memtest_t *t, bool copy) {
+
+  memset(t, 0, sizeof(*t));
+  memset(&err, 0, sizeof(err));
+  t->start = model.area;
+  t->size = AREA_SIZE;
+  t->width_mask = MEMTEST_WIDTH_32;
+  t->errcb = errcb;
+  t->scratch = scratch;
+  t->scratch_size = sizeof(scratch);
+  if (copy) {
+    t->copy = model_copy;
+    t->wait = model_wait;
+  }
+}
+
+/*
+ * A bit stuck in either half of a word must be reported at the index of
+ * that 32-bit half, with the value actually read.
+ */
+static void test_stuck_bits(void) {
+  static const testtype types[] = {
+    MEMTEST_WALKING_ONE, MEMTEST_WALKING_ZERO,
+    MEMTEST_MOVING_INVERSION_ZERO, MEMTEST_MOVING_INVERSION_55AA
+  };
+  static const unsigned bits[] = {0, 17, 31, 32, 45, 63};
+  memtest_t t;
+
+  printf("stuck data bits, copy engine fills\n");
+  for (size_t b = 0; b < sizeof bits / sizeof bits[0]; b++) {
+    for (int level = 0; level < 2; level++) {
+      const uint64_t mask = (uint64_t)1 << bits[b];
+      size_t half = bits[b] / 32;
+      uint32_t hmask = (uint32_t)1 << (bits[b] % 32);
+
+      for (size_t k = 0; k < sizeof types / sizeof types[0]; k++) {
+        /* The walking patterns have a period of 64 words, a bit stuck at
+           the value it has in most of them is only seen in the word where
+           it walks.*/
+        bool walks = ((types[k] == MEMTEST_WALKING_ONE) && (level == 0)) ||
+                     ((types[k] == MEMTEST_WALKING_ZERO) && (level == 1));
+        size_t word = 47 * 64 + (walks ? bits[b] : (bits[b] + 1) % 64);
+        stuck_bit s = {word, mask, level ? mask : 0};
+
+        model.stuck = &s;
+        model.nstuck = 1;
+        setup(&t, true);
+        TEST_ASSERT(!memtest_fast_run(&t, types[k]));
+        TEST_ASSERT(err.count == 1);
+        TEST_ASSERT(err.type == types[k]);
+        TEST_ASSERT(err.width == sizeof(uint32_t));
+        TEST_ASSERT(err.index == word * 2 + half);
+        TEST_ASSERT((err.got ^ err.expect) == hmask);
+        TEST_ASSERT((err.got & hmask) == (level ? hmask : 0));
+      }
+    }
+  }
+  model.nstuck = 0;
+
+  setup(&t, true);
+  TEST_ASSERT(memtest_fast_run(&t, MEMTEST_RUN_ALL));
+  TEST_ASSERT(err.count == 0);
+}
+
+/*
+ * Page 5 shows page 37, as if address line 17 was stuck at 1.
+ */
+static void test_address_fault(void) {
+  memtest_t t;
+
+  printf("shorted address line\n");
+  model_map(5, 37);
+
+  setup(&t, false);
+  TEST_ASSERT(!memtest_fast_run(&t, MEMTEST_OWN_ADDRESS));
+  TEST_ASSERT(err.count == 1);
+  TEST_ASSERT(err.type == MEMTEST_OWN_ADDRESS);
+  TEST_ASSERT(err.index / 2 == 5 * PAGE / sizeof(uint64_t));
+
+  setup(&t, false);
+  TEST_ASSERT(!memtest_fast_run(&t, MEMTEST_MOVING_INVERSION_RAND));
+  TEST_ASSERT(err.count == 1);
+
+  setup(&t, false);
+  memtest_run(&t, MEMTEST_OWN_ADDRESS);
+  TEST_ASSERT(err.count == 1);
+  TEST_ASSERT(err.index == 5 * PAGE / sizeof(uint32_t));
+
+  model_map(5, 5);
+}
+
+/*
+ * The background test restores the content of a healthy area, reports a
+ * faulty slice in bg_errors and stops at it.
+ */
+static void test_background(void) {
+  uint32_t *mem = reinterpret_cast<uint32_t *>(model.area);
+  memtest_t t;
+  unsigned calls;
+  size_t i;
+
+  printf("background test\n");
+  for (i = 0; i < AREA_SIZE / sizeof(uint32_t); i++) {
+    mem[i] = (uint32_t)(i * 2654435761U);
+  }
+
+  setup(&t, false);
+  for (calls = 1; !memtest_background(&t, MEMTEST_RUN_ALL, 0); calls++) {
+  }
+  TEST_ASSERT(calls == AREA_SIZE / SCRATCH_SIZE);
+  TEST_ASSERT(t.bg_errors == 0);
+  TEST_ASSERT(err.count == 0);
+  for (i = 0; i < AREA_SIZE / sizeof(uint32_t); i++) {
+    if (mem[i] != (uint32_t)(i * 2654435761U)) {
+      break;
+    }
+  }
+  TEST_ASSERT(i == AREA_SIZE / sizeof(uint32_t));
+
+  /* Slices are two pages long, the fault must be inside one of them.*/
+  model_map(9, 8);
+  setup(&t, false);
+  t.clock = model_clock;
+  while (!memtest_background(&t, MEMTEST_OWN_ADDRESS, 1000000U)) {
+    if (t.bg_errors > 0) {
+      break;
+    }
+  }
+  TEST_ASSERT(t.bg_errors == 1);
+  TEST_ASSERT(err.count == 1);
+  TEST_ASSERT(t.bg_offset == 8 * PAGE + SCRATCH_SIZE);
+  model_map(9, 9);
+}
+
+static void bench(void) {
+  static const struct {
+    testtype    type;
+    const char  *name;
+  } types[] = {
+    {MEMTEST_WALKING_ONE,           "walking one"},
+    {MEMTEST_WALKING_ZERO,          "walking zero"},
+    {MEMTEST_OWN_ADDRESS,           "own address"},
+    {MEMTEST_MOVING_INVERSION_ZERO, "moving inversion 00/FF"},
+    {MEMTEST_MOVING_INVERSION_55AA, "moving inversion 55/AA"},
+    {MEMTEST_MOVING_INVERSION_RAND, "moving inversion random"},
+  };
+  void *area = aligned_alloc(64, BENCH_SIZE);
+  memtest_t t;
+  double t0;
+
+  memset(&t, 0, sizeof(t));
+  t.start = area;
+  t.size = BENCH_SIZE;
+  t.width_mask = MEMTEST_WIDTH_32;
+  t.errcb = errcb;
+  t.clock = model_clock;
+
+  printf("benchmark, %u MB:\n", BENCH_SIZE / (1024U * 1024U));
+  t0 = test_now();
+  memtest_run(&t, MEMTEST_RUN_ALL);
+  printf("  memtest_run, 32-bit     %7.1f ms\n", (test_now() - t0) * 1e3);
+  t0 = test_now();
+  TEST_ASSERT(memtest_fast_run(&t, MEMTEST_RUN_ALL));
+  printf("  memtest_fast_run        %7.1f ms\n", (test_now() - t0) * 1e3);
+  for (size_t i = 0; i < sizeof types / sizeof types[0]; i++) {
+    printf("  %-24s %6u MB/s\n", types[i].name,
+           (unsigned)memtest_mbps(&t, types[i].type));
+  }
+  free(area);
+}
+
+int main(int argc, char *argv[]) {
+
+  model_init();
+  test_stuck_bits();
+  test_address_fault();
+  test_background();
+  if (test_bench_enabled(argc, argv)) {
+    bench();
+  }
+
+  return test_result("memtest");
+}
@@ -0,0 +1,304 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Host test of the PID engines.
+ * - Step responses of the float, Q15 and Q31 banks against the single
+ *   controller pid_computeFixed() on a first order plant.
+ * - Gain conversion and accumulation limits of the fixed-point banks.
+ * - Benchmark of one update of PID_BENCH_N controllers with each engine.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pid.h"
+#include "test_util.h"
+
+#define PID_BENCH_N         16
+#define PID_BENCH_LOOPS     200000
+
+#define STEP_SAMPLES        2000
+#define STEP_SAMPLE_MS      10
+#define STEP_TAU_S          0.2
+
+typedef struct {
+  const char    *name;
+  float         kp, ki, kd;
+  int           pon;
+  int           dir;
+} step_case_t;
+
+static const step_case_t step_cases[] = {
+  {"P on error",            2.0f, 5.0f, 0.01f, PID_ON_E, PID_DIRECT},
+  {"P on measurement",      2.0f, 5.0f, 0.01f, PID_ON_M, PID_DIRECT},
+  {"integral only",         0.0f, 8.0f, 0.0f,  PID_ON_E, PID_DIRECT},
+  {"reverse acting",        1.5f, 3.0f, 0.02f, PID_ON_E, PID_REVERSE},
+};
+
+/* First order plant, a reverse acting one has a negative gain: the
+   setpoint is negative while the output stays in 0..1. */
+static double plant(double y, double u, int dir) {
+  double k = dir == PID_REVERSE ? -1.0 : 1.0;
+  double a = (STEP_SAMPLE_MS / 1000.0) / STEP_TAU_S;
+
+  return y + a * (k * u - y);
+}
+
+/* Runs the same step response with the four engines, the outputs and the
+   setpoint are fractions of the full scale. */
+static void step_response(const step_case_t *c) {
+  pidc_t pid;
+  float in, out, sp;
+  float bstore[PID_BANK_FLOATS];
+  pid_bank_t fb;
+  int32_t q15store[PID_BANK_FIXED_WORDS(1)];
+  pid_bank_q15_t qb15;
+  int64_t q31store[PID_BANK_FIXED_WORDS(1)];
+  pid_bank_q31_t qb31;
+  double y_ref = 0.0, y_f = 0.0, y_15 = 0.0, y_31 = 0.0;
+  double e_f = 0.0, e_15 = 0.0, e_31 = 0.0;
+  float lo = 0.0f;
+  float hi = 1.0f;
+  float spv = c->dir == PID_REVERSE ? -0.5f : 0.5f;
+
+  in = 0.0f;
+  out = 0.0f;
+  sp = spv;
+  pid_create(&pid, &in, &out, &sp, c->kp, c->ki, c->kd, c->pon, c->dir);
+  pid_setSampleTime(&pid, STEP_SAMPLE_MS);
+  pid_setOutputLimits(&pid, lo, hi);
+  pid_setMode(&pid, PID_AUTOMATIC);
+
+  pid_bank_create(&fb, bstore, 1);
+  pid_bank_setTunings(&fb, 0, c->kp, c->ki, c->kd, c->pon, c->dir,
+                      STEP_SAMPLE_MS);
+  pid_bank_setOutputLimits(&fb, 0, lo, hi);
+  pid_bank_initialize(&fb, 0, 0.0f, 0.0f);
+
+  pid_bank_q15_create(&qb15, q15store, 1, 2);
+  pid_bank_q15_setTunings(&qb15, 0, c->kp, c->ki, c->kd, c->pon, c->dir,
+                          STEP_SAMPLE_MS);
+  pid_bank_q15_setOutputLimits(&qb15, 0, (int16_t)(lo * INT16_MAX),
+                               (int16_t)(hi * INT16_MAX));
+  pid_bank_q15_initialize(&qb15, 0, 0, 0);
+
+  pid_bank_q31_create(&qb31, q31store, 1, 2);
+  pid_bank_q31_setTunings(&qb31, 0, c->kp, c->ki, c->kd, c->pon, c->dir,
+                          STEP_SAMPLE_MS);
+  pid_bank_q31_setOutputLimits(&qb31, 0, (int32_t)(lo * INT32_MAX),
+                               (int32_t)(hi * INT32_MAX));
+  pid_bank_q31_initialize(&qb31, 0, 0, 0);
+
+  for (int k = 0; k < STEP_SAMPLES; k++) {
+    float f_in = (float)y_f, f_sp = spv, f_out;
+    int16_t q15_in = (int16_t)lrint(y_15 * INT16_MAX);
+    int16_t q15_sp = (int16_t)lrint(spv * INT16_MAX), q15_out;
+    int32_t q31_in = (int32_t)llrint(y_31 * INT32_MAX);
+    int32_t q31_sp = (int32_t)llrint(spv * (double)INT32_MAX), q31_out;
+
+    in = (float)y_ref;
+    pid_computeFixed(&pid);
+    pid_bank_compute(&fb, &f_in, &f_sp, &f_out);
+    pid_bank_q15_compute(&qb15, &q15_in, &q15_sp, &q15_out);
+    pid_bank_q31_compute(&qb31, &q31_in, &q31_sp, &q31_out);
+
+    y_ref = plant(y_ref, out, c->dir);
+    y_f   = plant(y_f, f_out, c->dir);
+    y_15  = plant(y_15, (double)q15_out / INT16_MAX, c->dir);
+    y_31  = plant(y_31, (double)q31_out / INT32_MAX, c->dir);
+
+    e_f  = fmax(e_f, fabs(y_f - y_ref));
+    e_15 = fmax(e_15, fabs(y_15 - y_ref));
+    e_31 = fmax(e_31, fabs(y_31 - y_ref));
+  }
+
+  printf("  %-18s final %+.4f  max error: float %.1e, Q15 %.1e, Q31 %.1e\n",
+         c->name, y_ref, e_f, e_15, e_31);
+  TEST_ASSERT(fabs(y_ref - spv) < 1e-3);
+  TEST_ASSERT(e_f < 1e-5);
+  TEST_ASSERT(e_15 < 5e-3);
+  TEST_ASSERT(e_31 < 1e-5);
+}
+
+static void test_step_responses(void) {
+  printf("step responses, %d samples of %d ms:\n",
+         STEP_SAMPLES, STEP_SAMPLE_MS);
+  for (size_t i = 0; i < sizeof step_cases / sizeof step_cases[0]; i++) {
+    step_response(&step_cases[i]);
+  }
+}
+
+/* Gains at or above 2^shift saturate to the largest positive fraction,
+   they must not wrap to the most negative one. */
+static void test_gain_saturation(void) {
+  int64_t s31[PID_BANK_FIXED_WORDS(1)];
+  int32_t s15[PID_BANK_FIXED_WORDS(1)];
+  pid_bank_q31_t b31;
+  pid_bank_q15_t b15;
+  static const float gains[] = {0.9999f, 1.0f, 5.0f, 1e9f};
+
+  printf("gain saturation\n");
+  pid_bank_q31_create(&b31, s31, 1, 0);
+  pid_bank_q15_create(&b15, s15, 1, 0);
+  for (size_t i = 0; i < sizeof gains / sizeof gains[0]; i++) {
+    pid_bank_q31_setTunings(&b31, 0, gains[i], 0, 0, PID_ON_E, PID_DIRECT, 1000);
+    pid_bank_q15_setTunings(&b15, 0, gains[i], 0, 0, PID_ON_E, PID_DIRECT, 1000);
+    TEST_ASSERT(b31.kpE[0] > 0);
+    TEST_ASSERT(b15.kpE[0] > 0);
+    if (gains[i] >= 1.0f) {
+      TEST_ASSERT(b31.kpE[0] == INT32_MAX);
+      TEST_ASSERT(b15.kpE[0] == INT16_MAX);
+    }
+    pid_bank_q31_setTunings(&b31, 0, gains[i], 0, 0, PID_ON_E, PID_REVERSE, 1000);
+    pid_bank_q15_setTunings(&b15, 0, gains[i], 0, 0, PID_ON_E, PID_REVERSE, 1000);
+    TEST_ASSERT(b31.kpE[0] < 0 && b31.kpE[0] >= -INT32_MAX);
+    TEST_ASSERT(b15.kpE[0] < 0 && b15.kpE[0] >= -INT16_MAX);
+  }
+}
+
+/* With the largest shift the integral products are 2^62, their sum must
+   saturate instead of wrapping. */
+static void test_q31_accumulation(void) {
+  int64_t s31[PID_BANK_FIXED_WORDS(1)];
+  pid_bank_q31_t b;
+  int32_t in, sp, out;
+
+  printf("Q31 accumulation limits\n");
+  pid_bank_q31_create(&b, s31, 1, 15);
+  pid_bank_q31_setTunings(&b, 0, 0, 1e6f, 0, PID_ON_E, PID_DIRECT, 1000);
+  pid_bank_q31_setOutputLimits(&b, 0, INT32_MIN, INT32_MAX);
+  TEST_ASSERT(b.ki[0] == INT32_MAX);
+
+  /* Largest positive error.*/
+  pid_bank_q31_initialize(&b, 0, INT32_MIN, INT32_MAX);
+  in = INT32_MIN;
+  sp = INT32_MAX;
+  for (int k = 0; k < 4; k++) {
+    pid_bank_q31_compute(&b, &in, &sp, &out);
+    TEST_ASSERT(out == INT32_MAX);
+  }
+
+  /* Largest negative error.*/
+  pid_bank_q31_initialize(&b, 0, INT32_MAX, INT32_MIN);
+  in = INT32_MAX;
+  sp = INT32_MIN;
+  for (int k = 0; k < 4; k++) {
+    pid_bank_q31_compute(&b, &in, &sp, &out);
+    TEST_ASSERT(out == INT32_MIN);
+  }
+
+  /* Proportional on measurement with the largest input step.*/
+  pid_bank_q31_setTunings(&b, 0, 1e6f, 1e6f, 0, PID_ON_M, PID_DIRECT, 1000);
+  pid_bank_q31_initialize(&b, 0, INT32_MIN, 0);
+  in = INT32_MAX;
+  sp = INT32_MIN;
+  pid_bank_q31_compute(&b, &in, &sp, &out);
+  TEST_ASSERT(out == INT32_MIN);
+}
+
+static void bench(void) {
+  static pidc_t pids[PID_BENCH_N];
+  static float in[PID_BENCH_N], sp[PID_BENCH_N], out[PID_BENCH_N];
+  static float fstore[PID_BENCH_N * PID_BANK_FLOATS];
+  static int32_t q15store[PID_BANK_FIXED_WORDS(PID_BENCH_N)];
+  static int64_t q31store[PID_BANK_FIXED_WORDS(PID_BENCH_N)];
+  static int16_t in15[PID_BENCH_N], sp15[PID_BENCH_N], out15[PID_BENCH_N];
+  static int32_t in31[PID_BENCH_N], sp31[PID_BENCH_N], out31[PID_BENCH_N];
+  pid_bank_t fb;
+  pid_bank_q15_t b15;
+  pid_bank_q31_t b31;
+  double t;
+
+  for (int i = 0; i < PID_BENCH_N; i++) {
+    pid_create(&pids[i], &in[i], &out[i], &sp[i], 1.0f, 2.0f, 0.01f,
+               i & 1 ? PID_ON_M : PID_ON_E, PID_DIRECT);
+    pid_setMode(&pids[i], PID_AUTOMATIC);
+    sp[i] = 100.0f + i;
+    sp15[i] = (int16_t)(1000 + i);
+    sp31[i] = 1000000 + i;
+  }
+  pid_bank_create(&fb, fstore, PID_BENCH_N);
+  pid_bank_q15_create(&b15, q15store, PID_BENCH_N, 2);
+  pid_bank_q31_create(&b31, q31store, PID_BENCH_N, 2);
+  for (int i = 0; i < PID_BENCH_N; i++) {
+    pid_bank_load(&fb, i, &pids[i]);
+    pid_bank_q15_setTunings(&b15, i, 1.0f, 2.0f, 0.01f,
+                            i & 1 ? PID_ON_M : PID_ON_E, PID_DIRECT, 100);
+    pid_bank_q31_setTunings(&b31, i, 1.0f, 2.0f, 0.01f,
+                            i & 1 ? PID_ON_M : PID_ON_E, PID_DIRECT, 100);
+  }
+
+  printf("benchmark, ns per controller update (%d controllers):\n",
+         PID_BENCH_N);
+
+  t = test_now();
+  for (int k = 0; k < PID_BENCH_LOOPS; k++) {
+    for (int i = 0; i < PID_BENCH_N; i++) {
+      in[i] = out[i] * 0.5f;
+      pid_computeFixed(&pids[i]);
+    }
+  }
+  t = test_now() - t;
+  printf("  pid_computeFixed     %6.2f\n",
+         t * 1e9 / PID_BENCH_LOOPS / PID_BENCH_N);
+
+  t = test_now();
+  for (int k = 0; k < PID_BENCH_LOOPS; k++) {
+    for (int i = 0; i < PID_BENCH_N; i++) {
+      in[i] = out[i] * 0.5f;
+    }
+    pid_bank_compute(&fb, in, sp, out);
+  }
+  t = test_now() - t;
+  printf("  pid_bank_compute     %6.2f\n",
+         t * 1e9 / PID_BENCH_LOOPS / PID_BENCH_N);
+
+  t = test_now();
+  for (int k = 0; k < PID_BENCH_LOOPS; k++) {
+    for (int i = 0; i < PID_BENCH_N; i++) {
+      in15[i] = (int16_t)(out15[i] / 2);
+    }
+    pid_bank_q15_compute(&b15, in15, sp15, out15);
+  }
+  t = test_now() - t;
+  printf("  pid_bank_q15_compute %6.2f\n",
+         t * 1e9 / PID_BENCH_LOOPS / PID_BENCH_N);
+
+  t = test_now();
+  for (int k = 0; k < PID_BENCH_LOOPS; k++) {
+    for (int i = 0; i < PID_BENCH_N; i++) {
+      in31[i] = out31[i] / 2;
+    }
+    pid_bank_q31_compute(&b31, in31, sp31, out31);
+  }
+  t = test_now() - t;
+  printf("  pid_bank_q31_compute %6.2f\n",
+         t * 1e9 / PID_BENCH_LOOPS / PID_BENCH_N);
+}
+
+int main(int argc, char *argv[]) {
+
+  test_step_responses();
+  test_gain_saturation();
+  test_q31_accumulation();
+  if (test_bench_enabled(argc, argv)) {
+    bench();
+  }
+
+  return test_result("pid");
+}
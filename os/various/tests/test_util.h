@@ -0,0 +1,67 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Minimal assertion and timing helpers shared by the host tests.
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static unsigned test_failures;
+
+/* Reports a failed condition and goes on, so that one run shows all the
+   failures of a test. */
+#define TEST_ASSERT(c) do {                                                 \
+  if (!(c)) {                                                               \
+    printf("%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #c);        \
+    test_failures++;                                                        \
+  }                                                                         \
+} while (0)
+
+static inline double test_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Benchmarks are skipped with "--no-bench", they dominate the run time. */
+static inline int test_bench_enabled(int argc, char *argv[]) {
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--no-bench") == 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static inline int test_result(const char *name) {
+
+  if (test_failures > 0U) {
+    printf("%s: %u failure(s)\n", name, test_failures);
+    return 1;
+  }
+  printf("%s: passed\n", name);
+  return 0;
+}
+
+#endif /* TEST_UTIL_H */
@@ -105,5 +105,13 @@
 #define RP_I2C_USE_I2C0                     TRUE
 #define RP_I2C_USE_I2C1                     FALSE
 #define RP_I2C_ADDRESS_MODE_10BIT           FALSE
+#define RP_I2C_USE_DMA                      TRUE
+#define RP_I2C_DMA_BUFFER_SIZE              32
+#define RP_I2C_I2C0_RX_DMA_CHANNEL          RP_DMA_CHANNEL_ID_ANY
+#define RP_I2C_I2C0_TX_DMA_CHANNEL          RP_DMA_CHANNEL_ID_ANY
+#define RP_I2C_I2C1_RX_DMA_CHANNEL          RP_DMA_CHANNEL_ID_ANY
+#define RP_I2C_I2C1_TX_DMA_CHANNEL          RP_DMA_CHANNEL_ID_ANY
+#define RP_I2C_I2C0_DMA_PRIORITY            0
+#define RP_I2C_I2C1_DMA_PRIORITY            0
 
 #endif /* MCUCONF_H */
@@ -67,6 +67,7 @@ int main(void) {
 
   I2CConfig i2cConfig = {
     400000, // baudrate
+    16,     // dma_threshold
   };
   i2cStart(&I2CD0, &i2cConfig);
 
@@ -253,6 +253,7 @@
 #define USBH_DEBUG_SINGLE_HOST_SELECTION			  USBHD1
 #define USBH_DEBUG_BUFFER                             25000
 #define USBH_DEBUG_OUTPUT_CALLBACK                    usbh_debug_output
+#define USBH_DEBUG_BINARY                             FALSE
 
 #define USBH_DEBUG_ENABLE_TRACE                       FALSE
 #define USBH_DEBUG_ENABLE_INFO                        TRUE
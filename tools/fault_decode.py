@@ -0,0 +1,253 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+"""
+Decodes the binary crash record written by the ARMv7-M fault handlers
+(os/various/fault_handlers, FAULT_CRASH_RECORD) and symbolicates it with the
+ELF image that was running.
+
+Get the record either from the application (faultGetCrashRecord() and any
+transport) or with GDB:
+
+    dump binary value crash.bin crash_record
+
+then run:
+
+    fault_decode.py crash.bin build/ch.elf
+
+The layout must match struct fault_crash_record in port_fault_handlers.h.
+"""
+
+from argparse import ArgumentParser
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x48535243
+VERSION = 1
+
+HEADER = struct.Struct('<IHHII')
+REGS = struct.Struct('<13I7I')
+STATUS = struct.Struct('<6II')
+COUNTS = struct.Struct('<8B')
+THREAD = struct.Struct('<IIIIBBH')
+TRACE_EVENT_SIZE = 16
+
+CFSR_BITS = (
+    (0, 'IACCVIOL: instruction access violation'),
+    (1, 'DACCVIOL: data access violation'),
+    (3, 'MUNSTKERR: unstacking error (MemManage)'),
+    (4, 'MSTKERR: stacking error (MemManage)'),
+    (5, 'MLSPERR: FP lazy state error (MemManage)'),
+    (8, 'IBUSERR: instruction bus error'),
+    (9, 'PRECISERR: precise data bus error'),
+    (10, 'IMPRECISERR: imprecise data bus error'),
+    (11, 'UNSTKERR: unstacking error (BusFault)'),
+    (12, 'STKERR: stacking error (BusFault)'),
+    (13, 'LSPERR: FP lazy state error (BusFault)'),
+    (16, 'UNDEFINSTR: undefined instruction'),
+    (17, 'INVSTATE: invalid state'),
+    (18, 'INVPC: invalid load of PC'),
+    (19, 'NOCP: no coprocessor'),
+    (24, 'UNALIGNED: unaligned access'),
+    (25, 'DIVBYZERO: division by zero'),
+)
+
+HFSR_BITS = (
+    (1, 'VECTTBL: bus fault on vector table read'),
+    (30, 'FORCED: escalated configurable fault'),
+    (31, 'DEBUGEVT: debug event'),
+)
+
+# RT 7 thread states and trace event types
+THREAD_STATES = ('READY', 'CURRENT', 'WTSTART', 'SUSPENDED', 'QUEUED',
+                 'WTSEM', 'WTMTX', 'WTCOND', 'SLEEPING', 'WTEXIT', 'WTOREVT',
+                 'WTANDEVT', 'SNDMSGQ', 'SNDMSG', 'WTMSG', 'FINAL')
+
+TRACE_TYPES = ('UNUSED', 'SWITCH', 'READY', 'ISR-ENTER', 'ISR-LEAVE',
+               'HALT', 'USER')
+
+
+class Elf(object):
+    """Minimal ELF32 little endian reader, sections only."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError('%s: not a 32-bit little endian ELF file' % path)
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            (_, sh_type, flags, addr, offset,
+             size) = struct.unpack_from('<6I', self.data, shoff + i * shentsize)
+            # SHF_ALLOC sections with file contents (not SHT_NOBITS)
+            if flags & 0x2 and sh_type != 8 and addr != 0:
+                self.sections.append((addr, offset, size, bool(flags & 0x4)))
+
+    def _find(self, addr):
+        for base, offset, size, code in self.sections:
+            if base <= addr < base + size:
+                return base, offset, size, code
+        return None
+
+    def is_code(self, addr):
+        s = self._find(addr & ~1)
+        return s is not None and s[3]
+
+    def string(self, addr):
+        s = self._find(addr)
+        if s is None:
+            return None
+        base, offset, size, _ = s
+        start = offset + addr - base
+        end = self.data.find(b'\0', start, offset + size)
+        if end < 0:
+            return None
+        return self.data[start:end].decode('ascii', 'replace')
+
+
+class Symbolizer(object):
+
+    def __init__(self, addr2line, elf_path):
+        self.cmd = [addr2line, '-f', '-C', '-e', elf_path]
+        self.cache = {}
+
+    def __call__(self, addr):
+        addr &= ~1
+        if addr not in self.cache:
+            try:
+                out = subprocess.check_output(self.cmd + ['0x%08x' % addr])
+                func, line = out.decode().strip().split('\n')[:2]
+                self.cache[addr] = '%s at %s' % (func, line)
+            except (OSError, subprocess.CalledProcessError, ValueError):
+                self.cache[addr] = '?'
+        return self.cache[addr]
+
+
+def checksum(raw):
+    words = struct.unpack_from('<%dI' % (len(raw) // 4), raw)
+    s = MAGIC
+    for i, w in enumerate(words):
+        if i == 2:
+            w = 0
+        s = (((s << 1) | (s >> 31)) & 0xffffffff) ^ w
+    return s
+
+
+def bits(value, table):
+    return [name for bit, name in table if value & (1 << bit)]
+
+
+def decode(raw, elf, sym, out):
+    magic, version, size, csum, count = HEADER.unpack_from(raw, 0)
+    if magic != MAGIC:
+        raise ValueError('bad magic 0x%08x' % magic)
+    if version != VERSION:
+        raise ValueError('unsupported record version %d' % version)
+    if size > len(raw):
+        raise ValueError('truncated record, %d of %d bytes' % (len(raw), size))
+    raw = raw[:size]
+    if checksum(raw) != csum:
+        out.write('WARNING: checksum mismatch, record may be corrupted\n')
+
+    pos = HEADER.size
+    regs = REGS.unpack_from(raw, pos)
+    pos += REGS.size
+    cfsr, hfsr, dfsr, mmfar, bfar, afsr, current = STATUS.unpack_from(raw, pos)
+    pos += STATUS.size
+    (stack_words, max_stack_words, thread_count, max_threads, trace_count,
+     max_trace, trace_event_size, systime_size) = COUNTS.unpack_from(raw, pos)
+    pos += COUNTS.size
+
+    r = regs[:13]
+    sp, lr, pc, xpsr, exc_return, msp, psp = regs[13:]
+
+    out.write('Crash record #%d\n\n' % count)
+    out.write('PC   0x%08x  %s\n' % (pc, sym(pc)))
+    out.write('LR   0x%08x  %s\n' % (lr, sym(lr)))
+    for i in range(0, 13, 4):
+        out.write('  '.join('R%-2d 0x%08x' % (j, r[j])
+                            for j in range(i, min(i + 4, 13))) + '\n')
+    out.write('SP   0x%08x  xPSR 0x%08x  EXC_RETURN 0x%08x\n' %
+              (sp, xpsr, exc_return))
+    out.write('MSP  0x%08x  PSP  0x%08x  (%s stack, %s frame)\n\n' %
+              (msp, psp, 'process' if exc_return & 4 else 'main',
+               'basic' if exc_return & 16 else 'FPU'))
+
+    out.write('CFSR 0x%08x  HFSR 0x%08x  DFSR 0x%08x  AFSR 0x%08x\n' %
+              (cfsr, hfsr, dfsr, afsr))
+    for name in bits(hfsr, HFSR_BITS) + bits(cfsr, CFSR_BITS):
+        out.write('  %s\n' % name)
+    if cfsr & (1 << 7):
+        out.write('  MMFAR 0x%08x\n' % mmfar)
+    if cfsr & (1 << 15):
+        out.write('  BFAR  0x%08x\n' % bfar)
+    out.write('\n')
+
+    stack = struct.unpack_from('<%dI' % max_stack_words, raw, pos)
+    pos += 4 * max_stack_words
+    if stack_words:
+        out.write('Stack at 0x%08x, code addresses:\n' % sp)
+        for i in range(stack_words):
+            if elf.is_code(stack[i]):
+                out.write('  [sp+%3d] 0x%08x  %s\n' %
+                          (4 * i, stack[i], sym(stack[i])))
+        out.write('\n')
+
+    out.write('Threads (%d):\n' % thread_count)
+    for i in range(max_threads):
+        address, name, base, free, prio, state, _ = THREAD.unpack_from(raw, pos)
+        pos += THREAD.size
+        if i >= thread_count:
+            continue
+        label = (name and elf.string(name)) or '<0x%08x>' % name
+        state = THREAD_STATES[state] if state < len(THREAD_STATES) else state
+        free = 'unknown' if free == 0xffffffff else '%d bytes' % free
+        out.write('  %s0x%08x %-16s prio %3d %-10s stack 0x%08x free %s\n' %
+                  ('*' if address == current else ' ', address, label, prio,
+                   state, base, free))
+    out.write('\n')
+
+    if trace_count:
+        out.write('Last trace events, oldest first:\n')
+        time_fmt = '<H' if systime_size == 2 else '<I'
+        for i in range(max_trace):
+            ev = raw[pos:pos + TRACE_EVENT_SIZE]
+            pos += TRACE_EVENT_SIZE
+            if i >= trace_count:
+                continue
+            head, = struct.unpack_from('<I', ev, 0)
+            ev_type, rtstamp = head & 7, head >> 8
+            if ev_type == 0:
+                continue
+            time, = struct.unpack_from(time_fmt, ev, 4)
+            u1, u2 = struct.unpack_from('<II', ev, 8)
+            tname = TRACE_TYPES[ev_type] if ev_type < len(TRACE_TYPES) else ev_type
+            if ev_type in (3, 4, 5):
+                detail = elf.string(u1) or '0x%08x' % u1
+            else:
+                detail = '0x%08x 0x%08x' % (u1, u2)
+            out.write('  time %10d rt %8d %-9s %s\n' % (time, rtstamp, tname,
+                                                         detail))
+
+
+def main():
+    parser = ArgumentParser(description='Decode a ChibiOS crash record.')
+    parser.add_argument('record', help='binary crash record')
+    parser.add_argument('elf', help='ELF image that produced the record')
+    parser.add_argument('--addr2line', default='arm-none-eabi-addr2line',
+                        help='addr2line executable (default: %(default)s)')
+    args = parser.parse_args()
+
+    with open(args.record, 'rb') as f:
+        raw = f.read()
+    try:
+        decode(raw, Elf(args.elf), Symbolizer(args.addr2line, args.elf),
+               sys.stdout)
+    except ValueError as e:
+        sys.exit('error: %s' % e)
+
+
+if __name__ == '__main__':
+    main()